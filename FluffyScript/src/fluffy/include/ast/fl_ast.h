@@ -3,7 +3,7 @@
 #include "fl_defs.h"
 #include "fl_exceptions.h"
 #include "fl_collections.h"
-#include "attributes\fl_attribute.h"
+#include "attributes/fl_attribute.h"
 
 namespace fluffy { namespace ast {
 
@@ -32,5 +32,7 @@ namespace fluffy { namespace ast {
 
 		const U32							beginPosition;
 		const U32							endPosition;
+
+		Bool								needParse;
 	};
 } }
\ No newline at end of file
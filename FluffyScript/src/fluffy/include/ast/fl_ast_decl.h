@@ -616,4 +616,20 @@ namespace fluffy { namespace ast {
 
 		ScopedPathDeclPtr				scopedChildPath;
 	};
+
+	/**
+	 * ErrorDecl
+	 */
+
+	// Ocupa o lugar de uma declaracao que nao pode ser analisada, o parser
+	// se recupera do erro e o restante do namespace continua na arvore.
+	class ErrorDecl : public GeneralStmtDecl, public AstSafeCast<AstNodeType_e::ErrorDecl>
+	{
+	public:
+		ErrorDecl(U32 line, U32 column);
+		virtual ~ErrorDecl();
+
+		U32									beginPosition;
+		U32									endPosition;
+	};
 } }
@@ -73,7 +73,6 @@ namespace fluffy { namespace ast { namespace expr {
 
 		const ExpressionDeclType_e				type;
 
-		Bool									needGenericValidation;
 		U32										beginPosition;
 		U32										endPosition;
 	};
@@ -272,6 +272,21 @@ namespace fluffy { namespace ast { namespace stmt {
 		ExpressionDeclPtr					exprDecl;
 	};
 
+	/**
+	 * StmtErrorDecl
+	 */
+
+	// Ocupa o lugar de uma instrucao que nao pode ser analisada.
+	class StmtErrorDecl : public StmtDecl, public AstSafeCast<AstNodeType_e::StmtError>
+	{
+	public:
+		StmtErrorDecl(U32 line, U32 column);
+		virtual ~StmtErrorDecl();
+
+		U32									beginPosition;
+		U32									endPosition;
+	};
+
 	/**
 	 * StmtForInitDecl
 	 */
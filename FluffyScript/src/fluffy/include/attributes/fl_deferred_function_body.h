@@ -0,0 +1,39 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include "attributes/fl_attribute.h"
+
+namespace fluffy { namespace ast {
+	class BlockDecl;
+} }
+
+namespace fluffy { namespace parser {
+	class Parser;
+} }
+
+namespace fluffy { namespace attributes {
+	/**
+	 * DeferredFunctionBody
+	 */
+
+	class DeferredFunctionBody : public AttributeTemplate<AttributeType_e::DeferredFunctionBody>
+	{
+	public:
+		DeferredFunctionBody(parser::Parser* const parser);
+		~DeferredFunctionBody();
+
+		void
+		parseFunctionBody(ast::BlockDecl* const blockDecl);
+
+		Bool
+		hasPendingFunctionBody();
+
+	private:
+		// Liberado apos o ultimo corpo pendente ser processado.
+		std::unique_ptr<parser::Parser>
+		mParser;
+
+		std::mutex
+		mMutex;
+	};
+} }
\ No newline at end of file
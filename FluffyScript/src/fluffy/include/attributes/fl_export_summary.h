@@ -0,0 +1,53 @@
+#pragma once
+#include "fl_collections.h"
+#include "attributes/fl_attribute.h"
+namespace fluffy { namespace attributes {
+	/**
+	 * ExportSummaryEntry_s
+	 */
+
+	struct ExportSummaryEntry_s
+	{
+		ast::AstNode* const scope;
+		ast::AstNode* const node;
+	};
+
+	typedef std::vector<ExportSummaryEntry_s> ExportSummaryEntryList;
+	typedef std::unordered_map<const TString, ExportSummaryEntryList, TStringHash, TStringEqual> ExportSummaryEntryMap;
+
+	/**
+	 * ExportSummary
+	 */
+
+	class ExportSummary : public AttributeTemplate<AttributeType_e::ExportSummary>
+	{
+	public:
+		ExportSummary();
+		virtual ~ExportSummary();
+
+		void
+		insertSymbol(const String& scopePath, ast::AstNode* const scope, ast::AstNode* const node);
+
+		const ExportSummaryEntryList&
+		findSymbol(const String& symbolPath);
+
+		const ExportSummaryEntryList&
+		scopeSymbolList(const String& scopePath);
+
+		U32
+		getSymbolCount();
+
+	private:
+		ExportSummaryEntryMap
+		mSymbolMap;
+
+		ExportSummaryEntryMap
+		mScopeMap;
+
+		ExportSummaryEntryList
+		mEmptyList;
+
+		U32
+		mSymbolCount;
+	};
+} }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+#include "attributes/fl_attribute.h"
+
+namespace fluffy { namespace attributes {
+	/**
+	 * SlotType_e
+	 */
+
+	enum class SlotType_e
+	{
+		Local,
+		Field,
+		Global,
+		Constant,
+		Function,
+		Method,
+		EnumItem,
+		Member
+	};
+
+	/**
+	 * FrameSlot
+	 */
+
+	// Local: indice no frame, Field: indice do campo do 'this', Global: indice da
+	// variavel global, Constant: indice da constante, Function: indice da funcao.
+	// Method e Member sao resolvidos pelo nome do no em tempo de execucao e guardam
+	// a ultima classe observada.
+	class FrameSlot : public AttributeTemplate<AttributeType_e::FrameSlot>
+	{
+	public:
+		FrameSlot(SlotType_e slotType, U32 index, I64 value);
+		~FrameSlot();
+
+		SlotType_e
+		getSlotType();
+
+		U32
+		getIndex();
+
+		I64
+		getValue();
+
+		Bool
+		hitCache(U32 classIndex);
+
+		void
+		updateCache(U32 classIndex, U32 index);
+
+	private:
+		const SlotType_e
+		mSlotType;
+
+		U32
+		mIndex;
+
+		const I64
+		mValue;
+
+		U32
+		mCachedClassIndex;
+	};
+} }
@@ -0,0 +1,26 @@
+#pragma once
+#include "attributes/fl_attribute.h"
+
+namespace fluffy { namespace generics {
+	struct Instance_s;
+} }
+
+namespace fluffy { namespace attributes {
+	/**
+	 * GenericInstance
+	 */
+
+	class GenericInstance : public AttributeTemplate<AttributeType_e::GenericInstance>
+	{
+	public:
+		GenericInstance(generics::Instance_s* const instance);
+		~GenericInstance();
+
+		generics::Instance_s* const
+		get();
+
+	private:
+		generics::Instance_s* const
+		mInstance;
+	};
+} }
@@ -1,8 +1,8 @@
 #pragma once
 #include "fl_defs.h"
 #include "fl_collections.h"
-#include "ast\fl_ast_decl.h"
-#include "attributes\fl_attribute.h"
+#include "ast/fl_ast_decl.h"
+#include "attributes/fl_attribute.h"
 namespace fluffy { namespace attributes {
 	/**
 	 * ImplementedTraitList
@@ -1,6 +1,6 @@
 #pragma once
 #include "fl_collections.h"
-#include "attributes\fl_attribute.h"
+#include "attributes/fl_attribute.h"
 namespace fluffy { namespace attributes {
 	/**
 	 * IncludeEntry_s
@@ -65,6 +65,12 @@ namespace fluffy { namespace attributes {
 		IncludeEntryMultiMap
 		mWeakIncludedMap;
 
+		IncludeEntryList
+		mIncludedList;
+
+		IncludeEntryList
+		mWeakIncludedList;
+
 		NodeMultiMap
 		mTraitDefinitionMap;
 	};
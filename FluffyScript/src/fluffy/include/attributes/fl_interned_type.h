@@ -0,0 +1,26 @@
+#pragma once
+#include "attributes/fl_attribute.h"
+
+namespace fluffy { namespace types {
+	struct Type_s;
+} }
+
+namespace fluffy { namespace attributes {
+	/**
+	 * InternedType
+	 */
+
+	class InternedType : public AttributeTemplate<AttributeType_e::InternedType>
+	{
+	public:
+		InternedType(const types::Type_s* const type);
+		~InternedType();
+
+		const types::Type_s*
+		get();
+
+	private:
+		const types::Type_s* const
+		mType;
+	};
+} }
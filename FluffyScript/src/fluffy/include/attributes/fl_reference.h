@@ -1,6 +1,6 @@
 #pragma once
-#include "ast\fl_ast.h"
-#include "attributes\fl_attribute.h"
+#include "ast/fl_ast.h"
+#include "attributes/fl_attribute.h"
 
 namespace fluffy { namespace ast {
 	class AstNode;
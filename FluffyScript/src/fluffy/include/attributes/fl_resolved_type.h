@@ -0,0 +1,22 @@
+#pragma once
+#include "attributes/fl_attribute.h"
+
+namespace fluffy { namespace attributes {
+	/**
+	 * ResolvedType
+	 */
+
+	class ResolvedType : public AttributeTemplate<AttributeType_e::ResolvedType>
+	{
+	public:
+		ResolvedType(U32 typeHandle);
+		~ResolvedType();
+
+		U32
+		getHandle();
+
+	private:
+		const U32
+		mTypeHandle;
+	};
+} }
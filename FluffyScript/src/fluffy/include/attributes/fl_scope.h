@@ -1,5 +1,5 @@
 #pragma once
-#include "attributes\fl_attribute.h"
+#include "attributes/fl_attribute.h"
 
 namespace fluffy { namespace ast {
 	class AstNode;
@@ -0,0 +1,338 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "fl_defs.h"
+
+namespace fluffy { namespace codegen {
+	/**
+	 * OpCode_e
+	 */
+
+	enum class OpCode_e : U8
+	{
+		Nop,
+
+		LoadConst,			// R[A] = K[Bx]
+		LoadInt,			// R[A] = sBx
+		LoadBool,			// R[A] = B
+		LoadNull,			// R[A] = null
+		Move,				// R[A] = R[B]
+
+		GetGlobal,			// R[A] = G[Bx]
+		SetGlobal,			// G[Bx] = R[A]
+		LoadFunction,		// R[A] = F[Bx]
+
+		GetField,			// R[A] = R[B].K[C]
+		SetField,			// R[A].K[B] = R[C]
+		GetIndex,			// R[A] = R[B][R[C]]
+		SetIndex,			// R[A][R[B]] = R[C]
+		GetMethod,			// R[A + 1] = R[B]; R[A] = R[B].K[C]
+
+		NewObject,			// R[A] = new C[Bx]
+		NewArray,			// R[A] = [R[B], ..., R[B + C - 1]]
+
+		Add,				// R[A] = R[B] + R[C]
+		Sub,				// R[A] = R[B] - R[C]
+		Mul,				// R[A] = R[B] * R[C]
+		Div,				// R[A] = R[B] / R[C]
+		Mod,				// R[A] = R[B] % R[C]
+		Shl,				// R[A] = R[B] << R[C]
+		Shr,				// R[A] = R[B] >> R[C]
+		BitAnd,				// R[A] = R[B] & R[C]
+		BitOr,				// R[A] = R[B] | R[C]
+		BitXor,				// R[A] = R[B] ^ R[C]
+
+		Equal,				// R[A] = R[B] == R[C]
+		NotEqual,			// R[A] = R[B] != R[C]
+		Less,				// R[A] = R[B] < R[C]
+		LessEqual,			// R[A] = R[B] <= R[C]
+		Greater,			// R[A] = R[B] > R[C]
+		GreaterEqual,		// R[A] = R[B] >= R[C]
+
+		Neg,				// R[A] = -R[B]
+		BitNot,				// R[A] = ~R[B]
+		Not,				// R[A] = !R[B]
+
+		Cast,				// R[A] = R[B] as PrimitiveTypeID_e(C)
+		AsType,				// R[A] = R[B] as K[C]
+		IsType,				// R[A] = R[B] is K[C]
+
+		Jump,				// pc += sBx
+		JumpIfFalse,		// if (!R[A]) pc += sBx
+		JumpIfTrue,			// if (R[A]) pc += sBx
+		JumpIfNull,			// if (R[A] == null) pc += sBx
+		Switch,				// if (R[A] is integer) pc += S[Bx][R[A]]
+
+		Call,				// R[A] = R[A](R[A + 1], ..., R[A + B])
+		Return,				// return B ? R[A] : void
+		Panic,				// panic R[A]
+
+		Count
+	};
+
+	/**
+	 * Instruction
+	 */
+
+	// Formatos das instrucoes, o opcode sempre ocupa o byte menos significativo:
+	// ABC:  [opcode:8][A:8][B:8][C:8]
+	// ABx:  [opcode:8][A:8][Bx:16]
+	// AsBx: [opcode:8][A:8][sBx:16], sBx e armazenado com deslocamento de maxSBx.
+	typedef U32 Instruction;
+
+	static constexpr const U32 maxRegisterCount	= 256;
+	static constexpr const U32 maxOperandC		= 0xFF;
+	static constexpr const U32 maxOperandBx		= 0xFFFF;
+	static constexpr const I32 maxOperandSBx	= 0x7FFF;
+	static constexpr const U32 invalidIndex		= 0xFFFFFFFF;
+
+	inline Instruction
+	encodeABC(OpCode_e op, U32 a, U32 b, U32 c)
+	{
+		return static_cast<U32>(op) | (a << 8) | (b << 16) | (c << 24);
+	}
+
+	inline Instruction
+	encodeABx(OpCode_e op, U32 a, U32 bx)
+	{
+		return static_cast<U32>(op) | (a << 8) | (bx << 16);
+	}
+
+	inline Instruction
+	encodeAsBx(OpCode_e op, U32 a, I32 sbx)
+	{
+		return encodeABx(op, a, static_cast<U32>(sbx + maxOperandSBx));
+	}
+
+	inline OpCode_e
+	getOpCode(Instruction instruction)
+	{
+		return static_cast<OpCode_e>(instruction & 0xFF);
+	}
+
+	inline U32
+	getOperandA(Instruction instruction)
+	{
+		return (instruction >> 8) & 0xFF;
+	}
+
+	inline U32
+	getOperandB(Instruction instruction)
+	{
+		return (instruction >> 16) & 0xFF;
+	}
+
+	inline U32
+	getOperandC(Instruction instruction)
+	{
+		return instruction >> 24;
+	}
+
+	inline U32
+	getOperandBx(Instruction instruction)
+	{
+		return instruction >> 16;
+	}
+
+	inline I32
+	getOperandSBx(Instruction instruction)
+	{
+		return static_cast<I32>(instruction >> 16) - maxOperandSBx;
+	}
+
+	const I8*
+	getOpCodeName(OpCode_e op);
+
+	// Retorna o opcode de um operador binario ou Nop se nao houver.
+	OpCode_e
+	getBinaryOpCode(TokenType_e op);
+
+	Bool
+	isCompoundAssign(TokenType_e op);
+
+	/**
+	 * Constant_s
+	 */
+
+	struct Constant_s
+	{
+		PrimitiveTypeID_e					type;
+		I64									integerValue;
+		Fp64								realValue;
+		String								stringValue;
+	};
+
+	/**
+	 * SwitchTable_s
+	 */
+
+	// Deslocamentos relativos a instrucao seguinte ao switch, valores que nao sao
+	// inteiros seguem para a instrucao seguinte.
+	struct SwitchTable_s
+	{
+		std::unordered_map<I64, I32>		offsetMap;
+		I32									defaultOffset;
+	};
+
+	/**
+	 * BytecodeFunction_s
+	 */
+
+	struct BytecodeFunction_s
+	{
+		String								name;
+
+		// Metodos recebem 'this' no registrador 0, contado em parameterCount.
+		Bool								isMethod;
+		U32									parameterCount;
+
+		// Quantidade de registradores do frame da funcao.
+		U32									frameSize;
+
+		std::vector<Instruction>			code;
+		std::vector<U32>					lineList;
+
+		// Constantes usadas pela funcao, indexadas por K nas instrucoes
+		// e referenciando o pool de constantes do modulo.
+		std::vector<U32>					constantList;
+
+		// Tabelas de saltos dos matches, indexadas por Bx na instrucao Switch.
+		std::vector<SwitchTable_s>			switchTableList;
+	};
+
+	/**
+	 * BytecodeMethod_s
+	 */
+
+	struct BytecodeMethod_s
+	{
+		String								name;
+		U32									functionIndex;
+	};
+
+	/**
+	 * BytecodeClass_s
+	 */
+
+	struct BytecodeClass_s
+	{
+		String								name;
+		U32									baseClassIndex;
+
+		// Campos na ordem de declaracao, sem os campos da classe base.
+		std::vector<String>					fieldList;
+		std::vector<BytecodeMethod_s>		methodList;
+		std::vector<U32>					constructorList;
+
+		// Funcao que inicializa os campos com as expressoes declaradas.
+		U32									initFunctionIndex;
+		U32									destructorFunctionIndex;
+	};
+
+	/**
+	 * BytecodeModule
+	 */
+
+	class BytecodeModule
+	{
+	public:
+		BytecodeModule();
+		virtual ~BytecodeModule();
+
+		U32
+		insertIntegerConstant(I64 value, PrimitiveTypeID_e valueType);
+
+		U32
+		insertRealConstant(Fp64 value, PrimitiveTypeID_e valueType);
+
+		U32
+		insertStringConstant(const String& value);
+
+		U32
+		insertFunction(const String& name);
+
+		U32
+		findFunction(const String& name);
+
+		U32
+		insertGlobal(const String& name);
+
+		U32
+		findGlobal(const String& name);
+
+		U32
+		insertClass(const String& name);
+
+		U32
+		findClass(const String& name);
+
+		U32
+		findMethod(U32 classIndex, const String& name);
+
+		void
+		insertInitFunction(U32 functionIndex);
+
+		const Constant_s&
+		getConstant(U32 constantIndex);
+
+		BytecodeFunction_s* const
+		getFunction(U32 functionIndex);
+
+		BytecodeClass_s* const
+		getClass(U32 classIndex);
+
+		const String&
+		getGlobalName(U32 globalIndex);
+
+		U32
+		getConstantCount();
+
+		U32
+		getFunctionCount();
+
+		U32
+		getClassCount();
+
+		U32
+		getGlobalCount();
+
+		const std::vector<U32>&
+		getInitFunctionList();
+
+		String
+		disassemble(U32 functionIndex);
+
+	private:
+		U32
+		insertConstant(const String& key, Constant_s&& constant);
+
+	private:
+		std::vector<Constant_s>
+		mConstantList;
+
+		std::unordered_map<String, U32>
+		mConstantMap;
+
+		std::vector<std::unique_ptr<BytecodeFunction_s>>
+		mFunctionList;
+
+		std::unordered_map<String, U32>
+		mFunctionMap;
+
+		std::vector<String>
+		mGlobalList;
+
+		std::unordered_map<String, U32>
+		mGlobalMap;
+
+		std::vector<std::unique_ptr<BytecodeClass_s>>
+		mClassList;
+
+		std::unordered_map<String, U32>
+		mClassMap;
+
+		std::vector<U32>
+		mInitFunctionList;
+	};
+} }
\ No newline at end of file
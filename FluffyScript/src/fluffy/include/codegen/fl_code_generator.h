@@ -0,0 +1,400 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "codegen/fl_bytecode.h"
+#include "match/fl_match_compiler.h"
+#include "scope/fl_scope_manager.h"
+
+namespace fluffy { namespace ast {
+	class CodeUnit;
+	class BlockDecl;
+	class ClassDecl;
+	class StructDecl;
+	class EnumDecl;
+	class TraitForDecl;
+	class FunctionDecl;
+	class VariableDecl;
+	class FunctionParameterDecl;
+	class ClassFunctionDecl;
+	class ClassConstructorDecl;
+	class ClassDestructorDecl;
+	class TraitFunctionDecl;
+	class TypeDecl;
+
+	namespace expr {
+		class ExpressionDecl;
+		class ExpressionBinaryDecl;
+		class ExpressionUnaryDecl;
+		class ExpressionTernaryDecl;
+		class ExpressionFunctionCall;
+		class ExpressionNewDecl;
+		class ExpressionMatchDecl;
+	}
+
+	namespace stmt {
+		class StmtDecl;
+		class StmtMatchDecl;
+	}
+
+	namespace pattern {
+		class PatternDecl;
+	}
+} }
+
+namespace fluffy { namespace codegen {
+	using FunctionParameterDeclPtrList = std::vector<std::unique_ptr<ast::FunctionParameterDecl>>;
+
+	/**
+	 * SymbolType_e
+	 */
+
+	enum class SymbolType_e
+	{
+		Unknown,
+		Local,
+		Field,
+		Global,
+		Function,
+		Method,
+		Class,
+		EnumItem
+	};
+
+	/**
+	 * Symbol_s
+	 */
+
+	struct Symbol_s
+	{
+		SymbolType_e						type;
+		U32									index;
+		I64									value;
+	};
+
+	/**
+	 * LValueType_e
+	 */
+
+	enum class LValueType_e
+	{
+		Local,
+		Global,
+		Field,
+		Index
+	};
+
+	/**
+	 * LValue_s
+	 */
+
+	struct LValue_s
+	{
+		LValueType_e						type;
+
+		// Local: registrador, Global: indice global, Field e Index: registrador do objeto.
+		U32									operandA;
+
+		// Field: constante com o nome do campo, Index: registrador do indice.
+		U32									operandB;
+	};
+
+	/**
+	 * LocalVariable_s
+	 */
+
+	struct LocalVariable_s
+	{
+		String								name;
+		U32									reg;
+	};
+
+	/**
+	 * LoopState_s
+	 */
+
+	struct LoopState_s
+	{
+		std::vector<U32>					breakJumpList;
+		std::vector<U32>					continueJumpList;
+	};
+
+	/**
+	 * PendingGoto_s
+	 */
+
+	struct PendingGoto_s
+	{
+		String								label;
+		U32									pc;
+		U32									line;
+		U32									column;
+	};
+
+	/**
+	 * FunctionState_s
+	 */
+
+	struct FunctionState_s
+	{
+		BytecodeFunction_s*					function;
+		U32									functionIndex;
+		std::vector<LocalVariable_s>		localList;
+		std::vector<LoopState_s>			loopList;
+		std::unordered_map<U32, U32>		constantMap;
+		std::unordered_map<String, U32>		labelMap;
+		std::vector<PendingGoto_s>			pendingGotoList;
+		U32									freeRegister;
+		U32									line;
+	};
+
+	/**
+	 * ScopeState_s
+	 */
+
+	struct ScopeState_s
+	{
+		String								path;
+		U32									classIndex;
+	};
+
+	/**
+	 * CodeGenerator
+	 */
+
+	class CodeGenerator : public scope::NodeProcessor, public match::PatternResolver
+	{
+	public:
+		CodeGenerator();
+		virtual ~CodeGenerator();
+
+		virtual void
+		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
+
+		// Itens de enum sao comparados pelo valor, variaveis globais sao dinamicas.
+		virtual match::PatternInfo_s
+		resolve(ast::pattern::PatternDecl* const patternDecl) override;
+
+		virtual String
+		getItemName(const void* const domain, U32 index) override;
+
+		BytecodeModule* const
+		getModule();
+
+	private:
+		void
+		beginCodeUnit(ast::CodeUnit* const codeUnit);
+
+		void
+		endCodeUnit();
+
+		void
+		declareScope(const String& scopePath, ast::AstNode* const scope);
+
+		void
+		declareClass(const String& classPath, ast::ClassDecl* const classDecl);
+
+		void
+		declareStruct(const String& structPath, ast::StructDecl* const structDecl);
+
+		void
+		declareEnum(const String& enumPath, ast::EnumDecl* const enumDecl);
+
+		void
+		pushScope(const String& scopePath, U32 classIndex);
+
+		void
+		popScope();
+
+		void
+		beginClass(ast::ClassDecl* const classDecl);
+
+		void
+		beginTraitFor(ast::TraitForDecl* const traitForDecl);
+
+		void
+		generateStructInit(ast::StructDecl* const structDecl);
+
+		void
+		generateFunction(ast::FunctionDecl* const functionDecl);
+
+		void
+		generateClassFunction(ast::ClassFunctionDecl* const classFunctionDecl);
+
+		void
+		generateTraitFunction(ast::TraitFunctionDecl* const traitFunctionDecl);
+
+		void
+		generateConstructor(ast::ClassConstructorDecl* const constructorDecl);
+
+		void
+		generateDestructor(ast::ClassDestructorDecl* const destructorDecl);
+
+		void
+		generateGlobalVariable(ast::VariableDecl* const variableDecl);
+
+		void
+		declareParameters(FunctionParameterDeclPtrList& parameterList);
+
+		void
+		generateFunctionBody(U32 functionIndex, Bool isMethod, FunctionParameterDeclPtrList& parameterList, ast::BlockDecl* const blockDecl, ast::expr::ExpressionDecl* const exprDecl);
+
+		void
+		beginFunction(FunctionState_s& functionState, U32 functionIndex, Bool isMethod);
+
+		void
+		endFunction(FunctionState_s& functionState);
+
+		void
+		generateBlock(ast::BlockDecl* const blockDecl);
+
+		void
+		generateStmt(ast::stmt::StmtDecl* const stmtDecl);
+
+		void
+		generateStmtMatch(ast::stmt::StmtMatchDecl* const stmtMatchDecl);
+
+		void
+		generateExprTo(ast::expr::ExpressionDecl* const exprDecl, U32 target);
+
+		U32
+		generateExprAny(ast::expr::ExpressionDecl* const exprDecl);
+
+		void
+		generateBinary(ast::expr::ExpressionBinaryDecl* const binaryDecl, U32 target);
+
+		void
+		generateUnary(ast::expr::ExpressionUnaryDecl* const unaryDecl, U32 target);
+
+		void
+		generateCall(ast::expr::ExpressionDecl* const lhsDecl, ast::expr::ExpressionDecl* const argumentsDecl, U32 target);
+
+		void
+		generateNew(ast::expr::ExpressionNewDecl* const newDecl, U32 target);
+
+		void
+		generateExprMatch(ast::expr::ExpressionMatchDecl* const matchDecl, U32 target);
+
+		U32
+		generatePatternTest(ast::pattern::PatternDecl* const patternDecl, U32 subjectReg);
+
+		// Emite a instrucao Switch quando a arvore de decisao do match compara o
+		// valor com inteiros constantes, retorna invalidIndex caso contrario.
+		U32
+		emitMatchSwitch(const std::vector<ast::pattern::PatternDecl*>& patternList, U32 subjectReg, match::JumpTable_s& jumpTable);
+
+		// Preenche a tabela com o inicio do teste ou do corpo de cada braco.
+		void
+		patchMatchSwitch(U32 switchPc, const match::JumpTable_s& jumpTable, const std::vector<U32>& testPcList, const std::vector<U32>& bodyPcList, U32 noMatchPc);
+
+		U32
+		generateArguments(ast::expr::ExpressionDecl* const argumentsDecl, U32 firstReg);
+
+		void
+		generateMethodCall(U32 functionIndex, U32 objectReg, ast::expr::ExpressionDecl* const argumentsDecl, U32 base);
+
+		LValue_s
+		prepareLValue(ast::expr::ExpressionDecl* const exprDecl);
+
+		void
+		loadLValue(const LValue_s& lvalue, U32 target);
+
+		void
+		storeLValue(const LValue_s& lvalue, U32 valueReg);
+
+		void
+		loadSymbol(const Symbol_s& symbol, const String& identifier, U32 target, ast::AstNode* const node);
+
+		Symbol_s
+		resolveSymbol(const String& identifier, Bool startFromRoot);
+
+		Symbol_s
+		resolvePath(const String& path);
+
+		String
+		resolveTypeName(ast::TypeDecl* const typeDecl);
+
+		U32
+		resolveClass(ast::TypeDecl* const typeDecl);
+
+		Bool
+		buildScopedPath(ast::expr::ExpressionDecl* const exprDecl, String& path, Bool& startFromRoot);
+
+		void
+		collectArguments(ast::expr::ExpressionDecl* const exprDecl, std::vector<ast::expr::ExpressionDecl*>& argumentList);
+
+		void
+		declareLocal(const String& identifier, U32 reg);
+
+		U32
+		findLocal(const String& identifier);
+
+		U32
+		allocateRegister();
+
+		U32
+		allocateRegisters(U32 count);
+
+		void
+		releaseRegisters(U32 mark);
+
+		U32
+		insertConstant(U32 moduleConstantIndex);
+
+		U32
+		insertNameConstant(const String& name);
+
+		U32
+		emitABC(OpCode_e op, U32 a, U32 b, U32 c);
+
+		U32
+		emitABx(OpCode_e op, U32 a, U32 bx);
+
+		U32
+		emitJump(OpCode_e op, U32 a);
+
+		void
+		patchJump(U32 jumpPc);
+
+		void
+		patchJumpTo(U32 jumpPc, U32 targetPc);
+
+		U32
+		currentPc();
+
+		void
+		setLine(ast::AstNode* const node);
+
+	private:
+		std::unique_ptr<BytecodeModule>
+		mModule;
+
+		ast::CodeUnit*
+		mCodeUnit;
+
+		String
+		mFilename;
+
+		std::vector<ScopeState_s>
+		mScopeStack;
+
+		std::unordered_map<String, String>
+		mIncludeAliasMap;
+
+		std::vector<String>
+		mIncludeWildcardList;
+
+		std::unordered_map<String, I64>
+		mEnumValueMap;
+
+		// Indice da funcao gerada para cada declaracao.
+		std::unordered_map<ast::AstNode*, U32>
+		mFunctionIndexMap;
+
+		std::unique_ptr<FunctionState_s>
+		mInitFunction;
+
+		FunctionState_s*
+		mFunction;
+	};
+} }
\ No newline at end of file
@@ -0,0 +1,232 @@
+#pragma once
+#include <exception>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+#include "fl_defs.h"
+#include "fl_string.h"
+
+namespace fluffy { namespace ast {
+	class AstNode;
+} }
+
+namespace fluffy { namespace diagnostics {
+	// Numero maximo de argumentos de uma mensagem.
+	static constexpr const U32 maxDiagnosticArgs = 3;
+
+	/**
+	 * DiagnosticCode_e
+	 */
+
+	enum class DiagnosticCode_e : U16
+	{
+		// Lexer
+		UnexpectedToken,
+		UnexpectedEndOfFile,
+		InvalidCharacter,
+		MalformedNumber,
+		MalformedStringConstant,
+		ExpectedToken,
+		ExpectedIdentifier,
+		ExpectedConstantBool,
+		ExpectedConstantInteger,
+		ExpectedConstantFp32,
+		ExpectedConstantFp64,
+		ExpectedConstantChar,
+		ExpectedConstantString,
+		IntegerConstantOverflow,
+
+		// Parser
+		ClassExtendsNotClass,
+		ClassImplementsNotInterface,
+		StaticFunctionAbstract,
+		StaticFunctionOverride,
+		StaticConstructor,
+		StaticDestructor,
+		DestructorAccessModifier,
+		DuplicatedDestructor,
+		AbstractFunctionModifier,
+		TraitDefinitionType,
+		SelfTypeOutsideTrait,
+		VoidFunctionAssign,
+		VoidAnomFunctionAssign,
+		VoidVariable,
+		VoidParameter,
+		VoidNamedParameter,
+		VoidGenericItem,
+		VoidNullable,
+		UnexpectedType,
+		WhereIdentifierNotGeneric,
+		WhereTypeNullable,
+		ExpectedParameterEnd,
+		ExpectedFunctionTypeEnd,
+		InvalidJokerIdentifier,
+		NotImplementedFeature,
+
+		// Resolucao de tipos
+		IdentifierNotFound,
+		AmbiguousSearchResult,
+		AmbiguousType,
+		InvalidType,
+		InvalidScope,
+
+		// Validacoes
+		DuplicatedIdentifier,
+		BaseClassNotClass,
+		CircularExtends,
+		MissingReference,
+		InterfaceExpected,
+		AbstractFunctionInConcreteClass,
+		AbstractFunctionNotPublic,
+		InterfaceFunctionNotPublic,
+		AbstractFunctionNotImplemented,
+		InterfaceFunctionNotImplemented,
+		GenericArgumentCount,
+		GenericWhereMismatch,
+		TraitNotFound,
+		TraitSearchFailed,
+		TraitNotDeclared,
+		TraitFunctionNotImplemented,
+
+		// Avaliacao de constantes
+		DivisionByZero,
+
+		// Erro lancado por um processador, a mensagem ja esta formatada.
+		ProcessingError,
+
+		// Avisos, nao contam como erros nem interrompem a compilacao
+		IntegerOverflow,
+		UnreachableMatchArm,
+		NonExhaustiveMatch
+	};
+
+	/**
+	 * DiagnosticSeverity_e
+	 */
+
+	enum class DiagnosticSeverity_e : U8
+	{
+		Error,
+		Warning
+	};
+
+	/**
+	 * Diagnostic_s
+	 */
+
+	// Registro compacto de um diagnostico, a mensagem so e montada quando o
+	// diagnostico e impresso. Os argumentos sao strings internadas, copiar um
+	// identificador do no nao aloca memoria. Sem posicao, line e column sao 0.
+	struct Diagnostic_s
+	{
+		DiagnosticCode_e					code;
+		DiagnosticSeverity_e				severity;
+		U8									argCount;
+		U32									line;
+		U32									column;
+		TString								sourceFile;
+		const ast::AstNode*					node;
+		TString								argList[maxDiagnosticArgs];
+	};
+
+	/**
+	 * DiagnosticEngine
+	 */
+
+	// Coleta os erros de uma compilacao sem interrompe-la: o parser se recupera
+	// no proximo ponto de sincronizacao e os processadores continuam no proximo
+	// no, uma execucao reporta todos os erros encontrados. Pode ser usado por
+	// varias threads ao mesmo tempo.
+	class DiagnosticEngine
+	{
+	public:
+		DiagnosticEngine();
+		~DiagnosticEngine();
+
+		void
+		report(const Diagnostic_s& diagnostic);
+
+		void
+		report(DiagnosticCode_e code, const TString& sourceFile, const ast::AstNode* const node, U32 line, U32 column, std::initializer_list<TString> argList);
+
+		// Usa a posicao do no.
+		void
+		report(DiagnosticCode_e code, const TString& sourceFile, const ast::AstNode* const node, std::initializer_list<TString> argList);
+
+		// Apos o limite os erros sao contados mas nao registrados, 0 desativa o limite.
+		void
+		setErrorLimit(U32 errorLimit);
+
+		Bool
+		isErrorLimitReached();
+
+		Bool
+		hasErrors();
+
+		U32
+		getErrorCount();
+
+		std::vector<Diagnostic_s>
+		getDiagnosticList();
+
+		void
+		clear();
+
+		// Todos os diagnosticos formatados, um por linha.
+		String
+		formatAll();
+
+		static Diagnostic_s
+		makeDiagnostic(DiagnosticCode_e code, const TString& sourceFile, const ast::AstNode* const node, U32 line, U32 column, std::initializer_list<TString> argList);
+
+		static DiagnosticSeverity_e
+		getSeverity(DiagnosticCode_e code);
+
+		// Apenas a mensagem, sem o arquivo e a posicao.
+		static String
+		formatMessage(const Diagnostic_s& diagnostic);
+
+		// No formato das excecoes: "<arquivo> error: <mensagem> at: line L, column C".
+		static String
+		format(const Diagnostic_s& diagnostic);
+
+	private:
+		std::mutex
+		mMutex;
+
+		std::vector<Diagnostic_s>
+		mDiagnosticList;
+
+		U32
+		mErrorCount;
+
+		U32
+		mErrorLimit;
+	};
+} }
+
+namespace fluffy { namespace exceptions {
+	/**
+	 * diagnostic_exception
+	 */
+
+	// Lancada apos o diagnostico ser registrado no motor, apenas interrompe a
+	// analise ate o proximo ponto de sincronizacao. A mensagem so e montada se
+	// for consultada.
+	class diagnostic_exception : public std::exception
+	{
+	public:
+								diagnostic_exception(const diagnostics::Diagnostic_s& diagnostic);
+								~diagnostic_exception();
+
+		virtual const char*		what() const noexcept override;
+
+		const diagnostics::Diagnostic_s&
+								getDiagnostic() const;
+
+	private:
+		diagnostics::Diagnostic_s
+								m_diagnostic;
+		mutable String			m_message;
+	};
+} }
@@ -19,6 +19,14 @@ namespace fluffy
 		virtual const I8		readByte(U8 offset = 0) = 0;
 		virtual void			nextByte() = 0;
 		virtual void			reset(U32 position) = 0;
+
+		// Codigo completo em memoria, nulo quando o buffer nao o mantem inteiro.
+		virtual const I8*		getData() = 0;
+		virtual U32				getLength() = 0;
+
+		// Copia ate 'length' bytes a partir de 'position' sem mover o cursor,
+		// retorna o numero de bytes copiados.
+		virtual U32				read(U32 position, I8* destination, U32 length) = 0;
 	};
 
 	/**
@@ -37,6 +45,9 @@ namespace fluffy
 		virtual const I8		readByte(U8 offset) override;
 		virtual void			nextByte() override;
 		virtual void			reset(U32 position) override;
+		virtual const I8*		getData() override;
+		virtual U32				getLength() override;
+		virtual U32				read(U32 position, I8* destination, U32 length) override;
 
 	private:
 		I8*						m_memory;
@@ -61,6 +72,9 @@ namespace fluffy
 		virtual const I8		readByte(U8 offset = 0) override;
 		virtual void			nextByte() override;
 		virtual void			reset(U32 position) override;
+		virtual const I8*		getData() override;
+		virtual U32				getLength() override;
+		virtual U32				read(U32 position, I8* destination, U32 length) override;
 
 	private:
 		std::istream*			m_stream;
@@ -70,4 +84,31 @@ namespace fluffy
 		U32						m_fileSize;
 		U32						m_position;
 	};
+
+	/**
+	 * SharedBuffer
+	 */
+
+	class SharedBuffer : public BufferBase
+	{
+	public:
+								SharedBuffer();
+		virtual					~SharedBuffer();
+
+		virtual void			load(const I8* sourcePtr, const U32 len) override;
+		virtual void			loadFromFile(const I8* fileName) override;
+		virtual U32				getPosition() override;
+		virtual const I8		readByte(U8 offset = 0) override;
+		virtual void			nextByte() override;
+		virtual void			reset(U32 position) override;
+		virtual const I8*		getData() override;
+		virtual U32				getLength() override;
+		virtual U32				read(U32 position, I8* destination, U32 length) override;
+
+	private:
+		String					m_fileContent;
+		const I8*				m_memory;
+		U32						m_cursor;
+		U32						m_length;
+	};
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include "fl_defs.h"
 #include "fl_string.h"
 
@@ -6,6 +7,7 @@ namespace fluffy { namespace ast {
 	class AstNode;
 	class NamespaceDecl;
 	class CodeUnit;
+	class IncludeDecl;
 } }
 
 namespace fluffy { namespace parser {
@@ -20,12 +22,45 @@ namespace fluffy { namespace transformation {
 	class Transformation;
 } }
 
+namespace fluffy { namespace codegen {
+	class CodeGenerator;
+} }
+
 namespace fluffy { namespace scope {
 	class ScopeManager;
 	class NodeProcessor;
 } }
 
+namespace fluffy { namespace profiler {
+	class Profiler;
+} }
+
+namespace fluffy { namespace diagnostics {
+	class DiagnosticEngine;
+} }
+
 namespace fluffy {
+	/**
+	 * BuildResult_s
+	 */
+
+	// Resultado de um arquivo no build em lote, os tempos sao em microsegundos.
+	struct BuildResult_s
+	{
+		String								sourceFile;
+		Bool								isEntry;
+		Bool								success;
+		String								error;
+		U64									parseTime;
+		U64									processTime;
+
+		// O arquivo e seus includes nao mudaram desde a chamada anterior, o
+		// resultado foi reaproveitado e os tempos sao zero.
+		Bool								cached;
+	};
+
+	struct BatchFile_s;
+
 	/**
 	 * Compiler
 	 */
@@ -48,22 +83,87 @@ namespace fluffy {
 		void
 		build();
 
+		// Compila varios arquivos de entrada. Cada arquivo e analisado uma unica
+		// vez, mesmo se incluido por varias entradas, os arquivos de cada rodada
+		// de includes sao analisados em paralelo com o numero de tarefas do
+		// compilador. Os erros nao interrompem o lote, ficam no resultado do
+		// arquivo e dos arquivos que o incluem.
+		//
+		// Os code units ficam no compilador entre as chamadas, em uma nova chamada
+		// apenas os arquivos alterados, pela data e pelo hash do conteudo, e os
+		// que os incluem sao analisados e processados novamente.
+		std::vector<BuildResult_s>
+		buildBatch(const std::vector<String>& sourceFileList);
+
 		void
 		addBlockToBuild(String sourceFile, String sourceCode);
 
 		void
 		setNumberOfJobs(U32 jobCount);
 
+		void
+		setSkipFunctionBody(Bool skipFunctionBody);
+
+		void
+		setParallelFunctionBody(Bool parallelFunctionBody);
+
+		// O profiler nao pertence ao compilador, fica ativo durante o parse e
+		// o processamento dos code units.
+		void
+		setProfiler(profiler::Profiler* const profiler);
+
+		// Com motor de diagnosticos os erros de parse e dos processadores sao
+		// registrados nele e o build continua, um code unit que falha nao
+		// interrompe os demais. O motor nao pertence ao compilador.
+		void
+		setDiagnosticEngine(diagnostics::DiagnosticEngine* const diagnosticEngine);
+
 		void
 		applyTransformation(scope::NodeProcessor* const transformationProcessor);
 
 		void
 		applyValidation(scope::NodeProcessor* const validationProcessor);
 
+		void
+		applyCodeGeneration(codegen::CodeGenerator* const codeGenerator);
+
+		// Code units compilados na ordem em que foram processados.
+		const std::vector<ast::CodeUnit*>&
+		getExecutionTree();
+
 	private:
 		void
 		buildInternal(String sourceFile);
 
+		void
+		runNodeProcessors();
+
+		void
+		processCodeUnit(ast::CodeUnit* const codeUnit, const std::vector<String>& processorNameList);
+
+		// Executado apos o parse de cada code unit, antes dos includes serem resolvidos.
+		void
+		onCodeUnitParsed(ast::CodeUnit* const codeUnit);
+
+		// Registra o erro de um job de parse, falso sem motor de diagnosticos.
+		Bool
+		reportJobError(const String& sourceFile, const I8* error);
+
+		std::vector<String>
+		getProcessorNameList();
+
+		String
+		getIncludeFilename(ast::IncludeDecl* const includeDecl);
+
+		void
+		parseBatchFiles(const std::vector<BatchFile_s*>& parseList);
+
+		BatchFile_s*
+		getBatchFile(const String& sourceFile);
+
+		void
+		unregisterCodeUnit(ast::CodeUnit* const codeUnit);
+
 	private:
 		std::unordered_map<const TString, std::unique_ptr<ast::CodeUnit>, TStringHash, TStringEqual>
 		mApplicationTree;
@@ -88,5 +188,23 @@ namespace fluffy {
 
 		Bool
 		mBuildBlock;
+
+		Bool
+		mSkipFunctionBody;
+
+		Bool
+		mParallelFunctionBody;
+
+		profiler::Profiler*
+		mProfiler;
+
+		diagnostics::DiagnosticEngine*
+		mDiagnosticEngine;
+
+		std::unordered_map<String, std::unique_ptr<BatchFile_s>>
+		mBatchFileMap;
+
+		U32
+		mBatchGeneration;
 	};
 }
\ No newline at end of file
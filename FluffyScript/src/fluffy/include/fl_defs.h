@@ -2,6 +2,7 @@
 #include <unordered_map>
 #include <string>
 #include <vector>
+#include "fl_platform.h"
 
 namespace fluffy { namespace parser {
 	class Parser;
@@ -267,7 +268,8 @@ namespace fluffy {
 		EnumDecl,
 		TraitDecl,
 		VariableDecl,
-		FunctionDecl
+		FunctionDecl,
+		ErrorDecl
 	};
 
 	/**
@@ -364,7 +366,8 @@ namespace fluffy {
 		Try,
 		Panic,
 		Variable,
-		Expr
+		Expr,
+		Error
 	};
 
 	/**
@@ -414,6 +417,7 @@ namespace fluffy {
 		GenericDecl,
 		GenericItemDecl,
 		ScopedPathDecl,
+		ErrorDecl,
 
 		Block,
 
@@ -467,6 +471,7 @@ namespace fluffy {
 		StmtPanic,
 		StmtVariable,
 		StmtExpr,
+		StmtError,
 
 		StmtForInitDecl,
 		StmtMatchWhenDecl,
@@ -510,7 +515,13 @@ namespace fluffy {
 		ImplementedTraitList,
 		ImplementedTraitForList,
 		Scope,
-		ReferenceStack
+		ReferenceStack,
+		ExportSummary,
+		DeferredFunctionBody,
+		FrameSlot,
+		ResolvedType,
+		GenericInstance,
+		InternedType
 	};
 
 
@@ -525,11 +536,8 @@ namespace fluffy {
 
 		TokenType_e	type;
 
-		U32				line;
-		U32				column;
+		// Offset no codigo, a linha e a coluna sao obtidas pelo lexer.
 		U32				position;
-
-		String			filename;
 	};
 
 	/**
@@ -0,0 +1,57 @@
+#pragma once
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Compatibilidade
+ * Fora do MSVC as funcoes seguras da CRT sao implementadas com as funcoes
+ * padrao, com o mesmo comportamento de truncamento e terminacao.
+ */
+
+#ifndef _MSC_VER
+	inline int
+	getenv_s(size_t* requiredSize, char* buffer, size_t bufferSize, const char* name)
+	{
+		const char* value = std::getenv(name);
+
+		// Como no MSVC o tamanho inclui o terminador e e zero se a variavel nao existe.
+		*requiredSize = value != nullptr ? std::strlen(value) + 1 : 0;
+
+		if (buffer != nullptr && bufferSize != 0)
+		{
+			if (value == nullptr || *requiredSize > bufferSize)
+			{
+				buffer[0] = '\0';
+				return value == nullptr ? 0 : ERANGE;
+			}
+			std::memcpy(buffer, value, *requiredSize);
+		}
+		return 0;
+	}
+
+	inline int
+	vsprintf_s(char* buffer, size_t bufferSize, const char* format, va_list list)
+	{
+		return std::vsnprintf(buffer, bufferSize, format, list);
+	}
+
+	template <
+		typename... TArgs
+	> inline int
+	sprintf_s(char* buffer, size_t bufferSize, const char* format, TArgs... args)
+	{
+		return std::snprintf(buffer, bufferSize, format, args...);
+	}
+
+	template <
+		size_t TSize,
+		typename... TArgs
+	> inline int
+	sprintf_s(char (&buffer)[TSize], const char* format, TArgs... args)
+	{
+		return std::snprintf(buffer, TSize, format, args...);
+	}
+#endif
@@ -1,6 +1,6 @@
 #pragma once
 #include <memory>
-#include "ast\fl_ast_decl.h"
+#include "ast/fl_ast_decl.h"
 namespace fluffy { namespace generics {
 	/**
 	 * TClone
@@ -71,6 +71,8 @@ namespace fluffy { namespace generics {
 			newDecl->isExported = decl->isExported;
 
 			newDecl->genericDecl = clone_single(decl->genericDecl);
+			newDecl->baseClass = clone_single(decl->baseClass);
+			newDecl->interfaceList = clone_each(decl->interfaceList);
 			newDecl->constructorList = clone_each(decl->constructorList);
 			newDecl->destructorDecl = clone_single(decl->destructorDecl);			
 			newDecl->functionList = clone_each(decl->functionList);
@@ -201,6 +203,76 @@ namespace fluffy { namespace generics {
 		}
 	};
 
+	/**
+	 * TClone -> StructDecl
+	 */
+
+	template <>
+	struct TClone<ast::StructDecl>
+	{
+		static ast::StructDecl* const
+		clone(ast::StructDecl* const decl)
+		{
+			ast::StructDecl* const newDecl = new ast::StructDecl(decl->line, decl->column);
+
+			newDecl->identifier = decl->identifier;
+			newDecl->isExported = decl->isExported;
+
+			newDecl->genericDecl = clone_single(decl->genericDecl);
+			newDecl->variableList = clone_each(decl->variableList);
+
+			return newDecl;
+		}
+	};
+
+	/**
+	 * TClone -> StructVariableDecl
+	 */
+
+	template <>
+	struct TClone<ast::StructVariableDecl>
+	{
+		static ast::StructVariableDecl* const
+		clone(ast::StructVariableDecl* const decl)
+		{
+			ast::StructVariableDecl* const newDecl = new ast::StructVariableDecl(decl->line, decl->column);
+
+			newDecl->identifier = decl->identifier;
+			newDecl->isConst = decl->isConst;
+			newDecl->isReference = decl->isReference;
+			newDecl->isShared = decl->isShared;
+			newDecl->isUnique = decl->isUnique;
+
+			newDecl->typeDecl = clone_single(decl->typeDecl);
+
+			return newDecl;
+		}
+	};
+
+	/**
+	 * TClone -> FunctionDecl
+	 */
+
+	template <>
+	struct TClone<ast::FunctionDecl>
+	{
+		static ast::FunctionDecl* const
+		clone(ast::FunctionDecl* const decl)
+		{
+			ast::FunctionDecl* const newDecl = new ast::FunctionDecl(decl->line, decl->column);
+
+			newDecl->identifier = decl->identifier;
+			newDecl->isExported = decl->isExported;
+
+			newDecl->genericDecl = clone_single(decl->genericDecl);
+
+			newDecl->parameterList = clone_each(decl->parameterList);
+			newDecl->returnType = clone_single(decl->returnType);
+
+			return newDecl;
+		}
+	};
+
 	/**
 	 * TClone -> InterfaceDecl
 	 */
@@ -0,0 +1,143 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "ast/fl_ast_decl.h"
+#include "scope/fl_scope_manager.h"
+
+namespace fluffy { namespace ast { namespace expr {
+	class ExpressionGenericCallDecl;
+} } }
+
+namespace fluffy { namespace generics {
+	using SubstitutionMap = std::unordered_map<ast::AstNode*, ast::TypeDecl*>;
+
+	/**
+	 * Instance_s
+	 */
+
+	struct Instance_s
+	{
+		// Declaracao generica e argumentos na ordem dos itens do generic.
+		ast::AstNode*						genericDecl;
+		ast::TypeDeclPtrList				argumentList;
+
+		// Chave canonica da instancia, ex: 'List<i32>'.
+		String								key;
+
+		// Copia da declaracao com os itens do generic substituidos pelos argumentos.
+		std::unique_ptr<ast::AstNode>		specializedDecl;
+
+		// Quantidade de usos da instancia.
+		U32									useCount;
+	};
+
+	/**
+	 * InstanceCache
+	 */
+
+	// Deduplica as instancias pela chave canonica dos tipos: cada combinacao de
+	// declaracao e argumentos e especializada uma unica vez, os demais usos
+	// recebem a mesma copia.
+	class InstanceCache
+	{
+	public:
+		InstanceCache();
+		~InstanceCache();
+
+		Instance_s*
+		instantiate(ast::AstNode* const genericDecl, const ast::TypeDeclPtrList& argumentList);
+
+		Instance_s*
+		findInstance(const String& key);
+
+		const std::vector<Instance_s*>&
+		getInstanceList();
+
+		// Quantidade de usos atendidos sem copiar a declaracao.
+		U32
+		getHitCount();
+
+		// Chave canonica do tipo, tipos nomeados usam a declaracao referenciada.
+		String
+		getTypeKey(ast::TypeDecl* const typeDecl);
+
+		// Verifica se o tipo depende de itens de um generic ainda nao substituidos.
+		static Bool
+		isOpen(ast::TypeDecl* const typeDecl);
+
+		static ast::GenericDecl*
+		getGenericDecl(ast::AstNode* const decl);
+
+	private:
+		String
+		getDeclName(ast::AstNode* const decl);
+
+		ast::AstNode*
+		specialize(ast::AstNode* const genericDecl, const SubstitutionMap& substitutionMap);
+
+	private:
+		std::unordered_map<String, std::unique_ptr<Instance_s>>
+		mInstanceMap;
+
+		// Instancias na ordem em que foram criadas.
+		std::vector<Instance_s*>
+		mInstanceList;
+
+		// Nome de cada declaracao na chave, declaracoes homonimas recebem sufixo.
+		std::unordered_map<ast::AstNode*, String>
+		mDeclNameMap;
+
+		std::unordered_map<String, U32>
+		mDeclNameCount;
+
+		U32
+		mHitCount;
+	};
+
+	/**
+	 * Monomorphizer
+	 */
+
+	// Coleta as instancias de generics fechados (tipos nomeados com argumentos e
+	// chamadas 'f<T>()' de funcoes genericas) depois do ResolveTypes. O uso recebe
+	// o atributo GenericInstance apontando para a instancia compartilhada.
+	class Monomorphizer : public scope::NodeProcessor
+	{
+	public:
+		Monomorphizer();
+		virtual ~Monomorphizer();
+
+		virtual void
+		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
+
+		InstanceCache*
+		getInstanceCache();
+
+	private:
+		void
+		collectNamedType(ast::TypeDeclNamed* const namedType);
+
+		void
+		collectGenericCall(ast::expr::ExpressionGenericCallDecl* const genericCallDecl);
+
+		Bool
+		canInstantiate(ast::AstNode* const genericDecl, const ast::TypeDeclPtrList& argumentList);
+
+	private:
+		scope::ScopeManager*
+		mScopeManager;
+
+		InstanceCache
+		mInstanceCache;
+	};
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	// Copia o tipo substituindo os itens do generic, as referencias resolvidas
+	// sao preservadas.
+	ast::TypeDeclPtr
+	specializeType(ast::TypeDecl* const typeDecl, const SubstitutionMap& substitutionMap);
+} }
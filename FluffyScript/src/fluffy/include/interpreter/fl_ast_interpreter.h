@@ -0,0 +1,249 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "attributes/fl_frame_slot.h"
+#include "interpreter/fl_program.h"
+#include "match/fl_match_compiler.h"
+#include "vm/fl_value.h"
+
+namespace fluffy { namespace ast {
+	class AstNode;
+	class BlockDecl;
+
+	namespace expr {
+		class ExpressionDecl;
+		class ExpressionBinaryDecl;
+		class ExpressionUnaryDecl;
+		class ExpressionNewDecl;
+	}
+
+	namespace stmt {
+		class StmtDecl;
+	}
+
+	namespace pattern {
+		class PatternDecl;
+	}
+} }
+
+namespace fluffy { namespace interpreter {
+	/**
+	 * Completion_e
+	 */
+
+	enum class Completion_e
+	{
+		Normal,
+		Break,
+		Continue,
+		Return
+	};
+
+	/**
+	 * InterpreterClass_s
+	 */
+
+	struct InterpreterClass_s
+	{
+		ScriptClass_s*						classInfo = nullptr;
+		U32									fieldCount = 0;
+
+		// Campos e metodos da classe e das classes base, ja resolvidas as sobrescritas.
+		std::unordered_map<String, U32>		fieldMap;
+		std::unordered_map<String, U32>		methodMap;
+	};
+
+	/**
+	 * InterpreterFrame_s
+	 */
+
+	struct InterpreterFrame_s
+	{
+		ScriptFunction_s*					function;
+		vm::Value_s*						base;
+		U32									line;
+	};
+
+	/**
+	 * AstInterpreter
+	 */
+
+	// Executa diretamente a arvore anotada pelo SlotResolver: variaveis locais sao
+	// acessadas pelo indice no frame e campos e metodos usam o cache do FrameSlot.
+	// Os valores e objetos sao os mesmos da maquina virtual.
+	class AstInterpreter : public match::PatternResolver
+	{
+	public:
+		AstInterpreter(Program* const program);
+		virtual ~AstInterpreter();
+
+		void
+		initialize();
+
+		vm::Value_s
+		call(const String& functionName, const std::vector<vm::Value_s>& argumentList);
+
+		vm::Value_s
+		call(U32 functionIndex, const std::vector<vm::Value_s>& argumentList);
+
+		vm::Value_s
+		getGlobal(const String& globalName);
+
+		vm::Value_s
+		makeString(String value);
+
+		String
+		toString(const vm::Value_s& value);
+
+		void
+		collectGarbage();
+
+		U32
+		getObjectCount();
+
+		U64
+		getInlineCacheMissCount();
+
+		// Itens de enum sao comparados pelo valor, variaveis globais sao dinamicas.
+		virtual match::PatternInfo_s
+		resolve(ast::pattern::PatternDecl* const patternDecl) override;
+
+		virtual String
+		getItemName(const void* const domain, U32 index) override;
+
+	private:
+		void
+		prepareClass(U32 classIndex);
+
+		vm::Value_s
+		invoke(U32 functionIndex, vm::Value_s* const callBase, U32 argumentCount);
+
+		vm::Value_s
+		runFunction(ScriptFunction_s* const function);
+
+		void
+		runInitializers(ScriptFunction_s* const function);
+
+		Completion_e
+		execBlock(ast::BlockDecl* const blockDecl);
+
+		Completion_e
+		execStmt(ast::stmt::StmtDecl* const stmtDecl);
+
+		vm::Value_s
+		eval(ast::expr::ExpressionDecl* const exprDecl);
+
+		vm::Value_s
+		evalBinary(ast::expr::ExpressionBinaryDecl* const binaryDecl);
+
+		vm::Value_s
+		evalUnary(ast::expr::ExpressionUnaryDecl* const unaryDecl);
+
+		vm::Value_s
+		evalCall(ast::expr::ExpressionDecl* const lhsDecl, ast::expr::ExpressionDecl* const argumentsDecl);
+
+		vm::Value_s
+		evalNew(ast::expr::ExpressionNewDecl* const newDecl);
+
+		vm::Value_s
+		evalAssign(ast::expr::ExpressionDecl* const targetDecl, ast::expr::ExpressionDecl* const valueDecl, codegen::OpCode_e op, Bool postfix);
+
+		vm::Value_s
+		loadSlot(ast::AstNode* const node);
+
+		void
+		storeSlot(ast::AstNode* const node, const vm::Value_s& value);
+
+		Bool
+		matchPattern(ast::pattern::PatternDecl* const patternDecl, const vm::Value_s& subject);
+
+		// Tabela de saltos do match, compilada na primeira execucao. Retorna nulo
+		// quando os bracos nao comparam o valor com inteiros constantes.
+		const match::JumpTable_s*
+		findJumpTable(ast::AstNode* const matchDecl);
+
+		// Primeiro braco que pode corresponder ao valor, 'matched' indica que o
+		// teste do braco ja foi satisfeito pela tabela.
+		void
+		selectArm(ast::AstNode* const matchDecl, const vm::Value_s& subject, U32& armIndex, Bool& matched);
+
+		U32
+		pushArguments(ast::expr::ExpressionDecl* const argumentsDecl);
+
+		vm::Value_s
+		executeArithmetic(codegen::OpCode_e op, const vm::Value_s& lhs, const vm::Value_s& rhs);
+
+		vm::Value_s
+		executeComparison(codegen::OpCode_e op, const vm::Value_s& lhs, const vm::Value_s& rhs);
+
+		vm::InstanceObject_s*
+		getInstance(const vm::Value_s& value, const I8* operation);
+
+		U32
+		getFieldIndex(attributes::FrameSlot* const frameSlot, vm::InstanceObject_s* const instance, const String& fieldName);
+
+		U32
+		getMethodIndex(attributes::FrameSlot* const frameSlot, vm::InstanceObject_s* const instance, const String& methodName);
+
+		vm::Value_s&
+		getThis();
+
+		void
+		push(const vm::Value_s& value);
+
+		template <typename TObject, typename... TArgs>
+		TObject*
+		allocate(TArgs&&... args);
+
+		[[noreturn]] void
+		throwRuntimeError(const String& message);
+
+	private:
+		Program*
+		mProgram;
+
+		std::vector<InterpreterClass_s>
+		mClassList;
+
+		std::vector<vm::Value_s>
+		mGlobalList;
+
+		// Strings constantes do programa, nunca sao coletadas.
+		std::vector<vm::Value_s>
+		mConstantList;
+
+		// Pilha de valores: slots dos frames e valores temporarios mantidos
+		// vivos durante a avaliacao das expressoes.
+		std::vector<vm::Value_s>
+		mStack;
+
+		vm::Value_s*
+		mTop;
+
+		std::vector<InterpreterFrame_s>
+		mFrameList;
+
+		std::unordered_map<ast::AstNode*, std::unique_ptr<match::JumpTable_s>>
+		mJumpTableMap;
+
+		// Valor do ultimo 'return' executado.
+		vm::Value_s
+		mReturnValue;
+
+		vm::HeapObject_s*
+		mObjectList;
+
+		U32
+		mObjectCount;
+
+		U32
+		mNextCollection;
+
+		U64
+		mInlineCacheMissCount;
+
+		Bool
+		mInitialized;
+	};
+} }
@@ -0,0 +1,210 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "fl_defs.h"
+
+namespace fluffy { namespace ast {
+	class AstNode;
+	class BlockDecl;
+
+	namespace expr {
+		class ExpressionDecl;
+	}
+} }
+
+namespace fluffy { namespace interpreter {
+	static constexpr const U32 invalidIndex = 0xFFFFFFFF;
+
+	/**
+	 * FunctionType_e
+	 */
+
+	enum class FunctionType_e
+	{
+		Function,
+		Method,
+		Constructor,
+		ClassInit,
+		GlobalInit
+	};
+
+	/**
+	 * Initializer_s
+	 */
+
+	struct Initializer_s
+	{
+		// Declaracao anotada com o slot do campo ou da variavel global.
+		ast::AstNode*						decl;
+		ast::expr::ExpressionDecl*			initExpr;
+	};
+
+	/**
+	 * ScriptFunction_s
+	 */
+
+	struct ScriptFunction_s
+	{
+		String								name;
+		FunctionType_e						type;
+
+		// Metodos recebem 'this' no slot 0, que nao e contado em parameterCount.
+		Bool								isMethod;
+		U32									parameterCount;
+
+		// Quantidade de slots do frame, incluindo parametros e variaveis locais.
+		U32									frameSize;
+
+		U32									classIndex;
+
+		// Construtor ou inicializador da classe base executado antes do corpo.
+		U32									baseFunctionIndex;
+
+		ast::AstNode*						decl;
+		ast::BlockDecl*						blockDecl;
+		ast::expr::ExpressionDecl*			exprDecl;
+
+		// Campos ou variaveis globais inicializados antes do corpo.
+		std::vector<Initializer_s>			initializerList;
+	};
+
+	/**
+	 * ScriptMethod_s
+	 */
+
+	struct ScriptMethod_s
+	{
+		String								name;
+		U32									functionIndex;
+	};
+
+	/**
+	 * ScriptClass_s
+	 */
+
+	struct ScriptClass_s
+	{
+		String								name;
+		U32									baseClassIndex;
+
+		// Campos na ordem de declaracao, sem os campos da classe base.
+		std::vector<String>					fieldList;
+		std::vector<ScriptMethod_s>			methodList;
+		std::vector<U32>					constructorList;
+
+		U32									initFunctionIndex;
+	};
+
+	/**
+	 * Program
+	 */
+
+	class Program
+	{
+	public:
+		Program();
+		virtual ~Program();
+
+		U32
+		insertFunction(const String& name, FunctionType_e type);
+
+		U32
+		findFunction(const String& name);
+
+		U32
+		insertGlobal(const String& name);
+
+		U32
+		findGlobal(const String& name);
+
+		U32
+		insertClass(const String& name);
+
+		U32
+		findClass(const String& name);
+
+		U32
+		findMethod(U32 classIndex, const String& name);
+
+		// Os campos da classe base ocupam os primeiros indices do objeto.
+		U32
+		findField(U32 classIndex, const String& name);
+
+		U32
+		getFieldCount(U32 classIndex);
+
+		Bool
+		isSubclassOf(U32 classIndex, U32 baseClassIndex);
+
+		void
+		insertEnumItem(const String& name, I64 value);
+
+		Bool
+		findEnumItem(const String& name, I64& value);
+
+		U32
+		insertStringConstant(const String& value);
+
+		const String&
+		getStringConstant(U32 constantIndex);
+
+		void
+		insertInitFunction(U32 functionIndex);
+
+		ScriptFunction_s* const
+		getFunction(U32 functionIndex);
+
+		ScriptClass_s* const
+		getClass(U32 classIndex);
+
+		const String&
+		getGlobalName(U32 globalIndex);
+
+		U32
+		getFunctionCount();
+
+		U32
+		getClassCount();
+
+		U32
+		getGlobalCount();
+
+		U32
+		getStringConstantCount();
+
+		const std::vector<U32>&
+		getInitFunctionList();
+
+	private:
+		std::vector<std::unique_ptr<ScriptFunction_s>>
+		mFunctionList;
+
+		std::unordered_map<String, U32>
+		mFunctionMap;
+
+		std::vector<String>
+		mGlobalList;
+
+		std::unordered_map<String, U32>
+		mGlobalMap;
+
+		std::vector<std::unique_ptr<ScriptClass_s>>
+		mClassList;
+
+		std::unordered_map<String, U32>
+		mClassMap;
+
+		std::unordered_map<String, I64>
+		mEnumItemMap;
+
+		std::vector<String>
+		mStringConstantList;
+
+		std::unordered_map<String, U32>
+		mStringConstantMap;
+
+		std::vector<U32>
+		mInitFunctionList;
+	};
+} }
@@ -0,0 +1,271 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "attributes/fl_frame_slot.h"
+#include "interpreter/fl_program.h"
+#include "scope/fl_scope_manager.h"
+
+namespace fluffy { namespace ast {
+	class CodeUnit;
+	class NamespaceDecl;
+	class BlockDecl;
+	class ClassDecl;
+	class StructDecl;
+	class EnumDecl;
+	class TraitForDecl;
+	class FunctionDecl;
+	class VariableDecl;
+	class FunctionParameterDecl;
+	class ClassFunctionDecl;
+	class ClassConstructorDecl;
+	class TraitFunctionDecl;
+	class TypeDecl;
+
+	namespace expr {
+		class ExpressionDecl;
+		class ExpressionBinaryDecl;
+		class ExpressionNewDecl;
+	}
+
+	namespace stmt {
+		class StmtDecl;
+	}
+
+	namespace pattern {
+		class PatternDecl;
+	}
+} }
+
+namespace fluffy { namespace interpreter {
+	using FunctionParameterDeclPtrList = std::vector<std::unique_ptr<ast::FunctionParameterDecl>>;
+
+	/**
+	 * SymbolType_e
+	 */
+
+	enum class SymbolType_e
+	{
+		Unknown,
+		Local,
+		Field,
+		Global,
+		Function,
+		Method,
+		Class,
+		EnumItem
+	};
+
+	/**
+	 * Symbol_s
+	 */
+
+	struct Symbol_s
+	{
+		SymbolType_e						type;
+		U32									index;
+		I64									value;
+	};
+
+	/**
+	 * LocalSlot_s
+	 */
+
+	struct LocalSlot_s
+	{
+		String								name;
+		U32									slot;
+	};
+
+	/**
+	 * FunctionScope_s
+	 */
+
+	struct FunctionScope_s
+	{
+		ScriptFunction_s*					function;
+		std::vector<LocalSlot_s>			localList;
+		U32									freeSlot;
+		U32									loopDepth;
+	};
+
+	/**
+	 * ResolverScope_s
+	 */
+
+	struct ResolverScope_s
+	{
+		String								path;
+		U32									classIndex;
+	};
+
+	/**
+	 * SlotResolver
+	 */
+
+	// Resolve uma unica vez os nomes dos code units validados: cada identificador,
+	// variavel e parametro recebe um FrameSlot e cada tipo consultado em tempo de
+	// execucao recebe um ResolvedType, o interpretador nao consulta nomes.
+	class SlotResolver : public scope::NodeProcessor
+	{
+	public:
+		SlotResolver();
+		virtual ~SlotResolver();
+
+		virtual void
+		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
+
+		Program* const
+		getProgram();
+
+	private:
+		void
+		beginCodeUnit(ast::CodeUnit* const codeUnit);
+
+		void
+		endCodeUnit();
+
+		void
+		declareScope(const String& scopePath, ast::NamespaceDecl* const namespaceDecl);
+
+		void
+		declareClass(const String& classPath, ast::ClassDecl* const classDecl);
+
+		void
+		declareStruct(const String& structPath, ast::StructDecl* const structDecl);
+
+		void
+		declareEnum(const String& enumPath, ast::EnumDecl* const enumDecl);
+
+		void
+		linkScope(const String& scopePath, ast::NamespaceDecl* const namespaceDecl);
+
+		void
+		pushScope(const String& scopePath, U32 classIndex);
+
+		void
+		popScope();
+
+		void
+		beginClass(ast::ClassDecl* const classDecl);
+
+		void
+		beginTraitFor(ast::TraitForDecl* const traitForDecl);
+
+		void
+		resolveStructInit(ast::StructDecl* const structDecl);
+
+		void
+		resolveClassFunction(ast::ClassFunctionDecl* const classFunctionDecl);
+
+		void
+		resolveTraitFunction(ast::TraitFunctionDecl* const traitFunctionDecl);
+
+		void
+		resolveConstructor(ast::ClassConstructorDecl* const constructorDecl);
+
+		void
+		resolveGlobalVariable(ast::VariableDecl* const variableDecl);
+
+		void
+		resolveFunctionBody(U32 functionIndex, ast::AstNode* const decl, FunctionParameterDeclPtrList& parameterList, ast::BlockDecl* const blockDecl, ast::expr::ExpressionDecl* const exprDecl);
+
+		void
+		beginFunction(FunctionScope_s& functionScope, U32 functionIndex, ast::AstNode* const decl);
+
+		void
+		declareParameters(FunctionParameterDeclPtrList& parameterList);
+
+		void
+		resolveBlock(ast::BlockDecl* const blockDecl);
+
+		void
+		resolveStmt(ast::stmt::StmtDecl* const stmtDecl);
+
+		void
+		resolveExpr(ast::expr::ExpressionDecl* const exprDecl);
+
+		void
+		resolveBinary(ast::expr::ExpressionBinaryDecl* const binaryDecl);
+
+		void
+		resolveAssignTarget(ast::expr::ExpressionDecl* const exprDecl);
+
+		void
+		resolveCall(ast::expr::ExpressionDecl* const lhsDecl, ast::expr::ExpressionDecl* const argumentsDecl);
+
+		void
+		resolveNew(ast::expr::ExpressionNewDecl* const newDecl);
+
+		void
+		resolvePattern(ast::pattern::PatternDecl* const patternDecl);
+
+		void
+		resolveArguments(ast::expr::ExpressionDecl* const argumentsDecl);
+
+		void
+		resolveType(ast::TypeDecl* const typeDecl);
+
+		U32
+		resolveClass(ast::TypeDecl* const typeDecl);
+
+		U32
+		findConstructor(U32 classIndex, ast::expr::ExpressionDecl* const argumentsDecl);
+
+		void
+		bindSymbol(ast::AstNode* const node, const Symbol_s& symbol, const String& identifier);
+
+		Symbol_s
+		resolveSymbol(const String& identifier, Bool startFromRoot);
+
+		Symbol_s
+		resolvePath(const String& path);
+
+		Bool
+		buildScopedPath(ast::expr::ExpressionDecl* const exprDecl, String& path, Bool& startFromRoot);
+
+		void
+		collectArguments(ast::expr::ExpressionDecl* const exprDecl, std::vector<ast::expr::ExpressionDecl*>& argumentList);
+
+		void
+		declareLocal(const String& identifier, U32 slot);
+
+		U32
+		findLocal(const String& identifier);
+
+		U32
+		allocateSlot();
+
+		void
+		setSlot(ast::AstNode* const node, attributes::SlotType_e slotType, U32 index, I64 value);
+
+	private:
+		std::unique_ptr<Program>
+		mProgram;
+
+		ast::CodeUnit*
+		mCodeUnit;
+
+		String
+		mFilename;
+
+		std::vector<ResolverScope_s>
+		mScopeStack;
+
+		std::unordered_map<String, String>
+		mIncludeAliasMap;
+
+		std::vector<String>
+		mIncludeWildcardList;
+
+		// Indice da funcao declarada para cada declaracao.
+		std::unordered_map<ast::AstNode*, U32>
+		mFunctionIndexMap;
+
+		std::unique_ptr<FunctionScope_s>
+		mInitFunction;
+
+		FunctionScope_s*
+		mFunction;
+	};
+} }
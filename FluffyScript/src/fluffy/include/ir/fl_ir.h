@@ -0,0 +1,370 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "vm/fl_value.h"
+#include "fl_defs.h"
+
+namespace fluffy { namespace ir {
+	static constexpr const U32 invalidIndex = 0xFFFFFFFF;
+
+	class Block;
+	class Function;
+
+	/**
+	 * Type_e
+	 */
+
+	// Os primeiros tipos seguem a ordem de vm::ValueType_e, Any e usado quando o
+	// tipo so e conhecido em tempo de execucao.
+	enum class Type_e : U8
+	{
+		Null,
+		Bool,
+		I8,
+		U8,
+		I16,
+		U16,
+		I32,
+		U32,
+		I64,
+		U64,
+		Fp32,
+		Fp64,
+		String,
+		Object,
+		Array,
+		Function,
+		Void,
+		Any
+	};
+
+	/**
+	 * Opcode_e
+	 */
+
+	enum class Opcode_e : U8
+	{
+		// Valores
+		Constant,
+		Parameter,
+		Phi,
+		FunctionRef,
+
+		// Operacoes
+		Neg,
+		BitNot,
+		Not,
+		Add,
+		Sub,
+		Mul,
+		Div,
+		Mod,
+		Shl,
+		Shr,
+		BitAnd,
+		BitOr,
+		BitXor,
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Cast,
+		IsType,
+		IsClass,
+		CastClass,
+
+		// Memoria
+		LoadGlobal,
+		StoreGlobal,
+		LoadField,
+		StoreField,
+		LoadIndex,
+		StoreIndex,
+		NewArray,
+		New,
+
+		// Chamadas
+		Call,
+		CallMethod,
+		CallValue,
+
+		// Terminadores
+		Jump,
+		Branch,
+		Return,
+		Panic,
+
+		Count
+	};
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	const I8*
+	getOpcodeName(Opcode_e op);
+
+	const I8*
+	getTypeName(Type_e type);
+
+	Type_e
+	toType(PrimitiveTypeID_e primitiveType);
+
+	inline vm::ValueType_e
+	toValueType(Type_e type)
+	{
+		return static_cast<vm::ValueType_e>(type);
+	}
+
+	inline Type_e
+	toType(vm::ValueType_e type)
+	{
+		return static_cast<Type_e>(type);
+	}
+
+	inline Bool
+	isTerminator(Opcode_e op)
+	{
+		return op >= Opcode_e::Jump;
+	}
+
+	inline Bool
+	isBinary(Opcode_e op)
+	{
+		return op >= Opcode_e::Add && op <= Opcode_e::GreaterEqual;
+	}
+
+	inline Bool
+	isComparison(Opcode_e op)
+	{
+		return op >= Opcode_e::Equal && op <= Opcode_e::GreaterEqual;
+	}
+
+	inline Bool
+	isNumberType(Type_e type)
+	{
+		return type >= Type_e::I8 && type <= Type_e::Fp64;
+	}
+
+	// Tipo do resultado de uma operacao binaria, segue as regras da maquina virtual.
+	Type_e
+	getBinaryType(Opcode_e op, Type_e lhs, Type_e rhs);
+
+	// Opcode do bytecode com a mesma semantica, usado para avaliar constantes.
+	codegen::OpCode_e
+	toBytecodeOp(Opcode_e op);
+
+	/**
+	 * Instruction
+	 */
+
+	// Cada instrucao e tambem o valor que ela define. Os usuarios sao mantidos
+	// junto com os operandos para que a substituicao de valores seja local.
+	class Instruction
+	{
+	public:
+		Instruction(Opcode_e op, Type_e type);
+		~Instruction();
+
+		void
+		appendOperand(Instruction* const value);
+
+		void
+		setOperand(U32 operandIndex, Instruction* const value);
+
+		void
+		removeOperand(U32 operandIndex);
+
+		void
+		dropOperands();
+
+		void
+		replaceAllUsesWith(Instruction* const value);
+
+		Bool
+		hasSideEffects();
+
+		// Instrucoes que podem gerar um erro em tempo de execucao.
+		Bool
+		mayTrap();
+
+		Bool
+		isConstant();
+
+	public:
+		Opcode_e							op;
+		Type_e								type;
+		Block*								block;
+
+		// Numeracao usada pela impressao, atribuida por Function::renumber.
+		U32									id;
+		U32									line;
+
+		std::vector<Instruction*>			operandList;
+		std::vector<Instruction*>			userList;
+
+		// Jump: destino, Branch: destino verdadeiro e falso.
+		std::vector<Block*>					targetList;
+
+		// Constant: valor primitivo, strings usam 'index' como constante do programa.
+		vm::Value_s							value;
+
+		// Parameter: slot, LoadGlobal/StoreGlobal: variavel global, LoadField/StoreField:
+		// campo quando conhecido, Call/FunctionRef: funcao, New/IsClass/CastClass: classe.
+		U32									index;
+
+		// New: construtor.
+		U32									auxIndex;
+
+		// Cast/IsType: tipo primitivo de destino.
+		PrimitiveTypeID_e					primitiveType;
+
+		// LoadField/StoreField/CallMethod: nome do membro.
+		String								name;
+	};
+
+	/**
+	 * Block
+	 */
+
+	class Block
+	{
+	public:
+		Block(Function* const function, U32 id);
+		~Block();
+
+		Instruction*
+		append(std::unique_ptr<Instruction> instruction);
+
+		Instruction*
+		insertAt(U32 position, std::unique_ptr<Instruction> instruction);
+
+		Instruction*
+		insertBeforeTerminator(std::unique_ptr<Instruction> instruction);
+
+		// Remove a instrucao do bloco e devolve a posse para quem chamou.
+		std::unique_ptr<Instruction>
+		remove(Instruction* const instruction);
+
+		void
+		erase(Instruction* const instruction);
+
+		Instruction*
+		getTerminator();
+
+		// Remove uma ocorrencia do predecessor e o operando correspondente dos phis.
+		void
+		removePredecessor(Block* const predecessor);
+
+		void
+		replacePredecessor(Block* const oldPredecessor, Block* const newPredecessor);
+
+		std::vector<Block*>
+		getSuccessorList();
+
+	public:
+		Function*							function;
+		U32									id;
+
+		std::vector<std::unique_ptr<Instruction>>
+											instructionList;
+
+		// A ordem dos predecessores e a ordem dos operandos dos phis.
+		std::vector<Block*>					predecessorList;
+	};
+
+	/**
+	 * Function
+	 */
+
+	class Function
+	{
+	public:
+		Function(const String& name, U32 functionIndex);
+		~Function();
+
+		Block*
+		createBlock();
+
+		Block*
+		getEntry();
+
+		void
+		eraseBlock(Block* const block);
+
+		// Blocos em pos-ordem reversa a partir da entrada, sem os inalcancaveis.
+		std::vector<Block*>
+		getReversePostOrder();
+
+		// Remove os blocos inalcancaveis, retorna true se houve alteracao.
+		Bool
+		removeUnreachableBlocks();
+
+		void
+		renumber();
+
+		U32
+		getInstructionCount();
+
+		// Valida as invariantes do SSA, lanca uma excecao quando falham.
+		void
+		verify();
+
+		String
+		dump();
+
+	public:
+		String								name;
+		U32									functionIndex;
+
+		// Slots recebidos como parametro, incluindo o 'this' dos metodos.
+		U32									parameterCount;
+		Type_e								returnType;
+
+		std::vector<std::unique_ptr<Block>>	blockList;
+
+	private:
+		U32
+		mNextBlockId;
+	};
+
+	/**
+	 * Module
+	 */
+
+	class Module
+	{
+	public:
+		Module();
+		~Module();
+
+		Function*
+		insertFunction(std::unique_ptr<Function> function);
+
+		Function*
+		getFunction(U32 functionIndex);
+
+		Function*
+		findFunction(const String& name);
+
+		U32
+		getFunctionCount();
+
+		U32
+		getInstructionCount();
+
+		String
+		dump();
+
+	public:
+		// Copia das strings constantes do programa, usada na impressao.
+		std::vector<String>					stringConstantList;
+
+	private:
+		// Indexado pelo indice da funcao no programa.
+		std::vector<std::unique_ptr<Function>>
+		mFunctionList;
+	};
+} }
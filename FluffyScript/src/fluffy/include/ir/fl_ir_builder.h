@@ -0,0 +1,234 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "ir/fl_ir.h"
+#include "interpreter/fl_program.h"
+
+namespace fluffy { namespace ast {
+	class AstNode;
+	class BlockDecl;
+	class TypeDecl;
+
+	namespace expr {
+		class ExpressionDecl;
+		class ExpressionBinaryDecl;
+		class ExpressionUnaryDecl;
+		class ExpressionNewDecl;
+	}
+
+	namespace stmt {
+		class StmtDecl;
+	}
+
+	namespace pattern {
+		class PatternDecl;
+	}
+} }
+
+namespace fluffy { namespace ir {
+	/**
+	 * BlockState_s
+	 */
+
+	struct BlockState_s
+	{
+		// Definicao corrente de cada slot local no bloco.
+		std::unordered_map<U32, Instruction*>
+											definitionMap;
+
+		// Phis criados antes de todos os predecessores serem conhecidos.
+		std::vector<std::pair<U32, Instruction*>>
+											incompletePhiList;
+
+		Bool								sealed;
+	};
+
+	/**
+	 * LoopTarget_s
+	 */
+
+	struct LoopTarget_s
+	{
+		Block*								breakBlock;
+		Block*								continueBlock;
+	};
+
+	/**
+	 * IrBuilder
+	 */
+
+	// Gera o SSA a partir da arvore anotada pelo SlotResolver. As variaveis locais
+	// sao os slots do frame e os phis sao criados durante a geracao, selando cada
+	// bloco quando todos os seus predecessores sao conhecidos.
+	class IrBuilder
+	{
+	public:
+		IrBuilder(interpreter::Program* const program);
+		~IrBuilder();
+
+		std::unique_ptr<Module>
+		build();
+
+	private:
+		std::unique_ptr<Function>
+		buildFunction(U32 functionIndex);
+
+		void
+		declareParameters(interpreter::ScriptFunction_s* const scriptFunction);
+
+		void
+		buildInitializers(interpreter::ScriptFunction_s* const scriptFunction);
+
+		void
+		buildBlock(ast::BlockDecl* const blockDecl);
+
+		void
+		buildStmt(ast::stmt::StmtDecl* const stmtDecl);
+
+		Instruction*
+		buildExpr(ast::expr::ExpressionDecl* const exprDecl);
+
+		Instruction*
+		buildBinary(ast::expr::ExpressionBinaryDecl* const binaryDecl);
+
+		Instruction*
+		buildUnary(ast::expr::ExpressionUnaryDecl* const unaryDecl);
+
+		// Gera os desvios da condicao sem materializar o valor dos operadores '&&', '||' e '!'.
+		void
+		buildCondition(ast::expr::ExpressionDecl* const conditionDecl, Block* const trueBlock, Block* const falseBlock);
+
+		Instruction*
+		buildShortCircuit(ast::expr::ExpressionBinaryDecl* const binaryDecl);
+
+		// Operador '?.': o resultado e nulo quando o objeto e nulo.
+		Instruction*
+		buildSafeAccess(Instruction* const object, const std::function<Instruction*()>& access);
+
+		Instruction*
+		buildCall(ast::expr::ExpressionDecl* const lhsDecl, ast::expr::ExpressionDecl* const argumentsDecl);
+
+		Instruction*
+		buildNew(ast::expr::ExpressionNewDecl* const newDecl);
+
+		Instruction*
+		buildAssign(ast::expr::ExpressionDecl* const targetDecl, ast::expr::ExpressionDecl* const valueDecl, Opcode_e op, Bool postfix);
+
+		Instruction*
+		buildPatternTest(ast::pattern::PatternDecl* const patternDecl, Instruction* const subject);
+
+		void
+		buildArguments(ast::expr::ExpressionDecl* const argumentsDecl, std::vector<Instruction*>& argumentList);
+
+		Instruction*
+		emitCall(Opcode_e op, Type_e type, U32 index, const std::vector<Instruction*>& operandList);
+
+		Instruction*
+		loadSlot(ast::AstNode* const node);
+
+		void
+		storeSlot(ast::AstNode* const node, Instruction* const value);
+
+		Instruction*
+		getThis();
+
+		Type_e
+		getDeclaredType(ast::TypeDecl* const typeDecl);
+
+		// Construcao do SSA.
+		void
+		writeVariable(U32 slot, Block* const block, Instruction* const value);
+
+		Instruction*
+		readVariable(U32 slot, Block* const block);
+
+		Instruction*
+		readVariableRecursive(U32 slot, Block* const block);
+
+		Instruction*
+		addPhiOperands(U32 slot, Instruction* const phi);
+
+		Instruction*
+		tryRemoveTrivialPhi(Instruction* const phi);
+
+		Instruction*
+		resolveReplacement(Instruction* value);
+
+		// Os phis dos lacos sao criados antes dos operandos serem conhecidos, os
+		// tipos dos phis e das operacoes aritmeticas sao refeitos ao final.
+		void
+		inferTypes();
+
+		Block*
+		createBlock(Bool sealed);
+
+		void
+		sealBlock(Block* const block);
+
+		void
+		setBlock(Block* const block);
+
+		// Instrucoes e arestas.
+		Instruction*
+		emit(Opcode_e op, Type_e type);
+
+		Instruction*
+		emitConstant(const vm::Value_s& value);
+
+		Instruction*
+		emitNull();
+
+		Instruction*
+		emitBinary(Opcode_e op, Instruction* const lhs, Instruction* const rhs);
+
+		Instruction*
+		emitPhi(Block* const block, const std::vector<Instruction*>& valueList);
+
+		void
+		emitJump(Block* const target);
+
+		void
+		emitBranch(Instruction* const condition, Block* const trueBlock, Block* const falseBlock);
+
+		void
+		emitReturn(Instruction* const value);
+
+		Bool
+		isTerminated();
+
+	private:
+		interpreter::Program*
+		mProgram;
+
+		std::unique_ptr<Function>
+		mFunction;
+
+		interpreter::ScriptFunction_s*
+		mScriptFunction;
+
+		Block*
+		mBlock;
+
+		U32
+		mLine;
+
+		std::vector<BlockState_s>
+		mBlockStateList;
+
+		std::vector<LoopTarget_s>
+		mLoopList;
+
+		// Phis triviais removidos e o valor que os substitui.
+		std::unordered_map<Instruction*, Instruction*>
+		mReplacementMap;
+
+		std::vector<std::unique_ptr<Instruction>>
+		mRemovedList;
+
+		// Phis recebendo operandos, ainda nao podem ser removidos.
+		std::vector<Instruction*>
+		mPendingPhiList;
+	};
+} }
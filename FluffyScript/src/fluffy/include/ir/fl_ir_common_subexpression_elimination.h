@@ -0,0 +1,73 @@
+#pragma once
+#include <unordered_map>
+#include "ir/fl_ir_pass.h"
+
+namespace fluffy { namespace ir {
+	/**
+	 * ExpressionKey_s
+	 */
+
+	struct ExpressionKey_s
+	{
+		Opcode_e							op;
+		Type_e								type;
+		U32									index;
+		PrimitiveTypeID_e					primitiveType;
+		U64									valueBits;
+		std::vector<Instruction*>			operandList;
+
+		Bool
+		operator==(const ExpressionKey_s& other) const;
+	};
+
+	/**
+	 * ExpressionKeyHash_s
+	 */
+
+	struct ExpressionKeyHash_s
+	{
+		size_t
+		operator()(const ExpressionKey_s& key) const;
+	};
+
+	/**
+	 * CommonSubexpressionElimination
+	 */
+
+	// Numeracao de valores sobre a arvore de dominadores: uma expressao pura e
+	// substituida por outra identica que a domina. Leituras de memoria nao sao
+	// consideradas porque qualquer chamada ou escrita pode altera-las.
+	class CommonSubexpressionElimination : public Pass
+	{
+	public:
+		CommonSubexpressionElimination();
+		~CommonSubexpressionElimination();
+
+		Bool
+		run(Module* const module, Function* const function) override;
+
+	private:
+		// Dominador imediato de cada bloco, pelo algoritmo de Cooper, Harvey e Kennedy.
+		void
+		computeDominators(Function* const function);
+
+		Bool
+		processBlock(Block* const block);
+
+	private:
+		std::vector<Block*>
+		mReversePostOrder;
+
+		std::unordered_map<Block*, U32>
+		mOrderMap;
+
+		std::unordered_map<Block*, Block*>
+		mDominatorMap;
+
+		std::unordered_map<Block*, std::vector<Block*>>
+		mChildrenMap;
+
+		std::unordered_map<ExpressionKey_s, Instruction*, ExpressionKeyHash_s>
+		mAvailableMap;
+	};
+} }
@@ -0,0 +1,32 @@
+#pragma once
+#include "ir/fl_ir_pass.h"
+
+namespace fluffy { namespace ir {
+	/**
+	 * ConstantPropagation
+	 */
+
+	// Avalia as operacoes com operandos constantes usando as mesmas rotinas da
+	// maquina virtual, remove phis triviais e substitui desvios com condicao
+	// constante por saltos. Operacoes que falhariam em tempo de execucao, como a
+	// divisao por zero, sao mantidas para que o erro aconteca no mesmo ponto.
+	class ConstantPropagation : public Pass
+	{
+	public:
+		ConstantPropagation();
+		~ConstantPropagation();
+
+		Bool
+		run(Module* const module, Function* const function) override;
+
+	private:
+		Bool
+		foldInstruction(Instruction* const instruction);
+
+		Bool
+		foldPhi(Instruction* const phi);
+
+		Bool
+		foldBranch(Instruction* const branch);
+	};
+} }
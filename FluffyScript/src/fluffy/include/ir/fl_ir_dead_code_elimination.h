@@ -0,0 +1,31 @@
+#pragma once
+#include "ir/fl_ir_pass.h"
+
+namespace fluffy { namespace ir {
+	/**
+	 * DeadCodeElimination
+	 */
+
+	// Remove as instrucoes cujo valor nao e usado e que nao tem efeitos nem
+	// podem falhar, os blocos inalcancaveis e os saltos entre blocos que podem
+	// ser unidos.
+	class DeadCodeElimination : public Pass
+	{
+	public:
+		DeadCodeElimination();
+		~DeadCodeElimination();
+
+		Bool
+		run(Module* const module, Function* const function) override;
+
+	private:
+		Bool
+		removeDeadInstructions(Function* const function);
+
+		Bool
+		simplifyBranches(Function* const function);
+
+		Bool
+		mergeBlocks(Function* const function);
+	};
+} }
@@ -0,0 +1,124 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "ir/fl_ir.h"
+#include "interpreter/fl_program.h"
+
+namespace fluffy { namespace ir {
+	/**
+	 * EscapeState_e
+	 */
+
+	// Ordenado do mais local para o mais global, o estado de um valor so cresce.
+	enum class EscapeState_e : U8
+	{
+		// O valor nao sai do quadro da funcao, pode ser substituido por escalares.
+		NoEscape,
+
+		// O valor e passado para funcoes que nao o guardam, pode ficar na pilha.
+		ArgEscape,
+
+		// O valor e retornado, guardado em uma global ou alcancado por outro quadro.
+		GlobalEscape
+	};
+
+	/**
+	 * EscapeAnalysis
+	 */
+
+	// Analise de escape das alocacoes (New e NewArray) de um modulo. Os valores
+	// sao agrupados por unificacao: atribuicoes e phis juntam os valores e cada
+	// grupo tem um grupo de conteudo com o que foi guardado nos seus campos ou
+	// elementos. O estado de um grupo e propagado para o seu conteudo.
+	//
+	// Chamadas diretas usam o resumo dos parametros da funcao chamada, os
+	// resumos sao recalculados ate se estabilizarem. Chamadas de metodo so sao
+	// resolvidas quando o objeto vem direto de um New, nos outros casos os
+	// operandos escapam.
+	class EscapeAnalysis
+	{
+	public:
+		EscapeAnalysis(interpreter::Program* const program);
+		~EscapeAnalysis();
+
+		void
+		run(Module* const module);
+
+		// Estado de uma instrucao New ou NewArray apos o 'run'.
+		EscapeState_e
+		getEscapeState(Instruction* const allocation);
+
+		// Estado do parametro na posicao informada, o 'this' dos metodos e o 0.
+		EscapeState_e
+		getParameterEscapeState(U32 functionIndex, U32 parameterIndex);
+
+		U32
+		getAllocationCount();
+
+		// Alocacoes que nao escapam do quadro, NoEscape ou ArgEscape.
+		U32
+		getLocalAllocationCount();
+
+	private:
+		// Analisa a funcao e atualiza o resumo dos parametros, retorna true
+		// se o resumo mudou.
+		Bool
+		analyze(Module* const module, Function* const function);
+
+		void
+		analyzeCall(Instruction* const instruction, Function* const callee);
+
+		void
+		analyzeNew(Instruction* const instruction);
+
+		U32
+		getNode(Instruction* const instruction);
+
+		U32
+		getContent(U32 node);
+
+		U32
+		find(U32 node);
+
+		void
+		merge(U32 nodeA, U32 nodeB);
+
+		void
+		escape(U32 node, EscapeState_e state);
+
+		// Estado minimo de um valor passado para o parametro da funcao.
+		EscapeState_e
+		getArgumentState(Function* const callee, U32 parameterIndex);
+
+		void
+		propagate();
+
+	private:
+		struct Node_s
+		{
+			U32								parent;
+			U32								content;
+			EscapeState_e					state;
+		};
+
+		interpreter::Program*
+		mProgram;
+
+		Module*
+		mModule;
+
+		// Estado de cada parametro, indexado pelo indice da funcao.
+		std::unordered_map<U32, std::vector<EscapeState_e>>
+		mSummaryMap;
+
+		std::unordered_map<Instruction*, EscapeState_e>
+		mAllocationMap;
+
+		// Estado da funcao em analise.
+		std::vector<Node_s>
+		mNodeList;
+
+		std::unordered_map<Instruction*, U32>
+		mNodeMap;
+	};
+} }
@@ -0,0 +1,43 @@
+#pragma once
+#include <unordered_map>
+#include "ir/fl_ir_pass.h"
+
+namespace fluffy { namespace ir {
+	/**
+	 * Inliner
+	 */
+
+	// Substitui chamadas diretas para funcoes pequenas e nao recursivas por uma
+	// copia do corpo da funcao chamada. O bloco da chamada e dividido, os
+	// retornos da copia saltam para a continuacao e o resultado e um phi.
+	class Inliner : public Pass
+	{
+	public:
+		Inliner(U32 maxCalleeSize = 32);
+		~Inliner();
+
+		Bool
+		run(Module* const module, Function* const function) override;
+
+	private:
+		Bool
+		isInlinable(Function* const caller, Function* const callee);
+
+		void
+		inlineCall(Function* const caller, Instruction* const call, Function* const callee);
+
+		// Move as instrucoes apos a chamada para um novo bloco.
+		Block*
+		splitBlock(Function* const function, Instruction* const call);
+
+	private:
+		U32
+		mMaxCalleeSize;
+
+		std::unordered_map<Instruction*, Instruction*>
+		mValueMap;
+
+		std::unordered_map<Block*, Block*>
+		mBlockMap;
+	};
+} }
@@ -0,0 +1,82 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "ir/fl_ir.h"
+
+namespace fluffy { namespace ir {
+	/**
+	 * Pass
+	 */
+
+	class Pass
+	{
+	public:
+		Pass(const I8* const name);
+		virtual ~Pass();
+
+		// Retorna true quando a funcao foi alterada.
+		virtual Bool
+		run(Module* const module, Function* const function) = 0;
+
+		const I8*
+		getName();
+
+	private:
+		const I8*
+		mName;
+	};
+
+	/**
+	 * PassStats_s
+	 */
+
+	struct PassStats_s
+	{
+		const I8*							name;
+		U32									runCount;
+		U32									changeCount;
+	};
+
+	/**
+	 * PassManager
+	 */
+
+	// Executa os passos em ordem sobre cada funcao ate que nenhum deles altere
+	// a funcao ou o limite de iteracoes seja atingido.
+	class PassManager
+	{
+	public:
+		PassManager();
+		~PassManager();
+
+		void
+		addPass(std::unique_ptr<Pass> pass);
+
+		// Retorna o maior numero de iteracoes usado por uma funcao.
+		U32
+		run(Module* const module);
+
+		void
+		setMaxIterations(U32 maxIterations);
+
+		// Valida o SSA apos cada passo que alterou a funcao.
+		void
+		setVerify(Bool verify);
+
+		const std::vector<PassStats_s>&
+		getStatsList();
+
+	private:
+		std::vector<std::unique_ptr<Pass>>
+		mPassList;
+
+		std::vector<PassStats_s>
+		mStatsList;
+
+		U32
+		mMaxIterations;
+
+		Bool
+		mVerify;
+	};
+} }
@@ -2,11 +2,16 @@
 #include <memory>
 #include <mutex>
 #include "fl_defs.h"
+#include "parser/fl_parser.h"
 
 namespace fluffy { namespace ast {
 	class CodeUnit;
 } }
 
+namespace fluffy { namespace diagnostics {
+	class DiagnosticEngine;
+} }
+
 namespace fluffy { namespace jobs {
 	/**
 	 * JobStatus_e
@@ -66,7 +71,7 @@ namespace fluffy { namespace jobs {
 	class JobParseFromSourceFile final : public Job
 	{
 	public:
-		JobParseFromSourceFile(const I8* sourceFilename);
+		JobParseFromSourceFile(const I8* sourceFilename, Bool skipFunctionBody = false, U32 functionBodyJobCount = 0, diagnostics::DiagnosticEngine* diagnosticEngine = nullptr);
 		virtual ~JobParseFromSourceFile();
 
 		virtual void
@@ -85,6 +90,15 @@ namespace fluffy { namespace jobs {
 		const I8*
 		m_sourceFilename;
 
+		Bool
+		m_skipFunctionBody;
+
+		U32
+		m_functionBodyJobCount;
+
+		diagnostics::DiagnosticEngine*
+		m_diagnosticEngine;
+
 		std::unique_ptr<ast::CodeUnit>
 		m_codeUnit;
 	};
@@ -96,7 +110,7 @@ namespace fluffy { namespace jobs {
 	class JobParseFromSourceBlock final : public Job
 	{
 	public:
-		JobParseFromSourceBlock(const I8* sourceFilename, const I8* sourceCode);
+		JobParseFromSourceBlock(const I8* sourceFilename, const I8* sourceCode, Bool skipFunctionBody = false, U32 functionBodyJobCount = 0, diagnostics::DiagnosticEngine* diagnosticEngine = nullptr);
 		virtual ~JobParseFromSourceBlock();
 
 		virtual void
@@ -118,8 +132,43 @@ namespace fluffy { namespace jobs {
 		const I8*
 		m_sourceCode;
 
+		Bool
+		m_skipFunctionBody;
+
+		U32
+		m_functionBodyJobCount;
+
+		diagnostics::DiagnosticEngine*
+		m_diagnosticEngine;
+
 		std::unique_ptr<ast::CodeUnit>
 		m_codeUnit;
 	};
 
+	/**
+	 * JobParseFunctionBody
+	 */
+
+	class JobParseFunctionBody final : public Job
+	{
+	public:
+		JobParseFunctionBody(const I8* sourceFilename, const I8* sourceCode);
+		virtual ~JobParseFunctionBody();
+
+		virtual void
+		doJob() override;
+
+		void
+		insertSkippedBlock(const parser::SkippedBlock_s& skippedBlock);
+
+	private:
+		const I8*
+		m_sourceFilename;
+
+		const I8*
+		m_sourceCode;
+
+		std::vector<parser::SkippedBlock_s>
+		m_skippedBlockList;
+	};
 } }
\ No newline at end of file
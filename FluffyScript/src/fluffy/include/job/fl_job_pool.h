@@ -29,7 +29,7 @@ namespace fluffy { namespace jobs {
 		void
 		close();
 
-		void
+		Bool
 		setJob(Job* job);
 
 	private:
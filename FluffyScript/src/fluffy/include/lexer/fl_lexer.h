@@ -1,12 +1,33 @@
 #pragma once
 #include <memory>
+#include <deque>
+#include <initializer_list>
 #include "fl_defs.h"
+#include "fl_string.h"
+#include "lexer/fl_source_line_index.h"
 
 namespace fluffy {
 	class BufferBase;
 }
 
+namespace fluffy { namespace diagnostics {
+	class DiagnosticEngine;
+	enum class DiagnosticCode_e : U16;
+} }
+
 namespace fluffy { namespace lexer {
+	///
+	/// LookaheadToken_s
+	///
+
+	struct LookaheadToken_s
+	{
+		Token_s token;
+
+		// Estado do lexer antes da leitura do token.
+		Bool eof;
+	};
+
 	///
 	/// Lexer
 	///
@@ -29,6 +50,27 @@ namespace fluffy { namespace lexer {
 		const I8*
 		getFilename();
 
+		// Tokens lidos desde a criacao do lexer, usado pelo profiler.
+		U32
+		getTokenCount();
+
+		// Motor que recebe os erros do lexer e do parser, sem motor os erros
+		// apenas interrompem a analise.
+		void
+		setDiagnosticEngine(diagnostics::DiagnosticEngine* const diagnosticEngine);
+
+		diagnostics::DiagnosticEngine*
+		getDiagnosticEngine();
+
+		// Lanca diagnostic_exception sem montar a mensagem, com motor o erro e
+		// registrado antes.
+		[[noreturn]] void
+		throwDiagnostic(diagnostics::DiagnosticCode_e code, U32 line, U32 column, std::initializer_list<TString> argList);
+
+		// Erro em um offset do codigo, a posicao e obtida pelo indice de linhas.
+		[[noreturn]] void
+		throwDiagnostic(diagnostics::DiagnosticCode_e code, U32 position, std::initializer_list<TString> argList);
+
 		void
 		nextToken();
 
@@ -39,7 +81,16 @@ namespace fluffy { namespace lexer {
 		getToken();
 
 		void
-		resetToPosition(U32 newPosition, U32 newLine, U32 newColumn);
+		resetToPosition(U32 newPosition);
+
+		// Linha e coluna de um offset do codigo carregado. O indice de linhas e
+		// montado conforme as posicoes sao consultadas.
+		SourceLocation_s
+		getLocation(U32 position);
+
+		// Linha e coluna do token atual, calculadas apenas quando pedidas.
+		const SourceLocation_s&
+		getTokenLocation();
 
 		void
 		reinterpretToken(TokenType_e type, U32 offset);
@@ -47,6 +98,9 @@ namespace fluffy { namespace lexer {
 		Token_s
 		predictNextToken();
 
+		const Token_s&
+		predictToken(U32 offset);
+
 		void
 		expectToken(TokenType_e expectedToken);
 
@@ -56,7 +110,7 @@ namespace fluffy { namespace lexer {
 		const Bool
 		expectConstantBool();
 
-		const I8
+		const I64
 		expectConstantInteger();
 
 		const Fp32
@@ -444,6 +498,13 @@ namespace fluffy { namespace lexer {
 		void
 		parse();
 
+		void
+		resetLineIndex();
+
+		// Indexa o codigo em blocos ate alcancar o offset.
+		void
+		extendLineIndex(U32 position);
+
 		I8
 		readChar(U32 offset = 0);
 
@@ -478,21 +539,38 @@ namespace fluffy { namespace lexer {
 		Token_s
 		m_token;
 
+		std::deque<LookaheadToken_s>
+		m_lookaheadList;
+
 		String
 		m_filename;
 
 		U32
 		m_tabSpaces;
 
+		SourceLineIndex
+		m_lineIndex;
+
+		// Linha da ultima consulta, as seguintes costumam estar nela ou nas
+		// proximas.
 		U32
-		m_line;
+		m_lineCursor;
 
+		SourceLocation_s
+		m_tokenLocation;
+
+		// Offset do token de m_tokenLocation.
 		U32
-		m_column;
+		m_tokenLocationPosition;
 
 		Bool
 		m_eof;
 
+		U32
+		m_tokenCount;
+
+		diagnostics::DiagnosticEngine*
+		m_diagnosticEngine;
 	};
 } }
 
@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include "fl_defs.h"
+
+namespace fluffy { namespace lexer {
+	///
+	/// SourceLocation_s
+	///
+
+	struct SourceLocation_s
+	{
+		U32 line;
+		U32 column;
+	};
+
+	///
+	/// SourceLineIndex
+	///
+
+	// Tabela com o inicio de cada linha de um arquivo, montada com uma unica
+	// varredura pelas quebras de linha. O codigo pode ser indexado em partes,
+	// em ordem, conforme as posicoes sao consultadas. Converte um offset ja
+	// indexado em linha e coluna sob demanda: a linha por busca binaria e a
+	// coluna pela distancia ao inicio da linha. As tabulacoes contam como
+	// tabSpaces colunas, as do inicio da linha sao contadas por linha e as
+	// demais guardadas a parte. O indice nao guarda o codigo, pode sobreviver
+	// ao buffer.
+	class SourceLineIndex
+	{
+	public:
+		SourceLineIndex();
+		~SourceLineIndex();
+
+		void
+		build(const I8* source, U32 length);
+
+		// Indexa o trecho seguinte do codigo, 'source' comeca no offset
+		// getIndexedLength().
+		void
+		append(const I8* source, U32 length);
+
+		void
+		clear();
+
+		U32
+		getIndexedLength();
+
+		U32
+		getLineCount();
+
+		// Offset do primeiro caractere da linha, as linhas comecam em 1.
+		U32
+		getLineStart(U32 line);
+
+		// Linha do offset em O(log n).
+		U32
+		getLine(U32 position);
+
+		// Coluna do offset, a linha ja deve ser conhecida.
+		U32
+		getColumn(U32 position, U32 line, U32 tabSpaces);
+
+		SourceLocation_s
+		getLocation(U32 position, U32 tabSpaces);
+
+	private:
+		std::vector<U32>
+		m_lineStartList;
+
+		std::vector<U32>
+		m_leadingTabList;
+
+		// Tabulacoes fora da indentacao, em ordem de offset.
+		std::vector<U32>
+		m_innerTabList;
+
+		U32
+		m_indexedLength;
+
+		// O ultimo trecho terminou na indentacao da linha atual.
+		Bool
+		m_insideIndent;
+	};
+} }
@@ -0,0 +1,293 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "vm/fl_value.h"
+#include "fl_defs.h"
+
+namespace fluffy { namespace ast {
+	namespace expr {
+		class ExpressionDecl;
+	}
+
+	namespace pattern {
+		class PatternDecl;
+	}
+} }
+
+namespace fluffy { namespace match {
+	static constexpr const U32 invalidArm = 0xFFFFFFFF;
+
+	// Quantidade minima de valores inteiros para um match usar a tabela de saltos.
+	static constexpr const U32 minJumpTableCaseCount = 4;
+
+	/**
+	 * PatternKind_e
+	 */
+
+	enum class PatternKind_e : U8
+	{
+		// '_' ou captura do valor em uma variavel.
+		Wildcard,
+
+		// Literal comparado por igualdade, o dominio dos literais e infinito.
+		Constant,
+
+		// Item de um dominio finito: enum, bool, tupla ou estrutura.
+		Constructor,
+
+		// Valor conhecido apenas em tempo de execucao, como variaveis globais.
+		Dynamic
+	};
+
+	/**
+	 * PatternInfo_s
+	 */
+
+	struct PatternInfo_s
+	{
+		PatternKind_e						kind;
+
+		// Constant: valor do literal, strings usam 'name'.
+		vm::Value_s							value;
+		String								name;
+
+		// Constructor: dominio, indice do item e quantidade de itens.
+		const void*							domain;
+		U32									index;
+		U32									domainSize;
+	};
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	// Valor de um literal numerico, booleano ou nulo, strings nao sao convertidas.
+	Bool
+	getLiteralValue(ast::expr::ExpressionDecl* const exprDecl, vm::Value_s& value);
+
+	/**
+	 * PatternResolver
+	 */
+
+	// Classifica os padroes literais e os itens de enum, cada etapa do compilador
+	// resolve os nomes com a informacao que possui.
+	class PatternResolver
+	{
+	public:
+		PatternResolver() {}
+		virtual ~PatternResolver() {}
+
+		// Chamado para LiteralPatternDecl e para o item de um EnumerablePatternDecl.
+		virtual PatternInfo_s
+		resolve(ast::pattern::PatternDecl* const patternDecl) = 0;
+
+		// Nome de um item do dominio, usado nos exemplos de valores nao cobertos.
+		virtual String
+		getItemName(const void* const domain, U32 index) = 0;
+	};
+
+	/**
+	 * Pattern_s
+	 */
+
+	struct Pattern_s
+	{
+		PatternKind_e						kind;
+		ast::pattern::PatternDecl*			patternDecl;
+
+		vm::Value_s							value;
+		String								name;
+		const void*							domain;
+		U32									index;
+		U32									domainSize;
+
+		// Subpadroes dos construtores, as estruturas usam os nomes dos campos.
+		std::vector<Pattern_s*>				argumentList;
+		std::vector<String>					fieldList;
+	};
+
+	/**
+	 * DecisionType_e
+	 */
+
+	enum class DecisionType_e : U8
+	{
+		Fail,
+		Leaf,
+		Switch,
+		Test
+	};
+
+	/**
+	 * Decision_s
+	 */
+
+	struct Decision_s;
+
+	struct Case_s
+	{
+		Pattern_s*							pattern;
+		Decision_s*							decision;
+	};
+
+	struct Decision_s
+	{
+		DecisionType_e						type;
+
+		// Caminho do valor testado a partir do valor do match, '$' e o proprio valor.
+		String								access;
+		U32									depth;
+
+		// Leaf: braco selecionado, Test: braco do padrao testado.
+		U32									armIndex;
+
+		// Switch: um caso por construtor, o default e nulo quando todos os itens
+		// do dominio estao presentes.
+		std::vector<Case_s>					caseList;
+		Decision_s*							defaultDecision;
+
+		// Test: comparacao com um valor dinamico.
+		Pattern_s*							testPattern;
+		Decision_s*							successDecision;
+	};
+
+	/**
+	 * JumpTable_s
+	 */
+
+	// Destino de um valor inteiro: 'matched' indica que o teste do braco ja foi
+	// satisfeito pela tabela, caso contrario o braco e testado normalmente.
+	struct JumpTarget_s
+	{
+		U32									armIndex;
+		Bool								matched;
+	};
+
+	struct JumpTable_s
+	{
+		std::unordered_map<I64, JumpTarget_s>
+											targetMap;
+		JumpTarget_s						defaultTarget;
+	};
+
+	/**
+	 * DecisionTree
+	 */
+
+	class DecisionTree
+	{
+		friend class MatchCompiler;
+
+	public:
+		DecisionTree(U32 armCount);
+		~DecisionTree();
+
+		Decision_s*
+		getRoot();
+
+		U32
+		getArmCount();
+
+		Bool
+		isExhaustive();
+
+		// Exemplos de valores nao cobertos pelos bracos.
+		const std::vector<String>&
+		getMissingList();
+
+		// Bracos que nunca sao selecionados porque os anteriores cobrem seus valores.
+		std::vector<U32>
+		getRedundantArmList();
+
+		// Monta a tabela de saltos quando a raiz compara o valor do match com ao
+		// menos 'minCaseCount' inteiros.
+		Bool
+		buildJumpTable(JumpTable_s& jumpTable, U32 minCaseCount);
+
+		String
+		dump();
+
+	private:
+		Decision_s*
+		mRoot;
+
+		U32
+		mArmCount;
+
+		std::vector<Bool>
+		mReachableList;
+
+		std::vector<String>
+		mMissingList;
+
+		// Padrao normalizado de cada braco.
+		std::vector<Pattern_s*>
+		mArmPatternList;
+
+		std::vector<std::unique_ptr<Pattern_s>>
+		mPatternList;
+
+		std::vector<std::unique_ptr<Decision_s>>
+		mDecisionList;
+	};
+
+	/**
+	 * MatchCompiler
+	 */
+
+	// Compila os bracos de um match em uma arvore de decisao (Maranget, "Compiling
+	// Pattern Matching to Good Decision Trees"): cada valor e testado uma unica vez
+	// e os bracos sao selecionados pelo construtor. Valores dinamicos nao podem ser
+	// agrupados, os bracos a partir deles sao compilados como continuacao.
+	class MatchCompiler
+	{
+	public:
+		MatchCompiler(PatternResolver* const resolver);
+		~MatchCompiler();
+
+		std::unique_ptr<DecisionTree>
+		compile(const std::vector<ast::pattern::PatternDecl*>& patternList);
+
+	private:
+		struct Row_s
+		{
+			std::vector<Pattern_s*>			columnList;
+			U32								armIndex;
+		};
+
+		struct Occurrence_s
+		{
+			String							access;
+			U32								depth;
+		};
+
+		Pattern_s*
+		normalize(ast::pattern::PatternDecl* const patternDecl);
+
+		Pattern_s*
+		makePattern(PatternKind_e kind, ast::pattern::PatternDecl* const patternDecl);
+
+		Decision_s*
+		makeDecision(DecisionType_e type);
+
+		Decision_s*
+		compileMatrix(const std::vector<Row_s>& rowList, const std::vector<Occurrence_s>& occurrenceList, Decision_s* const fallback);
+
+		Decision_s*
+		compileSwitch(const std::vector<Row_s>& rowList, const std::vector<Occurrence_s>& occurrenceList, U32 column, Decision_s* const fallback);
+
+		void
+		appendMissing(const Occurrence_s& occurrence, const String& name);
+
+	private:
+		PatternResolver*
+		mResolver;
+
+		DecisionTree*
+		mTree;
+
+		Pattern_s*
+		mWildcard;
+	};
+} }
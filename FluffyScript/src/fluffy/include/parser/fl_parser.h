@@ -1,11 +1,14 @@
 #pragma once
+#include <initializer_list>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "fl_defs.h"
-#include "ast\fl_ast_decl.h"
-#include "ast\fl_ast_type.h"
-#include "ast\fl_ast_block.h"
-#include "ast\fl_ast_expr.h"
-#include "ast\fl_ast_pattern.h"
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_type.h"
+#include "ast/fl_ast_block.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_pattern.h"
 
 namespace fluffy {
 	class BufferBase;
@@ -15,11 +18,66 @@ namespace fluffy { namespace lexer {
 	class Lexer;
 } }
 
+namespace fluffy { namespace diagnostics {
+	class DiagnosticEngine;
+	enum class DiagnosticCode_e : U16;
+} }
+
+namespace fluffy { namespace exceptions {
+	class diagnostic_exception;
+} }
+
 namespace fluffy { namespace parser {
+	///
+	/// TypeNameScope
+	///
+
+	class TypeNameScope
+	{
+	public:
+		TypeNameScope(TypeNameScope* const parent);
+		~TypeNameScope();
+
+		void
+		insertTypeName(const TString& typeName);
+
+		Bool
+		findTypeName(const TString& typeName);
+
+		void
+		setComplete(Bool complete);
+
+		Bool
+		isComplete();
+
+	private:
+		TypeNameScope* const
+		m_parent;
+
+		std::unordered_set<TString, TStringHash, TStringEqual>
+		m_typeNameSet;
+
+		Bool
+		m_complete;
+	};
+
 	struct ParserContext_s
 	{
-		Bool insideTrait;
-		Bool insideExpr;
+		Bool insideTrait = false;
+		Bool insideExpr = false;
+		Bool skipFunctionBody = false;
+		TypeNameScope* typeNameScope = nullptr;
+
+		// Com motor de diagnosticos o parser registra o erro e continua na
+		// proxima declaracao ou instrucao, o trecho descartado vira um no de
+		// erro na arvore.
+		diagnostics::DiagnosticEngine* diagnosticEngine = nullptr;
+	};
+
+	struct SkippedBlock_s
+	{
+		ast::BlockDecl* blockDecl;
+		ParserContext_s ctx;
 	};
 
 	///
@@ -94,6 +152,22 @@ namespace fluffy { namespace parser {
 		std::unique_ptr<ast::BlockDecl>
 		parseBlock(ParserContext_s& ctx);
 
+		void
+		parseSkippedBlock(ast::BlockDecl* const blockDecl);
+
+		void
+		parseSkippedBlock(const SkippedBlock_s& skippedBlock);
+
+		Bool
+		hasSkippedBlock();
+
+		std::vector<SkippedBlock_s>
+		releaseSkippedBlockList();
+
+		// Tokens lidos pelo lexer do parser.
+		U32
+		getTokenCount();
+
 		/// 
 		/// Stmt
 		/// 
@@ -126,6 +200,9 @@ namespace fluffy { namespace parser {
 		parseScopedPath(ParserContext_s& ctx);
 
 	private:
+		void
+		parseCodeUnitStructure(ParserContext_s& ctx, ast::CodeUnit* const codeUnit);
+
 		std::unique_ptr<ast::GeneralStmtDecl>
 		parseGeneralStmt(ParserContext_s& ctx);
 
@@ -153,6 +230,12 @@ namespace fluffy { namespace parser {
 		std::unique_ptr<ast::EnumItemDecl>
 		parseEnumItem(ParserContext_s& ctx);
 
+		std::unique_ptr<ast::BlockDecl>
+		parseFunctionBlock(ParserContext_s& ctx);
+
+		std::unique_ptr<ast::BlockDecl>
+		skipBlock(ParserContext_s& ctx);
+
 		std::unique_ptr<ast::stmt::StmtDecl>
 		parseIf(ParserContext_s& ctx);
 
@@ -199,10 +282,10 @@ namespace fluffy { namespace parser {
 		parseExprStmt(ParserContext_s& ctx);
 
 		std::unique_ptr<ast::expr::ExpressionDecl>
-		parseExpressionImp(ParserContext_s& ctx, U32 prec, Bool* requiredGenericValidation);
+		parseExpressionImp(ParserContext_s& ctx, U32 prec);
 
 		std::unique_ptr<ast::expr::ExpressionDecl>
-		parseAtom(ParserContext_s& ctx, Bool* requiredGenericValidation);
+		parseAtom(ParserContext_s& ctx);
 
 		std::unique_ptr<ast::pattern::PatternDecl>
 		parseLiteralPattern(ParserContext_s& ctx);
@@ -234,11 +317,73 @@ namespace fluffy { namespace parser {
 		void
 		validateIdentifier(TString& id);
 
+		Bool
+		isGenericCall(ParserContext_s& ctx);
+
+		void
+		insertTypeName(ParserContext_s& ctx, const TString& typeName);
+
+		TypeNameScope*
+		createTypeNameScope(ParserContext_s& ctx, ast::GenericDecl* const genericDecl);
+
+		///
+		/// Recuperacao de erros
+		///
+
+		// Lanca diagnostic_exception sem montar a mensagem, com motor de
+		// diagnosticos o erro e registrado antes. A excecao volta apenas ate o
+		// ponto de sincronizacao mais proximo.
+		[[noreturn]] void
+		throwDiagnostic(diagnostics::DiagnosticCode_e code, U32 line, U32 column, std::initializer_list<TString> argList);
+
+		// Erro na posicao do token atual.
+		[[noreturn]] void
+		throwDiagnostic(diagnostics::DiagnosticCode_e code, std::initializer_list<TString> argList);
+
+		// Sem motor ou com o limite de erros atingido a excecao e lancada
+		// novamente e a analise termina.
+		void
+		checkErrorLimit(ParserContext_s& ctx, const exceptions::diagnostic_exception& exception);
+
+		// Volta ao inicio da declaracao com erro e descarta os tokens ate a
+		// proxima declaracao no mesmo nivel, os blocos sao saltados por inteiro.
+		void
+		synchronize(U32 position, Bool insideNamespace);
+
+		Bool
+		isDeclarationStart();
+
+		// Analisa uma instrucao do bloco, com erro a instrucao e substituida por
+		// um no de erro e o bloco continua na proxima instrucao.
+		std::unique_ptr<ast::stmt::StmtDecl>
+		parseStmtDeclOrError(ParserContext_s& ctx);
+
+		// Volta ao inicio da instrucao com erro e descarta os tokens ate o ';',
+		// o inicio da proxima instrucao ou o '}' que fecha o bloco.
+		void
+		synchronizeStmt(U32 position);
+
+		Bool
+		isStmtStart();
+
+		// Avanca um token, os caracteres invalidos sao descartados.
+		void
+		skipTokenSafely();
+
 	private:
 		std::unique_ptr<lexer::Lexer>
 		m_lexer;
 
 		String
 		m_filename;
+
+		std::unordered_map<ast::BlockDecl*, ParserContext_s>
+		m_skippedBlockMap;
+
+		std::vector<std::unique_ptr<TypeNameScope>>
+		m_typeNameScopeList;
+
+		Bool
+		m_hasWildcardInclude;
 	};
 } }
\ No newline at end of file
@@ -0,0 +1,221 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+#include <unordered_map>
+#include "fl_defs.h"
+
+namespace fluffy { namespace profiler {
+	/**
+	 * Nomes das fases instrumentadas
+	 */
+
+	static constexpr const I8* lexerPhase = "lexer";
+	static constexpr const I8* parserPhase = "parser";
+	static constexpr const I8* functionBodyPhase = "parser.body";
+	static constexpr const I8* findNodeByIdPhase = "findNodeById";
+
+	/**
+	 * PhaseStats_s
+	 */
+
+	// Totais de uma fase em um code unit.
+	struct PhaseStats_s
+	{
+		String								phase;
+		String								codeUnit;
+
+		U64									callCount;
+		U64									totalTime;		// Microsegundos.
+		U64									allocatedBytes;
+
+		// Nos criados pelo parser, nos visitados pelos processadores ou tokens
+		// lidos pelo lexer.
+		U64									nodeCount;
+	};
+
+	/**
+	 * TraceEvent_s
+	 */
+
+	struct TraceEvent_s
+	{
+		String								phase;
+		String								codeUnit;
+		U32									threadId;
+		U64									beginTime;		// Microsegundos desde a criacao do profiler.
+		U64									duration;
+		U64									allocatedBytes;
+		U64									nodeCount;
+	};
+
+	/**
+	 * Profiler
+	 */
+
+	// Coleta o tempo, o numero de chamadas, os bytes alocados e os nos de cada
+	// fase da compilacao por code unit. O profiler ativo e global para que o
+	// lexer, o parser e as tarefas paralelas o encontrem sem alterar as suas
+	// interfaces, sem profiler ativo a instrumentacao custa uma leitura atomica.
+	class Profiler
+	{
+	public:
+		Profiler();
+		~Profiler();
+
+		static Profiler*
+		getActive();
+
+		static void
+		setActive(Profiler* const profiler);
+
+		// Indica se o 'new' global foi substituido para contar as alocacoes,
+		// o que so ocorre com FL_PROFILER_ALLOCATION_HOOK definido.
+		static Bool
+		hasAllocationHook();
+
+		// Bytes alocados pela thread atual desde o inicio do programa, sem a
+		// substituicao do 'new' global e sempre zero.
+		static U64
+		getThreadAllocatedBytes();
+
+		// Nome sem namespace da classe, usado para nomear os processadores.
+		static String
+		getTypeName(const std::type_info& typeInfo);
+
+		U64
+		getTime();
+
+		// Registra uma execucao da fase. Fases muito frequentes, como as buscas
+		// por nome, entram apenas nos totais sem gerar eventos.
+		void
+		record(const I8* phase, const I8* codeUnit, U64 beginTime, U64 duration, U64 allocatedBytes, U64 nodeCount, Bool traceEvent);
+
+		// Soma contadores a fase sem contar uma chamada.
+		void
+		addNodeCount(const I8* phase, const I8* codeUnit, U64 nodeCount);
+
+		// Totais ordenados pelo tempo, do maior para o menor.
+		std::vector<PhaseStats_s>
+		getStatsList();
+
+		const PhaseStats_s*
+		findStats(const String& phase, const String& codeUnit);
+
+		const std::vector<TraceEvent_s>&
+		getTraceEventList();
+
+		// Eventos no formato 'Trace Event' do Chrome (chrome://tracing, Perfetto).
+		String
+		toChromeTrace();
+
+		// Tabela com os totais por fase e code unit.
+		String
+		toSummary();
+
+		void
+		saveChromeTrace(const String& filename);
+
+		void
+		saveSummary(const String& filename);
+
+		void
+		clear();
+
+	private:
+		PhaseStats_s&
+		getStats(const I8* phase, const I8* codeUnit);
+
+		U32
+		getThreadId();
+
+	private:
+		static std::atomic<Profiler*>
+		sActiveProfiler;
+
+		std::chrono::steady_clock::time_point
+		mStartTime;
+
+		std::mutex
+		mMutex;
+
+		std::vector<PhaseStats_s>
+		mStatsList;
+
+		std::unordered_map<String, U32>
+		mStatsMap;
+
+		std::vector<TraceEvent_s>
+		mTraceEventList;
+
+		std::unordered_map<std::thread::id, U32>
+		mThreadMap;
+	};
+
+	/**
+	 * ProfilerGuard
+	 */
+
+	// Ativa o profiler enquanto o guard existir e restaura o anterior.
+	class ProfilerGuard
+	{
+	public:
+		ProfilerGuard(Profiler* const profiler);
+		~ProfilerGuard();
+
+	private:
+		Profiler*
+		mPreviousProfiler;
+
+		Bool
+		mActive;
+	};
+
+	/**
+	 * ProfileScope
+	 */
+
+	// Mede o bloco em que foi declarado. Os nos criados pela thread sao
+	// contados automaticamente, fases que visitam nos informam o total com
+	// 'setNodeCount'.
+	class ProfileScope
+	{
+	public:
+		ProfileScope(const I8* phase, const I8* codeUnit, Bool traceEvent = true);
+		~ProfileScope();
+
+		void
+		setNodeCount(U64 nodeCount);
+
+	private:
+		Profiler*
+		mProfiler;
+
+		const I8*
+		mPhase;
+
+		const I8*
+		mCodeUnit;
+
+		Bool
+		mTraceEvent;
+
+		Bool
+		mHasNodeCount;
+
+		U64
+		mBeginTime;
+
+		U64
+		mBeginBytes;
+
+		U64
+		mBeginNodeCount;
+
+		U64
+		mNodeCount;
+	};
+} }
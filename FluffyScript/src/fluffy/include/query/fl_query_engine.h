@@ -0,0 +1,199 @@
+#pragma once
+#include <memory>
+#include <unordered_map>
+#include "fl_defs.h"
+#include "fl_collections.h"
+
+namespace fluffy { namespace ast {
+	class AstNode;
+	class CodeUnit;
+	class ClassDecl;
+} }
+
+namespace fluffy { namespace scope {
+	class ScopeManager;
+	class NodeProcessor;
+} }
+
+namespace fluffy { namespace query {
+	/**
+	 * QueryKind_e
+	 */
+
+	enum class QueryKind_e
+	{
+		InputIndex,
+		NodeAt,
+		ResolveType,
+		ReferencesIn,
+		References,
+		Members
+	};
+
+	/**
+	 * QueryKey_s
+	 */
+
+	struct QueryKey_s
+	{
+		QueryKind_e							kind;
+		const ast::AstNode*					subject;
+		U64									argument;
+
+		Bool
+		operator==(const QueryKey_s& other) const;
+	};
+
+	struct QueryKeyHash
+	{
+		size_t
+		operator()(const QueryKey_s& key) const;
+	};
+
+	/**
+	 * QueryDependency_s
+	 */
+
+	// Entrada lida por uma consulta e a revisao da entrada no momento da leitura.
+	struct QueryDependency_s
+	{
+		const ast::AstNode*					input;
+		U64									revision;
+	};
+
+	/**
+	 * QueryEntry_s
+	 */
+
+	struct QueryEntry_s
+	{
+		NodeList							nodeList;
+		std::vector<QueryDependency_s>		dependencyList;
+	};
+
+	// Code unit e escopos ancestrais de cada funcao com corpo.
+	using FunctionScopeMap = std::unordered_map<const ast::AstNode*, std::pair<ast::CodeUnit*, NodeList>>;
+
+	// Code unit onde cada classe foi declarada.
+	using ClassUnitMap = std::unordered_map<const ast::AstNode*, ast::CodeUnit*>;
+
+	/**
+	 * QueryEngine
+	 */
+
+	// Consultas sob demanda sobre code units ja processados, no formato usado por
+	// editores. As entradas sao a camada de declaracoes de cada code unit e o
+	// corpo de cada funcao, cada consulta guarda as entradas que leu e so e
+	// recalculada quando a revisao de alguma delas muda. Alterar o corpo de uma
+	// funcao invalida apenas as consultas que leram aquele corpo.
+	class QueryEngine
+	{
+	public:
+		QueryEngine();
+		~QueryEngine();
+
+		void
+		insertCodeUnit(ast::CodeUnit* const codeUnit);
+
+		void
+		removeCodeUnit(ast::CodeUnit* const codeUnit);
+
+		// Processadores executados no corpo de uma funcao alterada, normalmente
+		// a resolucao de tipos. Pertencem ao engine.
+		void
+		applyBodyProcessor(scope::NodeProcessor* const bodyProcessor);
+
+		// O corpo da funcao foi substituido: os processadores de corpo sao
+		// executados apenas nele, com os escopos dos ancestrais.
+		void
+		updateFunctionBody(ast::AstNode* const functionDecl);
+
+		// A camada de declaracoes do code unit mudou, todas as consultas que a
+		// leram sao invalidadas.
+		void
+		invalidateDeclarations(ast::CodeUnit* const codeUnit);
+
+		// No mais interno cujo identificador cobre a posicao.
+		ast::AstNode*
+		findNodeAt(ast::CodeUnit* const codeUnit, U32 line, U32 column);
+
+		// Declaracao referenciada pelo tipo na posicao.
+		ast::AstNode*
+		resolveTypeAt(ast::CodeUnit* const codeUnit, U32 line, U32 column);
+
+		// Tipos de todos os code units que referenciam a declaracao.
+		NodeList
+		findReferences(ast::AstNode* const declaration);
+
+		// Membros da classe, seguidos dos membros herdados.
+		NodeList
+		listMembers(ast::ClassDecl* const classDecl);
+
+		// Numero de consultas calculadas, as respondidas pelo cache nao contam.
+		U64
+		getComputeCount();
+
+	private:
+		const QueryEntry_s&
+		query(const QueryKey_s& key);
+
+		void
+		compute(const QueryKey_s& key, QueryEntry_s& entry);
+
+		Bool
+		isValid(const QueryEntry_s& entry);
+
+		void
+		readInput(const ast::AstNode* const input);
+
+		const NodeList&
+		getInputNodeList(const ast::AstNode* const input);
+
+		NodeList
+		getInputList(ast::CodeUnit* const codeUnit);
+
+		void
+		indexInput(const ast::AstNode* const input, NodeList& nodeList);
+
+		U64
+		getRevision(const ast::AstNode* const input);
+
+		void
+		bumpRevision(const ast::AstNode* const input);
+
+	private:
+		std::unique_ptr<scope::ScopeManager>
+		mScopeManager;
+
+		std::vector<std::unique_ptr<scope::NodeProcessor>>
+		mBodyProcessorList;
+
+		std::vector<ast::CodeUnit*>
+		mCodeUnitList;
+
+		std::unordered_map<QueryKey_s, QueryEntry_s, QueryKeyHash>
+		mQueryMap;
+
+		std::unordered_map<const ast::AstNode*, U64>
+		mRevisionMap;
+
+		FunctionScopeMap
+		mFunctionScopeMap;
+
+		ClassUnitMap
+		mClassUnitMap;
+
+		// Consultas em calculo e as dependencias de cada uma, a ultima e a atual.
+		std::vector<QueryKey_s>
+		mActiveQueryList;
+
+		std::vector<std::vector<QueryDependency_s>>
+		mDependencyStack;
+
+		U64
+		mRevision;
+
+		U64
+		mComputeCount;
+	};
+} }
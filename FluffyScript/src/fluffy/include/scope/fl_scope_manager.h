@@ -1,5 +1,7 @@
 #pragma once
-#include "scope\fl_scope.h"
+#include <initializer_list>
+#include "scope/fl_scope.h"
+#include "diagnostics/fl_diagnostics.h"
 #include "fl_collections.h"
 
 namespace fluffy { namespace ast {
@@ -34,6 +36,11 @@ namespace fluffy { namespace scope {
 		virtual void
 		onProcess(ScopeManager* const scopeManager, const NodeProcessorEvent_e event, ast::AstNode* const node) = 0;
 
+		// Indica se o processador precisa visitar o corpo das funcoes, processadores
+		// que validam apenas declaracoes nao forcam o parse de corpos ignorados.
+		virtual Bool
+		requireFunctionBody() { return true; }
+
 	};
 
 	/**
@@ -83,12 +90,20 @@ namespace fluffy { namespace scope {
 		void
 		insertCodeUnit(ast::CodeUnit* const codeUnit);
 
+		void
+		removeCodeUnit(const TString& identifier);
+
 		void
 		copyReferenceTree(ScopeManager* const scopeManager);
 
 		void
 		processCodeUnit(ast::CodeUnit* const codeUnit, NodeProcessor* const nodeProcessor);
 
+		// Processa apenas a subarvore do no, os escopos dos ancestrais sao
+		// restaurados a partir da lista, que comeca pelo code unit.
+		void
+		processSubtree(ast::CodeUnit* const codeUnit, const NodeList& scopeList, ast::AstNode* const node, NodeProcessor* const nodeProcessor);
+
 		void
 		setCodeUnit(ast::CodeUnit* const codeUnit);
 
@@ -107,6 +122,23 @@ namespace fluffy { namespace scope {
 		FindResult_t
 		findAllNodeById(const TString& identifier);
 
+		// Os erros dos processadores sao registrados no motor e o processamento
+		// continua, o motor nao pertence ao gerenciador.
+		void
+		setDiagnosticEngine(diagnostics::DiagnosticEngine* const diagnosticEngine);
+
+		diagnostics::DiagnosticEngine*
+		getDiagnosticEngine();
+
+		// Registra o erro no code unit atual com a posicao do no. Sem motor de
+		// diagnosticos o erro e lancado como excecao, com a mesma mensagem.
+		void
+		reportError(diagnostics::DiagnosticCode_e code, const ast::AstNode* const node, std::initializer_list<TString> argList);
+
+		// Erro sem posicao.
+		void
+		reportError(diagnostics::DiagnosticCode_e code, std::initializer_list<TString> argList);
+
 		void
 		interrupt();
 
@@ -125,10 +157,21 @@ namespace fluffy { namespace scope {
 		const TString&
 		getCodeUnitName();
 
+		// Escopos do no atual, o primeiro e o code unit.
+		const NodeList&
+		getScopeStack();
+
+		// Nos visitados por processCodeUnit desde a criacao, usado pelo profiler.
+		U64
+		getVisitedNodeCount();
+
 	private:
 		void
 		processNode(ast::AstNode* const node, NodeProcessor* const nodeProcessor);
 
+		void
+		parseFunctionBody(ast::AstNode* const node);
+
 		void
 		pushScope(ast::AstNode* const node);
 
@@ -145,9 +188,15 @@ namespace fluffy { namespace scope {
 		ast::CodeUnit*
 		mCodeUnit;
 
+		diagnostics::DiagnosticEngine*
+		mDiagnosticEngine;
+
 		Bool
 		mInterruptFlag;
 
+		U64
+		mVisitedNodeCount;
+
 	};
 
 } }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+#include <memory>
+#include "fl_defs.h"
+
+namespace fluffy {
+	class Compiler;
+}
+
+namespace fluffy { namespace server {
+	/**
+	 * CompilerServer
+	 */
+
+	// Mantem um compilador em memoria entre as requisicoes, os code units, as
+	// tabelas de escopo e as strings internadas sao reaproveitados enquanto os
+	// arquivos nao mudam. Cada requisicao e uma linha de texto e a resposta e
+	// um objeto JSON em uma linha:
+	//
+	//   check <arquivo>...   compila os arquivos e retorna o resultado de cada um
+	//   stats                numero de requisicoes atendidas e de arquivos compilados
+	//   shutdown             encerra o servidor apos responder
+	class CompilerServer
+	{
+	public:
+		// O compilador deve estar inicializado e com os processadores aplicados, o
+		// servidor assume a posse dele.
+		CompilerServer(std::unique_ptr<Compiler> compiler);
+		~CompilerServer();
+
+		String
+		handleRequest(const String& request);
+
+		// Atende as conexoes no socket local ate receber 'shutdown', cada conexao
+		// pode enviar varias requisicoes.
+		void
+		listen(const String& socketPath);
+
+		Bool
+		isRunning();
+
+	private:
+		// Envia a resposta inteira, retorna false se o cliente desconectou.
+		Bool
+		sendResponse(int clientSocket, const String& response);
+
+		std::unique_ptr<Compiler>
+		mCompiler;
+
+		Bool
+		mRunning;
+
+		U64
+		mRequestCount;
+
+		U64
+		mBuiltFileCount;
+
+		U64
+		mCachedFileCount;
+	};
+} }
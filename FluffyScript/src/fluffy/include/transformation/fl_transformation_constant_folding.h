@@ -0,0 +1,139 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "scope/fl_scope_manager.h"
+#include "vm/fl_value.h"
+
+namespace fluffy { namespace ast {
+	class BlockDecl;
+	class FunctionParameterDecl;
+
+	namespace expr {
+		class ExpressionDecl;
+		class ExpressionBinaryDecl;
+		class ExpressionUnaryDecl;
+	}
+
+	namespace stmt {
+		class StmtDecl;
+	}
+
+	namespace pattern {
+		class PatternDecl;
+	}
+} }
+
+namespace fluffy { namespace transformations {
+	using ExpressionDeclPtr = std::unique_ptr<ast::expr::ExpressionDecl>;
+	using FunctionParameterDeclPtrList = std::vector<std::unique_ptr<ast::FunctionParameterDecl>>;
+
+	/**
+	 * ConstantWarning_s
+	 */
+
+	struct ConstantWarning_s
+	{
+		String								message;
+		U32									line;
+		U32									column;
+	};
+
+	/**
+	 * ConstantFolding
+	 */
+
+	// Avalia as expressoes unarias, binarias, ternarias e 'as' com operandos
+	// constantes e substitui as referencias para variaveis 'const' e constantes
+	// estaticas de classes pelo seu valor. Os calculos seguem as regras da maquina
+	// virtual: o estouro de inteiros e mantido e gera um aviso, a divisao inteira
+	// por zero e um erro de compilacao.
+	class ConstantFolding : public scope::NodeProcessor
+	{
+	public:
+		ConstantFolding();
+		virtual ~ConstantFolding();
+
+		virtual void
+		onProcess(scope::ScopeManager* const scopeManager, scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
+
+		const std::vector<ConstantWarning_s>&
+		getWarningList();
+
+		// Numero de expressoes substituidas por constantes.
+		U32
+		getFoldedCount();
+
+	private:
+		void
+		foldFunction(FunctionParameterDeclPtrList& parameterList, ast::BlockDecl* const blockDecl, ExpressionDeclPtr& exprDecl);
+
+		void
+		foldBlock(ast::BlockDecl* const blockDecl);
+
+		void
+		foldStmt(ast::stmt::StmtDecl* const stmtDecl);
+
+		void
+		foldExpr(ExpressionDeclPtr& exprDecl);
+
+		// Avalia as subexpressoes do destino de uma atribuicao sem substitui-lo.
+		void
+		foldAssignTarget(ExpressionDeclPtr& exprDecl);
+
+		void
+		foldUnary(ExpressionDeclPtr& exprDecl);
+
+		void
+		foldBinary(ExpressionDeclPtr& exprDecl);
+
+		void
+		foldTernary(ExpressionDeclPtr& exprDecl);
+
+		void
+		foldAs(ExpressionDeclPtr& exprDecl);
+
+		// Substitui uma referencia para uma constante pelo seu valor.
+		void
+		propagateConstant(ExpressionDeclPtr& exprDecl);
+
+		void
+		replaceWithValue(ExpressionDeclPtr& exprDecl, const vm::Value_s& value);
+
+		// Retorna a declaracao referenciada por um identificador ou caminho 'a::b'.
+		scope::FindResult_t
+		findDecl(ast::expr::ExpressionDecl* const exprDecl);
+
+		// Retorna o valor constante de uma declaracao 'const', ou nullptr.
+		ast::expr::ExpressionDecl*
+		getConstantInit(ast::AstNode* const decl);
+
+		void
+		declareLocal(ast::AstNode* const decl);
+
+		void
+		declarePattern(ast::pattern::PatternDecl* const patternDecl);
+
+		// Guarda o aviso na lista e o registra no motor de diagnosticos, se houver.
+		void
+		reportWarning(ast::AstNode* const node, diagnostics::DiagnosticCode_e code);
+
+	private:
+		scope::ScopeManager*
+		mScopeManager;
+
+		// Declaracoes locais visiveis, as mais internas no final.
+		std::vector<ast::AstNode*>
+		mLocalList;
+
+		// Constantes usadas antes da sua declaracao sao avaliadas fora do seu
+		// escopo, nesse caso apenas os literais sao considerados.
+		Bool
+		mLiteralOnly;
+
+		std::vector<ConstantWarning_s>
+		mWarningList;
+
+		U32
+		mFoldedCount;
+	};
+} }
@@ -1,6 +1,7 @@
 #pragma once
-#include "scope\fl_scope_manager.h"
-#include "attributes\fl_included_scope.h"
+#include "scope/fl_scope_manager.h"
+#include "attributes/fl_included_scope.h"
+#include "attributes/fl_export_summary.h"
 namespace fluffy { namespace transformations {
 	/**
 	 * ResolveInclude
@@ -15,9 +16,15 @@ namespace fluffy { namespace transformations {
 		virtual void
 		onProcess(scope::ScopeManager* const scopeManager, scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
 
+		virtual Bool
+		requireFunctionBody() override;
+
 	private:
+		Bool
+		processIncludeItemFromSummary(ast::IncludeItemDecl* const includeItemDecl, attributes::ExportSummary* const exportSummary);
+
 		void
-		processIncludeItem(ast::IncludeItemDecl* const includeItemDecl, ast::IncludeDecl* const includeDecl, scope::Scope& includeRootScope);
+		processIncludeItem(ast::IncludeItemDecl* const includeItemDecl, scope::Scope& includeRootScope);
 
 		void
 		validateIncludedNode(fluffy::ast::AstNode* const includedNode, fluffy::ast::AstNode* const includedItem);
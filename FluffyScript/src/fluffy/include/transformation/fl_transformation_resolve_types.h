@@ -1,5 +1,6 @@
 #pragma once
-#include "scope\fl_scope_manager.h"
+#include "scope/fl_scope_manager.h"
+#include "types/fl_type_table.h"
 namespace fluffy { namespace transformations {
 	/**
 	 * ResolveTypes
@@ -14,19 +15,26 @@ namespace fluffy { namespace transformations {
 		virtual void
 		onProcess(scope::ScopeManager* const scopeManager, scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
 
+		// Tabela com os tipos canonicos dos TypeDecl resolvidos.
+		types::TypeTable*
+		getTypeTable();
+
 	private:
-		void
+		// Registra o erro e retorna falso se o resultado nao for um tipo unico.
+		Bool
 		validateResult(fluffy::scope::FindResult_t& findResult, ast::AstNode* const namedType);
 
 		Bool
 		canBeType(ast::AstNode* const node);
 
-		void
+		Bool
 		validateScope(ast::AstNode* const node);
 
 	private:
 		scope::ScopeManager*
 		mScopeManager;
 
+		types::TypeTable
+		mTypeTable;
 	};
 } }
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "fl_defs.h"
+#include "fl_string.h"
+#include "types/fl_type_table.h"
+
+namespace fluffy { namespace ast {
+	class ClassDecl;
+	class InterfaceDecl;
+} }
+
+namespace fluffy { namespace types {
+	static constexpr const U32 invalidSlot = 0xFFFFFFFF;
+
+	/**
+	 * Signature_s
+	 */
+
+	// Assinatura canonica de uma funcao: o nome, 'static' e os tipos internados
+	// dos parametros e do retorno. Quando algum tipo nao pode ser internado
+	// a assinatura e aberta e a comparacao recorre ao AstUtils::equals. O nome
+	// aponta para o identificador da declaracao, que vive tanto quanto a AST.
+	struct Signature_s
+	{
+		ast::AstNode*						functionDecl;
+		const TString*						identifier;
+		Bool								isStatic;
+		std::vector<const Type_s*>			parameterList;
+		const Type_s*						returnType;
+		Bool								isOpen;
+
+		// Hash do nome e da aridade, usado pelas assinaturas abertas.
+		U64									nameHash;
+		U64									hash;
+	};
+
+	/**
+	 * SignatureIndex
+	 */
+
+	class SignatureIndex
+	{
+	public:
+		SignatureIndex();
+		~SignatureIndex();
+
+		void
+		insert(const Signature_s& signature, U32 value);
+
+		// Retorna o valor associado a assinatura ou 'invalidSlot'.
+		U32
+		find(const Signature_s& signature);
+
+	private:
+		std::vector<std::pair<Signature_s, U32>>
+		mEntryList;
+
+		std::unordered_multimap<U64, U32>
+		mSignatureMap;
+
+		std::unordered_multimap<U64, U32>
+		mNameMap;
+	};
+
+	/**
+	 * MethodSlot_s
+	 */
+
+	struct MethodSlot_s
+	{
+		U32									index;
+		Signature_s							signature;
+
+		// Implementacao atual do slot e a classe que a declara, 'functionDecl'
+		// aponta para a declaracao da interface enquanto nao ha implementacao.
+		ast::AstNode*						functionDecl;
+		ast::ClassDecl*						ownerDecl;
+		Bool								isAbstract;
+
+		// Interface que exige o slot e a classe que declara o 'implements'.
+		ast::InterfaceDecl*					interfaceDecl;
+		ast::ClassDecl*						implementorDecl;
+	};
+
+	/**
+	 * InterfaceTable_s
+	 */
+
+	struct InterfaceTable_s
+	{
+		ast::InterfaceDecl*					interfaceDecl;
+		ast::ClassDecl*						implementorDecl;
+
+		// Slot da vtable para cada funcao da interface, na ordem da declaracao.
+		std::vector<U32>					slotList;
+	};
+
+	/**
+	 * ClassLayout
+	 */
+
+	// Layout de metodos de uma classe: a vtable com os slots herdados primeiro,
+	// sobrescritas ocupam o slot da funcao original. Funcoes de interfaces nao
+	// implementadas reservam um slot abstrato que as subclasses preenchem.
+	class ClassLayout
+	{
+		friend class LayoutBuilder;
+
+	public:
+		ClassLayout(ast::ClassDecl* const classDecl);
+		~ClassLayout();
+
+		const MethodSlot_s*
+		findMethod(const Signature_s& signature);
+
+		const InterfaceTable_s*
+		findInterfaceTable(ast::InterfaceDecl* const interfaceDecl);
+
+		const std::vector<MethodSlot_s>&
+		getVTable();
+
+		const std::vector<InterfaceTable_s>&
+		getInterfaceTableList();
+
+		ast::ClassDecl*
+		getClassDecl();
+
+	private:
+		U32
+		insertSlot(MethodSlot_s& slot);
+
+	private:
+		ast::ClassDecl*
+		mClassDecl;
+
+		std::vector<MethodSlot_s>
+		mVTable;
+
+		SignatureIndex
+		mSignatureIndex;
+
+		std::vector<InterfaceTable_s>
+		mInterfaceTableList;
+
+		std::unordered_map<ast::InterfaceDecl*, U32>
+		mInterfaceTableMap;
+	};
+
+	/**
+	 * LayoutBuilder
+	 */
+
+	// Calcula e guarda o layout de cada classe. Os tipos das assinaturas sao
+	// internados na tabela do builder com os argumentos de 'extends' e
+	// 'implements' substituidos.
+	class LayoutBuilder
+	{
+	public:
+		LayoutBuilder();
+		~LayoutBuilder();
+
+		ClassLayout*
+		getLayout(ast::ClassDecl* const classDecl);
+
+		TypeTable*
+		getTypeTable();
+
+	private:
+		void
+		build(ClassLayout* const layout, ast::ClassDecl* const classDecl, const TypeSubstitution& substitution);
+
+		TypeSubstitution
+		makeSubstitution(ast::TypeDecl* const typeDecl, const TypeSubstitution& substitution);
+
+	private:
+		TypeTable
+		mTypeTable;
+
+		std::unordered_map<ast::ClassDecl*, std::unique_ptr<ClassLayout>>
+		mLayoutMap;
+	};
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	// Monta a assinatura de funcoes de classe, interface, trait ou livres com os
+	// tipos internados em 'typeTable' no contexto informado.
+	Signature_s
+	makeSignature(TypeTable* const typeTable, ast::AstNode* const functionDecl, const TypeSubstitution& substitution);
+} }
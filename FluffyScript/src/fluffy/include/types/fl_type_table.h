@@ -0,0 +1,130 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_set>
+#include <unordered_map>
+#include "fl_defs.h"
+
+namespace fluffy { namespace ast {
+	class AstNode;
+	class TypeDecl;
+} }
+
+namespace fluffy { namespace types {
+	static constexpr const U32 unsizedDimension = 0xFFFFFFFF;
+
+	struct Type_s;
+
+	// Tipo canonico de cada item de generic em um contexto de instanciacao.
+	using TypeSubstitution = std::unordered_map<ast::AstNode*, const Type_s*>;
+
+	inline U64
+	combineHash(U64 seed, U64 value)
+	{
+		return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+	}
+
+	/**
+	 * TypeKind_e
+	 */
+
+	enum class TypeKind_e : U8
+	{
+		Primitive,
+		Named,
+		Array,
+		Function,
+		Tuple
+	};
+
+	/**
+	 * Type_s
+	 */
+
+	// Tipo canonico: os filhos ja sao canonicos, dois tipos iguais possuem o
+	// mesmo endereco.
+	struct Type_s
+	{
+		TypeKind_e							kind;
+		Bool								nullable;
+
+		// Primitive.
+		PrimitiveTypeID_e					primitiveType;
+
+		// Named: declaracao referenciada, os argumentos ficam em 'itemList'.
+		ast::AstNode*						decl;
+
+		// Array: tipo dos valores, Function: retorno, nulo para 'void'.
+		const Type_s*						elementType;
+
+		// Function: tipo do objeto dono da funcao.
+		const Type_s*						ownerType;
+
+		// Named: argumentos do generic, Function: parametros, Tuple: itens.
+		std::vector<const Type_s*>			itemList;
+
+		// Array: tamanho de cada dimensao.
+		std::vector<U32>					dimensionList;
+
+		U64									hash;
+		U32									id;
+	};
+
+	/**
+	 * TypeTable
+	 */
+
+	// Hash-consing dos TypeDecl: cada tipo distinto existe uma unica vez e a
+	// comparacao de tipos se torna uma comparacao de enderecos. Sem contexto
+	// apenas tipos fechados e resolvidos sao internados, tipos que dependem de
+	// itens de generics ou de 'self' mudam conforme o contexto.
+	class TypeTable
+	{
+	public:
+		TypeTable();
+		~TypeTable();
+
+		// Retorna o tipo canonico e o associa ao no pelo atributo InternedType,
+		// nulo quando o tipo nao pode ser internado.
+		const Type_s*
+		intern(ast::TypeDecl* const typeDecl);
+
+		// Interna o tipo em um contexto: itens de generic presentes no mapa sao
+		// substituidos e os demais viram tipos nomeados opacos. O resultado
+		// depende do contexto e nao e associado ao no.
+		const Type_s*
+		intern(ast::TypeDecl* const typeDecl, const TypeSubstitution& substitution);
+
+		U32
+		getTypeCount();
+
+		String
+		toString(const Type_s* const type);
+
+	private:
+		const Type_s*
+		internType(ast::TypeDecl* const typeDecl, const TypeSubstitution* const substitution);
+
+		const Type_s*
+		insert(Type_s& type);
+
+		struct TypeHash
+		{
+			size_t
+			operator()(const Type_s* const type) const;
+		};
+
+		struct TypeEqual
+		{
+			bool
+			operator()(const Type_s* const typeA, const Type_s* const typeB) const;
+		};
+
+	private:
+		std::unordered_set<const Type_s*, TypeHash, TypeEqual>
+		mTypeSet;
+
+		std::vector<std::unique_ptr<Type_s>>
+		mTypeList;
+	};
+} }
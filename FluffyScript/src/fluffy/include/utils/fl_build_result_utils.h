@@ -0,0 +1,24 @@
+#pragma once
+#include <vector>
+#include "fl_defs.h"
+
+namespace fluffy {
+	struct BuildResult_s;
+}
+
+namespace fluffy { namespace utils {
+	/**
+	 * BuildResultUtils
+	 */
+
+	class BuildResultUtils
+	{
+	public:
+		// Lista JSON com os diagnosticos e os tempos de cada arquivo.
+		static String
+		toJson(const std::vector<BuildResult_s>& resultList);
+
+		static String
+		escapeJson(const String& text);
+	};
+} }
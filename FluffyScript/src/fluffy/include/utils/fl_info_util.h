@@ -12,5 +12,9 @@ namespace fluffy { namespace utils {
 
 		static void
 		resetNodeCount();
+
+		// Nos criados pela thread atual, nunca e zerado.
+		static U64
+		getThreadNodeCount();
 	};
 } }
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+#include "fl_defs.h"
+
+namespace fluffy { namespace ast {
+	class AstNode;
+	class CodeUnit;
+} }
+
+namespace fluffy { namespace attributes {
+	class ExportSummary;
+} }
+
+namespace fluffy { namespace utils {
+	/**
+	 * SummaryUtils
+	 */
+
+	class SummaryUtils
+	{
+	public:
+		static attributes::ExportSummary* const
+		generateExportSummary(ast::CodeUnit* const codeUnit);
+
+	private:
+		static void
+		summarizeScope(attributes::ExportSummary* const exportSummary, const String& scopePath, ast::AstNode* const scope);
+	};
+} }
\ No newline at end of file
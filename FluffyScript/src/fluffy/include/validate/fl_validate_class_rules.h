@@ -1,6 +1,7 @@
 #pragma once
 #include "fl_defs.h"
-#include "scope\fl_scope_manager.h"
+#include "scope/fl_scope_manager.h"
+#include "types/fl_class_layout.h"
 namespace fluffy { namespace validations {
 	/**
 	 * ClassRules
@@ -15,6 +16,13 @@ namespace fluffy { namespace validations {
 		virtual void
 		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
 
+		virtual Bool
+		requireFunctionBody() override;
+
+		// Layouts de metodos das classes validadas.
+		types::LayoutBuilder*
+		getLayoutBuilder();
+
 	private:
 		void
 		validateClassDecl(ast::ClassDecl* const classDecl);
@@ -22,18 +30,11 @@ namespace fluffy { namespace validations {
 		void
 		validateClassRequiredInterfaceFunctions(ast::ClassDecl* const classDecl);
 
-		void
-		resolveClassBaseAndInterfacesWithGenerics(ast::ClassDecl* const classDecl);
-
-		void
-		cleanupClassBaseAndInterfacesWithGenerics(ast::ClassDecl* const classDecl);
-
 	private:
 		scope::ScopeManager*
 		mScopeManager;
 
-		Bool
-		mNeedCleanGenerics;
-
+		types::LayoutBuilder
+		mLayoutBuilder;
 	};
 } }
@@ -1,6 +1,6 @@
 #pragma once
 #include "fl_defs.h"
-#include "scope\fl_scope_manager.h"
+#include "scope/fl_scope_manager.h"
 
 namespace fluffy { namespace attributes {
 	class Reference;
@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include "fl_defs.h"
+#include "match/fl_match_compiler.h"
+#include "scope/fl_scope_manager.h"
+
+namespace fluffy { namespace ast { namespace expr {
+	class ExpressionDecl;
+} } }
+
+namespace fluffy { namespace validations {
+	/**
+	 * MatchWarning_s
+	 */
+
+	struct MatchWarning_s
+	{
+		String								message;
+		U32									line;
+		U32									column;
+	};
+
+	/**
+	 * MatchRules
+	 */
+
+	// Compila os bracos de cada match em uma arvore de decisao para encontrar os
+	// bracos inalcancaveis e os valores nao cobertos. Um match sem correspondencia
+	// nao e um erro: a expressao resulta em nulo e o statement nao executa nada,
+	// por isso os problemas sao reportados como avisos.
+	class MatchRules : public scope::NodeProcessor, public match::PatternResolver
+	{
+	public:
+		MatchRules();
+		virtual ~MatchRules();
+
+		virtual void
+		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
+
+		virtual match::PatternInfo_s
+		resolve(ast::pattern::PatternDecl* const patternDecl) override;
+
+		virtual String
+		getItemName(const void* const domain, U32 index) override;
+
+		const std::vector<MatchWarning_s>&
+		getWarningList();
+
+	private:
+		void
+		validateMatch(ast::AstNode* const matchDecl, const std::vector<ast::pattern::PatternDecl*>& patternList, Bool isExpression);
+
+		// Retorna a declaracao referenciada por um identificador ou caminho 'a::b'.
+		scope::FindResult_t
+		findDecl(ast::expr::ExpressionDecl* const exprDecl);
+
+		// Itens de enum sao construtores, as demais declaracoes sao valores dinamicos.
+		match::PatternInfo_s
+		resolveDecl(const scope::FindResult_t& findResult);
+
+		// Guarda o aviso na lista e o registra no motor de diagnosticos, se houver.
+		void
+		reportWarning(ast::AstNode* const node, diagnostics::DiagnosticCode_e code, std::initializer_list<TString> argList);
+
+	private:
+		scope::ScopeManager*
+		mScopeManager;
+
+		std::vector<MatchWarning_s>
+		mWarningList;
+	};
+} }
@@ -1,6 +1,7 @@
 #pragma once
 #include "fl_defs.h"
-#include "scope\fl_scope_manager.h"
+#include "scope/fl_scope_manager.h"
+#include "types/fl_class_layout.h"
 namespace fluffy { namespace validations {
 	/**
 	 * TraitRules
@@ -15,11 +16,15 @@ namespace fluffy { namespace validations {
 		virtual void
 		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override;
 
+		virtual Bool
+		requireFunctionBody() override;
+
 	private:
 		void
 		validateTraitFor(ast::TraitForDecl* const traitFor);
 
-		void
+		// Retorna falso se o trait nao foi encontrado, o erro ja foi registrado.
+		Bool
 		validateTraitForDeclaration(ast::TraitForDecl* const traitFor);
 
 		void
@@ -29,5 +34,8 @@ namespace fluffy { namespace validations {
 		scope::ScopeManager*
 		mScopeManager;
 
+		// Tipos internados das assinaturas das funcoes de traits.
+		types::TypeTable
+		mTypeTable;
 	};
 } }
@@ -0,0 +1,311 @@
+#pragma once
+#include <vector>
+#include "codegen/fl_bytecode.h"
+#include "fl_defs.h"
+
+namespace fluffy { namespace vm {
+	/**
+	 * ValueType_e
+	 */
+
+	// Os tipos primitivos seguem a ordem de PrimitiveTypeID_e, do menor para o maior,
+	// e sao guardados sem alocacao diretamente nos registradores.
+	enum class ValueType_e : U8
+	{
+		Null,
+		Bool,
+		I8,
+		U8,
+		I16,
+		U16,
+		I32,
+		U32,
+		I64,
+		U64,
+		Fp32,
+		Fp64,
+		String,
+		Object,
+		Array,
+		Function
+	};
+
+	/**
+	 * HeapObject_s
+	 */
+
+	struct HeapObject_s
+	{
+		HeapObject_s(ValueType_e type)
+			: type(type)
+			, marked(false)
+			, next(nullptr)
+		{}
+
+		virtual ~HeapObject_s()
+		{}
+
+		ValueType_e							type;
+		Bool								marked;
+		HeapObject_s*						next;
+	};
+
+	/**
+	 * Value_s
+	 */
+
+	struct Value_s
+	{
+		ValueType_e							type;
+		union
+		{
+			Bool							boolValue;
+			I64								integerValue;
+			Fp64							realValue;
+			U32								functionIndex;
+			HeapObject_s*					object;
+		};
+	};
+
+	/**
+	 * StringObject_s
+	 */
+
+	struct StringObject_s : HeapObject_s
+	{
+		StringObject_s(String&& value)
+			: HeapObject_s(ValueType_e::String)
+			, value(std::move(value))
+		{}
+
+		String								value;
+	};
+
+	/**
+	 * InstanceObject_s
+	 */
+
+	struct InstanceObject_s : HeapObject_s
+	{
+		InstanceObject_s(U32 classIndex, U32 fieldCount)
+			: HeapObject_s(ValueType_e::Object)
+			, classIndex(classIndex)
+			, fieldList(fieldCount, Value_s { ValueType_e::Null, {} })
+		{}
+
+		U32									classIndex;
+		std::vector<Value_s>				fieldList;
+	};
+
+	/**
+	 * ArrayObject_s
+	 */
+
+	struct ArrayObject_s : HeapObject_s
+	{
+		ArrayObject_s()
+			: HeapObject_s(ValueType_e::Array)
+		{}
+
+		std::vector<Value_s>				elementList;
+	};
+
+	/**
+	 * OperationStatus_e
+	 */
+
+	enum class OperationStatus_e
+	{
+		Success,
+		InvalidOperands,
+		DivisionByZero
+	};
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	inline Bool
+	isInteger(ValueType_e type)
+	{
+		return type >= ValueType_e::I8 && type <= ValueType_e::U64;
+	}
+
+	inline Bool
+	isReal(ValueType_e type)
+	{
+		return type == ValueType_e::Fp32 || type == ValueType_e::Fp64;
+	}
+
+	inline Bool
+	isNumber(ValueType_e type)
+	{
+		return type >= ValueType_e::I8 && type <= ValueType_e::Fp64;
+	}
+
+	inline Bool
+	isHeapObject(ValueType_e type)
+	{
+		return type >= ValueType_e::String && type <= ValueType_e::Array;
+	}
+
+	inline Bool
+	isUnsigned(ValueType_e type)
+	{
+		return type == ValueType_e::U8 || type == ValueType_e::U16 || type == ValueType_e::U32 || type == ValueType_e::U64;
+	}
+
+	inline Bool
+	isTruthy(const Value_s& value)
+	{
+		switch (value.type)
+		{
+		case ValueType_e::Null:
+			return false;
+		case ValueType_e::Bool:
+			return value.boolValue;
+		case ValueType_e::Fp32:
+		case ValueType_e::Fp64:
+			return value.realValue != 0.0;
+		default:
+			return isInteger(value.type) ? value.integerValue != 0 : true;
+		}
+	}
+
+	inline Fp64
+	toReal(const Value_s& value)
+	{
+		if (isReal(value.type))
+		{
+			return value.realValue;
+		}
+		return value.type == ValueType_e::U64
+			? static_cast<Fp64>(static_cast<U64>(value.integerValue))
+			: static_cast<Fp64>(value.integerValue);
+	}
+
+	inline const String&
+	getString(const Value_s& value)
+	{
+		return static_cast<StringObject_s*>(value.object)->value;
+	}
+
+	inline Value_s
+	makeNull()
+	{
+		Value_s value;
+		value.type = ValueType_e::Null;
+		value.integerValue = 0;
+		return value;
+	}
+
+	inline Value_s
+	makeBool(Bool boolValue)
+	{
+		Value_s value;
+		value.type = ValueType_e::Bool;
+		value.integerValue = 0;
+		value.boolValue = boolValue;
+		return value;
+	}
+
+	// Trunca o valor para a largura do tipo inteiro.
+	inline Value_s
+	makeInteger(ValueType_e type, I64 integerValue)
+	{
+		Value_s value;
+		value.type = type;
+
+		switch (type)
+		{
+		case ValueType_e::I8:	value.integerValue = static_cast<signed char>(integerValue); break;
+		case ValueType_e::U8:	value.integerValue = static_cast<U8>(integerValue); break;
+		case ValueType_e::I16:	value.integerValue = static_cast<I16>(integerValue); break;
+		case ValueType_e::U16:	value.integerValue = static_cast<U16>(integerValue); break;
+		case ValueType_e::I32:	value.integerValue = static_cast<I32>(integerValue); break;
+		case ValueType_e::U32:	value.integerValue = static_cast<U32>(integerValue); break;
+		default:				value.integerValue = integerValue; break;
+		}
+		return value;
+	}
+
+	inline Value_s
+	makeReal(ValueType_e type, Fp64 realValue)
+	{
+		Value_s value;
+		value.type = type;
+		value.realValue = type == ValueType_e::Fp32 ? static_cast<Fp32>(realValue) : realValue;
+		return value;
+	}
+
+	inline Value_s
+	makeFunction(U32 functionIndex)
+	{
+		Value_s value;
+		value.type = ValueType_e::Function;
+		value.integerValue = 0;
+		value.functionIndex = functionIndex;
+		return value;
+	}
+
+	inline Value_s
+	makeObject(HeapObject_s* const object)
+	{
+		Value_s value;
+		value.type = object->type;
+		value.object = object;
+		return value;
+	}
+
+	inline ValueType_e
+	toValueType(PrimitiveTypeID_e primitiveType)
+	{
+		switch (primitiveType)
+		{
+		case PrimitiveTypeID_e::Bool:	return ValueType_e::Bool;
+		case PrimitiveTypeID_e::I8:		return ValueType_e::I8;
+		case PrimitiveTypeID_e::U8:		return ValueType_e::U8;
+		case PrimitiveTypeID_e::I16:	return ValueType_e::I16;
+		case PrimitiveTypeID_e::U16:	return ValueType_e::U16;
+		case PrimitiveTypeID_e::I32:	return ValueType_e::I32;
+		case PrimitiveTypeID_e::U32:	return ValueType_e::U32;
+		case PrimitiveTypeID_e::I64:	return ValueType_e::I64;
+		case PrimitiveTypeID_e::U64:	return ValueType_e::U64;
+		case PrimitiveTypeID_e::Fp32:	return ValueType_e::Fp32;
+		case PrimitiveTypeID_e::Fp64:	return ValueType_e::Fp64;
+		case PrimitiveTypeID_e::String:	return ValueType_e::String;
+		case PrimitiveTypeID_e::Object:	return ValueType_e::Object;
+		default:						return ValueType_e::Null;
+		}
+	}
+
+	const I8*
+	getValueTypeName(ValueType_e type);
+
+	Bool
+	isEqual(const Value_s& lhs, const Value_s& rhs);
+
+	// Operacoes entre numeros e booleanos, a concatenacao de strings exige alocacao
+	// e fica a cargo de quem executa o codigo.
+	OperationStatus_e
+	computeArithmetic(codegen::OpCode_e op, const Value_s& lhs, const Value_s& rhs, Value_s& result);
+
+	OperationStatus_e
+	computeComparison(codegen::OpCode_e op, const Value_s& lhs, const Value_s& rhs, Value_s& result);
+
+	// Conversao entre tipos primitivos, exceto para string.
+	Bool
+	computeCast(const Value_s& value, PrimitiveTypeID_e primitiveType, Value_s& result);
+
+	// Marca o valor e todos os objetos alcancaveis a partir dele.
+	void
+	markValue(const Value_s& value);
+
+	// Libera os objetos nao marcados da lista e desmarca os demais, retorna a quantidade liberada.
+	U32
+	sweepObjectList(HeapObject_s*& objectList);
+
+	// Representacao textual dos valores que nao dependem das classes e funcoes do programa.
+	String
+	formatValue(const Value_s& value);
+} }
\ No newline at end of file
@@ -0,0 +1,185 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "codegen/fl_bytecode.h"
+#include "vm/fl_value.h"
+
+namespace fluffy { namespace vm {
+	/**
+	 * PreparedInstruction_s
+	 */
+
+	struct PreparedInstruction_s
+	{
+		// Endereco do tratador da instrucao quando o despacho e direct-threaded.
+		const void*							handler;
+		codegen::Instruction				instruction;
+	};
+
+	/**
+	 * InlineCache_s
+	 */
+
+	struct InlineCache_s
+	{
+		// Classe observada na ultima execucao da instrucao.
+		U32									classIndex;
+
+		// Indice do campo no objeto ou indice da funcao do metodo.
+		U32									index;
+	};
+
+	/**
+	 * RuntimeFunction_s
+	 */
+
+	struct RuntimeFunction_s
+	{
+		codegen::BytecodeFunction_s*		function;
+		std::vector<PreparedInstruction_s>	code;
+		std::vector<Value_s>				constantList;
+		std::vector<InlineCache_s>			cacheList;
+	};
+
+	/**
+	 * RuntimeClass_s
+	 */
+
+	struct RuntimeClass_s
+	{
+		codegen::BytecodeClass_s*			classInfo = nullptr;
+
+		// Campos da classe base seguidos pelos campos declarados na classe.
+		std::vector<String>					fieldList;
+		std::unordered_map<String, U32>		fieldMap;
+
+		// Metodos da classe e das classes base, ja resolvidas as sobrescritas.
+		std::unordered_map<String, U32>		methodMap;
+	};
+
+	/**
+	 * CallFrame_s
+	 */
+
+	struct CallFrame_s
+	{
+		RuntimeFunction_s*					function;
+		const PreparedInstruction_s*		ip;
+		Value_s*							base;
+	};
+
+	/**
+	 * VirtualMachine
+	 */
+
+	class VirtualMachine
+	{
+	public:
+		VirtualMachine(codegen::BytecodeModule* const module);
+		virtual ~VirtualMachine();
+
+		void
+		initialize();
+
+		Value_s
+		call(const String& functionName, const std::vector<Value_s>& argumentList);
+
+		Value_s
+		call(U32 functionIndex, const std::vector<Value_s>& argumentList);
+
+		Value_s
+		getGlobal(const String& globalName);
+
+		Value_s
+		makeString(String value);
+
+		String
+		toString(const Value_s& value);
+
+		void
+		collectGarbage();
+
+		U32
+		getObjectCount();
+
+		U64
+		getInlineCacheMissCount();
+
+	private:
+		Value_s
+		execute(U32 stopDepth);
+
+		void
+		prepareFunction(RuntimeFunction_s& runtimeFunction, const void* const* dispatchTable);
+
+		void
+		prepareClass(U32 classIndex);
+
+		Value_s
+		executeArithmetic(codegen::OpCode_e op, const Value_s& lhs, const Value_s& rhs);
+
+		Value_s
+		executeComparison(codegen::OpCode_e op, const Value_s& lhs, const Value_s& rhs);
+
+		Value_s
+		executeCast(const Value_s& value, PrimitiveTypeID_e primitiveType);
+
+		Bool
+		isInstanceOf(const Value_s& value, const String& typeName);
+
+		U32
+		findField(U32 classIndex, const String& fieldName, const CallFrame_s& frame);
+
+		U32
+		findMethod(U32 classIndex, const String& methodName, const CallFrame_s& frame);
+
+		template <typename TObject, typename... TArgs>
+		TObject*
+		allocate(TArgs&&... args);
+
+		[[noreturn]] void
+		throwRuntimeError(const CallFrame_s& frame, const String& message);
+
+	private:
+		codegen::BytecodeModule*
+		mModule;
+
+		std::vector<RuntimeFunction_s>
+		mFunctionList;
+
+		std::vector<RuntimeClass_s>
+		mClassList;
+
+		std::vector<Value_s>
+		mGlobalList;
+
+		std::vector<Value_s>
+		mStack;
+
+		std::vector<CallFrame_s>
+		mFrameList;
+
+		// Objetos que nunca sao coletados, como as strings constantes.
+		std::vector<HeapObject_s*>
+		mPinnedObjectList;
+
+		HeapObject_s*
+		mObjectList;
+
+		U32
+		mObjectCount;
+
+		U32
+		mNextCollection;
+
+		U64
+		mInlineCacheMissCount;
+
+		Bool
+		mPrepared;
+
+		Bool
+		mInitialized;
+	};
+} }
\ No newline at end of file
@@ -1,11 +1,17 @@
-#include "ast\fl_ast.h"
-#include "utils\fl_info_util.h"
+#include <atomic>
+#include "ast/fl_ast.h"
+#include "utils/fl_info_util.h"
 #include "fl_string.h"
 #include "fl_defs.h"
 
 namespace fluffy { namespace utils {
-	static U32
-	g_totalNodeCount = 0;
+	// Os nos podem ser criados a partir de varias threads pelo parser.
+	static std::atomic<U32>
+	g_totalNodeCount(0);
+
+	// Contagem da thread atual, usada pelo profiler para separar as tarefas.
+	static thread_local U64
+	g_threadNodeCount = 0;
 
 	U32
 	InfoUtil::getNodeCount()
@@ -18,6 +24,12 @@ namespace fluffy { namespace utils {
 	{
 		g_totalNodeCount = 0;
 	}
+
+	U64
+	InfoUtil::getThreadNodeCount()
+	{
+		return g_threadNodeCount;
+	}
 } }
 
 namespace fluffy { namespace ast {	
@@ -33,6 +45,7 @@ namespace fluffy { namespace ast {
 		, column(column)
 	{
 		utils::g_totalNodeCount++;
+		utils::g_threadNodeCount++;
 	}
 
 	AstNode::~AstNode()
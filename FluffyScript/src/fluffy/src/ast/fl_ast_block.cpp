@@ -1,5 +1,5 @@
-#include "ast\fl_ast_stmt.h"
-#include "ast\fl_ast_block.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_block.h"
 
 namespace fluffy { namespace ast {
 
@@ -11,12 +11,14 @@ namespace fluffy { namespace ast {
 		: AstNode(AstNodeType_e::Block, line, column)
 		, beginPosition(0)
 		, endPosition(0)
+		, needParse(false)
 	{}
 
 	BlockDecl::BlockDecl(U32 beginPosition, U32 endPosition, U32 line, U32 column)
 		: AstNode(AstNodeType_e::Block, line, column)
 		, beginPosition(beginPosition)
 		, endPosition(endPosition)
+		, needParse(false)
 	{}
 
 	BlockDecl::~BlockDecl()
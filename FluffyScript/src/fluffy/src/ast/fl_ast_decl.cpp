@@ -1,9 +1,9 @@
 #include <memory>
 #include <vector>
-#include "ast\fl_ast_decl.h"
-#include "ast\fl_ast_expr.h"
-#include "ast\fl_ast_type.h"
-#include "ast\fl_ast_stmt.h"
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_type.h"
+#include "ast/fl_ast_stmt.h"
 #include "fl_defs.h"
 
 namespace fluffy { namespace ast {
@@ -646,4 +646,17 @@ namespace fluffy { namespace ast {
 
 	ScopedPathDecl::~ScopedPathDecl()
 	{}
+
+	/**
+	 * ErrorDecl
+	 */
+
+	ErrorDecl::ErrorDecl(U32 line, U32 column)
+		: GeneralStmtDecl(AstNodeType_e::ErrorDecl, GeneralDeclType_e::ErrorDecl, line, column)
+		, beginPosition(0)
+		, endPosition(0)
+	{}
+
+	ErrorDecl::~ErrorDecl()
+	{}
 } }
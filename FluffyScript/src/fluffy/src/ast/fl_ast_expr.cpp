@@ -1,10 +1,10 @@
 #include <memory>
 #include <vector>
-#include "ast\fl_ast_expr.h"
-#include "ast\fl_ast_decl.h"
-#include "ast\fl_ast_block.h"
-#include "ast\fl_ast_pattern.h"
-#include "ast\fl_ast_type.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_block.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_type.h"
 #include "fl_defs.h"
 
 namespace fluffy { namespace ast { namespace expr {
@@ -15,7 +15,6 @@ namespace fluffy { namespace ast { namespace expr {
 	ExpressionDecl::ExpressionDecl(AstNodeType_e nodeType, ExpressionDeclType_e type, const U32 line, const U32 column)
 		: AstNode(nodeType, line, column)
 		, type(type)
-		, needGenericValidation(false)
 		, beginPosition(0)
 		, endPosition(0)
 	{}
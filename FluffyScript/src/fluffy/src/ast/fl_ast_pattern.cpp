@@ -1,7 +1,7 @@
-#include "ast\fl_ast_pattern.h"
-#include "ast\fl_ast_expr.h"
-#include "ast\fl_ast_block.h"
-#include "ast\fl_ast.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_block.h"
+#include "ast/fl_ast.h"
 namespace fluffy { namespace ast { namespace pattern {
 	/**
 	 * PatternDecl
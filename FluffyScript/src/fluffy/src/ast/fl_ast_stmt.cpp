@@ -1,10 +1,10 @@
 #include <memory>
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_stmt.h"
-#include "ast\fl_ast_type.h"
-#include "ast\fl_ast_pattern.h"
-#include "ast\fl_ast_block.h"
-#include "ast\fl_ast_expr.h"
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_type.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_block.h"
+#include "ast/fl_ast_expr.h"
 #include "fl_defs.h"
 
 namespace fluffy { namespace ast { namespace stmt {
@@ -230,6 +230,19 @@ namespace fluffy { namespace ast { namespace stmt {
 	StmtExprDecl::~StmtExprDecl()
 	{}
 
+	/**
+	 * StmtErrorDecl
+	 */
+
+	StmtErrorDecl::StmtErrorDecl(U32 line, U32 column)
+		: StmtDecl(AstNodeType_e::StmtError, StmtDeclType_e::Error, line, column)
+		, beginPosition(0)
+		, endPosition(0)
+	{}
+
+	StmtErrorDecl::~StmtErrorDecl()
+	{}
+
 	/**
 	 * StmtForInitDecl
 	 */
@@ -1,5 +1,5 @@
-#include "ast\fl_ast_decl.h"
-#include "ast\fl_ast_type.h"
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_type.h"
 #define FLUFFY_PRIMITIVE_TYPE_DECL_IMP(type) \
 		TypeDecl##type::TypeDecl##type() \
 			: ast::AstNode(AstNodeType_e::type##Type, 0, 0) \
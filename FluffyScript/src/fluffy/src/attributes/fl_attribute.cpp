@@ -1,4 +1,4 @@
-#include "attributes\fl_attribute.h"
+#include "attributes/fl_attribute.h"
 namespace fluffy { namespace attributes {
 	/**
 	 * Attribute
@@ -0,0 +1,41 @@
+#include "ast/fl_ast_block.h"
+#include "parser/fl_parser.h"
+#include "attributes/fl_deferred_function_body.h"
+namespace fluffy { namespace attributes {
+	/**
+	 * DeferredFunctionBody
+	 */
+
+	DeferredFunctionBody::DeferredFunctionBody(parser::Parser* const parser)
+		: mParser(parser)
+	{}
+
+	DeferredFunctionBody::~DeferredFunctionBody()
+	{}
+
+	void
+	DeferredFunctionBody::parseFunctionBody(ast::BlockDecl* const blockDecl)
+	{
+		// O parser compartilha um unico lexer entre os blocos do code unit.
+		std::lock_guard<std::mutex> guard(mMutex);
+
+		if (mParser == nullptr || !blockDecl->needParse)
+		{
+			return;
+		}
+		mParser->parseSkippedBlock(blockDecl);
+
+		// Sem blocos pendentes o parser, o lexer e o buffer do codigo sao liberados.
+		if (!mParser->hasSkippedBlock())
+		{
+			mParser.reset();
+		}
+	}
+
+	Bool
+	DeferredFunctionBody::hasPendingFunctionBody()
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		return mParser != nullptr;
+	}
+} }
\ No newline at end of file
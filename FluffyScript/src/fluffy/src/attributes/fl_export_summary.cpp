@@ -0,0 +1,48 @@
+#include "ast/fl_ast.h"
+#include "attributes/fl_export_summary.h"
+namespace fluffy { namespace attributes {
+	/**
+	 * ExportSummary
+	 */
+
+	ExportSummary::ExportSummary()
+		: mSymbolCount(0)
+	{}
+
+	ExportSummary::~ExportSummary()
+	{}
+
+	void
+	ExportSummary::insertSymbol(const String& scopePath, ast::AstNode* const scope, ast::AstNode* const node)
+	{
+		const String symbolPath = scopePath.size()
+			? scopePath + "::" + node->identifier.str()
+			: String(node->identifier.str());
+
+		// Indexa o simbolo pelo caminho completo e pelo escopo a que pertence,
+		// mantendo a ordem de declaracao.
+		mSymbolMap[TString(symbolPath.c_str())].push_back(ExportSummaryEntry_s { scope, node });
+		mScopeMap[TString(scopePath.c_str())].push_back(ExportSummaryEntry_s { scope, node });
+		mSymbolCount++;
+	}
+
+	const ExportSummaryEntryList&
+	ExportSummary::findSymbol(const String& symbolPath)
+	{
+		auto it = mSymbolMap.find(TString(symbolPath.c_str()));
+		return it != mSymbolMap.end() ? it->second : mEmptyList;
+	}
+
+	const ExportSummaryEntryList&
+	ExportSummary::scopeSymbolList(const String& scopePath)
+	{
+		auto it = mScopeMap.find(TString(scopePath.c_str()));
+		return it != mScopeMap.end() ? it->second : mEmptyList;
+	}
+
+	U32
+	ExportSummary::getSymbolCount()
+	{
+		return mSymbolCount;
+	}
+} }
\ No newline at end of file
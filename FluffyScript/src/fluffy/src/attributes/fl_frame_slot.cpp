@@ -0,0 +1,47 @@
+#include "attributes/fl_frame_slot.h"
+namespace fluffy { namespace attributes {
+	/**
+	 * FrameSlot
+	 */
+
+	FrameSlot::FrameSlot(SlotType_e slotType, U32 index, I64 value)
+		: mSlotType(slotType)
+		, mIndex(index)
+		, mValue(value)
+		, mCachedClassIndex(0xFFFFFFFF)
+	{}
+
+	FrameSlot::~FrameSlot()
+	{}
+
+	SlotType_e
+	FrameSlot::getSlotType()
+	{
+		return mSlotType;
+	}
+
+	U32
+	FrameSlot::getIndex()
+	{
+		return mIndex;
+	}
+
+	I64
+	FrameSlot::getValue()
+	{
+		return mValue;
+	}
+
+	Bool
+	FrameSlot::hitCache(U32 classIndex)
+	{
+		return mCachedClassIndex == classIndex;
+	}
+
+	void
+	FrameSlot::updateCache(U32 classIndex, U32 index)
+	{
+		mCachedClassIndex = classIndex;
+		mIndex = index;
+	}
+} }
@@ -0,0 +1,19 @@
+#include "attributes/fl_generic_instance.h"
+namespace fluffy { namespace attributes {
+	/**
+	 * GenericInstance
+	 */
+
+	GenericInstance::GenericInstance(generics::Instance_s* const instance)
+		: mInstance(instance)
+	{}
+
+	GenericInstance::~GenericInstance()
+	{}
+
+	generics::Instance_s* const
+	GenericInstance::get()
+	{
+		return mInstance;
+	}
+} }
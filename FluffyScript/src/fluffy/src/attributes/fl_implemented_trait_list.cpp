@@ -1,4 +1,4 @@
-#include "attributes\fl_implemented_trait_list.h"
+#include "attributes/fl_implemented_trait_list.h"
 namespace fluffy { namespace attributes {
 	/**
 	 * ImplementedTraitList
@@ -1,6 +1,6 @@
 #include "fl_exceptions.h"
-#include "ast\fl_ast.h"
-#include "attributes\fl_included_scope.h"
+#include "ast/fl_ast.h"
+#include "attributes/fl_included_scope.h"
 namespace fluffy { namespace attributes {
 	/**
 	 * IncludedScope
@@ -16,12 +16,14 @@ namespace fluffy { namespace attributes {
 	IncludedScope::insertIncludedNode(const TString& identifier, ast::AstNode* const scope, ast::AstNode* const node)
 	{
 		mIncludedMap.emplace(identifier, IncludeEntry_s { scope, node });
+		mIncludedList.emplace_back(IncludeEntry_s { scope, node });
 	}
 
 	void
 	IncludedScope::insertWeakIncludedNode(const TString& identifier, ast::AstNode* const scope, ast::AstNode* const node)
 	{
 		mWeakIncludedMap.emplace(identifier, IncludeEntry_s{ scope, node });
+		mWeakIncludedList.emplace_back(IncludeEntry_s{ scope, node });
 	}
 
 	void
@@ -98,12 +100,8 @@ namespace fluffy { namespace attributes {
 	IncludeEntryList
 	IncludedScope::weakIncludeList()
 	{
-		IncludeEntryList list;
-		for (const auto& it : mWeakIncludedMap)
-		{
-			list.emplace_back(it.second);
-		}
-		return list;
+		// Mantem a ordem de inclusao.
+		return mWeakIncludedList;
 	}
 		
 	const IncludeEntryMultiMap&
@@ -115,12 +113,8 @@ namespace fluffy { namespace attributes {
 	IncludeEntryList
 	IncludedScope::includeList()
 	{
-		IncludeEntryList list;
-		for (const auto& it : mIncludedMap)
-		{
-			list.emplace_back(it.second);
-		}
-		return list;
+		// Mantem a ordem de inclusao.
+		return mIncludedList;
 	}
 
 	const IncludeEntryMultiMap&
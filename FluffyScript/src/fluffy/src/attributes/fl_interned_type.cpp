@@ -0,0 +1,19 @@
+#include "attributes/fl_interned_type.h"
+namespace fluffy { namespace attributes {
+	/**
+	 * InternedType
+	 */
+
+	InternedType::InternedType(const types::Type_s* const type)
+		: mType(type)
+	{}
+
+	InternedType::~InternedType()
+	{}
+
+	const types::Type_s*
+	InternedType::get()
+	{
+		return mType;
+	}
+} }
@@ -1,4 +1,4 @@
-#include "attributes\fl_reference.h"
+#include "attributes/fl_reference.h"
 namespace fluffy { namespace attributes {
 	/**
 	 * Reference
@@ -0,0 +1,19 @@
+#include "attributes/fl_resolved_type.h"
+namespace fluffy { namespace attributes {
+	/**
+	 * ResolvedType
+	 */
+
+	ResolvedType::ResolvedType(U32 typeHandle)
+		: mTypeHandle(typeHandle)
+	{}
+
+	ResolvedType::~ResolvedType()
+	{}
+
+	U32
+	ResolvedType::getHandle()
+	{
+		return mTypeHandle;
+	}
+} }
@@ -1,4 +1,4 @@
-#include "attributes\fl_scope.h"
+#include "attributes/fl_scope.h"
 namespace fluffy { namespace attributes {
 	/**
 	 * Scope
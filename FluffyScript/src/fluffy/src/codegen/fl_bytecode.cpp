@@ -0,0 +1,424 @@
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include "codegen/fl_bytecode.h"
+#include "fl_exceptions.h"
+namespace fluffy { namespace codegen {
+	/**
+	 * Nomes dos opcodes
+	 */
+
+	static const I8* opCodeNames[] = {
+		"nop",
+		"loadconst",
+		"loadint",
+		"loadbool",
+		"loadnull",
+		"move",
+		"getglobal",
+		"setglobal",
+		"loadfunction",
+		"getfield",
+		"setfield",
+		"getindex",
+		"setindex",
+		"getmethod",
+		"newobject",
+		"newarray",
+		"add",
+		"sub",
+		"mul",
+		"div",
+		"mod",
+		"shl",
+		"shr",
+		"bitand",
+		"bitor",
+		"bitxor",
+		"equal",
+		"notequal",
+		"less",
+		"lessequal",
+		"greater",
+		"greaterequal",
+		"neg",
+		"bitnot",
+		"not",
+		"cast",
+		"astype",
+		"istype",
+		"jump",
+		"jumpiffalse",
+		"jumpiftrue",
+		"jumpifnull",
+		"switch",
+		"call",
+		"return",
+		"panic"
+	};
+
+	static_assert(sizeof(opCodeNames) / sizeof(opCodeNames[0]) == static_cast<U32>(OpCode_e::Count), "Missing opcode name");
+
+	const I8*
+	getOpCodeName(OpCode_e op)
+	{
+		return op < OpCode_e::Count ? opCodeNames[static_cast<U32>(op)] : "unknown";
+	}
+
+	// Retorna o opcode de um operador binario ou Nop se nao houver.
+	OpCode_e
+	getBinaryOpCode(TokenType_e op)
+	{
+		switch (op)
+		{
+		case TokenType_e::Plus:
+		case TokenType_e::PlusAssign:
+			return OpCode_e::Add;
+		case TokenType_e::Minus:
+		case TokenType_e::MinusAssign:
+			return OpCode_e::Sub;
+		case TokenType_e::Multiplication:
+		case TokenType_e::MultAssign:
+			return OpCode_e::Mul;
+		case TokenType_e::Division:
+		case TokenType_e::DivAssign:
+			return OpCode_e::Div;
+		case TokenType_e::Modulo:
+		case TokenType_e::ModAssign:
+			return OpCode_e::Mod;
+		case TokenType_e::BitWiseLShift:
+		case TokenType_e::BitWiseLShiftAssign:
+			return OpCode_e::Shl;
+		case TokenType_e::BitWiseRShift:
+		case TokenType_e::BitWiseRShiftAssign:
+			return OpCode_e::Shr;
+		case TokenType_e::BitWiseAnd:
+		case TokenType_e::BitWiseAndAssign:
+			return OpCode_e::BitAnd;
+		case TokenType_e::BitWiseOr:
+		case TokenType_e::BitWiseOrAssign:
+			return OpCode_e::BitOr;
+		case TokenType_e::BitWiseXor:
+		case TokenType_e::BitWiseXorAssign:
+			return OpCode_e::BitXor;
+		case TokenType_e::Equal:
+			return OpCode_e::Equal;
+		case TokenType_e::NotEqual:
+			return OpCode_e::NotEqual;
+		case TokenType_e::LessThan:
+			return OpCode_e::Less;
+		case TokenType_e::LessThanOrEqual:
+			return OpCode_e::LessEqual;
+		case TokenType_e::GreaterThan:
+			return OpCode_e::Greater;
+		case TokenType_e::GreaterThanOrEqual:
+			return OpCode_e::GreaterEqual;
+		default:
+			return OpCode_e::Nop;
+		}
+	}
+
+	Bool
+	isCompoundAssign(TokenType_e op)
+	{
+		switch (op)
+		{
+		case TokenType_e::PlusAssign:
+		case TokenType_e::MinusAssign:
+		case TokenType_e::MultAssign:
+		case TokenType_e::DivAssign:
+		case TokenType_e::ModAssign:
+		case TokenType_e::BitWiseLShiftAssign:
+		case TokenType_e::BitWiseRShiftAssign:
+		case TokenType_e::BitWiseAndAssign:
+		case TokenType_e::BitWiseOrAssign:
+		case TokenType_e::BitWiseXorAssign:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	/**
+	 * BytecodeModule
+	 */
+
+	BytecodeModule::BytecodeModule()
+	{}
+
+	BytecodeModule::~BytecodeModule()
+	{}
+
+	U32
+	BytecodeModule::insertIntegerConstant(I64 value, PrimitiveTypeID_e valueType)
+	{
+		std::stringstream key;
+		key << "i" << static_cast<U32>(valueType) << ":" << value;
+
+		Constant_s constant { valueType, value, 0.0, String() };
+		return insertConstant(key.str(), std::move(constant));
+	}
+
+	U32
+	BytecodeModule::insertRealConstant(Fp64 value, PrimitiveTypeID_e valueType)
+	{
+		U64 bits = 0;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		// A chave usa a representacao binaria para diferenciar 0.0 de -0.0.
+		std::stringstream key;
+		key << "r" << static_cast<U32>(valueType) << ":" << bits;
+
+		Constant_s constant { valueType, 0, value, String() };
+		return insertConstant(key.str(), std::move(constant));
+	}
+
+	U32
+	BytecodeModule::insertStringConstant(const String& value)
+	{
+		Constant_s constant { PrimitiveTypeID_e::String, 0, 0.0, value };
+		return insertConstant("s:" + value, std::move(constant));
+	}
+
+	U32
+	BytecodeModule::insertFunction(const String& name)
+	{
+		if (mFunctionMap.find(name) != mFunctionMap.end())
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' already generated",
+				name.c_str()
+			);
+		}
+
+		auto function = std::make_unique<BytecodeFunction_s>();
+		function->name = name;
+		function->isMethod = false;
+		function->parameterCount = 0;
+		function->frameSize = 0;
+
+		const U32 functionIndex = static_cast<U32>(mFunctionList.size());
+		mFunctionList.push_back(std::move(function));
+		mFunctionMap.emplace(name, functionIndex);
+		return functionIndex;
+	}
+
+	U32
+	BytecodeModule::findFunction(const String& name)
+	{
+		auto it = mFunctionMap.find(name);
+		return it != mFunctionMap.end() ? it->second : invalidIndex;
+	}
+
+	U32
+	BytecodeModule::insertGlobal(const String& name)
+	{
+		auto it = mGlobalMap.find(name);
+		if (it != mGlobalMap.end())
+		{
+			return it->second;
+		}
+
+		const U32 globalIndex = static_cast<U32>(mGlobalList.size());
+		mGlobalList.push_back(name);
+		mGlobalMap.emplace(name, globalIndex);
+		return globalIndex;
+	}
+
+	U32
+	BytecodeModule::findGlobal(const String& name)
+	{
+		auto it = mGlobalMap.find(name);
+		return it != mGlobalMap.end() ? it->second : invalidIndex;
+	}
+
+	U32
+	BytecodeModule::insertClass(const String& name)
+	{
+		if (mClassMap.find(name) != mClassMap.end())
+		{
+			throw exceptions::custom_exception(
+				"Class '%s' already generated",
+				name.c_str()
+			);
+		}
+
+		auto classInfo = std::make_unique<BytecodeClass_s>();
+		classInfo->name = name;
+		classInfo->baseClassIndex = invalidIndex;
+		classInfo->initFunctionIndex = invalidIndex;
+		classInfo->destructorFunctionIndex = invalidIndex;
+
+		const U32 classIndex = static_cast<U32>(mClassList.size());
+		mClassList.push_back(std::move(classInfo));
+		mClassMap.emplace(name, classIndex);
+		return classIndex;
+	}
+
+	U32
+	BytecodeModule::findClass(const String& name)
+	{
+		auto it = mClassMap.find(name);
+		return it != mClassMap.end() ? it->second : invalidIndex;
+	}
+
+	U32
+	BytecodeModule::findMethod(U32 classIndex, const String& name)
+	{
+		// Procura o metodo na classe e depois nas classes base.
+		while (classIndex != invalidIndex)
+		{
+			auto classInfo = mClassList[classIndex].get();
+
+			for (auto& method : classInfo->methodList)
+			{
+				if (method.name == name)
+				{
+					return method.functionIndex;
+				}
+			}
+			classIndex = classInfo->baseClassIndex;
+		}
+		return invalidIndex;
+	}
+
+	void
+	BytecodeModule::insertInitFunction(U32 functionIndex)
+	{
+		mInitFunctionList.push_back(functionIndex);
+	}
+
+	const Constant_s&
+	BytecodeModule::getConstant(U32 constantIndex)
+	{
+		return mConstantList[constantIndex];
+	}
+
+	BytecodeFunction_s* const
+	BytecodeModule::getFunction(U32 functionIndex)
+	{
+		return mFunctionList[functionIndex].get();
+	}
+
+	BytecodeClass_s* const
+	BytecodeModule::getClass(U32 classIndex)
+	{
+		return mClassList[classIndex].get();
+	}
+
+	const String&
+	BytecodeModule::getGlobalName(U32 globalIndex)
+	{
+		return mGlobalList[globalIndex];
+	}
+
+	U32
+	BytecodeModule::getConstantCount()
+	{
+		return static_cast<U32>(mConstantList.size());
+	}
+
+	U32
+	BytecodeModule::getFunctionCount()
+	{
+		return static_cast<U32>(mFunctionList.size());
+	}
+
+	U32
+	BytecodeModule::getClassCount()
+	{
+		return static_cast<U32>(mClassList.size());
+	}
+
+	U32
+	BytecodeModule::getGlobalCount()
+	{
+		return static_cast<U32>(mGlobalList.size());
+	}
+
+	const std::vector<U32>&
+	BytecodeModule::getInitFunctionList()
+	{
+		return mInitFunctionList;
+	}
+
+	String
+	BytecodeModule::disassemble(U32 functionIndex)
+	{
+		auto function = mFunctionList[functionIndex].get();
+
+		std::stringstream ss;
+		ss << function->name << " params: " << function->parameterCount << " frame: " << function->frameSize << "\n";
+
+		for (U32 pc = 0; pc < function->code.size(); pc++)
+		{
+			const Instruction instruction = function->code[pc];
+			const OpCode_e op = getOpCode(instruction);
+
+			ss << std::setw(4) << std::setfill('0') << pc << " " << getOpCodeName(op);
+
+			switch (op)
+			{
+			case OpCode_e::LoadConst:
+			case OpCode_e::GetGlobal:
+			case OpCode_e::SetGlobal:
+			case OpCode_e::LoadFunction:
+			case OpCode_e::NewObject:
+				ss << " " << getOperandA(instruction) << " " << getOperandBx(instruction);
+				break;
+			case OpCode_e::Switch:
+				{
+					const SwitchTable_s& switchTable = function->switchTableList[getOperandBx(instruction)];
+
+					ss << " " << getOperandA(instruction) << " " << getOperandBx(instruction)
+						<< " cases: " << switchTable.offsetMap.size() << " default: " << switchTable.defaultOffset;
+				}
+				break;
+			case OpCode_e::LoadInt:
+			case OpCode_e::JumpIfFalse:
+			case OpCode_e::JumpIfTrue:
+			case OpCode_e::JumpIfNull:
+				ss << " " << getOperandA(instruction) << " " << getOperandSBx(instruction);
+				break;
+			case OpCode_e::Jump:
+				ss << " " << getOperandSBx(instruction);
+				break;
+			case OpCode_e::LoadNull:
+			case OpCode_e::Panic:
+				ss << " " << getOperandA(instruction);
+				break;
+			case OpCode_e::LoadBool:
+			case OpCode_e::Move:
+			case OpCode_e::Neg:
+			case OpCode_e::BitNot:
+			case OpCode_e::Not:
+			case OpCode_e::Call:
+			case OpCode_e::Return:
+				ss << " " << getOperandA(instruction) << " " << getOperandB(instruction);
+				break;
+			case OpCode_e::Nop:
+				break;
+			default:
+				ss << " " << getOperandA(instruction) << " " << getOperandB(instruction) << " " << getOperandC(instruction);
+				break;
+			}
+			ss << "\n";
+		}
+		return ss.str();
+	}
+
+	U32
+	BytecodeModule::insertConstant(const String& key, Constant_s&& constant)
+	{
+		auto it = mConstantMap.find(key);
+		if (it != mConstantMap.end())
+		{
+			return it->second;
+		}
+
+		const U32 constantIndex = static_cast<U32>(mConstantList.size());
+		mConstantList.push_back(std::move(constant));
+		mConstantMap.emplace(key, constantIndex);
+		return constantIndex;
+	}
+} }
\ No newline at end of file
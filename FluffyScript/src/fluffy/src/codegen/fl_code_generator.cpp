@@ -0,0 +1,2500 @@
+#include <string>
+#include <algorithm>
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_type.h"
+#include "codegen/fl_code_generator.h"
+#include "fl_exceptions.h"
+namespace fluffy { namespace codegen {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static String
+	toString(const TString& identifier)
+	{
+		return identifier.str() != nullptr ? String(identifier.str()) : String();
+	}
+
+	static String
+	joinPath(const String& scopePath, const String& identifier)
+	{
+		return scopePath.size() ? scopePath + "::" + identifier : identifier;
+	}
+
+	static const I8*
+	getPrimitiveTypeName(PrimitiveTypeID_e primitiveType)
+	{
+		switch (primitiveType)
+		{
+		case PrimitiveTypeID_e::Void:	return "void";
+		case PrimitiveTypeID_e::Bool:	return "bool";
+		case PrimitiveTypeID_e::I8:		return "i8";
+		case PrimitiveTypeID_e::U8:		return "u8";
+		case PrimitiveTypeID_e::I16:	return "i16";
+		case PrimitiveTypeID_e::U16:	return "u16";
+		case PrimitiveTypeID_e::I32:	return "i32";
+		case PrimitiveTypeID_e::U32:	return "u32";
+		case PrimitiveTypeID_e::I64:	return "i64";
+		case PrimitiveTypeID_e::U64:	return "u64";
+		case PrimitiveTypeID_e::Fp32:	return "fp32";
+		case PrimitiveTypeID_e::Fp64:	return "fp64";
+		case PrimitiveTypeID_e::String:	return "string";
+		case PrimitiveTypeID_e::Object:	return "object";
+		default:						return "unknown";
+		}
+	}
+
+	/**
+	 * CodeGenerator
+	 */
+
+	CodeGenerator::CodeGenerator()
+		: mModule(new BytecodeModule())
+		, mCodeUnit(nullptr)
+		, mFunction(nullptr)
+	{}
+
+	CodeGenerator::~CodeGenerator()
+	{}
+
+	void
+	CodeGenerator::onProcess(scope::ScopeManager* const, const scope::NodeProcessorEvent_e event, ast::AstNode* const node)
+	{
+		if (event == scope::NodeProcessorEvent_e::onBegin)
+		{
+			switch (node->nodeType)
+			{
+			case AstNodeType_e::CodeUnit:
+				beginCodeUnit(node->to<ast::CodeUnit>());
+				break;
+			case AstNodeType_e::NamespaceDecl:
+			case AstNodeType_e::TraitDecl:
+				pushScope(joinPath(mScopeStack.back().path, toString(node->identifier)), invalidIndex);
+				break;
+			case AstNodeType_e::ClassDecl:
+				beginClass(node->to<ast::ClassDecl>());
+				break;
+			case AstNodeType_e::StructDecl:
+				generateStructInit(node->to<ast::StructDecl>());
+				break;
+			case AstNodeType_e::TraitForDecl:
+				beginTraitFor(node->to<ast::TraitForDecl>());
+				break;
+			case AstNodeType_e::FunctionDecl:
+				generateFunction(node->to<ast::FunctionDecl>());
+				break;
+			case AstNodeType_e::VariableDecl:
+				generateGlobalVariable(node->to<ast::VariableDecl>());
+				break;
+			case AstNodeType_e::ClassFunctionDecl:
+				generateClassFunction(node->to<ast::ClassFunctionDecl>());
+				break;
+			case AstNodeType_e::ClassConstructorDecl:
+				generateConstructor(node->to<ast::ClassConstructorDecl>());
+				break;
+			case AstNodeType_e::ClassDestructorDecl:
+				generateDestructor(node->to<ast::ClassDestructorDecl>());
+				break;
+			case AstNodeType_e::TraitFunctionDecl:
+				generateTraitFunction(node->to<ast::TraitFunctionDecl>());
+				break;
+			default:
+				break;
+			}
+			return;
+		}
+
+		switch (node->nodeType)
+		{
+		case AstNodeType_e::CodeUnit:
+			endCodeUnit();
+			break;
+		case AstNodeType_e::NamespaceDecl:
+		case AstNodeType_e::TraitDecl:
+		case AstNodeType_e::ClassDecl:
+		case AstNodeType_e::TraitForDecl:
+			popScope();
+			break;
+		default:
+			break;
+		}
+	}
+
+	BytecodeModule* const
+	CodeGenerator::getModule()
+	{
+		return mModule.get();
+	}
+
+	void
+	CodeGenerator::beginCodeUnit(ast::CodeUnit* const codeUnit)
+	{
+		mCodeUnit = codeUnit;
+		mFilename = toString(codeUnit->identifier);
+
+		mScopeStack.clear();
+		mScopeStack.push_back(ScopeState_s { String(), invalidIndex });
+
+		mIncludeAliasMap.clear();
+		mIncludeWildcardList.clear();
+
+		// Os nomes incluidos apontam para o caminho completo do simbolo no code unit de origem.
+		for (auto& includeDecl : codeUnit->includeDeclList)
+		{
+			for (auto& includeItemDecl : includeDecl->includedItemList)
+			{
+				String scopePath;
+				for (auto scopedPathDecl = includeItemDecl->scopePath.get(); scopedPathDecl; scopedPathDecl = scopedPathDecl->scopedChildPath.get())
+				{
+					scopePath = joinPath(scopePath, toString(scopedPathDecl->identifier));
+				}
+
+				if (includeItemDecl->includeAll)
+				{
+					mIncludeWildcardList.push_back(scopePath);
+				}
+				else if (includeItemDecl->referencedAlias.str() != nullptr)
+				{
+					mIncludeAliasMap[toString(includeItemDecl->identifier)] = joinPath(scopePath, toString(includeItemDecl->referencedAlias));
+				}
+				else
+				{
+					mIncludeAliasMap[toString(includeItemDecl->identifier)] = joinPath(scopePath, toString(includeItemDecl->identifier));
+				}
+			}
+		}
+
+		// Declara todos os simbolos antes de gerar o codigo, permitindo
+		// referencias a funcoes e classes declaradas mais adiante.
+		for (auto& namespaceDecl : codeUnit->namespaceDeclList)
+		{
+			declareScope(toString(namespaceDecl->identifier), namespaceDecl.get());
+		}
+
+		// As variaveis globais do code unit sao inicializadas em uma funcao propria.
+		mInitFunction = std::make_unique<FunctionState_s>();
+		beginFunction(*mInitFunction, mModule->insertFunction("<init>::" + mFilename), false);
+		mFunction = nullptr;
+	}
+
+	void
+	CodeGenerator::endCodeUnit()
+	{
+		mFunction = mInitFunction.get();
+		emitABC(OpCode_e::Return, 0, 0, 0);
+		endFunction(*mInitFunction);
+
+		mModule->insertInitFunction(mInitFunction->functionIndex);
+
+		mInitFunction.reset();
+		mFunction = nullptr;
+		mCodeUnit = nullptr;
+	}
+
+	void
+	CodeGenerator::declareScope(const String& scopePath, ast::AstNode* const scope)
+	{
+		auto namespaceDecl = scope->to<ast::NamespaceDecl>();
+
+		for (auto& childNamespaceDecl : namespaceDecl->namespaceDeclList)
+		{
+			declareScope(joinPath(scopePath, toString(childNamespaceDecl->identifier)), childNamespaceDecl.get());
+		}
+
+		for (auto& generalDecl : namespaceDecl->generalDeclList)
+		{
+			const String generalPath = joinPath(scopePath, toString(generalDecl->identifier));
+
+			switch (generalDecl->nodeType)
+			{
+			case AstNodeType_e::FunctionDecl:
+				{
+					auto functionDecl = generalDecl->to<ast::FunctionDecl>();
+					const U32 functionIndex = mModule->insertFunction(generalPath);
+
+					mModule->getFunction(functionIndex)->parameterCount = static_cast<U32>(functionDecl->parameterList.size());
+					mFunctionIndexMap[functionDecl] = functionIndex;
+				}
+				break;
+			case AstNodeType_e::VariableDecl:
+				mModule->insertGlobal(generalPath);
+				break;
+			case AstNodeType_e::ClassDecl:
+				declareClass(generalPath, generalDecl->to<ast::ClassDecl>());
+				break;
+			case AstNodeType_e::StructDecl:
+				declareStruct(generalPath, generalDecl->to<ast::StructDecl>());
+				break;
+			case AstNodeType_e::EnumDecl:
+				declareEnum(generalPath, generalDecl->to<ast::EnumDecl>());
+				break;
+			case AstNodeType_e::TraitDecl:
+				{
+					// Somente as funcoes com implementacao padrao geram codigo.
+					for (auto& traitFunctionDecl : generalDecl->to<ast::TraitDecl>()->functionDeclList)
+					{
+						if (traitFunctionDecl->blockDecl == nullptr && traitFunctionDecl->exprDecl == nullptr)
+						{
+							continue;
+						}
+
+						const U32 functionIndex = mModule->insertFunction(joinPath(generalPath, toString(traitFunctionDecl->identifier)));
+						auto function = mModule->getFunction(functionIndex);
+
+						function->isMethod = !traitFunctionDecl->isStatic;
+						function->parameterCount = static_cast<U32>(traitFunctionDecl->parameterList.size()) + (function->isMethod ? 1 : 0);
+						mFunctionIndexMap[traitFunctionDecl.get()] = functionIndex;
+					}
+				}
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	void
+	CodeGenerator::declareClass(const String& classPath, ast::ClassDecl* const classDecl)
+	{
+		const U32 classIndex = mModule->insertClass(classPath);
+
+		// Variaveis estaticas sao globais qualificadas pelo nome da classe.
+		for (auto& variableDecl : classDecl->variableList)
+		{
+			if (variableDecl->isStatic)
+			{
+				mModule->insertGlobal(joinPath(classPath, toString(variableDecl->identifier)));
+			}
+			else
+			{
+				mModule->getClass(classIndex)->fieldList.push_back(toString(variableDecl->identifier));
+			}
+		}
+
+		const U32 initFunctionIndex = mModule->insertFunction(joinPath(classPath, "<init>"));
+		mModule->getFunction(initFunctionIndex)->isMethod = true;
+		mModule->getFunction(initFunctionIndex)->parameterCount = 1;
+		mModule->getClass(classIndex)->initFunctionIndex = initFunctionIndex;
+
+		for (auto& functionDecl : classDecl->functionList)
+		{
+			if (functionDecl->isAbstract)
+			{
+				continue;
+			}
+
+			const String identifier = toString(functionDecl->identifier);
+			const U32 functionIndex = mModule->insertFunction(joinPath(classPath, identifier));
+			auto function = mModule->getFunction(functionIndex);
+
+			function->isMethod = !functionDecl->isStatic;
+			function->parameterCount = static_cast<U32>(functionDecl->parameterList.size()) + (function->isMethod ? 1 : 0);
+
+			if (function->isMethod)
+			{
+				mModule->getClass(classIndex)->methodList.push_back(BytecodeMethod_s { identifier, functionIndex });
+			}
+			mFunctionIndexMap[functionDecl.get()] = functionIndex;
+		}
+
+		for (U32 i = 0; i < classDecl->constructorList.size(); i++)
+		{
+			auto constructorDecl = classDecl->constructorList[i].get();
+
+			const U32 functionIndex = mModule->insertFunction(joinPath(classPath, "<constructor>#" + std::to_string(i)));
+			auto function = mModule->getFunction(functionIndex);
+
+			function->isMethod = true;
+			function->parameterCount = static_cast<U32>(constructorDecl->parameterList.size()) + 1;
+
+			mModule->getClass(classIndex)->constructorList.push_back(functionIndex);
+			mFunctionIndexMap[constructorDecl] = functionIndex;
+		}
+
+		if (classDecl->destructorDecl)
+		{
+			const U32 functionIndex = mModule->insertFunction(joinPath(classPath, "<destructor>"));
+
+			mModule->getFunction(functionIndex)->isMethod = true;
+			mModule->getFunction(functionIndex)->parameterCount = 1;
+
+			mModule->getClass(classIndex)->destructorFunctionIndex = functionIndex;
+			mFunctionIndexMap[classDecl->destructorDecl.get()] = functionIndex;
+		}
+	}
+
+	void
+	CodeGenerator::declareStruct(const String& structPath, ast::StructDecl* const structDecl)
+	{
+		// Structs sao objetos sem metodos, construidos pelo bloco de inicializacao.
+		const U32 classIndex = mModule->insertClass(structPath);
+
+		for (auto& variableDecl : structDecl->variableList)
+		{
+			mModule->getClass(classIndex)->fieldList.push_back(toString(variableDecl->identifier));
+		}
+
+		const U32 initFunctionIndex = mModule->insertFunction(joinPath(structPath, "<init>"));
+		mModule->getFunction(initFunctionIndex)->isMethod = true;
+		mModule->getFunction(initFunctionIndex)->parameterCount = 1;
+		mModule->getClass(classIndex)->initFunctionIndex = initFunctionIndex;
+	}
+
+	void
+	CodeGenerator::declareEnum(const String& enumPath, ast::EnumDecl* const enumDecl)
+	{
+		I64 nextValue = 0;
+
+		for (auto& enumItemDecl : enumDecl->enumItemDeclList)
+		{
+			// Itens com dados precisam de um objeto em tempo de execucao.
+			if (enumItemDecl->hasData)
+			{
+				continue;
+			}
+
+			if (enumItemDecl->hasValue)
+			{
+				auto valueExpression = enumItemDecl->valueExpression.get();
+
+				if (valueExpression->nodeType != AstNodeType_e::ConstantIntegerExpr)
+				{
+					throw exceptions::not_implemented_feature_exception(mFilename, "enum items with non integer values");
+				}
+				nextValue = valueExpression->to<ast::expr::ExpressionConstantIntegerDecl>()->valueDecl;
+			}
+			mEnumValueMap[joinPath(enumPath, toString(enumItemDecl->identifier))] = nextValue++;
+		}
+	}
+
+	void
+	CodeGenerator::pushScope(const String& scopePath, U32 classIndex)
+	{
+		mScopeStack.push_back(ScopeState_s { scopePath, classIndex });
+	}
+
+	void
+	CodeGenerator::popScope()
+	{
+		mScopeStack.pop_back();
+	}
+
+	void
+	CodeGenerator::beginClass(ast::ClassDecl* const classDecl)
+	{
+		const String classPath = joinPath(mScopeStack.back().path, toString(classDecl->identifier));
+		const U32 classIndex = mModule->findClass(classPath);
+
+		if (classDecl->baseClass)
+		{
+			mModule->getClass(classIndex)->baseClassIndex = resolveClass(classDecl->baseClass.get());
+		}
+
+		pushScope(classPath, classIndex);
+
+		// Gera a funcao de inicializacao dos campos, que inicializa primeiro os campos da base.
+		FunctionState_s functionState;
+		auto previousFunction = mFunction;
+
+		beginFunction(functionState, mModule->getClass(classIndex)->initFunctionIndex, true);
+
+		const U32 baseClassIndex = mModule->getClass(classIndex)->baseClassIndex;
+		if (baseClassIndex != invalidIndex)
+		{
+			const U32 base = allocateRegister();
+			generateMethodCall(mModule->getClass(baseClassIndex)->initFunctionIndex, 0, nullptr, base);
+			releaseRegisters(base);
+		}
+
+		for (auto& variableDecl : classDecl->variableList)
+		{
+			if (variableDecl->isStatic || variableDecl->initExpr == nullptr)
+			{
+				continue;
+			}
+
+			setLine(variableDecl.get());
+
+			const U32 mark = mFunction->freeRegister;
+			const U32 valueReg = generateExprAny(variableDecl->initExpr.get());
+
+			emitABC(OpCode_e::SetField, 0, insertNameConstant(toString(variableDecl->identifier)), valueReg);
+			releaseRegisters(mark);
+		}
+		emitABC(OpCode_e::Return, 0, 0, 0);
+		endFunction(functionState);
+
+		// Variaveis estaticas sao inicializadas junto com as globais do code unit.
+		mFunction = mInitFunction.get();
+
+		for (auto& variableDecl : classDecl->variableList)
+		{
+			if (!variableDecl->isStatic || variableDecl->initExpr == nullptr)
+			{
+				continue;
+			}
+
+			setLine(variableDecl.get());
+
+			const U32 mark = mFunction->freeRegister;
+			const U32 valueReg = generateExprAny(variableDecl->initExpr.get());
+
+			emitABx(OpCode_e::SetGlobal, valueReg, mModule->findGlobal(joinPath(classPath, toString(variableDecl->identifier))));
+			releaseRegisters(mark);
+		}
+		mFunction = previousFunction;
+	}
+
+	void
+	CodeGenerator::beginTraitFor(ast::TraitForDecl* const traitForDecl)
+	{
+		if (traitForDecl->typeDefinitionDecl->nodeType != AstNodeType_e::NamedType)
+		{
+			throw exceptions::not_implemented_feature_exception(mFilename, "trait implementation for primitive types");
+		}
+
+		const U32 classIndex = resolveClass(traitForDecl->typeDefinitionDecl.get());
+		auto classInfo = mModule->getClass(classIndex);
+
+		// As funcoes do trait passam a ser metodos da classe.
+		for (auto& traitFunctionDecl : traitForDecl->functionDeclList)
+		{
+			const String identifier = toString(traitFunctionDecl->identifier);
+			const U32 functionIndex = mModule->insertFunction(joinPath(classInfo->name, identifier));
+			auto function = mModule->getFunction(functionIndex);
+
+			function->isMethod = !traitFunctionDecl->isStatic;
+			function->parameterCount = static_cast<U32>(traitFunctionDecl->parameterList.size()) + (function->isMethod ? 1 : 0);
+
+			if (function->isMethod)
+			{
+				classInfo->methodList.push_back(BytecodeMethod_s { identifier, functionIndex });
+			}
+			mFunctionIndexMap[traitFunctionDecl.get()] = functionIndex;
+		}
+		pushScope(classInfo->name, classIndex);
+	}
+
+	void
+	CodeGenerator::generateStructInit(ast::StructDecl* const structDecl)
+	{
+		const String structPath = joinPath(mScopeStack.back().path, toString(structDecl->identifier));
+		auto classInfo = mModule->getClass(mModule->findClass(structPath));
+
+		FunctionState_s functionState;
+		auto previousFunction = mFunction;
+
+		beginFunction(functionState, classInfo->initFunctionIndex, true);
+
+		for (auto& variableDecl : structDecl->variableList)
+		{
+			if (variableDecl->initExpr == nullptr)
+			{
+				continue;
+			}
+
+			setLine(variableDecl.get());
+
+			const U32 mark = mFunction->freeRegister;
+			const U32 valueReg = generateExprAny(variableDecl->initExpr.get());
+
+			emitABC(OpCode_e::SetField, 0, insertNameConstant(toString(variableDecl->identifier)), valueReg);
+			releaseRegisters(mark);
+		}
+		emitABC(OpCode_e::Return, 0, 0, 0);
+		endFunction(functionState);
+
+		mFunction = previousFunction;
+	}
+
+	void
+	CodeGenerator::generateFunction(ast::FunctionDecl* const functionDecl)
+	{
+		generateFunctionBody(
+			mFunctionIndexMap.at(functionDecl),
+			false,
+			functionDecl->parameterList,
+			functionDecl->blockDecl.get(),
+			functionDecl->exprDecl.get()
+		);
+	}
+
+	void
+	CodeGenerator::generateClassFunction(ast::ClassFunctionDecl* const classFunctionDecl)
+	{
+		if (classFunctionDecl->isAbstract)
+		{
+			return;
+		}
+
+		generateFunctionBody(
+			mFunctionIndexMap.at(classFunctionDecl),
+			!classFunctionDecl->isStatic,
+			classFunctionDecl->parameterList,
+			classFunctionDecl->blockDecl.get(),
+			classFunctionDecl->exprDecl.get()
+		);
+	}
+
+	void
+	CodeGenerator::generateTraitFunction(ast::TraitFunctionDecl* const traitFunctionDecl)
+	{
+		auto it = mFunctionIndexMap.find(traitFunctionDecl);
+
+		// Funcoes sem implementacao padrao nao geram codigo.
+		if (it == mFunctionIndexMap.end())
+		{
+			return;
+		}
+
+		generateFunctionBody(
+			it->second,
+			!traitFunctionDecl->isStatic,
+			traitFunctionDecl->parameterList,
+			traitFunctionDecl->blockDecl.get(),
+			traitFunctionDecl->exprDecl.get()
+		);
+	}
+
+	void
+	CodeGenerator::generateConstructor(ast::ClassConstructorDecl* const constructorDecl)
+	{
+		FunctionState_s functionState;
+		auto previousFunction = mFunction;
+
+		beginFunction(functionState, mFunctionIndexMap.at(constructorDecl), true);
+		declareParameters(constructorDecl->parameterList);
+
+		setLine(constructorDecl);
+
+		// Chama o construtor da classe base: explicitamente pelo super(...) ou o
+		// construtor sem parametros, quando existir.
+		const U32 baseClassIndex = mModule->getClass(mScopeStack.back().classIndex)->baseClassIndex;
+		if (baseClassIndex != invalidIndex)
+		{
+			std::vector<ast::expr::ExpressionDecl*> argumentList;
+			collectArguments(constructorDecl->superInitExpr.get(), argumentList);
+
+			U32 baseConstructorIndex = invalidIndex;
+			for (auto functionIndex : mModule->getClass(baseClassIndex)->constructorList)
+			{
+				if (mModule->getFunction(functionIndex)->parameterCount == argumentList.size() + 1)
+				{
+					baseConstructorIndex = functionIndex;
+					break;
+				}
+			}
+
+			if (baseConstructorIndex != invalidIndex)
+			{
+				const U32 base = allocateRegister();
+				generateMethodCall(baseConstructorIndex, 0, constructorDecl->superInitExpr.get(), base);
+				releaseRegisters(base);
+			}
+			else if (constructorDecl->superInitExpr)
+			{
+				throw exceptions::custom_exception(
+					"No constructor of '%s' receives %d arguments",
+					constructorDecl->line,
+					constructorDecl->column,
+					mModule->getClass(baseClassIndex)->name.c_str(),
+					static_cast<U32>(argumentList.size())
+				);
+			}
+		}
+
+		// Inicializa os campos listados no construtor.
+		for (auto& variableInitDecl : constructorDecl->variableInitDeclList)
+		{
+			const U32 mark = mFunction->freeRegister;
+			U32 valueReg = 0;
+
+			if (variableInitDecl->initExpr)
+			{
+				valueReg = generateExprAny(variableInitDecl->initExpr.get());
+			}
+			else
+			{
+				valueReg = allocateRegister();
+				emitABC(OpCode_e::LoadNull, valueReg, 0, 0);
+			}
+
+			emitABC(OpCode_e::SetField, 0, insertNameConstant(toString(variableInitDecl->identifier)), valueReg);
+			releaseRegisters(mark);
+		}
+
+		if (constructorDecl->blockDecl)
+		{
+			generateBlock(constructorDecl->blockDecl.get());
+		}
+		emitABC(OpCode_e::Return, 0, 0, 0);
+		endFunction(functionState);
+
+		mFunction = previousFunction;
+	}
+
+	void
+	CodeGenerator::generateDestructor(ast::ClassDestructorDecl* const destructorDecl)
+	{
+		FunctionParameterDeclPtrList emptyParameterList;
+
+		generateFunctionBody(
+			mFunctionIndexMap.at(destructorDecl),
+			true,
+			emptyParameterList,
+			destructorDecl->blockDecl.get(),
+			nullptr
+		);
+	}
+
+	void
+	CodeGenerator::generateGlobalVariable(ast::VariableDecl* const variableDecl)
+	{
+		auto previousFunction = mFunction;
+		mFunction = mInitFunction.get();
+
+		setLine(variableDecl);
+
+		const U32 globalIndex = mModule->findGlobal(joinPath(mScopeStack.back().path, toString(variableDecl->identifier)));
+		const U32 mark = mFunction->freeRegister;
+
+		U32 valueReg = 0;
+		if (variableDecl->initExpr)
+		{
+			valueReg = generateExprAny(variableDecl->initExpr.get());
+		}
+		else
+		{
+			valueReg = allocateRegister();
+			emitABC(OpCode_e::LoadNull, valueReg, 0, 0);
+		}
+
+		emitABx(OpCode_e::SetGlobal, valueReg, globalIndex);
+		releaseRegisters(mark);
+
+		mFunction = previousFunction;
+	}
+
+	void
+	CodeGenerator::generateFunctionBody(U32 functionIndex, Bool isMethod, FunctionParameterDeclPtrList& parameterList, ast::BlockDecl* const blockDecl, ast::expr::ExpressionDecl* const exprDecl)
+	{
+		FunctionState_s functionState;
+		auto previousFunction = mFunction;
+
+		beginFunction(functionState, functionIndex, isMethod);
+		declareParameters(parameterList);
+
+		if (exprDecl)
+		{
+			// Funcoes declaradas com '=' retornam o valor da expressao.
+			setLine(exprDecl);
+			emitABC(OpCode_e::Return, generateExprAny(exprDecl), 1, 0);
+		}
+		else
+		{
+			if (blockDecl)
+			{
+				generateBlock(blockDecl);
+			}
+			emitABC(OpCode_e::Return, 0, 0, 0);
+		}
+		endFunction(functionState);
+
+		mFunction = previousFunction;
+	}
+
+	void
+	CodeGenerator::declareParameters(FunctionParameterDeclPtrList& parameterList)
+	{
+		for (auto& parameterDecl : parameterList)
+		{
+			if (parameterDecl->patternDecl)
+			{
+				throw exceptions::not_implemented_feature_exception(mFilename, "parameter destructuring");
+			}
+			declareLocal(toString(parameterDecl->identifier), allocateRegister());
+		}
+	}
+
+	void
+	CodeGenerator::beginFunction(FunctionState_s& functionState, U32 functionIndex, Bool isMethod)
+	{
+		functionState.function = mModule->getFunction(functionIndex);
+		functionState.functionIndex = functionIndex;
+		functionState.freeRegister = 0;
+		functionState.line = 0;
+
+		mFunction = &functionState;
+
+		// O registrador 0 dos metodos guarda o 'this'.
+		if (isMethod)
+		{
+			allocateRegister();
+		}
+	}
+
+	void
+	CodeGenerator::endFunction(FunctionState_s& functionState)
+	{
+		if (functionState.pendingGotoList.size())
+		{
+			auto& pendingGoto = functionState.pendingGotoList.front();
+
+			throw exceptions::custom_exception(
+				"Label '%s' not found",
+				pendingGoto.line,
+				pendingGoto.column,
+				pendingGoto.label.c_str()
+			);
+		}
+	}
+
+	void
+	CodeGenerator::generateBlock(ast::BlockDecl* const blockDecl)
+	{
+		const size_t localCount = mFunction->localList.size();
+		const U32 mark = mFunction->freeRegister;
+
+		for (auto& stmtDecl : blockDecl->stmtList)
+		{
+			generateStmt(stmtDecl.get());
+		}
+
+		// Variaveis do bloco saem de escopo.
+		mFunction->localList.resize(localCount);
+		releaseRegisters(mark);
+	}
+
+	void
+	CodeGenerator::generateStmt(ast::stmt::StmtDecl* const stmtDecl)
+	{
+		setLine(stmtDecl);
+
+		const U32 mark = mFunction->freeRegister;
+
+		switch (stmtDecl->nodeType)
+		{
+		case AstNodeType_e::StmtExpr:
+			generateExprAny(stmtDecl->to<ast::stmt::StmtExprDecl>()->exprDecl.get());
+			break;
+		case AstNodeType_e::StmtVariable:
+			{
+				auto variableDecl = stmtDecl->to<ast::stmt::StmtVariableDecl>();
+
+				if (variableDecl->patternDecl)
+				{
+					throw exceptions::not_implemented_feature_exception(mFilename, "variable destructuring");
+				}
+
+				const U32 reg = allocateRegister();
+
+				if (variableDecl->initExpr)
+				{
+					generateExprTo(variableDecl->initExpr.get(), reg);
+				}
+				else
+				{
+					emitABC(OpCode_e::LoadNull, reg, 0, 0);
+				}
+
+				// A variavel so e visivel apos a expressao de inicializacao.
+				declareLocal(toString(variableDecl->identifier), reg);
+			}
+			return;
+		case AstNodeType_e::StmtIf:
+			{
+				auto ifDecl = stmtDecl->to<ast::stmt::StmtIfDecl>();
+
+				const U32 conditionReg = generateExprAny(ifDecl->conditionExprDecl.get());
+				const U32 elseJump = emitJump(OpCode_e::JumpIfFalse, conditionReg);
+				releaseRegisters(mark);
+
+				generateBlock(ifDecl->ifBlockDecl.get());
+
+				if (ifDecl->elseBlockDecl)
+				{
+					const U32 endJump = emitJump(OpCode_e::Jump, 0);
+					patchJump(elseJump);
+					generateBlock(ifDecl->elseBlockDecl.get());
+					patchJump(endJump);
+				}
+				else
+				{
+					patchJump(elseJump);
+				}
+			}
+			break;
+		case AstNodeType_e::StmtWhile:
+			{
+				auto whileDecl = stmtDecl->to<ast::stmt::StmtWhileDecl>();
+
+				const U32 loopPc = currentPc();
+				const U32 conditionReg = generateExprAny(whileDecl->conditionExprDecl.get());
+				const U32 exitJump = emitJump(OpCode_e::JumpIfFalse, conditionReg);
+				releaseRegisters(mark);
+
+				mFunction->loopList.emplace_back();
+				generateBlock(whileDecl->blockDecl.get());
+				patchJumpTo(emitJump(OpCode_e::Jump, 0), loopPc);
+				patchJump(exitJump);
+
+				LoopState_s loopState = std::move(mFunction->loopList.back());
+				mFunction->loopList.pop_back();
+
+				for (auto jumpPc : loopState.breakJumpList) patchJump(jumpPc);
+				for (auto jumpPc : loopState.continueJumpList) patchJumpTo(jumpPc, loopPc);
+			}
+			break;
+		case AstNodeType_e::StmtDoWhile:
+			{
+				auto doWhileDecl = stmtDecl->to<ast::stmt::StmtDoWhileDecl>();
+
+				const U32 loopPc = currentPc();
+
+				mFunction->loopList.emplace_back();
+				generateBlock(doWhileDecl->blockDecl.get());
+
+				const U32 conditionPc = currentPc();
+				const U32 conditionReg = generateExprAny(doWhileDecl->conditionExprDecl.get());
+				patchJumpTo(emitJump(OpCode_e::JumpIfTrue, conditionReg), loopPc);
+				releaseRegisters(mark);
+
+				LoopState_s loopState = std::move(mFunction->loopList.back());
+				mFunction->loopList.pop_back();
+
+				for (auto jumpPc : loopState.breakJumpList) patchJump(jumpPc);
+				for (auto jumpPc : loopState.continueJumpList) patchJumpTo(jumpPc, conditionPc);
+			}
+			break;
+		case AstNodeType_e::StmtFor:
+			{
+				auto forDecl = stmtDecl->to<ast::stmt::StmtForDecl>();
+				const size_t localCount = mFunction->localList.size();
+
+				if (forDecl->initStmtDecl)
+				{
+					const U32 reg = allocateRegister();
+					generateExprTo(forDecl->initStmtDecl->initExpr.get(), reg);
+					declareLocal(toString(forDecl->initStmtDecl->identifier), reg);
+				}
+				else if (forDecl->initExprDecl)
+				{
+					generateExprAny(forDecl->initExprDecl.get());
+					releaseRegisters(mark);
+				}
+
+				const U32 loopMark = mFunction->freeRegister;
+				const U32 loopPc = currentPc();
+
+				U32 exitJump = invalidIndex;
+				if (forDecl->conditionExprDecl)
+				{
+					const U32 conditionReg = generateExprAny(forDecl->conditionExprDecl.get());
+					exitJump = emitJump(OpCode_e::JumpIfFalse, conditionReg);
+					releaseRegisters(loopMark);
+				}
+
+				mFunction->loopList.emplace_back();
+				generateBlock(forDecl->blockDecl.get());
+
+				const U32 updatePc = currentPc();
+				if (forDecl->updateExprDecl)
+				{
+					generateExprAny(forDecl->updateExprDecl.get());
+					releaseRegisters(loopMark);
+				}
+				patchJumpTo(emitJump(OpCode_e::Jump, 0), loopPc);
+
+				if (exitJump != invalidIndex)
+				{
+					patchJump(exitJump);
+				}
+
+				LoopState_s loopState = std::move(mFunction->loopList.back());
+				mFunction->loopList.pop_back();
+
+				for (auto jumpPc : loopState.breakJumpList) patchJump(jumpPc);
+				for (auto jumpPc : loopState.continueJumpList) patchJumpTo(jumpPc, updatePc);
+
+				mFunction->localList.resize(localCount);
+			}
+			break;
+		case AstNodeType_e::StmtMatch:
+			generateStmtMatch(stmtDecl->to<ast::stmt::StmtMatchDecl>());
+			break;
+		case AstNodeType_e::StmtReturn:
+			{
+				auto returnDecl = stmtDecl->to<ast::stmt::StmtReturnDecl>();
+
+				if (returnDecl->exprDecl)
+				{
+					emitABC(OpCode_e::Return, generateExprAny(returnDecl->exprDecl.get()), 1, 0);
+				}
+				else
+				{
+					emitABC(OpCode_e::Return, 0, 0, 0);
+				}
+			}
+			break;
+		case AstNodeType_e::StmtContinue:
+		case AstNodeType_e::StmtBreak:
+			{
+				if (mFunction->loopList.empty())
+				{
+					throw exceptions::custom_exception(
+						"'%s' outside of a loop",
+						stmtDecl->line,
+						stmtDecl->column,
+						stmtDecl->nodeType == AstNodeType_e::StmtBreak ? "break" : "continue"
+					);
+				}
+
+				const U32 jumpPc = emitJump(OpCode_e::Jump, 0);
+
+				if (stmtDecl->nodeType == AstNodeType_e::StmtBreak)
+				{
+					mFunction->loopList.back().breakJumpList.push_back(jumpPc);
+				}
+				else
+				{
+					mFunction->loopList.back().continueJumpList.push_back(jumpPc);
+				}
+			}
+			break;
+		case AstNodeType_e::StmtGoto:
+			{
+				const String label = toString(stmtDecl->to<ast::stmt::StmtGotoDecl>()->labelIdentifier);
+				const U32 jumpPc = emitJump(OpCode_e::Jump, 0);
+
+				auto it = mFunction->labelMap.find(label);
+				if (it != mFunction->labelMap.end())
+				{
+					patchJumpTo(jumpPc, it->second);
+				}
+				else
+				{
+					mFunction->pendingGotoList.push_back(PendingGoto_s { label, jumpPc, stmtDecl->line, stmtDecl->column });
+				}
+			}
+			break;
+		case AstNodeType_e::StmtLabel:
+			{
+				const String label = toString(stmtDecl->identifier);
+				const U32 labelPc = currentPc();
+
+				mFunction->labelMap[label] = labelPc;
+
+				// Resolve os gotos que apareceram antes do label.
+				auto& pendingGotoList = mFunction->pendingGotoList;
+				for (auto it = pendingGotoList.begin(); it != pendingGotoList.end();)
+				{
+					if (it->label == label)
+					{
+						patchJumpTo(it->pc, labelPc);
+						it = pendingGotoList.erase(it);
+						continue;
+					}
+					it++;
+				}
+			}
+			break;
+		case AstNodeType_e::StmtPanic:
+			emitABC(OpCode_e::Panic, generateExprAny(stmtDecl->to<ast::stmt::StmtPanicDecl>()->exprDecl.get()), 0, 0);
+			break;
+		case AstNodeType_e::StmtIfLet:
+			throw exceptions::not_implemented_feature_exception(mFilename, "if let");
+		case AstNodeType_e::StmtTry:
+			throw exceptions::not_implemented_feature_exception(mFilename, "try catch");
+		default:
+			throw exceptions::custom_exception(
+				"Invalid statement",
+				stmtDecl->line,
+				stmtDecl->column
+			);
+		}
+		releaseRegisters(mark);
+	}
+
+	void
+	CodeGenerator::generateStmtMatch(ast::stmt::StmtMatchDecl* const stmtMatchDecl)
+	{
+		const U32 subjectReg = generateExprAny(stmtMatchDecl->conditionExprDecl.get());
+		const U32 mark = mFunction->freeRegister;
+
+		std::vector<ast::pattern::PatternDecl*> patternList;
+		for (auto& whenDecl : stmtMatchDecl->whenDeclList)
+		{
+			patternList.push_back(whenDecl->patternDecl.get());
+		}
+
+		match::JumpTable_s jumpTable;
+		const U32 switchPc = emitMatchSwitch(patternList, subjectReg, jumpTable);
+
+		std::vector<U32> endJumpList;
+		std::vector<U32> testPcList;
+		std::vector<U32> bodyPcList;
+
+		// Testa os padroes na ordem em que foram declarados, valores que nao sao
+		// inteiros seguem pelos testes mesmo quando ha tabela de saltos.
+		for (auto& whenDecl : stmtMatchDecl->whenDeclList)
+		{
+			const size_t localCount = mFunction->localList.size();
+
+			testPcList.push_back(currentPc());
+			const U32 nextJump = generatePatternTest(whenDecl->patternDecl.get(), subjectReg);
+			bodyPcList.push_back(currentPc());
+
+			generateBlock(whenDecl->blockDecl.get());
+			endJumpList.push_back(emitJump(OpCode_e::Jump, 0));
+
+			if (nextJump != invalidIndex)
+			{
+				patchJump(nextJump);
+			}
+
+			mFunction->localList.resize(localCount);
+			releaseRegisters(mark);
+		}
+
+		if (switchPc != invalidIndex)
+		{
+			patchMatchSwitch(switchPc, jumpTable, testPcList, bodyPcList, currentPc());
+		}
+
+		for (auto jumpPc : endJumpList)
+		{
+			patchJump(jumpPc);
+		}
+	}
+
+	void
+	CodeGenerator::generateExprTo(ast::expr::ExpressionDecl* const exprDecl, U32 target)
+	{
+		setLine(exprDecl);
+
+		const U32 mark = mFunction->freeRegister;
+
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::ConstantBoolExpr:
+			emitABC(OpCode_e::LoadBool, target, exprDecl->to<ast::expr::ExpressionConstantBoolDecl>()->valueDecl ? 1 : 0, 0);
+			break;
+		case AstNodeType_e::ConstantIntegerExpr:
+			{
+				auto integerDecl = exprDecl->to<ast::expr::ExpressionConstantIntegerDecl>();
+
+				// Inteiros pequenos sao carregados sem consultar o pool de constantes.
+				if (integerDecl->valueType == PrimitiveTypeID_e::I32 && integerDecl->valueDecl >= -maxOperandSBx && integerDecl->valueDecl <= maxOperandSBx)
+				{
+					emitABx(OpCode_e::LoadInt, target, static_cast<U32>(integerDecl->valueDecl + maxOperandSBx));
+				}
+				else
+				{
+					emitABx(OpCode_e::LoadConst, target, insertConstant(mModule->insertIntegerConstant(integerDecl->valueDecl, integerDecl->valueType)));
+				}
+			}
+			break;
+		case AstNodeType_e::ConstantRealExpr:
+			{
+				auto realDecl = exprDecl->to<ast::expr::ExpressionConstantRealDecl>();
+				emitABx(OpCode_e::LoadConst, target, insertConstant(mModule->insertRealConstant(realDecl->valueDecl, realDecl->valueType)));
+			}
+			break;
+		case AstNodeType_e::ConstantStringExpr:
+			emitABx(OpCode_e::LoadConst, target, insertConstant(mModule->insertStringConstant(exprDecl->to<ast::expr::ExpressionConstantStringDecl>()->valueDecl)));
+			break;
+		case AstNodeType_e::ConstantCharExpr:
+			emitABx(OpCode_e::LoadConst, target, insertConstant(mModule->insertIntegerConstant(exprDecl->to<ast::expr::ExpressionConstantCharDecl>()->valueDecl, PrimitiveTypeID_e::I8)));
+			break;
+		case AstNodeType_e::ConstantNullExpr:
+			emitABC(OpCode_e::LoadNull, target, 0, 0);
+			break;
+		case AstNodeType_e::ThisExpr:
+		case AstNodeType_e::SuperExpr:
+			if (!mFunction->function->isMethod)
+			{
+				throw exceptions::custom_exception(
+					"'%s' used outside of a method",
+					exprDecl->line,
+					exprDecl->column,
+					exprDecl->nodeType == AstNodeType_e::ThisExpr ? "this" : "super"
+				);
+			}
+			if (target != 0)
+			{
+				emitABC(OpCode_e::Move, target, 0, 0);
+			}
+			break;
+		case AstNodeType_e::IdentifierExpr:
+			{
+				auto identifierDecl = exprDecl->to<ast::expr::ExpressionIdentifierDecl>();
+				const String identifier = toString(identifierDecl->identifier);
+
+				loadSymbol(resolveSymbol(identifier, identifierDecl->startFromRoot), identifier, target, exprDecl);
+			}
+			break;
+		case AstNodeType_e::BinaryExpr:
+			generateBinary(exprDecl->to<ast::expr::ExpressionBinaryDecl>(), target);
+			break;
+		case AstNodeType_e::UnaryExpr:
+			generateUnary(exprDecl->to<ast::expr::ExpressionUnaryDecl>(), target);
+			break;
+		case AstNodeType_e::TernaryExpr:
+			{
+				auto ternaryDecl = exprDecl->to<ast::expr::ExpressionTernaryDecl>();
+
+				const U32 conditionReg = generateExprAny(ternaryDecl->conditionDecl.get());
+				const U32 elseJump = emitJump(OpCode_e::JumpIfFalse, conditionReg);
+				releaseRegisters(mark);
+
+				generateExprTo(ternaryDecl->leftDecl.get(), target);
+				const U32 endJump = emitJump(OpCode_e::Jump, 0);
+
+				patchJump(elseJump);
+				generateExprTo(ternaryDecl->rightDecl.get(), target);
+				patchJump(endJump);
+			}
+			break;
+		case AstNodeType_e::AsExpr:
+			{
+				auto asDecl = exprDecl->to<ast::expr::ExpressionAsDecl>();
+				const U32 valueReg = generateExprAny(asDecl->exprDecl.get());
+
+				if (asDecl->typeDecl->nodeType == AstNodeType_e::PrimitiveType)
+				{
+					emitABC(OpCode_e::Cast, target, valueReg, static_cast<U32>(asDecl->typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType));
+				}
+				else
+				{
+					emitABC(OpCode_e::AsType, target, valueReg, insertNameConstant(resolveTypeName(asDecl->typeDecl.get())));
+				}
+			}
+			break;
+		case AstNodeType_e::IsExpr:
+			{
+				auto isDecl = exprDecl->to<ast::expr::ExpressionIsDecl>();
+				const U32 valueReg = generateExprAny(isDecl->exprDecl.get());
+
+				emitABC(OpCode_e::IsType, target, valueReg, insertNameConstant(resolveTypeName(isDecl->typeDecl.get())));
+			}
+			break;
+		case AstNodeType_e::FunctionCallExpr:
+			{
+				auto callDecl = exprDecl->to<ast::expr::ExpressionFunctionCall>();
+				generateCall(callDecl->lhsDecl.get(), callDecl->rhsDecl.get(), target);
+			}
+			break;
+		case AstNodeType_e::GenericCallExpr:
+			{
+				// Os tipos genericos nao existem em tempo de execucao.
+				auto genericCallDecl = exprDecl->to<ast::expr::ExpressionGenericCallDecl>();
+				generateCall(genericCallDecl->lhsDecl.get(), genericCallDecl->rhsDecl.get(), target);
+			}
+			break;
+		case AstNodeType_e::IndexExpr:
+			{
+				auto indexDecl = exprDecl->to<ast::expr::ExpressionIndexDecl>();
+
+				const U32 objectReg = generateExprAny(indexDecl->lhsDecl.get());
+				const U32 indexReg = generateExprAny(indexDecl->rhsDecl.get());
+
+				emitABC(OpCode_e::GetIndex, target, objectReg, indexReg);
+			}
+			break;
+		case AstNodeType_e::ArrayInitExpr:
+			{
+				auto& elementList = exprDecl->to<ast::expr::ExpressionArrayInitDecl>()->arrayElementDeclList;
+
+				if (elementList.size() > maxOperandC)
+				{
+					throw exceptions::custom_exception(
+						"Array initializer exceeds the limit of %d elements",
+						exprDecl->line,
+						exprDecl->column,
+						maxOperandC
+					);
+				}
+
+				const U32 firstReg = allocateRegisters(static_cast<U32>(elementList.size()));
+				for (U32 i = 0; i < elementList.size(); i++)
+				{
+					generateExprTo(elementList[i].get(), firstReg + i);
+				}
+				emitABC(OpCode_e::NewArray, target, firstReg, static_cast<U32>(elementList.size()));
+			}
+			break;
+		case AstNodeType_e::NewExpr:
+			generateNew(exprDecl->to<ast::expr::ExpressionNewDecl>(), target);
+			break;
+		case AstNodeType_e::MatchExpr:
+			generateExprMatch(exprDecl->to<ast::expr::ExpressionMatchDecl>(), target);
+			break;
+		case AstNodeType_e::FunctionDeclExpr:
+			throw exceptions::not_implemented_feature_exception(mFilename, "anonymous functions");
+		case AstNodeType_e::AnomClassDeclExpr:
+			throw exceptions::not_implemented_feature_exception(mFilename, "anonymous classes");
+		case AstNodeType_e::PrimitiveTypeExpr:
+			throw exceptions::not_implemented_feature_exception(mFilename, "primitive type expressions");
+		default:
+			throw exceptions::custom_exception(
+				"Invalid expression",
+				exprDecl->line,
+				exprDecl->column
+			);
+		}
+		releaseRegisters(mark);
+	}
+
+	U32
+	CodeGenerator::generateExprAny(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		// Variaveis locais e o 'this' ja estao em registradores.
+		if (exprDecl->nodeType == AstNodeType_e::IdentifierExpr)
+		{
+			auto identifierDecl = exprDecl->to<ast::expr::ExpressionIdentifierDecl>();
+
+			if (!identifierDecl->startFromRoot)
+			{
+				const U32 reg = findLocal(toString(identifierDecl->identifier));
+				if (reg != invalidIndex)
+				{
+					return reg;
+				}
+			}
+		}
+		else if (exprDecl->nodeType == AstNodeType_e::ThisExpr && mFunction->function->isMethod)
+		{
+			return 0;
+		}
+
+		const U32 reg = allocateRegister();
+		generateExprTo(exprDecl, reg);
+		return reg;
+	}
+
+	void
+	CodeGenerator::generateBinary(ast::expr::ExpressionBinaryDecl* const binaryDecl, U32 target)
+	{
+		switch (binaryDecl->op)
+		{
+		case TokenType_e::ScopeResolution:
+			{
+				String path;
+				Bool startFromRoot = false;
+
+				if (!buildScopedPath(binaryDecl, path, startFromRoot))
+				{
+					throw exceptions::custom_exception(
+						"Invalid scoped identifier",
+						binaryDecl->line,
+						binaryDecl->column
+					);
+				}
+				loadSymbol(resolveSymbol(path, startFromRoot), path, target, binaryDecl);
+			}
+			break;
+		case TokenType_e::Dot:
+		case TokenType_e::SafeDot:
+			{
+				if (binaryDecl->rightDecl->nodeType != AstNodeType_e::IdentifierExpr)
+				{
+					throw exceptions::custom_exception(
+						"Expected a field name after '.'",
+						binaryDecl->rightDecl->line,
+						binaryDecl->rightDecl->column
+					);
+				}
+
+				const U32 nameIndex = insertNameConstant(toString(binaryDecl->rightDecl->identifier));
+
+				if (binaryDecl->op == TokenType_e::SafeDot)
+				{
+					// Acesso seguro: o resultado e nulo quando o objeto e nulo.
+					generateExprTo(binaryDecl->leftDecl.get(), target);
+
+					const U32 nullJump = emitJump(OpCode_e::JumpIfNull, target);
+					emitABC(OpCode_e::GetField, target, target, nameIndex);
+					patchJump(nullJump);
+				}
+				else
+				{
+					emitABC(OpCode_e::GetField, target, generateExprAny(binaryDecl->leftDecl.get()), nameIndex);
+				}
+			}
+			break;
+		case TokenType_e::Assign:
+			{
+				const LValue_s lvalue = prepareLValue(binaryDecl->leftDecl.get());
+
+				if (lvalue.type == LValueType_e::Local)
+				{
+					// O valor e avaliado fora do registrador da variavel, que pode
+					// ser lido pela propria expressao.
+					const U32 valueReg = generateExprAny(binaryDecl->rightDecl.get());
+
+					if (valueReg != lvalue.operandA)
+					{
+						emitABC(OpCode_e::Move, lvalue.operandA, valueReg, 0);
+					}
+
+					if (target != lvalue.operandA)
+					{
+						emitABC(OpCode_e::Move, target, lvalue.operandA, 0);
+					}
+				}
+				else
+				{
+					generateExprTo(binaryDecl->rightDecl.get(), target);
+					storeLValue(lvalue, target);
+				}
+			}
+			break;
+		case TokenType_e::LogicalAnd:
+		case TokenType_e::LogicalOr:
+			{
+				// Avaliacao em curto-circuito.
+				generateExprTo(binaryDecl->leftDecl.get(), target);
+
+				const U32 endJump = emitJump(binaryDecl->op == TokenType_e::LogicalAnd ? OpCode_e::JumpIfFalse : OpCode_e::JumpIfTrue, target);
+				generateExprTo(binaryDecl->rightDecl.get(), target);
+				patchJump(endJump);
+			}
+			break;
+		case TokenType_e::Comma:
+			{
+				const U32 mark = mFunction->freeRegister;
+
+				generateExprAny(binaryDecl->leftDecl.get());
+				releaseRegisters(mark);
+
+				generateExprTo(binaryDecl->rightDecl.get(), target);
+			}
+			break;
+		default:
+			{
+				const OpCode_e op = getBinaryOpCode(binaryDecl->op);
+
+				if (op == OpCode_e::Nop)
+				{
+					throw exceptions::custom_exception(
+						"Invalid binary operator",
+						binaryDecl->line,
+						binaryDecl->column
+					);
+				}
+
+				if (isCompoundAssign(binaryDecl->op))
+				{
+					const LValue_s lvalue = prepareLValue(binaryDecl->leftDecl.get());
+
+					if (lvalue.type == LValueType_e::Local)
+					{
+						emitABC(op, lvalue.operandA, lvalue.operandA, generateExprAny(binaryDecl->rightDecl.get()));
+
+						if (target != lvalue.operandA)
+						{
+							emitABC(OpCode_e::Move, target, lvalue.operandA, 0);
+						}
+					}
+					else
+					{
+						const U32 valueReg = allocateRegister();
+
+						loadLValue(lvalue, valueReg);
+						emitABC(op, valueReg, valueReg, generateExprAny(binaryDecl->rightDecl.get()));
+						storeLValue(lvalue, valueReg);
+
+						emitABC(OpCode_e::Move, target, valueReg, 0);
+					}
+					break;
+				}
+
+				const U32 lhsReg = generateExprAny(binaryDecl->leftDecl.get());
+				const U32 rhsReg = generateExprAny(binaryDecl->rightDecl.get());
+
+				emitABC(op, target, lhsReg, rhsReg);
+			}
+			break;
+		}
+	}
+
+	void
+	CodeGenerator::generateUnary(ast::expr::ExpressionUnaryDecl* const unaryDecl, U32 target)
+	{
+		switch (unaryDecl->op)
+		{
+		case TokenType_e::Increment:
+		case TokenType_e::Decrement:
+			{
+				const OpCode_e op = unaryDecl->op == TokenType_e::Increment ? OpCode_e::Add : OpCode_e::Sub;
+				const LValue_s lvalue = prepareLValue(unaryDecl->exprDecl.get());
+
+				const U32 oneReg = allocateRegister();
+				emitABx(OpCode_e::LoadInt, oneReg, static_cast<U32>(1 + maxOperandSBx));
+
+				if (unaryDecl->unaryType == ExpressionUnaryType_e::Posfix)
+				{
+					// O valor da expressao e o anterior a operacao.
+					const U32 valueReg = allocateRegister();
+
+					loadLValue(lvalue, valueReg);
+					emitABC(OpCode_e::Move, target, valueReg, 0);
+					emitABC(op, valueReg, valueReg, oneReg);
+					storeLValue(lvalue, valueReg);
+				}
+				else
+				{
+					loadLValue(lvalue, target);
+					emitABC(op, target, target, oneReg);
+					storeLValue(lvalue, target);
+				}
+			}
+			break;
+		case TokenType_e::Minus:
+			emitABC(OpCode_e::Neg, target, generateExprAny(unaryDecl->exprDecl.get()), 0);
+			break;
+		case TokenType_e::BitWiseNot:
+			emitABC(OpCode_e::BitNot, target, generateExprAny(unaryDecl->exprDecl.get()), 0);
+			break;
+		case TokenType_e::LogicalNot:
+			emitABC(OpCode_e::Not, target, generateExprAny(unaryDecl->exprDecl.get()), 0);
+			break;
+		case TokenType_e::Plus:
+		case TokenType_e::Ref:
+		case TokenType_e::Shared:
+			// 'ref' e 'shared' restringem a posse mas nao mudam o valor no registrador.
+			generateExprTo(unaryDecl->exprDecl.get(), target);
+			break;
+		default:
+			throw exceptions::custom_exception(
+				"Invalid unary operator",
+				unaryDecl->line,
+				unaryDecl->column
+			);
+		}
+	}
+
+	void
+	CodeGenerator::generateCall(ast::expr::ExpressionDecl* const lhsDecl, ast::expr::ExpressionDecl* const argumentsDecl, U32 target)
+	{
+		const U32 mark = mFunction->freeRegister;
+
+		// O registrador base recebe a funcao, seguido pelos argumentos, e depois o retorno.
+		// Quando o destino e o ultimo registrador alocado ele e usado como base.
+		const U32 base = target + 1 == mFunction->freeRegister
+			? target
+			: allocateRegister();
+
+		auto binaryDecl = lhsDecl->nodeType == AstNodeType_e::BinaryExpr
+			? lhsDecl->to<ast::expr::ExpressionBinaryDecl>()
+			: nullptr;
+
+		if (lhsDecl->nodeType == AstNodeType_e::SuperExpr)
+		{
+			// super(...) no corpo do construtor chama o construtor da classe base.
+			const U32 classIndex = mScopeStack.back().classIndex;
+			const U32 baseClassIndex = classIndex != invalidIndex
+				? mModule->getClass(classIndex)->baseClassIndex
+				: invalidIndex;
+
+			std::vector<ast::expr::ExpressionDecl*> argumentList;
+			collectArguments(argumentsDecl, argumentList);
+
+			U32 baseConstructorIndex = invalidIndex;
+			if (baseClassIndex != invalidIndex)
+			{
+				for (auto functionIndex : mModule->getClass(baseClassIndex)->constructorList)
+				{
+					if (mModule->getFunction(functionIndex)->parameterCount == argumentList.size() + 1)
+					{
+						baseConstructorIndex = functionIndex;
+						break;
+					}
+				}
+			}
+
+			if (baseConstructorIndex == invalidIndex || !mFunction->function->isMethod)
+			{
+				throw exceptions::custom_exception(
+					"No base constructor receives %d arguments",
+					lhsDecl->line,
+					lhsDecl->column,
+					static_cast<U32>(argumentList.size())
+				);
+			}
+			generateMethodCall(baseConstructorIndex, 0, argumentsDecl, base);
+		}
+		else if (binaryDecl && (binaryDecl->op == TokenType_e::Dot || binaryDecl->op == TokenType_e::SafeDot))
+		{
+			if (binaryDecl->rightDecl->nodeType != AstNodeType_e::IdentifierExpr)
+			{
+				throw exceptions::custom_exception(
+					"Expected a method name after '.'",
+					binaryDecl->rightDecl->line,
+					binaryDecl->rightDecl->column
+				);
+			}
+
+			const String methodName = toString(binaryDecl->rightDecl->identifier);
+
+			if (binaryDecl->leftDecl->nodeType == AstNodeType_e::SuperExpr)
+			{
+				// super.metodo() chama diretamente a implementacao da classe base.
+				const U32 classIndex = mScopeStack.back().classIndex;
+				const U32 functionIndex = classIndex != invalidIndex
+					? mModule->findMethod(mModule->getClass(classIndex)->baseClassIndex, methodName)
+					: invalidIndex;
+
+				if (functionIndex == invalidIndex || !mFunction->function->isMethod)
+				{
+					throw exceptions::custom_exception(
+						"Method '%s' not found in base class",
+						binaryDecl->line,
+						binaryDecl->column,
+						methodName.c_str()
+					);
+				}
+				generateMethodCall(functionIndex, 0, argumentsDecl, base);
+			}
+			else
+			{
+				const U32 objectReg = allocateRegister();
+				generateExprTo(binaryDecl->leftDecl.get(), objectReg);
+
+				U32 nullJump = invalidIndex;
+				if (binaryDecl->op == TokenType_e::SafeDot)
+				{
+					nullJump = emitJump(OpCode_e::JumpIfNull, objectReg);
+				}
+
+				// O metodo e resolvido pelo nome em tempo de execucao.
+				emitABC(OpCode_e::GetMethod, base, objectReg, insertNameConstant(methodName));
+				emitABC(OpCode_e::Call, base, generateArguments(argumentsDecl, objectReg + 1) + 1, 0);
+
+				if (nullJump != invalidIndex)
+				{
+					const U32 endJump = emitJump(OpCode_e::Jump, 0);
+					patchJump(nullJump);
+					emitABC(OpCode_e::LoadNull, base, 0, 0);
+					patchJump(endJump);
+				}
+			}
+		}
+		else
+		{
+			String path;
+			Bool startFromRoot = false;
+
+			Symbol_s symbol { SymbolType_e::Unknown, invalidIndex, 0 };
+			if (buildScopedPath(lhsDecl, path, startFromRoot))
+			{
+				symbol = resolveSymbol(path, startFromRoot);
+			}
+
+			switch (symbol.type)
+			{
+			case SymbolType_e::Function:
+				// Chamada direta de uma funcao conhecida.
+				emitABx(OpCode_e::LoadFunction, base, symbol.index);
+				emitABC(OpCode_e::Call, base, generateArguments(argumentsDecl, base + 1), 0);
+				break;
+			case SymbolType_e::Method:
+				{
+					// Metodo da propria classe chamado sem 'this', resolvido pelo nome
+					// para respeitar as sobrescritas.
+					if (!mFunction->function->isMethod)
+					{
+						throw exceptions::custom_exception(
+							"Method '%s' called without an object",
+							lhsDecl->line,
+							lhsDecl->column,
+							path.c_str()
+						);
+					}
+
+					const U32 objectReg = allocateRegister();
+					emitABC(OpCode_e::GetMethod, base, 0, insertNameConstant(mModule->getFunction(symbol.index)->name.substr(mModule->getFunction(symbol.index)->name.rfind("::") + 2)));
+					emitABC(OpCode_e::Call, base, generateArguments(argumentsDecl, objectReg + 1) + 1, 0);
+				}
+				break;
+			default:
+				// Valor chamavel em tempo de execucao.
+				generateExprTo(lhsDecl, base);
+				emitABC(OpCode_e::Call, base, generateArguments(argumentsDecl, base + 1), 0);
+				break;
+			}
+		}
+
+		if (target != base)
+		{
+			emitABC(OpCode_e::Move, target, base, 0);
+		}
+		releaseRegisters(mark);
+	}
+
+	void
+	CodeGenerator::generateNew(ast::expr::ExpressionNewDecl* const newDecl, U32 target)
+	{
+		if (newDecl->objTypeDecl->nodeType != AstNodeType_e::NamedType)
+		{
+			throw exceptions::not_implemented_feature_exception(mFilename, "new for non class types");
+		}
+
+		const U32 classIndex = resolveClass(newDecl->objTypeDecl.get());
+		auto classInfo = mModule->getClass(classIndex);
+
+		const U32 mark = mFunction->freeRegister;
+		const U32 objectReg = allocateRegister();
+
+		emitABx(OpCode_e::NewObject, objectReg, classIndex);
+
+		// Inicializa os campos com as expressoes declaradas na classe.
+		if (classInfo->initFunctionIndex != invalidIndex)
+		{
+			const U32 base = allocateRegister();
+			generateMethodCall(classInfo->initFunctionIndex, objectReg, nullptr, base);
+			releaseRegisters(base);
+		}
+
+		// Seleciona o construtor pela quantidade de argumentos.
+		std::vector<ast::expr::ExpressionDecl*> argumentList;
+		collectArguments(newDecl->exprDecl.get(), argumentList);
+
+		U32 constructorIndex = invalidIndex;
+		for (auto functionIndex : classInfo->constructorList)
+		{
+			if (mModule->getFunction(functionIndex)->parameterCount == argumentList.size() + 1)
+			{
+				constructorIndex = functionIndex;
+				break;
+			}
+		}
+
+		if (constructorIndex != invalidIndex)
+		{
+			const U32 base = allocateRegister();
+			generateMethodCall(constructorIndex, objectReg, newDecl->exprDecl.get(), base);
+			releaseRegisters(base);
+		}
+		else if (argumentList.size() || classInfo->constructorList.size())
+		{
+			throw exceptions::custom_exception(
+				"No constructor of '%s' receives %d arguments",
+				newDecl->line,
+				newDecl->column,
+				classInfo->name.c_str(),
+				static_cast<U32>(argumentList.size())
+			);
+		}
+
+		// Bloco de inicializacao: new Foo { a: 1, b }
+		if (newDecl->objInitBlockDecl)
+		{
+			for (auto& itemDecl : newDecl->objInitBlockDecl->itemDeclList)
+			{
+				const U32 itemMark = mFunction->freeRegister;
+				const String identifier = toString(itemDecl->identifier);
+
+				U32 valueReg = 0;
+				if (itemDecl->exprDecl)
+				{
+					valueReg = generateExprAny(itemDecl->exprDecl.get());
+				}
+				else
+				{
+					valueReg = allocateRegister();
+					loadSymbol(resolveSymbol(identifier, false), identifier, valueReg, itemDecl.get());
+				}
+
+				emitABC(OpCode_e::SetField, objectReg, insertNameConstant(identifier), valueReg);
+				releaseRegisters(itemMark);
+			}
+		}
+
+		if (target != objectReg)
+		{
+			emitABC(OpCode_e::Move, target, objectReg, 0);
+		}
+		releaseRegisters(mark);
+	}
+
+	void
+	CodeGenerator::generateExprMatch(ast::expr::ExpressionMatchDecl* const matchDecl, U32 target)
+	{
+		const U32 subjectReg = generateExprAny(matchDecl->exprDecl.get());
+		const U32 mark = mFunction->freeRegister;
+
+		std::vector<ast::pattern::PatternDecl*> patternList;
+		for (auto& whenDecl : matchDecl->whenDeclList)
+		{
+			patternList.push_back(whenDecl->patternDecl.get());
+		}
+
+		match::JumpTable_s jumpTable;
+		const U32 switchPc = emitMatchSwitch(patternList, subjectReg, jumpTable);
+
+		std::vector<U32> endJumpList;
+		std::vector<U32> testPcList;
+		std::vector<U32> bodyPcList;
+
+		for (auto& whenDecl : matchDecl->whenDeclList)
+		{
+			const size_t localCount = mFunction->localList.size();
+
+			testPcList.push_back(currentPc());
+			const U32 nextJump = generatePatternTest(whenDecl->patternDecl.get(), subjectReg);
+			bodyPcList.push_back(currentPc());
+
+			generateExprTo(whenDecl->exprDecl.get(), target);
+			endJumpList.push_back(emitJump(OpCode_e::Jump, 0));
+
+			if (nextJump != invalidIndex)
+			{
+				patchJump(nextJump);
+			}
+
+			mFunction->localList.resize(localCount);
+			releaseRegisters(mark);
+		}
+
+		if (switchPc != invalidIndex)
+		{
+			patchMatchSwitch(switchPc, jumpTable, testPcList, bodyPcList, currentPc());
+		}
+
+		// Nenhum padrao correspondeu.
+		emitABC(OpCode_e::LoadNull, target, 0, 0);
+
+		for (auto jumpPc : endJumpList)
+		{
+			patchJump(jumpPc);
+		}
+	}
+
+	match::PatternInfo_s
+	CodeGenerator::resolve(ast::pattern::PatternDecl* const patternDecl)
+	{
+		match::PatternInfo_s info { match::PatternKind_e::Dynamic, vm::makeNull(), String(), nullptr, 0, 0 };
+
+		// Apenas os padroes literais sao gerados.
+		if (patternDecl->nodeType != AstNodeType_e::LiteralPattern)
+		{
+			return info;
+		}
+
+		auto literalPatternDecl = patternDecl->to<ast::pattern::LiteralPatternDecl>();
+		auto literalExpr = literalPatternDecl->literalExpr.get();
+
+		if (literalExpr == nullptr)
+		{
+			const String identifier = toString(literalPatternDecl->identifier);
+			const Symbol_s symbol = identifier == "_"
+				? Symbol_s { SymbolType_e::Unknown, invalidIndex, 0 }
+				: resolveSymbol(identifier, false);
+
+			switch (symbol.type)
+			{
+			case SymbolType_e::EnumItem:
+				info.kind = match::PatternKind_e::Constant;
+				info.value = vm::makeInteger(vm::ValueType_e::I32, symbol.value);
+				break;
+			case SymbolType_e::Global:
+				break;
+			default:
+				info.kind = match::PatternKind_e::Wildcard;
+				break;
+			}
+			return info;
+		}
+
+		if (match::getLiteralValue(literalExpr, info.value))
+		{
+			info.kind = match::PatternKind_e::Constant;
+			return info;
+		}
+
+		String path;
+		Bool startFromRoot = false;
+
+		if (literalExpr->nodeType == AstNodeType_e::BinaryExpr && buildScopedPath(literalExpr, path, startFromRoot))
+		{
+			const Symbol_s symbol = resolveSymbol(path, startFromRoot);
+
+			if (symbol.type == SymbolType_e::EnumItem)
+			{
+				info.kind = match::PatternKind_e::Constant;
+				info.value = vm::makeInteger(vm::ValueType_e::I32, symbol.value);
+			}
+		}
+		return info;
+	}
+
+	String
+	CodeGenerator::getItemName(const void* const, U32)
+	{
+		return "_";
+	}
+
+	U32
+	CodeGenerator::generatePatternTest(ast::pattern::PatternDecl* const patternDecl, U32 subjectReg)
+	{
+		if (patternDecl->nodeType != AstNodeType_e::LiteralPattern)
+		{
+			throw exceptions::not_implemented_feature_exception(mFilename, "tuple, structure and enumerable patterns");
+		}
+
+		auto literalPatternDecl = patternDecl->to<ast::pattern::LiteralPatternDecl>();
+
+		if (literalPatternDecl->literalExpr == nullptr)
+		{
+			const String identifier = toString(literalPatternDecl->identifier);
+
+			// '_' aceita qualquer valor.
+			if (identifier == "_")
+			{
+				return invalidIndex;
+			}
+
+			// Itens de enum e constantes globais sao comparados, os demais nomes
+			// capturam o valor em uma nova variavel.
+			const Symbol_s symbol = resolveSymbol(identifier, false);
+			if (symbol.type != SymbolType_e::EnumItem && symbol.type != SymbolType_e::Global)
+			{
+				const U32 reg = allocateRegister();
+				emitABC(OpCode_e::Move, reg, subjectReg, 0);
+				declareLocal(identifier, reg);
+				return invalidIndex;
+			}
+
+			const U32 valueReg = allocateRegister();
+			loadSymbol(symbol, identifier, valueReg, patternDecl);
+			emitABC(OpCode_e::Equal, valueReg, subjectReg, valueReg);
+
+			const U32 nextJump = emitJump(OpCode_e::JumpIfFalse, valueReg);
+			releaseRegisters(valueReg);
+			return nextJump;
+		}
+
+		const U32 valueReg = allocateRegister();
+		generateExprTo(literalPatternDecl->literalExpr.get(), valueReg);
+		emitABC(OpCode_e::Equal, valueReg, subjectReg, valueReg);
+
+		const U32 nextJump = emitJump(OpCode_e::JumpIfFalse, valueReg);
+		releaseRegisters(valueReg);
+		return nextJump;
+	}
+
+	U32
+	CodeGenerator::emitMatchSwitch(const std::vector<ast::pattern::PatternDecl*>& patternList, U32 subjectReg, match::JumpTable_s& jumpTable)
+	{
+		const U32 tableIndex = static_cast<U32>(mFunction->function->switchTableList.size());
+
+		if (patternList.size() < match::minJumpTableCaseCount || tableIndex > maxOperandBx)
+		{
+			return invalidIndex;
+		}
+
+		match::MatchCompiler matchCompiler(this);
+		auto decisionTree = matchCompiler.compile(patternList);
+
+		if (!decisionTree->buildJumpTable(jumpTable, match::minJumpTableCaseCount))
+		{
+			return invalidIndex;
+		}
+
+		mFunction->function->switchTableList.push_back(SwitchTable_s { {}, 0 });
+		return emitABx(OpCode_e::Switch, subjectReg, tableIndex);
+	}
+
+	void
+	CodeGenerator::patchMatchSwitch(U32 switchPc, const match::JumpTable_s& jumpTable, const std::vector<U32>& testPcList, const std::vector<U32>& bodyPcList, U32 noMatchPc)
+	{
+		SwitchTable_s& switchTable = mFunction->function->switchTableList[getOperandBx(mFunction->function->code[switchPc])];
+
+		// Os literais selecionados pela tabela saltam direto para o corpo.
+		auto getOffset = [&](const match::JumpTarget_s& jumpTarget) -> I32 {
+			const U32 targetPc = jumpTarget.armIndex == match::invalidArm
+				? noMatchPc
+				: (jumpTarget.matched ? bodyPcList[jumpTarget.armIndex] : testPcList[jumpTarget.armIndex]);
+
+			return static_cast<I32>(targetPc) - static_cast<I32>(switchPc + 1);
+		};
+
+		for (auto& target : jumpTable.targetMap)
+		{
+			switchTable.offsetMap.emplace(target.first, getOffset(target.second));
+		}
+		switchTable.defaultOffset = getOffset(jumpTable.defaultTarget);
+	}
+
+	U32
+	CodeGenerator::generateArguments(ast::expr::ExpressionDecl* const argumentsDecl, U32 firstReg)
+	{
+		std::vector<ast::expr::ExpressionDecl*> argumentList;
+		collectArguments(argumentsDecl, argumentList);
+
+		// A instrucao de chamada conta o 'this' dos metodos no operando B.
+		if (argumentList.size() >= maxOperandC)
+		{
+			throw exceptions::custom_exception(
+				"Call exceeds the limit of %d arguments",
+				argumentsDecl->line,
+				argumentsDecl->column,
+				maxOperandC - 1
+			);
+		}
+
+		// Os argumentos ocupam registradores consecutivos a partir de firstReg.
+		allocateRegisters(firstReg + static_cast<U32>(argumentList.size()) - mFunction->freeRegister);
+
+		for (U32 i = 0; i < argumentList.size(); i++)
+		{
+			generateExprTo(argumentList[i], firstReg + i);
+		}
+		return static_cast<U32>(argumentList.size());
+	}
+
+	void
+	CodeGenerator::generateMethodCall(U32 functionIndex, U32 objectReg, ast::expr::ExpressionDecl* const argumentsDecl, U32 base)
+	{
+		emitABx(OpCode_e::LoadFunction, base, functionIndex);
+
+		const U32 thisReg = allocateRegister();
+		emitABC(OpCode_e::Move, thisReg, objectReg, 0);
+
+		emitABC(OpCode_e::Call, base, generateArguments(argumentsDecl, thisReg + 1) + 1, 0);
+	}
+
+	LValue_s
+	CodeGenerator::prepareLValue(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::IdentifierExpr:
+			{
+				auto identifierDecl = exprDecl->to<ast::expr::ExpressionIdentifierDecl>();
+				const String identifier = toString(identifierDecl->identifier);
+				const Symbol_s symbol = resolveSymbol(identifier, identifierDecl->startFromRoot);
+
+				if (symbol.type == SymbolType_e::Local)
+				{
+					return LValue_s { LValueType_e::Local, symbol.index, 0 };
+				}
+				if (symbol.type == SymbolType_e::Field)
+				{
+					return LValue_s { LValueType_e::Field, 0, insertNameConstant(identifier) };
+				}
+				if (symbol.type == SymbolType_e::Global)
+				{
+					return LValue_s { LValueType_e::Global, symbol.index, 0 };
+				}
+			}
+			break;
+		case AstNodeType_e::BinaryExpr:
+			{
+				auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+				if (binaryDecl->op == TokenType_e::ScopeResolution)
+				{
+					String path;
+					Bool startFromRoot = false;
+
+					if (buildScopedPath(binaryDecl, path, startFromRoot))
+					{
+						const Symbol_s symbol = resolveSymbol(path, startFromRoot);
+						if (symbol.type == SymbolType_e::Global)
+						{
+							return LValue_s { LValueType_e::Global, symbol.index, 0 };
+						}
+					}
+				}
+				else if (binaryDecl->op == TokenType_e::Dot && binaryDecl->rightDecl->nodeType == AstNodeType_e::IdentifierExpr)
+				{
+					const U32 objectReg = generateExprAny(binaryDecl->leftDecl.get());
+					return LValue_s { LValueType_e::Field, objectReg, insertNameConstant(toString(binaryDecl->rightDecl->identifier)) };
+				}
+			}
+			break;
+		case AstNodeType_e::IndexExpr:
+			{
+				auto indexDecl = exprDecl->to<ast::expr::ExpressionIndexDecl>();
+
+				const U32 objectReg = generateExprAny(indexDecl->lhsDecl.get());
+				const U32 indexReg = generateExprAny(indexDecl->rhsDecl.get());
+
+				return LValue_s { LValueType_e::Index, objectReg, indexReg };
+			}
+		default:
+			break;
+		}
+
+		throw exceptions::custom_exception(
+			"Invalid assignment target",
+			exprDecl->line,
+			exprDecl->column
+		);
+	}
+
+	void
+	CodeGenerator::loadLValue(const LValue_s& lvalue, U32 target)
+	{
+		switch (lvalue.type)
+		{
+		case LValueType_e::Local:
+			if (target != lvalue.operandA)
+			{
+				emitABC(OpCode_e::Move, target, lvalue.operandA, 0);
+			}
+			break;
+		case LValueType_e::Global:
+			emitABx(OpCode_e::GetGlobal, target, lvalue.operandA);
+			break;
+		case LValueType_e::Field:
+			emitABC(OpCode_e::GetField, target, lvalue.operandA, lvalue.operandB);
+			break;
+		case LValueType_e::Index:
+			emitABC(OpCode_e::GetIndex, target, lvalue.operandA, lvalue.operandB);
+			break;
+		}
+	}
+
+	void
+	CodeGenerator::storeLValue(const LValue_s& lvalue, U32 valueReg)
+	{
+		switch (lvalue.type)
+		{
+		case LValueType_e::Local:
+			if (valueReg != lvalue.operandA)
+			{
+				emitABC(OpCode_e::Move, lvalue.operandA, valueReg, 0);
+			}
+			break;
+		case LValueType_e::Global:
+			emitABx(OpCode_e::SetGlobal, valueReg, lvalue.operandA);
+			break;
+		case LValueType_e::Field:
+			emitABC(OpCode_e::SetField, lvalue.operandA, lvalue.operandB, valueReg);
+			break;
+		case LValueType_e::Index:
+			emitABC(OpCode_e::SetIndex, lvalue.operandA, lvalue.operandB, valueReg);
+			break;
+		}
+	}
+
+	void
+	CodeGenerator::loadSymbol(const Symbol_s& symbol, const String& identifier, U32 target, ast::AstNode* const node)
+	{
+		switch (symbol.type)
+		{
+		case SymbolType_e::Local:
+			if (target != symbol.index)
+			{
+				emitABC(OpCode_e::Move, target, symbol.index, 0);
+			}
+			break;
+		case SymbolType_e::Field:
+			emitABC(OpCode_e::GetField, target, 0, insertNameConstant(identifier));
+			break;
+		case SymbolType_e::Global:
+			emitABx(OpCode_e::GetGlobal, target, symbol.index);
+			break;
+		case SymbolType_e::Function:
+			emitABx(OpCode_e::LoadFunction, target, symbol.index);
+			break;
+		case SymbolType_e::EnumItem:
+			if (symbol.value >= -maxOperandSBx && symbol.value <= maxOperandSBx)
+			{
+				emitABx(OpCode_e::LoadInt, target, static_cast<U32>(symbol.value + maxOperandSBx));
+			}
+			else
+			{
+				emitABx(OpCode_e::LoadConst, target, insertConstant(mModule->insertIntegerConstant(symbol.value, PrimitiveTypeID_e::I32)));
+			}
+			break;
+		case SymbolType_e::Method:
+			throw exceptions::custom_exception(
+				"Method '%s' can't be used as a value",
+				node->line,
+				node->column,
+				identifier.c_str()
+			);
+		case SymbolType_e::Class:
+			throw exceptions::custom_exception(
+				"Type '%s' can't be used as a value",
+				node->line,
+				node->column,
+				identifier.c_str()
+			);
+		default:
+			throw exceptions::custom_exception(
+				"Unresolved identifier '%s'",
+				node->line,
+				node->column,
+				identifier.c_str()
+			);
+		}
+	}
+
+	Symbol_s
+	CodeGenerator::resolveSymbol(const String& identifier, Bool startFromRoot)
+	{
+		if (startFromRoot)
+		{
+			return resolvePath(identifier);
+		}
+
+		const U32 reg = findLocal(identifier);
+		if (reg != invalidIndex)
+		{
+			return Symbol_s { SymbolType_e::Local, reg, 0 };
+		}
+
+		// Dentro de metodos os campos da classe sao acessados sem 'this'.
+		if (mFunction != nullptr && mFunction->function->isMethod)
+		{
+			for (U32 classIndex = mScopeStack.back().classIndex; classIndex != invalidIndex; classIndex = mModule->getClass(classIndex)->baseClassIndex)
+			{
+				auto& fieldList = mModule->getClass(classIndex)->fieldList;
+
+				if (std::find(fieldList.begin(), fieldList.end(), identifier) != fieldList.end())
+				{
+					return Symbol_s { SymbolType_e::Field, classIndex, 0 };
+				}
+			}
+		}
+
+		// Procura do escopo mais interno ate o escopo global.
+		for (auto it = mScopeStack.rbegin(); it != mScopeStack.rend(); it++)
+		{
+			const Symbol_s symbol = resolvePath(joinPath(it->path, identifier));
+			if (symbol.type != SymbolType_e::Unknown)
+			{
+				return symbol;
+			}
+		}
+
+		// Procura nos nomes incluidos, o primeiro segmento do caminho pode ser um alias.
+		const size_t separator = identifier.find("::");
+		auto it = mIncludeAliasMap.find(identifier.substr(0, separator));
+
+		if (it != mIncludeAliasMap.end())
+		{
+			const Symbol_s symbol = resolvePath(separator != String::npos ? it->second + identifier.substr(separator) : it->second);
+			if (symbol.type != SymbolType_e::Unknown)
+			{
+				return symbol;
+			}
+		}
+
+		for (auto& includePath : mIncludeWildcardList)
+		{
+			const Symbol_s symbol = resolvePath(joinPath(includePath, identifier));
+			if (symbol.type != SymbolType_e::Unknown)
+			{
+				return symbol;
+			}
+		}
+		return Symbol_s { SymbolType_e::Unknown, invalidIndex, 0 };
+	}
+
+	Symbol_s
+	CodeGenerator::resolvePath(const String& path)
+	{
+		U32 index = mModule->findFunction(path);
+		if (index != invalidIndex)
+		{
+			return Symbol_s { mModule->getFunction(index)->isMethod ? SymbolType_e::Method : SymbolType_e::Function, index, 0 };
+		}
+
+		index = mModule->findGlobal(path);
+		if (index != invalidIndex)
+		{
+			return Symbol_s { SymbolType_e::Global, index, 0 };
+		}
+
+		index = mModule->findClass(path);
+		if (index != invalidIndex)
+		{
+			return Symbol_s { SymbolType_e::Class, index, 0 };
+		}
+
+		auto it = mEnumValueMap.find(path);
+		if (it != mEnumValueMap.end())
+		{
+			return Symbol_s { SymbolType_e::EnumItem, invalidIndex, it->second };
+		}
+		return Symbol_s { SymbolType_e::Unknown, invalidIndex, 0 };
+	}
+
+	String
+	CodeGenerator::resolveTypeName(ast::TypeDecl* const typeDecl)
+	{
+		if (typeDecl->nodeType == AstNodeType_e::PrimitiveType)
+		{
+			return getPrimitiveTypeName(typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType);
+		}
+		return mModule->getClass(resolveClass(typeDecl))->name;
+	}
+
+	U32
+	CodeGenerator::resolveClass(ast::TypeDecl* const typeDecl)
+	{
+		if (typeDecl->nodeType == AstNodeType_e::NamedType)
+		{
+			auto namedTypeDecl = typeDecl->to<ast::TypeDeclNamed>();
+
+			String path;
+			for (auto scopedPathDecl = namedTypeDecl->scopePath.get(); scopedPathDecl; scopedPathDecl = scopedPathDecl->scopedChildPath.get())
+			{
+				path = joinPath(path, toString(scopedPathDecl->identifier));
+			}
+			path = joinPath(path, toString(namedTypeDecl->identifier));
+
+			const Symbol_s symbol = resolveSymbol(path, namedTypeDecl->startFromRoot);
+			if (symbol.type == SymbolType_e::Class)
+			{
+				return symbol.index;
+			}
+
+			throw exceptions::custom_exception(
+				"Unresolved class '%s'",
+				typeDecl->line,
+				typeDecl->column,
+				path.c_str()
+			);
+		}
+
+		throw exceptions::custom_exception(
+			"Expected a class type",
+			typeDecl->line,
+			typeDecl->column
+		);
+	}
+
+	Bool
+	CodeGenerator::buildScopedPath(ast::expr::ExpressionDecl* const exprDecl, String& path, Bool& startFromRoot)
+	{
+		if (exprDecl->nodeType == AstNodeType_e::IdentifierExpr)
+		{
+			path = toString(exprDecl->identifier);
+			startFromRoot = exprDecl->to<ast::expr::ExpressionIdentifierDecl>()->startFromRoot;
+			return true;
+		}
+
+		if (exprDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op == TokenType_e::ScopeResolution &&
+				binaryDecl->rightDecl->nodeType == AstNodeType_e::IdentifierExpr &&
+				buildScopedPath(binaryDecl->leftDecl.get(), path, startFromRoot))
+			{
+				path = joinPath(path, toString(binaryDecl->rightDecl->identifier));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void
+	CodeGenerator::collectArguments(ast::expr::ExpressionDecl* const exprDecl, std::vector<ast::expr::ExpressionDecl*>& argumentList)
+	{
+		if (exprDecl == nullptr)
+		{
+			return;
+		}
+
+		// Os argumentos chegam como uma cadeia de operadores ','.
+		if (exprDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op == TokenType_e::Comma)
+			{
+				collectArguments(binaryDecl->leftDecl.get(), argumentList);
+				collectArguments(binaryDecl->rightDecl.get(), argumentList);
+				return;
+			}
+		}
+		argumentList.push_back(exprDecl);
+	}
+
+	void
+	CodeGenerator::declareLocal(const String& identifier, U32 reg)
+	{
+		mFunction->localList.push_back(LocalVariable_s { identifier, reg });
+	}
+
+	U32
+	CodeGenerator::findLocal(const String& identifier)
+	{
+		if (mFunction == nullptr)
+		{
+			return invalidIndex;
+		}
+
+		// A declaracao mais recente esconde as anteriores.
+		auto& localList = mFunction->localList;
+		for (auto it = localList.rbegin(); it != localList.rend(); it++)
+		{
+			if (it->name == identifier)
+			{
+				return it->reg;
+			}
+		}
+		return invalidIndex;
+	}
+
+	U32
+	CodeGenerator::allocateRegister()
+	{
+		if (mFunction->freeRegister >= maxRegisterCount)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' exceeds the limit of %d registers",
+				mFunction->function->name.c_str(),
+				maxRegisterCount
+			);
+		}
+
+		const U32 reg = mFunction->freeRegister++;
+
+		if (mFunction->freeRegister > mFunction->function->frameSize)
+		{
+			mFunction->function->frameSize = mFunction->freeRegister;
+		}
+		return reg;
+	}
+
+	U32
+	CodeGenerator::allocateRegisters(U32 count)
+	{
+		const U32 firstReg = mFunction->freeRegister;
+
+		for (U32 i = 0; i < count; i++)
+		{
+			allocateRegister();
+		}
+		return firstReg;
+	}
+
+	void
+	CodeGenerator::releaseRegisters(U32 mark)
+	{
+		mFunction->freeRegister = mark;
+	}
+
+	U32
+	CodeGenerator::insertConstant(U32 moduleConstantIndex)
+	{
+		auto it = mFunction->constantMap.find(moduleConstantIndex);
+		if (it != mFunction->constantMap.end())
+		{
+			return it->second;
+		}
+
+		auto& constantList = mFunction->function->constantList;
+
+		if (constantList.size() > maxOperandBx)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' exceeds the limit of %d constants",
+				mFunction->function->name.c_str(),
+				maxOperandBx + 1
+			);
+		}
+
+		const U32 constantIndex = static_cast<U32>(constantList.size());
+		constantList.push_back(moduleConstantIndex);
+		mFunction->constantMap.emplace(moduleConstantIndex, constantIndex);
+		return constantIndex;
+	}
+
+	U32
+	CodeGenerator::insertNameConstant(const String& name)
+	{
+		const U32 constantIndex = insertConstant(mModule->insertStringConstant(name));
+
+		// Nomes sao referenciados pelos operandos B e C de 8 bits.
+		if (constantIndex > maxOperandC)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' references more than %d distinct names",
+				mFunction->function->name.c_str(),
+				maxOperandC + 1
+			);
+		}
+		return constantIndex;
+	}
+
+	U32
+	CodeGenerator::emitABC(OpCode_e op, U32 a, U32 b, U32 c)
+	{
+		mFunction->function->code.push_back(encodeABC(op, a, b, c));
+		mFunction->function->lineList.push_back(mFunction->line);
+		return currentPc() - 1;
+	}
+
+	U32
+	CodeGenerator::emitABx(OpCode_e op, U32 a, U32 bx)
+	{
+		if (bx > maxOperandBx)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' exceeds the operand limit of '%s'",
+				mFunction->function->name.c_str(),
+				getOpCodeName(op)
+			);
+		}
+
+		mFunction->function->code.push_back(encodeABx(op, a, bx));
+		mFunction->function->lineList.push_back(mFunction->line);
+		return currentPc() - 1;
+	}
+
+	U32
+	CodeGenerator::emitJump(OpCode_e op, U32 a)
+	{
+		// O destino e corrigido por patchJump quando for conhecido.
+		return emitABx(op, a, static_cast<U32>(maxOperandSBx));
+	}
+
+	void
+	CodeGenerator::patchJump(U32 jumpPc)
+	{
+		patchJumpTo(jumpPc, currentPc());
+	}
+
+	void
+	CodeGenerator::patchJumpTo(U32 jumpPc, U32 targetPc)
+	{
+		// O deslocamento e relativo a instrucao seguinte ao salto.
+		const I32 offset = static_cast<I32>(targetPc) - static_cast<I32>(jumpPc + 1);
+
+		if (offset > maxOperandSBx || offset < -maxOperandSBx)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' exceeds the jump limit",
+				mFunction->function->name.c_str()
+			);
+		}
+
+		auto& instruction = mFunction->function->code[jumpPc];
+		instruction = encodeAsBx(getOpCode(instruction), getOperandA(instruction), offset);
+	}
+
+	U32
+	CodeGenerator::currentPc()
+	{
+		return static_cast<U32>(mFunction->function->code.size());
+	}
+
+	void
+	CodeGenerator::setLine(ast::AstNode* const node)
+	{
+		mFunction->line = node->line;
+	}
+} }
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include <sstream>
+#include "ast/fl_ast.h"
+#include "diagnostics/fl_diagnostics.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace diagnostics {
+	/**
+	 * getMessageFormat
+	 */
+
+	// Os argumentos substituem os '%s' na ordem.
+	static const I8*
+	getMessageFormat(DiagnosticCode_e code)
+	{
+		switch (code)
+		{
+		case DiagnosticCode_e::UnexpectedToken:					return "Unexpected token '%s'";
+		case DiagnosticCode_e::UnexpectedEndOfFile:				return "Unexpected end of file";
+		case DiagnosticCode_e::InvalidCharacter:				return "Invalid character '%s'";
+		case DiagnosticCode_e::MalformedNumber:					return "Malformed number";
+		case DiagnosticCode_e::MalformedStringConstant:			return "Malformed string constant";
+		case DiagnosticCode_e::ExpectedToken:					return "Expected token '%s', received '%s'";
+		case DiagnosticCode_e::ExpectedIdentifier:				return "Expected an identifier, received '%s'";
+		case DiagnosticCode_e::ExpectedConstantBool:			return "Expected an boolean constant, received '%s'";
+		case DiagnosticCode_e::ExpectedConstantInteger:			return "Expected an integer constant, received '%s'";
+		case DiagnosticCode_e::ExpectedConstantFp32:			return "Expected a real 32-bits constant, received '%s'";
+		case DiagnosticCode_e::ExpectedConstantFp64:			return "Expected a real 64-bits constant, received '%s'";
+		case DiagnosticCode_e::ExpectedConstantChar:			return "Expected a character constant, received '%s'";
+		case DiagnosticCode_e::ExpectedConstantString:			return "Expected a string constant, received '%s'";
+		case DiagnosticCode_e::IntegerConstantOverflow:			return "Integer constant '%s' does not fit in 64 bits";
+		case DiagnosticCode_e::ClassExtendsNotClass:			return "The '%s' class extends must be a class element";
+		case DiagnosticCode_e::ClassImplementsNotInterface:		return "The '%s' class implements must be a interface element";
+		case DiagnosticCode_e::StaticFunctionAbstract:			return "Static function can't be abstract";
+		case DiagnosticCode_e::StaticFunctionOverride:			return "Static function can't be overrided";
+		case DiagnosticCode_e::StaticConstructor:				return "Constructors can't be static";
+		case DiagnosticCode_e::StaticDestructor:				return "Destructor can't be static";
+		case DiagnosticCode_e::DestructorAccessModifier:		return "Destructors are public, can't have any access modifier";
+		case DiagnosticCode_e::DuplicatedDestructor:			return "Classes must have only one destructor declaration";
+		case DiagnosticCode_e::AbstractFunctionModifier:		return "Abstract function '%s' can't have override or final modifiers";
+		case DiagnosticCode_e::TraitDefinitionType:				return "Trait definition type must be primitive or named";
+		case DiagnosticCode_e::SelfTypeOutsideTrait:			return "Self type only can be declared in traits";
+		case DiagnosticCode_e::VoidFunctionAssign:				return "Function '%s' with assign('=') can't be void type return";
+		case DiagnosticCode_e::VoidAnomFunctionAssign:			return "Anom function with assign('=') can't be void type return";
+		case DiagnosticCode_e::VoidVariable:					return "Variables or constant can't have void type";
+		case DiagnosticCode_e::VoidParameter:					return "Parameter can't have void type";
+		case DiagnosticCode_e::VoidNamedParameter:				return "Parameter '%s' can't have void type";
+		case DiagnosticCode_e::VoidGenericItem:					return "Generic item can't be 'void'";
+		case DiagnosticCode_e::VoidNullable:					return "'void' type can't be nullable";
+		case DiagnosticCode_e::UnexpectedType:					return "Unexpected type '%s'";
+		case DiagnosticCode_e::WhereIdentifierNotGeneric:		return "Where identifier must be like generic identifier: %s";
+		case DiagnosticCode_e::WhereTypeNullable:				return "Where types can't be nullable";
+		case DiagnosticCode_e::ExpectedParameterEnd:			return "Expected ',' or ')' token";
+		case DiagnosticCode_e::ExpectedFunctionTypeEnd:			return "Expected ')', '->' or ',' declaration";
+		case DiagnosticCode_e::InvalidJokerIdentifier:			return "Invalid 'joker' identifier declaration";
+		case DiagnosticCode_e::NotImplementedFeature:			return "This feature '%s' is not implemented";
+		case DiagnosticCode_e::IdentifierNotFound:				return "Identifier '%s' not found in scope";
+		case DiagnosticCode_e::AmbiguousSearchResult:			return "Ambiguous search result";
+		case DiagnosticCode_e::AmbiguousType:					return "Ambiguous search result '%s'";
+		case DiagnosticCode_e::InvalidType:						return "The '%s' could not be a valid type or could not be found in scope";
+		case DiagnosticCode_e::InvalidScope:					return "'%s' is not a valid scope";
+		case DiagnosticCode_e::DuplicatedIdentifier:			return "Duplicated identifier '%s'";
+		case DiagnosticCode_e::BaseClassNotClass:				return "The '%s' class must be extended by another class: '%s' is not a class";
+		case DiagnosticCode_e::CircularExtends:					return "The '%s' class has circular extends dependency";
+		case DiagnosticCode_e::MissingReference:				return "Failed '%s' to retrieve baseClass reference attribute";
+		case DiagnosticCode_e::InterfaceExpected:				return "The '%s' class must implement only interfaces: '%s' is not a interface";
+		case DiagnosticCode_e::AbstractFunctionInConcreteClass:	return "The class '%s' declare '%s' function as abstract, only abstract class can have abstract functions";
+		case DiagnosticCode_e::AbstractFunctionNotPublic:		return "The '%s' function, must be public";
+		case DiagnosticCode_e::InterfaceFunctionNotPublic:		return "The '%s' function in '%s' class must be public to satisfy '%s' interface";
+		case DiagnosticCode_e::AbstractFunctionNotImplemented:	return "The '%s' class must implement '%s' abstract function from '%s' class";
+		case DiagnosticCode_e::InterfaceFunctionNotImplemented:	return "The '%s' class must implement '%s' function from '%s' interface";
+		case DiagnosticCode_e::GenericArgumentCount:			return "Generic '%s' requires %s type arguments";
+		case DiagnosticCode_e::GenericWhereMismatch:			return "Type generic item doesn't match where clause";
+		case DiagnosticCode_e::TraitNotFound:					return "Trait '%s' not found in scope";
+		case DiagnosticCode_e::TraitSearchFailed:				return "Failed to resolve trait, invalid search result";
+		case DiagnosticCode_e::TraitNotDeclared:				return "Failed to implement '%s' trait, '%s' trait doesn't exists";
+		case DiagnosticCode_e::TraitFunctionNotImplemented:		return "Trait definition '%s' trait, must implement all functions: '%s' was not implemented";
+		case DiagnosticCode_e::DivisionByZero:					return "Division by zero in constant expression";
+		case DiagnosticCode_e::ProcessingError:					return "%s";
+		case DiagnosticCode_e::IntegerOverflow:					return "Integer overflow in constant expression";
+		case DiagnosticCode_e::UnreachableMatchArm:				return "Unreachable match arm, previous patterns cover all its values";
+		case DiagnosticCode_e::NonExhaustiveMatch:				return "Non-exhaustive match, missing: %s";
+		}
+		return "Unknown error";
+	}
+
+	// A mensagem do argumento ja contem o arquivo e a posicao.
+	static Bool
+	isVerbatim(DiagnosticCode_e code)
+	{
+		return code == DiagnosticCode_e::ProcessingError;
+	}
+
+	/**
+	 * DiagnosticEngine
+	 */
+
+	DiagnosticEngine::DiagnosticEngine()
+		: mErrorCount(0)
+		, mErrorLimit(0)
+	{}
+
+	DiagnosticEngine::~DiagnosticEngine()
+	{}
+
+	void
+	DiagnosticEngine::report(const Diagnostic_s& diagnostic)
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		if (diagnostic.severity == DiagnosticSeverity_e::Error)
+		{
+			if (mErrorLimit != 0 && mErrorCount >= mErrorLimit)
+			{
+				mErrorCount++;
+				return;
+			}
+			mErrorCount++;
+		}
+		mDiagnosticList.push_back(diagnostic);
+	}
+
+	void
+	DiagnosticEngine::report(DiagnosticCode_e code, const TString& sourceFile, const ast::AstNode* const node, U32 line, U32 column, std::initializer_list<TString> argList)
+	{
+		report(makeDiagnostic(code, sourceFile, node, line, column, argList));
+	}
+
+	void
+	DiagnosticEngine::report(DiagnosticCode_e code, const TString& sourceFile, const ast::AstNode* const node, std::initializer_list<TString> argList)
+	{
+		report(code, sourceFile, node, node->line, node->column, argList);
+	}
+
+	void
+	DiagnosticEngine::setErrorLimit(U32 errorLimit)
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		mErrorLimit = errorLimit;
+	}
+
+	Bool
+	DiagnosticEngine::isErrorLimitReached()
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		return mErrorLimit != 0 && mErrorCount >= mErrorLimit;
+	}
+
+	Bool
+	DiagnosticEngine::hasErrors()
+	{
+		return getErrorCount() != 0;
+	}
+
+	U32
+	DiagnosticEngine::getErrorCount()
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		return mErrorCount;
+	}
+
+	std::vector<Diagnostic_s>
+	DiagnosticEngine::getDiagnosticList()
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		return mDiagnosticList;
+	}
+
+	void
+	DiagnosticEngine::clear()
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		mDiagnosticList.clear();
+		mErrorCount = 0;
+	}
+
+	String
+	DiagnosticEngine::formatAll()
+	{
+		std::stringstream stream;
+		for (auto& diagnostic : getDiagnosticList())
+		{
+			stream << format(diagnostic) << "\n";
+		}
+		return stream.str();
+	}
+
+	Diagnostic_s
+	DiagnosticEngine::makeDiagnostic(DiagnosticCode_e code, const TString& sourceFile, const ast::AstNode* const node, U32 line, U32 column, std::initializer_list<TString> argList)
+	{
+		if (argList.size() > maxDiagnosticArgs)
+		{
+			throw exceptions::custom_exception("Too many diagnostic arguments: %d", static_cast<U32>(argList.size()));
+		}
+
+		Diagnostic_s diagnostic;
+		diagnostic.code = code;
+		diagnostic.severity = getSeverity(code);
+		diagnostic.argCount = static_cast<U8>(argList.size());
+		diagnostic.line = line;
+		diagnostic.column = column;
+		diagnostic.sourceFile = sourceFile;
+		diagnostic.node = node;
+		std::copy(argList.begin(), argList.end(), diagnostic.argList);
+		return diagnostic;
+	}
+
+	DiagnosticSeverity_e
+	DiagnosticEngine::getSeverity(DiagnosticCode_e code)
+	{
+		switch (code)
+		{
+		case DiagnosticCode_e::IntegerOverflow:
+		case DiagnosticCode_e::UnreachableMatchArm:
+		case DiagnosticCode_e::NonExhaustiveMatch:
+			return DiagnosticSeverity_e::Warning;
+		default:
+			return DiagnosticSeverity_e::Error;
+		}
+	}
+
+	String
+	DiagnosticEngine::formatMessage(const Diagnostic_s& diagnostic)
+	{
+		String message;
+		U32 argIndex = 0;
+
+		for (const I8* it = getMessageFormat(diagnostic.code); *it != '\0'; it++)
+		{
+			if (it[0] == '%' && it[1] == 's')
+			{
+				if (argIndex < diagnostic.argCount && diagnostic.argList[argIndex].str() != nullptr)
+				{
+					message.append(diagnostic.argList[argIndex].str());
+				}
+				argIndex++;
+				it++;
+				continue;
+			}
+			message.push_back(*it);
+		}
+		return message;
+	}
+
+	String
+	DiagnosticEngine::format(const Diagnostic_s& diagnostic)
+	{
+		if (isVerbatim(diagnostic.code))
+		{
+			return formatMessage(diagnostic);
+		}
+
+		std::stringstream stream;
+		stream << (diagnostic.sourceFile.str() != nullptr ? diagnostic.sourceFile.str() : "")
+			<< (diagnostic.severity == DiagnosticSeverity_e::Error ? " error: " : " warning: ")
+			<< formatMessage(diagnostic);
+
+		if (diagnostic.line != 0)
+		{
+			stream << " at: line " << diagnostic.line << ", column " << diagnostic.column;
+		}
+		return stream.str();
+	}
+} }
+
+namespace fluffy { namespace exceptions {
+	/**
+	 * diagnostic_exception
+	 */
+
+	diagnostic_exception::diagnostic_exception(const diagnostics::Diagnostic_s& diagnostic)
+		: m_diagnostic(diagnostic)
+	{}
+
+	diagnostic_exception::~diagnostic_exception()
+	{}
+
+	const char* diagnostic_exception::what() const noexcept
+	{
+		if (m_message.empty())
+		{
+			m_message = diagnostics::DiagnosticEngine::format(m_diagnostic);
+		}
+		return m_message.c_str();
+	}
+
+	const diagnostics::Diagnostic_s&
+	diagnostic_exception::getDiagnostic() const
+	{
+		return m_diagnostic;
+	}
+} }
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include "fl_buffer.h"
@@ -41,6 +43,7 @@ namespace fluffy {
 			m_memory[len] = 0;
 		}
 		memcpy(m_memory, sourcePtr, len);
+		m_length = len;
 	}
 
 	void DirectBuffer::loadFromFile(const I8* fileName)
@@ -62,6 +65,7 @@ namespace fluffy {
 
 		// Copia o conteudo do arquivo para a string.
 		fileStream.read(m_memory, len);
+		m_length = static_cast<U32>(len);
 
 		fileStream.close();
 	}
@@ -86,6 +90,26 @@ namespace fluffy {
 		m_cursor = position;
 	}
 
+	const I8* DirectBuffer::getData()
+	{
+		return m_memory;
+	}
+
+	U32 DirectBuffer::getLength()
+	{
+		return m_length;
+	}
+
+	U32 DirectBuffer::read(U32 position, I8* destination, U32 length)
+	{
+		if (position >= m_length) {
+			return 0;
+		}
+		const U32 count = std::min(length, m_length - position);
+		memcpy(destination, m_memory + position, count);
+		return count;
+	}
+
 	/**
 	 * LazyBuffer
 	 */
@@ -121,12 +145,9 @@ namespace fluffy {
 
 	void LazyBuffer::load(const I8* sourcePtr, const U32 len)
 	{
-		m_stream = new std::stringstream(sourcePtr);
-
-		// Calcula o tamanho total do codigo.
-		m_stream->seekg(0, std::fstream::end);
-		m_fileSize = static_cast<U32>(m_stream->tellg());
-		m_stream->seekg(0, std::fstream::beg);
+		// Copia apenas os 'len' bytes do codigo, que nao precisa terminar em nulo.
+		m_stream = new std::stringstream(String(sourcePtr, len));
+		m_fileSize = len;
 
 		// Preenche o buffer inicial
 		m_stream->read(m_memory, m_length);
@@ -276,4 +297,130 @@ namespace fluffy {
 			}
 		}
 	}
+
+	const I8* LazyBuffer::getData()
+	{
+		// Apenas uma janela do codigo fica em memoria.
+		return nullptr;
+	}
+
+	U32 LazyBuffer::getLength()
+	{
+		return m_fileSize;
+	}
+
+	U32 LazyBuffer::read(U32 position, I8* destination, U32 length)
+	{
+		if (position >= m_fileSize) {
+			return 0;
+		}
+		const U32 count = std::min(length, m_fileSize - position);
+
+		// O arquivo inteiro ja esta no buffer.
+		if (m_length > m_fileSize) {
+			memcpy(destination, m_memory + position, count);
+			return count;
+		}
+
+		// Le o trecho e restaura a posicao e o estado do stream, a janela do
+		// buffer continua valida.
+		const std::ios_base::iostate state = m_stream->rdstate();
+		m_stream->clear();
+		const std::streampos streamPosition = m_stream->tellg();
+
+		m_stream->seekg(position, std::ios_base::beg);
+		m_stream->read(destination, count);
+		const U32 readedBytes = static_cast<U32>(m_stream->gcount());
+
+		m_stream->clear();
+		m_stream->seekg(streamPosition, std::ios_base::beg);
+		m_stream->setstate(state);
+
+		return readedBytes;
+	}
+
+	/**
+	 * SharedBuffer
+	 */
+
+	SharedBuffer::SharedBuffer()
+		: m_memory(nullptr)
+		, m_cursor(0)
+		, m_length(0)
+	{}
+
+	SharedBuffer::~SharedBuffer()
+	{
+		m_memory = nullptr;
+		m_cursor = 0;
+		m_length = 0;
+	}
+
+	void SharedBuffer::load(const I8* sourcePtr, const U32 len)
+	{
+		// O codigo nao e copiado, varios buffers podem ler a mesma memoria
+		// desde que ela se mantenha valida e inalterada enquanto sao usados.
+		m_memory = sourcePtr;
+		m_cursor = 0;
+		m_length = len;
+	}
+
+	void SharedBuffer::loadFromFile(const I8* fileName)
+	{
+		std::ifstream fileStream(fileName, std::ifstream::binary);
+		if (!fileStream.is_open()) {
+			throw exceptions::file_not_found_exception(fileName);
+		}
+
+		// Copia o conteudo do arquivo para a string.
+		std::stringstream stringStream;
+		stringStream << fileStream.rdbuf();
+		fileStream.close();
+
+		m_fileContent = stringStream.str();
+		load(m_fileContent.c_str(), static_cast<U32>(m_fileContent.size()));
+	}
+
+	U32 SharedBuffer::getPosition()
+	{
+		return m_cursor;
+	}
+
+	const I8 SharedBuffer::readByte(U8 offset)
+	{
+		if (m_cursor + offset >= m_length) {
+			return 0;
+		}
+		return m_memory[m_cursor + offset];
+	}
+
+	void SharedBuffer::nextByte()
+	{
+		m_cursor++;
+	}
+
+	void SharedBuffer::reset(U32 position)
+	{
+		m_cursor = position;
+	}
+
+	const I8* SharedBuffer::getData()
+	{
+		return m_memory;
+	}
+
+	U32 SharedBuffer::getLength()
+	{
+		return m_length;
+	}
+
+	U32 SharedBuffer::read(U32 position, I8* destination, U32 length)
+	{
+		if (position >= m_length) {
+			return 0;
+		}
+		const U32 count = std::min(length, m_length - position);
+		memcpy(destination, m_memory + position, count);
+		return count;
+	}
 }
\ No newline at end of file
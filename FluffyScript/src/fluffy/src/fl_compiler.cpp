@@ -1,13 +1,22 @@
 #include <iostream>
 #include <cstdlib>
-#include "ast\fl_ast_decl.h"
-#include "parser\fl_parser.h"
-#include "job\fl_job_pool.h"
-#include "job\fl_job.h"
-#include "utils\fl_ast_utils.h"
-#include "utils\fl_include_utils.h"
-#include "scope\fl_scope_manager.h"
-#include "validate\fl_validate_duplicated_nodes.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <functional>
+#include "ast/fl_ast_decl.h"
+#include "parser/fl_parser.h"
+#include "job/fl_job_pool.h"
+#include "job/fl_job.h"
+#include "utils/fl_ast_utils.h"
+#include "utils/fl_include_utils.h"
+#include "utils/fl_summary_utils.h"
+#include "scope/fl_scope_manager.h"
+#include "validate/fl_validate_duplicated_nodes.h"
+#include "codegen/fl_code_generator.h"
+#include "profiler/fl_profiler.h"
+#include "diagnostics/fl_diagnostics.h"
 #include "fl_buffer.h"
 #include "fl_exceptions.h"
 #include "fl_compiler.h"
@@ -15,6 +24,147 @@ namespace fluffy {
 	// Tamanho padrao do buffer: 16KB.
 	static constexpr const U32 bufferSize = 16384;
 
+	// Estados da ordenacao dos arquivos do build em lote.
+	static constexpr const U8 fileUnvisited = 0;
+	static constexpr const U8 fileVisiting = 1;
+	static constexpr const U8 fileVisited = 2;
+
+	static U64
+	getElapsedTime(const std::chrono::steady_clock::time_point& start)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/**
+	 * BatchFile_s
+	 */
+
+	struct BatchFile_s
+	{
+		BuildResult_s						result;
+
+		// Code unit analisado e ainda nao processado.
+		std::unique_ptr<ast::CodeUnit>		codeUnit;
+
+		// Code unit processado, pertence a arvore de aplicacao do compilador.
+		ast::CodeUnit*						registeredCodeUnit;
+
+		std::vector<BatchFile_s*>			includeList;
+
+		// Estado do arquivo em disco na ultima analise.
+		Bool								hasStamp;
+		I64									modifiedTime;
+		U64									fileSize;
+		U64									contentHash;
+
+		// Chamada de buildBatch que alcancou o arquivo por ultimo.
+		U32									generation;
+		Bool								changed;
+		Bool								dirty;
+		U8									visitState;
+	};
+
+	// Mantem apenas o primeiro erro do arquivo.
+	static void
+	setBatchError(BatchFile_s* const batchFile, const String& error)
+	{
+		if (batchFile->result.success)
+		{
+			batchFile->result.success = false;
+			batchFile->result.error = error;
+		}
+	}
+
+	// FNV-1a de 64 bits do conteudo do arquivo.
+	static U64
+	hashFile(const String& sourceFile)
+	{
+		std::ifstream fileStream(sourceFile, std::ifstream::binary);
+		I8 buffer[bufferSize];
+		U64 hash = 14695981039346656037ULL;
+
+		while (fileStream.read(buffer, bufferSize) || fileStream.gcount() > 0)
+		{
+			const std::streamsize readCount = fileStream.gcount();
+			for (std::streamsize i = 0; i < readCount; i++)
+			{
+				hash = (hash ^ static_cast<U8>(buffer[i])) * 1099511628211ULL;
+			}
+		}
+		return hash;
+	}
+
+	// Atualiza o estado do arquivo em disco, retorna se o conteudo mudou desde a
+	// ultima analise. Arquivos inacessiveis sao sempre analisados novamente para
+	// que o erro seja reportado.
+	static Bool
+	updateFileStamp(BatchFile_s* const batchFile)
+	{
+		const String& sourceFile = batchFile->result.sourceFile;
+		std::error_code error;
+
+		const auto modifiedTime = std::filesystem::last_write_time(sourceFile, error);
+		const U64 fileSize = error ? 0 : std::filesystem::file_size(sourceFile, error);
+
+		if (error)
+		{
+			batchFile->hasStamp = false;
+			return true;
+		}
+
+		const I64 modifiedTicks = modifiedTime.time_since_epoch().count();
+		if (batchFile->hasStamp && batchFile->modifiedTime == modifiedTicks && batchFile->fileSize == fileSize)
+		{
+			return false;
+		}
+
+		// O horario pode mudar sem que o conteudo mude, nesse caso o code unit e mantido.
+		const U64 contentHash = hashFile(sourceFile);
+		const Bool changed = !batchFile->hasStamp || batchFile->contentHash != contentHash;
+
+		batchFile->hasStamp = true;
+		batchFile->modifiedTime = modifiedTicks;
+		batchFile->fileSize = fileSize;
+		batchFile->contentHash = contentHash;
+		return changed;
+	}
+
+	/**
+	 * JobParseBatchFile
+	 */
+
+	// Analisa um arquivo do lote medindo o tempo, o resultado fica no proprio arquivo.
+	class JobParseBatchFile final : public jobs::Job
+	{
+	public:
+		JobParseBatchFile(BatchFile_s* const batchFile, Bool skipFunctionBody)
+			: mBatchFile(batchFile)
+			, mParseJob(batchFile->result.sourceFile.c_str(), skipFunctionBody)
+		{}
+
+		virtual void
+		doJob() override
+		{
+			const auto start = std::chrono::steady_clock::now();
+			mParseJob.doJob();
+			mBatchFile->result.parseTime = getElapsedTime(start);
+
+			if (mParseJob.getJobStatus() == jobs::JobStatus_e::Error)
+			{
+				setBatchError(mBatchFile, mParseJob.getError());
+				return;
+			}
+			mBatchFile->codeUnit = mParseJob.getCodeUnit();
+		}
+
+	private:
+		BatchFile_s*
+		mBatchFile;
+
+		jobs::JobParseFromSourceFile
+		mParseJob;
+	};
+
 	/**
 	 * Compiler
 	 */
@@ -24,6 +174,11 @@ namespace fluffy {
 		, mJobCount(4)
 		, mInitialized(false)
 		, mBuildBlock(false)
+		, mSkipFunctionBody(false)
+		, mParallelFunctionBody(false)
+		, mProfiler(nullptr)
+		, mDiagnosticEngine(nullptr)
+		, mBatchGeneration(0)
 	{}
 
 	Compiler::~Compiler()
@@ -45,38 +200,247 @@ namespace fluffy {
 	void
 	Compiler::build(String sourceFile)
 	{
+		const profiler::ProfilerGuard profilerGuard(mProfiler);
+
 		if (!mBuildBlock)
 		{
 			buildInternal(mBasePath + sourceFile.c_str());
 		}
-		for (auto codeUnit : mExecutionTree)
-		{
-			for (auto& nodeProcessor : mNodeProcessorList)
-			{
-				mScopeManager->processCodeUnit(codeUnit, nodeProcessor.get());
-			}
-		}
+		runNodeProcessors();
 	}
 
 	void
 	Compiler::build()
 	{
-		for (auto codeUnit : mExecutionTree)
+		const profiler::ProfilerGuard profilerGuard(mProfiler);
+
+		runNodeProcessors();
+	}
+
+	std::vector<BuildResult_s>
+	Compiler::buildBatch(const std::vector<String>& sourceFileList)
+	{
+		const profiler::ProfilerGuard profilerGuard(mProfiler);
+
+		// Arquivos alcancados nesta chamada, na ordem em que foram descobertos.
+		std::vector<BatchFile_s*> fileList;
+		mBatchGeneration++;
+
+		auto insertFile = [this, &fileList](const String& sourceFile, Bool isEntry) {
+			BatchFile_s* const batchFile = getBatchFile(sourceFile);
+			if (batchFile->generation != mBatchGeneration)
+			{
+				batchFile->generation = mBatchGeneration;
+				batchFile->result.isEntry = false;
+				batchFile->visitState = fileUnvisited;
+				fileList.push_back(batchFile);
+			}
+			batchFile->result.isEntry |= isEntry;
+			return batchFile;
+		};
+
+		for (auto& sourceFile : sourceFileList)
 		{
-			for (auto& nodeProcessor : mNodeProcessorList)
+			insertFile(mBasePath + sourceFile, true);
+		}
+
+		// Cada rodada analisa os arquivos novos ou alterados descobertos nos
+		// includes da rodada anterior, os demais mantem os includes ja conhecidos.
+		size_t discoveredCount = 0;
+		while (discoveredCount < fileList.size())
+		{
+			const size_t roundEnd = fileList.size();
+
+			std::vector<BatchFile_s*> parseList;
+			for (size_t i = discoveredCount; i < roundEnd; i++)
+			{
+				fileList[i]->changed = updateFileStamp(fileList[i]);
+				if (fileList[i]->changed)
+				{
+					parseList.push_back(fileList[i]);
+				}
+			}
+			parseBatchFiles(parseList);
+
+			for (size_t i = discoveredCount; i < roundEnd; i++)
+			{
+				for (auto includedFile : fileList[i]->includeList)
+				{
+					insertFile(includedFile->result.sourceFile, false);
+				}
+			}
+			discoveredCount = roundEnd;
+		}
+
+		// Um arquivo sem mudancas precisa ser processado novamente se algum
+		// include mudou, pois o code unit processado aponta para os nos do include.
+		for (auto batchFile : fileList)
+		{
+			batchFile->dirty = batchFile->changed;
+		}
+
+		for (Bool updated = true; updated; )
+		{
+			updated = false;
+			for (auto batchFile : fileList)
+			{
+				for (auto includedFile : batchFile->includeList)
+				{
+					if (!batchFile->dirty && includedFile->dirty)
+					{
+						batchFile->dirty = true;
+						updated = true;
+					}
+				}
+			}
+		}
+
+		std::vector<BatchFile_s*> parseList;
+		for (auto batchFile : fileList)
+		{
+			if (batchFile->dirty && !batchFile->changed)
+			{
+				parseList.push_back(batchFile);
+			}
+		}
+		parseBatchFiles(parseList);
+
+		// Grafo reverso dos includes de todos os arquivos em cache, inclusive os que
+		// nao foram alcancados nesta chamada, pois os code units processados deles
+		// tambem apontam para os nos dos includes.
+		std::unordered_map<BatchFile_s*, std::vector<BatchFile_s*>> dependentMap;
+		for (auto& it : mBatchFileMap)
+		{
+			for (auto includedFile : it.second->includeList)
+			{
+				dependentMap[includedFile].push_back(it.second.get());
+			}
+		}
+
+		// Descarta os code units de todos os arquivos que incluem o arquivo, direta ou
+		// indiretamente, antes que o code unit dele seja liberado. Os arquivos fora
+		// desta chamada sao analisados novamente quando forem alcancados.
+		auto invalidateDependentFiles = [&](BatchFile_s* const batchFile) {
+			std::vector<BatchFile_s*> pendingList = { batchFile };
+			while (!pendingList.empty())
+			{
+				BatchFile_s* const includedFile = pendingList.back();
+				pendingList.pop_back();
+
+				auto it = dependentMap.find(includedFile);
+				if (it == dependentMap.end())
+				{
+					continue;
+				}
+
+				for (auto dependentFile : it->second)
+				{
+					if (dependentFile->registeredCodeUnit == nullptr)
+					{
+						continue;
+					}
+					unregisterCodeUnit(dependentFile->registeredCodeUnit);
+					dependentFile->registeredCodeUnit = nullptr;
+
+					if (dependentFile->generation != mBatchGeneration)
+					{
+						dependentFile->hasStamp = false;
+					}
+					pendingList.push_back(dependentFile);
+				}
+			}
+		};
+
+		// Os arquivos sao processados apos os seus includes, na mesma ordem da arvore
+		// de execucao. Um erro em um include e propagado para os arquivos que o incluem.
+		const std::vector<String> processorNameList = getProcessorNameList();
+
+		std::function<void(BatchFile_s* const)> visitFile = [&](BatchFile_s* const batchFile) {
+			if (batchFile->visitState != fileUnvisited)
+			{
+				return;
+			}
+			batchFile->visitState = fileVisiting;
+
+			for (auto includedFile : batchFile->includeList)
+			{
+				if (includedFile->visitState == fileVisiting)
+				{
+					setBatchError(batchFile, batchFile->result.sourceFile + " error: Circular include of '" + includedFile->result.sourceFile + "'");
+					continue;
+				}
+
+				visitFile(includedFile);
+				if (!includedFile->result.success)
+				{
+					setBatchError(batchFile, batchFile->result.sourceFile + " error: Included file '" + includedFile->result.sourceFile + "' has errors");
+				}
+			}
+			batchFile->visitState = fileVisited;
+
+			if (!batchFile->dirty)
+			{
+				batchFile->result.cached = true;
+				batchFile->result.parseTime = 0;
+				batchFile->result.processTime = 0;
+				return;
+			}
+
+			// Os arquivos que incluem este deixam de apontar para o code unit anterior.
+			invalidateDependentFiles(batchFile);
+			if (batchFile->registeredCodeUnit != nullptr)
+			{
+				unregisterCodeUnit(batchFile->registeredCodeUnit);
+				batchFile->registeredCodeUnit = nullptr;
+			}
+
+			if (!batchFile->result.success)
+			{
+				batchFile->codeUnit.reset();
+				return;
+			}
+
+			ast::CodeUnit* const codeUnit = batchFile->codeUnit.get();
+
+			mExecutionTree.emplace_back(codeUnit);
+			mScopeManager->insertCodeUnit(codeUnit);
+			mApplicationTree.emplace(codeUnit->identifier, std::move(batchFile->codeUnit));
+			batchFile->registeredCodeUnit = codeUnit;
+
+			const auto start = std::chrono::steady_clock::now();
+			try
+			{
+				processCodeUnit(codeUnit, processorNameList);
+			}
+			catch (std::exception& e)
 			{
-				mScopeManager->processCodeUnit(codeUnit, nodeProcessor.get());
+				setBatchError(batchFile, e.what());
 			}
+			batchFile->result.processTime = getElapsedTime(start);
+		};
+
+		for (auto batchFile : fileList)
+		{
+			visitFile(batchFile);
+		}
+
+		std::vector<BuildResult_s> resultList;
+		for (auto batchFile : fileList)
+		{
+			resultList.push_back(batchFile->result);
 		}
+		return resultList;
 	}
 
 	void
 	Compiler::addBlockToBuild(String sourceFile, String sourceCode)
 	{
+		const profiler::ProfilerGuard profilerGuard(mProfiler);
+
 		std::unique_ptr<jobs::JobParseFromSourceBlock> job;
 		{
 			// Cria tarefa e enfileira na fila.
-			job = std::make_unique<jobs::JobParseFromSourceBlock>(sourceFile.c_str(), sourceCode.c_str());
+			job = std::make_unique<jobs::JobParseFromSourceBlock>(sourceFile.c_str(), sourceCode.c_str(), mSkipFunctionBody, mParallelFunctionBody ? mJobCount : 0, mDiagnosticEngine);
 			job->doJob();
 
 			// Valida os code units por ambiguidades.
@@ -84,6 +448,10 @@ namespace fluffy {
 			{
 				if (job->getJobStatus() == jobs::JobStatus_e::Error)
 				{
+					if (reportJobError(sourceFile, job->getError()))
+					{
+						return;
+					}
 					throw exceptions::custom_exception(job->getError());
 				}
 			}
@@ -91,6 +459,7 @@ namespace fluffy {
 
 		// Junta todos as AST das tarefas.
 		ast::CodeUnit* const codeUnit = job->getCodeUnitPointer();
+		onCodeUnitParsed(codeUnit);
 
 		// Insere o code unit na arvore de execucao, essa arvore contem a ordem em que os
 		// arquivos foram processados, sendo o primeiro o include mais distante do arquivo fonte de inicio
@@ -117,6 +486,43 @@ namespace fluffy {
 		mJobCount = jobCount;
 	}
 
+	void
+	Compiler::setSkipFunctionBody(Bool skipFunctionBody)
+	{
+		if (mInitialized)
+		{
+			throw exceptions::custom_exception(
+				"Function body skipping must be changed before initialize compiler"
+			);
+		}
+		mSkipFunctionBody = skipFunctionBody;
+	}
+
+	void
+	Compiler::setParallelFunctionBody(Bool parallelFunctionBody)
+	{
+		if (mInitialized)
+		{
+			throw exceptions::custom_exception(
+				"Parallel function body parsing must be changed before initialize compiler"
+			);
+		}
+		mParallelFunctionBody = parallelFunctionBody;
+	}
+
+	void
+	Compiler::setProfiler(profiler::Profiler* const profiler)
+	{
+		mProfiler = profiler;
+	}
+
+	void
+	Compiler::setDiagnosticEngine(diagnostics::DiagnosticEngine* const diagnosticEngine)
+	{
+		mDiagnosticEngine = diagnosticEngine;
+		mScopeManager->setDiagnosticEngine(diagnosticEngine);
+	}
+
 	void
 	Compiler::applyTransformation(scope::NodeProcessor* const transformationProcessor)
 	{
@@ -129,13 +535,25 @@ namespace fluffy {
 		mNodeProcessorList.emplace_back(validationProcessor);
 	}
 
+	void
+	Compiler::applyCodeGeneration(codegen::CodeGenerator* const codeGenerator)
+	{
+		mNodeProcessorList.emplace_back(codeGenerator);
+	}
+
+	const std::vector<ast::CodeUnit*>&
+	Compiler::getExecutionTree()
+	{
+		return mExecutionTree;
+	}
+
 	void
 	Compiler::buildInternal(String sourceFile)
 	{
 		std::unique_ptr<jobs::JobParseFromSourceFile> job;
 		{
 			// Cria tarefa e enfileira na fila.
-			job = std::make_unique<jobs::JobParseFromSourceFile>(sourceFile.c_str());
+			job = std::make_unique<jobs::JobParseFromSourceFile>(sourceFile.c_str(), mSkipFunctionBody, mParallelFunctionBody ? mJobCount : 0, mDiagnosticEngine);
 			job->doJob();
 
 			// Valida os code units por ambiguidades.
@@ -143,6 +561,10 @@ namespace fluffy {
 			{
 				if (job->getJobStatus() == jobs::JobStatus_e::Error)
 				{
+					if (reportJobError(sourceFile, job->getError()))
+					{
+						return;
+					}
 					throw exceptions::custom_exception(job->getError());
 				}
 			}
@@ -150,32 +572,13 @@ namespace fluffy {
 
 		// Junta todos as AST das tarefas.
 		ast::CodeUnit* const codeUnit = job->getCodeUnitPointer();
+		onCodeUnitParsed(codeUnit);
 
 		// TODO: Implementar o processamento de includes em multithread.
 		// Processa includes.
 		for (auto& include : codeUnit->includeDeclList)
 		{
-			String fileWithPath;
-			if (utils::IncludeUtils::isIncludeFromSystem(include.get()))
-			{
-				size_t strSize = 0;
-				getenv_s(&strSize, nullptr, 0, "FLUFFY_HOME");
-
-				// Verifica se a variavel ambiente 'FLUFFY_HOME' existe.
-				if (strSize == 0) {
-					throw exceptions::custom_exception("Invalid 'FLUFFY_HOME' environment variable.");
-				}
-
-				String str(strSize, 0);
-				getenv_s(&strSize, const_cast<char*>(str.c_str()), strSize, "FLUFFY_HOME");
-
-				fileWithPath = str + include->inFile + ".txt";
-				throw exceptions::not_implemented_feature_exception(fileWithPath, "include from system");
-			}
-			else
-			{
-				fileWithPath = mBasePath + include->inFile + ".txt";
-			}
+			const String fileWithPath = getIncludeFilename(include.get());
 			buildInternal(fileWithPath);
 			
 			// Atualiza o nome do arquivo
@@ -195,4 +598,194 @@ namespace fluffy {
 		mApplicationTree.emplace(codeUnit->identifier, std::move(job->getCodeUnit()));
 	}
 
+	void
+	Compiler::runNodeProcessors()
+	{
+		const std::vector<String> processorNameList = getProcessorNameList();
+
+		for (auto codeUnit : mExecutionTree)
+		{
+			try
+			{
+				processCodeUnit(codeUnit, processorNameList);
+			}
+			catch (std::exception& e)
+			{
+				// Sem motor de diagnosticos o primeiro erro interrompe o build.
+				if (mDiagnosticEngine == nullptr)
+				{
+					throw;
+				}
+				mDiagnosticEngine->report(diagnostics::DiagnosticCode_e::ProcessingError, codeUnit->identifier, codeUnit, 0, 0, { TString(e.what()) });
+			}
+		}
+	}
+
+	void
+	Compiler::onCodeUnitParsed(ast::CodeUnit* const codeUnit)
+	{
+		// Com os corpos das funcoes ignorados a arvore contem apenas as declaracoes
+		// e o sumario dos simbolos exportados e gerado logo apos o parse. Nos demais
+		// casos ele e gerado sob demanda pela resolucao de includes, apenas para os
+		// arquivos incluidos.
+		if (mSkipFunctionBody)
+		{
+			utils::SummaryUtils::generateExportSummary(codeUnit);
+		}
+	}
+
+	Bool
+	Compiler::reportJobError(const String& sourceFile, const I8* error)
+	{
+		if (mDiagnosticEngine == nullptr)
+		{
+			return false;
+		}
+		mDiagnosticEngine->report(diagnostics::DiagnosticCode_e::ProcessingError, TString(sourceFile.c_str()), nullptr, 0, 0, { TString(error) });
+		return true;
+	}
+
+	void
+	Compiler::processCodeUnit(ast::CodeUnit* const codeUnit, const std::vector<String>& processorNameList)
+	{
+		for (size_t i = 0; i < mNodeProcessorList.size(); i++)
+		{
+			if (processorNameList.empty())
+			{
+				mScopeManager->processCodeUnit(codeUnit, mNodeProcessorList[i].get());
+				continue;
+			}
+
+			profiler::ProfileScope profileScope(processorNameList[i].c_str(), codeUnit->identifier.str());
+			const U64 visitedNodeCount = mScopeManager->getVisitedNodeCount();
+
+			mScopeManager->processCodeUnit(codeUnit, mNodeProcessorList[i].get());
+			profileScope.setNodeCount(mScopeManager->getVisitedNodeCount() - visitedNodeCount);
+		}
+	}
+
+	void
+	Compiler::parseBatchFiles(const std::vector<BatchFile_s*>& parseList)
+	{
+		std::vector<std::unique_ptr<JobParseBatchFile>> jobList;
+		for (auto batchFile : parseList)
+		{
+			batchFile->result.success = true;
+			batchFile->result.error.clear();
+			batchFile->result.cached = false;
+			batchFile->result.processTime = 0;
+			batchFile->includeList.clear();
+
+			jobList.push_back(std::make_unique<JobParseBatchFile>(batchFile, mSkipFunctionBody));
+		}
+
+		const U32 runnerCount = std::min(mJobCount, static_cast<U32>(jobList.size()));
+		if (runnerCount > 1)
+		{
+			jobs::JobPool jobPool(runnerCount);
+			jobPool.initialize();
+
+			for (auto& job : jobList)
+			{
+				jobPool.addJob(job.get());
+			}
+			jobPool.run();
+		}
+		else
+		{
+			for (auto& job : jobList)
+			{
+				job->doJob();
+			}
+		}
+
+		for (auto batchFile : parseList)
+		{
+			if (!batchFile->result.success)
+			{
+				continue;
+			}
+
+			onCodeUnitParsed(batchFile->codeUnit.get());
+
+			try
+			{
+				for (auto& include : batchFile->codeUnit->includeDeclList)
+				{
+					const String includeFilename = getIncludeFilename(include.get());
+					batchFile->includeList.push_back(getBatchFile(includeFilename));
+
+					// Atualiza o nome do arquivo
+					include->inFile = includeFilename;
+				}
+			}
+			catch (std::exception& e)
+			{
+				setBatchError(batchFile, e.what());
+			}
+		}
+	}
+
+	BatchFile_s*
+	Compiler::getBatchFile(const String& sourceFile)
+	{
+		auto& batchFile = mBatchFileMap[sourceFile];
+		if (batchFile == nullptr)
+		{
+			batchFile = std::make_unique<BatchFile_s>();
+			batchFile->result = BuildResult_s { sourceFile, false, true, String(), 0, 0, false };
+			batchFile->registeredCodeUnit = nullptr;
+			batchFile->hasStamp = false;
+			batchFile->generation = 0;
+		}
+		return batchFile.get();
+	}
+
+	void
+	Compiler::unregisterCodeUnit(ast::CodeUnit* const codeUnit)
+	{
+		auto it = std::find(mExecutionTree.begin(), mExecutionTree.end(), codeUnit);
+		if (it != mExecutionTree.end())
+		{
+			mExecutionTree.erase(it);
+		}
+		mScopeManager->removeCodeUnit(codeUnit->identifier);
+		mApplicationTree.erase(codeUnit->identifier);
+	}
+
+	std::vector<String>
+	Compiler::getProcessorNameList()
+	{
+		// Sem profiler ativo os nomes dos processadores nao sao calculados.
+		std::vector<String> processorNameList;
+		if (profiler::Profiler::getActive() != nullptr)
+		{
+			for (auto& nodeProcessor : mNodeProcessorList)
+			{
+				processorNameList.push_back(profiler::Profiler::getTypeName(typeid(*nodeProcessor)));
+			}
+		}
+		return processorNameList;
+	}
+
+	String
+	Compiler::getIncludeFilename(ast::IncludeDecl* const includeDecl)
+	{
+		if (utils::IncludeUtils::isIncludeFromSystem(includeDecl))
+		{
+			size_t strSize = 0;
+			getenv_s(&strSize, nullptr, 0, "FLUFFY_HOME");
+
+			// Verifica se a variavel ambiente 'FLUFFY_HOME' existe.
+			if (strSize == 0) {
+				throw exceptions::custom_exception("Invalid 'FLUFFY_HOME' environment variable.");
+			}
+
+			String str(strSize, 0);
+			getenv_s(&strSize, const_cast<char*>(str.c_str()), strSize, "FLUFFY_HOME");
+
+			throw exceptions::not_implemented_feature_exception(str + includeDecl->inFile + ".txt", "include from system");
+		}
+		return mBasePath + includeDecl->inFile + ".txt";
+	}
 }
\ No newline at end of file
@@ -242,6 +242,8 @@ namespace fluffy {
 			return "panic stmt";
 		case AstNodeType_e::StmtExpr:
 			return "expr stmt";
+		case AstNodeType_e::StmtError:
+			return "error stmt";
 		case AstNodeType_e::StmtForInitDecl:
 			return "stmt for init decl";
 		case AstNodeType_e::StmtMatchWhenDecl:
@@ -18,7 +18,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* file_not_found_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		sprintf_s(buffer, "File not found: '%s'", m_filename.c_str());
 		return buffer;
 	}
@@ -48,7 +48,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* unexpected_token_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		if (m_isChar) {
 			sprintf_s(buffer, "%s error: Unexpected token '%c' at: line %d, column %d", m_filename.c_str(), m_tokenChar, m_line, m_column);
 		} else {
@@ -106,7 +106,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* unexpected_end_of_file_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		sprintf_s(buffer, "%s error: Unexpected end of file", m_filename.c_str());
 		return buffer;
 	}
@@ -126,7 +126,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* malformed_number_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		sprintf_s(buffer, "%s error: Malphormed number at: line %d, column %d", m_filename.c_str(), m_line, m_column);
 		return buffer;
 	}
@@ -146,7 +146,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* malformed_character_constant_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		sprintf_s(buffer, "%s error: Malphormed character constant at: line %d, column %d", m_filename.c_str(), m_line, m_column);
 		return buffer;
 	}
@@ -166,7 +166,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* malformed_string_constant_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		sprintf_s(buffer, "%s error: Malphormed string constant at: line %d, column %d", m_filename.c_str(), m_line, m_column);
 		return buffer;
 	}
@@ -185,7 +185,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* not_implemented_feature_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		sprintf_s(buffer, "%s error: This feature '%s' is not implemented", m_filename.c_str(), m_feature.c_str());
 		return buffer;
 	}
@@ -206,7 +206,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* unexpected_type_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		sprintf_s(buffer, "%s error: Unexpected type '%s' at: line %d, column %d", m_filename.c_str(), m_type.c_str(), m_line, m_column);
 		return buffer;
 	}
@@ -226,7 +226,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* expected_type_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		sprintf_s(buffer, "Expected type declaration at: line %d, column %d", m_line, m_column);
 		return buffer;
 	}
@@ -241,7 +241,7 @@ namespace fluffy { namespace exceptions {
 		, m_line(line)
 		, m_column(column)
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		va_list list;
 
 		va_start(list, column);
@@ -257,7 +257,7 @@ namespace fluffy { namespace exceptions {
 		, m_line(0)
 		, m_column(0)
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		va_list list;
 
 		va_start(list, message);
@@ -272,7 +272,7 @@ namespace fluffy { namespace exceptions {
 
 	const char* custom_exception::what() const noexcept
 	{
-		static char buffer[bufferSize];
+		static thread_local char buffer[bufferSize];
 		if (m_hasPositionalInfo) {
 			sprintf_s(buffer, "%s at: line %d, column %d", m_message.c_str(), m_line, m_column);
 		} else {
@@ -1,5 +1,7 @@
 #include <unordered_map>
+#include <vector>
 #include <mutex>
+#include <cstring>
 #include "fl_string.h"
 
 namespace fluffy {
@@ -10,33 +12,25 @@ namespace fluffy {
 	class TStringBuffer
 	{
 	private:
-		TStringBuffer(const U32 bufferSize = 2097152) // 2MB
-			: m_buffer(nullptr)
-			, m_cursor(0)
-			, m_bufferSize(bufferSize)
-		{
-			if (auto newBuffer = malloc(bufferSize))
-			{
-				m_buffer = static_cast<I8*>(newBuffer);
-			}
-		}
+		TStringBuffer(const U32 chunkSize = 2097152) // 2MB
+			: m_cursor(0)
+			, m_chunkSize(chunkSize)
+			, m_currentChunkSize(0)
+		{}
 
 	public:
 		~TStringBuffer()
 		{
-			if (m_buffer != nullptr) {
-				delete m_buffer;
-				m_buffer = nullptr;
+			for (auto chunk : m_chunkList) {
+				free(chunk);
 			}
+			m_chunkList.clear();
 		}
 
 		static
 		TStringBuffer* getSingleton()
 		{
-			static TStringBuffer* buffer = nullptr;
-			if (buffer == nullptr) {
-				buffer = new TStringBuffer(32768);
-			}
+			static TStringBuffer* buffer = new TStringBuffer(32768);
 			return buffer;
 		}
 
@@ -49,72 +43,66 @@ namespace fluffy {
 			}
 			const U64 strHash = std::hash<std::string>{}(str);
 
-			// Verifica se string ja existe.
-			auto strFinded = mStringLibrary.find(strHash);
-			if (strFinded != mStringLibrary.end()) {
-				return std::tuple<U64, const I8*>(strFinded->first, strFinded->second);
-			}
-
+			// A busca e a insercao sao feitas sob o mesmo lock, o parser
+			// pode internar strings a partir de varias threads.
 			std::lock_guard<std::mutex> guard(m_mutex);
 			{
-				// Verifica se e necesseario aumentar o tamanho do buffer.
-				if (m_bufferSize - m_cursor < 256)
-				{
-					m_bufferSize += 8192; // 8K
-					if (auto newBuffer = realloc(m_buffer, m_bufferSize))
-					{
-						m_buffer = static_cast<I8*>(newBuffer);
-					}
+				// Verifica se string ja existe.
+				auto strFinded = mStringLibrary.find(strHash);
+				if (strFinded != mStringLibrary.end()) {
+					return std::tuple<U64, const I8*>(strFinded->first, strFinded->second);
 				}
 
-				I8* bufferStrBeg = m_buffer + m_cursor;
-				I8* strCur = const_cast<I8*>(str);
+				const U32 len = static_cast<U32>(strlen(str)) + 1;
 
-				// Adiciona string ao buffer.
-				if (I8* bufferCur = bufferStrBeg)
+				// Aloca um novo bloco quando a string nao cabe no atual. Os blocos
+				// nunca sao realocados, os ponteiros ja entregues continuam validos.
+				if (m_chunkList.empty() || m_currentChunkSize - m_cursor < len)
 				{
-					while (*strCur != 0)
+					const U32 newChunkSize = len > m_chunkSize ? len : m_chunkSize;
+					if (auto newChunk = malloc(newChunkSize))
 					{
-						*bufferCur++ = *strCur++;
+						m_chunkList.push_back(static_cast<I8*>(newChunk));
+						m_currentChunkSize = newChunkSize;
+						m_cursor = 0;
 					}
-					*bufferCur++ = '\0';
-
-					// Atualiza posicao do pcursor para a proxima
-					m_cursor += static_cast<U32>(bufferCur - bufferStrBeg);
-
-					// Verifica se e necesseario aumentar o tamanho do buffer.
-					if (m_cursor >= m_bufferSize)
+					else
 					{
-						m_bufferSize += 8192; // 16K
-						if (auto newBuffer = realloc(m_buffer, m_bufferSize))
-						{
-							m_buffer = static_cast<I8*>(newBuffer);
-						}
+						return std::tuple<U64, const I8*>(0, nullptr);
 					}
+				}
 
-					mStringLibrary.emplace(strHash, bufferStrBeg);
+				// Adiciona string ao buffer.
+				I8* bufferStrBeg = m_chunkList.back() + m_cursor;
+				memcpy(bufferStrBeg, str, len);
 
-					return std::tuple<U64, const I8*>(strHash, bufferStrBeg);
-				}
+				// Atualiza posicao do cursor para a proxima
+				m_cursor += len;
+
+				mStringLibrary.emplace(strHash, bufferStrBeg);
+
+				return std::tuple<U64, const I8*>(strHash, bufferStrBeg);
 			}
-			return std::tuple<U64, const I8*>(0, nullptr);
 		}
 
 	private:
 		std::unordered_map<U64, const I8*>
 		mStringLibrary;
 
+		std::vector<I8*>
+		m_chunkList;
+
 		std::mutex
 		m_mutex;
 
-		I8*
-		m_buffer;
-
 		U32
 		m_cursor;
 
 		U32
-		m_bufferSize;
+		m_chunkSize;
+
+		U32
+		m_currentChunkSize;
 	};
 }
 
@@ -0,0 +1,646 @@
+#include <string>
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_type.h"
+#include "attributes/fl_reference.h"
+#include "attributes/fl_generic_instance.h"
+#include "generics/fl_clone.h"
+#include "generics/fl_monomorphizer.h"
+namespace fluffy { namespace generics {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static const I8*
+	getPrimitiveName(PrimitiveTypeID_e primitiveType)
+	{
+		switch (primitiveType)
+		{
+		case PrimitiveTypeID_e::Void:		return "void";
+		case PrimitiveTypeID_e::Bool:		return "bool";
+		case PrimitiveTypeID_e::I8:			return "i8";
+		case PrimitiveTypeID_e::U8:			return "u8";
+		case PrimitiveTypeID_e::I16:		return "i16";
+		case PrimitiveTypeID_e::U16:		return "u16";
+		case PrimitiveTypeID_e::I32:		return "i32";
+		case PrimitiveTypeID_e::U32:		return "u32";
+		case PrimitiveTypeID_e::I64:		return "i64";
+		case PrimitiveTypeID_e::U64:		return "u64";
+		case PrimitiveTypeID_e::Fp32:		return "fp32";
+		case PrimitiveTypeID_e::Fp64:		return "fp64";
+		case PrimitiveTypeID_e::String:		return "string";
+		case PrimitiveTypeID_e::Object:		return "object";
+		default:
+			break;
+		}
+		return "unknown";
+	}
+
+	static void
+	specializeSlot(ast::TypeDeclPtr& target, ast::TypeDecl* const source, const SubstitutionMap& substitutionMap)
+	{
+		if (source != nullptr)
+		{
+			target = specializeType(source, substitutionMap);
+		}
+	}
+
+	static void
+	specializeParameters(ast::FunctionParameterDeclPtrList& target, const ast::FunctionParameterDeclPtrList& source, const SubstitutionMap& substitutionMap)
+	{
+		for (size_t i = 0; i < source.size(); i++)
+		{
+			specializeSlot(target[i]->typeDecl, source[i]->typeDecl.get(), substitutionMap);
+		}
+	}
+
+	ast::TypeDeclPtr
+	specializeType(ast::TypeDecl* const typeDecl, const SubstitutionMap& substitutionMap)
+	{
+		switch (typeDecl->nodeType)
+		{
+		case AstNodeType_e::NamedType:
+			{
+				auto namedType = typeDecl->to<ast::TypeDeclNamed>();
+				auto reference = namedType->getAttribute<attributes::Reference>();
+
+				if (reference != nullptr)
+				{
+					auto it = substitutionMap.find(reference->get());
+
+					// Item do generic: 'T?' com 'T = i32' resulta em 'i32?'.
+					if (it != substitutionMap.end())
+					{
+						ast::TypeDeclPtr argumentType = specializeType(it->second, SubstitutionMap());
+						argumentType->nullable |= namedType->nullable;
+						return argumentType;
+					}
+				}
+
+				auto newType = std::make_unique<ast::TypeDeclNamed>(namedType->line, namedType->column);
+
+				newType->identifier = namedType->identifier;
+				newType->nullable = namedType->nullable;
+				newType->startFromRoot = namedType->startFromRoot;
+				newType->scopePath = clone_single(namedType->scopePath);
+
+				for (auto& genericType : namedType->genericDefinitionList)
+				{
+					newType->genericDefinitionList.push_back(specializeType(genericType.get(), substitutionMap));
+				}
+
+				if (reference != nullptr)
+				{
+					newType->insertAttribute(new attributes::Reference(reference->getScope(), reference->get()));
+				}
+				return newType;
+			}
+		case AstNodeType_e::ArrayType:
+			{
+				auto arrayType = typeDecl->to<ast::TypeDeclArray>();
+				auto newType = std::make_unique<ast::TypeDeclArray>(arrayType->line, arrayType->column);
+
+				newType->identifier = arrayType->identifier;
+				newType->nullable = arrayType->nullable;
+				newType->arrayDeclList = clone_each(arrayType->arrayDeclList);
+				newType->valueType = specializeType(arrayType->valueType.get(), substitutionMap);
+
+				return newType;
+			}
+		case AstNodeType_e::FunctionType:
+			{
+				auto functionType = typeDecl->to<ast::TypeDeclFunction>();
+				auto newType = std::make_unique<ast::TypeDeclFunction>(functionType->line, functionType->column);
+
+				newType->identifier = functionType->identifier;
+				newType->nullable = functionType->nullable;
+
+				specializeSlot(newType->objectOwnerDecl, functionType->objectOwnerDecl.get(), substitutionMap);
+				for (auto& parameterType : functionType->parameterTypeList)
+				{
+					newType->parameterTypeList.push_back(specializeType(parameterType.get(), substitutionMap));
+				}
+				specializeSlot(newType->returnType, functionType->returnType.get(), substitutionMap);
+
+				return newType;
+			}
+		case AstNodeType_e::TupleType:
+			{
+				auto tupleType = typeDecl->to<ast::TypeDeclTuple>();
+				auto newType = std::make_unique<ast::TypeDeclTuple>(tupleType->line, tupleType->column);
+
+				newType->identifier = tupleType->identifier;
+				newType->nullable = tupleType->nullable;
+
+				for (auto& itemType : tupleType->tupleItemList)
+				{
+					newType->tupleItemList.push_back(specializeType(itemType.get(), substitutionMap));
+				}
+				return newType;
+			}
+		default:
+			break;
+		}
+		return ast::TypeDeclPtr(clone<ast::TypeDecl>(typeDecl));
+	}
+
+	/**
+	 * InstanceCache
+	 */
+
+	InstanceCache::InstanceCache()
+		: mHitCount(0)
+	{}
+
+	InstanceCache::~InstanceCache()
+	{}
+
+	Instance_s*
+	InstanceCache::instantiate(ast::AstNode* const genericDecl, const ast::TypeDeclPtrList& argumentList)
+	{
+		String key = getDeclName(genericDecl) + "<";
+
+		for (size_t i = 0; i < argumentList.size(); i++)
+		{
+			key += (i ? ", " : "") + getTypeKey(argumentList[i].get());
+		}
+		key += ">";
+
+		auto it = mInstanceMap.find(key);
+
+		if (it != mInstanceMap.end())
+		{
+			it->second->useCount++;
+			mHitCount++;
+			return it->second.get();
+		}
+
+		auto instance = std::make_unique<Instance_s>();
+		instance->genericDecl = genericDecl;
+		instance->key = key;
+		instance->useCount = 1;
+
+		// Os argumentos sao copiados, a instancia sobrevive ao uso que a criou.
+		SubstitutionMap substitutionMap;
+		ast::GenericDecl* const genericItemDecl = getGenericDecl(genericDecl);
+
+		for (size_t i = 0; i < argumentList.size(); i++)
+		{
+			instance->argumentList.push_back(specializeType(argumentList[i].get(), SubstitutionMap()));
+			substitutionMap[genericItemDecl->genericDeclItemList[i].get()] = instance->argumentList.back().get();
+		}
+		instance->specializedDecl.reset(specialize(genericDecl, substitutionMap));
+
+		Instance_s* const result = instance.get();
+
+		mInstanceList.push_back(result);
+		mInstanceMap.emplace(key, std::move(instance));
+
+		return result;
+	}
+
+	Instance_s*
+	InstanceCache::findInstance(const String& key)
+	{
+		auto it = mInstanceMap.find(key);
+
+		if (it != mInstanceMap.end())
+		{
+			return it->second.get();
+		}
+		return nullptr;
+	}
+
+	const std::vector<Instance_s*>&
+	InstanceCache::getInstanceList()
+	{
+		return mInstanceList;
+	}
+
+	U32
+	InstanceCache::getHitCount()
+	{
+		return mHitCount;
+	}
+
+	String
+	InstanceCache::getTypeKey(ast::TypeDecl* const typeDecl)
+	{
+		String key;
+
+		switch (typeDecl->nodeType)
+		{
+		case AstNodeType_e::PrimitiveType:
+			key = getPrimitiveName(typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType);
+			break;
+		case AstNodeType_e::ArrayType:
+			{
+				auto arrayType = typeDecl->to<ast::TypeDeclArray>();
+
+				key = getTypeKey(arrayType->valueType.get());
+				for (auto& arrayDecl : arrayType->arrayDeclList)
+				{
+					key += arrayDecl->nodeType == AstNodeType_e::SizedArray
+						? "[" + std::to_string(arrayDecl->to<ast::SizedArrayDecl>()->size) + "]"
+						: "[]";
+				}
+			}
+			break;
+		case AstNodeType_e::FunctionType:
+			{
+				auto functionType = typeDecl->to<ast::TypeDeclFunction>();
+
+				key = functionType->objectOwnerDecl
+					? getTypeKey(functionType->objectOwnerDecl.get()) + "::fn("
+					: "fn(";
+
+				for (size_t i = 0; i < functionType->parameterTypeList.size(); i++)
+				{
+					key += (i ? ", " : "") + getTypeKey(functionType->parameterTypeList[i].get());
+				}
+				key += ")";
+
+				if (functionType->returnType)
+				{
+					key += " -> " + getTypeKey(functionType->returnType.get());
+				}
+			}
+			break;
+		case AstNodeType_e::TupleType:
+			{
+				auto tupleType = typeDecl->to<ast::TypeDeclTuple>();
+
+				key = "(";
+				for (size_t i = 0; i < tupleType->tupleItemList.size(); i++)
+				{
+					key += (i ? ", " : "") + getTypeKey(tupleType->tupleItemList[i].get());
+				}
+				key += ")";
+			}
+			break;
+		case AstNodeType_e::NamedType:
+			{
+				auto namedType = typeDecl->to<ast::TypeDeclNamed>();
+				auto reference = namedType->getAttribute<attributes::Reference>();
+
+				key = reference != nullptr && reference->get()->nodeType != AstNodeType_e::GenericItemDecl
+					? getDeclName(reference->get())
+					: String(namedType->identifier.str());
+
+				if (namedType->genericDefinitionList.size())
+				{
+					key += "<";
+					for (size_t i = 0; i < namedType->genericDefinitionList.size(); i++)
+					{
+						key += (i ? ", " : "") + getTypeKey(namedType->genericDefinitionList[i].get());
+					}
+					key += ">";
+				}
+			}
+			break;
+		case AstNodeType_e::SelfType:
+			key = "self";
+			break;
+		default:
+			break;
+		}
+
+		if (typeDecl->nullable)
+		{
+			key += "?";
+		}
+		return key;
+	}
+
+	Bool
+	InstanceCache::isOpen(ast::TypeDecl* const typeDecl)
+	{
+		switch (typeDecl->nodeType)
+		{
+		case AstNodeType_e::ArrayType:
+			return isOpen(typeDecl->to<ast::TypeDeclArray>()->valueType.get());
+		case AstNodeType_e::FunctionType:
+			{
+				auto functionType = typeDecl->to<ast::TypeDeclFunction>();
+
+				if (functionType->objectOwnerDecl && isOpen(functionType->objectOwnerDecl.get()))
+				{
+					return true;
+				}
+
+				for (auto& parameterType : functionType->parameterTypeList)
+				{
+					if (isOpen(parameterType.get()))
+					{
+						return true;
+					}
+				}
+				return functionType->returnType && isOpen(functionType->returnType.get());
+			}
+		case AstNodeType_e::TupleType:
+			for (auto& itemType : typeDecl->to<ast::TypeDeclTuple>()->tupleItemList)
+			{
+				if (isOpen(itemType.get()))
+				{
+					return true;
+				}
+			}
+			return false;
+		case AstNodeType_e::NamedType:
+			{
+				auto namedType = typeDecl->to<ast::TypeDeclNamed>();
+				auto reference = namedType->getAttribute<attributes::Reference>();
+
+				// Tipos nao resolvidos tambem nao podem ser especializados.
+				if (reference == nullptr || reference->get()->nodeType == AstNodeType_e::GenericItemDecl)
+				{
+					return true;
+				}
+
+				for (auto& genericType : namedType->genericDefinitionList)
+				{
+					if (isOpen(genericType.get()))
+					{
+						return true;
+					}
+				}
+			}
+			return false;
+		case AstNodeType_e::SelfType:
+			// Depende de quem implementa a trait.
+			return true;
+		default:
+			break;
+		}
+		return false;
+	}
+
+	ast::GenericDecl*
+	InstanceCache::getGenericDecl(ast::AstNode* const decl)
+	{
+		switch (decl->nodeType)
+		{
+		case AstNodeType_e::ClassDecl:
+			return decl->to<ast::ClassDecl>()->genericDecl.get();
+		case AstNodeType_e::InterfaceDecl:
+			return decl->to<ast::InterfaceDecl>()->genericDecl.get();
+		case AstNodeType_e::StructDecl:
+			return decl->to<ast::StructDecl>()->genericDecl.get();
+		case AstNodeType_e::TraitDecl:
+			return decl->to<ast::TraitDecl>()->genericDecl.get();
+		case AstNodeType_e::EnumDecl:
+			return decl->to<ast::EnumDecl>()->genericDecl.get();
+		case AstNodeType_e::FunctionDecl:
+			return decl->to<ast::FunctionDecl>()->genericDecl.get();
+		default:
+			break;
+		}
+		return nullptr;
+	}
+
+	String
+	InstanceCache::getDeclName(ast::AstNode* const decl)
+	{
+		auto it = mDeclNameMap.find(decl);
+
+		if (it != mDeclNameMap.end())
+		{
+			return it->second;
+		}
+
+		String name = decl->identifier.str();
+		const U32 count = mDeclNameCount[name]++;
+
+		if (count > 0)
+		{
+			name += "#" + std::to_string(count);
+		}
+		mDeclNameMap.emplace(decl, name);
+
+		return name;
+	}
+
+	ast::AstNode*
+	InstanceCache::specialize(ast::AstNode* const genericDecl, const SubstitutionMap& substitutionMap)
+	{
+		// As copias possuem apenas as assinaturas: os corpos das funcoes sao
+		// compartilhados, os generics nao existem em tempo de execucao.
+		switch (genericDecl->nodeType)
+		{
+		case AstNodeType_e::ClassDecl:
+			{
+				auto classDecl = genericDecl->to<ast::ClassDecl>();
+				auto newDecl = clone(classDecl);
+
+				newDecl->genericDecl = nullptr;
+
+				specializeSlot(newDecl->baseClass, classDecl->baseClass.get(), substitutionMap);
+				for (size_t i = 0; i < classDecl->interfaceList.size(); i++)
+				{
+					specializeSlot(newDecl->interfaceList[i], classDecl->interfaceList[i].get(), substitutionMap);
+				}
+
+				for (size_t i = 0; i < classDecl->variableList.size(); i++)
+				{
+					specializeSlot(newDecl->variableList[i]->typeDecl, classDecl->variableList[i]->typeDecl.get(), substitutionMap);
+				}
+
+				for (size_t i = 0; i < classDecl->constructorList.size(); i++)
+				{
+					specializeParameters(newDecl->constructorList[i]->parameterList, classDecl->constructorList[i]->parameterList, substitutionMap);
+				}
+
+				for (size_t i = 0; i < classDecl->functionList.size(); i++)
+				{
+					auto functionDecl = classDecl->functionList[i].get();
+					auto newFunctionDecl = newDecl->functionList[i].get();
+
+					specializeSlot(newFunctionDecl->sourceTypeDecl, functionDecl->sourceTypeDecl.get(), substitutionMap);
+					specializeParameters(newFunctionDecl->parameterList, functionDecl->parameterList, substitutionMap);
+					specializeSlot(newFunctionDecl->returnType, functionDecl->returnType.get(), substitutionMap);
+				}
+				return newDecl;
+			}
+		case AstNodeType_e::InterfaceDecl:
+			{
+				auto interfaceDecl = genericDecl->to<ast::InterfaceDecl>();
+				auto newDecl = clone(interfaceDecl);
+
+				newDecl->genericDecl = nullptr;
+
+				for (size_t i = 0; i < interfaceDecl->functionDeclList.size(); i++)
+				{
+					specializeParameters(newDecl->functionDeclList[i]->parameterList, interfaceDecl->functionDeclList[i]->parameterList, substitutionMap);
+					specializeSlot(newDecl->functionDeclList[i]->returnType, interfaceDecl->functionDeclList[i]->returnType.get(), substitutionMap);
+				}
+				return newDecl;
+			}
+		case AstNodeType_e::StructDecl:
+			{
+				auto structDecl = genericDecl->to<ast::StructDecl>();
+				auto newDecl = clone(structDecl);
+
+				newDecl->genericDecl = nullptr;
+
+				for (size_t i = 0; i < structDecl->variableList.size(); i++)
+				{
+					specializeSlot(newDecl->variableList[i]->typeDecl, structDecl->variableList[i]->typeDecl.get(), substitutionMap);
+				}
+				return newDecl;
+			}
+		case AstNodeType_e::TraitDecl:
+			{
+				auto traitDecl = genericDecl->to<ast::TraitDecl>();
+				auto newDecl = clone(traitDecl);
+
+				newDecl->genericDecl = nullptr;
+
+				for (size_t i = 0; i < traitDecl->functionDeclList.size(); i++)
+				{
+					specializeParameters(newDecl->functionDeclList[i]->parameterList, traitDecl->functionDeclList[i]->parameterList, substitutionMap);
+					specializeSlot(newDecl->functionDeclList[i]->returnType, traitDecl->functionDeclList[i]->returnType.get(), substitutionMap);
+				}
+				return newDecl;
+			}
+		case AstNodeType_e::EnumDecl:
+			{
+				auto enumDecl = genericDecl->to<ast::EnumDecl>();
+				auto newDecl = clone(enumDecl);
+
+				newDecl->genericDecl = nullptr;
+
+				for (size_t i = 0; i < enumDecl->enumItemDeclList.size(); i++)
+				{
+					auto& dataTypeDeclList = enumDecl->enumItemDeclList[i]->dataTypeDeclList;
+
+					for (size_t j = 0; j < dataTypeDeclList.size(); j++)
+					{
+						specializeSlot(newDecl->enumItemDeclList[i]->dataTypeDeclList[j], dataTypeDeclList[j].get(), substitutionMap);
+					}
+				}
+				return newDecl;
+			}
+		case AstNodeType_e::FunctionDecl:
+			{
+				auto functionDecl = genericDecl->to<ast::FunctionDecl>();
+				auto newDecl = clone(functionDecl);
+
+				newDecl->genericDecl = nullptr;
+
+				specializeParameters(newDecl->parameterList, functionDecl->parameterList, substitutionMap);
+				specializeSlot(newDecl->returnType, functionDecl->returnType.get(), substitutionMap);
+
+				return newDecl;
+			}
+		default:
+			break;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * Monomorphizer
+	 */
+
+	Monomorphizer::Monomorphizer()
+		: mScopeManager(nullptr)
+	{}
+
+	Monomorphizer::~Monomorphizer()
+	{}
+
+	void
+	Monomorphizer::onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node)
+	{
+		if (event != scope::NodeProcessorEvent_e::onBegin)
+		{
+			return;
+		}
+		mScopeManager = scopeManager;
+
+		switch (node->nodeType)
+		{
+		case AstNodeType_e::NamedType:
+			collectNamedType(node->to<ast::TypeDeclNamed>());
+			break;
+		case AstNodeType_e::GenericCallExpr:
+			collectGenericCall(node->to<ast::expr::ExpressionGenericCallDecl>());
+			break;
+		default:
+			break;
+		}
+	}
+
+	InstanceCache*
+	Monomorphizer::getInstanceCache()
+	{
+		return &mInstanceCache;
+	}
+
+	void
+	Monomorphizer::collectNamedType(ast::TypeDeclNamed* const namedType)
+	{
+		auto reference = namedType->getAttribute<attributes::Reference>();
+
+		if (reference == nullptr || !canInstantiate(reference->get(), namedType->genericDefinitionList))
+		{
+			return;
+		}
+
+		Instance_s* const instance = mInstanceCache.instantiate(reference->get(), namedType->genericDefinitionList);
+
+		namedType->removeAttribute(AttributeType_e::GenericInstance);
+		namedType->insertAttribute(new attributes::GenericInstance(instance));
+	}
+
+	void
+	Monomorphizer::collectGenericCall(ast::expr::ExpressionGenericCallDecl* const genericCallDecl)
+	{
+		// Apenas funcoes chamadas pelo nome sao resolvidas, metodos dependem do
+		// tipo do objeto.
+		if (genericCallDecl->lhsDecl->nodeType != AstNodeType_e::IdentifierExpr)
+		{
+			return;
+		}
+
+		auto identifierDecl = genericCallDecl->lhsDecl->to<ast::expr::ExpressionIdentifierDecl>();
+		const scope::FindResult_t findResult = mScopeManager->findNodeById(identifierDecl->identifier, identifierDecl->startFromRoot);
+
+		if (!findResult.foundResult || findResult.nodeList.size() != 1)
+		{
+			return;
+		}
+
+		if (!canInstantiate(findResult.nodeList[0], genericCallDecl->genericTypeList))
+		{
+			return;
+		}
+
+		Instance_s* const instance = mInstanceCache.instantiate(findResult.nodeList[0], genericCallDecl->genericTypeList);
+
+		genericCallDecl->removeAttribute(AttributeType_e::GenericInstance);
+		genericCallDecl->insertAttribute(new attributes::GenericInstance(instance));
+	}
+
+	Bool
+	Monomorphizer::canInstantiate(ast::AstNode* const genericDecl, const ast::TypeDeclPtrList& argumentList)
+	{
+		ast::GenericDecl* const genericItemDecl = InstanceCache::getGenericDecl(genericDecl);
+
+		if (genericItemDecl == nullptr || argumentList.empty() || genericItemDecl->genericDeclItemList.size() != argumentList.size())
+		{
+			return false;
+		}
+
+		// Usos dentro de outros generics, como 'List<T>', dependem dos argumentos
+		// da declaracao que os contem e nao sao instanciados.
+		for (auto& argumentType : argumentList)
+		{
+			if (InstanceCache::isOpen(argumentType.get()))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+} }
@@ -0,0 +1,1475 @@
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_type.h"
+#include "attributes/fl_resolved_type.h"
+#include "interpreter/fl_ast_interpreter.h"
+#include "fl_exceptions.h"
+namespace fluffy { namespace interpreter {
+	using namespace vm;
+	using attributes::FrameSlot;
+	using attributes::SlotType_e;
+	using codegen::OpCode_e;
+
+	// Quantidade de valores da pilha, compartilhada por todos os frames.
+	static constexpr const U32 maxStackSize = 1 << 18;
+
+	// Cada chamada do script usa varios frames da pilha nativa, o limite e menor
+	// que o da maquina virtual.
+	static constexpr const U32 maxCallDepth = 1 << 9;
+
+	// Quantidade de objetos alocados antes da primeira coleta.
+	static constexpr const U32 initialCollectionThreshold = 1 << 16;
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static String
+	getIdentifier(const TString& identifier)
+	{
+		return identifier.str() != nullptr ? String(identifier.str()) : String();
+	}
+
+	static FrameSlot*
+	getSlot(ast::AstNode* const node)
+	{
+		return node->getAttribute<FrameSlot>();
+	}
+
+	static Value_s
+	makeI32(I64 value)
+	{
+		Value_s result;
+		result.type = ValueType_e::I32;
+		result.integerValue = static_cast<I32>(value);
+		return result;
+	}
+
+	/**
+	 * AstInterpreter
+	 */
+
+	AstInterpreter::AstInterpreter(Program* const program)
+		: mProgram(program)
+		, mTop(nullptr)
+		, mReturnValue(makeNull())
+		, mObjectList(nullptr)
+		, mObjectCount(0)
+		, mNextCollection(initialCollectionThreshold)
+		, mInlineCacheMissCount(0)
+		, mInitialized(false)
+	{
+		// Strings constantes nunca sao coletadas.
+		for (U32 i = 0; i < program->getStringConstantCount(); i++)
+		{
+			auto stringObject = new StringObject_s(String(program->getStringConstant(i)));
+			stringObject->marked = true;
+
+			mConstantList.push_back(makeObject(stringObject));
+		}
+
+		mClassList.resize(program->getClassCount());
+		for (U32 i = 0; i < program->getClassCount(); i++)
+		{
+			prepareClass(i);
+		}
+
+		mGlobalList.resize(program->getGlobalCount(), makeNull());
+		mStack.resize(maxStackSize, makeNull());
+		mFrameList.reserve(maxCallDepth);
+
+		mTop = mStack.data();
+	}
+
+	AstInterpreter::~AstInterpreter()
+	{
+		while (mObjectList)
+		{
+			HeapObject_s* const next = mObjectList->next;
+			delete mObjectList;
+			mObjectList = next;
+		}
+
+		for (auto& constant : mConstantList)
+		{
+			delete constant.object;
+		}
+	}
+
+	void
+	AstInterpreter::initialize()
+	{
+		if (mInitialized)
+		{
+			return;
+		}
+		mInitialized = true;
+
+		// Inicializa as variaveis globais de cada code unit.
+		for (auto functionIndex : mProgram->getInitFunctionList())
+		{
+			call(functionIndex, {});
+		}
+	}
+
+	Value_s
+	AstInterpreter::call(const String& functionName, const std::vector<Value_s>& argumentList)
+	{
+		const U32 functionIndex = mProgram->findFunction(functionName);
+
+		if (functionIndex == invalidIndex)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' not found",
+				functionName.c_str()
+			);
+		}
+		return call(functionIndex, argumentList);
+	}
+
+	Value_s
+	AstInterpreter::call(U32 functionIndex, const std::vector<Value_s>& argumentList)
+	{
+		auto function = mProgram->getFunction(functionIndex);
+
+		// Nos metodos o primeiro argumento e o 'this'.
+		const U32 firstArgument = function->isMethod ? 1 : 0;
+
+		if (argumentList.size() > function->parameterCount + firstArgument)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' receives %d arguments",
+				function->name.c_str(),
+				function->parameterCount
+			);
+		}
+
+		Value_s* const callBase = mTop;
+		const size_t stopDepth = mFrameList.size();
+
+		try
+		{
+			for (auto& argument : argumentList)
+			{
+				push(argument);
+			}
+
+			if (argumentList.size() < firstArgument)
+			{
+				push(makeNull());
+			}
+			return invoke(functionIndex, callBase, static_cast<U32>(mTop - callBase) - firstArgument);
+		}
+		catch (...)
+		{
+			mFrameList.resize(stopDepth);
+			mTop = callBase;
+			throw;
+		}
+	}
+
+	Value_s
+	AstInterpreter::getGlobal(const String& globalName)
+	{
+		const U32 globalIndex = mProgram->findGlobal(globalName);
+		return globalIndex != invalidIndex ? mGlobalList[globalIndex] : makeNull();
+	}
+
+	Value_s
+	AstInterpreter::makeString(String value)
+	{
+		return makeObject(allocate<StringObject_s>(std::move(value)));
+	}
+
+	String
+	AstInterpreter::toString(const Value_s& value)
+	{
+		switch (value.type)
+		{
+		case ValueType_e::Object:
+			return mClassList[static_cast<InstanceObject_s*>(value.object)->classIndex].classInfo->name;
+		case ValueType_e::Array:
+			{
+				auto& elementList = static_cast<ArrayObject_s*>(value.object)->elementList;
+
+				String result = "[";
+				for (U32 i = 0; i < elementList.size(); i++)
+				{
+					result += (i ? ", " : "") + toString(elementList[i]);
+				}
+				return result + "]";
+			}
+		case ValueType_e::Function:
+			return "<fn " + mProgram->getFunction(value.functionIndex)->name + ">";
+		default:
+			return formatValue(value);
+		}
+	}
+
+	void
+	AstInterpreter::collectGarbage()
+	{
+		// Marca os objetos alcancaveis pelas variaveis globais, pelos frames ativos
+		// e pelos valores temporarios da pilha.
+		for (auto& value : mGlobalList)
+		{
+			markValue(value);
+		}
+
+		for (const Value_s* value = mStack.data(); value < mTop; value++)
+		{
+			markValue(*value);
+		}
+		markValue(mReturnValue);
+
+		mObjectCount -= sweepObjectList(mObjectList);
+
+		mNextCollection = mObjectCount * 2 > initialCollectionThreshold
+			? mObjectCount * 2
+			: initialCollectionThreshold;
+	}
+
+	U32
+	AstInterpreter::getObjectCount()
+	{
+		return mObjectCount;
+	}
+
+	U64
+	AstInterpreter::getInlineCacheMissCount()
+	{
+		return mInlineCacheMissCount;
+	}
+
+	void
+	AstInterpreter::prepareClass(U32 classIndex)
+	{
+		auto& runtimeClass = mClassList[classIndex];
+
+		if (runtimeClass.classInfo != nullptr)
+		{
+			return;
+		}
+
+		auto classInfo = mProgram->getClass(classIndex);
+
+		// Os campos e metodos da classe base sao herdados.
+		if (classInfo->baseClassIndex != invalidIndex)
+		{
+			prepareClass(classInfo->baseClassIndex);
+
+			auto& baseClass = mClassList[classInfo->baseClassIndex];
+			runtimeClass.fieldCount = baseClass.fieldCount;
+			runtimeClass.fieldMap = baseClass.fieldMap;
+			runtimeClass.methodMap = baseClass.methodMap;
+		}
+
+		for (auto& field : classInfo->fieldList)
+		{
+			runtimeClass.fieldMap[field] = runtimeClass.fieldCount++;
+		}
+
+		for (auto& method : classInfo->methodList)
+		{
+			runtimeClass.methodMap[method.name] = method.functionIndex;
+		}
+		runtimeClass.classInfo = classInfo;
+	}
+
+	Value_s
+	AstInterpreter::invoke(U32 functionIndex, Value_s* const callBase, U32 argumentCount)
+	{
+		auto function = mProgram->getFunction(functionIndex);
+
+		if (argumentCount > function->parameterCount)
+		{
+			throwRuntimeError("Function '" + function->name + "' receives " + std::to_string(function->parameterCount) + " arguments");
+		}
+
+		if (mFrameList.size() >= maxCallDepth || callBase + function->frameSize > mStack.data() + mStack.size())
+		{
+			throwRuntimeError("Stack overflow calling '" + function->name + "'");
+		}
+
+		// Os argumentos ja estao nos primeiros slots do frame, os demais sao limpos
+		// para que a coleta nao encontre valores antigos.
+		const U32 argumentEnd = argumentCount + (function->isMethod ? 1 : 0);
+		for (U32 i = argumentEnd; i < function->frameSize; i++)
+		{
+			callBase[i] = makeNull();
+		}
+
+		mTop = callBase + (function->frameSize > argumentEnd ? function->frameSize : argumentEnd);
+		mFrameList.push_back(InterpreterFrame_s { function, callBase, 0 });
+
+		const Value_s result = runFunction(function);
+
+		mFrameList.pop_back();
+		mTop = callBase;
+		return result;
+	}
+
+	Value_s
+	AstInterpreter::runFunction(ScriptFunction_s* const function)
+	{
+		switch (function->type)
+		{
+		case FunctionType_e::Constructor:
+			// O construtor da classe base recebe os argumentos do super(...).
+			if (function->baseFunctionIndex != invalidIndex)
+			{
+				auto constructorDecl = function->decl->to<ast::ClassConstructorDecl>();
+				Value_s* const callBase = mTop;
+
+				push(getThis());
+				invoke(function->baseFunctionIndex, callBase, pushArguments(constructorDecl->superInitExpr.get()));
+			}
+			runInitializers(function);
+			break;
+		case FunctionType_e::ClassInit:
+			// Os campos da classe base sao inicializados primeiro.
+			if (function->baseFunctionIndex != invalidIndex)
+			{
+				Value_s* const callBase = mTop;
+
+				push(getThis());
+				invoke(function->baseFunctionIndex, callBase, 0);
+			}
+			runInitializers(function);
+			return makeNull();
+		case FunctionType_e::GlobalInit:
+			runInitializers(function);
+			return makeNull();
+		default:
+			break;
+		}
+
+		// Funcoes declaradas com '=' retornam o valor da expressao.
+		if (function->exprDecl)
+		{
+			mFrameList.back().line = function->exprDecl->line;
+			return eval(function->exprDecl);
+		}
+
+		if (function->blockDecl && execBlock(function->blockDecl) == Completion_e::Return)
+		{
+			const Value_s result = mReturnValue;
+			mReturnValue = makeNull();
+			return result;
+		}
+		return makeNull();
+	}
+
+	void
+	AstInterpreter::runInitializers(ScriptFunction_s* const function)
+	{
+		for (auto& initializer : function->initializerList)
+		{
+			FrameSlot* const frameSlot = getSlot(initializer.decl);
+			mFrameList.back().line = initializer.decl->line;
+
+			const Value_s value = initializer.initExpr
+				? eval(initializer.initExpr)
+				: makeNull();
+
+			if (frameSlot->getSlotType() == SlotType_e::Field)
+			{
+				static_cast<InstanceObject_s*>(getThis().object)->fieldList[frameSlot->getIndex()] = value;
+			}
+			else
+			{
+				mGlobalList[frameSlot->getIndex()] = value;
+			}
+		}
+	}
+
+	Completion_e
+	AstInterpreter::execBlock(ast::BlockDecl* const blockDecl)
+	{
+		for (auto& stmtDecl : blockDecl->stmtList)
+		{
+			const Completion_e completion = execStmt(stmtDecl.get());
+
+			if (completion != Completion_e::Normal)
+			{
+				return completion;
+			}
+		}
+		return Completion_e::Normal;
+	}
+
+	Completion_e
+	AstInterpreter::execStmt(ast::stmt::StmtDecl* const stmtDecl)
+	{
+		mFrameList.back().line = stmtDecl->line;
+
+		switch (stmtDecl->nodeType)
+		{
+		case AstNodeType_e::StmtExpr:
+			eval(stmtDecl->to<ast::stmt::StmtExprDecl>()->exprDecl.get());
+			return Completion_e::Normal;
+		case AstNodeType_e::StmtVariable:
+			{
+				auto variableDecl = stmtDecl->to<ast::stmt::StmtVariableDecl>();
+
+				const Value_s value = variableDecl->initExpr
+					? eval(variableDecl->initExpr.get())
+					: makeNull();
+
+				mFrameList.back().base[getSlot(variableDecl)->getIndex()] = value;
+			}
+			return Completion_e::Normal;
+		case AstNodeType_e::StmtIf:
+			{
+				auto ifDecl = stmtDecl->to<ast::stmt::StmtIfDecl>();
+
+				if (isTruthy(eval(ifDecl->conditionExprDecl.get())))
+				{
+					return execBlock(ifDecl->ifBlockDecl.get());
+				}
+
+				if (ifDecl->elseBlockDecl)
+				{
+					return execBlock(ifDecl->elseBlockDecl.get());
+				}
+			}
+			return Completion_e::Normal;
+		case AstNodeType_e::StmtWhile:
+			{
+				auto whileDecl = stmtDecl->to<ast::stmt::StmtWhileDecl>();
+
+				while (isTruthy(eval(whileDecl->conditionExprDecl.get())))
+				{
+					const Completion_e completion = execBlock(whileDecl->blockDecl.get());
+
+					if (completion == Completion_e::Break)
+					{
+						break;
+					}
+
+					if (completion == Completion_e::Return)
+					{
+						return completion;
+					}
+				}
+			}
+			return Completion_e::Normal;
+		case AstNodeType_e::StmtDoWhile:
+			{
+				auto doWhileDecl = stmtDecl->to<ast::stmt::StmtDoWhileDecl>();
+
+				do
+				{
+					const Completion_e completion = execBlock(doWhileDecl->blockDecl.get());
+
+					if (completion == Completion_e::Break)
+					{
+						break;
+					}
+
+					if (completion == Completion_e::Return)
+					{
+						return completion;
+					}
+				}
+				while (isTruthy(eval(doWhileDecl->conditionExprDecl.get())));
+			}
+			return Completion_e::Normal;
+		case AstNodeType_e::StmtFor:
+			{
+				auto forDecl = stmtDecl->to<ast::stmt::StmtForDecl>();
+
+				if (forDecl->initStmtDecl)
+				{
+					auto initStmtDecl = forDecl->initStmtDecl.get();
+					const Value_s value = eval(initStmtDecl->initExpr.get());
+
+					mFrameList.back().base[getSlot(initStmtDecl)->getIndex()] = value;
+				}
+				else if (forDecl->initExprDecl)
+				{
+					eval(forDecl->initExprDecl.get());
+				}
+
+				while (forDecl->conditionExprDecl == nullptr || isTruthy(eval(forDecl->conditionExprDecl.get())))
+				{
+					const Completion_e completion = execBlock(forDecl->blockDecl.get());
+
+					if (completion == Completion_e::Break)
+					{
+						break;
+					}
+
+					if (completion == Completion_e::Return)
+					{
+						return completion;
+					}
+
+					if (forDecl->updateExprDecl)
+					{
+						eval(forDecl->updateExprDecl.get());
+					}
+				}
+			}
+			return Completion_e::Normal;
+		case AstNodeType_e::StmtMatch:
+			{
+				auto matchDecl = stmtDecl->to<ast::stmt::StmtMatchDecl>();
+				Value_s* const mark = mTop;
+
+				const Value_s subject = eval(matchDecl->conditionExprDecl.get());
+				push(subject);
+
+				U32 armIndex = 0;
+				Bool matched = false;
+				selectArm(matchDecl, subject, armIndex, matched);
+
+				// Testa os padroes na ordem em que foram declarados a partir do
+				// braco selecionado pela tabela de saltos.
+				for (; armIndex < matchDecl->whenDeclList.size(); armIndex++, matched = false)
+				{
+					auto& whenDecl = matchDecl->whenDeclList[armIndex];
+
+					if (matched || matchPattern(whenDecl->patternDecl.get(), subject))
+					{
+						const Completion_e completion = execBlock(whenDecl->blockDecl.get());
+						mTop = mark;
+						return completion;
+					}
+				}
+				mTop = mark;
+			}
+			return Completion_e::Normal;
+		case AstNodeType_e::StmtReturn:
+			{
+				auto returnDecl = stmtDecl->to<ast::stmt::StmtReturnDecl>();
+
+				mReturnValue = returnDecl->exprDecl
+					? eval(returnDecl->exprDecl.get())
+					: makeNull();
+			}
+			return Completion_e::Return;
+		case AstNodeType_e::StmtContinue:
+			return Completion_e::Continue;
+		case AstNodeType_e::StmtBreak:
+			return Completion_e::Break;
+		case AstNodeType_e::StmtPanic:
+			throwRuntimeError("panic: " + toString(eval(stmtDecl->to<ast::stmt::StmtPanicDecl>()->exprDecl.get())));
+		default:
+			throwRuntimeError("Invalid statement");
+		}
+	}
+
+	Value_s
+	AstInterpreter::eval(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::ConstantBoolExpr:
+			return makeBool(exprDecl->to<ast::expr::ExpressionConstantBoolDecl>()->valueDecl);
+		case AstNodeType_e::ConstantIntegerExpr:
+			{
+				auto integerDecl = exprDecl->to<ast::expr::ExpressionConstantIntegerDecl>();
+				return makeInteger(toValueType(integerDecl->valueType), integerDecl->valueDecl);
+			}
+		case AstNodeType_e::ConstantRealExpr:
+			{
+				auto realDecl = exprDecl->to<ast::expr::ExpressionConstantRealDecl>();
+				return makeReal(toValueType(realDecl->valueType), realDecl->valueDecl);
+			}
+		case AstNodeType_e::ConstantStringExpr:
+			return mConstantList[getSlot(exprDecl)->getIndex()];
+		case AstNodeType_e::ConstantCharExpr:
+			return makeInteger(ValueType_e::I8, exprDecl->to<ast::expr::ExpressionConstantCharDecl>()->valueDecl);
+		case AstNodeType_e::ConstantNullExpr:
+			return makeNull();
+		case AstNodeType_e::ThisExpr:
+		case AstNodeType_e::SuperExpr:
+			return getThis();
+		case AstNodeType_e::IdentifierExpr:
+			return loadSlot(exprDecl);
+		case AstNodeType_e::BinaryExpr:
+			return evalBinary(exprDecl->to<ast::expr::ExpressionBinaryDecl>());
+		case AstNodeType_e::UnaryExpr:
+			return evalUnary(exprDecl->to<ast::expr::ExpressionUnaryDecl>());
+		case AstNodeType_e::TernaryExpr:
+			{
+				auto ternaryDecl = exprDecl->to<ast::expr::ExpressionTernaryDecl>();
+
+				return isTruthy(eval(ternaryDecl->conditionDecl.get()))
+					? eval(ternaryDecl->leftDecl.get())
+					: eval(ternaryDecl->rightDecl.get());
+			}
+		case AstNodeType_e::AsExpr:
+			{
+				auto asDecl = exprDecl->to<ast::expr::ExpressionAsDecl>();
+				const Value_s value = eval(asDecl->exprDecl.get());
+
+				if (asDecl->typeDecl->nodeType == AstNodeType_e::PrimitiveType)
+				{
+					const PrimitiveTypeID_e primitiveType = asDecl->typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType;
+
+					if (primitiveType == PrimitiveTypeID_e::String)
+					{
+						return value.type == ValueType_e::String ? value : makeString(toString(value));
+					}
+
+					Value_s result;
+					if (!computeCast(value, primitiveType, result))
+					{
+						throwRuntimeError(String("Invalid cast from ") + getValueTypeName(value.type) + " to " + getValueTypeName(toValueType(primitiveType)));
+					}
+					return result;
+				}
+
+				// Conversao para classe: nulo quando o objeto nao e uma instancia.
+				const U32 classIndex = asDecl->typeDecl->getAttribute<attributes::ResolvedType>()->getHandle();
+
+				return value.type == ValueType_e::Object && mProgram->isSubclassOf(static_cast<InstanceObject_s*>(value.object)->classIndex, classIndex)
+					? value
+					: makeNull();
+			}
+		case AstNodeType_e::IsExpr:
+			{
+				auto isDecl = exprDecl->to<ast::expr::ExpressionIsDecl>();
+				const Value_s value = eval(isDecl->exprDecl.get());
+
+				if (isDecl->typeDecl->nodeType == AstNodeType_e::PrimitiveType)
+				{
+					return makeBool(value.type == toValueType(isDecl->typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType));
+				}
+
+				const U32 classIndex = isDecl->typeDecl->getAttribute<attributes::ResolvedType>()->getHandle();
+
+				return makeBool(value.type == ValueType_e::Object && mProgram->isSubclassOf(static_cast<InstanceObject_s*>(value.object)->classIndex, classIndex));
+			}
+		case AstNodeType_e::FunctionCallExpr:
+			{
+				auto callDecl = exprDecl->to<ast::expr::ExpressionFunctionCall>();
+				return evalCall(callDecl->lhsDecl.get(), callDecl->rhsDecl.get());
+			}
+		case AstNodeType_e::GenericCallExpr:
+			{
+				auto genericCallDecl = exprDecl->to<ast::expr::ExpressionGenericCallDecl>();
+				return evalCall(genericCallDecl->lhsDecl.get(), genericCallDecl->rhsDecl.get());
+			}
+		case AstNodeType_e::IndexExpr:
+			{
+				auto indexDecl = exprDecl->to<ast::expr::ExpressionIndexDecl>();
+				Value_s* const mark = mTop;
+
+				const Value_s object = eval(indexDecl->lhsDecl.get());
+				push(object);
+
+				const Value_s index = eval(indexDecl->rhsDecl.get());
+				mTop = mark;
+
+				if (!isInteger(index.type))
+				{
+					throwRuntimeError("Index must be an integer");
+				}
+
+				if (object.type == ValueType_e::Array)
+				{
+					auto& elementList = static_cast<ArrayObject_s*>(object.object)->elementList;
+
+					if (static_cast<U64>(index.integerValue) >= elementList.size())
+					{
+						throwRuntimeError("Index " + std::to_string(index.integerValue) + " out of bounds");
+					}
+					return elementList[index.integerValue];
+				}
+
+				if (object.type == ValueType_e::String)
+				{
+					auto& value = static_cast<StringObject_s*>(object.object)->value;
+
+					if (static_cast<U64>(index.integerValue) >= value.size())
+					{
+						throwRuntimeError("Index " + std::to_string(index.integerValue) + " out of bounds");
+					}
+					return makeInteger(ValueType_e::I8, value[index.integerValue]);
+				}
+				throwRuntimeError("Index access on " + String(getValueTypeName(object.type)));
+			}
+		case AstNodeType_e::ArrayInitExpr:
+			{
+				Value_s* const first = mTop;
+
+				// Os elementos ficam na pilha ate a alocacao do array.
+				for (auto& elementDecl : exprDecl->to<ast::expr::ExpressionArrayInitDecl>()->arrayElementDeclList)
+				{
+					push(eval(elementDecl.get()));
+				}
+
+				auto array = allocate<ArrayObject_s>();
+				array->elementList.assign(first, mTop);
+
+				mTop = first;
+				return makeObject(array);
+			}
+		case AstNodeType_e::NewExpr:
+			return evalNew(exprDecl->to<ast::expr::ExpressionNewDecl>());
+		case AstNodeType_e::MatchExpr:
+			{
+				auto matchDecl = exprDecl->to<ast::expr::ExpressionMatchDecl>();
+				Value_s* const mark = mTop;
+
+				const Value_s subject = eval(matchDecl->exprDecl.get());
+				push(subject);
+
+				U32 armIndex = 0;
+				Bool matched = false;
+				selectArm(matchDecl, subject, armIndex, matched);
+
+				for (; armIndex < matchDecl->whenDeclList.size(); armIndex++, matched = false)
+				{
+					auto& whenDecl = matchDecl->whenDeclList[armIndex];
+
+					if (matched || matchPattern(whenDecl->patternDecl.get(), subject))
+					{
+						const Value_s result = eval(whenDecl->exprDecl.get());
+						mTop = mark;
+						return result;
+					}
+				}
+
+				// Nenhum padrao correspondeu.
+				mTop = mark;
+				return makeNull();
+			}
+		default:
+			throwRuntimeError("Invalid expression");
+		}
+	}
+
+	Value_s
+	AstInterpreter::evalBinary(ast::expr::ExpressionBinaryDecl* const binaryDecl)
+	{
+		switch (binaryDecl->op)
+		{
+		case TokenType_e::ScopeResolution:
+			return loadSlot(binaryDecl);
+		case TokenType_e::Dot:
+		case TokenType_e::SafeDot:
+			{
+				const Value_s object = eval(binaryDecl->leftDecl.get());
+
+				// Acesso seguro: o resultado e nulo quando o objeto e nulo.
+				if (binaryDecl->op == TokenType_e::SafeDot && object.type == ValueType_e::Null)
+				{
+					return object;
+				}
+
+				auto instance = getInstance(object, "Field access");
+				auto rightDecl = binaryDecl->rightDecl.get();
+
+				return instance->fieldList[getFieldIndex(getSlot(rightDecl), instance, getIdentifier(rightDecl->identifier))];
+			}
+		case TokenType_e::Assign:
+			return evalAssign(binaryDecl->leftDecl.get(), binaryDecl->rightDecl.get(), OpCode_e::Nop, false);
+		case TokenType_e::LogicalAnd:
+			{
+				// Avaliacao em curto-circuito, o resultado e o valor do operando.
+				const Value_s lhs = eval(binaryDecl->leftDecl.get());
+				return isTruthy(lhs) ? eval(binaryDecl->rightDecl.get()) : lhs;
+			}
+		case TokenType_e::LogicalOr:
+			{
+				const Value_s lhs = eval(binaryDecl->leftDecl.get());
+				return isTruthy(lhs) ? lhs : eval(binaryDecl->rightDecl.get());
+			}
+		case TokenType_e::Comma:
+			eval(binaryDecl->leftDecl.get());
+			return eval(binaryDecl->rightDecl.get());
+		default:
+			break;
+		}
+
+		const OpCode_e op = codegen::getBinaryOpCode(binaryDecl->op);
+
+		if (codegen::isCompoundAssign(binaryDecl->op))
+		{
+			return evalAssign(binaryDecl->leftDecl.get(), binaryDecl->rightDecl.get(), op, false);
+		}
+
+		Value_s* const mark = mTop;
+
+		// O operando esquerdo fica na pilha enquanto o direito e avaliado, que pode alocar.
+		const Value_s lhs = eval(binaryDecl->leftDecl.get());
+		if (isHeapObject(lhs.type))
+		{
+			push(lhs);
+		}
+
+		const Value_s rhs = eval(binaryDecl->rightDecl.get());
+		mTop = mark;
+
+		// Caminho rapido para inteiros de 32 bits.
+		if (lhs.type == ValueType_e::I32 && rhs.type == ValueType_e::I32)
+		{
+			const I64 a = lhs.integerValue;
+			const I64 b = rhs.integerValue;
+
+			switch (op)
+			{
+			case OpCode_e::Add:				return makeI32(a + b);
+			case OpCode_e::Sub:				return makeI32(a - b);
+			case OpCode_e::Mul:				return makeI32(a * b);
+			case OpCode_e::BitAnd:			return makeI32(a & b);
+			case OpCode_e::BitOr:			return makeI32(a | b);
+			case OpCode_e::BitXor:			return makeI32(a ^ b);
+			case OpCode_e::Equal:			return makeBool(a == b);
+			case OpCode_e::NotEqual:		return makeBool(a != b);
+			case OpCode_e::Less:			return makeBool(a < b);
+			case OpCode_e::LessEqual:		return makeBool(a <= b);
+			case OpCode_e::Greater:			return makeBool(a > b);
+			case OpCode_e::GreaterEqual:	return makeBool(a >= b);
+			case OpCode_e::Div:
+				if (b != 0)
+				{
+					return makeI32(a / b);
+				}
+				break;
+			case OpCode_e::Mod:
+				if (b != 0)
+				{
+					return makeI32(a % b);
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		switch (op)
+		{
+		case OpCode_e::Equal:
+		case OpCode_e::NotEqual:
+		case OpCode_e::Less:
+		case OpCode_e::LessEqual:
+		case OpCode_e::Greater:
+		case OpCode_e::GreaterEqual:
+			return executeComparison(op, lhs, rhs);
+		default:
+			return executeArithmetic(op, lhs, rhs);
+		}
+	}
+
+	Value_s
+	AstInterpreter::evalUnary(ast::expr::ExpressionUnaryDecl* const unaryDecl)
+	{
+		switch (unaryDecl->op)
+		{
+		case TokenType_e::Increment:
+		case TokenType_e::Decrement:
+			return evalAssign(
+				unaryDecl->exprDecl.get(),
+				nullptr,
+				unaryDecl->op == TokenType_e::Increment ? OpCode_e::Add : OpCode_e::Sub,
+				unaryDecl->unaryType == ExpressionUnaryType_e::Posfix
+			);
+		case TokenType_e::Minus:
+			{
+				const Value_s value = eval(unaryDecl->exprDecl.get());
+
+				if (isInteger(value.type))
+				{
+					return makeInteger(value.type, static_cast<I64>(0 - static_cast<U64>(value.integerValue)));
+				}
+
+				if (isReal(value.type))
+				{
+					return makeReal(value.type, -value.realValue);
+				}
+				throwRuntimeError("Invalid operand for 'neg'");
+			}
+		case TokenType_e::BitWiseNot:
+			{
+				const Value_s value = eval(unaryDecl->exprDecl.get());
+
+				if (!isInteger(value.type))
+				{
+					throwRuntimeError("Invalid operand for 'bitnot'");
+				}
+				return makeInteger(value.type, ~value.integerValue);
+			}
+		case TokenType_e::LogicalNot:
+			return makeBool(!isTruthy(eval(unaryDecl->exprDecl.get())));
+		default:
+			// 'ref' e 'shared' restringem a posse mas nao mudam o valor.
+			return eval(unaryDecl->exprDecl.get());
+		}
+	}
+
+	Value_s
+	AstInterpreter::evalCall(ast::expr::ExpressionDecl* const lhsDecl, ast::expr::ExpressionDecl* const argumentsDecl)
+	{
+		auto binaryDecl = lhsDecl->nodeType == AstNodeType_e::BinaryExpr
+			? lhsDecl->to<ast::expr::ExpressionBinaryDecl>()
+			: nullptr;
+
+		Value_s* const callBase = mTop;
+
+		// Chamada de metodo: o objeto ocupa o slot 0 do frame chamado.
+		if (binaryDecl && (binaryDecl->op == TokenType_e::Dot || binaryDecl->op == TokenType_e::SafeDot))
+		{
+			auto rightDecl = binaryDecl->rightDecl.get();
+			FrameSlot* const frameSlot = getSlot(rightDecl);
+
+			if (frameSlot->getSlotType() == SlotType_e::Function)
+			{
+				// super.metodo()
+				push(getThis());
+				return invoke(frameSlot->getIndex(), callBase, pushArguments(argumentsDecl));
+			}
+
+			const Value_s object = eval(binaryDecl->leftDecl.get());
+
+			if (binaryDecl->op == TokenType_e::SafeDot && object.type == ValueType_e::Null)
+			{
+				return object;
+			}
+
+			auto instance = getInstance(object, "Method call");
+			const U32 functionIndex = getMethodIndex(frameSlot, instance, getIdentifier(rightDecl->identifier));
+
+			push(object);
+			return invoke(functionIndex, callBase, pushArguments(argumentsDecl));
+		}
+
+		FrameSlot* const frameSlot = getSlot(lhsDecl);
+
+		if (frameSlot != nullptr)
+		{
+			switch (frameSlot->getSlotType())
+			{
+			case SlotType_e::Function:
+				// Chamada direta de uma funcao conhecida ou do construtor base.
+				if (lhsDecl->nodeType == AstNodeType_e::SuperExpr)
+				{
+					push(getThis());
+				}
+				return invoke(frameSlot->getIndex(), callBase, pushArguments(argumentsDecl));
+			case SlotType_e::Method:
+				{
+					// Metodo da propria classe chamado sem 'this'.
+					const Value_s object = getThis();
+					const String methodName = binaryDecl
+						? getIdentifier(binaryDecl->rightDecl->identifier)
+						: getIdentifier(lhsDecl->identifier);
+
+					const U32 functionIndex = getMethodIndex(frameSlot, getInstance(object, "Method call"), methodName);
+
+					push(object);
+					return invoke(functionIndex, callBase, pushArguments(argumentsDecl));
+				}
+			default:
+				break;
+			}
+		}
+
+		// Valor chamavel em tempo de execucao.
+		const Value_s callee = eval(lhsDecl);
+
+		if (callee.type != ValueType_e::Function)
+		{
+			throwRuntimeError("Call on " + String(getValueTypeName(callee.type)));
+		}
+		return invoke(callee.functionIndex, callBase, pushArguments(argumentsDecl));
+	}
+
+	Value_s
+	AstInterpreter::evalNew(ast::expr::ExpressionNewDecl* const newDecl)
+	{
+		const U32 classIndex = newDecl->objTypeDecl->getAttribute<attributes::ResolvedType>()->getHandle();
+		auto& runtimeClass = mClassList[classIndex];
+
+		auto instance = allocate<InstanceObject_s>(classIndex, runtimeClass.fieldCount);
+		const Value_s object = makeObject(instance);
+
+		Value_s* const mark = mTop;
+		push(object);
+
+		// Inicializa os campos com as expressoes declaradas na classe.
+		if (runtimeClass.classInfo->initFunctionIndex != invalidIndex)
+		{
+			Value_s* const callBase = mTop;
+
+			push(object);
+			invoke(runtimeClass.classInfo->initFunctionIndex, callBase, 0);
+		}
+
+		const U32 constructorIndex = getSlot(newDecl)->getIndex();
+
+		if (constructorIndex != invalidIndex)
+		{
+			Value_s* const callBase = mTop;
+
+			push(object);
+			invoke(constructorIndex, callBase, pushArguments(newDecl->exprDecl.get()));
+		}
+
+		// Bloco de inicializacao: new Foo { a: 1, b }
+		if (newDecl->objInitBlockDecl)
+		{
+			for (auto& itemDecl : newDecl->objInitBlockDecl->itemDeclList)
+			{
+				const Value_s value = eval(itemDecl->exprDecl.get());
+				instance->fieldList[getSlot(itemDecl.get())->getIndex()] = value;
+			}
+		}
+
+		mTop = mark;
+		return object;
+	}
+
+	Value_s
+	AstInterpreter::evalAssign(ast::expr::ExpressionDecl* const targetDecl, ast::expr::ExpressionDecl* const valueDecl, OpCode_e op, Bool postfix)
+	{
+		Value_s* const mark = mTop;
+
+		if (targetDecl->nodeType == AstNodeType_e::IndexExpr)
+		{
+			auto indexDecl = targetDecl->to<ast::expr::ExpressionIndexDecl>();
+
+			const Value_s object = eval(indexDecl->lhsDecl.get());
+			push(object);
+
+			const Value_s index = eval(indexDecl->rhsDecl.get());
+
+			if (object.type != ValueType_e::Array)
+			{
+				throwRuntimeError("Index assignment on " + String(getValueTypeName(object.type)));
+			}
+
+			if (!isInteger(index.type))
+			{
+				throwRuntimeError("Index must be an integer");
+			}
+
+			auto& elementList = static_cast<ArrayObject_s*>(object.object)->elementList;
+
+			if (static_cast<U64>(index.integerValue) >= elementList.size())
+			{
+				throwRuntimeError("Index " + std::to_string(index.integerValue) + " out of bounds");
+			}
+
+			const Value_s current = elementList[index.integerValue];
+			const Value_s rhs = valueDecl ? eval(valueDecl) : makeI32(1);
+			const Value_s result = op == OpCode_e::Nop ? rhs : executeArithmetic(op, current, rhs);
+
+			elementList[index.integerValue] = result;
+
+			mTop = mark;
+			return postfix ? current : result;
+		}
+
+		if (targetDecl->nodeType == AstNodeType_e::BinaryExpr && targetDecl->to<ast::expr::ExpressionBinaryDecl>()->op == TokenType_e::Dot)
+		{
+			auto binaryDecl = targetDecl->to<ast::expr::ExpressionBinaryDecl>();
+			auto rightDecl = binaryDecl->rightDecl.get();
+
+			const Value_s object = eval(binaryDecl->leftDecl.get());
+			push(object);
+
+			auto instance = getInstance(object, "Field access");
+			const U32 fieldIndex = getFieldIndex(getSlot(rightDecl), instance, getIdentifier(rightDecl->identifier));
+
+			const Value_s current = instance->fieldList[fieldIndex];
+			const Value_s rhs = valueDecl ? eval(valueDecl) : makeI32(1);
+			const Value_s result = op == OpCode_e::Nop ? rhs : executeArithmetic(op, current, rhs);
+
+			instance->fieldList[fieldIndex] = result;
+
+			mTop = mark;
+			return postfix ? current : result;
+		}
+
+		// Variavel local, campo do 'this' ou variavel global.
+		if (op == OpCode_e::Nop)
+		{
+			const Value_s value = eval(valueDecl);
+			storeSlot(targetDecl, value);
+			return value;
+		}
+
+		const Value_s current = loadSlot(targetDecl);
+		if (isHeapObject(current.type))
+		{
+			push(current);
+		}
+
+		const Value_s rhs = valueDecl ? eval(valueDecl) : makeI32(1);
+		const Value_s result = executeArithmetic(op, current, rhs);
+
+		storeSlot(targetDecl, result);
+
+		mTop = mark;
+		return postfix ? current : result;
+	}
+
+	Value_s
+	AstInterpreter::loadSlot(ast::AstNode* const node)
+	{
+		FrameSlot* const frameSlot = getSlot(node);
+
+		switch (frameSlot->getSlotType())
+		{
+		case SlotType_e::Local:
+			return mFrameList.back().base[frameSlot->getIndex()];
+		case SlotType_e::Field:
+			return static_cast<InstanceObject_s*>(getThis().object)->fieldList[frameSlot->getIndex()];
+		case SlotType_e::Global:
+			return mGlobalList[frameSlot->getIndex()];
+		case SlotType_e::Function:
+			return makeFunction(frameSlot->getIndex());
+		case SlotType_e::EnumItem:
+			return makeInteger(ValueType_e::I32, frameSlot->getValue());
+		case SlotType_e::Constant:
+			return mConstantList[frameSlot->getIndex()];
+		default:
+			throwRuntimeError("Invalid slot for '" + getIdentifier(node->identifier) + "'");
+		}
+	}
+
+	void
+	AstInterpreter::storeSlot(ast::AstNode* const node, const Value_s& value)
+	{
+		FrameSlot* const frameSlot = getSlot(node);
+
+		switch (frameSlot->getSlotType())
+		{
+		case SlotType_e::Local:
+			mFrameList.back().base[frameSlot->getIndex()] = value;
+			break;
+		case SlotType_e::Field:
+			static_cast<InstanceObject_s*>(getThis().object)->fieldList[frameSlot->getIndex()] = value;
+			break;
+		case SlotType_e::Global:
+			mGlobalList[frameSlot->getIndex()] = value;
+			break;
+		default:
+			throwRuntimeError("Invalid assignment target");
+		}
+	}
+
+	Bool
+	AstInterpreter::matchPattern(ast::pattern::PatternDecl* const patternDecl, const Value_s& subject)
+	{
+		auto literalPatternDecl = patternDecl->to<ast::pattern::LiteralPatternDecl>();
+
+		if (literalPatternDecl->literalExpr)
+		{
+			return isEqual(subject, eval(literalPatternDecl->literalExpr.get()));
+		}
+
+		FrameSlot* const frameSlot = getSlot(patternDecl);
+
+		// '_' aceita qualquer valor.
+		if (frameSlot == nullptr)
+		{
+			return true;
+		}
+
+		switch (frameSlot->getSlotType())
+		{
+		case SlotType_e::Local:
+			// Captura o valor em uma nova variavel.
+			mFrameList.back().base[frameSlot->getIndex()] = subject;
+			return true;
+		case SlotType_e::EnumItem:
+			return isEqual(subject, makeInteger(ValueType_e::I32, frameSlot->getValue()));
+		default:
+			return isEqual(subject, loadSlot(patternDecl));
+		}
+	}
+
+	match::PatternInfo_s
+	AstInterpreter::resolve(ast::pattern::PatternDecl* const patternDecl)
+	{
+		match::PatternInfo_s info { match::PatternKind_e::Dynamic, makeNull(), String(), nullptr, 0, 0 };
+
+		auto literalPatternDecl = patternDecl->to<ast::pattern::LiteralPatternDecl>();
+		auto literalExpr = literalPatternDecl->literalExpr.get();
+
+		if (literalExpr && match::getLiteralValue(literalExpr, info.value))
+		{
+			info.kind = match::PatternKind_e::Constant;
+			return info;
+		}
+
+		// Caminhos 'a::b' recebem o slot na expressao, nomes simples no padrao.
+		FrameSlot* const frameSlot = getSlot(literalExpr ? static_cast<ast::AstNode*>(literalExpr) : patternDecl);
+
+		if (frameSlot == nullptr)
+		{
+			if (literalExpr == nullptr)
+			{
+				info.kind = match::PatternKind_e::Wildcard;
+			}
+			return info;
+		}
+
+		switch (frameSlot->getSlotType())
+		{
+		case SlotType_e::Local:
+			if (literalExpr == nullptr)
+			{
+				info.kind = match::PatternKind_e::Wildcard;
+			}
+			break;
+		case SlotType_e::EnumItem:
+			info.kind = match::PatternKind_e::Constant;
+			info.value = makeInteger(ValueType_e::I32, frameSlot->getValue());
+			break;
+		default:
+			break;
+		}
+		return info;
+	}
+
+	String
+	AstInterpreter::getItemName(const void* const, U32)
+	{
+		return "_";
+	}
+
+	const match::JumpTable_s*
+	AstInterpreter::findJumpTable(ast::AstNode* const matchDecl)
+	{
+		auto it = mJumpTableMap.find(matchDecl);
+
+		if (it != mJumpTableMap.end())
+		{
+			return it->second.get();
+		}
+
+		std::vector<ast::pattern::PatternDecl*> patternList;
+
+		if (matchDecl->nodeType == AstNodeType_e::StmtMatch)
+		{
+			for (auto& whenDecl : matchDecl->to<ast::stmt::StmtMatchDecl>()->whenDeclList)
+			{
+				patternList.push_back(whenDecl->patternDecl.get());
+			}
+		}
+		else
+		{
+			for (auto& whenDecl : matchDecl->to<ast::expr::ExpressionMatchDecl>()->whenDeclList)
+			{
+				patternList.push_back(whenDecl->patternDecl.get());
+			}
+		}
+
+		std::unique_ptr<match::JumpTable_s> jumpTable;
+
+		if (patternList.size() >= match::minJumpTableCaseCount)
+		{
+			match::MatchCompiler matchCompiler(this);
+			auto decisionTree = matchCompiler.compile(patternList);
+
+			jumpTable = std::make_unique<match::JumpTable_s>();
+			if (!decisionTree->buildJumpTable(*jumpTable, match::minJumpTableCaseCount))
+			{
+				jumpTable.reset();
+			}
+		}
+		return (mJumpTableMap[matchDecl] = std::move(jumpTable)).get();
+	}
+
+	void
+	AstInterpreter::selectArm(ast::AstNode* const matchDecl, const Value_s& subject, U32& armIndex, Bool& matched)
+	{
+		armIndex = 0;
+		matched = false;
+
+		// Valores que nao sao inteiros testam todos os bracos.
+		if (!isInteger(subject.type))
+		{
+			return;
+		}
+
+		const match::JumpTable_s* const jumpTable = findJumpTable(matchDecl);
+
+		if (jumpTable == nullptr)
+		{
+			return;
+		}
+
+		auto it = jumpTable->targetMap.find(subject.integerValue);
+		const match::JumpTarget_s& jumpTarget = it != jumpTable->targetMap.end()
+			? it->second
+			: jumpTable->defaultTarget;
+
+		armIndex = jumpTarget.armIndex;
+		matched = jumpTarget.matched;
+	}
+
+	U32
+	AstInterpreter::pushArguments(ast::expr::ExpressionDecl* const argumentsDecl)
+	{
+		if (argumentsDecl == nullptr)
+		{
+			return 0;
+		}
+
+		// Os argumentos chegam como uma cadeia de operadores ','.
+		if (argumentsDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = argumentsDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op == TokenType_e::Comma)
+			{
+				const U32 argumentCount = pushArguments(binaryDecl->leftDecl.get());
+				return argumentCount + pushArguments(binaryDecl->rightDecl.get());
+			}
+		}
+
+		push(eval(argumentsDecl));
+		return 1;
+	}
+
+	Value_s
+	AstInterpreter::executeArithmetic(OpCode_e op, const Value_s& lhs, const Value_s& rhs)
+	{
+		// Concatenacao de strings.
+		if (op == OpCode_e::Add && (lhs.type == ValueType_e::String || rhs.type == ValueType_e::String))
+		{
+			return makeString(toString(lhs) + toString(rhs));
+		}
+
+		Value_s result;
+		switch (computeArithmetic(op, lhs, rhs, result))
+		{
+		case OperationStatus_e::Success:
+			return result;
+		case OperationStatus_e::DivisionByZero:
+			throwRuntimeError("Division by zero");
+		default:
+			throwRuntimeError(
+				String("Invalid operands for '") + codegen::getOpCodeName(op) + "': " + getValueTypeName(lhs.type) + " and " + getValueTypeName(rhs.type)
+			);
+		}
+	}
+
+	Value_s
+	AstInterpreter::executeComparison(OpCode_e op, const Value_s& lhs, const Value_s& rhs)
+	{
+		Value_s result;
+		if (computeComparison(op, lhs, rhs, result) != OperationStatus_e::Success)
+		{
+			throwRuntimeError(
+				String("Invalid operands for '") + codegen::getOpCodeName(op) + "': " + getValueTypeName(lhs.type) + " and " + getValueTypeName(rhs.type)
+			);
+		}
+		return result;
+	}
+
+	InstanceObject_s*
+	AstInterpreter::getInstance(const Value_s& value, const I8* operation)
+	{
+		if (value.type != ValueType_e::Object)
+		{
+			throwRuntimeError(String(operation) + " on " + getValueTypeName(value.type));
+		}
+		return static_cast<InstanceObject_s*>(value.object);
+	}
+
+	U32
+	AstInterpreter::getFieldIndex(FrameSlot* const frameSlot, InstanceObject_s* const instance, const String& fieldName)
+	{
+		if (frameSlot->hitCache(instance->classIndex))
+		{
+			return frameSlot->getIndex();
+		}
+		mInlineCacheMissCount++;
+
+		auto& runtimeClass = mClassList[instance->classIndex];
+		auto it = runtimeClass.fieldMap.find(fieldName);
+
+		if (it == runtimeClass.fieldMap.end())
+		{
+			throwRuntimeError("Field '" + fieldName + "' not found in '" + runtimeClass.classInfo->name + "'");
+		}
+
+		frameSlot->updateCache(instance->classIndex, it->second);
+		return it->second;
+	}
+
+	U32
+	AstInterpreter::getMethodIndex(FrameSlot* const frameSlot, InstanceObject_s* const instance, const String& methodName)
+	{
+		if (frameSlot->hitCache(instance->classIndex))
+		{
+			return frameSlot->getIndex();
+		}
+		mInlineCacheMissCount++;
+
+		auto& runtimeClass = mClassList[instance->classIndex];
+		auto it = runtimeClass.methodMap.find(methodName);
+
+		if (it == runtimeClass.methodMap.end())
+		{
+			throwRuntimeError("Method '" + methodName + "' not found in '" + runtimeClass.classInfo->name + "'");
+		}
+
+		frameSlot->updateCache(instance->classIndex, it->second);
+		return it->second;
+	}
+
+	Value_s&
+	AstInterpreter::getThis()
+	{
+		return mFrameList.back().base[0];
+	}
+
+	void
+	AstInterpreter::push(const Value_s& value)
+	{
+		if (mTop == mStack.data() + mStack.size())
+		{
+			throwRuntimeError("Stack overflow");
+		}
+		*mTop++ = value;
+	}
+
+	template <typename TObject, typename... TArgs>
+	TObject*
+	AstInterpreter::allocate(TArgs&&... args)
+	{
+		if (mObjectCount >= mNextCollection)
+		{
+			collectGarbage();
+		}
+
+		TObject* const object = new TObject(std::forward<TArgs>(args)...);
+		object->next = mObjectList;
+		mObjectList = object;
+		mObjectCount++;
+		return object;
+	}
+
+	void
+	AstInterpreter::throwRuntimeError(const String& message)
+	{
+		if (mFrameList.empty())
+		{
+			throw exceptions::custom_exception(
+				"Runtime error: %s",
+				message.c_str()
+			);
+		}
+
+		auto& frame = mFrameList.back();
+
+		throw exceptions::custom_exception(
+			"Runtime error: %s in '%s' at line %d",
+			message.c_str(),
+			frame.function->name.c_str(),
+			frame.line
+		);
+	}
+} }
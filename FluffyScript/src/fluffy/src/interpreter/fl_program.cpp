@@ -0,0 +1,260 @@
+#include "interpreter/fl_program.h"
+#include "fl_exceptions.h"
+namespace fluffy { namespace interpreter {
+	/**
+	 * Program
+	 */
+
+	Program::Program()
+	{}
+
+	Program::~Program()
+	{}
+
+	U32
+	Program::insertFunction(const String& name, FunctionType_e type)
+	{
+		if (mFunctionMap.find(name) != mFunctionMap.end())
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' already declared",
+				name.c_str()
+			);
+		}
+
+		auto function = std::make_unique<ScriptFunction_s>();
+		function->name = name;
+		function->type = type;
+		function->isMethod = type != FunctionType_e::Function && type != FunctionType_e::GlobalInit;
+		function->parameterCount = 0;
+		function->frameSize = 0;
+		function->classIndex = invalidIndex;
+		function->baseFunctionIndex = invalidIndex;
+		function->decl = nullptr;
+		function->blockDecl = nullptr;
+		function->exprDecl = nullptr;
+
+		const U32 functionIndex = static_cast<U32>(mFunctionList.size());
+		mFunctionList.push_back(std::move(function));
+		mFunctionMap.emplace(name, functionIndex);
+		return functionIndex;
+	}
+
+	U32
+	Program::findFunction(const String& name)
+	{
+		auto it = mFunctionMap.find(name);
+		return it != mFunctionMap.end() ? it->second : invalidIndex;
+	}
+
+	U32
+	Program::insertGlobal(const String& name)
+	{
+		auto it = mGlobalMap.find(name);
+		if (it != mGlobalMap.end())
+		{
+			return it->second;
+		}
+
+		const U32 globalIndex = static_cast<U32>(mGlobalList.size());
+		mGlobalList.push_back(name);
+		mGlobalMap.emplace(name, globalIndex);
+		return globalIndex;
+	}
+
+	U32
+	Program::findGlobal(const String& name)
+	{
+		auto it = mGlobalMap.find(name);
+		return it != mGlobalMap.end() ? it->second : invalidIndex;
+	}
+
+	U32
+	Program::insertClass(const String& name)
+	{
+		if (mClassMap.find(name) != mClassMap.end())
+		{
+			throw exceptions::custom_exception(
+				"Class '%s' already declared",
+				name.c_str()
+			);
+		}
+
+		auto classInfo = std::make_unique<ScriptClass_s>();
+		classInfo->name = name;
+		classInfo->baseClassIndex = invalidIndex;
+		classInfo->initFunctionIndex = invalidIndex;
+
+		const U32 classIndex = static_cast<U32>(mClassList.size());
+		mClassList.push_back(std::move(classInfo));
+		mClassMap.emplace(name, classIndex);
+		return classIndex;
+	}
+
+	U32
+	Program::findClass(const String& name)
+	{
+		auto it = mClassMap.find(name);
+		return it != mClassMap.end() ? it->second : invalidIndex;
+	}
+
+	U32
+	Program::findMethod(U32 classIndex, const String& name)
+	{
+		// Procura o metodo na classe e depois nas classes base.
+		while (classIndex != invalidIndex)
+		{
+			auto classInfo = mClassList[classIndex].get();
+
+			for (auto& method : classInfo->methodList)
+			{
+				if (method.name == name)
+				{
+					return method.functionIndex;
+				}
+			}
+			classIndex = classInfo->baseClassIndex;
+		}
+		return invalidIndex;
+	}
+
+	U32
+	Program::findField(U32 classIndex, const String& name)
+	{
+		// Campos da classe derivada escondem os campos da base com o mesmo nome.
+		while (classIndex != invalidIndex)
+		{
+			auto classInfo = mClassList[classIndex].get();
+
+			for (U32 i = 0; i < classInfo->fieldList.size(); i++)
+			{
+				if (classInfo->fieldList[i] == name)
+				{
+					return getFieldCount(classInfo->baseClassIndex) + i;
+				}
+			}
+			classIndex = classInfo->baseClassIndex;
+		}
+		return invalidIndex;
+	}
+
+	U32
+	Program::getFieldCount(U32 classIndex)
+	{
+		U32 fieldCount = 0;
+
+		while (classIndex != invalidIndex)
+		{
+			fieldCount += static_cast<U32>(mClassList[classIndex]->fieldList.size());
+			classIndex = mClassList[classIndex]->baseClassIndex;
+		}
+		return fieldCount;
+	}
+
+	Bool
+	Program::isSubclassOf(U32 classIndex, U32 baseClassIndex)
+	{
+		while (classIndex != invalidIndex)
+		{
+			if (classIndex == baseClassIndex)
+			{
+				return true;
+			}
+			classIndex = mClassList[classIndex]->baseClassIndex;
+		}
+		return false;
+	}
+
+	void
+	Program::insertEnumItem(const String& name, I64 value)
+	{
+		mEnumItemMap[name] = value;
+	}
+
+	Bool
+	Program::findEnumItem(const String& name, I64& value)
+	{
+		auto it = mEnumItemMap.find(name);
+		if (it == mEnumItemMap.end())
+		{
+			return false;
+		}
+		value = it->second;
+		return true;
+	}
+
+	U32
+	Program::insertStringConstant(const String& value)
+	{
+		auto it = mStringConstantMap.find(value);
+		if (it != mStringConstantMap.end())
+		{
+			return it->second;
+		}
+
+		const U32 constantIndex = static_cast<U32>(mStringConstantList.size());
+		mStringConstantList.push_back(value);
+		mStringConstantMap.emplace(value, constantIndex);
+		return constantIndex;
+	}
+
+	const String&
+	Program::getStringConstant(U32 constantIndex)
+	{
+		return mStringConstantList[constantIndex];
+	}
+
+	void
+	Program::insertInitFunction(U32 functionIndex)
+	{
+		mInitFunctionList.push_back(functionIndex);
+	}
+
+	ScriptFunction_s* const
+	Program::getFunction(U32 functionIndex)
+	{
+		return mFunctionList[functionIndex].get();
+	}
+
+	ScriptClass_s* const
+	Program::getClass(U32 classIndex)
+	{
+		return mClassList[classIndex].get();
+	}
+
+	const String&
+	Program::getGlobalName(U32 globalIndex)
+	{
+		return mGlobalList[globalIndex];
+	}
+
+	U32
+	Program::getFunctionCount()
+	{
+		return static_cast<U32>(mFunctionList.size());
+	}
+
+	U32
+	Program::getClassCount()
+	{
+		return static_cast<U32>(mClassList.size());
+	}
+
+	U32
+	Program::getGlobalCount()
+	{
+		return static_cast<U32>(mGlobalList.size());
+	}
+
+	U32
+	Program::getStringConstantCount()
+	{
+		return static_cast<U32>(mStringConstantList.size());
+	}
+
+	const std::vector<U32>&
+	Program::getInitFunctionList()
+	{
+		return mInitFunctionList;
+	}
+} }
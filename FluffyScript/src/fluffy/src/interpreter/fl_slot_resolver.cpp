@@ -0,0 +1,1625 @@
+#include <string>
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_type.h"
+#include "attributes/fl_resolved_type.h"
+#include "codegen/fl_bytecode.h"
+#include "interpreter/fl_slot_resolver.h"
+#include "fl_exceptions.h"
+namespace fluffy { namespace interpreter {
+	using attributes::SlotType_e;
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static String
+	toString(const TString& identifier)
+	{
+		return identifier.str() != nullptr ? String(identifier.str()) : String();
+	}
+
+	static String
+	joinPath(const String& scopePath, const String& identifier)
+	{
+		return scopePath.size() ? scopePath + "::" + identifier : identifier;
+	}
+
+	/**
+	 * SlotResolver
+	 */
+
+	SlotResolver::SlotResolver()
+		: mProgram(new Program())
+		, mCodeUnit(nullptr)
+		, mFunction(nullptr)
+	{}
+
+	SlotResolver::~SlotResolver()
+	{}
+
+	void
+	SlotResolver::onProcess(scope::ScopeManager* const, const scope::NodeProcessorEvent_e event, ast::AstNode* const node)
+	{
+		if (event == scope::NodeProcessorEvent_e::onBegin)
+		{
+			switch (node->nodeType)
+			{
+			case AstNodeType_e::CodeUnit:
+				beginCodeUnit(node->to<ast::CodeUnit>());
+				break;
+			case AstNodeType_e::NamespaceDecl:
+			case AstNodeType_e::TraitDecl:
+				pushScope(joinPath(mScopeStack.back().path, toString(node->identifier)), invalidIndex);
+				break;
+			case AstNodeType_e::ClassDecl:
+				beginClass(node->to<ast::ClassDecl>());
+				break;
+			case AstNodeType_e::StructDecl:
+				resolveStructInit(node->to<ast::StructDecl>());
+				break;
+			case AstNodeType_e::TraitForDecl:
+				beginTraitFor(node->to<ast::TraitForDecl>());
+				break;
+			case AstNodeType_e::FunctionDecl:
+				{
+					auto functionDecl = node->to<ast::FunctionDecl>();
+					resolveFunctionBody(mFunctionIndexMap.at(functionDecl), functionDecl, functionDecl->parameterList, functionDecl->blockDecl.get(), functionDecl->exprDecl.get());
+				}
+				break;
+			case AstNodeType_e::VariableDecl:
+				resolveGlobalVariable(node->to<ast::VariableDecl>());
+				break;
+			case AstNodeType_e::ClassFunctionDecl:
+				resolveClassFunction(node->to<ast::ClassFunctionDecl>());
+				break;
+			case AstNodeType_e::ClassConstructorDecl:
+				resolveConstructor(node->to<ast::ClassConstructorDecl>());
+				break;
+			case AstNodeType_e::TraitFunctionDecl:
+				resolveTraitFunction(node->to<ast::TraitFunctionDecl>());
+				break;
+			default:
+				break;
+			}
+			return;
+		}
+
+		switch (node->nodeType)
+		{
+		case AstNodeType_e::CodeUnit:
+			endCodeUnit();
+			break;
+		case AstNodeType_e::NamespaceDecl:
+		case AstNodeType_e::TraitDecl:
+		case AstNodeType_e::ClassDecl:
+		case AstNodeType_e::TraitForDecl:
+			popScope();
+			break;
+		default:
+			break;
+		}
+	}
+
+	Program* const
+	SlotResolver::getProgram()
+	{
+		return mProgram.get();
+	}
+
+	void
+	SlotResolver::beginCodeUnit(ast::CodeUnit* const codeUnit)
+	{
+		mCodeUnit = codeUnit;
+		mFilename = toString(codeUnit->identifier);
+
+		mScopeStack.clear();
+		mScopeStack.push_back(ResolverScope_s { String(), invalidIndex });
+
+		mIncludeAliasMap.clear();
+		mIncludeWildcardList.clear();
+
+		// Os nomes incluidos apontam para o caminho completo do simbolo no code unit de origem.
+		for (auto& includeDecl : codeUnit->includeDeclList)
+		{
+			for (auto& includeItemDecl : includeDecl->includedItemList)
+			{
+				String scopePath;
+				for (auto scopedPathDecl = includeItemDecl->scopePath.get(); scopedPathDecl; scopedPathDecl = scopedPathDecl->scopedChildPath.get())
+				{
+					scopePath = joinPath(scopePath, toString(scopedPathDecl->identifier));
+				}
+
+				if (includeItemDecl->includeAll)
+				{
+					mIncludeWildcardList.push_back(scopePath);
+				}
+				else if (includeItemDecl->referencedAlias.str() != nullptr)
+				{
+					mIncludeAliasMap[toString(includeItemDecl->identifier)] = joinPath(scopePath, toString(includeItemDecl->referencedAlias));
+				}
+				else
+				{
+					mIncludeAliasMap[toString(includeItemDecl->identifier)] = joinPath(scopePath, toString(includeItemDecl->identifier));
+				}
+			}
+		}
+
+		// Declara todos os simbolos antes de resolver os corpos, permitindo
+		// referencias a funcoes e classes declaradas mais adiante.
+		for (auto& namespaceDecl : codeUnit->namespaceDeclList)
+		{
+			declareScope(toString(namespaceDecl->identifier), namespaceDecl.get());
+		}
+
+		// As classes base sao ligadas antes dos corpos, os indices dos campos
+		// dependem da quantidade de campos das classes base.
+		for (auto& namespaceDecl : codeUnit->namespaceDeclList)
+		{
+			linkScope(toString(namespaceDecl->identifier), namespaceDecl.get());
+		}
+
+		// As variaveis globais do code unit sao inicializadas em uma funcao propria.
+		mInitFunction = std::make_unique<FunctionScope_s>();
+		beginFunction(*mInitFunction, mProgram->insertFunction("<init>::" + mFilename, FunctionType_e::GlobalInit), codeUnit);
+		mFunction = nullptr;
+	}
+
+	void
+	SlotResolver::endCodeUnit()
+	{
+		mProgram->insertInitFunction(mFunctionIndexMap.at(mCodeUnit));
+
+		mInitFunction.reset();
+		mFunction = nullptr;
+		mCodeUnit = nullptr;
+	}
+
+	void
+	SlotResolver::declareScope(const String& scopePath, ast::NamespaceDecl* const namespaceDecl)
+	{
+		for (auto& childNamespaceDecl : namespaceDecl->namespaceDeclList)
+		{
+			declareScope(joinPath(scopePath, toString(childNamespaceDecl->identifier)), childNamespaceDecl.get());
+		}
+
+		for (auto& generalDecl : namespaceDecl->generalDeclList)
+		{
+			const String generalPath = joinPath(scopePath, toString(generalDecl->identifier));
+
+			switch (generalDecl->nodeType)
+			{
+			case AstNodeType_e::FunctionDecl:
+				{
+					auto functionDecl = generalDecl->to<ast::FunctionDecl>();
+					const U32 functionIndex = mProgram->insertFunction(generalPath, FunctionType_e::Function);
+
+					mProgram->getFunction(functionIndex)->parameterCount = static_cast<U32>(functionDecl->parameterList.size());
+					mFunctionIndexMap[functionDecl] = functionIndex;
+				}
+				break;
+			case AstNodeType_e::VariableDecl:
+				setSlot(generalDecl.get(), SlotType_e::Global, mProgram->insertGlobal(generalPath), 0);
+				break;
+			case AstNodeType_e::ClassDecl:
+				declareClass(generalPath, generalDecl->to<ast::ClassDecl>());
+				break;
+			case AstNodeType_e::StructDecl:
+				declareStruct(generalPath, generalDecl->to<ast::StructDecl>());
+				break;
+			case AstNodeType_e::EnumDecl:
+				declareEnum(generalPath, generalDecl->to<ast::EnumDecl>());
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	void
+	SlotResolver::declareClass(const String& classPath, ast::ClassDecl* const classDecl)
+	{
+		const U32 classIndex = mProgram->insertClass(classPath);
+		auto classInfo = mProgram->getClass(classIndex);
+
+		// Variaveis estaticas sao globais qualificadas pelo nome da classe.
+		for (auto& variableDecl : classDecl->variableList)
+		{
+			if (variableDecl->isStatic)
+			{
+				setSlot(variableDecl.get(), SlotType_e::Global, mProgram->insertGlobal(joinPath(classPath, toString(variableDecl->identifier))), 0);
+			}
+			else
+			{
+				classInfo->fieldList.push_back(toString(variableDecl->identifier));
+			}
+		}
+
+		classInfo->initFunctionIndex = mProgram->insertFunction(joinPath(classPath, "<init>"), FunctionType_e::ClassInit);
+		mProgram->getFunction(classInfo->initFunctionIndex)->classIndex = classIndex;
+		mFunctionIndexMap[classDecl] = classInfo->initFunctionIndex;
+
+		for (auto& functionDecl : classDecl->functionList)
+		{
+			if (functionDecl->isAbstract)
+			{
+				continue;
+			}
+
+			const String identifier = toString(functionDecl->identifier);
+			const U32 functionIndex = mProgram->insertFunction(joinPath(classPath, identifier), functionDecl->isStatic ? FunctionType_e::Function : FunctionType_e::Method);
+			auto function = mProgram->getFunction(functionIndex);
+
+			function->parameterCount = static_cast<U32>(functionDecl->parameterList.size());
+			function->classIndex = classIndex;
+
+			if (function->isMethod)
+			{
+				classInfo->methodList.push_back(ScriptMethod_s { identifier, functionIndex });
+			}
+			mFunctionIndexMap[functionDecl.get()] = functionIndex;
+		}
+
+		for (U32 i = 0; i < classDecl->constructorList.size(); i++)
+		{
+			auto constructorDecl = classDecl->constructorList[i].get();
+
+			const U32 functionIndex = mProgram->insertFunction(joinPath(classPath, "<constructor>#" + std::to_string(i)), FunctionType_e::Constructor);
+			auto function = mProgram->getFunction(functionIndex);
+
+			function->parameterCount = static_cast<U32>(constructorDecl->parameterList.size());
+			function->classIndex = classIndex;
+
+			classInfo->constructorList.push_back(functionIndex);
+			mFunctionIndexMap[constructorDecl] = functionIndex;
+		}
+	}
+
+	void
+	SlotResolver::declareStruct(const String& structPath, ast::StructDecl* const structDecl)
+	{
+		// Structs sao objetos sem metodos, construidos pelo bloco de inicializacao.
+		const U32 classIndex = mProgram->insertClass(structPath);
+		auto classInfo = mProgram->getClass(classIndex);
+
+		for (auto& variableDecl : structDecl->variableList)
+		{
+			classInfo->fieldList.push_back(toString(variableDecl->identifier));
+		}
+
+		classInfo->initFunctionIndex = mProgram->insertFunction(joinPath(structPath, "<init>"), FunctionType_e::ClassInit);
+		mProgram->getFunction(classInfo->initFunctionIndex)->classIndex = classIndex;
+		mFunctionIndexMap[structDecl] = classInfo->initFunctionIndex;
+	}
+
+	void
+	SlotResolver::declareEnum(const String& enumPath, ast::EnumDecl* const enumDecl)
+	{
+		I64 nextValue = 0;
+
+		for (auto& enumItemDecl : enumDecl->enumItemDeclList)
+		{
+			// Itens com dados precisam de um objeto em tempo de execucao.
+			if (enumItemDecl->hasData)
+			{
+				continue;
+			}
+
+			if (enumItemDecl->hasValue)
+			{
+				auto valueExpression = enumItemDecl->valueExpression.get();
+
+				if (valueExpression->nodeType != AstNodeType_e::ConstantIntegerExpr)
+				{
+					throw exceptions::not_implemented_feature_exception(mFilename, "enum items with non integer values");
+				}
+				nextValue = valueExpression->to<ast::expr::ExpressionConstantIntegerDecl>()->valueDecl;
+			}
+			mProgram->insertEnumItem(joinPath(enumPath, toString(enumItemDecl->identifier)), nextValue++);
+		}
+	}
+
+	void
+	SlotResolver::linkScope(const String& scopePath, ast::NamespaceDecl* const namespaceDecl)
+	{
+		pushScope(scopePath, invalidIndex);
+
+		for (auto& childNamespaceDecl : namespaceDecl->namespaceDeclList)
+		{
+			linkScope(joinPath(scopePath, toString(childNamespaceDecl->identifier)), childNamespaceDecl.get());
+		}
+
+		for (auto& generalDecl : namespaceDecl->generalDeclList)
+		{
+			if (generalDecl->nodeType != AstNodeType_e::ClassDecl)
+			{
+				continue;
+			}
+
+			auto classDecl = generalDecl->to<ast::ClassDecl>();
+
+			if (classDecl->baseClass)
+			{
+				const U32 classIndex = mProgram->findClass(joinPath(scopePath, toString(classDecl->identifier)));
+				mProgram->getClass(classIndex)->baseClassIndex = resolveClass(classDecl->baseClass.get());
+			}
+		}
+		popScope();
+	}
+
+	void
+	SlotResolver::pushScope(const String& scopePath, U32 classIndex)
+	{
+		mScopeStack.push_back(ResolverScope_s { scopePath, classIndex });
+	}
+
+	void
+	SlotResolver::popScope()
+	{
+		mScopeStack.pop_back();
+	}
+
+	void
+	SlotResolver::beginClass(ast::ClassDecl* const classDecl)
+	{
+		const String classPath = joinPath(mScopeStack.back().path, toString(classDecl->identifier));
+		const U32 classIndex = mProgram->findClass(classPath);
+		auto classInfo = mProgram->getClass(classIndex);
+
+		pushScope(classPath, classIndex);
+
+		// Resolve a funcao de inicializacao dos campos, que inicializa primeiro os campos da base.
+		FunctionScope_s functionScope;
+		auto previousFunction = mFunction;
+
+		beginFunction(functionScope, classInfo->initFunctionIndex, classDecl);
+
+		if (classInfo->baseClassIndex != invalidIndex)
+		{
+			functionScope.function->baseFunctionIndex = mProgram->getClass(classInfo->baseClassIndex)->initFunctionIndex;
+		}
+
+		for (auto& variableDecl : classDecl->variableList)
+		{
+			if (variableDecl->isStatic)
+			{
+				continue;
+			}
+
+			setSlot(variableDecl.get(), SlotType_e::Field, mProgram->findField(classIndex, toString(variableDecl->identifier)), 0);
+
+			if (variableDecl->initExpr)
+			{
+				resolveExpr(variableDecl->initExpr.get());
+				functionScope.function->initializerList.push_back(Initializer_s { variableDecl.get(), variableDecl->initExpr.get() });
+			}
+		}
+
+		// Variaveis estaticas sao inicializadas junto com as globais do code unit.
+		mFunction = mInitFunction.get();
+
+		for (auto& variableDecl : classDecl->variableList)
+		{
+			if (!variableDecl->isStatic || variableDecl->initExpr == nullptr)
+			{
+				continue;
+			}
+
+			resolveExpr(variableDecl->initExpr.get());
+			mFunction->function->initializerList.push_back(Initializer_s { variableDecl.get(), variableDecl->initExpr.get() });
+		}
+		mFunction = previousFunction;
+	}
+
+	void
+	SlotResolver::beginTraitFor(ast::TraitForDecl* const traitForDecl)
+	{
+		if (traitForDecl->typeDefinitionDecl->nodeType != AstNodeType_e::NamedType)
+		{
+			throw exceptions::not_implemented_feature_exception(mFilename, "trait implementation for primitive types");
+		}
+
+		const U32 classIndex = resolveClass(traitForDecl->typeDefinitionDecl.get());
+		auto classInfo = mProgram->getClass(classIndex);
+
+		// As funcoes do trait passam a ser metodos da classe.
+		for (auto& traitFunctionDecl : traitForDecl->functionDeclList)
+		{
+			const String identifier = toString(traitFunctionDecl->identifier);
+			const U32 functionIndex = mProgram->insertFunction(joinPath(classInfo->name, identifier), traitFunctionDecl->isStatic ? FunctionType_e::Function : FunctionType_e::Method);
+			auto function = mProgram->getFunction(functionIndex);
+
+			function->parameterCount = static_cast<U32>(traitFunctionDecl->parameterList.size());
+			function->classIndex = classIndex;
+
+			if (function->isMethod)
+			{
+				classInfo->methodList.push_back(ScriptMethod_s { identifier, functionIndex });
+			}
+			mFunctionIndexMap[traitFunctionDecl.get()] = functionIndex;
+		}
+		pushScope(classInfo->name, classIndex);
+	}
+
+	void
+	SlotResolver::resolveStructInit(ast::StructDecl* const structDecl)
+	{
+		const U32 classIndex = mProgram->findClass(joinPath(mScopeStack.back().path, toString(structDecl->identifier)));
+
+		FunctionScope_s functionScope;
+		auto previousFunction = mFunction;
+
+		beginFunction(functionScope, mProgram->getClass(classIndex)->initFunctionIndex, structDecl);
+
+		for (auto& variableDecl : structDecl->variableList)
+		{
+			setSlot(variableDecl.get(), SlotType_e::Field, mProgram->findField(classIndex, toString(variableDecl->identifier)), 0);
+
+			if (variableDecl->initExpr)
+			{
+				resolveExpr(variableDecl->initExpr.get());
+				functionScope.function->initializerList.push_back(Initializer_s { variableDecl.get(), variableDecl->initExpr.get() });
+			}
+		}
+		mFunction = previousFunction;
+	}
+
+	void
+	SlotResolver::resolveClassFunction(ast::ClassFunctionDecl* const classFunctionDecl)
+	{
+		if (classFunctionDecl->isAbstract)
+		{
+			return;
+		}
+
+		resolveFunctionBody(
+			mFunctionIndexMap.at(classFunctionDecl),
+			classFunctionDecl,
+			classFunctionDecl->parameterList,
+			classFunctionDecl->blockDecl.get(),
+			classFunctionDecl->exprDecl.get()
+		);
+	}
+
+	void
+	SlotResolver::resolveTraitFunction(ast::TraitFunctionDecl* const traitFunctionDecl)
+	{
+		auto it = mFunctionIndexMap.find(traitFunctionDecl);
+
+		// Somente as funcoes de 'trait for' sao executadas, as implementacoes
+		// padrao dos traits nao sao ligadas as classes.
+		if (it == mFunctionIndexMap.end())
+		{
+			return;
+		}
+
+		resolveFunctionBody(
+			it->second,
+			traitFunctionDecl,
+			traitFunctionDecl->parameterList,
+			traitFunctionDecl->blockDecl.get(),
+			traitFunctionDecl->exprDecl.get()
+		);
+	}
+
+	void
+	SlotResolver::resolveConstructor(ast::ClassConstructorDecl* const constructorDecl)
+	{
+		FunctionScope_s functionScope;
+		auto previousFunction = mFunction;
+
+		beginFunction(functionScope, mFunctionIndexMap.at(constructorDecl), constructorDecl);
+		declareParameters(constructorDecl->parameterList);
+
+		auto function = functionScope.function;
+		auto classInfo = mProgram->getClass(function->classIndex);
+
+		// Chama o construtor da classe base: explicitamente pelo super(...) ou o
+		// construtor sem parametros, quando existir.
+		if (classInfo->baseClassIndex != invalidIndex)
+		{
+			function->baseFunctionIndex = findConstructor(classInfo->baseClassIndex, constructorDecl->superInitExpr.get());
+
+			if (function->baseFunctionIndex == invalidIndex && constructorDecl->superInitExpr)
+			{
+				std::vector<ast::expr::ExpressionDecl*> argumentList;
+				collectArguments(constructorDecl->superInitExpr.get(), argumentList);
+
+				throw exceptions::custom_exception(
+					"No constructor of '%s' receives %d arguments",
+					constructorDecl->line,
+					constructorDecl->column,
+					mProgram->getClass(classInfo->baseClassIndex)->name.c_str(),
+					static_cast<U32>(argumentList.size())
+				);
+			}
+			resolveArguments(constructorDecl->superInitExpr.get());
+		}
+
+		// Campos listados no construtor.
+		for (auto& variableInitDecl : constructorDecl->variableInitDeclList)
+		{
+			const String identifier = toString(variableInitDecl->identifier);
+			const U32 fieldIndex = mProgram->findField(function->classIndex, identifier);
+
+			if (fieldIndex == invalidIndex)
+			{
+				throw exceptions::custom_exception(
+					"Field '%s' not found in '%s'",
+					variableInitDecl->line,
+					variableInitDecl->column,
+					identifier.c_str(),
+					classInfo->name.c_str()
+				);
+			}
+
+			setSlot(variableInitDecl.get(), SlotType_e::Field, fieldIndex, 0);
+
+			if (variableInitDecl->initExpr)
+			{
+				resolveExpr(variableInitDecl->initExpr.get());
+			}
+			function->initializerList.push_back(Initializer_s { variableInitDecl.get(), variableInitDecl->initExpr.get() });
+		}
+
+		if (constructorDecl->blockDecl)
+		{
+			function->blockDecl = constructorDecl->blockDecl.get();
+			resolveBlock(constructorDecl->blockDecl.get());
+		}
+		mFunction = previousFunction;
+	}
+
+	void
+	SlotResolver::resolveGlobalVariable(ast::VariableDecl* const variableDecl)
+	{
+		auto previousFunction = mFunction;
+		mFunction = mInitFunction.get();
+
+		if (variableDecl->initExpr)
+		{
+			resolveExpr(variableDecl->initExpr.get());
+		}
+		mFunction->function->initializerList.push_back(Initializer_s { variableDecl, variableDecl->initExpr.get() });
+
+		mFunction = previousFunction;
+	}
+
+	void
+	SlotResolver::resolveFunctionBody(U32 functionIndex, ast::AstNode* const decl, FunctionParameterDeclPtrList& parameterList, ast::BlockDecl* const blockDecl, ast::expr::ExpressionDecl* const exprDecl)
+	{
+		FunctionScope_s functionScope;
+		auto previousFunction = mFunction;
+
+		beginFunction(functionScope, functionIndex, decl);
+		declareParameters(parameterList);
+
+		functionScope.function->blockDecl = blockDecl;
+		functionScope.function->exprDecl = exprDecl;
+
+		if (exprDecl)
+		{
+			resolveExpr(exprDecl);
+		}
+		else if (blockDecl)
+		{
+			resolveBlock(blockDecl);
+		}
+		mFunction = previousFunction;
+	}
+
+	void
+	SlotResolver::beginFunction(FunctionScope_s& functionScope, U32 functionIndex, ast::AstNode* const decl)
+	{
+		functionScope.function = mProgram->getFunction(functionIndex);
+		functionScope.function->decl = decl;
+		functionScope.localList.clear();
+		functionScope.loopDepth = 0;
+
+		// O slot 0 dos metodos guarda o 'this'.
+		functionScope.freeSlot = functionScope.function->isMethod ? 1 : 0;
+		functionScope.function->frameSize = functionScope.freeSlot;
+
+		mFunctionIndexMap[decl] = functionIndex;
+		mFunction = &functionScope;
+	}
+
+	void
+	SlotResolver::declareParameters(FunctionParameterDeclPtrList& parameterList)
+	{
+		for (auto& parameterDecl : parameterList)
+		{
+			if (parameterDecl->patternDecl)
+			{
+				throw exceptions::not_implemented_feature_exception(mFilename, "parameter destructuring");
+			}
+
+			const U32 slot = allocateSlot();
+
+			setSlot(parameterDecl.get(), SlotType_e::Local, slot, 0);
+			declareLocal(toString(parameterDecl->identifier), slot);
+		}
+	}
+
+	void
+	SlotResolver::resolveBlock(ast::BlockDecl* const blockDecl)
+	{
+		const size_t localCount = mFunction->localList.size();
+		const U32 mark = mFunction->freeSlot;
+
+		for (auto& stmtDecl : blockDecl->stmtList)
+		{
+			resolveStmt(stmtDecl.get());
+		}
+
+		// Variaveis do bloco saem de escopo e os slots sao reaproveitados.
+		mFunction->localList.resize(localCount);
+		mFunction->freeSlot = mark;
+	}
+
+	void
+	SlotResolver::resolveStmt(ast::stmt::StmtDecl* const stmtDecl)
+	{
+		switch (stmtDecl->nodeType)
+		{
+		case AstNodeType_e::StmtExpr:
+			resolveExpr(stmtDecl->to<ast::stmt::StmtExprDecl>()->exprDecl.get());
+			break;
+		case AstNodeType_e::StmtVariable:
+			{
+				auto variableDecl = stmtDecl->to<ast::stmt::StmtVariableDecl>();
+
+				if (variableDecl->patternDecl)
+				{
+					throw exceptions::not_implemented_feature_exception(mFilename, "variable destructuring");
+				}
+
+				if (variableDecl->initExpr)
+				{
+					resolveExpr(variableDecl->initExpr.get());
+				}
+
+				// A variavel so e visivel apos a expressao de inicializacao.
+				const U32 slot = allocateSlot();
+
+				setSlot(variableDecl, SlotType_e::Local, slot, 0);
+				declareLocal(toString(variableDecl->identifier), slot);
+			}
+			break;
+		case AstNodeType_e::StmtIf:
+			{
+				auto ifDecl = stmtDecl->to<ast::stmt::StmtIfDecl>();
+
+				resolveExpr(ifDecl->conditionExprDecl.get());
+				resolveBlock(ifDecl->ifBlockDecl.get());
+
+				if (ifDecl->elseBlockDecl)
+				{
+					resolveBlock(ifDecl->elseBlockDecl.get());
+				}
+			}
+			break;
+		case AstNodeType_e::StmtWhile:
+			{
+				auto whileDecl = stmtDecl->to<ast::stmt::StmtWhileDecl>();
+
+				resolveExpr(whileDecl->conditionExprDecl.get());
+
+				mFunction->loopDepth++;
+				resolveBlock(whileDecl->blockDecl.get());
+				mFunction->loopDepth--;
+			}
+			break;
+		case AstNodeType_e::StmtDoWhile:
+			{
+				auto doWhileDecl = stmtDecl->to<ast::stmt::StmtDoWhileDecl>();
+
+				mFunction->loopDepth++;
+				resolveBlock(doWhileDecl->blockDecl.get());
+				mFunction->loopDepth--;
+
+				resolveExpr(doWhileDecl->conditionExprDecl.get());
+			}
+			break;
+		case AstNodeType_e::StmtFor:
+			{
+				auto forDecl = stmtDecl->to<ast::stmt::StmtForDecl>();
+
+				const size_t localCount = mFunction->localList.size();
+				const U32 mark = mFunction->freeSlot;
+
+				if (forDecl->initStmtDecl)
+				{
+					resolveExpr(forDecl->initStmtDecl->initExpr.get());
+
+					const U32 slot = allocateSlot();
+
+					setSlot(forDecl->initStmtDecl.get(), SlotType_e::Local, slot, 0);
+					declareLocal(toString(forDecl->initStmtDecl->identifier), slot);
+				}
+				else if (forDecl->initExprDecl)
+				{
+					resolveExpr(forDecl->initExprDecl.get());
+				}
+
+				if (forDecl->conditionExprDecl)
+				{
+					resolveExpr(forDecl->conditionExprDecl.get());
+				}
+
+				mFunction->loopDepth++;
+				resolveBlock(forDecl->blockDecl.get());
+				mFunction->loopDepth--;
+
+				if (forDecl->updateExprDecl)
+				{
+					resolveExpr(forDecl->updateExprDecl.get());
+				}
+
+				mFunction->localList.resize(localCount);
+				mFunction->freeSlot = mark;
+			}
+			break;
+		case AstNodeType_e::StmtMatch:
+			{
+				auto matchDecl = stmtDecl->to<ast::stmt::StmtMatchDecl>();
+
+				resolveExpr(matchDecl->conditionExprDecl.get());
+
+				for (auto& whenDecl : matchDecl->whenDeclList)
+				{
+					const size_t localCount = mFunction->localList.size();
+					const U32 mark = mFunction->freeSlot;
+
+					resolvePattern(whenDecl->patternDecl.get());
+					resolveBlock(whenDecl->blockDecl.get());
+
+					mFunction->localList.resize(localCount);
+					mFunction->freeSlot = mark;
+				}
+			}
+			break;
+		case AstNodeType_e::StmtReturn:
+			{
+				auto returnDecl = stmtDecl->to<ast::stmt::StmtReturnDecl>();
+
+				if (returnDecl->exprDecl)
+				{
+					resolveExpr(returnDecl->exprDecl.get());
+				}
+			}
+			break;
+		case AstNodeType_e::StmtContinue:
+		case AstNodeType_e::StmtBreak:
+			if (mFunction->loopDepth == 0)
+			{
+				throw exceptions::custom_exception(
+					"'%s' outside of a loop",
+					stmtDecl->line,
+					stmtDecl->column,
+					stmtDecl->nodeType == AstNodeType_e::StmtBreak ? "break" : "continue"
+				);
+			}
+			break;
+		case AstNodeType_e::StmtPanic:
+			resolveExpr(stmtDecl->to<ast::stmt::StmtPanicDecl>()->exprDecl.get());
+			break;
+		case AstNodeType_e::StmtGoto:
+		case AstNodeType_e::StmtLabel:
+			throw exceptions::not_implemented_feature_exception(mFilename, "goto in the ast interpreter");
+		case AstNodeType_e::StmtIfLet:
+			throw exceptions::not_implemented_feature_exception(mFilename, "if let");
+		case AstNodeType_e::StmtTry:
+			throw exceptions::not_implemented_feature_exception(mFilename, "try catch");
+		default:
+			throw exceptions::custom_exception(
+				"Invalid statement",
+				stmtDecl->line,
+				stmtDecl->column
+			);
+		}
+	}
+
+	void
+	SlotResolver::resolveExpr(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::ConstantBoolExpr:
+		case AstNodeType_e::ConstantIntegerExpr:
+		case AstNodeType_e::ConstantRealExpr:
+		case AstNodeType_e::ConstantCharExpr:
+		case AstNodeType_e::ConstantNullExpr:
+			break;
+		case AstNodeType_e::ConstantStringExpr:
+			setSlot(exprDecl, SlotType_e::Constant, mProgram->insertStringConstant(exprDecl->to<ast::expr::ExpressionConstantStringDecl>()->valueDecl), 0);
+			break;
+		case AstNodeType_e::ThisExpr:
+		case AstNodeType_e::SuperExpr:
+			if (!mFunction->function->isMethod)
+			{
+				throw exceptions::custom_exception(
+					"'%s' used outside of a method",
+					exprDecl->line,
+					exprDecl->column,
+					exprDecl->nodeType == AstNodeType_e::ThisExpr ? "this" : "super"
+				);
+			}
+			break;
+		case AstNodeType_e::IdentifierExpr:
+			{
+				auto identifierDecl = exprDecl->to<ast::expr::ExpressionIdentifierDecl>();
+				const String identifier = toString(identifierDecl->identifier);
+
+				bindSymbol(exprDecl, resolveSymbol(identifier, identifierDecl->startFromRoot), identifier);
+			}
+			break;
+		case AstNodeType_e::BinaryExpr:
+			resolveBinary(exprDecl->to<ast::expr::ExpressionBinaryDecl>());
+			break;
+		case AstNodeType_e::UnaryExpr:
+			{
+				auto unaryDecl = exprDecl->to<ast::expr::ExpressionUnaryDecl>();
+
+				switch (unaryDecl->op)
+				{
+				case TokenType_e::Increment:
+				case TokenType_e::Decrement:
+					resolveAssignTarget(unaryDecl->exprDecl.get());
+					break;
+				case TokenType_e::Minus:
+				case TokenType_e::BitWiseNot:
+				case TokenType_e::LogicalNot:
+				case TokenType_e::Plus:
+				case TokenType_e::Ref:
+				case TokenType_e::Shared:
+					resolveExpr(unaryDecl->exprDecl.get());
+					break;
+				default:
+					throw exceptions::custom_exception(
+						"Invalid unary operator",
+						unaryDecl->line,
+						unaryDecl->column
+					);
+				}
+			}
+			break;
+		case AstNodeType_e::TernaryExpr:
+			{
+				auto ternaryDecl = exprDecl->to<ast::expr::ExpressionTernaryDecl>();
+
+				resolveExpr(ternaryDecl->conditionDecl.get());
+				resolveExpr(ternaryDecl->leftDecl.get());
+				resolveExpr(ternaryDecl->rightDecl.get());
+			}
+			break;
+		case AstNodeType_e::AsExpr:
+			{
+				auto asDecl = exprDecl->to<ast::expr::ExpressionAsDecl>();
+
+				resolveExpr(asDecl->exprDecl.get());
+				resolveType(asDecl->typeDecl.get());
+			}
+			break;
+		case AstNodeType_e::IsExpr:
+			{
+				auto isDecl = exprDecl->to<ast::expr::ExpressionIsDecl>();
+
+				resolveExpr(isDecl->exprDecl.get());
+				resolveType(isDecl->typeDecl.get());
+			}
+			break;
+		case AstNodeType_e::FunctionCallExpr:
+			{
+				auto callDecl = exprDecl->to<ast::expr::ExpressionFunctionCall>();
+				resolveCall(callDecl->lhsDecl.get(), callDecl->rhsDecl.get());
+			}
+			break;
+		case AstNodeType_e::GenericCallExpr:
+			{
+				// Os tipos genericos nao existem em tempo de execucao.
+				auto genericCallDecl = exprDecl->to<ast::expr::ExpressionGenericCallDecl>();
+				resolveCall(genericCallDecl->lhsDecl.get(), genericCallDecl->rhsDecl.get());
+			}
+			break;
+		case AstNodeType_e::IndexExpr:
+			{
+				auto indexDecl = exprDecl->to<ast::expr::ExpressionIndexDecl>();
+
+				resolveExpr(indexDecl->lhsDecl.get());
+				resolveExpr(indexDecl->rhsDecl.get());
+			}
+			break;
+		case AstNodeType_e::ArrayInitExpr:
+			for (auto& elementDecl : exprDecl->to<ast::expr::ExpressionArrayInitDecl>()->arrayElementDeclList)
+			{
+				resolveExpr(elementDecl.get());
+			}
+			break;
+		case AstNodeType_e::NewExpr:
+			resolveNew(exprDecl->to<ast::expr::ExpressionNewDecl>());
+			break;
+		case AstNodeType_e::MatchExpr:
+			{
+				auto matchDecl = exprDecl->to<ast::expr::ExpressionMatchDecl>();
+
+				resolveExpr(matchDecl->exprDecl.get());
+
+				for (auto& whenDecl : matchDecl->whenDeclList)
+				{
+					const size_t localCount = mFunction->localList.size();
+					const U32 mark = mFunction->freeSlot;
+
+					resolvePattern(whenDecl->patternDecl.get());
+					resolveExpr(whenDecl->exprDecl.get());
+
+					mFunction->localList.resize(localCount);
+					mFunction->freeSlot = mark;
+				}
+			}
+			break;
+		case AstNodeType_e::FunctionDeclExpr:
+			throw exceptions::not_implemented_feature_exception(mFilename, "anonymous functions");
+		case AstNodeType_e::AnomClassDeclExpr:
+			throw exceptions::not_implemented_feature_exception(mFilename, "anonymous classes");
+		case AstNodeType_e::PrimitiveTypeExpr:
+			throw exceptions::not_implemented_feature_exception(mFilename, "primitive type expressions");
+		default:
+			throw exceptions::custom_exception(
+				"Invalid expression",
+				exprDecl->line,
+				exprDecl->column
+			);
+		}
+	}
+
+	void
+	SlotResolver::resolveBinary(ast::expr::ExpressionBinaryDecl* const binaryDecl)
+	{
+		switch (binaryDecl->op)
+		{
+		case TokenType_e::ScopeResolution:
+			{
+				String path;
+				Bool startFromRoot = false;
+
+				if (!buildScopedPath(binaryDecl, path, startFromRoot))
+				{
+					throw exceptions::custom_exception(
+						"Invalid scoped identifier",
+						binaryDecl->line,
+						binaryDecl->column
+					);
+				}
+
+				// O caminho inteiro e resolvido no no do operador.
+				bindSymbol(binaryDecl, resolveSymbol(path, startFromRoot), path);
+			}
+			break;
+		case TokenType_e::Dot:
+		case TokenType_e::SafeDot:
+			if (binaryDecl->rightDecl->nodeType != AstNodeType_e::IdentifierExpr)
+			{
+				throw exceptions::custom_exception(
+					"Expected a field name after '.'",
+					binaryDecl->rightDecl->line,
+					binaryDecl->rightDecl->column
+				);
+			}
+
+			// O campo depende da classe do objeto, guardada no cache do slot.
+			resolveExpr(binaryDecl->leftDecl.get());
+			setSlot(binaryDecl->rightDecl.get(), SlotType_e::Member, invalidIndex, 0);
+			break;
+		case TokenType_e::Assign:
+			resolveAssignTarget(binaryDecl->leftDecl.get());
+			resolveExpr(binaryDecl->rightDecl.get());
+			break;
+		case TokenType_e::LogicalAnd:
+		case TokenType_e::LogicalOr:
+		case TokenType_e::Comma:
+			resolveExpr(binaryDecl->leftDecl.get());
+			resolveExpr(binaryDecl->rightDecl.get());
+			break;
+		default:
+			if (codegen::getBinaryOpCode(binaryDecl->op) == codegen::OpCode_e::Nop)
+			{
+				throw exceptions::custom_exception(
+					"Invalid binary operator",
+					binaryDecl->line,
+					binaryDecl->column
+				);
+			}
+
+			if (codegen::isCompoundAssign(binaryDecl->op))
+			{
+				resolveAssignTarget(binaryDecl->leftDecl.get());
+			}
+			else
+			{
+				resolveExpr(binaryDecl->leftDecl.get());
+			}
+			resolveExpr(binaryDecl->rightDecl.get());
+			break;
+		}
+	}
+
+	void
+	SlotResolver::resolveAssignTarget(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::IdentifierExpr:
+			{
+				auto identifierDecl = exprDecl->to<ast::expr::ExpressionIdentifierDecl>();
+				const Symbol_s symbol = resolveSymbol(toString(identifierDecl->identifier), identifierDecl->startFromRoot);
+
+				if (symbol.type == SymbolType_e::Local || symbol.type == SymbolType_e::Field || symbol.type == SymbolType_e::Global)
+				{
+					bindSymbol(exprDecl, symbol, toString(identifierDecl->identifier));
+					return;
+				}
+			}
+			break;
+		case AstNodeType_e::BinaryExpr:
+			{
+				auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+				if (binaryDecl->op == TokenType_e::ScopeResolution)
+				{
+					String path;
+					Bool startFromRoot = false;
+
+					if (buildScopedPath(binaryDecl, path, startFromRoot))
+					{
+						const Symbol_s symbol = resolveSymbol(path, startFromRoot);
+						if (symbol.type == SymbolType_e::Global)
+						{
+							bindSymbol(exprDecl, symbol, path);
+							return;
+						}
+					}
+				}
+				else if (binaryDecl->op == TokenType_e::Dot && binaryDecl->rightDecl->nodeType == AstNodeType_e::IdentifierExpr)
+				{
+					resolveBinary(binaryDecl);
+					return;
+				}
+			}
+			break;
+		case AstNodeType_e::IndexExpr:
+			resolveExpr(exprDecl);
+			return;
+		default:
+			break;
+		}
+
+		throw exceptions::custom_exception(
+			"Invalid assignment target",
+			exprDecl->line,
+			exprDecl->column
+		);
+	}
+
+	void
+	SlotResolver::resolveCall(ast::expr::ExpressionDecl* const lhsDecl, ast::expr::ExpressionDecl* const argumentsDecl)
+	{
+		auto binaryDecl = lhsDecl->nodeType == AstNodeType_e::BinaryExpr
+			? lhsDecl->to<ast::expr::ExpressionBinaryDecl>()
+			: nullptr;
+
+		if (lhsDecl->nodeType == AstNodeType_e::SuperExpr)
+		{
+			// super(...) no corpo do construtor chama o construtor da classe base.
+			const U32 classIndex = mFunction->function->classIndex;
+			const U32 baseClassIndex = classIndex != invalidIndex
+				? mProgram->getClass(classIndex)->baseClassIndex
+				: invalidIndex;
+
+			const U32 constructorIndex = baseClassIndex != invalidIndex
+				? findConstructor(baseClassIndex, argumentsDecl)
+				: invalidIndex;
+
+			if (constructorIndex == invalidIndex || !mFunction->function->isMethod)
+			{
+				std::vector<ast::expr::ExpressionDecl*> argumentList;
+				collectArguments(argumentsDecl, argumentList);
+
+				throw exceptions::custom_exception(
+					"No base constructor receives %d arguments",
+					lhsDecl->line,
+					lhsDecl->column,
+					static_cast<U32>(argumentList.size())
+				);
+			}
+			setSlot(lhsDecl, SlotType_e::Function, constructorIndex, 0);
+		}
+		else if (binaryDecl && (binaryDecl->op == TokenType_e::Dot || binaryDecl->op == TokenType_e::SafeDot))
+		{
+			if (binaryDecl->rightDecl->nodeType != AstNodeType_e::IdentifierExpr)
+			{
+				throw exceptions::custom_exception(
+					"Expected a method name after '.'",
+					binaryDecl->rightDecl->line,
+					binaryDecl->rightDecl->column
+				);
+			}
+
+			const String methodName = toString(binaryDecl->rightDecl->identifier);
+
+			if (binaryDecl->leftDecl->nodeType == AstNodeType_e::SuperExpr)
+			{
+				// super.metodo() chama diretamente a implementacao da classe base.
+				const U32 classIndex = mFunction->function->classIndex;
+				const U32 functionIndex = classIndex != invalidIndex
+					? mProgram->findMethod(mProgram->getClass(classIndex)->baseClassIndex, methodName)
+					: invalidIndex;
+
+				if (functionIndex == invalidIndex || !mFunction->function->isMethod)
+				{
+					throw exceptions::custom_exception(
+						"Method '%s' not found in base class",
+						binaryDecl->line,
+						binaryDecl->column,
+						methodName.c_str()
+					);
+				}
+				setSlot(binaryDecl->rightDecl.get(), SlotType_e::Function, functionIndex, 0);
+			}
+			else
+			{
+				// O metodo e escolhido pela classe do objeto e guardado no cache do slot.
+				resolveExpr(binaryDecl->leftDecl.get());
+				setSlot(binaryDecl->rightDecl.get(), SlotType_e::Member, invalidIndex, 0);
+			}
+		}
+		else
+		{
+			String path;
+			Bool startFromRoot = false;
+
+			Symbol_s symbol { SymbolType_e::Unknown, invalidIndex, 0 };
+			if (buildScopedPath(lhsDecl, path, startFromRoot))
+			{
+				symbol = resolveSymbol(path, startFromRoot);
+			}
+
+			switch (symbol.type)
+			{
+			case SymbolType_e::Function:
+				setSlot(lhsDecl, SlotType_e::Function, symbol.index, 0);
+				break;
+			case SymbolType_e::Method:
+				// Metodo da propria classe chamado sem 'this', resolvido pelo nome
+				// para respeitar as sobrescritas.
+				if (!mFunction->function->isMethod)
+				{
+					throw exceptions::custom_exception(
+						"Method '%s' called without an object",
+						lhsDecl->line,
+						lhsDecl->column,
+						path.c_str()
+					);
+				}
+				setSlot(lhsDecl, SlotType_e::Method, invalidIndex, 0);
+				break;
+			default:
+				// Valor chamavel em tempo de execucao.
+				resolveExpr(lhsDecl);
+				break;
+			}
+		}
+		resolveArguments(argumentsDecl);
+	}
+
+	void
+	SlotResolver::resolveNew(ast::expr::ExpressionNewDecl* const newDecl)
+	{
+		if (newDecl->objTypeDecl->nodeType != AstNodeType_e::NamedType)
+		{
+			throw exceptions::not_implemented_feature_exception(mFilename, "new for non class types");
+		}
+
+		const U32 classIndex = resolveClass(newDecl->objTypeDecl.get());
+		auto classInfo = mProgram->getClass(classIndex);
+
+		// Seleciona o construtor pela quantidade de argumentos.
+		const U32 constructorIndex = findConstructor(classIndex, newDecl->exprDecl.get());
+
+		if (constructorIndex == invalidIndex && (newDecl->exprDecl || classInfo->constructorList.size()))
+		{
+			std::vector<ast::expr::ExpressionDecl*> argumentList;
+			collectArguments(newDecl->exprDecl.get(), argumentList);
+
+			throw exceptions::custom_exception(
+				"No constructor of '%s' receives %d arguments",
+				newDecl->line,
+				newDecl->column,
+				classInfo->name.c_str(),
+				static_cast<U32>(argumentList.size())
+			);
+		}
+
+		setSlot(newDecl, SlotType_e::Function, constructorIndex, 0);
+		resolveArguments(newDecl->exprDecl.get());
+
+		// Bloco de inicializacao: new Foo { a: 1, b }
+		if (newDecl->objInitBlockDecl)
+		{
+			for (auto& itemDecl : newDecl->objInitBlockDecl->itemDeclList)
+			{
+				const String identifier = toString(itemDecl->identifier);
+				const U32 fieldIndex = mProgram->findField(classIndex, identifier);
+
+				if (fieldIndex == invalidIndex)
+				{
+					throw exceptions::custom_exception(
+						"Field '%s' not found in '%s'",
+						itemDecl->line,
+						itemDecl->column,
+						identifier.c_str(),
+						classInfo->name.c_str()
+					);
+				}
+
+				// O atalho { b } equivale a { b: b }.
+				if (itemDecl->exprDecl == nullptr)
+				{
+					auto identifierDecl = std::make_unique<ast::expr::ExpressionIdentifierDecl>(itemDecl->line, itemDecl->column);
+					identifierDecl->identifier = itemDecl->identifier;
+					itemDecl->exprDecl = std::move(identifierDecl);
+				}
+
+				setSlot(itemDecl.get(), SlotType_e::Field, fieldIndex, 0);
+				resolveExpr(itemDecl->exprDecl.get());
+			}
+		}
+	}
+
+	void
+	SlotResolver::resolvePattern(ast::pattern::PatternDecl* const patternDecl)
+	{
+		if (patternDecl->nodeType != AstNodeType_e::LiteralPattern)
+		{
+			throw exceptions::not_implemented_feature_exception(mFilename, "tuple, structure and enumerable patterns");
+		}
+
+		auto literalPatternDecl = patternDecl->to<ast::pattern::LiteralPatternDecl>();
+
+		if (literalPatternDecl->literalExpr)
+		{
+			resolveExpr(literalPatternDecl->literalExpr.get());
+			return;
+		}
+
+		const String identifier = toString(literalPatternDecl->identifier);
+
+		// '_' aceita qualquer valor e nao recebe slot.
+		if (identifier == "_")
+		{
+			return;
+		}
+
+		// Itens de enum e constantes globais sao comparados, os demais nomes
+		// capturam o valor em uma nova variavel.
+		const Symbol_s symbol = resolveSymbol(identifier, false);
+		if (symbol.type == SymbolType_e::EnumItem || symbol.type == SymbolType_e::Global)
+		{
+			bindSymbol(patternDecl, symbol, identifier);
+			return;
+		}
+
+		const U32 slot = allocateSlot();
+
+		setSlot(patternDecl, SlotType_e::Local, slot, 0);
+		declareLocal(identifier, slot);
+	}
+
+	void
+	SlotResolver::resolveArguments(ast::expr::ExpressionDecl* const argumentsDecl)
+	{
+		std::vector<ast::expr::ExpressionDecl*> argumentList;
+		collectArguments(argumentsDecl, argumentList);
+
+		for (auto argumentDecl : argumentList)
+		{
+			resolveExpr(argumentDecl);
+		}
+	}
+
+	void
+	SlotResolver::resolveType(ast::TypeDecl* const typeDecl)
+	{
+		switch (typeDecl->nodeType)
+		{
+		case AstNodeType_e::PrimitiveType:
+			break;
+		case AstNodeType_e::NamedType:
+			resolveClass(typeDecl);
+			break;
+		default:
+			throw exceptions::not_implemented_feature_exception(mFilename, "type tests for non class types");
+		}
+	}
+
+	U32
+	SlotResolver::resolveClass(ast::TypeDecl* const typeDecl)
+	{
+		if (typeDecl->nodeType == AstNodeType_e::NamedType)
+		{
+			auto namedTypeDecl = typeDecl->to<ast::TypeDeclNamed>();
+
+			String path;
+			for (auto scopedPathDecl = namedTypeDecl->scopePath.get(); scopedPathDecl; scopedPathDecl = scopedPathDecl->scopedChildPath.get())
+			{
+				path = joinPath(path, toString(scopedPathDecl->identifier));
+			}
+			path = joinPath(path, toString(namedTypeDecl->identifier));
+
+			const Symbol_s symbol = resolveSymbol(path, namedTypeDecl->startFromRoot);
+			if (symbol.type == SymbolType_e::Class)
+			{
+				typeDecl->removeAttribute(AttributeType_e::ResolvedType);
+				typeDecl->insertAttribute(new attributes::ResolvedType(symbol.index));
+				return symbol.index;
+			}
+
+			throw exceptions::custom_exception(
+				"Unresolved class '%s'",
+				typeDecl->line,
+				typeDecl->column,
+				path.c_str()
+			);
+		}
+
+		throw exceptions::custom_exception(
+			"Expected a class type",
+			typeDecl->line,
+			typeDecl->column
+		);
+	}
+
+	U32
+	SlotResolver::findConstructor(U32 classIndex, ast::expr::ExpressionDecl* const argumentsDecl)
+	{
+		std::vector<ast::expr::ExpressionDecl*> argumentList;
+		collectArguments(argumentsDecl, argumentList);
+
+		for (auto functionIndex : mProgram->getClass(classIndex)->constructorList)
+		{
+			if (mProgram->getFunction(functionIndex)->parameterCount == argumentList.size())
+			{
+				return functionIndex;
+			}
+		}
+		return invalidIndex;
+	}
+
+	void
+	SlotResolver::bindSymbol(ast::AstNode* const node, const Symbol_s& symbol, const String& identifier)
+	{
+		switch (symbol.type)
+		{
+		case SymbolType_e::Local:
+			setSlot(node, SlotType_e::Local, symbol.index, 0);
+			break;
+		case SymbolType_e::Field:
+			setSlot(node, SlotType_e::Field, symbol.index, 0);
+			break;
+		case SymbolType_e::Global:
+			setSlot(node, SlotType_e::Global, symbol.index, 0);
+			break;
+		case SymbolType_e::Function:
+			setSlot(node, SlotType_e::Function, symbol.index, 0);
+			break;
+		case SymbolType_e::EnumItem:
+			setSlot(node, SlotType_e::EnumItem, invalidIndex, symbol.value);
+			break;
+		case SymbolType_e::Method:
+			throw exceptions::custom_exception(
+				"Method '%s' can't be used as a value",
+				node->line,
+				node->column,
+				identifier.c_str()
+			);
+		case SymbolType_e::Class:
+			throw exceptions::custom_exception(
+				"Type '%s' can't be used as a value",
+				node->line,
+				node->column,
+				identifier.c_str()
+			);
+		default:
+			throw exceptions::custom_exception(
+				"Unresolved identifier '%s'",
+				node->line,
+				node->column,
+				identifier.c_str()
+			);
+		}
+	}
+
+	Symbol_s
+	SlotResolver::resolveSymbol(const String& identifier, Bool startFromRoot)
+	{
+		if (startFromRoot)
+		{
+			return resolvePath(identifier);
+		}
+
+		const U32 slot = findLocal(identifier);
+		if (slot != invalidIndex)
+		{
+			return Symbol_s { SymbolType_e::Local, slot, 0 };
+		}
+
+		// Dentro de metodos os campos da classe sao acessados sem 'this', o indice
+		// do campo e o mesmo em todas as classes derivadas.
+		if (mFunction != nullptr && mFunction->function->isMethod)
+		{
+			const U32 fieldIndex = mProgram->findField(mFunction->function->classIndex, identifier);
+			if (fieldIndex != invalidIndex)
+			{
+				return Symbol_s { SymbolType_e::Field, fieldIndex, 0 };
+			}
+		}
+
+		// Procura do escopo mais interno ate o escopo global.
+		for (auto it = mScopeStack.rbegin(); it != mScopeStack.rend(); it++)
+		{
+			const Symbol_s symbol = resolvePath(joinPath(it->path, identifier));
+			if (symbol.type != SymbolType_e::Unknown)
+			{
+				return symbol;
+			}
+		}
+
+		// Procura nos nomes incluidos, o primeiro segmento do caminho pode ser um alias.
+		const size_t separator = identifier.find("::");
+		auto it = mIncludeAliasMap.find(identifier.substr(0, separator));
+
+		if (it != mIncludeAliasMap.end())
+		{
+			const Symbol_s symbol = resolvePath(separator != String::npos ? it->second + identifier.substr(separator) : it->second);
+			if (symbol.type != SymbolType_e::Unknown)
+			{
+				return symbol;
+			}
+		}
+
+		for (auto& includePath : mIncludeWildcardList)
+		{
+			const Symbol_s symbol = resolvePath(joinPath(includePath, identifier));
+			if (symbol.type != SymbolType_e::Unknown)
+			{
+				return symbol;
+			}
+		}
+		return Symbol_s { SymbolType_e::Unknown, invalidIndex, 0 };
+	}
+
+	Symbol_s
+	SlotResolver::resolvePath(const String& path)
+	{
+		U32 index = mProgram->findFunction(path);
+		if (index != invalidIndex)
+		{
+			return Symbol_s { mProgram->getFunction(index)->isMethod ? SymbolType_e::Method : SymbolType_e::Function, index, 0 };
+		}
+
+		index = mProgram->findGlobal(path);
+		if (index != invalidIndex)
+		{
+			return Symbol_s { SymbolType_e::Global, index, 0 };
+		}
+
+		index = mProgram->findClass(path);
+		if (index != invalidIndex)
+		{
+			return Symbol_s { SymbolType_e::Class, index, 0 };
+		}
+
+		I64 value = 0;
+		if (mProgram->findEnumItem(path, value))
+		{
+			return Symbol_s { SymbolType_e::EnumItem, invalidIndex, value };
+		}
+		return Symbol_s { SymbolType_e::Unknown, invalidIndex, 0 };
+	}
+
+	Bool
+	SlotResolver::buildScopedPath(ast::expr::ExpressionDecl* const exprDecl, String& path, Bool& startFromRoot)
+	{
+		if (exprDecl->nodeType == AstNodeType_e::IdentifierExpr)
+		{
+			path = toString(exprDecl->identifier);
+			startFromRoot = exprDecl->to<ast::expr::ExpressionIdentifierDecl>()->startFromRoot;
+			return true;
+		}
+
+		if (exprDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op == TokenType_e::ScopeResolution &&
+				binaryDecl->rightDecl->nodeType == AstNodeType_e::IdentifierExpr &&
+				buildScopedPath(binaryDecl->leftDecl.get(), path, startFromRoot))
+			{
+				path = joinPath(path, toString(binaryDecl->rightDecl->identifier));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void
+	SlotResolver::collectArguments(ast::expr::ExpressionDecl* const exprDecl, std::vector<ast::expr::ExpressionDecl*>& argumentList)
+	{
+		if (exprDecl == nullptr)
+		{
+			return;
+		}
+
+		// Os argumentos chegam como uma cadeia de operadores ','.
+		if (exprDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op == TokenType_e::Comma)
+			{
+				collectArguments(binaryDecl->leftDecl.get(), argumentList);
+				collectArguments(binaryDecl->rightDecl.get(), argumentList);
+				return;
+			}
+		}
+		argumentList.push_back(exprDecl);
+	}
+
+	void
+	SlotResolver::declareLocal(const String& identifier, U32 slot)
+	{
+		mFunction->localList.push_back(LocalSlot_s { identifier, slot });
+	}
+
+	U32
+	SlotResolver::findLocal(const String& identifier)
+	{
+		if (mFunction == nullptr)
+		{
+			return invalidIndex;
+		}
+
+		// A declaracao mais recente esconde as anteriores.
+		auto& localList = mFunction->localList;
+		for (auto it = localList.rbegin(); it != localList.rend(); it++)
+		{
+			if (it->name == identifier)
+			{
+				return it->slot;
+			}
+		}
+		return invalidIndex;
+	}
+
+	U32
+	SlotResolver::allocateSlot()
+	{
+		const U32 slot = mFunction->freeSlot++;
+
+		if (mFunction->freeSlot > mFunction->function->frameSize)
+		{
+			mFunction->function->frameSize = mFunction->freeSlot;
+		}
+		return slot;
+	}
+
+	void
+	SlotResolver::setSlot(ast::AstNode* const node, SlotType_e slotType, U32 index, I64 value)
+	{
+		// A resolucao pode ser repetida, o slot anterior e substituido.
+		node->removeAttribute(AttributeType_e::FrameSlot);
+		node->insertAttribute(new attributes::FrameSlot(slotType, index, value));
+	}
+} }
@@ -0,0 +1,792 @@
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+#include "ir/fl_ir.h"
+#include "fl_exceptions.h"
+namespace fluffy { namespace ir {
+	using codegen::OpCode_e;
+
+	static const I8* opcodeNames[] = {
+		"const", "param", "phi", "fnref",
+		"neg", "bitnot", "not", "add", "sub", "mul", "div", "mod", "shl", "shr",
+		"bitand", "bitor", "bitxor", "eq", "ne", "lt", "le", "gt", "ge",
+		"cast", "istype", "isclass", "castclass",
+		"ldglobal", "stglobal", "ldfield", "stfield", "ldindex", "stindex", "newarray", "new",
+		"call", "callmethod", "callvalue",
+		"jmp", "br", "ret", "panic"
+	};
+
+	static_assert(sizeof(opcodeNames) / sizeof(opcodeNames[0]) == static_cast<U32>(Opcode_e::Count), "opcodeNames out of sync with Opcode_e");
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	const I8*
+	getOpcodeName(Opcode_e op)
+	{
+		return op < Opcode_e::Count ? opcodeNames[static_cast<U32>(op)] : "unknown";
+	}
+
+	const I8*
+	getTypeName(Type_e type)
+	{
+		switch (type)
+		{
+		case Type_e::Void:	return "void";
+		case Type_e::Any:	return "any";
+		default:			return vm::getValueTypeName(toValueType(type));
+		}
+	}
+
+	Type_e
+	toType(PrimitiveTypeID_e primitiveType)
+	{
+		switch (primitiveType)
+		{
+		case PrimitiveTypeID_e::Void:		return Type_e::Void;
+		case PrimitiveTypeID_e::Object:		return Type_e::Object;
+		case PrimitiveTypeID_e::Unknown:	return Type_e::Any;
+		default:							return toType(vm::toValueType(primitiveType));
+		}
+	}
+
+	Type_e
+	getBinaryType(Opcode_e op, Type_e lhs, Type_e rhs)
+	{
+		if (isComparison(op))
+		{
+			return Type_e::Bool;
+		}
+
+		if (isNumberType(lhs) && isNumberType(rhs))
+		{
+			const Bool lhsReal = lhs == Type_e::Fp32 || lhs == Type_e::Fp64;
+			const Bool rhsReal = rhs == Type_e::Fp32 || rhs == Type_e::Fp64;
+
+			// Mesmas regras de computeArithmetic.
+			if (!lhsReal && !rhsReal)
+			{
+				return lhs > rhs ? lhs : rhs;
+			}
+			return lhs == Type_e::Fp64 || rhs == Type_e::Fp64 ? Type_e::Fp64 : Type_e::Fp32;
+		}
+
+		if (lhs == Type_e::Bool && rhs == Type_e::Bool && (op == Opcode_e::BitAnd || op == Opcode_e::BitOr || op == Opcode_e::BitXor))
+		{
+			return Type_e::Bool;
+		}
+
+		if (op == Opcode_e::Add && (lhs == Type_e::String || rhs == Type_e::String))
+		{
+			return Type_e::String;
+		}
+		return Type_e::Any;
+	}
+
+	OpCode_e
+	toBytecodeOp(Opcode_e op)
+	{
+		switch (op)
+		{
+		case Opcode_e::Add:				return OpCode_e::Add;
+		case Opcode_e::Sub:				return OpCode_e::Sub;
+		case Opcode_e::Mul:				return OpCode_e::Mul;
+		case Opcode_e::Div:				return OpCode_e::Div;
+		case Opcode_e::Mod:				return OpCode_e::Mod;
+		case Opcode_e::Shl:				return OpCode_e::Shl;
+		case Opcode_e::Shr:				return OpCode_e::Shr;
+		case Opcode_e::BitAnd:			return OpCode_e::BitAnd;
+		case Opcode_e::BitOr:			return OpCode_e::BitOr;
+		case Opcode_e::BitXor:			return OpCode_e::BitXor;
+		case Opcode_e::Equal:			return OpCode_e::Equal;
+		case Opcode_e::NotEqual:		return OpCode_e::NotEqual;
+		case Opcode_e::Less:			return OpCode_e::Less;
+		case Opcode_e::LessEqual:		return OpCode_e::LessEqual;
+		case Opcode_e::Greater:			return OpCode_e::Greater;
+		case Opcode_e::GreaterEqual:	return OpCode_e::GreaterEqual;
+		default:						return OpCode_e::Nop;
+		}
+	}
+
+	static void
+	dumpValue(std::stringstream& ss, Instruction* const instruction, Module* const module)
+	{
+		switch (instruction->type)
+		{
+		case Type_e::String:
+			if (module && instruction->index < module->stringConstantList.size())
+			{
+				ss << "\"" << module->stringConstantList[instruction->index] << "\"";
+			}
+			else
+			{
+				ss << "#" << instruction->index;
+			}
+			break;
+		default:
+			ss << vm::formatValue(instruction->value);
+			break;
+		}
+	}
+
+	static void
+	dumpInstruction(std::stringstream& ss, Instruction* const instruction, Module* const module)
+	{
+		ss << "  ";
+		if (instruction->type != Type_e::Void)
+		{
+			ss << "%" << instruction->id << " = ";
+		}
+		ss << getOpcodeName(instruction->op);
+
+		if (instruction->type != Type_e::Void)
+		{
+			ss << " " << getTypeName(instruction->type);
+		}
+
+		switch (instruction->op)
+		{
+		case Opcode_e::Constant:
+			ss << " ";
+			dumpValue(ss, instruction, module);
+			break;
+		case Opcode_e::Parameter:
+		case Opcode_e::LoadGlobal:
+		case Opcode_e::StoreGlobal:
+		case Opcode_e::FunctionRef:
+		case Opcode_e::Call:
+		case Opcode_e::New:
+		case Opcode_e::IsClass:
+		case Opcode_e::CastClass:
+			ss << " @" << instruction->index;
+			break;
+		case Opcode_e::LoadField:
+		case Opcode_e::StoreField:
+		case Opcode_e::CallMethod:
+			ss << " ." << instruction->name;
+			break;
+		default:
+			break;
+		}
+
+		for (size_t i = 0; i < instruction->operandList.size(); i++)
+		{
+			ss << (i == 0 ? " " : ", ") << "%" << instruction->operandList[i]->id;
+		}
+
+		for (size_t i = 0; i < instruction->targetList.size(); i++)
+		{
+			ss << (i == 0 && instruction->operandList.empty() ? " " : ", ") << "b" << instruction->targetList[i]->id;
+		}
+		ss << "\n";
+	}
+
+	static String
+	dumpFunction(Function* const function, Module* const module)
+	{
+		std::stringstream ss;
+
+		function->renumber();
+
+		ss << "fn " << function->name << " -> " << getTypeName(function->returnType) << "\n";
+		for (auto& block : function->blockList)
+		{
+			ss << "b" << block->id << ":";
+			if (block->predecessorList.size())
+			{
+				ss << " ; preds";
+				for (auto predecessor : block->predecessorList)
+				{
+					ss << " b" << predecessor->id;
+				}
+			}
+			ss << "\n";
+
+			for (auto& instruction : block->instructionList)
+			{
+				dumpInstruction(ss, instruction.get(), module);
+			}
+		}
+		return ss.str();
+	}
+
+	/**
+	 * Instruction
+	 */
+
+	Instruction::Instruction(Opcode_e op, Type_e type)
+		: op(op)
+		, type(type)
+		, block(nullptr)
+		, id(0)
+		, line(0)
+		, value(vm::makeNull())
+		, index(invalidIndex)
+		, auxIndex(invalidIndex)
+		, primitiveType(PrimitiveTypeID_e::Unknown)
+	{}
+
+	Instruction::~Instruction()
+	{}
+
+	void
+	Instruction::appendOperand(Instruction* const value)
+	{
+		operandList.push_back(value);
+		value->userList.push_back(this);
+	}
+
+	void
+	Instruction::setOperand(U32 operandIndex, Instruction* const value)
+	{
+		Instruction* const previous = operandList[operandIndex];
+
+		if (previous == value)
+		{
+			return;
+		}
+
+		auto it = std::find(previous->userList.begin(), previous->userList.end(), this);
+		previous->userList.erase(it);
+
+		operandList[operandIndex] = value;
+		value->userList.push_back(this);
+	}
+
+	void
+	Instruction::removeOperand(U32 operandIndex)
+	{
+		Instruction* const previous = operandList[operandIndex];
+
+		auto it = std::find(previous->userList.begin(), previous->userList.end(), this);
+		previous->userList.erase(it);
+
+		operandList.erase(operandList.begin() + operandIndex);
+	}
+
+	void
+	Instruction::dropOperands()
+	{
+		while (operandList.size())
+		{
+			removeOperand(static_cast<U32>(operandList.size() - 1));
+		}
+	}
+
+	void
+	Instruction::replaceAllUsesWith(Instruction* const value)
+	{
+		// A lista muda a cada substituicao.
+		const std::vector<Instruction*> users = userList;
+
+		for (auto user : users)
+		{
+			for (size_t i = 0; i < user->operandList.size(); i++)
+			{
+				if (user->operandList[i] == this)
+				{
+					user->setOperand(static_cast<U32>(i), value);
+				}
+			}
+		}
+	}
+
+	Bool
+	Instruction::hasSideEffects()
+	{
+		switch (op)
+		{
+		case Opcode_e::StoreGlobal:
+		case Opcode_e::StoreField:
+		case Opcode_e::StoreIndex:
+		case Opcode_e::New:
+		case Opcode_e::Call:
+		case Opcode_e::CallMethod:
+		case Opcode_e::CallValue:
+			return true;
+		default:
+			return isTerminator(op);
+		}
+	}
+
+	Bool
+	Instruction::mayTrap()
+	{
+		switch (op)
+		{
+		case Opcode_e::Neg:
+			return !isNumberType(operandList[0]->type);
+		case Opcode_e::BitNot:
+			return !isNumberType(operandList[0]->type) || operandList[0]->type == Type_e::Fp32 || operandList[0]->type == Type_e::Fp64;
+		case Opcode_e::Div:
+		case Opcode_e::Mod:
+			{
+				// Divisao inteira por uma constante diferente de zero nao falha.
+				Instruction* const divisor = operandList[1];
+
+				if (!isNumberType(operandList[0]->type) || !isNumberType(divisor->type))
+				{
+					return true;
+				}
+
+				if (divisor->type == Type_e::Fp32 || divisor->type == Type_e::Fp64)
+				{
+					return false;
+				}
+				return !divisor->isConstant() || divisor->value.integerValue == 0;
+			}
+		case Opcode_e::Add:
+		case Opcode_e::Sub:
+		case Opcode_e::Mul:
+		case Opcode_e::Shl:
+		case Opcode_e::Shr:
+		case Opcode_e::BitAnd:
+		case Opcode_e::BitOr:
+		case Opcode_e::BitXor:
+		case Opcode_e::Less:
+		case Opcode_e::LessEqual:
+		case Opcode_e::Greater:
+		case Opcode_e::GreaterEqual:
+			return type == Type_e::Any;
+		case Opcode_e::Cast:
+			return !isNumberType(operandList[0]->type) && operandList[0]->type != Type_e::Bool;
+		case Opcode_e::LoadField:
+		case Opcode_e::LoadIndex:
+		case Opcode_e::NewArray:
+			return true;
+		default:
+			return hasSideEffects();
+		}
+	}
+
+	Bool
+	Instruction::isConstant()
+	{
+		return op == Opcode_e::Constant;
+	}
+
+	/**
+	 * Block
+	 */
+
+	Block::Block(Function* const function, U32 id)
+		: function(function)
+		, id(id)
+	{}
+
+	Block::~Block()
+	{}
+
+	Instruction*
+	Block::append(std::unique_ptr<Instruction> instruction)
+	{
+		instruction->block = this;
+		instructionList.push_back(std::move(instruction));
+		return instructionList.back().get();
+	}
+
+	Instruction*
+	Block::insertAt(U32 position, std::unique_ptr<Instruction> instruction)
+	{
+		Instruction* const result = instruction.get();
+
+		instruction->block = this;
+		instructionList.insert(instructionList.begin() + position, std::move(instruction));
+		return result;
+	}
+
+	Instruction*
+	Block::insertBeforeTerminator(std::unique_ptr<Instruction> instruction)
+	{
+		const U32 position = getTerminator() != nullptr
+			? static_cast<U32>(instructionList.size() - 1)
+			: static_cast<U32>(instructionList.size());
+
+		return insertAt(position, std::move(instruction));
+	}
+
+	std::unique_ptr<Instruction>
+	Block::remove(Instruction* const instruction)
+	{
+		for (auto it = instructionList.begin(); it != instructionList.end(); it++)
+		{
+			if (it->get() == instruction)
+			{
+				std::unique_ptr<Instruction> result = std::move(*it);
+				instructionList.erase(it);
+
+				result->block = nullptr;
+				return result;
+			}
+		}
+		return nullptr;
+	}
+
+	void
+	Block::erase(Instruction* const instruction)
+	{
+		instruction->dropOperands();
+		remove(instruction);
+	}
+
+	Instruction*
+	Block::getTerminator()
+	{
+		if (instructionList.empty() || !isTerminator(instructionList.back()->op))
+		{
+			return nullptr;
+		}
+		return instructionList.back().get();
+	}
+
+	void
+	Block::removePredecessor(Block* const predecessor)
+	{
+		auto it = std::find(predecessorList.begin(), predecessorList.end(), predecessor);
+		if (it == predecessorList.end())
+		{
+			return;
+		}
+
+		const U32 operandIndex = static_cast<U32>(it - predecessorList.begin());
+		predecessorList.erase(it);
+
+		for (auto& instruction : instructionList)
+		{
+			if (instruction->op != Opcode_e::Phi)
+			{
+				break;
+			}
+			instruction->removeOperand(operandIndex);
+		}
+	}
+
+	void
+	Block::replacePredecessor(Block* const oldPredecessor, Block* const newPredecessor)
+	{
+		std::replace(predecessorList.begin(), predecessorList.end(), oldPredecessor, newPredecessor);
+	}
+
+	std::vector<Block*>
+	Block::getSuccessorList()
+	{
+		Instruction* const terminator = getTerminator();
+		return terminator != nullptr ? terminator->targetList : std::vector<Block*>();
+	}
+
+	/**
+	 * Function
+	 */
+
+	Function::Function(const String& name, U32 functionIndex)
+		: name(name)
+		, functionIndex(functionIndex)
+		, parameterCount(0)
+		, returnType(Type_e::Void)
+		, mNextBlockId(0)
+	{}
+
+	Function::~Function()
+	{}
+
+	Block*
+	Function::createBlock()
+	{
+		blockList.push_back(std::make_unique<Block>(this, mNextBlockId++));
+		return blockList.back().get();
+	}
+
+	Block*
+	Function::getEntry()
+	{
+		return blockList.size() ? blockList.front().get() : nullptr;
+	}
+
+	void
+	Function::eraseBlock(Block* const block)
+	{
+		for (auto& instruction : block->instructionList)
+		{
+			instruction->dropOperands();
+		}
+
+		for (auto it = blockList.begin(); it != blockList.end(); it++)
+		{
+			if (it->get() == block)
+			{
+				blockList.erase(it);
+				return;
+			}
+		}
+	}
+
+	std::vector<Block*>
+	Function::getReversePostOrder()
+	{
+		std::vector<Block*> postOrder;
+		std::unordered_set<Block*> visited;
+
+		// Pilha explicita: bloco e o proximo sucessor a visitar.
+		std::vector<std::pair<Block*, U32>> stack;
+
+		if (getEntry() == nullptr)
+		{
+			return postOrder;
+		}
+
+		stack.emplace_back(getEntry(), 0);
+		visited.insert(getEntry());
+
+		while (stack.size())
+		{
+			auto& top = stack.back();
+			const std::vector<Block*> successorList = top.first->getSuccessorList();
+
+			if (top.second < successorList.size())
+			{
+				Block* const successor = successorList[top.second++];
+
+				if (visited.insert(successor).second)
+				{
+					stack.emplace_back(successor, 0);
+				}
+				continue;
+			}
+
+			postOrder.push_back(top.first);
+			stack.pop_back();
+		}
+
+		std::reverse(postOrder.begin(), postOrder.end());
+		return postOrder;
+	}
+
+	Bool
+	Function::removeUnreachableBlocks()
+	{
+		const std::vector<Block*> reachableList = getReversePostOrder();
+		const std::unordered_set<Block*> reachable(reachableList.begin(), reachableList.end());
+
+		std::vector<Block*> unreachableList;
+		for (auto& block : blockList)
+		{
+			if (reachable.find(block.get()) == reachable.end())
+			{
+				unreachableList.push_back(block.get());
+			}
+		}
+
+		if (unreachableList.empty())
+		{
+			return false;
+		}
+
+		// Remove as arestas para os blocos alcancaveis antes de apagar os blocos.
+		for (auto block : unreachableList)
+		{
+			for (auto successor : block->getSuccessorList())
+			{
+				if (reachable.find(successor) != reachable.end())
+				{
+					successor->removePredecessor(block);
+				}
+			}
+		}
+
+		for (auto block : unreachableList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				instruction->dropOperands();
+			}
+		}
+
+		for (auto block : unreachableList)
+		{
+			eraseBlock(block);
+		}
+		return true;
+	}
+
+	void
+	Function::renumber()
+	{
+		U32 id = 0;
+		for (auto& block : blockList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				instruction->id = id++;
+			}
+		}
+	}
+
+	U32
+	Function::getInstructionCount()
+	{
+		U32 count = 0;
+		for (auto& block : blockList)
+		{
+			count += static_cast<U32>(block->instructionList.size());
+		}
+		return count;
+	}
+
+	void
+	Function::verify()
+	{
+		std::unordered_set<Instruction*> definedSet;
+		std::unordered_set<Block*> blockSet;
+
+		for (auto& block : blockList)
+		{
+			blockSet.insert(block.get());
+			for (auto& instruction : block->instructionList)
+			{
+				definedSet.insert(instruction.get());
+			}
+		}
+
+		for (auto& block : blockList)
+		{
+			if (block->getTerminator() == nullptr)
+			{
+				throw exceptions::custom_exception("IR error: block b%d of '%s' has no terminator", block->id, name.c_str());
+			}
+
+			Bool phiSection = true;
+			for (auto& instruction : block->instructionList)
+			{
+				if (instruction->block != block.get())
+				{
+					throw exceptions::custom_exception("IR error: instruction '%s' in b%d of '%s' has the wrong parent", getOpcodeName(instruction->op), block->id, name.c_str());
+				}
+
+				if (instruction->op == Opcode_e::Phi)
+				{
+					if (!phiSection || instruction->operandList.size() != block->predecessorList.size())
+					{
+						throw exceptions::custom_exception("IR error: malformed phi in b%d of '%s'", block->id, name.c_str());
+					}
+				}
+				else
+				{
+					phiSection = false;
+				}
+
+				if (isTerminator(instruction->op) && instruction.get() != block->instructionList.back().get())
+				{
+					throw exceptions::custom_exception("IR error: terminator in the middle of b%d of '%s'", block->id, name.c_str());
+				}
+
+				for (auto operand : instruction->operandList)
+				{
+					if (definedSet.find(operand) == definedSet.end())
+					{
+						throw exceptions::custom_exception("IR error: '%s' in b%d of '%s' uses a removed value", getOpcodeName(instruction->op), block->id, name.c_str());
+					}
+
+					if (std::find(operand->userList.begin(), operand->userList.end(), instruction.get()) == operand->userList.end())
+					{
+						throw exceptions::custom_exception("IR error: missing use of '%s' in b%d of '%s'", getOpcodeName(operand->op), block->id, name.c_str());
+					}
+				}
+			}
+
+			// Cada aresta aparece na lista de predecessores do destino.
+			const std::vector<Block*> successorList = block->getSuccessorList();
+			for (auto successor : successorList)
+			{
+				if (blockSet.find(successor) == blockSet.end()
+					|| std::count(successor->predecessorList.begin(), successor->predecessorList.end(), block.get())
+						!= std::count(successorList.begin(), successorList.end(), successor))
+				{
+					throw exceptions::custom_exception("IR error: edge b%d -> b%d of '%s' is inconsistent", block->id, successor->id, name.c_str());
+				}
+			}
+		}
+	}
+
+	String
+	Function::dump()
+	{
+		return dumpFunction(this, nullptr);
+	}
+
+	/**
+	 * Module
+	 */
+
+	Module::Module()
+	{}
+
+	Module::~Module()
+	{}
+
+	Function*
+	Module::insertFunction(std::unique_ptr<Function> function)
+	{
+		const U32 functionIndex = function->functionIndex;
+
+		if (functionIndex >= mFunctionList.size())
+		{
+			mFunctionList.resize(functionIndex + 1);
+		}
+		mFunctionList[functionIndex] = std::move(function);
+		return mFunctionList[functionIndex].get();
+	}
+
+	Function*
+	Module::getFunction(U32 functionIndex)
+	{
+		return functionIndex < mFunctionList.size() ? mFunctionList[functionIndex].get() : nullptr;
+	}
+
+	Function*
+	Module::findFunction(const String& name)
+	{
+		for (auto& function : mFunctionList)
+		{
+			if (function && function->name == name)
+			{
+				return function.get();
+			}
+		}
+		return nullptr;
+	}
+
+	U32
+	Module::getFunctionCount()
+	{
+		return static_cast<U32>(mFunctionList.size());
+	}
+
+	U32
+	Module::getInstructionCount()
+	{
+		U32 count = 0;
+		for (auto& function : mFunctionList)
+		{
+			if (function)
+			{
+				count += function->getInstructionCount();
+			}
+		}
+		return count;
+	}
+
+	String
+	Module::dump()
+	{
+		String result;
+		for (auto& function : mFunctionList)
+		{
+			if (function)
+			{
+				result += dumpFunction(function.get(), this);
+			}
+		}
+		return result;
+	}
+} }
@@ -0,0 +1,1619 @@
+#include <algorithm>
+#include <unordered_set>
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_type.h"
+#include "attributes/fl_frame_slot.h"
+#include "attributes/fl_resolved_type.h"
+#include "ir/fl_ir_builder.h"
+#include "fl_exceptions.h"
+namespace fluffy { namespace ir {
+	using attributes::FrameSlot;
+	using attributes::SlotType_e;
+	using interpreter::FunctionType_e;
+	using interpreter::ScriptFunction_s;
+
+	// Indica uma atribuicao simples em buildAssign.
+	static constexpr const Opcode_e assignOnly = Opcode_e::Count;
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static String
+	getIdentifier(const TString& identifier)
+	{
+		return identifier.str() != nullptr ? String(identifier.str()) : String();
+	}
+
+	static FrameSlot*
+	getSlot(ast::AstNode* const node)
+	{
+		return node->getAttribute<FrameSlot>();
+	}
+
+	static Opcode_e
+	toIrOp(codegen::OpCode_e op)
+	{
+		switch (op)
+		{
+		case codegen::OpCode_e::Add:			return Opcode_e::Add;
+		case codegen::OpCode_e::Sub:			return Opcode_e::Sub;
+		case codegen::OpCode_e::Mul:			return Opcode_e::Mul;
+		case codegen::OpCode_e::Div:			return Opcode_e::Div;
+		case codegen::OpCode_e::Mod:			return Opcode_e::Mod;
+		case codegen::OpCode_e::Shl:			return Opcode_e::Shl;
+		case codegen::OpCode_e::Shr:			return Opcode_e::Shr;
+		case codegen::OpCode_e::BitAnd:			return Opcode_e::BitAnd;
+		case codegen::OpCode_e::BitOr:			return Opcode_e::BitOr;
+		case codegen::OpCode_e::BitXor:			return Opcode_e::BitXor;
+		case codegen::OpCode_e::Equal:			return Opcode_e::Equal;
+		case codegen::OpCode_e::NotEqual:		return Opcode_e::NotEqual;
+		case codegen::OpCode_e::Less:			return Opcode_e::Less;
+		case codegen::OpCode_e::LessEqual:		return Opcode_e::LessEqual;
+		case codegen::OpCode_e::Greater:		return Opcode_e::Greater;
+		default:								return Opcode_e::GreaterEqual;
+		}
+	}
+
+	static ast::FunctionParameterDeclPtrList*
+	getParameterList(ast::AstNode* const decl)
+	{
+		if (decl == nullptr)
+		{
+			return nullptr;
+		}
+
+		switch (decl->nodeType)
+		{
+		case AstNodeType_e::FunctionDecl:
+			return &decl->to<ast::FunctionDecl>()->parameterList;
+		case AstNodeType_e::ClassFunctionDecl:
+			return &decl->to<ast::ClassFunctionDecl>()->parameterList;
+		case AstNodeType_e::TraitFunctionDecl:
+			return &decl->to<ast::TraitFunctionDecl>()->parameterList;
+		case AstNodeType_e::ClassConstructorDecl:
+			return &decl->to<ast::ClassConstructorDecl>()->parameterList;
+		default:
+			return nullptr;
+		}
+	}
+
+	static ast::TypeDecl*
+	getReturnTypeDecl(ast::AstNode* const decl)
+	{
+		if (decl == nullptr)
+		{
+			return nullptr;
+		}
+
+		switch (decl->nodeType)
+		{
+		case AstNodeType_e::FunctionDecl:
+			return decl->to<ast::FunctionDecl>()->returnType.get();
+		case AstNodeType_e::ClassFunctionDecl:
+			return decl->to<ast::ClassFunctionDecl>()->returnType.get();
+		case AstNodeType_e::TraitFunctionDecl:
+			return decl->to<ast::TraitFunctionDecl>()->returnType.get();
+		default:
+			return nullptr;
+		}
+	}
+
+	static Type_e
+	joinTypes(Instruction* const phi)
+	{
+		Type_e type = Type_e::Void;
+
+		for (auto operand : phi->operandList)
+		{
+			if (operand == phi)
+			{
+				continue;
+			}
+
+			if (type == Type_e::Void)
+			{
+				type = operand->type;
+			}
+			else if (type != operand->type)
+			{
+				return Type_e::Any;
+			}
+		}
+		return type == Type_e::Void ? Type_e::Any : type;
+	}
+
+	/**
+	 * IrBuilder
+	 */
+
+	IrBuilder::IrBuilder(interpreter::Program* const program)
+		: mProgram(program)
+		, mScriptFunction(nullptr)
+		, mBlock(nullptr)
+		, mLine(0)
+	{}
+
+	IrBuilder::~IrBuilder()
+	{}
+
+	std::unique_ptr<Module>
+	IrBuilder::build()
+	{
+		auto module = std::make_unique<Module>();
+
+		for (U32 i = 0; i < mProgram->getStringConstantCount(); i++)
+		{
+			module->stringConstantList.push_back(mProgram->getStringConstant(i));
+		}
+
+		for (U32 i = 0; i < mProgram->getFunctionCount(); i++)
+		{
+			module->insertFunction(buildFunction(i));
+		}
+		return module;
+	}
+
+	std::unique_ptr<Function>
+	IrBuilder::buildFunction(U32 functionIndex)
+	{
+		mScriptFunction = mProgram->getFunction(functionIndex);
+		mFunction = std::make_unique<Function>(mScriptFunction->name, functionIndex);
+		mFunction->returnType = getDeclaredType(getReturnTypeDecl(mScriptFunction->decl));
+
+		mBlockStateList.clear();
+		mLoopList.clear();
+		mLine = mScriptFunction->decl ? mScriptFunction->decl->line : 0;
+
+		setBlock(createBlock(true));
+		declareParameters(mScriptFunction);
+
+		switch (mScriptFunction->type)
+		{
+		case FunctionType_e::Constructor:
+			// O construtor da classe base recebe os argumentos do super(...).
+			if (mScriptFunction->baseFunctionIndex != invalidIndex)
+			{
+				std::vector<Instruction*> operandList { getThis() };
+				buildArguments(mScriptFunction->decl->to<ast::ClassConstructorDecl>()->superInitExpr.get(), operandList);
+
+				emitCall(Opcode_e::Call, Type_e::Void, mScriptFunction->baseFunctionIndex, operandList);
+			}
+			buildInitializers(mScriptFunction);
+			break;
+		case FunctionType_e::ClassInit:
+			if (mScriptFunction->baseFunctionIndex != invalidIndex)
+			{
+				emitCall(Opcode_e::Call, Type_e::Void, mScriptFunction->baseFunctionIndex, { getThis() });
+			}
+			buildInitializers(mScriptFunction);
+			break;
+		case FunctionType_e::GlobalInit:
+			buildInitializers(mScriptFunction);
+			break;
+		default:
+			break;
+		}
+
+		// Funcoes declaradas com '=' retornam o valor da expressao.
+		if (mScriptFunction->exprDecl)
+		{
+			emitReturn(buildExpr(mScriptFunction->exprDecl));
+		}
+		else if (mScriptFunction->blockDecl)
+		{
+			buildBlock(mScriptFunction->blockDecl);
+		}
+
+		if (!isTerminated())
+		{
+			emitReturn(nullptr);
+		}
+
+		// Blocos apos 'return', 'break' e 'continue' nao tem predecessores.
+		mFunction->removeUnreachableBlocks();
+		inferTypes();
+
+		mReplacementMap.clear();
+		mRemovedList.clear();
+		return std::move(mFunction);
+	}
+
+	void
+	IrBuilder::declareParameters(ScriptFunction_s* const scriptFunction)
+	{
+		const U32 thisCount = scriptFunction->isMethod ? 1 : 0;
+
+		mFunction->parameterCount = thisCount + scriptFunction->parameterCount;
+
+		if (thisCount)
+		{
+			Instruction* const parameter = emit(Opcode_e::Parameter, Type_e::Object);
+			parameter->index = 0;
+			writeVariable(0, mBlock, parameter);
+		}
+
+		auto parameterList = getParameterList(scriptFunction->decl);
+		if (parameterList == nullptr)
+		{
+			return;
+		}
+
+		for (auto& parameterDecl : *parameterList)
+		{
+			const U32 slot = getSlot(parameterDecl.get())->getIndex();
+
+			Instruction* const parameter = emit(Opcode_e::Parameter, getDeclaredType(parameterDecl->typeDecl.get()));
+			parameter->index = slot;
+			writeVariable(slot, mBlock, parameter);
+		}
+	}
+
+	void
+	IrBuilder::buildInitializers(ScriptFunction_s* const scriptFunction)
+	{
+		for (auto& initializer : scriptFunction->initializerList)
+		{
+			FrameSlot* const frameSlot = getSlot(initializer.decl);
+			mLine = initializer.decl->line;
+
+			Instruction* const value = initializer.initExpr
+				? buildExpr(initializer.initExpr)
+				: emitNull();
+
+			if (frameSlot->getSlotType() == SlotType_e::Field)
+			{
+				Instruction* const store = emit(Opcode_e::StoreField, Type_e::Void);
+				store->index = frameSlot->getIndex();
+				store->name = getIdentifier(initializer.decl->identifier);
+				store->appendOperand(getThis());
+				store->appendOperand(value);
+			}
+			else
+			{
+				Instruction* const store = emit(Opcode_e::StoreGlobal, Type_e::Void);
+				store->index = frameSlot->getIndex();
+				store->appendOperand(value);
+			}
+		}
+	}
+
+	void
+	IrBuilder::buildBlock(ast::BlockDecl* const blockDecl)
+	{
+		for (auto& stmtDecl : blockDecl->stmtList)
+		{
+			// Codigo apos um desvio incondicional fica em um bloco sem predecessores.
+			if (isTerminated())
+			{
+				setBlock(createBlock(true));
+			}
+			buildStmt(stmtDecl.get());
+		}
+	}
+
+	void
+	IrBuilder::buildStmt(ast::stmt::StmtDecl* const stmtDecl)
+	{
+		mLine = stmtDecl->line;
+
+		switch (stmtDecl->nodeType)
+		{
+		case AstNodeType_e::StmtExpr:
+			buildExpr(stmtDecl->to<ast::stmt::StmtExprDecl>()->exprDecl.get());
+			break;
+		case AstNodeType_e::StmtVariable:
+			{
+				auto variableDecl = stmtDecl->to<ast::stmt::StmtVariableDecl>();
+
+				Instruction* const value = variableDecl->initExpr
+					? buildExpr(variableDecl->initExpr.get())
+					: emitNull();
+
+				writeVariable(getSlot(variableDecl)->getIndex(), mBlock, value);
+			}
+			break;
+		case AstNodeType_e::StmtIf:
+			{
+				auto ifDecl = stmtDecl->to<ast::stmt::StmtIfDecl>();
+
+				Block* const thenBlock = createBlock(false);
+				Block* const elseBlock = ifDecl->elseBlockDecl ? createBlock(false) : nullptr;
+				Block* const mergeBlock = createBlock(false);
+
+				buildCondition(ifDecl->conditionExprDecl.get(), thenBlock, elseBlock ? elseBlock : mergeBlock);
+				sealBlock(thenBlock);
+
+				setBlock(thenBlock);
+				buildBlock(ifDecl->ifBlockDecl.get());
+				if (!isTerminated())
+				{
+					emitJump(mergeBlock);
+				}
+
+				if (elseBlock)
+				{
+					sealBlock(elseBlock);
+
+					setBlock(elseBlock);
+					buildBlock(ifDecl->elseBlockDecl.get());
+					if (!isTerminated())
+					{
+						emitJump(mergeBlock);
+					}
+				}
+
+				sealBlock(mergeBlock);
+				setBlock(mergeBlock);
+			}
+			break;
+		case AstNodeType_e::StmtWhile:
+			{
+				auto whileDecl = stmtDecl->to<ast::stmt::StmtWhileDecl>();
+
+				Block* const headerBlock = createBlock(false);
+				Block* const bodyBlock = createBlock(false);
+				Block* const exitBlock = createBlock(false);
+
+				emitJump(headerBlock);
+
+				setBlock(headerBlock);
+				buildCondition(whileDecl->conditionExprDecl.get(), bodyBlock, exitBlock);
+				sealBlock(bodyBlock);
+
+				mLoopList.push_back(LoopTarget_s { exitBlock, headerBlock });
+
+				setBlock(bodyBlock);
+				buildBlock(whileDecl->blockDecl.get());
+				if (!isTerminated())
+				{
+					emitJump(headerBlock);
+				}
+
+				mLoopList.pop_back();
+
+				sealBlock(headerBlock);
+				sealBlock(exitBlock);
+				setBlock(exitBlock);
+			}
+			break;
+		case AstNodeType_e::StmtDoWhile:
+			{
+				auto doWhileDecl = stmtDecl->to<ast::stmt::StmtDoWhileDecl>();
+
+				Block* const bodyBlock = createBlock(false);
+				Block* const conditionBlock = createBlock(false);
+				Block* const exitBlock = createBlock(false);
+
+				emitJump(bodyBlock);
+
+				mLoopList.push_back(LoopTarget_s { exitBlock, conditionBlock });
+
+				setBlock(bodyBlock);
+				buildBlock(doWhileDecl->blockDecl.get());
+				if (!isTerminated())
+				{
+					emitJump(conditionBlock);
+				}
+
+				mLoopList.pop_back();
+
+				sealBlock(conditionBlock);
+				setBlock(conditionBlock);
+				buildCondition(doWhileDecl->conditionExprDecl.get(), bodyBlock, exitBlock);
+
+				sealBlock(bodyBlock);
+				sealBlock(exitBlock);
+				setBlock(exitBlock);
+			}
+			break;
+		case AstNodeType_e::StmtFor:
+			{
+				auto forDecl = stmtDecl->to<ast::stmt::StmtForDecl>();
+
+				if (forDecl->initStmtDecl)
+				{
+					auto initStmtDecl = forDecl->initStmtDecl.get();
+					writeVariable(getSlot(initStmtDecl)->getIndex(), mBlock, buildExpr(initStmtDecl->initExpr.get()));
+				}
+				else if (forDecl->initExprDecl)
+				{
+					buildExpr(forDecl->initExprDecl.get());
+				}
+
+				Block* const headerBlock = createBlock(false);
+				Block* const bodyBlock = createBlock(false);
+				Block* const updateBlock = createBlock(false);
+				Block* const exitBlock = createBlock(false);
+
+				emitJump(headerBlock);
+
+				setBlock(headerBlock);
+				if (forDecl->conditionExprDecl)
+				{
+					buildCondition(forDecl->conditionExprDecl.get(), bodyBlock, exitBlock);
+				}
+				else
+				{
+					emitJump(bodyBlock);
+				}
+				sealBlock(bodyBlock);
+
+				mLoopList.push_back(LoopTarget_s { exitBlock, updateBlock });
+
+				setBlock(bodyBlock);
+				buildBlock(forDecl->blockDecl.get());
+				if (!isTerminated())
+				{
+					emitJump(updateBlock);
+				}
+
+				mLoopList.pop_back();
+
+				sealBlock(updateBlock);
+				setBlock(updateBlock);
+				if (forDecl->updateExprDecl)
+				{
+					buildExpr(forDecl->updateExprDecl.get());
+				}
+				emitJump(headerBlock);
+
+				sealBlock(headerBlock);
+				sealBlock(exitBlock);
+				setBlock(exitBlock);
+			}
+			break;
+		case AstNodeType_e::StmtMatch:
+			{
+				auto matchDecl = stmtDecl->to<ast::stmt::StmtMatchDecl>();
+
+				Instruction* const subject = buildExpr(matchDecl->conditionExprDecl.get());
+				Block* const exitBlock = createBlock(false);
+
+				// Testa os padroes na ordem em que foram declarados.
+				for (auto& whenDecl : matchDecl->whenDeclList)
+				{
+					Block* const armBlock = createBlock(false);
+					Block* const nextBlock = createBlock(false);
+
+					Instruction* const test = buildPatternTest(whenDecl->patternDecl.get(), subject);
+					if (test)
+					{
+						emitBranch(test, armBlock, nextBlock);
+					}
+					else
+					{
+						emitJump(armBlock);
+					}
+					sealBlock(armBlock);
+
+					setBlock(armBlock);
+					buildBlock(whenDecl->blockDecl.get());
+					if (!isTerminated())
+					{
+						emitJump(exitBlock);
+					}
+
+					sealBlock(nextBlock);
+					setBlock(nextBlock);
+				}
+
+				emitJump(exitBlock);
+
+				sealBlock(exitBlock);
+				setBlock(exitBlock);
+			}
+			break;
+		case AstNodeType_e::StmtReturn:
+			{
+				auto returnDecl = stmtDecl->to<ast::stmt::StmtReturnDecl>();
+
+				emitReturn(returnDecl->exprDecl
+					? buildExpr(returnDecl->exprDecl.get())
+					: nullptr
+				);
+			}
+			break;
+		case AstNodeType_e::StmtContinue:
+			emitJump(mLoopList.back().continueBlock);
+			break;
+		case AstNodeType_e::StmtBreak:
+			emitJump(mLoopList.back().breakBlock);
+			break;
+		case AstNodeType_e::StmtPanic:
+			{
+				Instruction* const message = buildExpr(stmtDecl->to<ast::stmt::StmtPanicDecl>()->exprDecl.get());
+				emit(Opcode_e::Panic, Type_e::Void)->appendOperand(message);
+			}
+			break;
+		default:
+			throw exceptions::custom_exception(
+				"Invalid statement",
+				stmtDecl->line,
+				stmtDecl->column
+			);
+		}
+	}
+
+	Instruction*
+	IrBuilder::buildExpr(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::ConstantBoolExpr:
+			return emitConstant(vm::makeBool(exprDecl->to<ast::expr::ExpressionConstantBoolDecl>()->valueDecl));
+		case AstNodeType_e::ConstantIntegerExpr:
+			{
+				auto integerDecl = exprDecl->to<ast::expr::ExpressionConstantIntegerDecl>();
+				return emitConstant(vm::makeInteger(vm::toValueType(integerDecl->valueType), integerDecl->valueDecl));
+			}
+		case AstNodeType_e::ConstantRealExpr:
+			{
+				auto realDecl = exprDecl->to<ast::expr::ExpressionConstantRealDecl>();
+				return emitConstant(vm::makeReal(vm::toValueType(realDecl->valueType), realDecl->valueDecl));
+			}
+		case AstNodeType_e::ConstantCharExpr:
+			return emitConstant(vm::makeInteger(vm::ValueType_e::I8, exprDecl->to<ast::expr::ExpressionConstantCharDecl>()->valueDecl));
+		case AstNodeType_e::ConstantNullExpr:
+			return emitNull();
+		case AstNodeType_e::ConstantStringExpr:
+		case AstNodeType_e::IdentifierExpr:
+			return loadSlot(exprDecl);
+		case AstNodeType_e::ThisExpr:
+		case AstNodeType_e::SuperExpr:
+			return getThis();
+		case AstNodeType_e::BinaryExpr:
+			return buildBinary(exprDecl->to<ast::expr::ExpressionBinaryDecl>());
+		case AstNodeType_e::UnaryExpr:
+			return buildUnary(exprDecl->to<ast::expr::ExpressionUnaryDecl>());
+		case AstNodeType_e::TernaryExpr:
+			{
+				auto ternaryDecl = exprDecl->to<ast::expr::ExpressionTernaryDecl>();
+
+				Block* const trueBlock = createBlock(false);
+				Block* const falseBlock = createBlock(false);
+				Block* const mergeBlock = createBlock(false);
+
+				buildCondition(ternaryDecl->conditionDecl.get(), trueBlock, falseBlock);
+				sealBlock(trueBlock);
+				sealBlock(falseBlock);
+
+				setBlock(trueBlock);
+				Instruction* const trueValue = buildExpr(ternaryDecl->leftDecl.get());
+				emitJump(mergeBlock);
+
+				setBlock(falseBlock);
+				Instruction* const falseValue = buildExpr(ternaryDecl->rightDecl.get());
+				emitJump(mergeBlock);
+
+				sealBlock(mergeBlock);
+				setBlock(mergeBlock);
+				return emitPhi(mergeBlock, { trueValue, falseValue });
+			}
+		case AstNodeType_e::AsExpr:
+			{
+				auto asDecl = exprDecl->to<ast::expr::ExpressionAsDecl>();
+				Instruction* const value = buildExpr(asDecl->exprDecl.get());
+
+				if (asDecl->typeDecl->nodeType == AstNodeType_e::PrimitiveType)
+				{
+					const PrimitiveTypeID_e primitiveType = asDecl->typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType;
+
+					Instruction* const cast = emit(Opcode_e::Cast, toType(primitiveType));
+					cast->primitiveType = primitiveType;
+					cast->appendOperand(value);
+					return cast;
+				}
+
+				// Conversao para classe: nulo quando o objeto nao e uma instancia.
+				Instruction* const cast = emit(Opcode_e::CastClass, Type_e::Object);
+				cast->index = asDecl->typeDecl->getAttribute<attributes::ResolvedType>()->getHandle();
+				cast->appendOperand(value);
+				return cast;
+			}
+		case AstNodeType_e::IsExpr:
+			{
+				auto isDecl = exprDecl->to<ast::expr::ExpressionIsDecl>();
+				Instruction* const value = buildExpr(isDecl->exprDecl.get());
+
+				if (isDecl->typeDecl->nodeType == AstNodeType_e::PrimitiveType)
+				{
+					Instruction* const test = emit(Opcode_e::IsType, Type_e::Bool);
+					test->primitiveType = isDecl->typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType;
+					test->appendOperand(value);
+					return test;
+				}
+
+				Instruction* const test = emit(Opcode_e::IsClass, Type_e::Bool);
+				test->index = isDecl->typeDecl->getAttribute<attributes::ResolvedType>()->getHandle();
+				test->appendOperand(value);
+				return test;
+			}
+		case AstNodeType_e::FunctionCallExpr:
+			{
+				auto callDecl = exprDecl->to<ast::expr::ExpressionFunctionCall>();
+				return buildCall(callDecl->lhsDecl.get(), callDecl->rhsDecl.get());
+			}
+		case AstNodeType_e::GenericCallExpr:
+			{
+				auto genericCallDecl = exprDecl->to<ast::expr::ExpressionGenericCallDecl>();
+				return buildCall(genericCallDecl->lhsDecl.get(), genericCallDecl->rhsDecl.get());
+			}
+		case AstNodeType_e::IndexExpr:
+			{
+				auto indexDecl = exprDecl->to<ast::expr::ExpressionIndexDecl>();
+
+				Instruction* const object = buildExpr(indexDecl->lhsDecl.get());
+				Instruction* const index = buildExpr(indexDecl->rhsDecl.get());
+
+				Instruction* const load = emit(Opcode_e::LoadIndex, Type_e::Any);
+				load->appendOperand(object);
+				load->appendOperand(index);
+				return load;
+			}
+		case AstNodeType_e::ArrayInitExpr:
+			{
+				std::vector<Instruction*> elementList;
+
+				for (auto& elementDecl : exprDecl->to<ast::expr::ExpressionArrayInitDecl>()->arrayElementDeclList)
+				{
+					elementList.push_back(buildExpr(elementDecl.get()));
+				}
+				return emitCall(Opcode_e::NewArray, Type_e::Array, invalidIndex, elementList);
+			}
+		case AstNodeType_e::NewExpr:
+			return buildNew(exprDecl->to<ast::expr::ExpressionNewDecl>());
+		case AstNodeType_e::MatchExpr:
+			{
+				auto matchDecl = exprDecl->to<ast::expr::ExpressionMatchDecl>();
+
+				Instruction* const subject = buildExpr(matchDecl->exprDecl.get());
+				Block* const mergeBlock = createBlock(false);
+
+				// Um valor por predecessor do bloco de saida, na mesma ordem.
+				std::vector<Instruction*> valueList;
+
+				for (auto& whenDecl : matchDecl->whenDeclList)
+				{
+					Block* const armBlock = createBlock(false);
+					Block* const nextBlock = createBlock(false);
+
+					Instruction* const test = buildPatternTest(whenDecl->patternDecl.get(), subject);
+					if (test)
+					{
+						emitBranch(test, armBlock, nextBlock);
+					}
+					else
+					{
+						emitJump(armBlock);
+					}
+					sealBlock(armBlock);
+
+					setBlock(armBlock);
+					valueList.push_back(buildExpr(whenDecl->exprDecl.get()));
+					emitJump(mergeBlock);
+
+					sealBlock(nextBlock);
+					setBlock(nextBlock);
+				}
+
+				// Nenhum padrao correspondeu.
+				valueList.push_back(emitNull());
+				emitJump(mergeBlock);
+
+				sealBlock(mergeBlock);
+				setBlock(mergeBlock);
+				return emitPhi(mergeBlock, valueList);
+			}
+		default:
+			throw exceptions::custom_exception(
+				"Invalid expression",
+				exprDecl->line,
+				exprDecl->column
+			);
+		}
+	}
+
+	Instruction*
+	IrBuilder::buildBinary(ast::expr::ExpressionBinaryDecl* const binaryDecl)
+	{
+		switch (binaryDecl->op)
+		{
+		case TokenType_e::ScopeResolution:
+			return loadSlot(binaryDecl);
+		case TokenType_e::Dot:
+		case TokenType_e::SafeDot:
+			{
+				Instruction* const object = buildExpr(binaryDecl->leftDecl.get());
+				const String fieldName = getIdentifier(binaryDecl->rightDecl->identifier);
+
+				auto loadField = [this, object, &fieldName]() {
+					Instruction* const load = emit(Opcode_e::LoadField, Type_e::Any);
+					load->name = fieldName;
+					load->appendOperand(object);
+					return load;
+				};
+
+				return binaryDecl->op == TokenType_e::SafeDot
+					? buildSafeAccess(object, loadField)
+					: loadField();
+			}
+		case TokenType_e::Assign:
+			return buildAssign(binaryDecl->leftDecl.get(), binaryDecl->rightDecl.get(), assignOnly, false);
+		case TokenType_e::LogicalAnd:
+		case TokenType_e::LogicalOr:
+			return buildShortCircuit(binaryDecl);
+		case TokenType_e::Comma:
+			buildExpr(binaryDecl->leftDecl.get());
+			return buildExpr(binaryDecl->rightDecl.get());
+		default:
+			break;
+		}
+
+		const Opcode_e op = toIrOp(codegen::getBinaryOpCode(binaryDecl->op));
+
+		if (codegen::isCompoundAssign(binaryDecl->op))
+		{
+			return buildAssign(binaryDecl->leftDecl.get(), binaryDecl->rightDecl.get(), op, false);
+		}
+
+		Instruction* const lhs = buildExpr(binaryDecl->leftDecl.get());
+		Instruction* const rhs = buildExpr(binaryDecl->rightDecl.get());
+		return emitBinary(op, lhs, rhs);
+	}
+
+	Instruction*
+	IrBuilder::buildUnary(ast::expr::ExpressionUnaryDecl* const unaryDecl)
+	{
+		switch (unaryDecl->op)
+		{
+		case TokenType_e::Increment:
+		case TokenType_e::Decrement:
+			return buildAssign(
+				unaryDecl->exprDecl.get(),
+				nullptr,
+				unaryDecl->op == TokenType_e::Increment ? Opcode_e::Add : Opcode_e::Sub,
+				unaryDecl->unaryType == ExpressionUnaryType_e::Posfix
+			);
+		case TokenType_e::Minus:
+		case TokenType_e::BitWiseNot:
+			{
+				Instruction* const value = buildExpr(unaryDecl->exprDecl.get());
+
+				Instruction* const result = emit(
+					unaryDecl->op == TokenType_e::Minus ? Opcode_e::Neg : Opcode_e::BitNot,
+					isNumberType(value->type) ? value->type : Type_e::Any
+				);
+				result->appendOperand(value);
+				return result;
+			}
+		case TokenType_e::LogicalNot:
+			{
+				Instruction* const value = buildExpr(unaryDecl->exprDecl.get());
+
+				Instruction* const result = emit(Opcode_e::Not, Type_e::Bool);
+				result->appendOperand(value);
+				return result;
+			}
+		default:
+			// 'ref' e 'shared' restringem a posse mas nao mudam o valor.
+			return buildExpr(unaryDecl->exprDecl.get());
+		}
+	}
+
+	void
+	IrBuilder::buildCondition(ast::expr::ExpressionDecl* const conditionDecl, Block* const trueBlock, Block* const falseBlock)
+	{
+		if (conditionDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = conditionDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op == TokenType_e::LogicalAnd || binaryDecl->op == TokenType_e::LogicalOr)
+			{
+				Block* const rhsBlock = createBlock(false);
+
+				if (binaryDecl->op == TokenType_e::LogicalAnd)
+				{
+					buildCondition(binaryDecl->leftDecl.get(), rhsBlock, falseBlock);
+				}
+				else
+				{
+					buildCondition(binaryDecl->leftDecl.get(), trueBlock, rhsBlock);
+				}
+				sealBlock(rhsBlock);
+
+				setBlock(rhsBlock);
+				buildCondition(binaryDecl->rightDecl.get(), trueBlock, falseBlock);
+				return;
+			}
+		}
+		else if (conditionDecl->nodeType == AstNodeType_e::UnaryExpr)
+		{
+			auto unaryDecl = conditionDecl->to<ast::expr::ExpressionUnaryDecl>();
+
+			if (unaryDecl->op == TokenType_e::LogicalNot)
+			{
+				buildCondition(unaryDecl->exprDecl.get(), falseBlock, trueBlock);
+				return;
+			}
+		}
+
+		emitBranch(buildExpr(conditionDecl), trueBlock, falseBlock);
+	}
+
+	Instruction*
+	IrBuilder::buildShortCircuit(ast::expr::ExpressionBinaryDecl* const binaryDecl)
+	{
+		// O resultado e o valor do ultimo operando avaliado.
+		Instruction* const lhs = buildExpr(binaryDecl->leftDecl.get());
+
+		Block* const rhsBlock = createBlock(false);
+		Block* const mergeBlock = createBlock(false);
+
+		if (binaryDecl->op == TokenType_e::LogicalAnd)
+		{
+			emitBranch(lhs, rhsBlock, mergeBlock);
+		}
+		else
+		{
+			emitBranch(lhs, mergeBlock, rhsBlock);
+		}
+		sealBlock(rhsBlock);
+
+		setBlock(rhsBlock);
+		Instruction* const rhs = buildExpr(binaryDecl->rightDecl.get());
+		emitJump(mergeBlock);
+
+		sealBlock(mergeBlock);
+		setBlock(mergeBlock);
+		return emitPhi(mergeBlock, { lhs, rhs });
+	}
+
+	Instruction*
+	IrBuilder::buildSafeAccess(Instruction* const object, const std::function<Instruction*()>& access)
+	{
+		Instruction* const null = emitNull();
+		Instruction* const isNull = emitBinary(Opcode_e::Equal, object, null);
+
+		Block* const accessBlock = createBlock(false);
+		Block* const mergeBlock = createBlock(false);
+
+		emitBranch(isNull, mergeBlock, accessBlock);
+		sealBlock(accessBlock);
+
+		setBlock(accessBlock);
+		Instruction* const value = access();
+		emitJump(mergeBlock);
+
+		sealBlock(mergeBlock);
+		setBlock(mergeBlock);
+		return emitPhi(mergeBlock, { null, value });
+	}
+
+	Instruction*
+	IrBuilder::buildCall(ast::expr::ExpressionDecl* const lhsDecl, ast::expr::ExpressionDecl* const argumentsDecl)
+	{
+		auto binaryDecl = lhsDecl->nodeType == AstNodeType_e::BinaryExpr
+			? lhsDecl->to<ast::expr::ExpressionBinaryDecl>()
+			: nullptr;
+
+		// Chamada de metodo: o objeto e o primeiro operando.
+		if (binaryDecl && (binaryDecl->op == TokenType_e::Dot || binaryDecl->op == TokenType_e::SafeDot))
+		{
+			auto rightDecl = binaryDecl->rightDecl.get();
+			FrameSlot* const frameSlot = getSlot(rightDecl);
+
+			if (frameSlot->getSlotType() == SlotType_e::Function)
+			{
+				// super.metodo()
+				std::vector<Instruction*> operandList { getThis() };
+				buildArguments(argumentsDecl, operandList);
+
+				auto function = mProgram->getFunction(frameSlot->getIndex());
+				return emitCall(Opcode_e::Call, getDeclaredType(getReturnTypeDecl(function->decl)), frameSlot->getIndex(), operandList);
+			}
+
+			Instruction* const object = buildExpr(binaryDecl->leftDecl.get());
+			const String methodName = getIdentifier(rightDecl->identifier);
+
+			auto callMethod = [this, object, &methodName, argumentsDecl]() {
+				std::vector<Instruction*> operandList { object };
+				buildArguments(argumentsDecl, operandList);
+
+				Instruction* const call = emitCall(Opcode_e::CallMethod, Type_e::Any, invalidIndex, operandList);
+				call->name = methodName;
+				return call;
+			};
+
+			return binaryDecl->op == TokenType_e::SafeDot
+				? buildSafeAccess(object, callMethod)
+				: callMethod();
+		}
+
+		FrameSlot* const frameSlot = getSlot(lhsDecl);
+
+		if (frameSlot != nullptr)
+		{
+			switch (frameSlot->getSlotType())
+			{
+			case SlotType_e::Function:
+				{
+					// Chamada direta de uma funcao conhecida ou do construtor base.
+					std::vector<Instruction*> operandList;
+					if (lhsDecl->nodeType == AstNodeType_e::SuperExpr)
+					{
+						operandList.push_back(getThis());
+					}
+					buildArguments(argumentsDecl, operandList);
+
+					auto function = mProgram->getFunction(frameSlot->getIndex());
+					return emitCall(Opcode_e::Call, getDeclaredType(getReturnTypeDecl(function->decl)), frameSlot->getIndex(), operandList);
+				}
+			case SlotType_e::Method:
+				{
+					// Metodo da propria classe chamado sem 'this'.
+					std::vector<Instruction*> operandList { getThis() };
+					buildArguments(argumentsDecl, operandList);
+
+					Instruction* const call = emitCall(Opcode_e::CallMethod, Type_e::Any, invalidIndex, operandList);
+					call->name = binaryDecl
+						? getIdentifier(binaryDecl->rightDecl->identifier)
+						: getIdentifier(lhsDecl->identifier);
+					return call;
+				}
+			default:
+				break;
+			}
+		}
+
+		// Valor chamavel em tempo de execucao.
+		std::vector<Instruction*> operandList { buildExpr(lhsDecl) };
+		buildArguments(argumentsDecl, operandList);
+
+		return emitCall(Opcode_e::CallValue, Type_e::Any, invalidIndex, operandList);
+	}
+
+	Instruction*
+	IrBuilder::buildNew(ast::expr::ExpressionNewDecl* const newDecl)
+	{
+		std::vector<Instruction*> argumentList;
+		buildArguments(newDecl->exprDecl.get(), argumentList);
+
+		// A instrucao executa a inicializacao dos campos e o construtor.
+		Instruction* const object = emitCall(Opcode_e::New, Type_e::Object, newDecl->objTypeDecl->getAttribute<attributes::ResolvedType>()->getHandle(), argumentList);
+		object->auxIndex = getSlot(newDecl)->getIndex();
+
+		// Bloco de inicializacao: new Foo { a: 1, b }
+		if (newDecl->objInitBlockDecl)
+		{
+			for (auto& itemDecl : newDecl->objInitBlockDecl->itemDeclList)
+			{
+				Instruction* const value = buildExpr(itemDecl->exprDecl.get());
+
+				Instruction* const store = emit(Opcode_e::StoreField, Type_e::Void);
+				store->index = getSlot(itemDecl.get())->getIndex();
+				store->name = getIdentifier(itemDecl->identifier);
+				store->appendOperand(object);
+				store->appendOperand(value);
+			}
+		}
+		return object;
+	}
+
+	Instruction*
+	IrBuilder::buildAssign(ast::expr::ExpressionDecl* const targetDecl, ast::expr::ExpressionDecl* const valueDecl, Opcode_e op, Bool postfix)
+	{
+		auto computeResult = [this, valueDecl, op](Instruction* const current) {
+			Instruction* const rhs = valueDecl
+				? buildExpr(valueDecl)
+				: emitConstant(vm::makeInteger(vm::ValueType_e::I32, 1));
+
+			return op == assignOnly ? rhs : emitBinary(op, current, rhs);
+		};
+
+		if (targetDecl->nodeType == AstNodeType_e::IndexExpr)
+		{
+			auto indexDecl = targetDecl->to<ast::expr::ExpressionIndexDecl>();
+
+			Instruction* const object = buildExpr(indexDecl->lhsDecl.get());
+			Instruction* const index = buildExpr(indexDecl->rhsDecl.get());
+			Instruction* current = nullptr;
+
+			if (op != assignOnly)
+			{
+				current = emit(Opcode_e::LoadIndex, Type_e::Any);
+				current->appendOperand(object);
+				current->appendOperand(index);
+			}
+
+			Instruction* const result = computeResult(current);
+
+			Instruction* const store = emit(Opcode_e::StoreIndex, Type_e::Void);
+			store->appendOperand(object);
+			store->appendOperand(index);
+			store->appendOperand(result);
+
+			return postfix ? current : result;
+		}
+
+		if (targetDecl->nodeType == AstNodeType_e::BinaryExpr && targetDecl->to<ast::expr::ExpressionBinaryDecl>()->op == TokenType_e::Dot)
+		{
+			auto binaryDecl = targetDecl->to<ast::expr::ExpressionBinaryDecl>();
+			const String fieldName = getIdentifier(binaryDecl->rightDecl->identifier);
+
+			Instruction* const object = buildExpr(binaryDecl->leftDecl.get());
+			Instruction* current = nullptr;
+
+			if (op != assignOnly)
+			{
+				current = emit(Opcode_e::LoadField, Type_e::Any);
+				current->name = fieldName;
+				current->appendOperand(object);
+			}
+
+			Instruction* const result = computeResult(current);
+
+			Instruction* const store = emit(Opcode_e::StoreField, Type_e::Void);
+			store->name = fieldName;
+			store->appendOperand(object);
+			store->appendOperand(result);
+
+			return postfix ? current : result;
+		}
+
+		// Variavel local, campo do 'this' ou variavel global.
+		Instruction* const current = op != assignOnly
+			? loadSlot(targetDecl)
+			: nullptr;
+
+		Instruction* const result = computeResult(current);
+		storeSlot(targetDecl, result);
+
+		return postfix ? current : result;
+	}
+
+	Instruction*
+	IrBuilder::buildPatternTest(ast::pattern::PatternDecl* const patternDecl, Instruction* const subject)
+	{
+		auto literalPatternDecl = patternDecl->to<ast::pattern::LiteralPatternDecl>();
+
+		if (literalPatternDecl->literalExpr)
+		{
+			return emitBinary(Opcode_e::Equal, subject, buildExpr(literalPatternDecl->literalExpr.get()));
+		}
+
+		FrameSlot* const frameSlot = getSlot(patternDecl);
+
+		// '_' aceita qualquer valor.
+		if (frameSlot == nullptr)
+		{
+			return nullptr;
+		}
+
+		switch (frameSlot->getSlotType())
+		{
+		case SlotType_e::Local:
+			// Captura o valor em uma nova variavel.
+			writeVariable(frameSlot->getIndex(), mBlock, subject);
+			return nullptr;
+		case SlotType_e::EnumItem:
+			return emitBinary(Opcode_e::Equal, subject, emitConstant(vm::makeInteger(vm::ValueType_e::I32, frameSlot->getValue())));
+		default:
+			return emitBinary(Opcode_e::Equal, subject, loadSlot(patternDecl));
+		}
+	}
+
+	void
+	IrBuilder::buildArguments(ast::expr::ExpressionDecl* const argumentsDecl, std::vector<Instruction*>& argumentList)
+	{
+		if (argumentsDecl == nullptr)
+		{
+			return;
+		}
+
+		// Os argumentos chegam como uma cadeia de operadores ','.
+		if (argumentsDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = argumentsDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op == TokenType_e::Comma)
+			{
+				buildArguments(binaryDecl->leftDecl.get(), argumentList);
+				buildArguments(binaryDecl->rightDecl.get(), argumentList);
+				return;
+			}
+		}
+		argumentList.push_back(buildExpr(argumentsDecl));
+	}
+
+	Instruction*
+	IrBuilder::emitCall(Opcode_e op, Type_e type, U32 index, const std::vector<Instruction*>& operandList)
+	{
+		Instruction* const call = emit(op, type);
+		call->index = index;
+
+		for (auto operand : operandList)
+		{
+			call->appendOperand(operand);
+		}
+		return call;
+	}
+
+	Instruction*
+	IrBuilder::loadSlot(ast::AstNode* const node)
+	{
+		FrameSlot* const frameSlot = getSlot(node);
+
+		switch (frameSlot->getSlotType())
+		{
+		case SlotType_e::Local:
+			return readVariable(frameSlot->getIndex(), mBlock);
+		case SlotType_e::Field:
+			{
+				Instruction* const load = emit(Opcode_e::LoadField, Type_e::Any);
+				load->index = frameSlot->getIndex();
+				load->name = getIdentifier(node->identifier);
+				load->appendOperand(getThis());
+				return load;
+			}
+		case SlotType_e::Global:
+			{
+				Instruction* const load = emit(Opcode_e::LoadGlobal, Type_e::Any);
+				load->index = frameSlot->getIndex();
+				return load;
+			}
+		case SlotType_e::Function:
+			{
+				Instruction* const function = emit(Opcode_e::FunctionRef, Type_e::Function);
+				function->index = frameSlot->getIndex();
+				return function;
+			}
+		case SlotType_e::EnumItem:
+			return emitConstant(vm::makeInteger(vm::ValueType_e::I32, frameSlot->getValue()));
+		case SlotType_e::Constant:
+			{
+				Instruction* const constant = emit(Opcode_e::Constant, Type_e::String);
+				constant->index = frameSlot->getIndex();
+				return constant;
+			}
+		default:
+			throw exceptions::custom_exception(
+				"Invalid slot for '%s'",
+				node->line,
+				node->column,
+				getIdentifier(node->identifier).c_str()
+			);
+		}
+	}
+
+	void
+	IrBuilder::storeSlot(ast::AstNode* const node, Instruction* const value)
+	{
+		FrameSlot* const frameSlot = getSlot(node);
+
+		switch (frameSlot->getSlotType())
+		{
+		case SlotType_e::Local:
+			writeVariable(frameSlot->getIndex(), mBlock, value);
+			break;
+		case SlotType_e::Field:
+			{
+				Instruction* const store = emit(Opcode_e::StoreField, Type_e::Void);
+				store->index = frameSlot->getIndex();
+				store->name = getIdentifier(node->identifier);
+				store->appendOperand(getThis());
+				store->appendOperand(value);
+			}
+			break;
+		case SlotType_e::Global:
+			{
+				Instruction* const store = emit(Opcode_e::StoreGlobal, Type_e::Void);
+				store->index = frameSlot->getIndex();
+				store->appendOperand(value);
+			}
+			break;
+		default:
+			throw exceptions::custom_exception(
+				"Invalid assignment target",
+				node->line,
+				node->column
+			);
+		}
+	}
+
+	Instruction*
+	IrBuilder::getThis()
+	{
+		return readVariable(0, mBlock);
+	}
+
+	Type_e
+	IrBuilder::getDeclaredType(ast::TypeDecl* const typeDecl)
+	{
+		if (typeDecl == nullptr)
+		{
+			return Type_e::Void;
+		}
+
+		switch (typeDecl->nodeType)
+		{
+		case AstNodeType_e::PrimitiveType:
+			return toType(typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType);
+		case AstNodeType_e::NamedType:
+			return Type_e::Object;
+		case AstNodeType_e::ArrayType:
+			return Type_e::Array;
+		case AstNodeType_e::FunctionType:
+			return Type_e::Function;
+		default:
+			return Type_e::Any;
+		}
+	}
+
+	void
+	IrBuilder::writeVariable(U32 slot, Block* const block, Instruction* const value)
+	{
+		mBlockStateList[block->id].definitionMap[slot] = value;
+	}
+
+	Instruction*
+	IrBuilder::readVariable(U32 slot, Block* const block)
+	{
+		auto& definitionMap = mBlockStateList[block->id].definitionMap;
+		auto it = definitionMap.find(slot);
+
+		if (it != definitionMap.end())
+		{
+			return resolveReplacement(it->second);
+		}
+		return readVariableRecursive(slot, block);
+	}
+
+	Instruction*
+	IrBuilder::readVariableRecursive(U32 slot, Block* const block)
+	{
+		auto& blockState = mBlockStateList[block->id];
+		Instruction* value = nullptr;
+
+		if (!blockState.sealed)
+		{
+			// Os predecessores ainda nao sao conhecidos.
+			value = block->insertAt(0, std::make_unique<Instruction>(Opcode_e::Phi, Type_e::Any));
+			value->line = mLine;
+			blockState.incompletePhiList.emplace_back(slot, value);
+		}
+		else if (block->predecessorList.size() == 1)
+		{
+			value = readVariable(slot, block->predecessorList[0]);
+		}
+		else if (block->predecessorList.empty())
+		{
+			// Variavel lida antes de ser escrita.
+			auto undefined = std::make_unique<Instruction>(Opcode_e::Constant, Type_e::Null);
+			value = mFunction->getEntry()->insertAt(0, std::move(undefined));
+		}
+		else
+		{
+			// A escrita antes da leitura dos predecessores quebra os ciclos.
+			Instruction* const phi = block->insertAt(0, std::make_unique<Instruction>(Opcode_e::Phi, Type_e::Any));
+			phi->line = mLine;
+
+			writeVariable(slot, block, phi);
+			value = addPhiOperands(slot, phi);
+		}
+
+		writeVariable(slot, block, value);
+		return value;
+	}
+
+	Instruction*
+	IrBuilder::addPhiOperands(U32 slot, Instruction* const phi)
+	{
+		mPendingPhiList.push_back(phi);
+
+		// Copia: a leitura pode criar phis em outros blocos, mas nao altera os predecessores.
+		const std::vector<Block*> predecessorList = phi->block->predecessorList;
+		for (auto predecessor : predecessorList)
+		{
+			phi->appendOperand(readVariable(slot, predecessor));
+		}
+
+		mPendingPhiList.erase(std::find(mPendingPhiList.begin(), mPendingPhiList.end(), phi));
+		return tryRemoveTrivialPhi(phi);
+	}
+
+	Instruction*
+	IrBuilder::tryRemoveTrivialPhi(Instruction* const phi)
+	{
+		Instruction* same = nullptr;
+
+		for (auto operand : phi->operandList)
+		{
+			if (operand == same || operand == phi)
+			{
+				continue;
+			}
+
+			if (same != nullptr)
+			{
+				// O phi une ao menos dois valores.
+				phi->type = joinTypes(phi);
+				return phi;
+			}
+			same = operand;
+		}
+
+		if (same == nullptr)
+		{
+			// Phi inalcancavel ou apenas com referencias a si mesmo.
+			auto undefined = std::make_unique<Instruction>(Opcode_e::Constant, Type_e::Null);
+			same = mFunction->getEntry()->insertAt(0, std::move(undefined));
+		}
+
+		std::vector<Instruction*> userList;
+		for (auto user : phi->userList)
+		{
+			if (user != phi && std::find(userList.begin(), userList.end(), user) == userList.end())
+			{
+				userList.push_back(user);
+			}
+		}
+
+		phi->replaceAllUsesWith(same);
+		phi->dropOperands();
+
+		mReplacementMap[phi] = same;
+		mRemovedList.push_back(phi->block->remove(phi));
+
+		// Os phis que usavam este phi podem ter se tornado triviais.
+		for (auto user : userList)
+		{
+			if (user->op == Opcode_e::Phi && user->block != nullptr
+				&& std::find(mPendingPhiList.begin(), mPendingPhiList.end(), user) == mPendingPhiList.end())
+			{
+				tryRemoveTrivialPhi(user);
+			}
+		}
+		return resolveReplacement(same);
+	}
+
+	Instruction*
+	IrBuilder::resolveReplacement(Instruction* value)
+	{
+		auto it = mReplacementMap.find(value);
+
+		while (it != mReplacementMap.end())
+		{
+			value = it->second;
+			it = mReplacementMap.find(value);
+		}
+		return value;
+	}
+
+	void
+	IrBuilder::inferTypes()
+	{
+		auto isInferred = [](Instruction* const instruction) {
+			return instruction->op == Opcode_e::Phi
+				|| instruction->op == Opcode_e::Neg
+				|| instruction->op == Opcode_e::BitNot
+				|| isBinary(instruction->op);
+		};
+
+		// Tipos ainda desconhecidos, ignorados pelos phis.
+		std::unordered_set<Instruction*> unknownSet;
+
+		const std::vector<Block*> blockList = mFunction->getReversePostOrder();
+		for (auto block : blockList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				if (isInferred(instruction.get()))
+				{
+					unknownSet.insert(instruction.get());
+				}
+			}
+		}
+
+		Bool changed = true;
+		while (changed)
+		{
+			changed = false;
+
+			for (auto block : blockList)
+			{
+				for (auto& instruction : block->instructionList)
+				{
+					if (!isInferred(instruction.get()))
+					{
+						continue;
+					}
+
+					Type_e type = Type_e::Void;
+					Bool known = true;
+
+					if (instruction->op == Opcode_e::Phi)
+					{
+						known = false;
+						for (auto operand : instruction->operandList)
+						{
+							if (unknownSet.find(operand) != unknownSet.end())
+							{
+								continue;
+							}
+							type = !known || type == operand->type ? operand->type : Type_e::Any;
+							known = true;
+						}
+					}
+					else
+					{
+						for (auto operand : instruction->operandList)
+						{
+							known &= unknownSet.find(operand) == unknownSet.end();
+						}
+
+						if (known)
+						{
+							type = instruction->operandList.size() == 2
+								? getBinaryType(instruction->op, instruction->operandList[0]->type, instruction->operandList[1]->type)
+								: (isNumberType(instruction->operandList[0]->type) ? instruction->operandList[0]->type : Type_e::Any);
+						}
+					}
+
+					if (!known)
+					{
+						continue;
+					}
+
+					if (unknownSet.erase(instruction.get()) || instruction->type != type)
+					{
+						instruction->type = type;
+						changed = true;
+					}
+				}
+			}
+		}
+
+		// Valores que so dependem de si mesmos.
+		for (auto instruction : unknownSet)
+		{
+			instruction->type = Type_e::Any;
+		}
+	}
+
+	Block*
+	IrBuilder::createBlock(Bool sealed)
+	{
+		Block* const block = mFunction->createBlock();
+
+		if (mBlockStateList.size() <= block->id)
+		{
+			mBlockStateList.resize(block->id + 1);
+		}
+		mBlockStateList[block->id].sealed = sealed;
+		return block;
+	}
+
+	void
+	IrBuilder::sealBlock(Block* const block)
+	{
+		auto& blockState = mBlockStateList[block->id];
+
+		// A lista pode crescer enquanto os operandos sao adicionados.
+		while (blockState.incompletePhiList.size())
+		{
+			const std::vector<std::pair<U32, Instruction*>> incompletePhiList = std::move(blockState.incompletePhiList);
+			blockState.incompletePhiList.clear();
+
+			for (auto& incompletePhi : incompletePhiList)
+			{
+				addPhiOperands(incompletePhi.first, incompletePhi.second);
+			}
+		}
+		blockState.sealed = true;
+	}
+
+	void
+	IrBuilder::setBlock(Block* const block)
+	{
+		mBlock = block;
+	}
+
+	Instruction*
+	IrBuilder::emit(Opcode_e op, Type_e type)
+	{
+		auto instruction = std::make_unique<Instruction>(op, type);
+		instruction->line = mLine;
+		return mBlock->append(std::move(instruction));
+	}
+
+	Instruction*
+	IrBuilder::emitConstant(const vm::Value_s& value)
+	{
+		Instruction* const constant = emit(Opcode_e::Constant, toType(value.type));
+		constant->value = value;
+		return constant;
+	}
+
+	Instruction*
+	IrBuilder::emitNull()
+	{
+		return emitConstant(vm::makeNull());
+	}
+
+	Instruction*
+	IrBuilder::emitBinary(Opcode_e op, Instruction* const lhs, Instruction* const rhs)
+	{
+		Instruction* const result = emit(op, getBinaryType(op, lhs->type, rhs->type));
+		result->appendOperand(lhs);
+		result->appendOperand(rhs);
+		return result;
+	}
+
+	Instruction*
+	IrBuilder::emitPhi(Block* const block, const std::vector<Instruction*>& valueList)
+	{
+		// Todos os caminhos trazem o mesmo valor.
+		if (std::all_of(valueList.begin(), valueList.end(), [&valueList](Instruction* value) { return value == valueList.front(); }))
+		{
+			return valueList.front();
+		}
+
+		U32 position = 0;
+		while (position < block->instructionList.size() && block->instructionList[position]->op == Opcode_e::Phi)
+		{
+			position++;
+		}
+
+		Instruction* const phi = block->insertAt(position, std::make_unique<Instruction>(Opcode_e::Phi, Type_e::Any));
+		phi->line = mLine;
+
+		for (auto value : valueList)
+		{
+			phi->appendOperand(value);
+		}
+		phi->type = joinTypes(phi);
+		return phi;
+	}
+
+	void
+	IrBuilder::emitJump(Block* const target)
+	{
+		Instruction* const jump = emit(Opcode_e::Jump, Type_e::Void);
+		jump->targetList.push_back(target);
+
+		target->predecessorList.push_back(mBlock);
+	}
+
+	void
+	IrBuilder::emitBranch(Instruction* const condition, Block* const trueBlock, Block* const falseBlock)
+	{
+		Instruction* const branch = emit(Opcode_e::Branch, Type_e::Void);
+		branch->appendOperand(condition);
+		branch->targetList.push_back(trueBlock);
+		branch->targetList.push_back(falseBlock);
+
+		trueBlock->predecessorList.push_back(mBlock);
+		falseBlock->predecessorList.push_back(mBlock);
+	}
+
+	void
+	IrBuilder::emitReturn(Instruction* const value)
+	{
+		Instruction* const ret = emit(Opcode_e::Return, Type_e::Void);
+
+		if (value)
+		{
+			ret->appendOperand(value);
+		}
+	}
+
+	Bool
+	IrBuilder::isTerminated()
+	{
+		return mBlock->getTerminator() != nullptr;
+	}
+} }
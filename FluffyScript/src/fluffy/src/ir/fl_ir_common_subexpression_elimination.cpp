@@ -0,0 +1,263 @@
+#include <cstring>
+#include "ir/fl_ir_common_subexpression_elimination.h"
+namespace fluffy { namespace ir {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static Bool
+	isEligible(Instruction* const instruction)
+	{
+		if (isBinary(instruction->op))
+		{
+			return true;
+		}
+
+		switch (instruction->op)
+		{
+		case Opcode_e::Constant:
+		case Opcode_e::FunctionRef:
+		case Opcode_e::Neg:
+		case Opcode_e::BitNot:
+		case Opcode_e::Not:
+		case Opcode_e::Cast:
+		case Opcode_e::IsType:
+		case Opcode_e::IsClass:
+		case Opcode_e::CastClass:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static U64
+	getValueBits(Instruction* const instruction)
+	{
+		if (!instruction->isConstant() || instruction->type == Type_e::String)
+		{
+			return 0;
+		}
+
+		const vm::Value_s& value = instruction->value;
+
+		switch (value.type)
+		{
+		case vm::ValueType_e::Null:
+			return 0;
+		case vm::ValueType_e::Bool:
+			return value.boolValue ? 1 : 0;
+		case vm::ValueType_e::Fp32:
+		case vm::ValueType_e::Fp64:
+			{
+				U64 bits = 0;
+				std::memcpy(&bits, &value.realValue, sizeof(bits));
+				return bits;
+			}
+		default:
+			return static_cast<U64>(value.integerValue);
+		}
+	}
+
+	static ExpressionKey_s
+	makeKey(Instruction* const instruction)
+	{
+		ExpressionKey_s key;
+		key.op = instruction->op;
+		key.type = instruction->type;
+		key.index = instruction->index;
+		key.primitiveType = instruction->primitiveType;
+		key.valueBits = getValueBits(instruction);
+		key.operandList = instruction->operandList;
+
+		// Operacoes comutativas usam uma ordem canonica dos operandos.
+		switch (instruction->op)
+		{
+		case Opcode_e::Add:
+		case Opcode_e::Mul:
+		case Opcode_e::BitAnd:
+		case Opcode_e::BitOr:
+		case Opcode_e::BitXor:
+		case Opcode_e::Equal:
+		case Opcode_e::NotEqual:
+			if (key.operandList[1] < key.operandList[0])
+			{
+				std::swap(key.operandList[0], key.operandList[1]);
+			}
+			break;
+		default:
+			break;
+		}
+		return key;
+	}
+
+	/**
+	 * ExpressionKey_s
+	 */
+
+	Bool
+	ExpressionKey_s::operator==(const ExpressionKey_s& other) const
+	{
+		return op == other.op
+			&& type == other.type
+			&& index == other.index
+			&& primitiveType == other.primitiveType
+			&& valueBits == other.valueBits
+			&& operandList == other.operandList;
+	}
+
+	/**
+	 * ExpressionKeyHash_s
+	 */
+
+	size_t
+	ExpressionKeyHash_s::operator()(const ExpressionKey_s& key) const
+	{
+		size_t hash = std::hash<U64>()(key.valueBits);
+
+		hash = hash * 31 + static_cast<size_t>(key.op);
+		hash = hash * 31 + static_cast<size_t>(key.type);
+		hash = hash * 31 + key.index;
+		hash = hash * 31 + static_cast<size_t>(key.primitiveType);
+
+		for (auto operand : key.operandList)
+		{
+			hash = hash * 31 + std::hash<Instruction*>()(operand);
+		}
+		return hash;
+	}
+
+	/**
+	 * CommonSubexpressionElimination
+	 */
+
+	CommonSubexpressionElimination::CommonSubexpressionElimination()
+		: Pass("common-subexpression-elimination")
+	{}
+
+	CommonSubexpressionElimination::~CommonSubexpressionElimination()
+	{}
+
+	Bool
+	CommonSubexpressionElimination::run(Module* const, Function* const function)
+	{
+		computeDominators(function);
+
+		const Bool changed = processBlock(function->getEntry());
+
+		mReversePostOrder.clear();
+		mOrderMap.clear();
+		mDominatorMap.clear();
+		mChildrenMap.clear();
+		mAvailableMap.clear();
+		return changed;
+	}
+
+	void
+	CommonSubexpressionElimination::computeDominators(Function* const function)
+	{
+		mReversePostOrder = function->getReversePostOrder();
+
+		for (U32 i = 0; i < mReversePostOrder.size(); i++)
+		{
+			mOrderMap[mReversePostOrder[i]] = i;
+		}
+
+		Block* const entry = function->getEntry();
+		mDominatorMap[entry] = entry;
+
+		auto intersect = [this](Block* a, Block* b) {
+			while (a != b)
+			{
+				while (mOrderMap[a] > mOrderMap[b])
+				{
+					a = mDominatorMap[a];
+				}
+				while (mOrderMap[b] > mOrderMap[a])
+				{
+					b = mDominatorMap[b];
+				}
+			}
+			return a;
+		};
+
+		Bool changed = true;
+		while (changed)
+		{
+			changed = false;
+
+			for (size_t i = 1; i < mReversePostOrder.size(); i++)
+			{
+				Block* const block = mReversePostOrder[i];
+				Block* dominator = nullptr;
+
+				for (auto predecessor : block->predecessorList)
+				{
+					if (mDominatorMap.find(predecessor) == mDominatorMap.end())
+					{
+						continue;
+					}
+					dominator = dominator ? intersect(predecessor, dominator) : predecessor;
+				}
+
+				auto it = mDominatorMap.find(block);
+				if (it == mDominatorMap.end() || it->second != dominator)
+				{
+					mDominatorMap[block] = dominator;
+					changed = true;
+				}
+			}
+		}
+
+		for (size_t i = 1; i < mReversePostOrder.size(); i++)
+		{
+			Block* const block = mReversePostOrder[i];
+			mChildrenMap[mDominatorMap[block]].push_back(block);
+		}
+	}
+
+	Bool
+	CommonSubexpressionElimination::processBlock(Block* const block)
+	{
+		Bool changed = false;
+
+		// Expressoes adicionadas por este bloco, removidas ao sair do escopo.
+		std::vector<ExpressionKey_s> scopeList;
+
+		for (size_t i = 0; i < block->instructionList.size();)
+		{
+			Instruction* const instruction = block->instructionList[i].get();
+
+			if (!isEligible(instruction))
+			{
+				i++;
+				continue;
+			}
+
+			ExpressionKey_s key = makeKey(instruction);
+			auto it = mAvailableMap.find(key);
+
+			if (it != mAvailableMap.end())
+			{
+				instruction->replaceAllUsesWith(it->second);
+				block->erase(instruction);
+				changed = true;
+				continue;
+			}
+
+			mAvailableMap.emplace(key, instruction);
+			scopeList.push_back(std::move(key));
+			i++;
+		}
+
+		for (auto child : mChildrenMap[block])
+		{
+			changed |= processBlock(child);
+		}
+
+		for (auto& key : scopeList)
+		{
+			mAvailableMap.erase(key);
+		}
+		return changed;
+	}
+} }
@@ -0,0 +1,218 @@
+#include "ir/fl_ir_constant_propagation.h"
+namespace fluffy { namespace ir {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	// Strings constantes sao indices do programa, nao valores avaliaveis.
+	static Bool
+	isFoldable(Instruction* const value)
+	{
+		return value->isConstant() && value->type != Type_e::String;
+	}
+
+	static void
+	replaceWithConstant(Instruction* const instruction, const vm::Value_s& value)
+	{
+		instruction->dropOperands();
+		instruction->op = Opcode_e::Constant;
+		instruction->type = toType(value.type);
+		instruction->value = value;
+	}
+
+	/**
+	 * ConstantPropagation
+	 */
+
+	ConstantPropagation::ConstantPropagation()
+		: Pass("constant-propagation")
+	{}
+
+	ConstantPropagation::~ConstantPropagation()
+	{}
+
+	Bool
+	ConstantPropagation::run(Module* const, Function* const function)
+	{
+		Bool changed = false;
+
+		// Em pos-ordem reversa os operandos sao visitados antes dos usuarios,
+		// exceto pelos phis dos lacos.
+		for (auto block : function->getReversePostOrder())
+		{
+			for (size_t i = 0; i < block->instructionList.size();)
+			{
+				Instruction* const instruction = block->instructionList[i].get();
+
+				if (instruction->op == Opcode_e::Phi && foldPhi(instruction))
+				{
+					changed = true;
+					continue;
+				}
+
+				if (instruction->op == Opcode_e::Branch && foldBranch(instruction))
+				{
+					changed = true;
+					break;
+				}
+
+				changed |= foldInstruction(instruction);
+				i++;
+			}
+		}
+
+		if (changed)
+		{
+			function->removeUnreachableBlocks();
+		}
+		return changed;
+	}
+
+	Bool
+	ConstantPropagation::foldInstruction(Instruction* const instruction)
+	{
+		vm::Value_s result;
+
+		if (isBinary(instruction->op))
+		{
+			Instruction* const lhs = instruction->operandList[0];
+			Instruction* const rhs = instruction->operandList[1];
+
+			if (!isFoldable(lhs) || !isFoldable(rhs))
+			{
+				return false;
+			}
+
+			const codegen::OpCode_e op = toBytecodeOp(instruction->op);
+
+			if (isComparison(instruction->op))
+			{
+				if (vm::computeComparison(op, lhs->value, rhs->value, result) != vm::OperationStatus_e::Success)
+				{
+					return false;
+				}
+			}
+			else if (vm::computeArithmetic(op, lhs->value, rhs->value, result) != vm::OperationStatus_e::Success)
+			{
+				return false;
+			}
+
+			replaceWithConstant(instruction, result);
+			return true;
+		}
+
+		switch (instruction->op)
+		{
+		case Opcode_e::Not:
+			if (!isFoldable(instruction->operandList[0]))
+			{
+				return false;
+			}
+			result = vm::makeBool(!vm::isTruthy(instruction->operandList[0]->value));
+			break;
+		case Opcode_e::Neg:
+			{
+				Instruction* const operand = instruction->operandList[0];
+
+				if (!operand->isConstant() || !isNumberType(operand->type))
+				{
+					return false;
+				}
+
+				const vm::Value_s& value = operand->value;
+				result = vm::isInteger(value.type)
+					? vm::makeInteger(value.type, static_cast<I64>(0 - static_cast<U64>(value.integerValue)))
+					: vm::makeReal(value.type, -value.realValue);
+			}
+			break;
+		case Opcode_e::BitNot:
+			{
+				Instruction* const operand = instruction->operandList[0];
+
+				if (!operand->isConstant() || !vm::isInteger(operand->value.type))
+				{
+					return false;
+				}
+				result = vm::makeInteger(operand->value.type, ~operand->value.integerValue);
+			}
+			break;
+		case Opcode_e::Cast:
+			if (!isFoldable(instruction->operandList[0])
+				|| !vm::computeCast(instruction->operandList[0]->value, instruction->primitiveType, result))
+			{
+				return false;
+			}
+			break;
+		case Opcode_e::IsType:
+			if (!isFoldable(instruction->operandList[0]))
+			{
+				return false;
+			}
+			result = vm::makeBool(instruction->operandList[0]->value.type == vm::toValueType(instruction->primitiveType));
+			break;
+		default:
+			return false;
+		}
+
+		replaceWithConstant(instruction, result);
+		return true;
+	}
+
+	Bool
+	ConstantPropagation::foldPhi(Instruction* const phi)
+	{
+		Instruction* same = nullptr;
+
+		for (auto operand : phi->operandList)
+		{
+			if (operand == phi || operand == same)
+			{
+				continue;
+			}
+
+			// Constantes iguais vindas de caminhos diferentes.
+			if (same != nullptr && !(isFoldable(same) && isFoldable(operand)
+				&& same->type == operand->type && vm::isEqual(same->value, operand->value)))
+			{
+				return false;
+			}
+
+			if (same == nullptr)
+			{
+				same = operand;
+			}
+		}
+
+		if (same == nullptr)
+		{
+			return false;
+		}
+
+		phi->replaceAllUsesWith(same);
+		phi->block->erase(phi);
+		return true;
+	}
+
+	Bool
+	ConstantPropagation::foldBranch(Instruction* const branch)
+	{
+		Instruction* const condition = branch->operandList[0];
+
+		if (!isFoldable(condition))
+		{
+			return false;
+		}
+
+		Block* const block = branch->block;
+		Block* const takenBlock = branch->targetList[vm::isTruthy(condition->value) ? 0 : 1];
+		Block* const untakenBlock = branch->targetList[vm::isTruthy(condition->value) ? 1 : 0];
+
+		// O phi do destino nao descartado continua com um operando por aresta.
+		untakenBlock->removePredecessor(block);
+
+		branch->dropOperands();
+		branch->op = Opcode_e::Jump;
+		branch->targetList = { takenBlock };
+		return true;
+	}
+} }
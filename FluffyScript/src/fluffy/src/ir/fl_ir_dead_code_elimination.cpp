@@ -0,0 +1,169 @@
+#include <unordered_set>
+#include "ir/fl_ir_dead_code_elimination.h"
+namespace fluffy { namespace ir {
+	/**
+	 * DeadCodeElimination
+	 */
+
+	DeadCodeElimination::DeadCodeElimination()
+		: Pass("dead-code-elimination")
+	{}
+
+	DeadCodeElimination::~DeadCodeElimination()
+	{}
+
+	Bool
+	DeadCodeElimination::run(Module* const, Function* const function)
+	{
+		Bool changed = function->removeUnreachableBlocks();
+
+		changed |= simplifyBranches(function);
+		changed |= removeDeadInstructions(function);
+		changed |= mergeBlocks(function);
+		return changed;
+	}
+
+	Bool
+	DeadCodeElimination::removeDeadInstructions(Function* const function)
+	{
+		std::unordered_set<Instruction*> liveSet;
+		std::vector<Instruction*> workList;
+
+		// Os parametros sao mantidos para preservar a assinatura da funcao.
+		for (auto& block : function->blockList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				if (instruction->mayTrap() || instruction->op == Opcode_e::Parameter)
+				{
+					liveSet.insert(instruction.get());
+					workList.push_back(instruction.get());
+				}
+			}
+		}
+
+		while (workList.size())
+		{
+			Instruction* const instruction = workList.back();
+			workList.pop_back();
+
+			for (auto operand : instruction->operandList)
+			{
+				if (liveSet.insert(operand).second)
+				{
+					workList.push_back(operand);
+				}
+			}
+		}
+
+		std::vector<Instruction*> deadList;
+		for (auto& block : function->blockList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				if (liveSet.find(instruction.get()) == liveSet.end())
+				{
+					deadList.push_back(instruction.get());
+				}
+			}
+		}
+
+		// As instrucoes mortas podem usar umas as outras, os operandos sao
+		// removidos antes de qualquer instrucao ser destruida.
+		for (auto instruction : deadList)
+		{
+			instruction->dropOperands();
+		}
+
+		for (auto instruction : deadList)
+		{
+			instruction->block->erase(instruction);
+		}
+		return deadList.size() > 0;
+	}
+
+	Bool
+	DeadCodeElimination::simplifyBranches(Function* const function)
+	{
+		Bool changed = false;
+
+		for (auto& block : function->blockList)
+		{
+			Instruction* const terminator = block->getTerminator();
+
+			// Desvio com os dois destinos iguais.
+			if (terminator->op == Opcode_e::Branch && terminator->targetList[0] == terminator->targetList[1])
+			{
+				Block* const target = terminator->targetList[0];
+				target->removePredecessor(block.get());
+
+				terminator->dropOperands();
+				terminator->op = Opcode_e::Jump;
+				terminator->targetList.pop_back();
+				changed = true;
+			}
+		}
+		return changed;
+	}
+
+	Bool
+	DeadCodeElimination::mergeBlocks(Function* const function)
+	{
+		Bool changed = false;
+
+		for (size_t i = 0; i < function->blockList.size(); i++)
+		{
+			Block* const block = function->blockList[i].get();
+
+			// Une o bloco ao seu sucessor enquanto ele for o unico predecessor.
+			for (;;)
+			{
+				Instruction* const terminator = block->getTerminator();
+				if (terminator->op != Opcode_e::Jump)
+				{
+					break;
+				}
+
+				Block* const successor = terminator->targetList[0];
+				if (successor == block || successor == function->getEntry() || successor->predecessorList.size() != 1)
+				{
+					break;
+				}
+
+				// Com um unico predecessor os phis tem um unico operando.
+				while (successor->instructionList.size() && successor->instructionList[0]->op == Opcode_e::Phi)
+				{
+					Instruction* const phi = successor->instructionList[0].get();
+
+					phi->replaceAllUsesWith(phi->operandList[0]);
+					successor->erase(phi);
+				}
+
+				block->erase(terminator);
+
+				for (auto& instruction : successor->instructionList)
+				{
+					instruction->block = block;
+					block->instructionList.push_back(std::move(instruction));
+				}
+				successor->instructionList.clear();
+
+				for (auto next : block->getSuccessorList())
+				{
+					next->replacePredecessor(successor, block);
+				}
+
+				function->eraseBlock(successor);
+				changed = true;
+
+				// O bloco apagado pode estar antes deste na lista.
+				i = 0;
+				while (function->blockList[i].get() != block)
+				{
+					i++;
+				}
+			}
+		}
+		return changed;
+	}
+} }
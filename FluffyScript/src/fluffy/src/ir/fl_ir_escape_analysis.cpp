@@ -0,0 +1,412 @@
+#include <algorithm>
+#include "ir/fl_ir_escape_analysis.h"
+namespace fluffy { namespace ir {
+	static constexpr const U32 noContent = 0xFFFFFFFF;
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static EscapeState_e
+	maxState(EscapeState_e stateA, EscapeState_e stateB)
+	{
+		return stateA > stateB ? stateA : stateB;
+	}
+
+	/**
+	 * EscapeAnalysis
+	 */
+
+	EscapeAnalysis::EscapeAnalysis(interpreter::Program* const program)
+		: mProgram(program)
+		, mModule(nullptr)
+	{}
+
+	EscapeAnalysis::~EscapeAnalysis()
+	{}
+
+	void
+	EscapeAnalysis::run(Module* const module)
+	{
+		mModule = module;
+		mSummaryMap.clear();
+		mAllocationMap.clear();
+
+		// Os resumos comecam sem escape e so crescem, o laco termina quando
+		// nenhum resumo muda em uma volta completa.
+		Bool changed = true;
+		while (changed)
+		{
+			changed = false;
+
+			for (U32 i = 0; i < module->getFunctionCount(); i++)
+			{
+				if (Function* const function = module->getFunction(i))
+				{
+					changed |= analyze(module, function);
+				}
+			}
+		}
+	}
+
+	EscapeState_e
+	EscapeAnalysis::getEscapeState(Instruction* const allocation)
+	{
+		auto it = mAllocationMap.find(allocation);
+		return it != mAllocationMap.end() ? it->second : EscapeState_e::GlobalEscape;
+	}
+
+	EscapeState_e
+	EscapeAnalysis::getParameterEscapeState(U32 functionIndex, U32 parameterIndex)
+	{
+		auto it = mSummaryMap.find(functionIndex);
+
+		if (it == mSummaryMap.end() || parameterIndex >= it->second.size())
+		{
+			return EscapeState_e::GlobalEscape;
+		}
+		return it->second[parameterIndex];
+	}
+
+	U32
+	EscapeAnalysis::getAllocationCount()
+	{
+		return static_cast<U32>(mAllocationMap.size());
+	}
+
+	U32
+	EscapeAnalysis::getLocalAllocationCount()
+	{
+		U32 count = 0;
+		for (auto& entry : mAllocationMap)
+		{
+			count += entry.second != EscapeState_e::GlobalEscape ? 1 : 0;
+		}
+		return count;
+	}
+
+	Bool
+	EscapeAnalysis::analyze(Module* const module, Function* const function)
+	{
+		mNodeList.clear();
+		mNodeMap.clear();
+
+		std::vector<Instruction*> parameterList;
+		std::vector<Instruction*> allocationList;
+
+		for (auto& block : function->blockList)
+		{
+			for (auto& instructionPtr : block->instructionList)
+			{
+				Instruction* const instruction = instructionPtr.get();
+				const U32 node = getNode(instruction);
+
+				switch (instruction->op)
+				{
+				case Opcode_e::Parameter:
+					// O conteudo de valores externos pode ser visto por qualquer quadro.
+					parameterList.push_back(instruction);
+					escape(getContent(node), EscapeState_e::GlobalEscape);
+					break;
+				case Opcode_e::LoadGlobal:
+					escape(node, EscapeState_e::GlobalEscape);
+					break;
+				case Opcode_e::StoreGlobal:
+					escape(getNode(instruction->operandList[0]), EscapeState_e::GlobalEscape);
+					break;
+				case Opcode_e::Phi:
+				case Opcode_e::CastClass:
+					for (auto operand : instruction->operandList)
+					{
+						merge(node, getNode(operand));
+					}
+					break;
+				case Opcode_e::LoadField:
+				case Opcode_e::LoadIndex:
+					merge(node, getContent(getNode(instruction->operandList[0])));
+					break;
+				case Opcode_e::StoreField:
+					merge(getContent(getNode(instruction->operandList[0])), getNode(instruction->operandList[1]));
+					break;
+				case Opcode_e::StoreIndex:
+					merge(getContent(getNode(instruction->operandList[0])), getNode(instruction->operandList[2]));
+					break;
+				case Opcode_e::NewArray:
+					allocationList.push_back(instruction);
+					for (auto operand : instruction->operandList)
+					{
+						merge(getContent(node), getNode(operand));
+					}
+					break;
+				case Opcode_e::New:
+					allocationList.push_back(instruction);
+					analyzeNew(instruction);
+					break;
+				case Opcode_e::Call:
+					analyzeCall(instruction, module->getFunction(instruction->index));
+					break;
+				case Opcode_e::CallMethod:
+					{
+						// Metodos so sao resolvidos quando a classe exata do objeto e conhecida.
+						Instruction* const object = instruction->operandList[0];
+						Function* callee = nullptr;
+
+						if (object->op == Opcode_e::New && mProgram != nullptr)
+						{
+							const U32 methodIndex = mProgram->findMethod(object->index, instruction->name);
+							callee = methodIndex != invalidIndex ? module->getFunction(methodIndex) : nullptr;
+						}
+						analyzeCall(instruction, callee);
+					}
+					break;
+				case Opcode_e::CallValue:
+					analyzeCall(instruction, nullptr);
+					break;
+				case Opcode_e::Return:
+				case Opcode_e::Panic:
+					for (auto operand : instruction->operandList)
+					{
+						escape(getNode(operand), EscapeState_e::GlobalEscape);
+					}
+					break;
+				default:
+					break;
+				}
+			}
+		}
+
+		propagate();
+
+		for (auto allocation : allocationList)
+		{
+			mAllocationMap[allocation] = mNodeList[find(getNode(allocation))].state;
+		}
+
+		// Os parametros sao ordenados pelo slot, a mesma ordem dos operandos das chamadas.
+		std::sort(parameterList.begin(), parameterList.end(), [](Instruction* const a, Instruction* const b) {
+			return a->index < b->index;
+		});
+
+		std::vector<EscapeState_e> summary(function->parameterCount, EscapeState_e::GlobalEscape);
+		for (U32 i = 0; i < parameterList.size() && i < summary.size(); i++)
+		{
+			summary[i] = mNodeList[find(getNode(parameterList[i]))].state;
+		}
+
+		auto it = mSummaryMap.find(function->functionIndex);
+		if (it == mSummaryMap.end())
+		{
+			// A primeira volta ainda nao conhece os resumos das funcoes seguintes.
+			mSummaryMap.emplace(function->functionIndex, std::move(summary));
+			return true;
+		}
+
+		if (it->second != summary)
+		{
+			it->second = std::move(summary);
+			return true;
+		}
+		return false;
+	}
+
+	void
+	EscapeAnalysis::analyzeCall(Instruction* const instruction, Function* const callee)
+	{
+		// O resultado vem de outro quadro.
+		const U32 node = getNode(instruction);
+		escape(getContent(node), EscapeState_e::GlobalEscape);
+
+		for (U32 i = 0; i < instruction->operandList.size(); i++)
+		{
+			const U32 operandNode = getNode(instruction->operandList[i]);
+
+			// O resumo so descreve o proprio parametro, o que a funcao chamada
+			// le dos campos pode ser guardado em qualquer lugar.
+			escape(operandNode, getArgumentState(callee, i));
+			escape(getContent(operandNode), EscapeState_e::GlobalEscape);
+		}
+	}
+
+	void
+	EscapeAnalysis::analyzeNew(Instruction* const instruction)
+	{
+		const U32 node = getNode(instruction);
+		Function* const constructor = instruction->auxIndex != invalidIndex
+			? mModule->getFunction(instruction->auxIndex)
+			: nullptr;
+
+		// Os argumentos vao para o construtor depois do 'this'.
+		for (U32 i = 0; i < instruction->operandList.size(); i++)
+		{
+			const U32 operandNode = getNode(instruction->operandList[i]);
+
+			escape(operandNode, getArgumentState(constructor, i + 1));
+			escape(getContent(operandNode), EscapeState_e::GlobalEscape);
+		}
+
+		// O objeto e o 'this' da inicializacao dos campos e do construtor.
+		EscapeState_e state = EscapeState_e::NoEscape;
+
+		if (mProgram != nullptr && instruction->index < mProgram->getClassCount())
+		{
+			const U32 initFunctionIndex = mProgram->getClass(instruction->index)->initFunctionIndex;
+
+			if (initFunctionIndex != invalidIndex)
+			{
+				state = maxState(state, getArgumentState(mModule->getFunction(initFunctionIndex), 0));
+			}
+		}
+		else
+		{
+			state = EscapeState_e::GlobalEscape;
+		}
+
+		if (instruction->auxIndex != invalidIndex)
+		{
+			state = maxState(state, getArgumentState(constructor, 0));
+		}
+
+		// Sem chamadas a alocacao continua local ao quadro.
+		if (state != EscapeState_e::NoEscape)
+		{
+			escape(node, state);
+		}
+	}
+
+	U32
+	EscapeAnalysis::getNode(Instruction* const instruction)
+	{
+		auto it = mNodeMap.find(instruction);
+
+		if (it != mNodeMap.end())
+		{
+			return it->second;
+		}
+
+		const U32 node = static_cast<U32>(mNodeList.size());
+		mNodeList.push_back({ node, noContent, EscapeState_e::NoEscape });
+		mNodeMap.emplace(instruction, node);
+		return node;
+	}
+
+	U32
+	EscapeAnalysis::getContent(U32 node)
+	{
+		node = find(node);
+
+		if (mNodeList[node].content == noContent)
+		{
+			const U32 content = static_cast<U32>(mNodeList.size());
+			mNodeList.push_back({ content, noContent, EscapeState_e::NoEscape });
+			mNodeList[node].content = content;
+		}
+		return find(mNodeList[node].content);
+	}
+
+	U32
+	EscapeAnalysis::find(U32 node)
+	{
+		while (mNodeList[node].parent != node)
+		{
+			mNodeList[node].parent = mNodeList[mNodeList[node].parent].parent;
+			node = mNodeList[node].parent;
+		}
+		return node;
+	}
+
+	void
+	EscapeAnalysis::merge(U32 nodeA, U32 nodeB)
+	{
+		// Unir dois grupos une tambem os seus conteudos.
+		std::vector<std::pair<U32, U32>> workList { { nodeA, nodeB } };
+
+		while (workList.size())
+		{
+			const U32 rootA = find(workList.back().first);
+			const U32 rootB = find(workList.back().second);
+			workList.pop_back();
+
+			if (rootA == rootB)
+			{
+				continue;
+			}
+
+			mNodeList[rootB].parent = rootA;
+			mNodeList[rootA].state = maxState(mNodeList[rootA].state, mNodeList[rootB].state);
+
+			const U32 contentB = mNodeList[rootB].content;
+			if (contentB == noContent)
+			{
+				continue;
+			}
+
+			if (mNodeList[rootA].content == noContent)
+			{
+				mNodeList[rootA].content = contentB;
+			}
+			else
+			{
+				workList.emplace_back(mNodeList[rootA].content, contentB);
+			}
+		}
+	}
+
+	void
+	EscapeAnalysis::escape(U32 node, EscapeState_e state)
+	{
+		node = find(node);
+		mNodeList[node].state = maxState(mNodeList[node].state, state);
+	}
+
+	EscapeState_e
+	EscapeAnalysis::getArgumentState(Function* const callee, U32 parameterIndex)
+	{
+		if (callee == nullptr)
+		{
+			return EscapeState_e::GlobalEscape;
+		}
+
+		// Funcoes ainda nao analisadas sao otimistas, a volta seguinte corrige.
+		auto it = mSummaryMap.find(callee->functionIndex);
+		if (it == mSummaryMap.end())
+		{
+			return parameterIndex < callee->parameterCount
+				? EscapeState_e::ArgEscape
+				: EscapeState_e::GlobalEscape;
+		}
+
+		if (parameterIndex >= it->second.size() || it->second[parameterIndex] == EscapeState_e::GlobalEscape)
+		{
+			return EscapeState_e::GlobalEscape;
+		}
+		return EscapeState_e::ArgEscape;
+	}
+
+	void
+	EscapeAnalysis::propagate()
+	{
+		// O que e alcancavel a partir de um valor escapa pelo menos tanto quanto ele.
+		Bool changed = true;
+		while (changed)
+		{
+			changed = false;
+
+			for (U32 node = 0; node < mNodeList.size(); node++)
+			{
+				if (mNodeList[node].parent != node || mNodeList[node].content == noContent)
+				{
+					continue;
+				}
+
+				const U32 content = find(mNodeList[node].content);
+				const EscapeState_e state = maxState(mNodeList[content].state, mNodeList[node].state);
+
+				if (state != mNodeList[content].state)
+				{
+					mNodeList[content].state = state;
+					changed = true;
+				}
+			}
+		}
+	}
+} }
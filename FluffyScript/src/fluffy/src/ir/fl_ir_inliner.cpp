@@ -0,0 +1,216 @@
+#include <algorithm>
+#include "ir/fl_ir_inliner.h"
+namespace fluffy { namespace ir {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static std::unique_ptr<Instruction>
+	cloneInstruction(Instruction* const instruction)
+	{
+		auto clone = std::make_unique<Instruction>(instruction->op, instruction->type);
+		clone->line = instruction->line;
+		clone->value = instruction->value;
+		clone->index = instruction->index;
+		clone->auxIndex = instruction->auxIndex;
+		clone->primitiveType = instruction->primitiveType;
+		clone->name = instruction->name;
+		return clone;
+	}
+
+	/**
+	 * Inliner
+	 */
+
+	Inliner::Inliner(U32 maxCalleeSize)
+		: Pass("inliner")
+		, mMaxCalleeSize(maxCalleeSize)
+	{}
+
+	Inliner::~Inliner()
+	{}
+
+	Bool
+	Inliner::run(Module* const module, Function* const function)
+	{
+		std::vector<std::pair<Instruction*, Function*>> callList;
+
+		for (auto& block : function->blockList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				if (instruction->op != Opcode_e::Call || instruction->index == invalidIndex)
+				{
+					continue;
+				}
+
+				Function* const callee = module->getFunction(instruction->index);
+
+				if (callee != nullptr && isInlinable(function, callee))
+				{
+					callList.emplace_back(instruction.get(), callee);
+				}
+			}
+		}
+
+		// As instrucoes continuam validas quando os blocos sao divididos.
+		for (auto& call : callList)
+		{
+			inlineCall(function, call.first, call.second);
+		}
+		return callList.size() > 0;
+	}
+
+	Bool
+	Inliner::isInlinable(Function* const caller, Function* const callee)
+	{
+		if (callee == caller || callee->getInstructionCount() > mMaxCalleeSize)
+		{
+			return false;
+		}
+
+		// Funcoes recursivas cresceriam a cada iteracao.
+		for (auto& block : callee->blockList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				if (instruction->op == Opcode_e::Call && instruction->index == callee->functionIndex)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void
+	Inliner::inlineCall(Function* const caller, Instruction* const call, Function* const callee)
+	{
+		Block* const callBlock = call->block;
+		Block* const continuation = splitBlock(caller, call);
+
+		// Parametros sem argumento e retornos sem valor recebem nulo.
+		Instruction* const null = callBlock->insertAt(
+			static_cast<U32>(std::find_if(callBlock->instructionList.begin(), callBlock->instructionList.end(),
+				[call](const std::unique_ptr<Instruction>& instruction) { return instruction.get() == call; }) - callBlock->instructionList.begin()),
+			std::make_unique<Instruction>(Opcode_e::Constant, Type_e::Null)
+		);
+
+		for (auto& block : callee->blockList)
+		{
+			mBlockMap[block.get()] = caller->createBlock();
+		}
+
+		// Primeiro cria as copias, os phis podem usar valores definidos depois.
+		for (auto& block : callee->blockList)
+		{
+			Block* const clone = mBlockMap[block.get()];
+
+			for (auto& instruction : block->instructionList)
+			{
+				if (instruction->op == Opcode_e::Parameter)
+				{
+					mValueMap[instruction.get()] = instruction->index < call->operandList.size()
+						? call->operandList[instruction->index]
+						: null;
+					continue;
+				}
+				mValueMap[instruction.get()] = clone->append(cloneInstruction(instruction.get()));
+			}
+
+			for (auto predecessor : block->predecessorList)
+			{
+				clone->predecessorList.push_back(mBlockMap[predecessor]);
+			}
+		}
+
+		std::vector<Instruction*> resultList;
+
+		for (auto& block : callee->blockList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				if (instruction->op == Opcode_e::Parameter)
+				{
+					continue;
+				}
+
+				Instruction* const clone = mValueMap[instruction.get()];
+
+				for (auto operand : instruction->operandList)
+				{
+					clone->appendOperand(mValueMap[operand]);
+				}
+
+				for (auto target : instruction->targetList)
+				{
+					clone->targetList.push_back(mBlockMap[target]);
+				}
+
+				// O retorno vira um salto para a continuacao.
+				if (clone->op == Opcode_e::Return)
+				{
+					resultList.push_back(clone->operandList.size() ? clone->operandList[0] : null);
+
+					clone->dropOperands();
+					clone->op = Opcode_e::Jump;
+					clone->targetList.push_back(continuation);
+					continuation->predecessorList.push_back(clone->block);
+				}
+			}
+		}
+
+		Instruction* result = null;
+
+		if (resultList.size() == 1)
+		{
+			result = resultList[0];
+		}
+		else if (resultList.size() > 1)
+		{
+			result = continuation->insertAt(0, std::make_unique<Instruction>(Opcode_e::Phi, callee->returnType == Type_e::Void ? Type_e::Any : callee->returnType));
+			result->line = call->line;
+
+			for (auto value : resultList)
+			{
+				result->appendOperand(value);
+			}
+		}
+
+		call->replaceAllUsesWith(result);
+		callBlock->erase(call);
+
+		Block* const calleeEntry = mBlockMap[callee->getEntry()];
+
+		auto jump = std::make_unique<Instruction>(Opcode_e::Jump, Type_e::Void);
+		jump->targetList.push_back(calleeEntry);
+		callBlock->append(std::move(jump));
+		calleeEntry->predecessorList.push_back(callBlock);
+
+		mValueMap.clear();
+		mBlockMap.clear();
+	}
+
+	Block*
+	Inliner::splitBlock(Function* const function, Instruction* const call)
+	{
+		Block* const block = call->block;
+		Block* const continuation = function->createBlock();
+
+		auto it = std::find_if(block->instructionList.begin(), block->instructionList.end(),
+			[call](const std::unique_ptr<Instruction>& instruction) { return instruction.get() == call; });
+
+		for (auto next = it + 1; next != block->instructionList.end(); next++)
+		{
+			(*next)->block = continuation;
+			continuation->instructionList.push_back(std::move(*next));
+		}
+		block->instructionList.erase(it + 1, block->instructionList.end());
+
+		for (auto successor : continuation->getSuccessorList())
+		{
+			successor->replacePredecessor(block, continuation);
+		}
+		return continuation;
+	}
+} }
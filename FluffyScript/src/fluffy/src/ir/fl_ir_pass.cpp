@@ -0,0 +1,103 @@
+#include <algorithm>
+#include "ir/fl_ir_pass.h"
+namespace fluffy { namespace ir {
+	/**
+	 * Pass
+	 */
+
+	Pass::Pass(const I8* const name)
+		: mName(name)
+	{}
+
+	Pass::~Pass()
+	{}
+
+	const I8*
+	Pass::getName()
+	{
+		return mName;
+	}
+
+	/**
+	 * PassManager
+	 */
+
+	PassManager::PassManager()
+		: mMaxIterations(8)
+		, mVerify(false)
+	{}
+
+	PassManager::~PassManager()
+	{}
+
+	void
+	PassManager::addPass(std::unique_ptr<Pass> pass)
+	{
+		mStatsList.push_back(PassStats_s { pass->getName(), 0, 0 });
+		mPassList.push_back(std::move(pass));
+	}
+
+	U32
+	PassManager::run(Module* const module)
+	{
+		U32 maxIterationCount = 0;
+
+		for (U32 functionIndex = 0; functionIndex < module->getFunctionCount(); functionIndex++)
+		{
+			Function* const function = module->getFunction(functionIndex);
+
+			if (function == nullptr)
+			{
+				continue;
+			}
+
+			U32 iterationCount = 0;
+			Bool changed = true;
+
+			while (changed && iterationCount < mMaxIterations)
+			{
+				changed = false;
+				iterationCount++;
+
+				for (size_t i = 0; i < mPassList.size(); i++)
+				{
+					PassStats_s& stats = mStatsList[i];
+					stats.runCount++;
+
+					if (!mPassList[i]->run(module, function))
+					{
+						continue;
+					}
+
+					stats.changeCount++;
+					changed = true;
+
+					if (mVerify)
+					{
+						function->verify();
+					}
+				}
+			}
+			maxIterationCount = std::max(maxIterationCount, iterationCount);
+		}
+		return maxIterationCount;
+	}
+
+	void
+	PassManager::setMaxIterations(U32 maxIterations)
+	{
+		mMaxIterations = maxIterations;
+	}
+
+	void
+	PassManager::setVerify(Bool verify)
+	{
+		mVerify = verify;
+	}
+
+	const std::vector<PassStats_s>&
+	PassManager::getStatsList()
+	{
+		return mStatsList;
+	}
+} }
@@ -1,9 +1,95 @@
-#include "ast\fl_ast_decl.h"
-#include "parser\fl_parser.h"
-#include "job\fl_job.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "ast/fl_ast_decl.h"
+#include "parser/fl_parser.h"
+#include "job/fl_job.h"
+#include "job/fl_job_pool.h"
+#include "attributes/fl_deferred_function_body.h"
+#include "profiler/fl_profiler.h"
 #include "fl_buffer.h"
+#include "fl_exceptions.h"
 namespace fluffy { namespace jobs {
-	
+	/**
+	 * readSourceFile
+	 */
+
+	static String
+	readSourceFile(const I8* sourceFilename)
+	{
+		std::ifstream fileStream(sourceFilename, std::ifstream::binary);
+		if (!fileStream.is_open()) {
+			throw exceptions::file_not_found_exception(sourceFilename);
+		}
+
+		std::stringstream stringStream;
+		stringStream << fileStream.rdbuf();
+		return stringStream.str();
+	}
+
+	/**
+	 * parseCodeUnitInParallel
+	 */
+
+	static std::unique_ptr<ast::CodeUnit>
+	parseCodeUnitInParallel(const I8* sourceFilename, const I8* sourceCode, const U32 jobCount, diagnostics::DiagnosticEngine* const diagnosticEngine)
+	{
+		// Analisa apenas a estrutura do codigo, os corpos das funcoes sao ignorados.
+		parser::ParserContext_s context;
+		context.skipFunctionBody = true;
+		context.diagnosticEngine = diagnosticEngine;
+		auto parser = std::make_unique<parser::Parser>(
+			new SharedBuffer()
+		);
+
+		parser->loadSource(sourceFilename, sourceCode);
+		auto codeUnit = parser->parseCodeUnit(context);
+
+		auto skippedBlockList = parser->releaseSkippedBlockList();
+		if (skippedBlockList.empty())
+		{
+			return codeUnit;
+		}
+
+		const U32 runnerCount = std::min(jobCount, static_cast<U32>(skippedBlockList.size()));
+
+		std::vector<std::unique_ptr<JobParseFunctionBody>> jobList;
+		std::vector<U32> jobLoadList(runnerCount, 0);
+
+		for (U32 i = 0; i < runnerCount; i++)
+		{
+			jobList.push_back(std::make_unique<JobParseFunctionBody>(sourceFilename, sourceCode));
+		}
+
+		// Cada corpo vai para a tarefa com menos codigo a processar.
+		for (auto& skippedBlock : skippedBlockList)
+		{
+			auto it = std::min_element(jobLoadList.begin(), jobLoadList.end());
+			jobList[it - jobLoadList.begin()]->insertSkippedBlock(skippedBlock);
+			*it += skippedBlock.blockDecl->endPosition - skippedBlock.blockDecl->beginPosition + 1;
+		}
+
+		// Cada tarefa usa seu proprio parser sobre o mesmo codigo, os nos
+		// gerados sao anexados aos blocos ja existentes na arvore.
+		JobPool jobPool(runnerCount);
+		jobPool.initialize();
+
+		for (auto& job : jobList)
+		{
+			jobPool.addJob(job.get());
+		}
+		jobPool.run();
+
+		for (auto& job : jobList)
+		{
+			if (job->getJobStatus() == JobStatus_e::Error)
+			{
+				throw exceptions::custom_exception("%s", job->getError());
+			}
+		}
+		return codeUnit;
+	}
+
 
 	/**
 	 * Job
@@ -48,8 +134,11 @@ namespace fluffy { namespace jobs {
 	 * JobParseFromSourceFile
 	 */
 
-	JobParseFromSourceFile::JobParseFromSourceFile(const I8* sourceFilename)
+	JobParseFromSourceFile::JobParseFromSourceFile(const I8* sourceFilename, Bool skipFunctionBody, U32 functionBodyJobCount, diagnostics::DiagnosticEngine* diagnosticEngine)
 		: m_sourceFilename(sourceFilename)
+		, m_skipFunctionBody(skipFunctionBody)
+		, m_functionBodyJobCount(functionBodyJobCount)
+		, m_diagnosticEngine(diagnosticEngine)
 	{}
 
 	JobParseFromSourceFile::~JobParseFromSourceFile()
@@ -58,7 +147,26 @@ namespace fluffy { namespace jobs {
 	void
 	JobParseFromSourceFile::doJob()
 	{
-		parser::ParserContext_s context = parser::ParserContext_s { false };
+		// Com mais de uma tarefa disponivel os corpos das funcoes sao
+		// processados em paralelo apos a analise da estrutura.
+		if (!m_skipFunctionBody && m_functionBodyJobCount > 1)
+		{
+			try
+			{
+				const String sourceCode = readSourceFile(m_sourceFilename);
+				m_codeUnit = parseCodeUnitInParallel(m_sourceFilename, sourceCode.c_str(), m_functionBodyJobCount, m_diagnosticEngine);
+			}
+			catch (std::exception& e)
+			{
+				setJobStatus(JobStatus_e::Error);
+				setError(e.what());
+			}
+			return;
+		}
+
+		parser::ParserContext_s context;
+		context.skipFunctionBody = m_skipFunctionBody;
+		context.diagnosticEngine = m_diagnosticEngine;
 		auto parser = std::make_unique<parser::Parser>(
 			new LazyBuffer()
 		);
@@ -67,6 +175,12 @@ namespace fluffy { namespace jobs {
 		{
 			parser->loadSourceFromFile(m_sourceFilename);
 			m_codeUnit = parser->parseCodeUnit(context);
+
+			// Mantem o parser junto ao code unit para processar os corpos ignorados sob demanda.
+			if (parser->hasSkippedBlock())
+			{
+				m_codeUnit->insertAttribute(new attributes::DeferredFunctionBody(parser.release()));
+			}
 		}
 		catch (std::exception& e)
 		{
@@ -97,9 +211,12 @@ namespace fluffy { namespace jobs {
 	 * JobParseFromSourceBlock
 	 */
 
-	JobParseFromSourceBlock::JobParseFromSourceBlock(const I8* sourceFilename, const I8* sourceCode)
+	JobParseFromSourceBlock::JobParseFromSourceBlock(const I8* sourceFilename, const I8* sourceCode, Bool skipFunctionBody, U32 functionBodyJobCount, diagnostics::DiagnosticEngine* diagnosticEngine)
 		: m_sourceFilename(sourceFilename)
 		, m_sourceCode(sourceCode)
+		, m_skipFunctionBody(skipFunctionBody)
+		, m_functionBodyJobCount(functionBodyJobCount)
+		, m_diagnosticEngine(diagnosticEngine)
 	{}
 
 	JobParseFromSourceBlock::~JobParseFromSourceBlock()
@@ -108,7 +225,25 @@ namespace fluffy { namespace jobs {
 	void
 	JobParseFromSourceBlock::doJob()
 	{
-		parser::ParserContext_s context = parser::ParserContext_s { false };
+		// Com mais de uma tarefa disponivel os corpos das funcoes sao
+		// processados em paralelo apos a analise da estrutura.
+		if (!m_skipFunctionBody && m_functionBodyJobCount > 1)
+		{
+			try
+			{
+				m_codeUnit = parseCodeUnitInParallel(m_sourceFilename, m_sourceCode, m_functionBodyJobCount, m_diagnosticEngine);
+			}
+			catch (std::exception& e)
+			{
+				setJobStatus(JobStatus_e::Error);
+				setError(e.what());
+			}
+			return;
+		}
+
+		parser::ParserContext_s context;
+		context.skipFunctionBody = m_skipFunctionBody;
+		context.diagnosticEngine = m_diagnosticEngine;
 		auto parser = std::make_unique<parser::Parser>(
 			new LazyBuffer()
 		);
@@ -117,6 +252,12 @@ namespace fluffy { namespace jobs {
 		{
 			parser->loadSource(m_sourceFilename, m_sourceCode);
 			m_codeUnit = parser->parseCodeUnit(context);
+
+			// Mantem o parser junto ao code unit para processar os corpos ignorados sob demanda.
+			if (parser->hasSkippedBlock())
+			{
+				m_codeUnit->insertAttribute(new attributes::DeferredFunctionBody(parser.release()));
+			}
 		}
 		catch (std::exception& e)
 		{
@@ -142,4 +283,55 @@ namespace fluffy { namespace jobs {
 	{
 		return m_codeUnit.get();
 	}
+
+	/**
+	 * JobParseFunctionBody
+	 */
+
+	JobParseFunctionBody::JobParseFunctionBody(const I8* sourceFilename, const I8* sourceCode)
+		: m_sourceFilename(sourceFilename)
+		, m_sourceCode(sourceCode)
+	{}
+
+	JobParseFunctionBody::~JobParseFunctionBody()
+	{}
+
+	void
+	JobParseFunctionBody::doJob()
+	{
+		// O buffer compartilhado le o codigo sem copia-lo, cada tarefa tem apenas seu cursor.
+		auto parser = std::make_unique<parser::Parser>(
+			new SharedBuffer()
+		);
+
+		try
+		{
+			parser->loadSource(m_sourceFilename, m_sourceCode);
+
+			// Cada tarefa aparece na sua propria linha do trace.
+			const profiler::ProfileScope profileScope(profiler::functionBodyPhase, m_sourceFilename);
+			const U32 tokenCount = parser->getTokenCount();
+
+			for (auto& skippedBlock : m_skippedBlockList)
+			{
+				parser->parseSkippedBlock(skippedBlock);
+			}
+
+			if (auto activeProfiler = profiler::Profiler::getActive())
+			{
+				activeProfiler->addNodeCount(profiler::lexerPhase, m_sourceFilename, parser->getTokenCount() - tokenCount);
+			}
+		}
+		catch (std::exception& e)
+		{
+			setJobStatus(JobStatus_e::Error);
+			setError(e.what());
+		}
+	}
+
+	void
+	JobParseFunctionBody::insertSkippedBlock(const parser::SkippedBlock_s& skippedBlock)
+	{
+		m_skippedBlockList.push_back(skippedBlock);
+	}
 } }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include <chrono>
-#include "job\fl_job.h"
-#include "job\fl_job_pool.h"
+#include "job/fl_job.h"
+#include "job/fl_job_pool.h"
 namespace fluffy { namespace jobs {
 	// Constante de tempo padrao para esperar atualizacoes.
 	constexpr const std::chrono::milliseconds sleepTime = std::chrono::milliseconds(5);
@@ -24,17 +24,21 @@ namespace fluffy { namespace jobs {
 		m_status = JobRunnerStatus_e::Done;
 	}
 
-	void
+	Bool
 	JobRunner::setJob(Job* job)
 	{
 		std::lock_guard<std::mutex> guard(m_mutex);
 		{
-			if (job)
+			// Apenas um runner ocioso aceita a tarefa.
+			if (job && m_status == JobRunnerStatus_e::Idle)
 			{
+				job->setJobStatus(JobStatus_e::Working);
 				m_currentJob = job;
 				m_status = JobRunnerStatus_e::Working;
+				return true;
 			}
 		}
+		return false;
 	}
 
 	void
@@ -44,36 +48,41 @@ namespace fluffy { namespace jobs {
 
 		while (true)
 		{
+			Job* job = nullptr;
+			{
+				std::lock_guard<std::mutex> guard(m_mutex);
+
+				// Finaliza a thread.
+				if (m_status == JobRunnerStatus_e::Done)
+				{
+					break;
+				}
+				job = m_currentJob;
+			}
+
 			// Deixa a thread esperando alguma tarefa.
-			while (m_status == JobRunnerStatus_e::Idle)
+			if (job == nullptr)
 			{
 				std::this_thread::sleep_for(
 					milliseconds(sleepTime)
 				);
+				continue;
 			}
 
-			// Executa a tarefa.
-			if (m_currentJob && m_status == JobRunnerStatus_e::Working)
-			{
-				std::lock_guard<std::mutex> guard(m_mutex);
-				{
-					m_currentJob->setJobStatus(JobStatus_e::Working);
-					m_currentJob->doJob();
-
-					// O estado para feito so e alterado se nao houver erros.
-					if (m_currentJob->getJobStatus() == JobStatus_e::Working) {
-						m_currentJob->setJobStatus(JobStatus_e::Done);
-					}
+			// Executa a tarefa fora do lock, para que o pool possa consultar o runner.
+			job->doJob();
 
-					m_currentJob = nullptr;
-					m_status = JobRunnerStatus_e::Idle;
-				}
+			// O estado para feito so e alterado se nao houver erros.
+			if (job->getJobStatus() == JobStatus_e::Working) {
+				job->setJobStatus(JobStatus_e::Done);
 			}
 
-			// Finaliza a thread.
-			if (m_status == JobRunnerStatus_e::Done)
+			std::lock_guard<std::mutex> guard(m_mutex);
 			{
-				break;
+				m_currentJob = nullptr;
+				if (m_status == JobRunnerStatus_e::Working) {
+					m_status = JobRunnerStatus_e::Idle;
+				}
 			}
 		}
 	}
@@ -90,9 +99,11 @@ namespace fluffy { namespace jobs {
 	JobPool::~JobPool()
 	{
 		// Sinaliza para todos os running serem finalizados.
-		for (U32 i = 0; i < m_threadPool.size(); i++)
+		for (auto& jobRunner : m_runnerPool)
 		{
-			m_runnerPool[i]->close();
+			if (jobRunner) {
+				jobRunner->close();
+			}
 		}
 
 		// Espera todas as thread serem finalizadas.
@@ -127,12 +138,16 @@ namespace fluffy { namespace jobs {
 					hasPendentJob = true;
 					for (auto& jobRunner : m_runnerPool)
 					{
-						jobRunner->setJob(job);
+						if (jobRunner->setJob(job))
+						{
+							break;
+						}
 					}
 				}
 			}
 
-			if (!hasPendentJob)
+			// Retorna apenas quando todas as tarefas foram finalizadas.
+			if (!hasPendentJob && getWorkingJobCount() == 0)
 			{
 				break;
 			}
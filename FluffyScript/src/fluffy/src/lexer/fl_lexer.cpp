@@ -1,5 +1,9 @@
+#include <algorithm>
 #include <cstring>
-#include "lexer\fl_lexer.h"
+#include <stdexcept>
+#include "diagnostics/fl_diagnostics.h"
+#include "lexer/fl_lexer.h"
+#include "profiler/fl_profiler.h"
 #include "fl_exceptions.h"
 #include "fl_buffer.h"
 
@@ -123,6 +127,12 @@ namespace fluffy {
 	static const auto isNewLine = [](char ch) -> bool { return ch == '\n'; };
 	static const auto isCarriage = [](char ch) -> bool { return ch == '\r'; };
 	static const auto isTab = [](char ch) -> bool { return ch == '\t'; };
+
+	// Tamanho dos blocos lidos do buffer para o indice de linhas.
+	static constexpr const U32 lineIndexBlockSize = 4096;
+
+	// Nenhum token tem a linha e coluna calculadas.
+	static constexpr const U32 invalidPosition = 0xFFFFFFFF;
 }
 
 namespace fluffy { namespace lexer {
@@ -130,9 +140,12 @@ namespace fluffy { namespace lexer {
 		: m_buffer(buffer)
 		, m_filename()
 		, m_tabSpaces(4)
-		, m_line(1)
-		, m_column(1)
+		, m_lineCursor(1)
+		, m_tokenLocation()
+		, m_tokenLocationPosition(invalidPosition)
 		, m_eof(false)
+		, m_tokenCount(0)
+		, m_diagnosticEngine(nullptr)
 	{}
 
 	Lexer::~Lexer()
@@ -141,24 +154,33 @@ namespace fluffy { namespace lexer {
 	void
 	Lexer::loadSource(const I8* sourceCode)
 	{
+		const profiler::ProfileScope profileScope(profiler::lexerPhase, "anom_block");
+
 		m_buffer->load(sourceCode, static_cast<U32>(strlen(sourceCode)));
 		m_filename = "anom_block";
+		resetLineIndex();
 		parse();
 	}
 
 	void
 	Lexer::loadSource(const I8* sourceFilename, const I8* sourceCode)
 	{
+		const profiler::ProfileScope profileScope(profiler::lexerPhase, sourceFilename);
+
 		m_buffer->load(sourceCode, static_cast<U32>(strlen(sourceCode)));
 		m_filename = sourceFilename;
+		resetLineIndex();
 		parse();
 	}
 
 	void
 	Lexer::loadSourceFromFile(const I8* sourceFilename)
 	{
+		const profiler::ProfileScope profileScope(profiler::lexerPhase, sourceFilename);
+
 		m_buffer->loadFromFile(sourceFilename);
 		m_filename = sourceFilename;
+		resetLineIndex();
 		parse();
 	}
 
@@ -168,9 +190,52 @@ namespace fluffy { namespace lexer {
 		return m_filename.c_str();
 	}
 
+	U32
+	Lexer::getTokenCount()
+	{
+		return m_tokenCount;
+	}
+
+	void
+	Lexer::setDiagnosticEngine(diagnostics::DiagnosticEngine* const diagnosticEngine)
+	{
+		m_diagnosticEngine = diagnosticEngine;
+	}
+
+	diagnostics::DiagnosticEngine*
+	Lexer::getDiagnosticEngine()
+	{
+		return m_diagnosticEngine;
+	}
+
+	void
+	Lexer::throwDiagnostic(diagnostics::DiagnosticCode_e code, U32 line, U32 column, std::initializer_list<TString> argList)
+	{
+		const diagnostics::Diagnostic_s diagnostic = diagnostics::DiagnosticEngine::makeDiagnostic(code, TString(m_filename), nullptr, line, column, argList);
+		if (m_diagnosticEngine != nullptr)
+		{
+			m_diagnosticEngine->report(diagnostic);
+		}
+		throw exceptions::diagnostic_exception(diagnostic);
+	}
+
+	void
+	Lexer::throwDiagnostic(diagnostics::DiagnosticCode_e code, U32 position, std::initializer_list<TString> argList)
+	{
+		const SourceLocation_s location = getLocation(position);
+		throwDiagnostic(code, location.line, location.column, argList);
+	}
+
 	void
 	Lexer::nextToken()
 	{
+		// Consome primeiro os tokens ja lidos antecipadamente.
+		if (!m_lookaheadList.empty())
+		{
+			m_token = std::move(m_lookaheadList.front().token);
+			m_lookaheadList.pop_front();
+			return;
+		}
 		parse();
 	}
 
@@ -187,18 +252,52 @@ namespace fluffy { namespace lexer {
 	}
 
 	void
-	Lexer::resetToPosition(U32 newPosition, U32 newLine, U32 newColumn)
+	Lexer::resetToPosition(U32 newPosition)
 	{
+		m_lookaheadList.clear();
 		m_eof = false;
-		m_line = newLine;
-		m_column = newColumn;
 		m_buffer->reset(newPosition);
 		parse();
 	}
 
+	SourceLocation_s
+	Lexer::getLocation(U32 position)
+	{
+		extendLineIndex(position);
+
+		// Apos um reset para tras a linha e procurada no indice, senao avanca
+		// a partir da linha da consulta anterior.
+		if (position < m_lineIndex.getLineStart(m_lineCursor))
+		{
+			m_lineCursor = m_lineIndex.getLine(position);
+		}
+		else
+		{
+			while (m_lineCursor < m_lineIndex.getLineCount() && m_lineIndex.getLineStart(m_lineCursor + 1) <= position)
+			{
+				m_lineCursor++;
+			}
+		}
+		return SourceLocation_s { m_lineCursor, m_lineIndex.getColumn(position, m_lineCursor, m_tabSpaces) };
+	}
+
+	const SourceLocation_s&
+	Lexer::getTokenLocation()
+	{
+		if (m_tokenLocationPosition != m_token.position)
+		{
+			m_tokenLocation = getLocation(m_token.position);
+			m_tokenLocationPosition = m_token.position;
+		}
+		return m_tokenLocation;
+	}
+
 	void
 	Lexer::reinterpretToken(TokenType_e type, U32 offset)
 	{
+		// Descarta os tokens lidos antecipadamente, restaurando o
+		// estado do lexer logo apos o token atual.
+		m_lookaheadList.clear();
 		m_eof = false;
 		m_token.type = type;
 		m_buffer->reset(m_token.position + offset);
@@ -207,27 +306,38 @@ namespace fluffy { namespace lexer {
 	Token_s
 	Lexer::predictNextToken()
 	{
-		const U32 position = m_token.position;
-		const U32 line = m_token.line;
-		const U32 column = m_token.column;
+		return predictToken(1);
+	}
 
-		parse();
-		const Token_s token = m_token;
-		resetToPosition(position, line, column);
-		return token;
+	const Token_s&
+	Lexer::predictToken(U32 offset)
+	{
+		if (offset == 0)
+		{
+			return m_token;
+		}
+
+		// Le os tokens a frente sem voltar o buffer, eles ficam
+		// guardados ate serem consumidos por nextToken.
+		while (m_lookaheadList.size() < offset)
+		{
+			LookaheadToken_s lookahead { Token_s(), m_eof };
+
+			Token_s currentToken = std::move(m_token);
+			parse();
+			lookahead.token = std::move(m_token);
+			m_token = std::move(currentToken);
+
+			m_lookaheadList.push_back(std::move(lookahead));
+		}
+		return m_lookaheadList[offset - 1].token;
 	}
 
 	void
 	Lexer::expectToken(TokenType_e expectedToken)
 	{
 		if (m_token.type != expectedToken) {
-			throw exceptions::custom_exception(
-				"%s error: Expected token '%s', received '%s'",
-				m_token.line, m_token.column,
-				m_filename.c_str(),
-				getTokenString(expectedToken),
-				m_token.value.c_str()
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedToken, m_token.position, { TString(getTokenString(expectedToken)), TString(m_token.value) });
 		}
 		nextToken();
 	}
@@ -237,12 +347,7 @@ namespace fluffy { namespace lexer {
 	{
 		String value = m_token.value;
 		if (m_token.type != TokenType_e::Identifier) {
-			throw exceptions::custom_exception(
-				"%s error: Expected an identifier, received '%s'",
-				m_token.line, m_token.column,
-				m_filename.c_str(),
-				m_token.value.c_str()
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedIdentifier, m_token.position, { TString(m_token.value) });
 		}
 		nextToken();
 		return value;
@@ -252,44 +357,39 @@ namespace fluffy { namespace lexer {
 	Lexer::expectConstantBool()
 	{
 		if (m_token.type != TokenType_e::True && m_token.type != TokenType_e::False) {
-			throw exceptions::custom_exception(
-				"%s error: Expected an boolean constant, received '%s'",
-				m_token.line, m_token.column,
-				m_filename.c_str(),
-				m_token.value.c_str()
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedConstantBool, m_token.position, { TString(m_token.value) });
 		}
 		const Bool value = m_token.type == TokenType_e::True ? true : false;
 		nextToken();
 		return value;
 	}
 
-	const I8
+	const I64
 	Lexer::expectConstantInteger()
 	{
 		if (m_token.type != TokenType_e::ConstantInteger) {
-			throw exceptions::custom_exception(
-				"%s error: Expected an integer 8-bits constant, received '%s'",
-				m_token.line, m_token.column,
-				m_filename.c_str(),
-				m_token.value.c_str()
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedConstantInteger, m_token.position, { TString(m_token.value) });
+		}
+		// Constantes acima de INT64_MAX sao validas para u64 e mantem o mesmo
+		// padrao de bits, apenas as que nao cabem em 64 bits sao rejeitadas.
+		U64 value = 0;
+		try
+		{
+			value = std::stoull(m_token.value, nullptr);
+		}
+		catch (std::out_of_range&)
+		{
+			throwDiagnostic(diagnostics::DiagnosticCode_e::IntegerConstantOverflow, m_token.position, { TString(m_token.value) });
 		}
-		const I8 value = std::stoi(m_token.value, nullptr);
 		nextToken();
-		return value;
+		return static_cast<I64>(value);
 	}
 
 	const Fp32
 	Lexer::expectConstantFp32()
 	{
 		if (m_token.type != TokenType_e::ConstantFp32) {
-			throw exceptions::custom_exception(
-				"%s error: Expected a real 32-bits constant, received '%s'",
-				m_token.line, m_token.column,
-				m_filename.c_str(),
-				m_token.value.c_str()
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedConstantFp32, m_token.position, { TString(m_token.value) });
 		}
 		const Fp32 value = std::stof(m_token.value, nullptr);
 		nextToken();
@@ -300,12 +400,7 @@ namespace fluffy { namespace lexer {
 	Lexer::expectConstantFp64()
 	{
 		if (m_token.type != TokenType_e::ConstantFp64) {
-			throw exceptions::custom_exception(
-				"%s error: Expected a real 64-bits constant, received '%s'",
-				m_token.line, m_token.column,
-				m_filename.c_str(),
-				m_token.value.c_str()
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedConstantFp64, m_token.position, { TString(m_token.value) });
 		}
 		const Fp64 value = std::stod(m_token.value, nullptr);
 		nextToken();
@@ -316,12 +411,7 @@ namespace fluffy { namespace lexer {
 	Lexer::expectConstantChar()
 	{
 		if (m_token.type != TokenType_e::ConstantChar) {
-			throw exceptions::custom_exception(
-				"%s error: Expected a character constant, received '%s'",
-				m_token.line, m_token.column,
-				m_filename.c_str(),
-				m_token.value.c_str()
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedConstantChar, m_token.position, { TString(m_token.value) });
 		}
 		const I8 value = m_token.value[0];
 		nextToken();
@@ -332,12 +422,7 @@ namespace fluffy { namespace lexer {
 	Lexer::expectConstantString()
 	{
 		if (m_token.type != TokenType_e::ConstantString) {
-			throw exceptions::custom_exception(
-				"%s error: Expected a string constant, received '%s'",
-				m_token.line, m_token.column,
-				m_filename.c_str(),
-				m_token.value.c_str()
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedConstantString, m_token.position, { TString(m_token.value) });
 		}
 		String value = m_token.value;
 		nextToken();
@@ -1088,13 +1173,11 @@ namespace fluffy { namespace lexer {
 
 		if (!m_eof) {
 			const I8 ch = readChar();
+			m_tokenCount++;
 
-			// Armazena inicio do m_tokenen e nome do arquivo ou bloco.
+			// Armazena inicio do m_tokenen.
 			m_token.type = TokenType_e::Unknown;
-			m_token.line = m_line;
-			m_token.column = m_column;
 			m_token.position = m_buffer->getPosition();
-			m_token.filename = m_filename;
 			m_token.value.clear();
 
 			// Processa m_tokenen.
@@ -1118,13 +1201,11 @@ namespace fluffy { namespace lexer {
 				parseString();
 				return;
 			}
-			throw exceptions::unexpected_token_exception(m_filename, ch, m_token.line, m_token.column);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::InvalidCharacter, m_token.position, { TString(String(1, ch)) });
 		}
 		else
 		{
-			m_token.line = m_line;
-			m_token.column = m_column;
-			m_token.filename = m_filename;
+			m_token.position = m_buffer->getPosition();
 			m_token.value = "<eof>";
 			m_token.type = TokenType_e::Eof;
 		}
@@ -1145,25 +1226,50 @@ namespace fluffy { namespace lexer {
 	}
 
 	void
-	Lexer::nextChar()
+	Lexer::resetLineIndex()
 	{
-		m_buffer->nextByte();
-		const U8 ch = readChar();
+		m_lineIndex.clear();
+		m_lineCursor = 1;
+		m_tokenLocationPosition = invalidPosition;
+	}
+
+	void
+	Lexer::extendLineIndex(U32 position)
+	{
+		const U32 length = m_buffer->getLength();
+		const I8* const source = m_buffer->getData();
+
+		while (m_lineIndex.getIndexedLength() <= position && m_lineIndex.getIndexedLength() < length)
 		{
-			if (ch == '\0') {
-				m_eof = true;
-			}
-			if (isNewLine(ch)) {
-				m_line++;
-				m_column = 0;
-				return;
+			const U32 indexedLength = m_lineIndex.getIndexedLength();
+			const U32 blockLength = std::min(lineIndexBlockSize, length - indexedLength);
+
+			// Sem o codigo inteiro em memoria o bloco e lido do buffer.
+			if (source != nullptr)
+			{
+				m_lineIndex.append(source + indexedLength, blockLength);
+				continue;
 			}
-			if (isTab(ch)) {
-				m_column += m_tabSpaces;
-				return;
+
+			I8 block[lineIndexBlockSize];
+			const U32 readedBytes = m_buffer->read(indexedLength, block, blockLength);
+			if (readedBytes == 0)
+			{
+				break;
 			}
+			m_lineIndex.append(block, readedBytes);
+		}
+	}
+
+	void
+	Lexer::nextChar()
+	{
+		// A posicao do token e convertida em linha e coluna pelo indice, o
+		// lexer nao acompanha as linhas a cada caractere.
+		m_buffer->nextByte();
+		if (readChar() == '\0') {
+			m_eof = true;
 		}
-		m_column++;
 	}
 
 	void
@@ -1202,7 +1308,7 @@ namespace fluffy { namespace lexer {
 					const I8 nch = readChar();
 
 					if (m_eof) {
-						throw exceptions::unexpected_end_of_file_exception(m_filename);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedEndOfFile, m_token.position, {});
 					}
 
 					const I8 nch2 = readChar(1);
@@ -1413,7 +1519,7 @@ namespace fluffy { namespace lexer {
 						m_token.value.push_back(readCharAndAdv());
 						return;
 					}
-					throw exceptions::unexpected_token_exception(m_filename, m_token.value, m_token.line, m_token.column);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, m_token.position, { TString(m_token.value) });
 				}
 			}
 			break;
@@ -1527,7 +1633,7 @@ namespace fluffy { namespace lexer {
 			}
 			break;
 		default:
-			throw exceptions::unexpected_token_exception(m_filename, m_token.value, m_token.line, m_token.column);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, m_token.position, { TString(m_token.value) });
 		}
 	}
 
@@ -1551,7 +1657,7 @@ namespace fluffy { namespace lexer {
 				ch = readChar();
 				if (!ishex(ch)) {
 					if (!isValid) {
-						throw exceptions::malformed_number_exception(m_filename, m_token.line, m_token.column);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::MalformedNumber, m_token.position, {});
 					}
 					return;
 				}
@@ -1576,7 +1682,7 @@ namespace fluffy { namespace lexer {
 				ch = readChar();
 				if (!isbin(ch)) {
 					if (!isValid) {
-						throw exceptions::malformed_number_exception(m_filename, m_token.line, m_token.column);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::MalformedNumber, m_token.position, {});
 					}
 					return;
 				}
@@ -1659,7 +1765,7 @@ namespace fluffy { namespace lexer {
 					const I8 ch = readChar();
 
 					if (ch == '\0') {
-						throw exceptions::malformed_string_constant_exception(m_filename, m_token.line, m_token.column);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::MalformedStringConstant, m_token.position, {});
 					}
 					if (ch == '\"') {
 						nextChar(); // Consome "
@@ -1690,7 +1796,7 @@ namespace fluffy { namespace lexer {
 				m_token.value.push_back(readCharAndAdv());
 			}
 			if (ch == '\n' || ch == '\0') {
-				throw exceptions::malformed_string_constant_exception(m_filename, m_token.line, m_token.column);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::MalformedStringConstant, m_token.position, {});
 			}
 			if (ch == '\"') {
 				break;
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstring>
+#include "lexer/fl_source_line_index.h"
+
+namespace fluffy { namespace lexer {
+	/**
+	 * SourceLineIndex
+	 */
+
+	SourceLineIndex::SourceLineIndex()
+	{
+		clear();
+	}
+
+	SourceLineIndex::~SourceLineIndex()
+	{}
+
+	void
+	SourceLineIndex::build(const I8* source, U32 length)
+	{
+		clear();
+		append(source, length);
+	}
+
+	void
+	SourceLineIndex::append(const I8* source, U32 length)
+	{
+		const I8* const end = source + length;
+		const I8* it = source;
+
+		while (it < end)
+		{
+			// A indentacao pode continuar do trecho anterior.
+			if (m_insideIndent)
+			{
+				const I8* const indentBegin = it;
+				while (it < end && *it == '\t')
+				{
+					it++;
+				}
+				m_leadingTabList.back() += static_cast<U32>(it - indentBegin);
+
+				if (it == end)
+				{
+					break;
+				}
+				m_insideIndent = false;
+			}
+
+			const I8* newLine = reinterpret_cast<const I8*>(memchr(it, '\n', end - it));
+			const I8* lineEnd = newLine != nullptr ? newLine : end;
+
+			for (const I8* tab = reinterpret_cast<const I8*>(memchr(it, '\t', lineEnd - it)); tab != nullptr;
+				tab = reinterpret_cast<const I8*>(memchr(tab + 1, '\t', lineEnd - tab - 1)))
+			{
+				m_innerTabList.push_back(m_indexedLength + static_cast<U32>(tab - source));
+			}
+
+			if (newLine == nullptr)
+			{
+				break;
+			}
+
+			m_lineStartList.push_back(m_indexedLength + static_cast<U32>(newLine + 1 - source));
+			m_leadingTabList.push_back(0);
+			m_insideIndent = true;
+			it = newLine + 1;
+		}
+		m_indexedLength += length;
+	}
+
+	void
+	SourceLineIndex::clear()
+	{
+		m_lineStartList.assign(1, 0);
+		m_leadingTabList.assign(1, 0);
+		m_innerTabList.clear();
+		m_indexedLength = 0;
+		m_insideIndent = true;
+	}
+
+	U32
+	SourceLineIndex::getIndexedLength()
+	{
+		return m_indexedLength;
+	}
+
+	U32
+	SourceLineIndex::getLineCount()
+	{
+		return static_cast<U32>(m_lineStartList.size());
+	}
+
+	U32
+	SourceLineIndex::getLineStart(U32 line)
+	{
+		return m_lineStartList[line - 1];
+	}
+
+	U32
+	SourceLineIndex::getLine(U32 position)
+	{
+		auto it = std::upper_bound(m_lineStartList.begin(), m_lineStartList.end(), position);
+		return static_cast<U32>(it - m_lineStartList.begin());
+	}
+
+	U32
+	SourceLineIndex::getColumn(U32 position, U32 line, U32 tabSpaces)
+	{
+		const U32 lineStart = m_lineStartList[line - 1];
+		const U32 indentEnd = lineStart + m_leadingTabList[line - 1];
+
+		// Um offset dentro da indentacao conta apenas as tabulacoes anteriores.
+		if (position < indentEnd)
+		{
+			return (position - lineStart) * tabSpaces + 1;
+		}
+
+		const U32 innerTabCount = static_cast<U32>(
+			std::lower_bound(m_innerTabList.begin(), m_innerTabList.end(), position) -
+			std::lower_bound(m_innerTabList.begin(), m_innerTabList.end(), indentEnd)
+		);
+		const U32 tabCount = m_leadingTabList[line - 1] + innerTabCount;
+
+		return position - lineStart + 1 + tabCount * (tabSpaces - 1);
+	}
+
+	SourceLocation_s
+	SourceLineIndex::getLocation(U32 position, U32 tabSpaces)
+	{
+		const U32 line = getLine(position);
+		return SourceLocation_s { line, getColumn(position, line, tabSpaces) };
+	}
+} }
@@ -0,0 +1,629 @@
+#include <algorithm>
+#include <sstream>
+#include "ast/fl_ast_pattern.h"
+#include "match/fl_match_compiler.h"
+namespace fluffy { namespace match {
+	/**
+	 * Dominios internos
+	 */
+
+	static const I8 boolDomain = 0;
+	static const I8 tupleDomain = 0;
+	static const I8 structureDomain = 0;
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	Bool
+	getLiteralValue(ast::expr::ExpressionDecl* const exprDecl, vm::Value_s& value)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::ConstantBoolExpr:
+			value = vm::makeBool(exprDecl->to<ast::expr::ExpressionConstantBoolDecl>()->valueDecl);
+			return true;
+		case AstNodeType_e::ConstantIntegerExpr:
+			{
+				auto integerDecl = exprDecl->to<ast::expr::ExpressionConstantIntegerDecl>();
+				value = vm::makeInteger(vm::toValueType(integerDecl->valueType), integerDecl->valueDecl);
+			}
+			return vm::isInteger(value.type);
+		case AstNodeType_e::ConstantRealExpr:
+			{
+				auto realDecl = exprDecl->to<ast::expr::ExpressionConstantRealDecl>();
+				value = vm::makeReal(vm::toValueType(realDecl->valueType), realDecl->valueDecl);
+			}
+			return vm::isReal(value.type);
+		case AstNodeType_e::ConstantCharExpr:
+			value = vm::makeInteger(vm::ValueType_e::I8, exprDecl->to<ast::expr::ExpressionConstantCharDecl>()->valueDecl);
+			return true;
+		case AstNodeType_e::ConstantNullExpr:
+			value = vm::makeNull();
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static Bool
+	isSameConstructor(Pattern_s* const lhs, Pattern_s* const rhs)
+	{
+		if (lhs->kind != rhs->kind)
+		{
+			return false;
+		}
+
+		if (lhs->kind == PatternKind_e::Constructor)
+		{
+			return lhs->domain == rhs->domain && lhs->index == rhs->index;
+		}
+
+		// Strings sao comparadas pelo texto, os numeros seguem a igualdade da maquina virtual.
+		if (lhs->value.type == vm::ValueType_e::String || rhs->value.type == vm::ValueType_e::String)
+		{
+			return lhs->value.type == rhs->value.type && lhs->name == rhs->name;
+		}
+		return vm::isEqual(lhs->value, rhs->value);
+	}
+
+	static String
+	getPatternName(Pattern_s* const pattern)
+	{
+		if (pattern->name.size())
+		{
+			return pattern->name;
+		}
+		return pattern->kind == PatternKind_e::Constant
+			? vm::formatValue(pattern->value)
+			: String("_");
+	}
+
+	static void
+	dumpDecision(std::stringstream& ss, Decision_s* const decision, U32 indent)
+	{
+		const String padding(indent * 2, ' ');
+
+		switch (decision->type)
+		{
+		case DecisionType_e::Fail:
+			ss << "fail\n";
+			break;
+		case DecisionType_e::Leaf:
+			ss << "arm " << decision->armIndex << "\n";
+			break;
+		case DecisionType_e::Test:
+			ss << "test " << decision->access << " == " << getPatternName(decision->testPattern) << "\n";
+			ss << padding << "  then: ";
+			dumpDecision(ss, decision->successDecision, indent + 1);
+			ss << padding << "  else: ";
+			dumpDecision(ss, decision->defaultDecision, indent + 1);
+			break;
+		case DecisionType_e::Switch:
+			ss << "switch " << decision->access << "\n";
+			for (auto& caseItem : decision->caseList)
+			{
+				ss << padding << "  case " << getPatternName(caseItem.pattern) << ": ";
+				dumpDecision(ss, caseItem.decision, indent + 1);
+			}
+
+			if (decision->defaultDecision)
+			{
+				ss << padding << "  default: ";
+				dumpDecision(ss, decision->defaultDecision, indent + 1);
+			}
+			break;
+		}
+	}
+
+	/**
+	 * DecisionTree
+	 */
+
+	DecisionTree::DecisionTree(U32 armCount)
+		: mRoot(nullptr)
+		, mArmCount(armCount)
+		, mReachableList(armCount, false)
+	{}
+
+	DecisionTree::~DecisionTree()
+	{}
+
+	Decision_s*
+	DecisionTree::getRoot()
+	{
+		return mRoot;
+	}
+
+	U32
+	DecisionTree::getArmCount()
+	{
+		return mArmCount;
+	}
+
+	Bool
+	DecisionTree::isExhaustive()
+	{
+		return mMissingList.empty();
+	}
+
+	const std::vector<String>&
+	DecisionTree::getMissingList()
+	{
+		return mMissingList;
+	}
+
+	std::vector<U32>
+	DecisionTree::getRedundantArmList()
+	{
+		std::vector<U32> redundantArmList;
+
+		for (U32 armIndex = 0; armIndex < mArmCount; armIndex++)
+		{
+			if (!mReachableList[armIndex])
+			{
+				redundantArmList.push_back(armIndex);
+			}
+		}
+		return redundantArmList;
+	}
+
+	Bool
+	DecisionTree::buildJumpTable(JumpTable_s& jumpTable, U32 minCaseCount)
+	{
+		if (mRoot->type != DecisionType_e::Switch || mRoot->caseList.size() < minCaseCount)
+		{
+			return false;
+		}
+
+		auto getTarget = [this](Decision_s* const decision, JumpTarget_s& target) -> Bool {
+			if (decision == nullptr || decision->type == DecisionType_e::Fail)
+			{
+				target = JumpTarget_s { invalidArm, true };
+				return true;
+			}
+
+			switch (decision->type)
+			{
+			case DecisionType_e::Leaf:
+				// Os literais selecionados pela tabela ja foram comparados, as capturas
+				// ainda precisam atribuir o valor.
+				target = JumpTarget_s { decision->armIndex, mArmPatternList[decision->armIndex]->kind == PatternKind_e::Constant };
+				return true;
+			case DecisionType_e::Test:
+				target = JumpTarget_s { decision->armIndex, false };
+				return true;
+			default:
+				return false;
+			}
+		};
+
+		jumpTable.targetMap.clear();
+
+		for (auto& caseItem : mRoot->caseList)
+		{
+			JumpTarget_s target;
+
+			if (caseItem.pattern->kind != PatternKind_e::Constant || !vm::isInteger(caseItem.pattern->value.type))
+			{
+				return false;
+			}
+
+			if (!getTarget(caseItem.decision, target))
+			{
+				return false;
+			}
+			jumpTable.targetMap.emplace(caseItem.pattern->value.integerValue, target);
+		}
+		return getTarget(mRoot->defaultDecision, jumpTable.defaultTarget);
+	}
+
+	String
+	DecisionTree::dump()
+	{
+		std::stringstream ss;
+		dumpDecision(ss, mRoot, 0);
+		return ss.str();
+	}
+
+	/**
+	 * MatchCompiler
+	 */
+
+	MatchCompiler::MatchCompiler(PatternResolver* const resolver)
+		: mResolver(resolver)
+		, mTree(nullptr)
+		, mWildcard(nullptr)
+	{}
+
+	MatchCompiler::~MatchCompiler()
+	{}
+
+	std::unique_ptr<DecisionTree>
+	MatchCompiler::compile(const std::vector<ast::pattern::PatternDecl*>& patternList)
+	{
+		auto tree = std::make_unique<DecisionTree>(static_cast<U32>(patternList.size()));
+		mTree = tree.get();
+		mWildcard = makePattern(PatternKind_e::Wildcard, nullptr);
+
+		std::vector<Row_s> rowList;
+		for (U32 armIndex = 0; armIndex < patternList.size(); armIndex++)
+		{
+			Pattern_s* const pattern = normalize(patternList[armIndex]);
+
+			tree->mArmPatternList.push_back(pattern);
+			rowList.push_back(Row_s { { pattern }, armIndex });
+		}
+
+		const std::vector<Occurrence_s> occurrenceList = { Occurrence_s { "$", 0 } };
+
+		if (rowList.empty())
+		{
+			appendMissing(occurrenceList[0], "_");
+		}
+		tree->mRoot = compileMatrix(rowList, occurrenceList, nullptr);
+
+		mTree = nullptr;
+		return tree;
+	}
+
+	Pattern_s*
+	MatchCompiler::normalize(ast::pattern::PatternDecl* const patternDecl)
+	{
+		switch (patternDecl->nodeType)
+		{
+		case AstNodeType_e::LiteralPattern:
+		case AstNodeType_e::EnumerablePatternDecl:
+			{
+				const PatternInfo_s info = mResolver->resolve(patternDecl);
+				Pattern_s* const pattern = makePattern(info.kind, patternDecl);
+
+				pattern->value = info.value;
+				pattern->name = info.name;
+				pattern->domain = info.domain;
+				pattern->index = info.index;
+				pattern->domainSize = info.domainSize;
+
+				// Os booleanos formam um dominio de dois itens.
+				if (info.kind == PatternKind_e::Constant && info.value.type == vm::ValueType_e::Bool)
+				{
+					pattern->kind = PatternKind_e::Constructor;
+					pattern->domain = &boolDomain;
+					pattern->index = info.value.boolValue ? 1 : 0;
+					pattern->domainSize = 2;
+					pattern->name = info.value.boolValue ? "true" : "false";
+				}
+
+				if (info.kind == PatternKind_e::Constructor && patternDecl->nodeType == AstNodeType_e::EnumerablePatternDecl)
+				{
+					for (auto& itemDecl : patternDecl->to<ast::pattern::EnumerablePatternDecl>()->patternDeclItemList)
+					{
+						pattern->argumentList.push_back(normalize(itemDecl.get()));
+					}
+				}
+				return pattern;
+			}
+		case AstNodeType_e::TuplePatternDecl:
+			{
+				Pattern_s* const pattern = makePattern(PatternKind_e::Constructor, patternDecl);
+
+				pattern->domain = &tupleDomain;
+				pattern->domainSize = 1;
+
+				for (auto& itemDecl : patternDecl->to<ast::pattern::TuplePatternDecl>()->patternItemDeclList)
+				{
+					pattern->argumentList.push_back(normalize(itemDecl.get()));
+				}
+				return pattern;
+			}
+		case AstNodeType_e::StructurePatternDecl:
+			{
+				Pattern_s* const pattern = makePattern(PatternKind_e::Constructor, patternDecl);
+
+				pattern->domain = &structureDomain;
+				pattern->domainSize = 1;
+
+				// Campos sem subpadrao capturam o valor do campo.
+				for (auto& itemDecl : patternDecl->to<ast::pattern::StructurePatternDecl>()->structureItemDeclList)
+				{
+					pattern->fieldList.push_back(itemDecl->identifier.str());
+					pattern->argumentList.push_back(itemDecl->referencedPattern ? normalize(itemDecl->referencedPattern.get()) : mWildcard);
+				}
+				return pattern;
+			}
+		default:
+			return makePattern(PatternKind_e::Dynamic, patternDecl);
+		}
+	}
+
+	Pattern_s*
+	MatchCompiler::makePattern(PatternKind_e kind, ast::pattern::PatternDecl* const patternDecl)
+	{
+		auto pattern = std::make_unique<Pattern_s>();
+
+		pattern->kind = kind;
+		pattern->patternDecl = patternDecl;
+		pattern->value = vm::makeNull();
+		pattern->domain = nullptr;
+		pattern->index = 0;
+		pattern->domainSize = 0;
+
+		mTree->mPatternList.push_back(std::move(pattern));
+		return mTree->mPatternList.back().get();
+	}
+
+	Decision_s*
+	MatchCompiler::makeDecision(DecisionType_e type)
+	{
+		auto decision = std::make_unique<Decision_s>();
+
+		decision->type = type;
+		decision->depth = 0;
+		decision->armIndex = invalidArm;
+		decision->defaultDecision = nullptr;
+		decision->testPattern = nullptr;
+		decision->successDecision = nullptr;
+
+		mTree->mDecisionList.push_back(std::move(decision));
+		return mTree->mDecisionList.back().get();
+	}
+
+	Decision_s*
+	MatchCompiler::compileMatrix(const std::vector<Row_s>& rowList, const std::vector<Occurrence_s>& occurrenceList, Decision_s* const fallback)
+	{
+		if (rowList.empty())
+		{
+			return fallback ? fallback : makeDecision(DecisionType_e::Fail);
+		}
+
+		const Row_s& firstRow = rowList[0];
+
+		// A primeira linha sem testes seleciona o braco.
+		U32 column = 0;
+		while (column < firstRow.columnList.size() && firstRow.columnList[column]->kind == PatternKind_e::Wildcard)
+		{
+			column++;
+		}
+
+		if (column == firstRow.columnList.size())
+		{
+			Decision_s* const leaf = makeDecision(DecisionType_e::Leaf);
+
+			leaf->armIndex = firstRow.armIndex;
+			mTree->mReachableList[firstRow.armIndex] = true;
+			return leaf;
+		}
+
+		// Valores dinamicos sao testados um a um, o braco e considerado apenas
+		// quando o teste falha e os seguintes continuam na ordem declarada.
+		if (firstRow.columnList[column]->kind == PatternKind_e::Dynamic)
+		{
+			Decision_s* const test = makeDecision(DecisionType_e::Test);
+			std::vector<Row_s> successRowList = rowList;
+			std::vector<Row_s> failureRowList(rowList.begin() + 1, rowList.end());
+
+			successRowList[0].columnList[column] = mWildcard;
+
+			test->access = occurrenceList[column].access;
+			test->depth = occurrenceList[column].depth;
+			test->armIndex = firstRow.armIndex;
+			test->testPattern = firstRow.columnList[column];
+
+			if (failureRowList.empty() && fallback == nullptr)
+			{
+				appendMissing(occurrenceList[column], "_");
+			}
+
+			test->successDecision = compileMatrix(successRowList, occurrenceList, fallback);
+			test->defaultDecision = compileMatrix(failureRowList, occurrenceList, fallback);
+			return test;
+		}
+
+		// As linhas a partir do primeiro valor dinamico da coluna nao podem ser
+		// agrupadas pelo construtor e se tornam a continuacao do switch.
+		for (U32 rowIndex = 1; rowIndex < rowList.size(); rowIndex++)
+		{
+			if (rowList[rowIndex].columnList[column]->kind == PatternKind_e::Dynamic)
+			{
+				const std::vector<Row_s> topRowList(rowList.begin(), rowList.begin() + rowIndex);
+				const std::vector<Row_s> restRowList(rowList.begin() + rowIndex, rowList.end());
+
+				Decision_s* const restDecision = compileMatrix(restRowList, occurrenceList, fallback);
+				return compileSwitch(topRowList, occurrenceList, column, restDecision);
+			}
+		}
+		return compileSwitch(rowList, occurrenceList, column, fallback);
+	}
+
+	Decision_s*
+	MatchCompiler::compileSwitch(const std::vector<Row_s>& rowList, const std::vector<Occurrence_s>& occurrenceList, U32 column, Decision_s* const fallback)
+	{
+		Decision_s* const decision = makeDecision(DecisionType_e::Switch);
+		const Occurrence_s& occurrence = occurrenceList[column];
+
+		decision->access = occurrence.access;
+		decision->depth = occurrence.depth;
+
+		// Construtores na ordem em que aparecem na coluna.
+		std::vector<Pattern_s*> constructorList;
+		for (auto& row : rowList)
+		{
+			Pattern_s* const pattern = row.columnList[column];
+
+			if (pattern->kind == PatternKind_e::Wildcard)
+			{
+				continue;
+			}
+
+			Bool found = false;
+			for (auto constructor : constructorList)
+			{
+				if (isSameConstructor(constructor, pattern))
+				{
+					found = true;
+					break;
+				}
+			}
+
+			if (!found)
+			{
+				constructorList.push_back(pattern);
+			}
+		}
+
+		for (auto constructor : constructorList)
+		{
+			// Aridade do construtor, as estruturas unem os campos citados na coluna.
+			std::vector<String> fieldList;
+			size_t arity = 0;
+
+			for (auto& row : rowList)
+			{
+				Pattern_s* const pattern = row.columnList[column];
+
+				if (!isSameConstructor(constructor, pattern))
+				{
+					continue;
+				}
+
+				for (auto& field : pattern->fieldList)
+				{
+					if (std::find(fieldList.begin(), fieldList.end(), field) == fieldList.end())
+					{
+						fieldList.push_back(field);
+					}
+				}
+				arity = std::max(arity, pattern->argumentList.size());
+			}
+
+			if (fieldList.size())
+			{
+				arity = fieldList.size();
+			}
+
+			// Linhas que aceitam o construtor, com os subpadroes no lugar da coluna.
+			std::vector<Row_s> specializedRowList;
+			for (auto& row : rowList)
+			{
+				Pattern_s* const pattern = row.columnList[column];
+				std::vector<Pattern_s*> argumentList(arity, mWildcard);
+
+				if (pattern->kind != PatternKind_e::Wildcard)
+				{
+					if (!isSameConstructor(constructor, pattern))
+					{
+						continue;
+					}
+
+					for (size_t argumentIndex = 0; argumentIndex < pattern->argumentList.size(); argumentIndex++)
+					{
+						size_t targetIndex = argumentIndex;
+
+						if (fieldList.size())
+						{
+							targetIndex = std::find(fieldList.begin(), fieldList.end(), pattern->fieldList[argumentIndex]) - fieldList.begin();
+						}
+						argumentList[targetIndex] = pattern->argumentList[argumentIndex];
+					}
+				}
+
+				Row_s specializedRow { {}, row.armIndex };
+
+				specializedRow.columnList.insert(specializedRow.columnList.end(), row.columnList.begin(), row.columnList.begin() + column);
+				specializedRow.columnList.insert(specializedRow.columnList.end(), argumentList.begin(), argumentList.end());
+				specializedRow.columnList.insert(specializedRow.columnList.end(), row.columnList.begin() + column + 1, row.columnList.end());
+				specializedRowList.push_back(std::move(specializedRow));
+			}
+
+			std::vector<Occurrence_s> specializedOccurrenceList(occurrenceList.begin(), occurrenceList.begin() + column);
+			for (size_t argumentIndex = 0; argumentIndex < arity; argumentIndex++)
+			{
+				const String field = fieldList.size()
+					? fieldList[argumentIndex]
+					: std::to_string(argumentIndex);
+
+				specializedOccurrenceList.push_back(Occurrence_s { occurrence.access + "." + field, occurrence.depth + 1 });
+			}
+			specializedOccurrenceList.insert(specializedOccurrenceList.end(), occurrenceList.begin() + column + 1, occurrenceList.end());
+
+			decision->caseList.push_back(Case_s {
+				constructor,
+				compileMatrix(specializedRowList, specializedOccurrenceList, fallback)
+			});
+		}
+
+		// Dominios finitos com todos os itens presentes nao precisam de default.
+		Pattern_s* const first = constructorList[0];
+		const Bool complete = first->kind == PatternKind_e::Constructor
+			&& first->domainSize != 0
+			&& constructorList.size() >= first->domainSize;
+
+		if (complete)
+		{
+			return decision;
+		}
+
+		std::vector<Row_s> defaultRowList;
+		for (auto& row : rowList)
+		{
+			if (row.columnList[column]->kind != PatternKind_e::Wildcard)
+			{
+				continue;
+			}
+
+			Row_s defaultRow { row.columnList, row.armIndex };
+			defaultRow.columnList.erase(defaultRow.columnList.begin() + column);
+			defaultRowList.push_back(std::move(defaultRow));
+		}
+
+		if (defaultRowList.empty() && fallback == nullptr)
+		{
+			if (first->kind == PatternKind_e::Constructor && first->domainSize != 0)
+			{
+				for (U32 index = 0; index < first->domainSize; index++)
+				{
+					Bool found = false;
+					for (auto constructor : constructorList)
+					{
+						if (constructor->index == index)
+						{
+							found = true;
+							break;
+						}
+					}
+
+					if (!found)
+					{
+						appendMissing(occurrence, first->domain == &boolDomain
+							? String(index ? "true" : "false")
+							: mResolver->getItemName(first->domain, index));
+					}
+				}
+			}
+			else
+			{
+				appendMissing(occurrence, "_");
+			}
+		}
+
+		std::vector<Occurrence_s> defaultOccurrenceList = occurrenceList;
+		defaultOccurrenceList.erase(defaultOccurrenceList.begin() + column);
+
+		decision->defaultDecision = compileMatrix(defaultRowList, defaultOccurrenceList, fallback);
+		return decision;
+	}
+
+	void
+	MatchCompiler::appendMissing(const Occurrence_s& occurrence, const String& name)
+	{
+		const String missing = occurrence.depth == 0
+			? name
+			: occurrence.access + " = " + name;
+
+		auto& missingList = mTree->mMissingList;
+		if (std::find(missingList.begin(), missingList.end(), missing) == missingList.end())
+		{
+			missingList.push_back(missing);
+		}
+	}
+} }
@@ -1,12 +1,15 @@
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_block.h"
-#include "ast\fl_ast_decl.h"
-#include "ast\fl_ast_expr.h"
-#include "ast\fl_ast_pattern.h"
-#include "ast\fl_ast_stmt.h"
-#include "ast\fl_ast_type.h"
-#include "lexer\fl_lexer.h"
-#include "parser\fl_parser.h"
+#include <algorithm>
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_block.h"
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_type.h"
+#include "lexer/fl_lexer.h"
+#include "parser/fl_parser.h"
+#include "profiler/fl_profiler.h"
+#include "diagnostics/fl_diagnostics.h"
 #include "fl_exceptions.h"
 
 namespace fluffy {
@@ -134,32 +137,145 @@ namespace fluffy {
 		{ TokenType_e::Unknown,				0, true }
 	};
 
-	// Retorna informacoes sobre os operadores.
-	const TokenInfo_t& getOperatorInfo(TokenType_e op)
+	/**
+	 * BindingPower_t
+	 */
+
+	struct BindingPower_t
 	{
-		U32 current_op = 0;
-		while (true)
+		U32				left;	// Forca de ligacao com o operando a esquerda, 0 se nao e operador.
+		U32				right;	// Precedencia minima do operando a direita.
+	};
+
+	/**
+	 * BindingPowerTable_t
+	 */
+
+	struct BindingPowerTable_t
+	{
+		BindingPowerTable_t()
+			: table()
 		{
-			if (op_info[current_op].op == op)
-			{
-				return op_info[current_op];
-			}
-			if (op_info[current_op].op == TokenType_e::Unknown)
+			// Deriva as forcas de ligacao da tabela de precedencia, a primeira
+			// entrada de cada operador prevalece.
+			for (U32 i = 0; op_info[i].op != TokenType_e::Unknown; i++)
 			{
-				return op_info[current_op];
+				const TokenInfo_t& opInfo = op_info[i];
+				BindingPower_t& bindingPower = table[static_cast<U32>(opInfo.op)];
+
+				if (bindingPower.left == 0 && isExprOperator(opInfo.op))
+				{
+					bindingPower.left = opInfo.prec;
+					bindingPower.right = opInfo.left ? opInfo.prec + 1 : opInfo.prec;
+				}
 			}
-			current_op++;
 		}
+
+		BindingPower_t	table[static_cast<U32>(TokenType_e::Eof) + 1];
+	};
+
+	// Retorna a forca de ligacao do operador.
+	const BindingPower_t& getBindingPower(TokenType_e op)
+	{
+		static const BindingPowerTable_t bindingPowerTable;
+		return bindingPowerTable.table[static_cast<U32>(op)];
 	}
+
+	/**
+	 * TypeNameScopeGuard
+	 */
+
+	struct TypeNameScopeGuard
+	{
+		TypeNameScopeGuard(parser::ParserContext_s& ctx, parser::TypeNameScope* const typeNameScope)
+			: ctx(ctx)
+			, previousTypeNameScope(ctx.typeNameScope)
+		{
+			ctx.typeNameScope = typeNameScope;
+		}
+
+		~TypeNameScopeGuard()
+		{
+			ctx.typeNameScope = previousTypeNameScope;
+		}
+
+		parser::ParserContext_s&		ctx;
+		parser::TypeNameScope* const	previousTypeNameScope;
+	};
+
+	/**
+	 * DiagnosticEngineGuard
+	 */
+
+	// Desliga o motor de diagnosticos do lexer enquanto existir.
+	struct DiagnosticEngineGuard
+	{
+		DiagnosticEngineGuard(lexer::Lexer* const lexer)
+			: lexer(lexer)
+			, previousDiagnosticEngine(lexer->getDiagnosticEngine())
+		{
+			lexer->setDiagnosticEngine(nullptr);
+		}
+
+		~DiagnosticEngineGuard()
+		{
+			lexer->setDiagnosticEngine(previousDiagnosticEngine);
+		}
+
+		lexer::Lexer* const						lexer;
+		diagnostics::DiagnosticEngine* const	previousDiagnosticEngine;
+	};
 }
 
 namespace fluffy { namespace parser {
+	///
+	/// TypeNameScope
+	///
+
+	TypeNameScope::TypeNameScope(TypeNameScope* const parent)
+		: m_parent(parent)
+		, m_complete(false)
+	{}
+
+	TypeNameScope::~TypeNameScope()
+	{}
+
+	void
+	TypeNameScope::insertTypeName(const TString& typeName)
+	{
+		m_typeNameSet.insert(typeName);
+	}
+
+	Bool
+	TypeNameScope::findTypeName(const TString& typeName)
+	{
+		if (m_typeNameSet.find(typeName) != m_typeNameSet.end())
+		{
+			return true;
+		}
+		return m_parent != nullptr ? m_parent->findTypeName(typeName) : false;
+	}
+
+	void
+	TypeNameScope::setComplete(Bool complete)
+	{
+		m_complete = complete;
+	}
+
+	Bool
+	TypeNameScope::isComplete()
+	{
+		// Apenas o escopo do code unit sabe se todos os tipos sao conhecidos.
+		return m_parent != nullptr ? m_parent->isComplete() : m_complete;
+	}
+
 	///
 	/// Parser
 	///
 	
 	Parser::Parser(BufferBase* const buffer)
 		: m_lexer(new lexer::Lexer(buffer))
+		, m_hasWildcardInclude(false)
 	{}
 
 	Parser::~Parser()
@@ -198,24 +314,82 @@ namespace fluffy { namespace parser {
 	std::unique_ptr<ast::CodeUnit>
 	Parser::parseCodeUnit(ParserContext_s& ctx)
 	{
+		const profiler::ProfileScope profileScope(profiler::parserPhase, m_lexer->getFilename());
+		const U32 tokenCount = m_lexer->getTokenCount();
+
 		auto codeUnit = std::make_unique<ast::CodeUnit>();
 
 		// Atribui ao code unit o nome do arquivo.
 		codeUnit->identifier = TString(m_lexer->getFilename());
 		m_filename = m_lexer->getFilename();
 
+		// Os erros do lexer e do parser sao registrados no motor do contexto.
+		m_lexer->setDiagnosticEngine(ctx.diagnosticEngine);
+
 		if (m_lexer->isEof()) {
 			return codeUnit;
 		}
 
+		const Bool skipFunctionBody = ctx.skipFunctionBody;
+
+		m_typeNameScopeList.push_back(std::make_unique<TypeNameScope>(nullptr));
+		const TypeNameScopeGuard typeNameScopeGuard(ctx, m_typeNameScopeList.back().get());
+
+		// Primeira fase: processa apenas a estrutura do code unit, montando a
+		// tabela de nomes de tipos. Os corpos das funcoes sao ignorados.
+		m_hasWildcardInclude = false;
+		ctx.skipFunctionBody = true;
+
+		parseCodeUnitStructure(ctx, codeUnit.get());
+
+		ctx.skipFunctionBody = skipFunctionBody;
+
+		// Sem includes com coringa todos os tipos visiveis no code unit sao conhecidos.
+		ctx.typeNameScope->setComplete(!m_hasWildcardInclude);
+
+		// Segunda fase: processa os corpos das funcoes com a tabela completa,
+		// a menos que o processamento tenha sido adiado.
+		if (!skipFunctionBody && hasSkippedBlock())
+		{
+			const Token_s eofToken = m_lexer->getToken();
+
+			for (auto& skippedBlock : releaseSkippedBlockList())
+			{
+				parseSkippedBlock(skippedBlock);
+			}
+
+			// Volta o lexer para o fim do arquivo.
+			m_lexer->resetToPosition(eofToken.position);
+		}
+
+		if (auto activeProfiler = profiler::Profiler::getActive())
+		{
+			activeProfiler->addNodeCount(profiler::lexerPhase, m_filename.c_str(), m_lexer->getTokenCount() - tokenCount);
+		}
+		return codeUnit;
+	}
+
+	void
+	Parser::parseCodeUnitStructure(ParserContext_s& ctx, ast::CodeUnit* const codeUnit)
+	{
 		// Processa declaracoes de include.
 		while (true)
 		{
 			if (m_lexer->isEof()) {
-				return codeUnit;
+				return;
 			}
 			if (m_lexer->isInclude()) {
-				codeUnit->includeDeclList.push_back(parseInclude(ctx));
+				const U32 position = m_lexer->getToken().position;
+
+				try
+				{
+					codeUnit->includeDeclList.push_back(parseInclude(ctx));
+				}
+				catch (exceptions::diagnostic_exception& exception)
+				{
+					checkErrorLimit(ctx, exception);
+					synchronize(position, false);
+				}
 				continue;
 			}
 			break;
@@ -227,31 +401,32 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			// Processa namespaces.
-			if (m_lexer->isNamespace()) {
-				codeUnit->namespaceDeclList.push_back(parseNamespace(ctx));
-				continue;
-			}
+			const U32 position = m_lexer->getToken().position;
 
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{
-					TokenType_e::Namespace
-				},
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			try
+			{
+				// Processa namespaces.
+				if (m_lexer->isNamespace()) {
+					codeUnit->namespaceDeclList.push_back(parseNamespace(ctx));
+					continue;
+				}
+
+				throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
+			}
+			catch (exceptions::diagnostic_exception& exception)
+			{
+				checkErrorLimit(ctx, exception);
+				synchronize(position, false);
+			}
 		}
-		return codeUnit;
 	}
 
 	std::unique_ptr<ast::IncludeDecl>
 	Parser::parseInclude(ParserContext_s& ctx)
 	{
 		auto includeDecl = std::make_unique<ast::IncludeDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'include'.
@@ -264,8 +439,8 @@ namespace fluffy { namespace parser {
 		while (true)
 		{
 			auto includeItemDecl = std::make_unique<ast::IncludeItemDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Consome identificador
@@ -278,6 +453,9 @@ namespace fluffy { namespace parser {
 				m_lexer->expectToken(TokenType_e::Multiplication);
 
 				includeItemDecl->includeAll = true;
+
+				// Os nomes incluidos pelo coringa so sao conhecidos na resolucao dos includes.
+				m_hasWildcardInclude = true;
 			}
 			else if (m_lexer->isIdentifier())
 			{
@@ -308,6 +486,12 @@ namespace fluffy { namespace parser {
 
 			}
 
+			// O item incluido pode ser um tipo.
+			if (!includeItemDecl->includeAll)
+			{
+				insertTypeName(ctx, includeItemDecl->identifier);
+			}
+
 			// Inclui item a lista
 			includeDecl->includedItemList.push_back(std::move(includeItemDecl));
 
@@ -339,8 +523,8 @@ namespace fluffy { namespace parser {
 	Parser::parseNamespace(ParserContext_s& ctx)
 	{
 		auto namespaceDecl = std::make_unique<ast::NamespaceDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'namespace'.
@@ -363,15 +547,41 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			// Processa namespace.
-			if (m_lexer->isNamespace())
+			const U32 position = m_lexer->getToken().position;
+			const ParserContext_s declCtx = ctx;
+
+			try
 			{
-				namespaceDecl->namespaceDeclList.push_back(parseNamespace(ctx));
-				continue;
+				// Processa namespace.
+				if (m_lexer->isNamespace())
+				{
+					namespaceDecl->namespaceDeclList.push_back(parseNamespace(ctx));
+					continue;
+				}
+
+				// Processa declaracao geral.
+				namespaceDecl->generalDeclList.push_back(parseGeneralStmt(ctx));
 			}
+			catch (exceptions::diagnostic_exception& exception)
+			{
+				checkErrorLimit(ctx, exception);
+				synchronize(position, true);
 
-			// Processa declaracao geral.
-			namespaceDecl->generalDeclList.push_back(parseGeneralStmt(ctx));
+				// O contexto pode ter ficado no meio de uma classe ou expressao.
+				ctx = declCtx;
+
+				const lexer::SourceLocation_s location = m_lexer->getLocation(position);
+				auto errorDecl = std::make_unique<ast::ErrorDecl>(location.line, location.column);
+				errorDecl->beginPosition = position;
+				errorDecl->endPosition = m_lexer->getToken().position;
+				namespaceDecl->generalDeclList.push_back(std::move(errorDecl));
+
+				// Sem o '}' o namespace termina no fim do arquivo.
+				if (m_lexer->isEof())
+				{
+					return namespaceDecl;
+				}
+			}
 		}
 
 		// Consome '}'.
@@ -384,8 +594,8 @@ namespace fluffy { namespace parser {
 	Parser::parseClass(ParserContext_s& ctx, Bool hasExport)
 	{
 		auto classDecl = std::make_unique<ast::ClassDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		classDecl->isExported = hasExport;
@@ -407,12 +617,18 @@ namespace fluffy { namespace parser {
 		// Valida o identificador.
 		validateIdentifier(classDecl->identifier);
 
+		// Registra o nome do tipo.
+		insertTypeName(ctx, classDecl->identifier);
+
 		// Verifica se a declaracao de generic.
 		if (m_lexer->isLessThan())
 		{
 			classDecl->genericDecl = parseGenericDecl(ctx);
 		}
 
+		// Os parametros do generic sao tipos dentro da classe.
+		const TypeNameScopeGuard typeNameScopeGuard(ctx, createTypeNameScope(ctx, classDecl->genericDecl.get()));
+
 		// Verifica se a declaracao de extends.
 		if (m_lexer->isExtends())
 		{
@@ -425,11 +641,7 @@ namespace fluffy { namespace parser {
 			// Valida a base class.
 			if (classDecl->baseClass->nodeType != AstNodeType_e::NamedType)
 			{
-				throw exceptions::custom_exception(
-					"%s error: The '%s' class extends must be a class element",
-					classDecl->baseClass->line, classDecl->baseClass->column,
-					m_filename.c_str(), classDecl->identifier.str()
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::ClassExtendsNotClass, classDecl->baseClass->line, classDecl->baseClass->column, { classDecl->identifier });
 			}
 		}
 
@@ -446,11 +658,7 @@ namespace fluffy { namespace parser {
 				// Valida a interface.
 				if (implementsDecl->nodeType != AstNodeType_e::NamedType)
 				{
-					throw exceptions::custom_exception(
-						"%s error: The '%s' class implements must be a interface element",
-						implementsDecl->line, implementsDecl->column,
-						m_filename.c_str(), classDecl->identifier.str()
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::ClassImplementsNotInterface, implementsDecl->line, implementsDecl->column, { classDecl->identifier });
 				}
 				classDecl->interfaceList.push_back(std::move(implementsDecl));
 
@@ -499,22 +707,14 @@ namespace fluffy { namespace parser {
 			case TokenType_e::Abstract:
 				if (staticModifier)
 				{
-					throw exceptions::custom_exception(
-						"Static function can't be abstract",
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::StaticFunctionAbstract, {});
 				}
 				goto processFunction;
 
 			case TokenType_e::Override:
 				if (staticModifier)
 				{
-					throw exceptions::custom_exception(
-						"Static function can't be overrided",
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::StaticFunctionOverride, {});
 				}
 				goto processFunction;
 
@@ -532,11 +732,7 @@ namespace fluffy { namespace parser {
 				{
 					if (staticModifier)
 					{
-						throw exceptions::custom_exception(
-							"%s error: Constructors can't be static",
-							m_lexer->getToken().line, m_lexer->getToken().column,
-							m_filename.c_str()
-						);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::StaticConstructor, {});
 					}
 					classDecl->constructorList.push_back(parseClassConstructor(ctx, accessModifier));
 				}
@@ -546,47 +742,24 @@ namespace fluffy { namespace parser {
 				{
 					if (staticModifier)
 					{
-						throw exceptions::custom_exception(
-							"%s error: Destructor can't be static",
-							m_lexer->getToken().line, m_lexer->getToken().column,
-							m_filename.c_str()
-						);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::StaticDestructor, {});
 					}
 
 					if (hasAccessModifier && accessModifier != TokenType_e::Public)
 					{
-						throw exceptions::custom_exception(
-							"%s error: Destructors are public, can't have any access modifier",
-							m_lexer->getToken().line, m_lexer->getToken().column,
-							m_filename.c_str()
-						);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::DestructorAccessModifier, {});
 					}
 
 					if (classDecl->destructorDecl)
 					{
-						throw exceptions::custom_exception(
-							"%s error: Classes must have only one destructor declaration",
-							m_lexer->getToken().line, m_lexer->getToken().column,
-							m_filename.c_str()
-						);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::DuplicatedDestructor, {});
 					}
 					classDecl->destructorDecl = parseClassDestructor(ctx);
 				}
 				break;
 
 			default:
-				throw exceptions::unexpected_with_possibilities_token_exception(
-					m_filename,
-					m_lexer->getToken().value,
-					{
-						TokenType_e::Public, TokenType_e::Protected, TokenType_e::Private,
-						TokenType_e::Let, TokenType_e::Const,
-						TokenType_e::Override, TokenType_e::Abstract, TokenType_e::Fn,
-						TokenType_e::LBracket
-					},
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 			}
 		}
 
@@ -600,8 +773,8 @@ namespace fluffy { namespace parser {
 	Parser::parseInterface(ParserContext_s& ctx, Bool hasExport)
 	{
 		auto interfaceDecl = std::make_unique<ast::InterfaceDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		interfaceDecl->isExported = hasExport;
@@ -615,6 +788,9 @@ namespace fluffy { namespace parser {
 		// Valida o identificador.
 		validateIdentifier(interfaceDecl->identifier);
 
+		// Registra o nome do tipo.
+		insertTypeName(ctx, interfaceDecl->identifier);
+
 		// Consome generic se houver.
 		if (m_lexer->isLessThan())
 		{
@@ -644,13 +820,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{ TokenType_e::Fn, TokenType_e::RBracket },
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome '}'.
@@ -663,8 +833,8 @@ namespace fluffy { namespace parser {
 	Parser::parseStruct(ParserContext_s& ctx, Bool hasExport)
 	{
 		auto structDecl = std::make_unique<ast::StructDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		structDecl->isExported = hasExport;
@@ -678,6 +848,9 @@ namespace fluffy { namespace parser {
 		// Valida o identificador.
 		validateIdentifier(structDecl->identifier);
 
+		// Registra o nome do tipo.
+		insertTypeName(ctx, structDecl->identifier);
+
 		// Consome generic se houver.
 		if (m_lexer->isLessThan())
 		{
@@ -707,13 +880,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{ TokenType_e::Let, TokenType_e::Const, TokenType_e::RBracket },
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome '}'.
@@ -725,8 +892,8 @@ namespace fluffy { namespace parser {
 	std::unique_ptr<ast::GeneralStmtDecl>
 	Parser::parseTrait(ParserContext_s& ctx, Bool hasExport)
 	{
-		const U32 line = m_lexer->getToken().line;
-		const U32 column = m_lexer->getToken().column;
+		const U32 line = m_lexer->getTokenLocation().line;
+		const U32 column = m_lexer->getTokenLocation().column;
 
 		// Consome 'trait'.
 		m_lexer->expectToken(TokenType_e::Trait);
@@ -737,6 +904,9 @@ namespace fluffy { namespace parser {
 		// Valida o identificador.
 		validateIdentifier(identifier);
 
+		// Registra o nome do trait.
+		insertTypeName(ctx, identifier);
+
 		// Consome generic se houver.
 		std::unique_ptr<ast::GenericDecl> genericDecl;
 		if (m_lexer->isLessThan())
@@ -744,6 +914,9 @@ namespace fluffy { namespace parser {
 			genericDecl = parseGenericDecl(ctx);
 		}
 
+		// Os parametros do generic sao tipos dentro do trait.
+		const TypeNameScopeGuard typeNameScopeGuard(ctx, createTypeNameScope(ctx, genericDecl.get()));
+
 		// Verifica se e um definicao de trait.
 		if (m_lexer->isFor())
 		{
@@ -767,12 +940,7 @@ namespace fluffy { namespace parser {
 			if (traitDecl->typeDefinitionDecl->nodeType != AstNodeType_e::PrimitiveType &&
 				traitDecl->typeDefinitionDecl->nodeType != AstNodeType_e::NamedType)
 			{
-				throw exceptions::custom_exception(
-					"%s error: trait definition type must be primitive or named",
-					traitDecl->typeDefinitionDecl->line,
-					traitDecl->typeDefinitionDecl->column,
-					m_filename.c_str()
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::TraitDefinitionType, traitDecl->typeDefinitionDecl->line, traitDecl->typeDefinitionDecl->column, {});
 			}
 
 			ctx.insideTrait = false;
@@ -809,13 +977,7 @@ namespace fluffy { namespace parser {
 					break;
 				}
 
-				throw exceptions::unexpected_with_possibilities_token_exception(
-					m_filename,
-					m_lexer->getToken().value,
-					{ TokenType_e::Fn, TokenType_e::Static, TokenType_e::RBracket },
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 			}
 
 			// Consome '}'.
@@ -866,13 +1028,7 @@ namespace fluffy { namespace parser {
 					break;
 				}
 
-				throw exceptions::unexpected_with_possibilities_token_exception(
-					m_filename,
-					m_lexer->getToken().value,
-					{ TokenType_e::Fn, TokenType_e::Static, TokenType_e::RBracket },
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 			}
 
 			// Consome '}'.
@@ -887,8 +1043,8 @@ namespace fluffy { namespace parser {
 	Parser::parseEnum(ParserContext_s& ctx, Bool hasExport)
 	{
 		auto enumDecl = std::make_unique<ast::EnumDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		enumDecl->isExported = hasExport;
@@ -902,6 +1058,9 @@ namespace fluffy { namespace parser {
 		// Valida o identificador.
 		validateIdentifier(enumDecl->identifier);
 
+		// Registra o nome do tipo.
+		insertTypeName(ctx, enumDecl->identifier);
+
 		// Consome generic se houver.
 		if (m_lexer->isLessThan())
 		{
@@ -934,12 +1093,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome '}'.
@@ -952,8 +1106,8 @@ namespace fluffy { namespace parser {
 	Parser::parseFunction(ParserContext_s& ctx, Bool hasExport)
 	{
 		auto functionPtr = std::make_unique<ast::FunctionDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		functionPtr->isExported = hasExport;
@@ -973,6 +1127,9 @@ namespace fluffy { namespace parser {
 			functionPtr->genericDecl = parseGenericDecl(ctx);
 		}
 
+		// Os parametros do generic sao tipos dentro da funcao.
+		const TypeNameScopeGuard typeNameScopeGuard(ctx, createTypeNameScope(ctx, functionPtr->genericDecl.get()));
+
 		// Consome os parametros.
 		functionPtr->parameterList = parseFunctionParameters(ctx);
 
@@ -989,7 +1146,7 @@ namespace fluffy { namespace parser {
 		{
 			// Consome o tipo retorno.
 			functionPtr->returnType = ast::makePrimitiveType(
-				m_lexer->getToken().line, m_lexer->getToken().column, PrimitiveTypeID_e::Void
+				m_lexer->getTokenLocation().line, m_lexer->getTokenLocation().column, PrimitiveTypeID_e::Void
 			);
 		}
 
@@ -1002,12 +1159,7 @@ namespace fluffy { namespace parser {
 			// Esse tipo de declaracao so pode ser usado com retorno.
 			if (functionPtr->returnType->nodeType == AstNodeType_e::VoidType)
 			{
-				throw exceptions::custom_exception(
-					"Function '%s' with assign('=') can't be void type return",
-					functionPtr->identifier.str(),
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::VoidFunctionAssign, { functionPtr->identifier });
 			}
 
 			// consome expressao.
@@ -1018,7 +1170,7 @@ namespace fluffy { namespace parser {
 		}
 		else
 		{
-			functionPtr->blockDecl = parseBlock(ctx);
+			functionPtr->blockDecl = parseFunctionBlock(ctx);
 		}
 		return functionPtr;
 	}
@@ -1027,8 +1179,8 @@ namespace fluffy { namespace parser {
 	Parser::parseVariable(ParserContext_s& ctx, Bool hasExport)
 	{
 		auto variableDecl = std::make_unique<ast::VariableDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		variableDecl->isExported = hasExport;
@@ -1045,13 +1197,7 @@ namespace fluffy { namespace parser {
 			variableDecl->isConst = true;
 			break;
 		default:
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{ TokenType_e::Let, TokenType_e::Const },
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Verifica se o modificador 'ref' foi declarado.
@@ -1087,8 +1233,8 @@ namespace fluffy { namespace parser {
 			// Consome ':'.
 			m_lexer->expectToken(TokenType_e::Colon);
 
-			const U32 line = m_lexer->getToken().line;
-			const U32 column = m_lexer->getToken().column;
+			const U32 line = m_lexer->getTokenLocation().line;
+			const U32 column = m_lexer->getTokenLocation().column;
 
 			// Consome o tipo.
 			variableDecl->typeDecl = parseType(ctx);
@@ -1099,11 +1245,7 @@ namespace fluffy { namespace parser {
 				auto type = variableDecl->typeDecl->to<ast::TypeDeclPrimitive>();
 				if (type->primitiveType == PrimitiveTypeID_e::Void)
 				{
-					throw exceptions::custom_exception(
-						"Variables or constant can't have void type",
-						line,
-						column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::VoidVariable, line, column, {});
 				}
 			}
 		} else {
@@ -1132,8 +1274,8 @@ namespace fluffy { namespace parser {
 	Parser::parseGenericDecl(ParserContext_s& ctx)
 	{
 		std::unique_ptr<ast::GenericDecl> templateDecl = std::make_unique<ast::GenericDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome '<'
@@ -1142,8 +1284,8 @@ namespace fluffy { namespace parser {
 		while (true)
 		{
 			auto genericDecl = std::make_unique<ast::GenericItemDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Consome o identificador.
@@ -1158,8 +1300,8 @@ namespace fluffy { namespace parser {
 				// Consome 'where'
 				m_lexer->expectToken(TokenType_e::Where);
 
-				const U32 line = m_lexer->getToken().line;
-				const U32 column = m_lexer->getToken().column;
+				const U32 line = m_lexer->getTokenLocation().line;
+				const U32 column = m_lexer->getTokenLocation().column;
 
 				// Consome o identificador
 				auto identifier = m_lexer->expectIdentifier();
@@ -1168,12 +1310,7 @@ namespace fluffy { namespace parser {
 				// apos o where deve ser igual o identificador declarado no generic.
 				if (genericDecl->identifier != identifier)
 				{
-					throw exceptions::custom_exception(
-						"Where identifier must be like generic identifier: %s",
-						line,
-						column,
-						genericDecl->identifier.str()
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::WhereIdentifierNotGeneric, line, column, { genericDecl->identifier });
 				}
 
 				// Consome 'is'
@@ -1185,11 +1322,7 @@ namespace fluffy { namespace parser {
 
 					if (whereTypeDecl->nullable)
 					{
-						throw exceptions::custom_exception(
-							"Where types can't be nullable",
-							line,
-							column
-						);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::WhereTypeNullable, line, column, {});
 					}
 
 					genericDecl->whereTypeList.push_back(std::move(whereTypeDecl));
@@ -1248,8 +1381,8 @@ namespace fluffy { namespace parser {
 	{
 		std::unique_ptr<ast::TypeDecl> typeDecl;
 
-		const U32 line = m_lexer->getToken().line;
-		const U32 column = m_lexer->getToken().column;
+		const U32 line = m_lexer->getTokenLocation().line;
+		const U32 column = m_lexer->getTokenLocation().column;
 
 		switch (m_lexer->getToken().type)
 		{
@@ -1356,11 +1489,7 @@ namespace fluffy { namespace parser {
 			}
 			else
 			{
-				throw exceptions::custom_exception(
-					"%s error: Self type only can be declared in traits",
-					line, column,
-					m_filename.c_str()
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::SelfTypeOutsideTrait, line, column, {});
 			}
 			break;
 		default:
@@ -1371,12 +1500,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Verifica se o tipo e anulavel.
@@ -1387,10 +1511,7 @@ namespace fluffy { namespace parser {
 				auto primitiveType = ast::safe_cast<ast::TypeDeclPrimitive>(typeDecl.get());
 				if (primitiveType->primitiveType == PrimitiveTypeID_e::Void)
 				{
-					throw exceptions::custom_exception("'void' type can't be nullable",
-						line,
-						column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::VoidNullable, line, column, {});
 				}
 			}
 
@@ -1404,8 +1525,8 @@ namespace fluffy { namespace parser {
 		if (m_lexer->isLeftSquBracket())
 		{
 			auto arrayType = std::make_unique<ast::TypeDeclArray>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Adiciona o tipo base ao tipo array
@@ -1437,8 +1558,8 @@ namespace fluffy { namespace parser {
 	Parser::parseBlock(ParserContext_s& ctx)
 	{
 		auto blockDecl = std::make_unique<ast::BlockDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome '{'
@@ -1451,7 +1572,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			blockDecl->stmtList.push_back(parseStmtDecl(ctx));
+			blockDecl->stmtList.push_back(parseStmtDeclOrError(ctx));
 		}
 
 		// Consome '}'
@@ -1460,6 +1581,101 @@ namespace fluffy { namespace parser {
 		return blockDecl;
 	}
 
+	void
+	Parser::parseSkippedBlock(ast::BlockDecl* const blockDecl)
+	{
+		auto it = m_skippedBlockMap.find(blockDecl);
+
+		if (it == m_skippedBlockMap.end())
+		{
+			throw exceptions::custom_exception(
+				"%s error: Block was not skipped by the parser",
+				blockDecl->line, blockDecl->column,
+				m_filename.c_str()
+			);
+		}
+
+		parseSkippedBlock(SkippedBlock_s { blockDecl, it->second });
+		m_skippedBlockMap.erase(it);
+	}
+
+	void
+	Parser::parseSkippedBlock(const SkippedBlock_s& skippedBlock)
+	{
+		ast::BlockDecl* const blockDecl = skippedBlock.blockDecl;
+
+		// O parser pode nao ter processado o code unit, como nas tarefas paralelas.
+		m_filename = m_lexer->getFilename();
+
+		// Restaura o contexto da declaracao da funcao, o corpo e processado por completo.
+		ParserContext_s ctx = skippedBlock.ctx;
+		ctx.skipFunctionBody = false;
+		m_lexer->setDiagnosticEngine(ctx.diagnosticEngine);
+
+		// Volta o lexer para o inicio do bloco.
+		m_lexer->resetToPosition(blockDecl->beginPosition);
+
+		try
+		{
+			// Consome '{'
+			m_lexer->expectToken(TokenType_e::LBracket);
+
+			while (true)
+			{
+				if (m_lexer->isRightBracket())
+				{
+					break;
+				}
+
+				blockDecl->stmtList.push_back(parseStmtDeclOrError(ctx));
+			}
+
+			// Consome '}'
+			m_lexer->expectToken(TokenType_e::RBracket);
+		}
+		catch (exceptions::diagnostic_exception& exception)
+		{
+			// O fim do bloco ja e conhecido, o corpo fica com as instrucoes
+			// lidas antes do erro.
+			checkErrorLimit(ctx, exception);
+		}
+
+		blockDecl->needParse = false;
+	}
+
+	Bool
+	Parser::hasSkippedBlock()
+	{
+		return !m_skippedBlockMap.empty();
+	}
+
+	U32
+	Parser::getTokenCount()
+	{
+		return m_lexer->getTokenCount();
+	}
+
+	std::vector<SkippedBlock_s>
+	Parser::releaseSkippedBlockList()
+	{
+		std::vector<SkippedBlock_s> skippedBlockList;
+		skippedBlockList.reserve(m_skippedBlockMap.size());
+
+		for (auto& it : m_skippedBlockMap)
+		{
+			skippedBlockList.push_back(SkippedBlock_s { it.first, it.second });
+		}
+		m_skippedBlockMap.clear();
+
+		// Mantem a ordem em que os blocos aparecem no codigo.
+		std::sort(skippedBlockList.begin(), skippedBlockList.end(),
+			[](const SkippedBlock_s& a, const SkippedBlock_s& b) {
+				return a.blockDecl->beginPosition < b.blockDecl->beginPosition;
+			}
+		);
+		return skippedBlockList;
+	}
+
 	std::unique_ptr<ast::stmt::StmtDecl>
 	Parser::parseStmtDecl(ParserContext_s& ctx)
 	{
@@ -1518,18 +1734,16 @@ namespace fluffy { namespace parser {
 	std::unique_ptr<ast::expr::ExpressionDecl>
 	Parser::parseExpression(ParserContext_s& ctx, U32 prec)
 	{
-		Bool needGenericValidation = false;
 		std::unique_ptr<ast::expr::ExpressionDecl> expr;
 
 		const U32 beginPosition = m_lexer->getToken().position;
 
 		ctx.insideExpr = true;
-		expr = parseExpressionImp(ctx, prec, &needGenericValidation);
+		expr = parseExpressionImp(ctx, prec);
 		ctx.insideExpr = false;
 
 		expr->beginPosition = beginPosition;
 		expr->endPosition = m_lexer->getToken().position;
-		expr->needGenericValidation = needGenericValidation;
 
 		return expr;
 	}
@@ -1544,8 +1758,6 @@ namespace fluffy { namespace parser {
 		case TokenType_e::Identifier:
 			{
 				const U32 position = m_lexer->getToken().position;
-				const U32 line = m_lexer->getToken().line;
-				const U32 column = m_lexer->getToken().column;
 
 				// Verifica se pode ser um enum destructuring.
 				while (true)
@@ -1564,10 +1776,10 @@ namespace fluffy { namespace parser {
 
 					if (m_lexer->isLeftParBracket())
 					{
-						m_lexer->resetToPosition(position, line, column);
+						m_lexer->resetToPosition(position);
 						return parseEnumerablePattern(ctx);
 					}
-					m_lexer->resetToPosition(position, line, column);
+					m_lexer->resetToPosition(position);
 					break;
 				}
 				return parseLiteralPattern(ctx);
@@ -1578,7 +1790,7 @@ namespace fluffy { namespace parser {
 		case TokenType_e::LBracket:
 			return parseStructurePattern(ctx);
 		default:
-			throw exceptions::not_implemented_feature_exception(m_filename, "pattern matching");
+			throwDiagnostic(diagnostics::DiagnosticCode_e::NotImplementedFeature, { TString("pattern matching") });
 		}
 		return nullptr;
 	}
@@ -1624,8 +1836,8 @@ namespace fluffy { namespace parser {
 			if (m_lexer->isIdentifier())
 			{
 				auto parameterDecl = std::make_unique<ast::FunctionParameterDecl>(
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
 				);
 
 				parameterDecl->isReference = isReference;
@@ -1653,12 +1865,7 @@ namespace fluffy { namespace parser {
 					auto primitiveType = ast::safe_cast<ast::TypeDeclPrimitive>(parameterDecl->typeDecl.get());
 					if (primitiveType->primitiveType == PrimitiveTypeID_e::Void)
 					{
-						throw exceptions::custom_exception(
-							"Parameter '%s' can't have void type",
-							parameterDecl->typeDecl->line,
-							parameterDecl->typeDecl->column,
-							parameterDecl->identifier.str()
-						);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::VoidNamedParameter, parameterDecl->typeDecl->line, parameterDecl->typeDecl->column, { parameterDecl->identifier });
 					}
 				}
 
@@ -1668,8 +1875,8 @@ namespace fluffy { namespace parser {
 			else if (m_lexer->isLeftBracket() || m_lexer->isLeftParBracket())
 			{
 				auto parameterDecl = std::make_unique<ast::FunctionParameterDecl>(
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
 				);
 
 				parameterDecl->isReference = isReference;
@@ -1692,11 +1899,7 @@ namespace fluffy { namespace parser {
 					auto primitiveType = ast::safe_cast<ast::TypeDeclPrimitive>(parameterDecl->typeDecl.get());
 					if (primitiveType->primitiveType == PrimitiveTypeID_e::Void)
 					{
-						throw exceptions::custom_exception(
-							"Parameter can't have void type",
-							parameterDecl->typeDecl->line,
-							parameterDecl->typeDecl->column
-						);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::VoidParameter, parameterDecl->typeDecl->line, parameterDecl->typeDecl->column, {});
 					}
 				}
 
@@ -1717,10 +1920,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::custom_exception("Expected ',' or ')' token",
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedParameterEnd, {});
 		}
 
 		// Consome ')'
@@ -1733,8 +1933,8 @@ namespace fluffy { namespace parser {
 	Parser::parseScopedPath(ParserContext_s& ctx)
 	{
 		auto scopedPathDecl = std::make_unique<ast::ScopedPathDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome o identificador.
@@ -1793,23 +1993,7 @@ namespace fluffy { namespace parser {
 		case TokenType_e::Let:
 			return parseVariable(ctx, hasExport);
 		default:
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{
-					TokenType_e::Abstract,
-					TokenType_e::Class,
-					TokenType_e::Interface,
-					TokenType_e::Struct,
-					TokenType_e::Enum,
-					TokenType_e::Trait,
-					TokenType_e::Let,
-					TokenType_e::Const,
-					TokenType_e::Fn
-				},
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		return nullptr;
@@ -1819,8 +2003,8 @@ namespace fluffy { namespace parser {
 	Parser::parseClassFunction(ParserContext_s& ctx, TokenType_e accessModifier, Bool staticModifier)
 	{
 		auto classFunctionDecl = std::make_unique<ast::ClassFunctionDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Atribui modificador estatico.
@@ -1865,8 +2049,6 @@ namespace fluffy { namespace parser {
 		// e segue a seguint sintaxe: <tipo> '.'
 		Bool	hasSourceTypeDecl = false;
 		U32		position = m_lexer->getToken().position;
-		U32		line = m_lexer->getToken().line;
-		U32		column = m_lexer->getToken().column;
 
 		while (!m_lexer->isLeftParBracket()) {
 			if (m_lexer->isDot())
@@ -1876,7 +2058,7 @@ namespace fluffy { namespace parser {
 			}
 			m_lexer->nextToken();
 		}
-		m_lexer->resetToPosition(position, line, column);
+		m_lexer->resetToPosition(position);
 
 		// Consome o <tipo> seguido de '.'
 		if (hasSourceTypeDecl)
@@ -1897,6 +2079,9 @@ namespace fluffy { namespace parser {
 			classFunctionDecl->genericDecl = parseGenericDecl(ctx);
 		}
 
+		// Os parametros do generic sao tipos dentro da funcao.
+		const TypeNameScopeGuard typeNameScopeGuard(ctx, createTypeNameScope(ctx, classFunctionDecl->genericDecl.get()));
+
 		// Consome os parametros.
 		classFunctionDecl->parameterList = parseFunctionParameters(ctx);
 
@@ -1913,7 +2098,7 @@ namespace fluffy { namespace parser {
 		{
 			// Consome o tipo retorno.
 			classFunctionDecl->returnType = ast::makePrimitiveType(
-				m_lexer->getToken().line, m_lexer->getToken().column, PrimitiveTypeID_e::Void
+				m_lexer->getTokenLocation().line, m_lexer->getTokenLocation().column, PrimitiveTypeID_e::Void
 			);
 		}
 
@@ -1923,12 +2108,7 @@ namespace fluffy { namespace parser {
 			// Funcoes abstratas nao podem ser override ou final
 			if (classFunctionDecl->isAbstract)
 			{
-				throw exceptions::custom_exception(
-					"Abstract function '%s' can't have override or final modifiers",
-					m_lexer->getToken().line,
-					m_lexer->getToken().column,
-					classFunctionDecl->identifier.str()
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::AbstractFunctionModifier, { classFunctionDecl->identifier });
 			}
 			m_lexer->expectToken(TokenType_e::Final);
 			classFunctionDecl->isFinal = true;
@@ -1953,12 +2133,7 @@ namespace fluffy { namespace parser {
 			// Esse tipo de declaracao so pode ser usado com retorno.
 			if (classFunctionDecl->returnType->nodeType == AstNodeType_e::VoidType)
 			{
-				throw exceptions::custom_exception(
-					"Function '%s' with assign('=') can't be void type return",
-					classFunctionDecl->identifier.str(),
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::VoidFunctionAssign, { classFunctionDecl->identifier });
 			}
 
 			// consome expressao.
@@ -1969,7 +2144,7 @@ namespace fluffy { namespace parser {
 		}
 		else
 		{
-			classFunctionDecl->blockDecl = parseBlock(ctx);
+			classFunctionDecl->blockDecl = parseFunctionBlock(ctx);
 		}
 		return classFunctionDecl;
 	}
@@ -1978,8 +2153,8 @@ namespace fluffy { namespace parser {
 	Parser::parseClassVariable(ParserContext_s& ctx, TokenType_e accessModifier, Bool staticModifier)
 	{
 		auto classVariableDecl = std::make_unique<ast::ClassVariableDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Define a variavel como estatica.
@@ -2013,13 +2188,7 @@ namespace fluffy { namespace parser {
 			classVariableDecl->isConst = true;
 			break;
 		default:
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{ TokenType_e::Let, TokenType_e::Const },
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Verifica se o modificador 'ref' foi declarado.
@@ -2055,8 +2224,8 @@ namespace fluffy { namespace parser {
 			// Consome ':'.
 			m_lexer->expectToken(TokenType_e::Colon);
 
-			const U32 line = m_lexer->getToken().line;
-			const U32 column = m_lexer->getToken().column;
+			const U32 line = m_lexer->getTokenLocation().line;
+			const U32 column = m_lexer->getTokenLocation().column;
 
 			// Consome o tipo.
 			classVariableDecl->typeDecl = parseType(ctx);
@@ -2067,11 +2236,7 @@ namespace fluffy { namespace parser {
 				auto primitiveType = ast::safe_cast<ast::TypeDeclPrimitive>(classVariableDecl->typeDecl.get());
 				if (primitiveType->primitiveType == PrimitiveTypeID_e::Void)
 				{
-					throw exceptions::custom_exception(
-						"Variables or constant can't have void type",
-						line,
-						column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::VoidVariable, line, column, {});
 				}
 			}
 		} else {
@@ -2100,8 +2265,8 @@ namespace fluffy { namespace parser {
 	Parser::parseClassConstructor(ParserContext_s& ctx, TokenType_e accessModifier)
 	{
 		auto classConstructorDecl = std::make_unique<ast::ClassConstructorDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 		
 		// Consome 'constructor'.
@@ -2134,8 +2299,8 @@ namespace fluffy { namespace parser {
 				m_lexer->expectToken(TokenType_e::RParBracket);
 			} else {
 				auto variableInitDecl = std::make_unique<ast::ClassVariableInitDecl>(
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
 					);
 
 				// Consome o identificador
@@ -2171,8 +2336,8 @@ namespace fluffy { namespace parser {
 				m_lexer->expectToken(TokenType_e::Comma);
 
 				auto variableInitDecl = std::make_unique<ast::ClassVariableInitDecl>(
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
 				);
 
 				// Consome o identificador
@@ -2207,8 +2372,8 @@ namespace fluffy { namespace parser {
 	Parser::parseClassDestructor(ParserContext_s& ctx)
 	{
 		auto classDestructorDecl = std::make_unique<ast::ClassDestructorDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'destructor'.
@@ -2230,8 +2395,8 @@ namespace fluffy { namespace parser {
 	Parser::parserInterfaceFunction(ParserContext_s& ctx)
 	{
 		auto interfaceFunctionDecl = std::make_unique<ast::InterfaceFunctionDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'fn'
@@ -2265,7 +2430,7 @@ namespace fluffy { namespace parser {
 		{
 			// Consome o tipo retorno.
 			interfaceFunctionDecl->returnType = ast::makePrimitiveType(
-				m_lexer->getToken().line, m_lexer->getToken().column, PrimitiveTypeID_e::Void
+				m_lexer->getTokenLocation().line, m_lexer->getTokenLocation().column, PrimitiveTypeID_e::Void
 			);
 		}
 
@@ -2279,8 +2444,8 @@ namespace fluffy { namespace parser {
 	Parser::parseStructVariable(ParserContext_s& ctx)
 	{
 		auto structVariableDecl = std::make_unique<ast::StructVariableDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		switch (m_lexer->getToken().type)
@@ -2294,13 +2459,7 @@ namespace fluffy { namespace parser {
 			structVariableDecl->isConst = true;
 			break;
 		default:
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{ TokenType_e::Let, TokenType_e::Const },
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Verifica se possui o identificador 'ref'.
@@ -2335,8 +2494,8 @@ namespace fluffy { namespace parser {
 			// Consome ':'.
 			m_lexer->expectToken(TokenType_e::Colon);
 
-			const U32 line = m_lexer->getToken().line;
-			const U32 column = m_lexer->getToken().column;
+			const U32 line = m_lexer->getTokenLocation().line;
+			const U32 column = m_lexer->getTokenLocation().column;
 
 			// Consome o tipo.
 			structVariableDecl->typeDecl = parseType(ctx);
@@ -2347,11 +2506,7 @@ namespace fluffy { namespace parser {
 				auto primitiveType = ast::safe_cast<ast::TypeDeclPrimitive>(structVariableDecl->typeDecl.get());
 				if (primitiveType->primitiveType == PrimitiveTypeID_e::Void)
 				{
-					throw exceptions::custom_exception(
-						"Variables or constant can't have void type",
-						line,
-						column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::VoidVariable, line, column, {});
 				}
 			}
 		} else {
@@ -2380,8 +2535,8 @@ namespace fluffy { namespace parser {
 	Parser::parseTraitFunction(ParserContext_s& ctx, Bool isDefinition, Bool isStatic)
 	{
 		auto traitFunctionDecl = std::make_unique<ast::TraitFunctionDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		traitFunctionDecl->isStatic = isStatic;
@@ -2401,6 +2556,9 @@ namespace fluffy { namespace parser {
 			traitFunctionDecl->genericDecl = parseGenericDecl(ctx);
 		}
 
+		// Os parametros do generic sao tipos dentro da funcao.
+		const TypeNameScopeGuard typeNameScopeGuard(ctx, createTypeNameScope(ctx, traitFunctionDecl->genericDecl.get()));
+
 		ctx.insideTrait = true;
 
 		// Consome os parametros.		
@@ -2425,7 +2583,7 @@ namespace fluffy { namespace parser {
 		{
 			// Consome o tipo retorno.
 			traitFunctionDecl->returnType = ast::makePrimitiveType(
-				m_lexer->getToken().line, m_lexer->getToken().column, PrimitiveTypeID_e::Void
+				m_lexer->getTokenLocation().line, m_lexer->getTokenLocation().column, PrimitiveTypeID_e::Void
 			);
 		}
 
@@ -2442,12 +2600,7 @@ namespace fluffy { namespace parser {
 				// Esse tipo de declaracao so pode ser usado com retorno.
 				if (traitFunctionDecl->returnType->nodeType == AstNodeType_e::VoidType)
 				{
-					throw exceptions::custom_exception(
-						"Function '%s' with assign('=') can't be void type return",
-						traitFunctionDecl->identifier.str(),
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::VoidFunctionAssign, { traitFunctionDecl->identifier });
 				}
 
 				// consome expressao.
@@ -2458,7 +2611,7 @@ namespace fluffy { namespace parser {
 			}
 			else
 			{
-				traitFunctionDecl->blockDecl = parseBlock(ctx);
+				traitFunctionDecl->blockDecl = parseFunctionBlock(ctx);
 			}
 
 			ctx.insideTrait = false;
@@ -2473,8 +2626,8 @@ namespace fluffy { namespace parser {
 	Parser::parseEnumItem(ParserContext_s& ctx)
 	{
 		auto enumItemDecl = std::make_unique<ast::EnumItemDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome o identificador.
@@ -2519,13 +2672,7 @@ namespace fluffy { namespace parser {
 						break;
 					}
 
-					throw exceptions::unexpected_with_possibilities_token_exception(
-						m_filename,
-						m_lexer->getToken().value,
-						{ TokenType_e::Comma, TokenType_e::RParBracket },
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 				}				
 
 				// Consome ')'.
@@ -2540,24 +2687,85 @@ namespace fluffy { namespace parser {
 		return enumItemDecl;
 	}
 
-	std::unique_ptr<ast::stmt::StmtDecl>
-	Parser::parseIf(ParserContext_s& ctx)
+	std::unique_ptr<ast::BlockDecl>
+	Parser::parseFunctionBlock(ParserContext_s& ctx)
 	{
-		auto ifDecl = std::make_unique<ast::StmtIfDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
-		);
-
-		// Consome 'if'.
-		m_lexer->expectToken(TokenType_e::If);
+		// No modo de skim o corpo da funcao e apenas delimitado, o parse
+		// completo e feito sob demanda por parseSkippedBlock.
+		if (ctx.skipFunctionBody)
+		{
+			return skipBlock(ctx);
+		}
+		return parseBlock(ctx);
+	}
 
-		// Consome expressao.
-		ifDecl->conditionExprDecl = parseExpression(ctx, OperatorPrecLevel_e::MinPrec);
+	std::unique_ptr<ast::BlockDecl>
+	Parser::skipBlock(ParserContext_s& ctx)
+	{
+		const U32 beginPosition = m_lexer->getToken().position;
+		const U32 line = m_lexer->getTokenLocation().line;
+		const U32 column = m_lexer->getTokenLocation().column;
 
-		// Consome o block if.
-		ifDecl->ifBlockDecl = parseBlock(ctx);
+		// Consome '{'
+		m_lexer->expectToken(TokenType_e::LBracket);
 
-		// Verifica se existe o bloco else.
+		// Avanca ate o '}' correspondente.
+		U32 depth = 1;
+		while (true)
+		{
+			if (m_lexer->isEof())
+			{
+				throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedEndOfFile, {});
+			}
+
+			if (m_lexer->isLeftBracket())
+			{
+				depth++;
+			}
+			else if (m_lexer->isRightBracket())
+			{
+				if (--depth == 0)
+				{
+					break;
+				}
+			}
+			m_lexer->nextToken();
+		}
+
+		auto blockDecl = std::make_unique<ast::BlockDecl>(
+			beginPosition,
+			m_lexer->getToken().position,
+			line,
+			column
+		);
+
+		// Consome '}'
+		m_lexer->expectToken(TokenType_e::RBracket);
+
+		blockDecl->needParse = true;
+		m_skippedBlockMap.emplace(blockDecl.get(), ctx);
+
+		return blockDecl;
+	}
+
+	std::unique_ptr<ast::stmt::StmtDecl>
+	Parser::parseIf(ParserContext_s& ctx)
+	{
+		auto ifDecl = std::make_unique<ast::StmtIfDecl>(
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
+		);
+
+		// Consome 'if'.
+		m_lexer->expectToken(TokenType_e::If);
+
+		// Consome expressao.
+		ifDecl->conditionExprDecl = parseExpression(ctx, OperatorPrecLevel_e::MinPrec);
+
+		// Consome o block if.
+		ifDecl->ifBlockDecl = parseBlock(ctx);
+
+		// Verifica se existe o bloco else.
 		if (m_lexer->isElse())
 		{
 			// Consome 'else'.
@@ -2574,8 +2782,8 @@ namespace fluffy { namespace parser {
 	Parser::parseIfLet(ParserContext_s& ctx)
 	{
 		auto ifLefDecl = std::make_unique<ast::StmtIfLetDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'if'.
@@ -2612,8 +2820,8 @@ namespace fluffy { namespace parser {
 	Parser::parseFor(ParserContext_s& ctx)
 	{
 		auto forDecl = std::make_unique<ast::StmtForDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 		
 		// Consome 'for'.
@@ -2629,8 +2837,8 @@ namespace fluffy { namespace parser {
 				m_lexer->expectToken(TokenType_e::Let);
 
 				forDecl->initStmtDecl = std::make_unique<ast::StmtForInitDecl>(
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
 				);
 
 				// Consome o identificador.
@@ -2682,8 +2890,8 @@ namespace fluffy { namespace parser {
 	Parser::parseWhile(ParserContext_s& ctx)
 	{
 		auto whileDecl = std::make_unique<ast::StmtWhileDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'while'.
@@ -2702,8 +2910,8 @@ namespace fluffy { namespace parser {
 	Parser::parseDoWhile(ParserContext_s& ctx)
 	{
 		auto doWhileDecl = std::make_unique<ast::StmtDoWhileDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'do'.
@@ -2728,8 +2936,8 @@ namespace fluffy { namespace parser {
 	Parser::parseMatch(ParserContext_s& ctx)
 	{
 		auto matchDecl = std::make_unique<ast::StmtMatchDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'match'.
@@ -2750,8 +2958,8 @@ namespace fluffy { namespace parser {
 
 		parsePatternlabel:
 			auto whenDecl = std::make_unique<ast::StmtMatchWhenDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Consome 'when'.
@@ -2786,16 +2994,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{
-					TokenType_e::Comma,
-					TokenType_e::RBracket
-				},
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome '}'.
@@ -2808,8 +3007,8 @@ namespace fluffy { namespace parser {
 	Parser::parseReturn(ParserContext_s& ctx)
 	{
 		auto returnDecl = std::make_unique<ast::StmtReturnDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'return'.
@@ -2828,8 +3027,8 @@ namespace fluffy { namespace parser {
 	Parser::parseContinue(ParserContext_s& ctx)
 	{
 		auto continueDecl = std::make_unique<ast::StmtContinueDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'continue'.
@@ -2845,8 +3044,8 @@ namespace fluffy { namespace parser {
 	Parser::parseBreak(ParserContext_s& ctx)
 	{
 		auto continueDecl = std::make_unique<ast::StmtBreakDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'break'.
@@ -2862,8 +3061,8 @@ namespace fluffy { namespace parser {
 	Parser::parseGoto(ParserContext_s& ctx)
 	{
 		auto gotoDecl = std::make_unique<ast::StmtGotoDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'goto'.
@@ -2882,8 +3081,8 @@ namespace fluffy { namespace parser {
 	Parser::parseTry(ParserContext_s& ctx)
 	{
 		auto tryDecl = std::make_unique<ast::StmtTryDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'try'.
@@ -2893,8 +3092,8 @@ namespace fluffy { namespace parser {
 		tryDecl->blockDecl = parseBlock(ctx);
 		{
 			auto catchDecl = std::make_unique<ast::stmt::StmtCatchBlockDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Consome 'catch'
@@ -2921,8 +3120,8 @@ namespace fluffy { namespace parser {
 			if (m_lexer->isCatch())
 			{
 				auto catchDecl = std::make_unique<ast::StmtCatchBlockDecl>(
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
 				);
 
 				// Consome 'catch'
@@ -2953,8 +3152,8 @@ namespace fluffy { namespace parser {
 	Parser::parsePanic(ParserContext_s& ctx)
 	{
 		auto panicDecl = std::make_unique<ast::StmtPanicDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'panic'.
@@ -2979,8 +3178,8 @@ namespace fluffy { namespace parser {
 	Parser::parseVariable(ParserContext_s& ctx)
 	{
 		auto variableDecl = std::make_unique<ast::StmtVariableDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome o tipo de variavel.
@@ -2995,16 +3194,7 @@ namespace fluffy { namespace parser {
 			variableDecl->isConst = true;
 			break;
 		default:
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{
-					TokenType_e::Let,
-					TokenType_e::Const
-				},
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome 'ref'.
@@ -3045,8 +3235,8 @@ namespace fluffy { namespace parser {
 			// Consome ':'.
 			m_lexer->expectToken(TokenType_e::Colon);
 
-			const U32 line = m_lexer->getToken().line;
-			const U32 column = m_lexer->getToken().column;
+			const U32 line = m_lexer->getTokenLocation().line;
+			const U32 column = m_lexer->getTokenLocation().column;
 
 			// Consome o tipo.
 			variableDecl->typeDecl = parseType(ctx);
@@ -3057,11 +3247,7 @@ namespace fluffy { namespace parser {
 				auto primitiveType = ast::safe_cast<ast::TypeDeclPrimitive>(variableDecl->typeDecl.get());
 				if (primitiveType->primitiveType == PrimitiveTypeID_e::Void)
 				{
-					throw exceptions::custom_exception(
-						"Variables or constant can't have void type",
-						line,
-						column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::VoidVariable, line, column, {});
 				}
 			}
 		} else {
@@ -3089,8 +3275,8 @@ namespace fluffy { namespace parser {
 	Parser::parseLabel(ParserContext_s& ctx)
 	{
 		auto labelDecl = std::make_unique<ast::StmtLabelDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome identificador.
@@ -3109,8 +3295,8 @@ namespace fluffy { namespace parser {
 	Parser::parseExprStmt(ParserContext_s& ctx)
 	{
 		auto exprDecl = std::make_unique<ast::StmtExprDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome identificador.
@@ -3123,138 +3309,145 @@ namespace fluffy { namespace parser {
 	}
 
 	std::unique_ptr<ast::expr::ExpressionDecl>
-	Parser::parseExpressionImp(ParserContext_s& ctx, U32 prec, Bool* requiredGenericValidation)
+	Parser::parseExpressionImp(ParserContext_s& ctx, U32 prec)
 	{
 		std::unique_ptr<ast::expr::ExpressionDecl> lhs;
 		std::unique_ptr<ast::expr::ExpressionDecl> rhs;
 
-		const U32 line		= m_lexer->getToken().line;
-		const U32 column	= m_lexer->getToken().column;
+		const U32 line		= m_lexer->getTokenLocation().line;
+		const U32 column	= m_lexer->getTokenLocation().column;
 
-		// Processa operadores unarios Prefixo.
-		if (prec > OperatorPrecLevel_e::Unary) {
-			switch (m_lexer->getToken().type)
+		// Processa operadores unarios prefixo, o operando consome todos os
+		// operadores com precedencia igual ou maior a dos unarios.
+		switch (m_lexer->getToken().type)
+		{
+		case TokenType_e::BitWiseNot:
+		case TokenType_e::LogicalNot:
+		case TokenType_e::Minus:
+		case TokenType_e::Plus:
+		case TokenType_e::Increment:
+		case TokenType_e::Decrement:
+		case TokenType_e::Shared:
+		case TokenType_e::Ref:
 			{
-			case TokenType_e::BitWiseNot:
-			case TokenType_e::LogicalNot:
-			case TokenType_e::Minus:
-			case TokenType_e::Plus:
-			case TokenType_e::Increment:
-			case TokenType_e::Decrement:
-			case TokenType_e::Shared:
-			case TokenType_e::Ref:
-				{
-					// Processa superficialmente
-					auto unaryExprDecl = std::make_unique<ast::expr::ExpressionUnaryDecl>(
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
-					);
+				// Processa superficialmente
+				auto unaryExprDecl = std::make_unique<ast::expr::ExpressionUnaryDecl>(
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
+				);
 
-					unaryExprDecl->op = m_lexer->getToken().type;
-					unaryExprDecl->unaryType = ExpressionUnaryType_e::Prefix;
+				unaryExprDecl->op = m_lexer->getToken().type;
+				unaryExprDecl->unaryType = ExpressionUnaryType_e::Prefix;
 
-					// Consome operator.
-					m_lexer->nextToken();
+				// Consome operator.
+				m_lexer->nextToken();
+
+				// Processa expressao a direita.
+				unaryExprDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::Unary);
 
-					// Processa expressao a direita.
-					unaryExprDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::Unary, requiredGenericValidation);
+				lhs = std::move(unaryExprDecl);
 
-					return unaryExprDecl;
+				// Acima da precedencia dos unarios o prefixo e processado isoladamente.
+				if (prec > OperatorPrecLevel_e::Unary) {
+					return lhs;
 				}
-				break;
-			case TokenType_e::Match:
-				{
-					auto matchExprDecl = std::make_unique<ast::expr::ExpressionMatchDecl>(
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
-					);
+			}
+			break;
+		case TokenType_e::Match:
+			{
+				auto matchExprDecl = std::make_unique<ast::expr::ExpressionMatchDecl>(
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
+				);
 
-					// Consome operator.
-					m_lexer->nextToken();
+				// Consome operator.
+				m_lexer->nextToken();
 
-					// Processa expressao a direita.
-					matchExprDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::Unary, requiredGenericValidation);
+				// Processa expressao a direita.
+				matchExprDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::Unary);
 
-					// Consome '{'
-					m_lexer->expectToken(TokenType_e::LBracket);
+				// Consome '{'
+				m_lexer->expectToken(TokenType_e::LBracket);
 
-					// Processa declaracao 'when'
-					while (true)
-					{
-						auto whenDecl = std::make_unique<ast::expr::ExpressionMatchWhenDecl>(
-							m_lexer->getToken().line,
-							m_lexer->getToken().column
-						);
+				// Processa declaracao 'when'
+				while (true)
+				{
+					auto whenDecl = std::make_unique<ast::expr::ExpressionMatchWhenDecl>(
+						m_lexer->getTokenLocation().line,
+						m_lexer->getTokenLocation().column
+					);
 
-						// Consome 'when'
-						m_lexer->expectToken(TokenType_e::When);
+					// Consome 'when'
+					m_lexer->expectToken(TokenType_e::When);
 
-						// Consome pattern.
-						whenDecl->patternDecl = parsePattern(ctx);
+					// Consome pattern.
+					whenDecl->patternDecl = parsePattern(ctx);
 
-						// Consome '->'
-						m_lexer->expectToken(TokenType_e::Arrow);
+					// Consome '->'
+					m_lexer->expectToken(TokenType_e::Arrow);
 
-						// Consome o expressao.
-						whenDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::Interrogation, requiredGenericValidation);
+					// Consome o expressao.
+					whenDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::Interrogation);
 
-						if (m_lexer->isComma())
-						{
-							// Consome ','
-							m_lexer->expectToken(TokenType_e::Comma);
-						}
+					// Adiciona a declaracao when a lista.
+					matchExprDecl->whenDeclList.push_back(std::move(whenDecl));
 
-						if (m_lexer->isRightBracket())
-						{
-							break;
-						}
+					if (m_lexer->isComma())
+					{
+						// Consome ','
+						m_lexer->expectToken(TokenType_e::Comma);
 					}
 
-					// Consome '}'
-					m_lexer->expectToken(TokenType_e::RBracket);
+					if (m_lexer->isRightBracket())
+					{
+						break;
+					}
+				}
 
-					return matchExprDecl;
+				// Consome '}'
+				m_lexer->expectToken(TokenType_e::RBracket);
+
+				lhs = std::move(matchExprDecl);
+
+				// Acima da precedencia dos unarios o prefixo e processado isoladamente.
+				if (prec > OperatorPrecLevel_e::Unary) {
+					return lhs;
 				}
-				break;
-			default:
-				break;
 			}
-		}
+			break;
+		default:
+			{
+				// Processa atomos: constantes, identificadores e expressoes entre parenteses.
+				lhs = parseAtom(ctx);
 
-		// Processa atomos: operadores de precedencia maxima
-		// como constantes e identificadores.
-		if (prec > OperatorPrecLevel_e::Max) {
-			return parseAtom(ctx, requiredGenericValidation);
+				// Acima da precedencia maxima apenas o atomo e processado.
+				if (prec > OperatorPrecLevel_e::Max) {
+					return lhs;
+				}
+			}
+			break;
 		}
 
-		// Processa expressao a esquerda.
-		lhs = parseExpressionImp(ctx, static_cast<OperatorPrecLevel_e>(prec + 1), requiredGenericValidation);
-
 		while (true)
 		{
 			const TokenType_e op = m_lexer->getToken().type;
 
-			// Se nao e um operador de expressao sai do loop.
-			if (!isExprOperator(m_lexer->getToken().type))
-			{
-				break;
-			}
-
 			// Processa operator unario posfixo.
-			switch (m_lexer->getToken().type)
+			switch (op)
 			{
 			case TokenType_e::Increment:
 			case TokenType_e::Decrement:
 				{
-					// Consome o token: '++' ou '--'
-					m_lexer->nextToken();
-
 					auto unaryExprDecl = std::make_unique<ast::expr::ExpressionUnaryDecl>(
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
+						m_lexer->getTokenLocation().line,
+						m_lexer->getTokenLocation().column
 					);
 
-					unaryExprDecl->op = m_lexer->getToken().type;
+					unaryExprDecl->op = op;
+
+					// Consome o token: '++' ou '--'
+					m_lexer->nextToken();
+
 					unaryExprDecl->unaryType = ExpressionUnaryType_e::Posfix;
 					unaryExprDecl->exprDecl = std::move(lhs);
 
@@ -3265,17 +3458,15 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			// Pega informacoes do operador.
-			const auto& opInfo = getOperatorInfo(m_lexer->getToken().type);
+			// Pega a forca de ligacao do operador, tokens que nao sao
+			// operadores de expressao tem forca 0.
+			const BindingPower_t& bindingPower = getBindingPower(op);
 
-			// Retorna se precedencia dele e menor que a atual da funcao.
-			if (opInfo.prec < prec) {
+			// Retorna se o operador liga com menos forca que a precedencia atual.
+			if (bindingPower.left == 0 || bindingPower.left < prec) {
 				break;
 			}
 
-			// Calcula proxima precedencia minima.
-			U32 nextMinPrec = opInfo.left ? opInfo.prec + 1 : opInfo.prec;
-			
 			// Consome o operador.
 			m_lexer->nextToken();
 
@@ -3304,7 +3495,7 @@ namespace fluffy { namespace parser {
 						column
 					);
 					functionCallExpr->lhsDecl = std::move(lhs);
-					functionCallExpr->rhsDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec, requiredGenericValidation);
+					functionCallExpr->rhsDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec);
 
 					// Consome ')'
 					m_lexer->expectToken(TokenType_e::RParBracket);
@@ -3321,7 +3512,7 @@ namespace fluffy { namespace parser {
 					);
 
 					indexAddressExpr->lhsDecl = std::move(lhs);
-					indexAddressExpr->rhsDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec, requiredGenericValidation);
+					indexAddressExpr->rhsDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec);
 
 					// Consome ']'
 					m_lexer->expectToken(TokenType_e::RSquBracket);
@@ -3332,180 +3523,62 @@ namespace fluffy { namespace parser {
 				break;
 			case TokenType_e::LessThan:
 				{
-					const U32	position = m_lexer->getToken().position;
-					const U32	line = m_lexer->getToken().line;
-					const U32	column = m_lexer->getToken().column;
-
-					// Tenta predizer a presenca de um generic.
-					Bool hasGeneric = false;
-					Bool finishParse = false;
-					while (!finishParse) {
-						switch (m_lexer->getToken().type)
-						{
-						case TokenType_e::Void:
-							finishParse = true;
-							break;
-						case TokenType_e::Bool:
-						case TokenType_e::I8:
-						case TokenType_e::U8:
-						case TokenType_e::I16:
-						case TokenType_e::U16:
-						case TokenType_e::I32:
-						case TokenType_e::U32:
-						case TokenType_e::I64:
-						case TokenType_e::U64:
-						case TokenType_e::Fp32:
-						case TokenType_e::Fp64:
-						case TokenType_e::String:
-						case TokenType_e::Object:
-						case TokenType_e::Identifier:
-						case TokenType_e::ScopeResolution:
-						case TokenType_e::Comma:
-							m_lexer->nextToken();	// Consome token.
-							continue;
-						case TokenType_e::GreaterThan:
-							if (m_lexer->predictNextToken().type == TokenType_e::LParBracket)
-							{
-								finishParse = true;
-								hasGeneric = true;
-								m_lexer->resetToPosition(position, line, column);
-							}
-							else
-							{
-								finishParse = true;
-								m_lexer->resetToPosition(position, line, column);
-							}
-							break;
-						default:
-							finishParse = true;
-							m_lexer->resetToPosition(position, line, column);
-							break;
-						}
-					}
-
-					// Verifica deve fazer o processamento do generic.
-					if (!hasGeneric)
+					// A tabela de nomes de tipos decide se o '<' inicia um generic.
+					if (!isGenericCall(ctx))
 					{
 						break;
 					}
 
 					auto exprGenericDef = std::make_unique<ast::expr::ExpressionGenericCallDecl>(
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
+						m_lexer->getTokenLocation().line,
+						m_lexer->getTokenLocation().column
 					);
 
-					Bool		parseGeneric = false;
-					Bool		expectType = false;					
-
+					// Consome os tipos do generic.
 					while (true)
 					{
-						switch (m_lexer->getToken().type)
+						if (m_lexer->isVoid())
 						{
-						case TokenType_e::Void:
-							{
-								throw exceptions::custom_exception(
-									"Generic item can't be 'void'",
-									m_lexer->getToken().line,
-									m_lexer->getToken().column
-								);
-							}
-							break;
-						case TokenType_e::Bool:
-						case TokenType_e::I8:
-						case TokenType_e::U8:
-						case TokenType_e::I16:
-						case TokenType_e::U16:
-						case TokenType_e::I32:
-						case TokenType_e::U32:
-						case TokenType_e::I64:
-						case TokenType_e::U64:
-						case TokenType_e::Fp32:
-						case TokenType_e::Fp64:
-						case TokenType_e::String:
-						case TokenType_e::Object:
-						case TokenType_e::Identifier:
-						case TokenType_e::ScopeResolution:
-							{
-								// Consome o tipo.
-								expectType = false;
-								auto typeDecl = parseType(ctx);
+							throwDiagnostic(diagnostics::DiagnosticCode_e::VoidGenericItem, {});
+						}
 
-								// TODO: Verificar se e um tipo ou uma instancia de dados.
+						exprGenericDef->genericTypeList.push_back(parseType(ctx));
 
-								// Adiciona o template a lista.
-								exprGenericDef->genericTypeList.push_back(std::move(typeDecl));
-								continue;
-							}
-							break;
-						case TokenType_e::Comma:
-							{
-								expectType = true;
-								m_lexer->nextToken();	// Consome ','
-								continue;
-							}
+						if (!m_lexer->isComma())
+						{
 							break;
-						case TokenType_e::GreaterThan:
-							if (m_lexer->predictNextToken().type == TokenType_e::LParBracket) {
-								m_lexer->nextToken();	// Consome '>'
-								m_lexer->nextToken();	// Consome '('
-
-								*requiredGenericValidation = true;
-
-								parseGeneric = true;
-								finishParse = true;
-
-								// Verfica se e esperado uma declaracao de tipo.
-								if (expectType)
-								{
-									throw exceptions::custom_exception(
-										"Expect type decl",
-										m_lexer->getToken().line,
-										m_lexer->getToken().column
-									);
-								}
-
-								exprGenericDef->lhsDecl = std::move(lhs);
+						}
 
-								if (!m_lexer->isRightParBracket())
-								{
-									exprGenericDef->rhsDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec, requiredGenericValidation);
-								}
+						// Consome ','
+						m_lexer->expectToken(TokenType_e::Comma);
+					}
 
-								// Consome ')'
-								m_lexer->expectToken(TokenType_e::RParBracket);
+					// Consome '>'
+					m_lexer->expectToken(TokenType_e::GreaterThan);
 
-								lhs = std::move(exprGenericDef);
-							} else {
-								finishParse = true;
-								m_lexer->resetToPosition(position, line, column);
-							}
-							break;
-						default:
-							finishParse = true;
-							m_lexer->resetToPosition(position, line, column);
-							break;
-						}
+					// Consome '('
+					m_lexer->expectToken(TokenType_e::LParBracket);
 
-						// Quebra o loop.
-						if (finishParse)
-						{
-							break;
-						}
-					}
+					exprGenericDef->lhsDecl = std::move(lhs);
 
-					// Verifica se houve o processamento do generic.
-					if (parseGeneric)
+					if (!m_lexer->isRightParBracket())
 					{
-						continue;
+						exprGenericDef->rhsDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec);
 					}
+
+					// Consome ')'
+					m_lexer->expectToken(TokenType_e::RParBracket);
+
+					lhs = std::move(exprGenericDef);
+					continue;
 				}
 				break;
 
 			case TokenType_e::As:
 				{
 					auto asExpr = std::make_unique<ast::expr::ExpressionAsDecl>(
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
+						m_lexer->getTokenLocation().line,
+						m_lexer->getTokenLocation().column
 					);
 
 					asExpr->exprDecl = std::move(lhs);
@@ -3519,8 +3592,8 @@ namespace fluffy { namespace parser {
 			case TokenType_e::Is:
 				{
 					auto isExpr = std::make_unique<ast::expr::ExpressionIsDecl>(
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
+						m_lexer->getTokenLocation().line,
+						m_lexer->getTokenLocation().column
 					);
 
 					isExpr->exprDecl = std::move(lhs);
@@ -3536,7 +3609,7 @@ namespace fluffy { namespace parser {
 			}
 
 			// Processa expressao a direita.
-			rhs = parseExpressionImp(ctx, static_cast<OperatorPrecLevel_e>(nextMinPrec), requiredGenericValidation);
+			rhs = parseExpressionImp(ctx, bindingPower.right);
 
 			// Verifica se a operacao e ternaria
 			if (op == TokenType_e::Interrogation)
@@ -3551,7 +3624,7 @@ namespace fluffy { namespace parser {
 
 				ternaryExprDecl->conditionDecl = std::move(lhs);
 				ternaryExprDecl->leftDecl = std::move(rhs);
-				ternaryExprDecl->rightDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec, requiredGenericValidation);
+				ternaryExprDecl->rightDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec);
 
 				lhs = std::move(ternaryExprDecl);
 				break;
@@ -3573,10 +3646,10 @@ namespace fluffy { namespace parser {
 	}
 
 	std::unique_ptr<ast::expr::ExpressionDecl>
-	Parser::parseAtom(ParserContext_s& ctx, Bool* requiredGenericValidation)
+	Parser::parseAtom(ParserContext_s& ctx)
 	{
-		const U32 line = m_lexer->getToken().line;
-		const U32 column = m_lexer->getToken().column;
+		const U32 line = m_lexer->getTokenLocation().line;
+		const U32 column = m_lexer->getTokenLocation().column;
 
 		// Processa expressao entre parenteses.
 		if (m_lexer->isLeftParBracket())
@@ -3587,7 +3660,7 @@ namespace fluffy { namespace parser {
 			m_lexer->expectToken(TokenType_e::LParBracket);
 
 			// Processa expressao.
-			expr = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec, requiredGenericValidation);
+			expr = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec);
 
 			// Ajusta a posicao inicial
 			expr->line = line;
@@ -3603,8 +3676,8 @@ namespace fluffy { namespace parser {
 		if (m_lexer->isLeftSquBracket())
 		{
 			auto arrayIniDecl = std::make_unique<ast::ExpressionArrayInitDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Consome '['
@@ -3618,7 +3691,7 @@ namespace fluffy { namespace parser {
 				}
 
 				// Consome elemento
-				arrayIniDecl->arrayElementDeclList.push_back(parseExpressionImp(ctx, OperatorPrecLevel_e::Interrogation, requiredGenericValidation));
+				arrayIniDecl->arrayElementDeclList.push_back(parseExpressionImp(ctx, OperatorPrecLevel_e::Interrogation));
 
 				if (m_lexer->isComma())
 				{
@@ -3658,8 +3731,8 @@ namespace fluffy { namespace parser {
 
 			if (m_lexer->isIdentifier() || m_lexer->isLeftBracket() || m_lexer->isLeftParBracket()) {
 				auto paramDecl = std::make_unique<ast::expr::ExpressionFunctionParameterDecl>(
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
 				);
 
 				// Consome os patterns ou o identificador.
@@ -3691,8 +3764,8 @@ namespace fluffy { namespace parser {
 						while (true)
 						{
 							paramDecl = std::make_unique<ast::expr::ExpressionFunctionParameterDecl>(
-								m_lexer->getToken().line,
-								m_lexer->getToken().column
+								m_lexer->getTokenLocation().line,
+								m_lexer->getTokenLocation().column
 							);
 
 							// Consome os patterns ou o identificador.
@@ -3725,12 +3798,7 @@ namespace fluffy { namespace parser {
 								auto primitiveType = ast::safe_cast<ast::TypeDeclPrimitive>(paramDecl->typeDecl.get());
 								if (primitiveType->primitiveType == PrimitiveTypeID_e::Void)
 								{
-									throw exceptions::custom_exception(
-										"Parameter '%s' can't have void type",
-										m_lexer->getToken().line,
-										m_lexer->getToken().column,
-										paramDecl->identifier.str()
-									);
+									throwDiagnostic(diagnostics::DiagnosticCode_e::VoidNamedParameter, { paramDecl->identifier });
 								}
 							}
 
@@ -3749,16 +3817,7 @@ namespace fluffy { namespace parser {
 								break;
 							}
 
-							throw exceptions::unexpected_with_possibilities_token_exception(
-								m_filename,
-								m_lexer->getToken().value,
-								{
-									TokenType_e::Comma,
-									TokenType_e::BitWiseOr
-								},
-								m_lexer->getToken().line,
-								m_lexer->getToken().column
-							);
+							throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 						}
 					}
 				} else {
@@ -3784,8 +3843,8 @@ namespace fluffy { namespace parser {
 						while (true)
 						{
 							auto paramDecl = std::make_unique<ast::expr::ExpressionFunctionParameterDecl>(
-								m_lexer->getToken().line,
-								m_lexer->getToken().column
+								m_lexer->getTokenLocation().line,
+								m_lexer->getTokenLocation().column
 							);
 
 							// Consome os patterns ou o identificador.
@@ -3821,16 +3880,7 @@ namespace fluffy { namespace parser {
 								break;
 							}
 
-							throw exceptions::unexpected_with_possibilities_token_exception(
-								m_filename,
-								m_lexer->getToken().value,
-								{
-									TokenType_e::Comma,
-									TokenType_e::BitWiseOr
-								},
-								m_lexer->getToken().line,
-								m_lexer->getToken().column
-							);
+							throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 						}
 					}
 				}
@@ -3865,11 +3915,7 @@ namespace fluffy { namespace parser {
 				// Esse tipo de declaracao so pode ser usado com retorno.
 				if (functionDecl->returnTypeDecl && functionDecl->returnTypeDecl->nodeType == AstNodeType_e::VoidType)
 				{
-					throw exceptions::custom_exception(
-						"Anom function with assign('=') can't be void type return",
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
-					);
+					throwDiagnostic(diagnostics::DiagnosticCode_e::VoidAnomFunctionAssign, {});
 				}
 
 				// Consom expressao
@@ -3887,8 +3933,8 @@ namespace fluffy { namespace parser {
 		if (m_lexer->isNew())
 		{
 			auto newDecl = std::make_unique<ast::ExpressionNewDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Consome 'new'
@@ -3905,7 +3951,7 @@ namespace fluffy { namespace parser {
 				// Consome expressao no caso os parametros passados para o construtor.
 				if (!m_lexer->isRightParBracket())
 				{
-					newDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec, requiredGenericValidation);
+					newDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::MinPrec);
 				}
 
 				// Consome ')'
@@ -3919,8 +3965,8 @@ namespace fluffy { namespace parser {
 				m_lexer->expectToken(TokenType_e::LBracket);
 				
 				newDecl->objInitBlockDecl = std::make_unique<ast::ExpressionNewBlockDecl>(
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
+					m_lexer->getTokenLocation().line,
+					m_lexer->getTokenLocation().column
 				);
 
 				while (true)
@@ -3931,8 +3977,8 @@ namespace fluffy { namespace parser {
 					}
 
 					auto itemDecl = std::make_unique<ast::expr::ExpressionNewItemDecl>(
-						m_lexer->getToken().line,
-						m_lexer->getToken().column
+						m_lexer->getTokenLocation().line,
+						m_lexer->getTokenLocation().column
 					);
 
 					// Processa identificador.
@@ -3947,7 +3993,7 @@ namespace fluffy { namespace parser {
 						m_lexer->expectToken(TokenType_e::Colon);
 
 						// Consome expressao.
-						itemDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::EnumExpr, requiredGenericValidation);
+						itemDecl->exprDecl = parseExpressionImp(ctx, OperatorPrecLevel_e::EnumExpr);
 					}
 
 					// Adiciona item ao bloco.
@@ -4107,22 +4153,14 @@ namespace fluffy { namespace parser {
 						case TokenType_e::Abstract:
 							if (staticModifier)
 							{
-								throw exceptions::custom_exception(
-									"Static function can't be abstract",
-									m_lexer->getToken().line,
-									m_lexer->getToken().column
-								);
+								throwDiagnostic(diagnostics::DiagnosticCode_e::StaticFunctionAbstract, {});
 							}
 							goto processFunction;
 
 						case TokenType_e::Override:
 							if (staticModifier)
 							{
-								throw exceptions::custom_exception(
-									"Static function can't be overrided",
-									m_lexer->getToken().line,
-									m_lexer->getToken().column
-								);
+								throwDiagnostic(diagnostics::DiagnosticCode_e::StaticFunctionOverride, {});
 							}
 							goto processFunction;
 
@@ -4140,11 +4178,7 @@ namespace fluffy { namespace parser {
 							{
 								if (staticModifier)
 								{
-									throw exceptions::custom_exception(
-										"Constructors can't be static",
-										m_lexer->getToken().line,
-										m_lexer->getToken().column
-									);
+									throwDiagnostic(diagnostics::DiagnosticCode_e::StaticConstructor, {});
 								}
 								anomObjectImpl->constructorList.push_back(parseClassConstructor(ctx, accessModifier));
 							}
@@ -4154,38 +4188,19 @@ namespace fluffy { namespace parser {
 							{
 								if (staticModifier)
 								{
-									throw exceptions::custom_exception(
-										"Destructor can't be static",
-										m_lexer->getToken().line,
-										m_lexer->getToken().column
-									);
+									throwDiagnostic(diagnostics::DiagnosticCode_e::StaticDestructor, {});
 								}
 
 								if (hasAccessModifier)
 								{
-									throw exceptions::custom_exception(
-										"Destructors are public, can't have any access modifier",
-										m_lexer->getToken().line,
-										m_lexer->getToken().column
-									);
+									throwDiagnostic(diagnostics::DiagnosticCode_e::DestructorAccessModifier, {});
 								}
 								anomObjectImpl->destructorDecl = parseClassDestructor(ctx);
 							}
 							break;
 
 						default:
-							throw exceptions::unexpected_with_possibilities_token_exception(
-								m_filename,
-								m_lexer->getToken().value,
-								{
-									TokenType_e::Public, TokenType_e::Protected, TokenType_e::Private,
-									TokenType_e::Let, TokenType_e::Const,
-									TokenType_e::Override, TokenType_e::Abstract, TokenType_e::Fn,
-									TokenType_e::LBracket
-								},
-								m_lexer->getToken().line,
-								m_lexer->getToken().column
-							);
+							throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 						}
 					}
 
@@ -4214,8 +4229,8 @@ namespace fluffy { namespace parser {
 			m_lexer->expectToken(TokenType_e::ScopeResolution);
 
 			auto namedExpressionDecl = std::make_unique<ast::expr::ExpressionIdentifierDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			namedExpressionDecl->identifier = m_lexer->expectIdentifier();
@@ -4231,20 +4246,15 @@ namespace fluffy { namespace parser {
 		if (m_lexer->isIdentifier())
 		{
 			auto namedExpressionDecl = std::make_unique<ast::expr::ExpressionIdentifierDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			namedExpressionDecl->identifier = m_lexer->expectIdentifier();
 			return namedExpressionDecl;
 		}
 
-		throw exceptions::unexpected_token_exception(
-			m_filename,
-			m_lexer->getToken().value,
-			line,
-			column
-		);
+		throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, line, column, { TString(m_lexer->getToken().value.c_str()) });
 		return nullptr;
 	}
 
@@ -4252,12 +4262,12 @@ namespace fluffy { namespace parser {
 	Parser::parseLiteralPattern(ParserContext_s& ctx)
 	{
 		auto literalPatternDecl = std::make_unique<ast::pattern::LiteralPatternDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
-		// Consome uma expressao.
-		if (m_lexer->isIdentifier())
+		// Consome uma expressao, caminhos como 'Color::Red' sao comparados com o valor.
+		if (m_lexer->isIdentifier() && m_lexer->predictNextToken().type != TokenType_e::ScopeResolution)
 		{
 			literalPatternDecl->identifier = m_lexer->expectIdentifier();
 		}
@@ -4272,8 +4282,8 @@ namespace fluffy { namespace parser {
 	Parser::parseTuplePattern(ParserContext_s& ctx)
 	{
 		auto tuplePatternDecl = std::make_unique<ast::pattern::TuplePatternDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome '('
@@ -4296,16 +4306,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{
-					TokenType_e::RParBracket,
-					TokenType_e::Identifier
-				},
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome ')'
@@ -4318,8 +4319,8 @@ namespace fluffy { namespace parser {
 	Parser::parseStructurePattern(ParserContext_s& ctx)
 	{
 		auto structurePatternDecl = std::make_unique<ast::pattern::StructurePatternDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome '{'
@@ -4327,8 +4328,8 @@ namespace fluffy { namespace parser {
 
 		while (true) {
 			auto structureItemPatternDecl = std::make_unique<ast::pattern::StructureItemPatternDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Consome o identificador.
@@ -4361,16 +4362,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{
-					TokenType_e::Comma,
-					TokenType_e::RBracket
-				},
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome '}'
@@ -4383,8 +4375,8 @@ namespace fluffy { namespace parser {
 	Parser::parseEnumerablePattern(ParserContext_s& ctx)
 	{
 		auto enumPatternDecl = std::make_unique<ast::pattern::EnumerablePatternDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome tipo.
@@ -4410,16 +4402,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_with_possibilities_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				{
-					TokenType_e::RParBracket,
-					TokenType_e::Identifier
-				},
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome ')'
@@ -4432,8 +4415,8 @@ namespace fluffy { namespace parser {
 	Parser::parseFunctionType(ParserContext_s& ctx)
 	{
 		auto functionTypeDecl = std::make_unique<ast::TypeDeclFunction>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome 'fn'
@@ -4468,12 +4451,7 @@ namespace fluffy { namespace parser {
 			// Parametros nao podem ser nulos.
 			if (m_lexer->isVoid())
 			{
-				throw exceptions::unexpected_type_exception(
-					m_filename,
-					"void",
-					m_lexer->getToken().line,
-					m_lexer->getToken().column
-				);
+				throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedType, { TString("void") });
 			}
 
 			// Consome o tipo do parametro.
@@ -4505,17 +4483,14 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::custom_exception("Expected ')', '->' or ',' declaration",
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::ExpectedFunctionTypeEnd, {});
 		}
 
 		// Se nao ha retorno explicito void e o tipo padrao.
 		if (!hasReturnExplicit)
 		{
 			functionTypeDecl->returnType = ast::makePrimitiveType(
-				m_lexer->getToken().line, m_lexer->getToken().column, PrimitiveTypeID_e::Void
+				m_lexer->getTokenLocation().line, m_lexer->getTokenLocation().column, PrimitiveTypeID_e::Void
 			);
 		}
 
@@ -4529,8 +4504,8 @@ namespace fluffy { namespace parser {
 	Parser::parseTupleType(ParserContext_s& ctx)
 	{
 		auto tupleTypeDecl = std::make_unique<ast::TypeDeclTuple>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome '('.
@@ -4546,11 +4521,7 @@ namespace fluffy { namespace parser {
 					auto primitiveType = ast::safe_cast<ast::TypeDeclPrimitive>(tupleItemDecl.get());
 					if (primitiveType->nodeType == AstNodeType_e::VoidType)
 					{
-						throw exceptions::unexpected_type_exception("void",
-							m_filename,
-							m_lexer->getToken().line,
-							m_lexer->getToken().column
-						);
+						throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedType, { TString("void") });
 					}
 				}
 				tupleTypeDecl->tupleItemList.push_back(std::move(tupleItemDecl));
@@ -4568,12 +4539,7 @@ namespace fluffy { namespace parser {
 				break;
 			}
 
-			throw exceptions::unexpected_token_exception(
-				m_filename,
-				m_lexer->getToken().value,
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::UnexpectedToken, { TString(m_lexer->getToken().value.c_str()) });
 		}
 
 		// Consome ')'.
@@ -4586,8 +4552,8 @@ namespace fluffy { namespace parser {
 	Parser::parseNamedType(ParserContext_s& ctx)
 	{
 		auto namedTypeDecl = std::make_unique<ast::TypeDeclNamed>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 				
 		if (m_lexer->isScopeResolution())
@@ -4601,8 +4567,8 @@ namespace fluffy { namespace parser {
 		while (m_lexer->isIdentifier() && m_lexer->predictNextToken().type == TokenType_e::ScopeResolution)
 		{
 			auto scopedPathDecl = std::make_unique<ast::ScopedPathDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 
 			// Consome identificador.
@@ -4688,8 +4654,8 @@ namespace fluffy { namespace parser {
 	{
 		/*
 		auto namedTypeDecl = std::make_unique<ast::TypeDeclNamed>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 
 		// Consome '::'.
@@ -4768,14 +4734,14 @@ namespace fluffy { namespace parser {
 			// Consome ']'
 			m_lexer->expectToken(TokenType_e::RSquBracket);
 			return std::make_unique<ast::UnsizedArrayDecl>(
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
+				m_lexer->getTokenLocation().line,
+				m_lexer->getTokenLocation().column
 			);
 		}
 
 		auto sizedArrayDecl = std::make_unique<ast::SizedArrayDecl>(
-			m_lexer->getToken().line,
-			m_lexer->getToken().column
+			m_lexer->getTokenLocation().line,
+			m_lexer->getTokenLocation().column
 		);
 		
 		// TODO: Futuramente vai fazer o parse de uma expressao em tempode compilacao.
@@ -4793,11 +4759,332 @@ namespace fluffy { namespace parser {
 	{
 		if (id == String("_"))
 		{
-			throw exceptions::custom_exception(
-				"Invalid 'joker' identifier declaration",
-				m_lexer->getToken().line,
-				m_lexer->getToken().column
-			);
+			throwDiagnostic(diagnostics::DiagnosticCode_e::InvalidJokerIdentifier, {});
+		}
+	}
+
+	Bool
+	Parser::isGenericCall(ParserContext_s& ctx)
+	{
+		// Um nome fora da tabela so pode ser um tipo enquanto a tabela esta
+		// incompleta: na primeira fase ou com includes com coringa.
+		const Bool acceptUnknownName = ctx.typeNameScope == nullptr || !ctx.typeNameScope->isComplete();
+
+		// O token atual e o primeiro apos o '<'. Os tokens seguintes sao lidos
+		// antecipadamente pelo lexer e reaproveitados, nada e reprocessado.
+		U32 offset = 0;
+		while (true)
+		{
+			switch (m_lexer->predictToken(offset).type)
+			{
+			case TokenType_e::Bool:
+			case TokenType_e::I8:
+			case TokenType_e::U8:
+			case TokenType_e::I16:
+			case TokenType_e::U16:
+			case TokenType_e::I32:
+			case TokenType_e::U32:
+			case TokenType_e::I64:
+			case TokenType_e::U64:
+			case TokenType_e::Fp32:
+			case TokenType_e::Fp64:
+			case TokenType_e::String:
+			case TokenType_e::Object:
+				offset++;
+				break;
+			case TokenType_e::ScopeResolution:
+			case TokenType_e::Identifier:
+				{
+					if (m_lexer->predictToken(offset).type == TokenType_e::ScopeResolution)
+					{
+						offset++;
+					}
+
+					// Percorre o caminho ate o nome do tipo.
+					TString typeName;
+					while (true)
+					{
+						const Token_s& token = m_lexer->predictToken(offset);
+						if (token.type != TokenType_e::Identifier)
+						{
+							return false;
+						}
+						typeName = token.value;
+						offset++;
+
+						if (m_lexer->predictToken(offset).type != TokenType_e::ScopeResolution)
+						{
+							break;
+						}
+						offset++;
+					}
+
+					if (!acceptUnknownName && !ctx.typeNameScope->findTypeName(typeName))
+					{
+						return false;
+					}
+				}
+				break;
+			default:
+				return false;
+			}
+
+			// Apos cada tipo vem ',' ou '>' seguido de '('.
+			switch (m_lexer->predictToken(offset).type)
+			{
+			case TokenType_e::Comma:
+				offset++;
+				continue;
+			case TokenType_e::GreaterThan:
+				return m_lexer->predictToken(offset + 1).type == TokenType_e::LParBracket;
+			default:
+				return false;
+			}
+		}
+	}
+
+	void
+	Parser::insertTypeName(ParserContext_s& ctx, const TString& typeName)
+	{
+		if (ctx.typeNameScope != nullptr)
+		{
+			ctx.typeNameScope->insertTypeName(typeName);
+		}
+	}
+
+	TypeNameScope*
+	Parser::createTypeNameScope(ParserContext_s& ctx, ast::GenericDecl* const genericDecl)
+	{
+		if (genericDecl == nullptr)
+		{
+			return ctx.typeNameScope;
+		}
+
+		m_typeNameScopeList.push_back(std::make_unique<TypeNameScope>(ctx.typeNameScope));
+		TypeNameScope* const typeNameScope = m_typeNameScopeList.back().get();
+
+		for (auto& genericItemDecl : genericDecl->genericDeclItemList)
+		{
+			typeNameScope->insertTypeName(genericItemDecl->identifier);
+		}
+		return typeNameScope;
+	}
+
+	void
+	Parser::throwDiagnostic(diagnostics::DiagnosticCode_e code, U32 line, U32 column, std::initializer_list<TString> argList)
+	{
+		m_lexer->throwDiagnostic(code, line, column, argList);
+	}
+
+	void
+	Parser::throwDiagnostic(diagnostics::DiagnosticCode_e code, std::initializer_list<TString> argList)
+	{
+		m_lexer->throwDiagnostic(code, m_lexer->getToken().position, argList);
+	}
+
+	void
+	Parser::checkErrorLimit(ParserContext_s& ctx, const exceptions::diagnostic_exception& exception)
+	{
+		if (ctx.diagnosticEngine == nullptr || ctx.diagnosticEngine->isErrorLimitReached())
+		{
+			throw exception;
+		}
+	}
+
+	void
+	Parser::synchronize(U32 position, Bool insideNamespace)
+	{
+		// Descarta o primeiro token da declaracao, garantindo o avanco.
+		m_lexer->resetToPosition(position);
+		skipTokenSafely();
+
+		U32 depth = 0;
+		while (!m_lexer->isEof())
+		{
+			if (depth == 0)
+			{
+				if (m_lexer->isRightBracket())
+				{
+					// Fora de um namespace o '}' nao fecha nada e e descartado.
+					if (insideNamespace)
+					{
+						break;
+					}
+					skipTokenSafely();
+					continue;
+				}
+
+				if (insideNamespace ? isDeclarationStart() : (m_lexer->isNamespace() || m_lexer->isInclude()))
+				{
+					break;
+				}
+
+				if (m_lexer->isSemiColon())
+				{
+					skipTokenSafely();
+					break;
+				}
+			}
+
+			if (m_lexer->isLeftBracket())
+			{
+				depth++;
+			}
+			else if (m_lexer->isRightBracket())
+			{
+				depth--;
+			}
+			skipTokenSafely();
+		}
+	}
+
+	Bool
+	Parser::isDeclarationStart()
+	{
+		switch (m_lexer->getToken().type)
+		{
+		case TokenType_e::Namespace:
+		case TokenType_e::Export:
+		case TokenType_e::Abstract:
+		case TokenType_e::Class:
+		case TokenType_e::Interface:
+		case TokenType_e::Struct:
+		case TokenType_e::Trait:
+		case TokenType_e::Enum:
+		case TokenType_e::Fn:
+		case TokenType_e::Let:
+		case TokenType_e::Const:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	std::unique_ptr<ast::stmt::StmtDecl>
+	Parser::parseStmtDeclOrError(ParserContext_s& ctx)
+	{
+		if (ctx.diagnosticEngine == nullptr)
+		{
+			return parseStmtDecl(ctx);
+		}
+
+		const U32 position = m_lexer->getToken().position;
+		const ParserContext_s stmtCtx = ctx;
+
+		try
+		{
+			return parseStmtDecl(ctx);
+		}
+		catch (exceptions::diagnostic_exception& exception)
+		{
+			// Sem o '}' o bloco nao pode ser fechado, a declaracao trata o erro.
+			if (m_lexer->isEof())
+			{
+				throw;
+			}
+
+			checkErrorLimit(ctx, exception);
+			synchronizeStmt(position);
+
+			ctx = stmtCtx;
+
+			const lexer::SourceLocation_s location = m_lexer->getLocation(position);
+			auto stmtErrorDecl = std::make_unique<ast::stmt::StmtErrorDecl>(location.line, location.column);
+			stmtErrorDecl->beginPosition = position;
+			stmtErrorDecl->endPosition = m_lexer->getToken().position;
+			return stmtErrorDecl;
+		}
+	}
+
+	void
+	Parser::synchronizeStmt(U32 position)
+	{
+		// Descarta o primeiro token da instrucao, um '{' abre um bloco a ser saltado.
+		m_lexer->resetToPosition(position);
+
+		U32 depth = m_lexer->isLeftBracket() ? 1 : 0;
+		skipTokenSafely();
+
+		while (!m_lexer->isEof())
+		{
+			if (depth == 0)
+			{
+				// O '}' fecha o bloco da instrucao.
+				if (m_lexer->isRightBracket() || isStmtStart())
+				{
+					break;
+				}
+
+				if (m_lexer->isSemiColon())
+				{
+					skipTokenSafely();
+					break;
+				}
+			}
+
+			if (m_lexer->isLeftBracket())
+			{
+				depth++;
+			}
+			else if (m_lexer->isRightBracket())
+			{
+				depth--;
+			}
+			skipTokenSafely();
+		}
+	}
+
+	Bool
+	Parser::isStmtStart()
+	{
+		switch (m_lexer->getToken().type)
+		{
+		case TokenType_e::If:
+		case TokenType_e::For:
+		case TokenType_e::While:
+		case TokenType_e::Do:
+		case TokenType_e::Match:
+		case TokenType_e::Return:
+		case TokenType_e::Continue:
+		case TokenType_e::Break:
+		case TokenType_e::Goto:
+		case TokenType_e::Try:
+		case TokenType_e::Panic:
+		case TokenType_e::Let:
+		case TokenType_e::Const:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void
+	Parser::skipTokenSafely()
+	{
+		// Os tokens descartados na sincronizacao nao geram novos erros.
+		const DiagnosticEngineGuard diagnosticEngineGuard(m_lexer.get());
+
+		while (true)
+		{
+			try
+			{
+				m_lexer->nextToken();
+				return;
+			}
+			catch (std::exception&)
+			{
+				// Recomeca a leitura no caractere seguinte ao token invalido.
+				const Token_s& token = m_lexer->getToken();
+				try
+				{
+					m_lexer->resetToPosition(token.position + 1);
+					return;
+				}
+				catch (std::exception&)
+				{
+					// O caractere seguinte tambem e invalido.
+				}
+			}
 		}
 	}
 } }
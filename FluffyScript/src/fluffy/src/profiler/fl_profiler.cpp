@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+#include "profiler/fl_profiler.h"
+#include "utils/fl_info_util.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace profiler {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static String
+	escapeJson(const String& text)
+	{
+		String result;
+		result.reserve(text.size());
+
+		for (auto ch : text)
+		{
+			switch (ch)
+			{
+			case '"':	result += "\\\""; break;
+			case '\\':	result += "\\\\"; break;
+			case '\n':	result += "\\n"; break;
+			case '\t':	result += "\\t"; break;
+			default:
+				if (static_cast<U8>(ch) < 0x20)
+				{
+					I8 buffer[8];
+					std::snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+					result += buffer;
+				}
+				else
+				{
+					result += ch;
+				}
+				break;
+			}
+		}
+		return result;
+	}
+
+	static void
+	saveFile(const String& filename, const String& content)
+	{
+		std::ofstream fileStream(filename, std::ofstream::binary);
+		if (!fileStream.is_open())
+		{
+			throw exceptions::custom_exception("Can't open profiler output file '%s'", filename.c_str());
+		}
+		fileStream << content;
+	}
+
+	/**
+	 * Profiler
+	 */
+
+	std::atomic<Profiler*>
+	Profiler::sActiveProfiler(nullptr);
+
+	Profiler::Profiler()
+		: mStartTime(std::chrono::steady_clock::now())
+	{}
+
+	Profiler::~Profiler()
+	{
+		// Um profiler destruido nunca fica ativo.
+		Profiler* self = this;
+		sActiveProfiler.compare_exchange_strong(self, nullptr);
+	}
+
+	Profiler*
+	Profiler::getActive()
+	{
+		return sActiveProfiler.load(std::memory_order_acquire);
+	}
+
+	void
+	Profiler::setActive(Profiler* const profiler)
+	{
+		sActiveProfiler.store(profiler, std::memory_order_release);
+	}
+
+	String
+	Profiler::getTypeName(const std::type_info& typeInfo)
+	{
+		String name = typeInfo.name();
+
+#if defined(__GNUC__)
+		I32 status = 0;
+		if (I8* const demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status))
+		{
+			name = demangled;
+			std::free(demangled);
+		}
+#endif
+		// O MSVC prefixa o nome com 'class ' ou 'struct '.
+		const size_t separator = name.rfind("::");
+		if (separator != String::npos)
+		{
+			return name.substr(separator + 2);
+		}
+
+		const size_t space = name.rfind(' ');
+		return space != String::npos ? name.substr(space + 1) : name;
+	}
+
+	U64
+	Profiler::getTime()
+	{
+		return static_cast<U64>(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - mStartTime
+		).count());
+	}
+
+	void
+	Profiler::record(const I8* phase, const I8* codeUnit, U64 beginTime, U64 duration, U64 allocatedBytes, U64 nodeCount, Bool traceEvent)
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+
+		PhaseStats_s& stats = getStats(phase, codeUnit);
+		stats.callCount++;
+		stats.totalTime += duration;
+		stats.allocatedBytes += allocatedBytes;
+		stats.nodeCount += nodeCount;
+
+		if (traceEvent)
+		{
+			mTraceEventList.push_back({ phase, codeUnit, getThreadId(), beginTime, duration, allocatedBytes, nodeCount });
+		}
+	}
+
+	void
+	Profiler::addNodeCount(const I8* phase, const I8* codeUnit, U64 nodeCount)
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		getStats(phase, codeUnit).nodeCount += nodeCount;
+	}
+
+	std::vector<PhaseStats_s>
+	Profiler::getStatsList()
+	{
+		std::vector<PhaseStats_s> statsList;
+		{
+			std::lock_guard<std::mutex> guard(mMutex);
+			statsList = mStatsList;
+		}
+
+		std::stable_sort(statsList.begin(), statsList.end(), [](const PhaseStats_s& a, const PhaseStats_s& b) {
+			return a.totalTime > b.totalTime;
+		});
+		return statsList;
+	}
+
+	const PhaseStats_s*
+	Profiler::findStats(const String& phase, const String& codeUnit)
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+
+		auto it = mStatsMap.find(phase + '\0' + codeUnit);
+		return it != mStatsMap.end() ? &mStatsList[it->second] : nullptr;
+	}
+
+	const std::vector<TraceEvent_s>&
+	Profiler::getTraceEventList()
+	{
+		return mTraceEventList;
+	}
+
+	String
+	Profiler::toChromeTrace()
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+		std::stringstream stream;
+
+		stream << "{\"traceEvents\":[";
+
+		for (size_t i = 0; i < mTraceEventList.size(); i++)
+		{
+			const TraceEvent_s& event = mTraceEventList[i];
+
+			stream << (i ? ",\n" : "\n")
+				<< "{\"name\":\"" << escapeJson(event.phase) << "\""
+				<< ",\"cat\":\"compiler\",\"ph\":\"X\",\"pid\":1"
+				<< ",\"tid\":" << event.threadId
+				<< ",\"ts\":" << event.beginTime
+				<< ",\"dur\":" << event.duration
+				<< ",\"args\":{\"codeUnit\":\"" << escapeJson(event.codeUnit) << "\""
+				<< ",\"bytes\":" << event.allocatedBytes
+				<< ",\"nodes\":" << event.nodeCount << "}}";
+		}
+
+		stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		return stream.str();
+	}
+
+	String
+	Profiler::toSummary()
+	{
+		std::stringstream stream;
+		I8 line[512];
+
+		std::snprintf(line, sizeof(line), "%-32s %-24s %10s %12s %14s %10s\n", "phase", "code unit", "calls", "time (ms)", "bytes", "nodes");
+		stream << line;
+
+		PhaseStats_s total = { "total", "", 0, 0, 0, 0 };
+
+		for (auto& stats : getStatsList())
+		{
+			std::snprintf(line, sizeof(line), "%-32s %-24s %10llu %12.3f %14llu %10llu\n",
+				stats.phase.c_str(),
+				stats.codeUnit.c_str(),
+				stats.callCount,
+				stats.totalTime / 1000.0,
+				stats.allocatedBytes,
+				stats.nodeCount
+			);
+			stream << line;
+
+			// As buscas acontecem dentro dos processadores, somar o tempo contaria duas vezes.
+			if (stats.phase != findNodeByIdPhase && stats.phase != lexerPhase)
+			{
+				total.totalTime += stats.totalTime;
+				total.allocatedBytes += stats.allocatedBytes;
+			}
+			total.callCount += stats.callCount;
+		}
+
+		std::snprintf(line, sizeof(line), "%-32s %-24s %10llu %12.3f %14llu\n",
+			total.phase.c_str(),
+			"",
+			total.callCount,
+			total.totalTime / 1000.0,
+			total.allocatedBytes
+		);
+		stream << line;
+		return stream.str();
+	}
+
+	void
+	Profiler::saveChromeTrace(const String& filename)
+	{
+		saveFile(filename, toChromeTrace());
+	}
+
+	void
+	Profiler::saveSummary(const String& filename)
+	{
+		saveFile(filename, toSummary());
+	}
+
+	void
+	Profiler::clear()
+	{
+		std::lock_guard<std::mutex> guard(mMutex);
+
+		mStatsList.clear();
+		mStatsMap.clear();
+		mTraceEventList.clear();
+		mThreadMap.clear();
+		mStartTime = std::chrono::steady_clock::now();
+	}
+
+	PhaseStats_s&
+	Profiler::getStats(const I8* phase, const I8* codeUnit)
+	{
+		String key = phase;
+		key += '\0';
+		key += codeUnit;
+
+		auto it = mStatsMap.find(key);
+		if (it != mStatsMap.end())
+		{
+			return mStatsList[it->second];
+		}
+
+		mStatsMap.emplace(std::move(key), static_cast<U32>(mStatsList.size()));
+		mStatsList.push_back({ phase, codeUnit, 0, 0, 0, 0 });
+		return mStatsList.back();
+	}
+
+	U32
+	Profiler::getThreadId()
+	{
+		// Numera as threads na ordem em que aparecem, a principal e a 1.
+		auto result = mThreadMap.emplace(std::this_thread::get_id(), static_cast<U32>(mThreadMap.size() + 1));
+		return result.first->second;
+	}
+
+	/**
+	 * ProfilerGuard
+	 */
+
+	ProfilerGuard::ProfilerGuard(Profiler* const profiler)
+		: mPreviousProfiler(Profiler::getActive())
+		, mActive(profiler != nullptr)
+	{
+		if (mActive)
+		{
+			Profiler::setActive(profiler);
+		}
+	}
+
+	ProfilerGuard::~ProfilerGuard()
+	{
+		if (mActive)
+		{
+			Profiler::setActive(mPreviousProfiler);
+		}
+	}
+
+	/**
+	 * ProfileScope
+	 */
+
+	ProfileScope::ProfileScope(const I8* phase, const I8* codeUnit, Bool traceEvent)
+		: mProfiler(Profiler::getActive())
+		, mPhase(phase)
+		, mCodeUnit(codeUnit)
+		, mTraceEvent(traceEvent)
+		, mHasNodeCount(false)
+		, mBeginTime(0)
+		, mBeginBytes(0)
+		, mBeginNodeCount(0)
+		, mNodeCount(0)
+	{
+		if (mProfiler != nullptr)
+		{
+			mBeginBytes = Profiler::getThreadAllocatedBytes();
+			mBeginNodeCount = utils::InfoUtil::getThreadNodeCount();
+			mBeginTime = mProfiler->getTime();
+		}
+	}
+
+	ProfileScope::~ProfileScope()
+	{
+		if (mProfiler == nullptr)
+		{
+			return;
+		}
+
+		const U64 endTime = mProfiler->getTime();
+		const U64 allocatedBytes = Profiler::getThreadAllocatedBytes() - mBeginBytes;
+		const U64 nodeCount = mHasNodeCount
+			? mNodeCount
+			: utils::InfoUtil::getThreadNodeCount() - mBeginNodeCount;
+
+		mProfiler->record(mPhase, mCodeUnit, mBeginTime, endTime - mBeginTime, allocatedBytes, nodeCount, mTraceEvent);
+	}
+
+	void
+	ProfileScope::setNodeCount(U64 nodeCount)
+	{
+		mHasNodeCount = true;
+		mNodeCount = nodeCount;
+	}
+} }
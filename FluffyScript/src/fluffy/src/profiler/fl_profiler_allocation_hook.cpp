@@ -0,0 +1,234 @@
+#include <cstdlib>
+#include <new>
+#include "profiler/fl_profiler.h"
+
+#ifdef FL_PROFILER_ALLOCATION_HOOK
+// Os bytes alocados sao contados por thread substituindo o 'new' e o 'delete'
+// globais. A substituicao vale para o programa inteiro, por isso e opcional:
+// defina FL_PROFILER_ALLOCATION_HOOK apenas nos alvos de teste e benchmark.
+// Todas as formas sao substituidas, inclusive as de array, 'nothrow' e
+// alinhadas, para que cada ponteiro seja liberado pelo mesmo alocador. O
+// arquivo fica separado do profiler para que o compilador nao veja os
+// containers da biblioteca padrao liberando memoria por estas funcoes.
+static thread_local fluffy::U64
+g_threadAllocatedBytes = 0;
+
+static void*
+allocateCounted(std::size_t size, std::size_t alignment)
+{
+	g_threadAllocatedBytes += size;
+
+	if (size == 0)
+	{
+		size = 1;
+	}
+
+	while (true)
+	{
+		void* pointer = nullptr;
+
+		if (alignment == 0)
+		{
+			pointer = std::malloc(size);
+		}
+		else
+		{
+#if defined(_MSC_VER)
+			pointer = _aligned_malloc(size, alignment);
+#else
+			if (posix_memalign(&pointer, alignment, size) != 0)
+			{
+				pointer = nullptr;
+			}
+#endif
+		}
+
+		if (pointer != nullptr)
+		{
+			return pointer;
+		}
+
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+static void*
+allocateCountedNoThrow(std::size_t size, std::size_t alignment) noexcept
+{
+	try
+	{
+		return allocateCounted(size, alignment);
+	}
+	catch (std::bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+static void
+releaseCounted(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+static void
+releaseCountedAligned(void* pointer) noexcept
+{
+#if defined(_MSC_VER)
+	_aligned_free(pointer);
+#else
+	std::free(pointer);
+#endif
+}
+
+void*
+operator new(std::size_t size)
+{
+	return allocateCounted(size, 0);
+}
+
+void*
+operator new[](std::size_t size)
+{
+	return allocateCounted(size, 0);
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocateCountedNoThrow(size, 0);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocateCountedNoThrow(size, 0);
+}
+
+void*
+operator new(std::size_t size, std::align_val_t alignment)
+{
+	return allocateCounted(size, static_cast<std::size_t>(alignment));
+}
+
+void*
+operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return allocateCounted(size, static_cast<std::size_t>(alignment));
+}
+
+void*
+operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocateCountedNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void*
+operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocateCountedNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void
+operator delete(void* pointer) noexcept
+{
+	releaseCounted(pointer);
+}
+
+void
+operator delete[](void* pointer) noexcept
+{
+	releaseCounted(pointer);
+}
+
+void
+operator delete(void* pointer, std::size_t) noexcept
+{
+	releaseCounted(pointer);
+}
+
+void
+operator delete[](void* pointer, std::size_t) noexcept
+{
+	releaseCounted(pointer);
+}
+
+void
+operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	releaseCounted(pointer);
+}
+
+void
+operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	releaseCounted(pointer);
+}
+
+void
+operator delete(void* pointer, std::align_val_t) noexcept
+{
+	releaseCountedAligned(pointer);
+}
+
+void
+operator delete[](void* pointer, std::align_val_t) noexcept
+{
+	releaseCountedAligned(pointer);
+}
+
+void
+operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	releaseCountedAligned(pointer);
+}
+
+void
+operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	releaseCountedAligned(pointer);
+}
+
+void
+operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	releaseCountedAligned(pointer);
+}
+
+void
+operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	releaseCountedAligned(pointer);
+}
+#endif
+
+namespace fluffy { namespace profiler {
+	/**
+	 * Profiler
+	 */
+
+	Bool
+	Profiler::hasAllocationHook()
+	{
+#ifdef FL_PROFILER_ALLOCATION_HOOK
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	U64
+	Profiler::getThreadAllocatedBytes()
+	{
+#ifdef FL_PROFILER_ALLOCATION_HOOK
+		return g_threadAllocatedBytes;
+#else
+		return 0;
+#endif
+	}
+} }
@@ -0,0 +1,523 @@
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include "ast/fl_ast_decl.h"
+#include "attributes/fl_reference.h"
+#include "scope/fl_scope_manager.h"
+#include "query/fl_query_engine.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace query {
+	// Corpo das funcoes que sao entradas do engine.
+	static ast::AstNode*
+	getFunctionBody(ast::AstNode* const node)
+	{
+		switch (node->nodeType)
+		{
+		case AstNodeType_e::FunctionDecl:
+			return reinterpret_cast<ast::FunctionDecl*>(node)->blockDecl.get();
+		case AstNodeType_e::ClassFunctionDecl:
+			return reinterpret_cast<ast::ClassFunctionDecl*>(node)->blockDecl.get();
+		case AstNodeType_e::ClassConstructorDecl:
+			return reinterpret_cast<ast::ClassConstructorDecl*>(node)->blockDecl.get();
+		case AstNodeType_e::ClassDestructorDecl:
+			return reinterpret_cast<ast::ClassDestructorDecl*>(node)->blockDecl.get();
+		case AstNodeType_e::TraitFunctionDecl:
+			return reinterpret_cast<ast::TraitFunctionDecl*>(node)->blockDecl.get();
+		default:
+			return nullptr;
+		}
+	}
+
+	/**
+	 * DeclarationCollector
+	 */
+
+	// Coleta os nos do code unit fora dos corpos das funcoes e guarda os escopos
+	// ancestrais de cada funcao com corpo.
+	class DeclarationCollector final : public scope::NodeProcessor
+	{
+	public:
+		DeclarationCollector(ast::CodeUnit* const codeUnit, NodeList& nodeList, FunctionScopeMap& functionScopeMap, ClassUnitMap& classUnitMap)
+			: mCodeUnit(codeUnit)
+			, mNodeList(nodeList)
+			, mFunctionScopeMap(functionScopeMap)
+			, mClassUnitMap(classUnitMap)
+			, mBodyDepth(0)
+		{}
+
+		virtual void
+		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override
+		{
+			const Bool isBody = mBodySet.find(node) != mBodySet.end();
+
+			if (event == scope::NodeProcessorEvent_e::onEnd)
+			{
+				mBodyDepth -= isBody ? 1 : 0;
+				return;
+			}
+
+			if (isBody)
+			{
+				mBodyDepth++;
+				return;
+			}
+
+			if (mBodyDepth != 0)
+			{
+				return;
+			}
+			mNodeList.push_back(node);
+
+			if (node->nodeType == AstNodeType_e::ClassDecl)
+			{
+				mClassUnitMap[node] = mCodeUnit;
+			}
+
+			if (auto body = getFunctionBody(node))
+			{
+				NodeList scopeList = scopeManager->getScopeStack();
+				scopeList.push_back(node);
+
+				mFunctionScopeMap[node] = std::make_pair(mCodeUnit, scopeList);
+				mBodySet.insert(body);
+			}
+		}
+
+		// Os corpos nao parseados continuam ignorados.
+		virtual Bool
+		requireFunctionBody() override
+		{
+			return false;
+		}
+
+	private:
+		ast::CodeUnit*
+		mCodeUnit;
+
+		NodeList&
+		mNodeList;
+
+		FunctionScopeMap&
+		mFunctionScopeMap;
+
+		ClassUnitMap&
+		mClassUnitMap;
+
+		std::unordered_set<ast::AstNode*>
+		mBodySet;
+
+		U32
+		mBodyDepth;
+	};
+
+	/**
+	 * BodyCollector
+	 */
+
+	class BodyCollector final : public scope::NodeProcessor
+	{
+	public:
+		BodyCollector(NodeList& nodeList)
+			: mNodeList(nodeList)
+		{}
+
+		virtual void
+		onProcess(scope::ScopeManager* const, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override
+		{
+			if (event == scope::NodeProcessorEvent_e::onBegin)
+			{
+				mNodeList.push_back(node);
+			}
+		}
+
+	private:
+		NodeList&
+		mNodeList;
+	};
+
+	/**
+	 * QueryKey_s
+	 */
+
+	Bool
+	QueryKey_s::operator==(const QueryKey_s& other) const
+	{
+		return kind == other.kind && subject == other.subject && argument == other.argument;
+	}
+
+	size_t
+	QueryKeyHash::operator()(const QueryKey_s& key) const
+	{
+		size_t hash = std::hash<const ast::AstNode*>()(key.subject);
+		hash ^= std::hash<U64>()(key.argument) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+		return hash ^ static_cast<size_t>(key.kind);
+	}
+
+	/**
+	 * QueryEngine
+	 */
+
+	QueryEngine::QueryEngine()
+		: mScopeManager(new scope::ScopeManager())
+		, mRevision(0)
+		, mComputeCount(0)
+	{}
+
+	QueryEngine::~QueryEngine()
+	{}
+
+	void
+	QueryEngine::insertCodeUnit(ast::CodeUnit* const codeUnit)
+	{
+		mCodeUnitList.push_back(codeUnit);
+		mScopeManager->insertCodeUnit(codeUnit);
+
+		// A entrada nula representa a lista de code units.
+		bumpRevision(nullptr);
+		bumpRevision(codeUnit);
+	}
+
+	void
+	QueryEngine::removeCodeUnit(ast::CodeUnit* const codeUnit)
+	{
+		auto it = std::find(mCodeUnitList.begin(), mCodeUnitList.end(), codeUnit);
+		if (it == mCodeUnitList.end())
+		{
+			return;
+		}
+
+		invalidateDeclarations(codeUnit);
+		mCodeUnitList.erase(it);
+
+		for (auto classIt = mClassUnitMap.begin(); classIt != mClassUnitMap.end(); )
+		{
+			classIt = classIt->second == codeUnit ? mClassUnitMap.erase(classIt) : std::next(classIt);
+		}
+		mScopeManager->removeCodeUnit(codeUnit->identifier);
+		bumpRevision(nullptr);
+	}
+
+	void
+	QueryEngine::applyBodyProcessor(scope::NodeProcessor* const bodyProcessor)
+	{
+		mBodyProcessorList.emplace_back(bodyProcessor);
+	}
+
+	void
+	QueryEngine::updateFunctionBody(ast::AstNode* const functionDecl)
+	{
+		auto it = mFunctionScopeMap.find(functionDecl);
+		auto body = getFunctionBody(functionDecl);
+
+		if (it == mFunctionScopeMap.end() || body == nullptr)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' is not indexed by the query engine",
+				functionDecl->identifier.str()
+			);
+		}
+
+		for (auto& bodyProcessor : mBodyProcessorList)
+		{
+			mScopeManager->processSubtree(it->second.first, it->second.second, body, bodyProcessor.get());
+		}
+		bumpRevision(functionDecl);
+	}
+
+	void
+	QueryEngine::invalidateDeclarations(ast::CodeUnit* const codeUnit)
+	{
+		bumpRevision(codeUnit);
+
+		// As funcoes podem ter sido removidas, os corpos sao indexados novamente.
+		auto it = mFunctionScopeMap.begin();
+		while (it != mFunctionScopeMap.end())
+		{
+			if (it->second.first == codeUnit)
+			{
+				bumpRevision(it->first);
+				it = mFunctionScopeMap.erase(it);
+				continue;
+			}
+			it++;
+		}
+	}
+
+	ast::AstNode*
+	QueryEngine::findNodeAt(ast::CodeUnit* const codeUnit, U32 line, U32 column)
+	{
+		const QueryEntry_s& entry = query({ QueryKind_e::NodeAt, codeUnit, (static_cast<U64>(line) << 32) | column });
+		return entry.nodeList.empty() ? nullptr : entry.nodeList[0];
+	}
+
+	ast::AstNode*
+	QueryEngine::resolveTypeAt(ast::CodeUnit* const codeUnit, U32 line, U32 column)
+	{
+		const QueryEntry_s& entry = query({ QueryKind_e::ResolveType, codeUnit, (static_cast<U64>(line) << 32) | column });
+		return entry.nodeList.empty() ? nullptr : entry.nodeList[0];
+	}
+
+	NodeList
+	QueryEngine::findReferences(ast::AstNode* const declaration)
+	{
+		return query({ QueryKind_e::References, declaration, 0 }).nodeList;
+	}
+
+	NodeList
+	QueryEngine::listMembers(ast::ClassDecl* const classDecl)
+	{
+		return query({ QueryKind_e::Members, classDecl, 0 }).nodeList;
+	}
+
+	U64
+	QueryEngine::getComputeCount()
+	{
+		return mComputeCount;
+	}
+
+	const QueryEntry_s&
+	QueryEngine::query(const QueryKey_s& key)
+	{
+		static const QueryEntry_s emptyEntry;
+
+		auto it = mQueryMap.find(key);
+		if (it == mQueryMap.end() || !isValid(it->second))
+		{
+			// Uma consulta que depende de si mesma, como uma heranca ciclica, fica vazia.
+			if (std::find(mActiveQueryList.begin(), mActiveQueryList.end(), key) != mActiveQueryList.end())
+			{
+				return emptyEntry;
+			}
+
+			QueryEntry_s entry;
+
+			mActiveQueryList.push_back(key);
+			mDependencyStack.emplace_back();
+
+			compute(key, entry);
+
+			entry.dependencyList = std::move(mDependencyStack.back());
+			mDependencyStack.pop_back();
+			mActiveQueryList.pop_back();
+			mComputeCount++;
+
+			it = mQueryMap.insert_or_assign(key, std::move(entry)).first;
+		}
+
+		// A consulta atual depende de tudo que a consulta lida depende.
+		if (!mDependencyStack.empty())
+		{
+			auto& dependencyList = mDependencyStack.back();
+			dependencyList.insert(dependencyList.end(), it->second.dependencyList.begin(), it->second.dependencyList.end());
+		}
+		return it->second;
+	}
+
+	void
+	QueryEngine::compute(const QueryKey_s& key, QueryEntry_s& entry)
+	{
+		ast::AstNode* const subject = const_cast<ast::AstNode*>(key.subject);
+
+		switch (key.kind)
+		{
+		case QueryKind_e::InputIndex:
+			readInput(subject);
+			indexInput(subject, entry.nodeList);
+			break;
+
+		case QueryKind_e::NodeAt:
+			{
+				const U32 line = static_cast<U32>(key.argument >> 32);
+				const U32 column = static_cast<U32>(key.argument);
+				ast::AstNode* foundNode = nullptr;
+
+				// Os nos sao indexados em pre-ordem, o ultimo encontrado e o mais interno.
+				for (auto input : getInputList(ast::safe_cast<ast::CodeUnit>(subject)))
+				{
+					for (auto node : getInputNodeList(input))
+					{
+						const U32 length = node->identifier.str() != nullptr ? static_cast<U32>(std::strlen(node->identifier.str())) : 0;
+						if (node->line == line && column >= node->column && column < node->column + length)
+						{
+							foundNode = node;
+						}
+					}
+				}
+
+				if (foundNode != nullptr)
+				{
+					entry.nodeList.push_back(foundNode);
+				}
+			}
+			break;
+
+		case QueryKind_e::ResolveType:
+			{
+				const QueryEntry_s& nodeAt = query({ QueryKind_e::NodeAt, key.subject, key.argument });
+				if (!nodeAt.nodeList.empty())
+				{
+					if (auto reference = nodeAt.nodeList[0]->getAttribute<attributes::Reference>())
+					{
+						entry.nodeList.push_back(reference->get());
+					}
+				}
+			}
+			break;
+
+		case QueryKind_e::ReferencesIn:
+			{
+				const ast::AstNode* const declaration = reinterpret_cast<const ast::AstNode*>(key.argument);
+
+				for (auto node : getInputNodeList(subject))
+				{
+					auto reference = node->getAttribute<attributes::Reference>();
+					if (reference != nullptr && reference->get() == declaration)
+					{
+						entry.nodeList.push_back(node);
+					}
+				}
+			}
+			break;
+
+		case QueryKind_e::References:
+			readInput(nullptr);
+
+			// Cada entrada e consultada separadamente, alterar um corpo recalcula so a parte dele.
+			for (auto codeUnit : mCodeUnitList)
+			{
+				for (auto input : getInputList(codeUnit))
+				{
+					const NodeList& nodeList = query({ QueryKind_e::ReferencesIn, input, reinterpret_cast<U64>(subject) }).nodeList;
+					entry.nodeList.insert(entry.nodeList.end(), nodeList.begin(), nodeList.end());
+				}
+			}
+			break;
+
+		case QueryKind_e::Members:
+			{
+				auto classDecl = ast::safe_cast<ast::ClassDecl>(subject);
+
+				// Os membros fazem parte da camada de declaracoes do code unit da classe.
+				auto it = mClassUnitMap.find(classDecl);
+				if (it == mClassUnitMap.end())
+				{
+					for (auto codeUnit : mCodeUnitList)
+					{
+						getInputNodeList(codeUnit);
+					}
+					it = mClassUnitMap.find(classDecl);
+				}
+				readInput(it != mClassUnitMap.end() ? it->second : nullptr);
+
+				for (auto& constructorDecl : classDecl->constructorList)
+				{
+					entry.nodeList.push_back(constructorDecl.get());
+				}
+				for (auto& variableDecl : classDecl->variableList)
+				{
+					entry.nodeList.push_back(variableDecl.get());
+				}
+				for (auto& functionDecl : classDecl->functionList)
+				{
+					entry.nodeList.push_back(functionDecl.get());
+				}
+				if (classDecl->destructorDecl != nullptr)
+				{
+					entry.nodeList.push_back(classDecl->destructorDecl.get());
+				}
+
+				if (classDecl->baseClass != nullptr)
+				{
+					auto reference = classDecl->baseClass->getAttribute<attributes::Reference>();
+					if (reference != nullptr && reference->get()->nodeType == AstNodeType_e::ClassDecl)
+					{
+						const NodeList& nodeList = query({ QueryKind_e::Members, reference->get(), 0 }).nodeList;
+						entry.nodeList.insert(entry.nodeList.end(), nodeList.begin(), nodeList.end());
+					}
+				}
+			}
+			break;
+		}
+	}
+
+	Bool
+	QueryEngine::isValid(const QueryEntry_s& entry)
+	{
+		for (auto& dependency : entry.dependencyList)
+		{
+			if (getRevision(dependency.input) != dependency.revision)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void
+	QueryEngine::readInput(const ast::AstNode* const input)
+	{
+		if (!mDependencyStack.empty())
+		{
+			mDependencyStack.back().push_back({ input, getRevision(input) });
+		}
+	}
+
+	const NodeList&
+	QueryEngine::getInputNodeList(const ast::AstNode* const input)
+	{
+		return query({ QueryKind_e::InputIndex, input, 0 }).nodeList;
+	}
+
+	NodeList
+	QueryEngine::getInputList(ast::CodeUnit* const codeUnit)
+	{
+		NodeList inputList = { codeUnit };
+
+		for (auto node : getInputNodeList(codeUnit))
+		{
+			if (getFunctionBody(node) != nullptr)
+			{
+				inputList.push_back(node);
+			}
+		}
+		return inputList;
+	}
+
+	void
+	QueryEngine::indexInput(const ast::AstNode* const input, NodeList& nodeList)
+	{
+		ast::AstNode* const node = const_cast<ast::AstNode*>(input);
+
+		if (node->nodeType == AstNodeType_e::CodeUnit)
+		{
+			auto codeUnit = ast::safe_cast<ast::CodeUnit>(node);
+			DeclarationCollector collector(codeUnit, nodeList, mFunctionScopeMap, mClassUnitMap);
+
+			mScopeManager->processCodeUnit(codeUnit, &collector);
+			return;
+		}
+
+		auto it = mFunctionScopeMap.find(input);
+		if (it == mFunctionScopeMap.end())
+		{
+			return;
+		}
+
+		BodyCollector collector(nodeList);
+		mScopeManager->processSubtree(it->second.first, it->second.second, getFunctionBody(node), &collector);
+	}
+
+	U64
+	QueryEngine::getRevision(const ast::AstNode* const input)
+	{
+		auto it = mRevisionMap.find(input);
+		return it != mRevisionMap.end() ? it->second : 0;
+	}
+
+	void
+	QueryEngine::bumpRevision(const ast::AstNode* const input)
+	{
+		mRevisionMap[input] = ++mRevision;
+	}
+} }
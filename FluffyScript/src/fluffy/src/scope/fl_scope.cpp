@@ -1,8 +1,8 @@
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_decl.h"
-#include "scope\fl_scope.h"
-#include "scope\fl_scope_manager.h"
-#include "attributes\fl_included_scope.h"
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_decl.h"
+#include "scope/fl_scope.h"
+#include "scope/fl_scope_manager.h"
+#include "attributes/fl_included_scope.h"
 #include "fl_exceptions.h"
 
 namespace fluffy { namespace scope {
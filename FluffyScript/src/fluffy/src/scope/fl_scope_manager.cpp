@@ -1,8 +1,11 @@
+#include <algorithm>
 #include <functional>
-#include "ast\fl_ast_decl.h"
-#include "scope\fl_scope.h"
-#include "scope\fl_scope_manager.h"
-#include "utils\fl_scope_utils.h"
+#include "ast/fl_ast_decl.h"
+#include "scope/fl_scope.h"
+#include "scope/fl_scope_manager.h"
+#include "attributes/fl_deferred_function_body.h"
+#include "utils/fl_scope_utils.h"
+#include "profiler/fl_profiler.h"
 #include "fl_exceptions.h"
 namespace fluffy { namespace scope {
 	template <typename T>
@@ -54,14 +57,24 @@ namespace fluffy { namespace scope {
 		}
 	}
 
+	// Mensagem das excecoes lancadas quando nao ha motor de diagnosticos.
+	static String
+	formatErrorMessage(ast::CodeUnit* const codeUnit, diagnostics::DiagnosticCode_e code, std::initializer_list<TString> argList)
+	{
+		const diagnostics::Diagnostic_s diagnostic = diagnostics::DiagnosticEngine::makeDiagnostic(code, codeUnit->identifier, nullptr, 0, 0, argList);
+
+		return String(codeUnit->identifier.str()) + " error: " + diagnostics::DiagnosticEngine::formatMessage(diagnostic);
+	}
+
 	/**
 	 * ScopeManager
 	 */
 
 	ScopeManager::ScopeManager()
 		: mCodeUnit(nullptr)
+		, mDiagnosticEngine(nullptr)
 		, mInterruptFlag(false)
-		
+		, mVisitedNodeCount(0)
 	{}
 
 	ScopeManager::~ScopeManager()
@@ -73,6 +86,12 @@ namespace fluffy { namespace scope {
 		mReferenceTree.emplace(codeUnit->identifier, codeUnit);
 	}
 
+	void
+	ScopeManager::removeCodeUnit(const TString& identifier)
+	{
+		mReferenceTree.erase(identifier);
+	}
+
 	void
 	ScopeManager::copyReferenceTree(ScopeManager* const scopeManager)
 	{
@@ -85,10 +104,22 @@ namespace fluffy { namespace scope {
 	void
 	ScopeManager::processCodeUnit(ast::CodeUnit* const codeUnit, NodeProcessor* const nodeProcessor)
 	{
+		// Um processamento interrompido por erro pode deixar escopos na pilha.
+		mScopeStack.clear();
+
 		mCodeUnit = codeUnit;
 		processNode(codeUnit, nodeProcessor);
 	}
 
+	void
+	ScopeManager::processSubtree(ast::CodeUnit* const codeUnit, const NodeList& scopeList, ast::AstNode* const node, NodeProcessor* const nodeProcessor)
+	{
+		mScopeStack = scopeList;
+		mCodeUnit = codeUnit;
+		processNode(node, nodeProcessor);
+		mScopeStack.clear();
+	}
+
 	void
 	ScopeManager::setCodeUnit(ast::CodeUnit* const codeUnit)
 	{
@@ -105,6 +136,8 @@ namespace fluffy { namespace scope {
 	FindResult_t
 	ScopeManager::findNodeById(const TString& identifier, Bool findInRoot)
 	{
+		const profiler::ProfileScope profileScope(profiler::findNodeByIdPhase, mCodeUnit ? mCodeUnit->identifier.str() : "", false);
+
 		if (findInRoot)
 		{
 			return getRootScope().findNodeById(identifier);
@@ -131,6 +164,8 @@ namespace fluffy { namespace scope {
 	FindResult_t
 	ScopeManager::findNodeById(const TString& identifier, ast::AstNode* const ignoredNode, Bool findInRoot)
 	{
+		const profiler::ProfileScope profileScope(profiler::findNodeByIdPhase, mCodeUnit ? mCodeUnit->identifier.str() : "", false);
+
 		if (findInRoot)
 		{
 			return getRootScope().findNodeById(identifier);
@@ -159,6 +194,8 @@ namespace fluffy { namespace scope {
 	FindResult_t
 	ScopeManager::findNodeById(const TString& identifier, const AstNodeType_e ignoredType, Bool findInRoot)
 	{
+		const profiler::ProfileScope profileScope(profiler::findNodeByIdPhase, mCodeUnit ? mCodeUnit->identifier.str() : "", false);
+
 		if (findInRoot)
 		{
 			return getRootScope().findNodeById(identifier);
@@ -209,6 +246,44 @@ namespace fluffy { namespace scope {
 		return finalFindResult;
 	}
 
+	void
+	ScopeManager::setDiagnosticEngine(diagnostics::DiagnosticEngine* const diagnosticEngine)
+	{
+		mDiagnosticEngine = diagnosticEngine;
+	}
+
+	diagnostics::DiagnosticEngine*
+	ScopeManager::getDiagnosticEngine()
+	{
+		return mDiagnosticEngine;
+	}
+
+	void
+	ScopeManager::reportError(diagnostics::DiagnosticCode_e code, const ast::AstNode* const node, std::initializer_list<TString> argList)
+	{
+		if (mDiagnosticEngine != nullptr)
+		{
+			mDiagnosticEngine->report(code, mCodeUnit->identifier, node, argList);
+			return;
+		}
+
+		const String message = formatErrorMessage(mCodeUnit, code, argList);
+		throw exceptions::custom_exception("%s", node->line, node->column, message.c_str());
+	}
+
+	void
+	ScopeManager::reportError(diagnostics::DiagnosticCode_e code, std::initializer_list<TString> argList)
+	{
+		if (mDiagnosticEngine != nullptr)
+		{
+			mDiagnosticEngine->report(code, mCodeUnit->identifier, nullptr, 0, 0, argList);
+			return;
+		}
+
+		const String message = formatErrorMessage(mCodeUnit, code, argList);
+		throw exceptions::custom_exception("%s", message.c_str());
+	}
+
 	void
 	ScopeManager::interrupt()
 	{
@@ -250,6 +325,18 @@ namespace fluffy { namespace scope {
 		return mCodeUnit->identifier;
 	}
 
+	const NodeList&
+	ScopeManager::getScopeStack()
+	{
+		return mScopeStack;
+	}
+
+	U64
+	ScopeManager::getVisitedNodeCount()
+	{
+		return mVisitedNodeCount;
+	}
+
 	void
 	ScopeManager::processNode(ast::AstNode* const node, NodeProcessor* const nodeProcessor)
 	{
@@ -257,6 +344,13 @@ namespace fluffy { namespace scope {
 		{
 			return;
 		}
+		mVisitedNodeCount++;
+
+		// Corpos de funcoes ignorados pelo parser sao processados sob demanda.
+		if (nodeProcessor->requireFunctionBody())
+		{
+			parseFunctionBody(node);
+		}
 
 		// Faz a validao no nodo.
 		nodeProcessor->onProcess(this, NodeProcessorEvent_e::onBegin, node);
@@ -538,6 +632,12 @@ namespace fluffy { namespace scope {
 		case AstNodeType_e::Block:
 			if (auto n = reinterpret_cast<ast::BlockDecl*>(node))
 			{
+				// Corpo de funcao ainda nao processado pelo parser.
+				if (n->needParse)
+				{
+					break;
+				}
+
 				pushScope(n);
 
 				for_each_i(this, &ScopeManager::processNode, n->stmtList, nodeProcessor);
@@ -933,6 +1033,46 @@ namespace fluffy { namespace scope {
 		nodeProcessor->onProcess(this, NodeProcessorEvent_e::onEnd, node);
 	}
 
+	void
+	ScopeManager::parseFunctionBody(ast::AstNode* const node)
+	{
+		ast::BlockDecl* blockDecl = nullptr;
+
+		switch (node->nodeType)
+		{
+		case AstNodeType_e::FunctionDecl:
+			blockDecl = reinterpret_cast<ast::FunctionDecl*>(node)->blockDecl.get();
+			break;
+		case AstNodeType_e::ClassFunctionDecl:
+			blockDecl = reinterpret_cast<ast::ClassFunctionDecl*>(node)->blockDecl.get();
+			break;
+		case AstNodeType_e::TraitFunctionDecl:
+			blockDecl = reinterpret_cast<ast::TraitFunctionDecl*>(node)->blockDecl.get();
+			break;
+		default:
+			return;
+		}
+
+		if (blockDecl == nullptr || !blockDecl->needParse)
+		{
+			return;
+		}
+
+		if (auto deferredFunctionBody = mCodeUnit->getAttribute<attributes::DeferredFunctionBody>())
+		{
+			deferredFunctionBody->parseFunctionBody(blockDecl);
+		}
+		else
+		{
+			throw exceptions::custom_exception(
+				"%s error: Failed to retrieve the deferred body of '%s'",
+				node->line, node->column,
+				getCodeUnitName().str(),
+				node->identifier.str()
+			);
+		}
+	}
+
 	void
 	ScopeManager::pushScope(ast::AstNode* const node)
 	{
@@ -0,0 +1,214 @@
+#include <cerrno>
+#include <chrono>
+#include <sstream>
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include "server/fl_compiler_server.h"
+#include "utils/fl_build_result_utils.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace server {
+	// Tamanho do buffer de leitura das conexoes.
+	static constexpr const U32 bufferSize = 4096;
+
+#ifndef _WIN32
+	// Um cliente que fecha a conexao antes de ler a resposta nao pode gerar
+	// SIGPIPE, o sinal encerraria o servidor. No macOS o SO_NOSIGPIPE e
+	// aplicado no socket de cada conexao.
+#ifdef MSG_NOSIGNAL
+	static constexpr const int sendFlags = MSG_NOSIGNAL;
+#else
+	static constexpr const int sendFlags = 0;
+#endif
+#endif
+
+	/**
+	 * CompilerServer
+	 */
+
+	CompilerServer::CompilerServer(std::unique_ptr<Compiler> compiler)
+		: mCompiler(std::move(compiler))
+		, mRunning(true)
+		, mRequestCount(0)
+		, mBuiltFileCount(0)
+		, mCachedFileCount(0)
+	{}
+
+	CompilerServer::~CompilerServer()
+	{}
+
+	String
+	CompilerServer::handleRequest(const String& request)
+	{
+		std::stringstream requestStream(request);
+		std::stringstream responseStream;
+		String command;
+
+		requestStream >> command;
+		mRequestCount++;
+
+		if (command == "check")
+		{
+			std::vector<String> sourceFileList;
+			String sourceFile;
+
+			while (requestStream >> sourceFile)
+			{
+				sourceFileList.push_back(sourceFile);
+			}
+
+			if (sourceFileList.empty())
+			{
+				return "{\"error\":\"Expected at least one file\"}";
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			auto resultList = mCompiler->buildBatch(sourceFileList);
+			const U64 totalTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+			Bool success = true;
+			for (auto& result : resultList)
+			{
+				success &= result.success;
+				(result.cached ? mCachedFileCount : mBuiltFileCount)++;
+			}
+
+			responseStream << "{\"success\":" << (success ? "true" : "false")
+				<< ",\"totalTime\":" << totalTime
+				<< ",\"files\":" << utils::BuildResultUtils::toJson(resultList) << "}";
+		}
+		else if (command == "stats")
+		{
+			responseStream << "{\"requests\":" << mRequestCount
+				<< ",\"builtFiles\":" << mBuiltFileCount
+				<< ",\"cachedFiles\":" << mCachedFileCount << "}";
+		}
+		else if (command == "shutdown")
+		{
+			mRunning = false;
+			responseStream << "{\"success\":true}";
+		}
+		else
+		{
+			responseStream << "{\"error\":\"Unknown request '" << utils::BuildResultUtils::escapeJson(command) << "'\"}";
+		}
+		return responseStream.str();
+	}
+
+	void
+	CompilerServer::listen(const String& socketPath)
+	{
+#ifdef _WIN32
+		throw exceptions::not_implemented_feature_exception(socketPath, "compiler server");
+#else
+		sockaddr_un address = {};
+		address.sun_family = AF_UNIX;
+
+		if (socketPath.size() >= sizeof(address.sun_path))
+		{
+			throw exceptions::custom_exception("Socket path too long: '%s'", socketPath.c_str());
+		}
+		socketPath.copy(address.sun_path, socketPath.size());
+
+		const int serverSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (serverSocket < 0)
+		{
+			throw exceptions::custom_exception("Failed to create socket '%s'", socketPath.c_str());
+		}
+
+		// Remove o socket de uma execucao anterior.
+		unlink(socketPath.c_str());
+
+		if (bind(serverSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(serverSocket, 8) < 0)
+		{
+			close(serverSocket);
+			throw exceptions::custom_exception("Failed to listen on socket '%s'", socketPath.c_str());
+		}
+
+		while (mRunning)
+		{
+			const int clientSocket = accept(serverSocket, nullptr, nullptr);
+			if (clientSocket < 0)
+			{
+				continue;
+			}
+#ifdef SO_NOSIGPIPE
+			const int noSignal = 1;
+			setsockopt(clientSocket, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+#endif
+
+			// As requisicoes sao atendidas em ordem, o compilador nao e compartilhado entre threads.
+			String pendent;
+			I8 buffer[bufferSize];
+			Bool connected = true;
+
+			while (mRunning && connected)
+			{
+				const ssize_t readCount = read(clientSocket, buffer, bufferSize);
+				if (readCount <= 0)
+				{
+					break;
+				}
+				pendent.append(buffer, readCount);
+
+				size_t lineEnd;
+				while (mRunning && connected && (lineEnd = pendent.find('\n')) != String::npos)
+				{
+					const String request = pendent.substr(0, lineEnd);
+					pendent.erase(0, lineEnd + 1);
+
+					String response;
+					try
+					{
+						response = handleRequest(request) + "\n";
+					}
+					catch (std::exception& e)
+					{
+						response = "{\"error\":\"" + utils::BuildResultUtils::escapeJson(e.what()) + "\"}\n";
+					}
+
+					// Se o cliente desconectou (EPIPE/ECONNRESET) a conexao e descartada.
+					connected = sendResponse(clientSocket, response);
+				}
+			}
+			close(clientSocket);
+		}
+
+		close(serverSocket);
+		unlink(socketPath.c_str());
+#endif
+	}
+
+	Bool
+	CompilerServer::sendResponse(int clientSocket, const String& response)
+	{
+#ifdef _WIN32
+		return false;
+#else
+		for (size_t written = 0; written < response.size(); )
+		{
+			const ssize_t writeCount = send(clientSocket, response.c_str() + written, response.size() - written, sendFlags);
+			if (writeCount < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (writeCount <= 0)
+			{
+				return false;
+			}
+			written += writeCount;
+		}
+		return true;
+#endif
+	}
+
+	Bool
+	CompilerServer::isRunning()
+	{
+		return mRunning;
+	}
+} }
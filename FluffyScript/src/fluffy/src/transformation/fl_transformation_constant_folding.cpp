@@ -0,0 +1,1119 @@
+#include <limits>
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_pattern.h"
+#include "ast/fl_ast_type.h"
+#include "codegen/fl_bytecode.h"
+#include "scope/fl_scope.h"
+#include "transformation/fl_transformation_constant_folding.h"
+namespace fluffy { namespace transformations {
+	using codegen::OpCode_e;
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static Bool
+	isConstantExpr(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::ConstantBoolExpr:
+		case AstNodeType_e::ConstantIntegerExpr:
+		case AstNodeType_e::ConstantRealExpr:
+		case AstNodeType_e::ConstantCharExpr:
+		case AstNodeType_e::ConstantNullExpr:
+		case AstNodeType_e::ConstantStringExpr:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// Valor da constante como a maquina virtual o representa, strings nao sao convertidas.
+	static Bool
+	toValue(ast::expr::ExpressionDecl* const exprDecl, vm::Value_s& value)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::ConstantBoolExpr:
+			value = vm::makeBool(exprDecl->to<ast::expr::ExpressionConstantBoolDecl>()->valueDecl);
+			return true;
+		case AstNodeType_e::ConstantIntegerExpr:
+			{
+				auto integerDecl = exprDecl->to<ast::expr::ExpressionConstantIntegerDecl>();
+				value = vm::makeInteger(vm::toValueType(integerDecl->valueType), integerDecl->valueDecl);
+			}
+			return vm::isInteger(value.type);
+		case AstNodeType_e::ConstantRealExpr:
+			{
+				auto realDecl = exprDecl->to<ast::expr::ExpressionConstantRealDecl>();
+				value = vm::makeReal(vm::toValueType(realDecl->valueType), realDecl->valueDecl);
+			}
+			return vm::isReal(value.type);
+		case AstNodeType_e::ConstantCharExpr:
+			value = vm::makeInteger(vm::ValueType_e::I8, exprDecl->to<ast::expr::ExpressionConstantCharDecl>()->valueDecl);
+			return true;
+		case AstNodeType_e::ConstantNullExpr:
+			value = vm::makeNull();
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static PrimitiveTypeID_e
+	toPrimitiveType(vm::ValueType_e type)
+	{
+		switch (type)
+		{
+		case vm::ValueType_e::Bool:		return PrimitiveTypeID_e::Bool;
+		case vm::ValueType_e::I8:		return PrimitiveTypeID_e::I8;
+		case vm::ValueType_e::U8:		return PrimitiveTypeID_e::U8;
+		case vm::ValueType_e::I16:		return PrimitiveTypeID_e::I16;
+		case vm::ValueType_e::U16:		return PrimitiveTypeID_e::U16;
+		case vm::ValueType_e::I32:		return PrimitiveTypeID_e::I32;
+		case vm::ValueType_e::U32:		return PrimitiveTypeID_e::U32;
+		case vm::ValueType_e::I64:		return PrimitiveTypeID_e::I64;
+		case vm::ValueType_e::U64:		return PrimitiveTypeID_e::U64;
+		case vm::ValueType_e::Fp32:		return PrimitiveTypeID_e::Fp32;
+		case vm::ValueType_e::Fp64:		return PrimitiveTypeID_e::Fp64;
+		case vm::ValueType_e::String:	return PrimitiveTypeID_e::String;
+		default:						return PrimitiveTypeID_e::Unknown;
+		}
+	}
+
+	static PrimitiveTypeID_e
+	getConstantType(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		if (exprDecl->nodeType == AstNodeType_e::ConstantStringExpr)
+		{
+			return PrimitiveTypeID_e::String;
+		}
+
+		vm::Value_s value;
+		return toValue(exprDecl, value)
+			? toPrimitiveType(value.type)
+			: PrimitiveTypeID_e::Unknown;
+	}
+
+	static String
+	toText(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		if (exprDecl->nodeType == AstNodeType_e::ConstantStringExpr)
+		{
+			return exprDecl->to<ast::expr::ExpressionConstantStringDecl>()->valueDecl;
+		}
+
+		vm::Value_s value;
+		toValue(exprDecl, value);
+		return vm::formatValue(value);
+	}
+
+	template <typename TDecl>
+	static std::unique_ptr<TDecl>
+	makeDecl(ast::expr::ExpressionDecl* const origin)
+	{
+		auto decl = std::make_unique<TDecl>(origin->line, origin->column);
+		decl->beginPosition = origin->beginPosition;
+		decl->endPosition = origin->endPosition;
+		return decl;
+	}
+
+	static ExpressionDeclPtr
+	makeString(const String& text, ast::expr::ExpressionDecl* const origin)
+	{
+		auto stringDecl = makeDecl<ast::expr::ExpressionConstantStringDecl>(origin);
+		stringDecl->valueDecl = text;
+		return stringDecl;
+	}
+
+	static ExpressionDeclPtr
+	cloneConstant(ast::expr::ExpressionDecl* const constantDecl, ast::expr::ExpressionDecl* const origin)
+	{
+		switch (constantDecl->nodeType)
+		{
+		case AstNodeType_e::ConstantBoolExpr:
+			{
+				auto boolDecl = makeDecl<ast::expr::ExpressionConstantBoolDecl>(origin);
+				boolDecl->valueDecl = constantDecl->to<ast::expr::ExpressionConstantBoolDecl>()->valueDecl;
+				return boolDecl;
+			}
+		case AstNodeType_e::ConstantIntegerExpr:
+			{
+				auto integerDecl = makeDecl<ast::expr::ExpressionConstantIntegerDecl>(origin);
+				integerDecl->valueDecl = constantDecl->to<ast::expr::ExpressionConstantIntegerDecl>()->valueDecl;
+				integerDecl->valueType = constantDecl->to<ast::expr::ExpressionConstantIntegerDecl>()->valueType;
+				return integerDecl;
+			}
+		case AstNodeType_e::ConstantRealExpr:
+			{
+				auto realDecl = makeDecl<ast::expr::ExpressionConstantRealDecl>(origin);
+				realDecl->valueDecl = constantDecl->to<ast::expr::ExpressionConstantRealDecl>()->valueDecl;
+				realDecl->valueType = constantDecl->to<ast::expr::ExpressionConstantRealDecl>()->valueType;
+				return realDecl;
+			}
+		case AstNodeType_e::ConstantCharExpr:
+			{
+				auto charDecl = makeDecl<ast::expr::ExpressionConstantCharDecl>(origin);
+				charDecl->valueDecl = constantDecl->to<ast::expr::ExpressionConstantCharDecl>()->valueDecl;
+				return charDecl;
+			}
+		case AstNodeType_e::ConstantStringExpr:
+			return makeString(constantDecl->to<ast::expr::ExpressionConstantStringDecl>()->valueDecl, origin);
+		default:
+			return makeDecl<ast::expr::ExpressionConstantNullDecl>(origin);
+		}
+	}
+
+	// Verifica se o resultado truncado de uma soma, subtracao ou multiplicacao
+	// inteira difere do resultado exato.
+	static Bool
+	hasOverflow(OpCode_e op, const vm::Value_s& lhs, const vm::Value_s& rhs, const vm::Value_s& result)
+	{
+		if (!vm::isInteger(lhs.type) || !vm::isInteger(rhs.type) || !vm::isInteger(result.type))
+		{
+			return false;
+		}
+
+		if (result.type == vm::ValueType_e::U64)
+		{
+			const U64 a = static_cast<U64>(lhs.integerValue);
+			const U64 b = static_cast<U64>(rhs.integerValue);
+			const U64 r = static_cast<U64>(result.integerValue);
+
+			switch (op)
+			{
+			case OpCode_e::Add:		return r < a;
+			case OpCode_e::Sub:		return a < b;
+			case OpCode_e::Mul:		return a != 0 && r / a != b;
+			default:				return false;
+			}
+		}
+
+		constexpr I64 maxValue = std::numeric_limits<I64>::max();
+		constexpr I64 minValue = std::numeric_limits<I64>::min();
+
+		const I64 a = lhs.integerValue;
+		const I64 b = rhs.integerValue;
+		I64 exact = 0;
+
+		switch (op)
+		{
+		case OpCode_e::Add:
+			if ((b > 0 && a > maxValue - b) || (b < 0 && a < minValue - b))
+			{
+				return true;
+			}
+			exact = a + b;
+			break;
+		case OpCode_e::Sub:
+			if ((b < 0 && a > maxValue + b) || (b > 0 && a < minValue + b))
+			{
+				return true;
+			}
+			exact = a - b;
+			break;
+		case OpCode_e::Mul:
+			if (a > 0 ? (b > 0 ? a > maxValue / b : b < minValue / a)
+				: (b > 0 ? a < minValue / b : (a != 0 && b < maxValue / a)))
+			{
+				return true;
+			}
+			exact = a * b;
+			break;
+		default:
+			return false;
+		}
+		return exact != result.integerValue;
+	}
+
+	/**
+	 * ConstantFolding
+	 */
+
+	ConstantFolding::ConstantFolding()
+		: mScopeManager(nullptr)
+		, mLiteralOnly(false)
+		, mFoldedCount(0)
+	{}
+
+	ConstantFolding::~ConstantFolding()
+	{}
+
+	void
+	ConstantFolding::onProcess(scope::ScopeManager* const scopeManager, scope::NodeProcessorEvent_e event, ast::AstNode* const node)
+	{
+		if (event != scope::NodeProcessorEvent_e::onBegin)
+		{
+			return;
+		}
+		mScopeManager = scopeManager;
+
+		// Os corpos sao percorridos a partir da declaracao, antes que o
+		// gerenciador de escopo empilhe a funcao.
+		switch (node->nodeType)
+		{
+		case AstNodeType_e::FunctionDecl:
+			{
+				auto functionDecl = node->to<ast::FunctionDecl>();
+				foldFunction(functionDecl->parameterList, functionDecl->blockDecl.get(), functionDecl->exprDecl);
+			}
+			break;
+		case AstNodeType_e::ClassFunctionDecl:
+			{
+				auto classFunctionDecl = node->to<ast::ClassFunctionDecl>();
+				foldFunction(classFunctionDecl->parameterList, classFunctionDecl->blockDecl.get(), classFunctionDecl->exprDecl);
+			}
+			break;
+		case AstNodeType_e::TraitFunctionDecl:
+			{
+				auto traitFunctionDecl = node->to<ast::TraitFunctionDecl>();
+				foldFunction(traitFunctionDecl->parameterList, traitFunctionDecl->blockDecl.get(), traitFunctionDecl->exprDecl);
+			}
+			break;
+		case AstNodeType_e::ClassConstructorDecl:
+			{
+				auto constructorDecl = node->to<ast::ClassConstructorDecl>();
+
+				for (auto& parameterDecl : constructorDecl->parameterList)
+				{
+					parameterDecl->patternDecl ? declarePattern(parameterDecl->patternDecl.get()) : declareLocal(parameterDecl.get());
+				}
+
+				foldExpr(constructorDecl->superInitExpr);
+				for (auto& variableInitDecl : constructorDecl->variableInitDeclList)
+				{
+					foldExpr(variableInitDecl->initExpr);
+				}
+
+				if (constructorDecl->blockDecl)
+				{
+					foldBlock(constructorDecl->blockDecl.get());
+				}
+				mLocalList.clear();
+			}
+			break;
+		case AstNodeType_e::ClassDestructorDecl:
+			if (auto blockDecl = node->to<ast::ClassDestructorDecl>()->blockDecl.get())
+			{
+				foldBlock(blockDecl);
+			}
+			break;
+		case AstNodeType_e::VariableDecl:
+			foldExpr(node->to<ast::VariableDecl>()->initExpr);
+			break;
+		case AstNodeType_e::ClassVariableDecl:
+			foldExpr(node->to<ast::ClassVariableDecl>()->initExpr);
+			break;
+		case AstNodeType_e::StructVariableDecl:
+			foldExpr(node->to<ast::StructVariableDecl>()->initExpr);
+			break;
+		default:
+			break;
+		}
+	}
+
+	const std::vector<ConstantWarning_s>&
+	ConstantFolding::getWarningList()
+	{
+		return mWarningList;
+	}
+
+	U32
+	ConstantFolding::getFoldedCount()
+	{
+		return mFoldedCount;
+	}
+
+	void
+	ConstantFolding::foldFunction(FunctionParameterDeclPtrList& parameterList, ast::BlockDecl* const blockDecl, ExpressionDeclPtr& exprDecl)
+	{
+		for (auto& parameterDecl : parameterList)
+		{
+			parameterDecl->patternDecl ? declarePattern(parameterDecl->patternDecl.get()) : declareLocal(parameterDecl.get());
+		}
+
+		if (blockDecl)
+		{
+			foldBlock(blockDecl);
+		}
+		foldExpr(exprDecl);
+
+		mLocalList.clear();
+	}
+
+	void
+	ConstantFolding::foldBlock(ast::BlockDecl* const blockDecl)
+	{
+		const size_t mark = mLocalList.size();
+
+		for (auto& stmtDecl : blockDecl->stmtList)
+		{
+			foldStmt(stmtDecl.get());
+		}
+		mLocalList.resize(mark);
+	}
+
+	void
+	ConstantFolding::foldStmt(ast::stmt::StmtDecl* const stmtDecl)
+	{
+		switch (stmtDecl->nodeType)
+		{
+		case AstNodeType_e::StmtExpr:
+			foldExpr(stmtDecl->to<ast::stmt::StmtExprDecl>()->exprDecl);
+			break;
+		case AstNodeType_e::StmtVariable:
+			{
+				auto variableDecl = stmtDecl->to<ast::stmt::StmtVariableDecl>();
+
+				foldExpr(variableDecl->initExpr);
+				variableDecl->patternDecl ? declarePattern(variableDecl->patternDecl.get()) : declareLocal(variableDecl);
+			}
+			break;
+		case AstNodeType_e::StmtIf:
+			{
+				auto ifDecl = stmtDecl->to<ast::stmt::StmtIfDecl>();
+
+				foldExpr(ifDecl->conditionExprDecl);
+				foldBlock(ifDecl->ifBlockDecl.get());
+				if (ifDecl->elseBlockDecl)
+				{
+					foldBlock(ifDecl->elseBlockDecl.get());
+				}
+			}
+			break;
+		case AstNodeType_e::StmtIfLet:
+			{
+				auto ifLetDecl = stmtDecl->to<ast::stmt::StmtIfLetDecl>();
+				const size_t mark = mLocalList.size();
+
+				foldExpr(ifLetDecl->expressionDecl);
+
+				declarePattern(ifLetDecl->patternDecl.get());
+				foldBlock(ifLetDecl->ifBlockDecl.get());
+				mLocalList.resize(mark);
+
+				if (ifLetDecl->elseBlockDecl)
+				{
+					foldBlock(ifLetDecl->elseBlockDecl.get());
+				}
+			}
+			break;
+		case AstNodeType_e::StmtFor:
+			{
+				auto forDecl = stmtDecl->to<ast::stmt::StmtForDecl>();
+				const size_t mark = mLocalList.size();
+
+				if (forDecl->initStmtDecl)
+				{
+					foldExpr(forDecl->initStmtDecl->initExpr);
+					declareLocal(forDecl->initStmtDecl.get());
+				}
+				foldExpr(forDecl->initExprDecl);
+				foldExpr(forDecl->conditionExprDecl);
+				foldExpr(forDecl->updateExprDecl);
+				foldBlock(forDecl->blockDecl.get());
+
+				mLocalList.resize(mark);
+			}
+			break;
+		case AstNodeType_e::StmtWhile:
+			{
+				auto whileDecl = stmtDecl->to<ast::stmt::StmtWhileDecl>();
+
+				foldExpr(whileDecl->conditionExprDecl);
+				foldBlock(whileDecl->blockDecl.get());
+			}
+			break;
+		case AstNodeType_e::StmtDoWhile:
+			{
+				auto doWhileDecl = stmtDecl->to<ast::stmt::StmtDoWhileDecl>();
+
+				foldBlock(doWhileDecl->blockDecl.get());
+				foldExpr(doWhileDecl->conditionExprDecl);
+			}
+			break;
+		case AstNodeType_e::StmtMatch:
+			{
+				auto matchDecl = stmtDecl->to<ast::stmt::StmtMatchDecl>();
+
+				foldExpr(matchDecl->conditionExprDecl);
+				for (auto& whenDecl : matchDecl->whenDeclList)
+				{
+					const size_t mark = mLocalList.size();
+
+					declarePattern(whenDecl->patternDecl.get());
+					foldBlock(whenDecl->blockDecl.get());
+
+					mLocalList.resize(mark);
+				}
+			}
+			break;
+		case AstNodeType_e::StmtReturn:
+			foldExpr(stmtDecl->to<ast::stmt::StmtReturnDecl>()->exprDecl);
+			break;
+		case AstNodeType_e::StmtPanic:
+			foldExpr(stmtDecl->to<ast::stmt::StmtPanicDecl>()->exprDecl);
+			break;
+		case AstNodeType_e::StmtTry:
+			{
+				auto tryDecl = stmtDecl->to<ast::stmt::StmtTryDecl>();
+
+				foldBlock(tryDecl->blockDecl.get());
+				for (auto& catchDecl : tryDecl->catchDeclList)
+				{
+					const size_t mark = mLocalList.size();
+
+					catchDecl->patternDecl ? declarePattern(catchDecl->patternDecl.get()) : declareLocal(catchDecl.get());
+					foldBlock(catchDecl->blockDecl.get());
+
+					mLocalList.resize(mark);
+				}
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void
+	ConstantFolding::foldExpr(ExpressionDeclPtr& exprDecl)
+	{
+		if (exprDecl == nullptr)
+		{
+			return;
+		}
+
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::IdentifierExpr:
+			propagateConstant(exprDecl);
+			break;
+		case AstNodeType_e::UnaryExpr:
+			{
+				auto unaryDecl = exprDecl->to<ast::expr::ExpressionUnaryDecl>();
+
+				if (unaryDecl->op == TokenType_e::Increment || unaryDecl->op == TokenType_e::Decrement)
+				{
+					foldAssignTarget(unaryDecl->exprDecl);
+					break;
+				}
+				foldExpr(unaryDecl->exprDecl);
+				foldUnary(exprDecl);
+			}
+			break;
+		case AstNodeType_e::BinaryExpr:
+			{
+				auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+				switch (binaryDecl->op)
+				{
+				case TokenType_e::ScopeResolution:
+					propagateConstant(exprDecl);
+					break;
+				case TokenType_e::Dot:
+				case TokenType_e::SafeDot:
+					foldExpr(binaryDecl->leftDecl);
+					break;
+				default:
+					if (binaryDecl->op == TokenType_e::Assign || codegen::isCompoundAssign(binaryDecl->op))
+					{
+						foldAssignTarget(binaryDecl->leftDecl);
+						foldExpr(binaryDecl->rightDecl);
+						break;
+					}
+					foldExpr(binaryDecl->leftDecl);
+					foldExpr(binaryDecl->rightDecl);
+					foldBinary(exprDecl);
+					break;
+				}
+			}
+			break;
+		case AstNodeType_e::TernaryExpr:
+			{
+				auto ternaryDecl = exprDecl->to<ast::expr::ExpressionTernaryDecl>();
+
+				foldExpr(ternaryDecl->conditionDecl);
+				foldExpr(ternaryDecl->leftDecl);
+				foldExpr(ternaryDecl->rightDecl);
+				foldTernary(exprDecl);
+			}
+			break;
+		case AstNodeType_e::AsExpr:
+			foldExpr(exprDecl->to<ast::expr::ExpressionAsDecl>()->exprDecl);
+			foldAs(exprDecl);
+			break;
+		case AstNodeType_e::IsExpr:
+			foldExpr(exprDecl->to<ast::expr::ExpressionIsDecl>()->exprDecl);
+			break;
+		case AstNodeType_e::FunctionCallExpr:
+			{
+				auto callDecl = exprDecl->to<ast::expr::ExpressionFunctionCall>();
+
+				foldExpr(callDecl->lhsDecl);
+				foldExpr(callDecl->rhsDecl);
+			}
+			break;
+		case AstNodeType_e::GenericCallExpr:
+			{
+				auto genericCallDecl = exprDecl->to<ast::expr::ExpressionGenericCallDecl>();
+
+				foldExpr(genericCallDecl->lhsDecl);
+				foldExpr(genericCallDecl->rhsDecl);
+			}
+			break;
+		case AstNodeType_e::IndexExpr:
+			{
+				auto indexDecl = exprDecl->to<ast::expr::ExpressionIndexDecl>();
+
+				foldExpr(indexDecl->lhsDecl);
+				foldExpr(indexDecl->rhsDecl);
+			}
+			break;
+		case AstNodeType_e::ArrayInitExpr:
+			for (auto& elementDecl : exprDecl->to<ast::expr::ExpressionArrayInitDecl>()->arrayElementDeclList)
+			{
+				foldExpr(elementDecl);
+			}
+			break;
+		case AstNodeType_e::NewExpr:
+			{
+				auto newDecl = exprDecl->to<ast::expr::ExpressionNewDecl>();
+
+				foldExpr(newDecl->exprDecl);
+				if (newDecl->objInitBlockDecl)
+				{
+					for (auto& itemDecl : newDecl->objInitBlockDecl->itemDeclList)
+					{
+						foldExpr(itemDecl->exprDecl);
+					}
+				}
+			}
+			break;
+		case AstNodeType_e::MatchExpr:
+			{
+				auto matchDecl = exprDecl->to<ast::expr::ExpressionMatchDecl>();
+
+				foldExpr(matchDecl->exprDecl);
+				for (auto& whenDecl : matchDecl->whenDeclList)
+				{
+					const size_t mark = mLocalList.size();
+
+					declarePattern(whenDecl->patternDecl.get());
+					foldExpr(whenDecl->exprDecl);
+
+					mLocalList.resize(mark);
+				}
+			}
+			break;
+		case AstNodeType_e::FunctionDeclExpr:
+			{
+				auto functionDecl = exprDecl->to<ast::expr::ExpressionFunctionDecl>();
+				const size_t mark = mLocalList.size();
+
+				for (auto& parameterDecl : functionDecl->parametersDeclList)
+				{
+					parameterDecl->patternDecl ? declarePattern(parameterDecl->patternDecl.get()) : declareLocal(parameterDecl.get());
+				}
+
+				if (functionDecl->blockDecl)
+				{
+					foldBlock(functionDecl->blockDecl.get());
+				}
+				foldExpr(functionDecl->exprDecl);
+
+				mLocalList.resize(mark);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void
+	ConstantFolding::foldAssignTarget(ExpressionDeclPtr& exprDecl)
+	{
+		switch (exprDecl->nodeType)
+		{
+		case AstNodeType_e::IndexExpr:
+			{
+				auto indexDecl = exprDecl->to<ast::expr::ExpressionIndexDecl>();
+
+				foldExpr(indexDecl->lhsDecl);
+				foldExpr(indexDecl->rhsDecl);
+			}
+			break;
+		case AstNodeType_e::BinaryExpr:
+			if (exprDecl->to<ast::expr::ExpressionBinaryDecl>()->op != TokenType_e::ScopeResolution)
+			{
+				foldExpr(exprDecl->to<ast::expr::ExpressionBinaryDecl>()->leftDecl);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void
+	ConstantFolding::foldUnary(ExpressionDeclPtr& exprDecl)
+	{
+		auto unaryDecl = exprDecl->to<ast::expr::ExpressionUnaryDecl>();
+		vm::Value_s value;
+
+		if (!toValue(unaryDecl->exprDecl.get(), value))
+		{
+			return;
+		}
+
+		switch (unaryDecl->op)
+		{
+		case TokenType_e::Minus:
+			if (vm::isInteger(value.type))
+			{
+				const vm::Value_s result = vm::makeInteger(value.type, static_cast<I64>(0 - static_cast<U64>(value.integerValue)));
+
+				// Apenas o zero nao muda de valor, exceto pelo menor inteiro com sinal.
+				if (value.integerValue != 0 && (vm::isUnsigned(value.type) || result.integerValue == value.integerValue))
+				{
+					reportWarning(unaryDecl, diagnostics::DiagnosticCode_e::IntegerOverflow);
+				}
+				replaceWithValue(exprDecl, result);
+			}
+			else if (vm::isReal(value.type))
+			{
+				replaceWithValue(exprDecl, vm::makeReal(value.type, -value.realValue));
+			}
+			break;
+		case TokenType_e::BitWiseNot:
+			if (vm::isInteger(value.type))
+			{
+				replaceWithValue(exprDecl, vm::makeInteger(value.type, ~value.integerValue));
+			}
+			break;
+		case TokenType_e::LogicalNot:
+			replaceWithValue(exprDecl, vm::makeBool(!vm::isTruthy(value)));
+			break;
+		default:
+			break;
+		}
+	}
+
+	void
+	ConstantFolding::foldBinary(ExpressionDeclPtr& exprDecl)
+	{
+		auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+		auto leftDecl = binaryDecl->leftDecl.get();
+		auto rightDecl = binaryDecl->rightDecl.get();
+
+		if (!isConstantExpr(leftDecl))
+		{
+			return;
+		}
+
+		vm::Value_s lhs;
+		vm::Value_s rhs;
+
+		// O resultado de '&&' e '||' e o ultimo operando avaliado.
+		if (binaryDecl->op == TokenType_e::LogicalAnd || binaryDecl->op == TokenType_e::LogicalOr)
+		{
+			if (!toValue(leftDecl, lhs))
+			{
+				return;
+			}
+
+			const Bool truthy = vm::isTruthy(lhs);
+			const Bool keepLeft = binaryDecl->op == TokenType_e::LogicalAnd ? !truthy : truthy;
+
+			ExpressionDeclPtr result = std::move(keepLeft ? binaryDecl->leftDecl : binaryDecl->rightDecl);
+			exprDecl = std::move(result);
+			mFoldedCount++;
+			return;
+		}
+
+		if (!isConstantExpr(rightDecl))
+		{
+			return;
+		}
+
+		const Bool leftString = leftDecl->nodeType == AstNodeType_e::ConstantStringExpr;
+		const Bool rightString = rightDecl->nodeType == AstNodeType_e::ConstantStringExpr;
+
+		if (leftString || rightString)
+		{
+			switch (binaryDecl->op)
+			{
+			case TokenType_e::Plus:
+				exprDecl = makeString(toText(leftDecl) + toText(rightDecl), binaryDecl);
+				mFoldedCount++;
+				break;
+			case TokenType_e::Equal:
+			case TokenType_e::NotEqual:
+				{
+					const Bool equal = leftString && rightString && toText(leftDecl) == toText(rightDecl);
+					replaceWithValue(exprDecl, vm::makeBool(binaryDecl->op == TokenType_e::Equal ? equal : !equal));
+				}
+				break;
+			default:
+				break;
+			}
+			return;
+		}
+
+		if (!toValue(leftDecl, lhs) || !toValue(rightDecl, rhs))
+		{
+			return;
+		}
+
+		const OpCode_e op = codegen::getBinaryOpCode(binaryDecl->op);
+		vm::Value_s result;
+		vm::OperationStatus_e status;
+
+		switch (op)
+		{
+		case OpCode_e::Equal:
+		case OpCode_e::NotEqual:
+		case OpCode_e::Less:
+		case OpCode_e::LessEqual:
+		case OpCode_e::Greater:
+		case OpCode_e::GreaterEqual:
+			status = vm::computeComparison(op, lhs, rhs, result);
+			break;
+		case OpCode_e::Add:
+		case OpCode_e::Sub:
+		case OpCode_e::Mul:
+		case OpCode_e::Div:
+		case OpCode_e::Mod:
+		case OpCode_e::Shl:
+		case OpCode_e::Shr:
+		case OpCode_e::BitAnd:
+		case OpCode_e::BitOr:
+		case OpCode_e::BitXor:
+			status = vm::computeArithmetic(op, lhs, rhs, result);
+			break;
+		default:
+			return;
+		}
+
+		switch (status)
+		{
+		case vm::OperationStatus_e::Success:
+			break;
+		case vm::OperationStatus_e::DivisionByZero:
+			// O erro e registrado e a expressao permanece sem avaliacao.
+			mScopeManager->reportError(diagnostics::DiagnosticCode_e::DivisionByZero, binaryDecl, {});
+			return;
+		default:
+			// Operandos invalidos falham em tempo de execucao.
+			return;
+		}
+
+		if (hasOverflow(op, lhs, rhs, result))
+		{
+			reportWarning(binaryDecl, diagnostics::DiagnosticCode_e::IntegerOverflow);
+		}
+		replaceWithValue(exprDecl, result);
+	}
+
+	void
+	ConstantFolding::foldTernary(ExpressionDeclPtr& exprDecl)
+	{
+		auto ternaryDecl = exprDecl->to<ast::expr::ExpressionTernaryDecl>();
+		auto conditionDecl = ternaryDecl->conditionDecl.get();
+
+		if (!isConstantExpr(conditionDecl))
+		{
+			return;
+		}
+
+		vm::Value_s condition;
+		if (!toValue(conditionDecl, condition))
+		{
+			return;
+		}
+
+		ExpressionDeclPtr result = std::move(vm::isTruthy(condition) ? ternaryDecl->leftDecl : ternaryDecl->rightDecl);
+		exprDecl = std::move(result);
+		mFoldedCount++;
+	}
+
+	void
+	ConstantFolding::foldAs(ExpressionDeclPtr& exprDecl)
+	{
+		auto asDecl = exprDecl->to<ast::expr::ExpressionAsDecl>();
+		vm::Value_s value;
+
+		if (asDecl->typeDecl->nodeType != AstNodeType_e::PrimitiveType || !toValue(asDecl->exprDecl.get(), value))
+		{
+			return;
+		}
+
+		vm::Value_s result;
+		if (vm::computeCast(value, asDecl->typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType, result))
+		{
+			replaceWithValue(exprDecl, result);
+		}
+	}
+
+	void
+	ConstantFolding::propagateConstant(ExpressionDeclPtr& exprDecl)
+	{
+		if (mLiteralOnly)
+		{
+			return;
+		}
+
+		scope::FindResult_t findResult = findDecl(exprDecl.get());
+
+		if (!findResult.foundResult || findResult.nodeList.size() != 1)
+		{
+			return;
+		}
+
+		if (auto constantDecl = getConstantInit(findResult.nodeList[0]))
+		{
+			exprDecl = cloneConstant(constantDecl, exprDecl.get());
+			mFoldedCount++;
+		}
+	}
+
+	void
+	ConstantFolding::replaceWithValue(ExpressionDeclPtr& exprDecl, const vm::Value_s& value)
+	{
+		auto origin = exprDecl.get();
+
+		switch (value.type)
+		{
+		case vm::ValueType_e::Null:
+			exprDecl = makeDecl<ast::expr::ExpressionConstantNullDecl>(origin);
+			break;
+		case vm::ValueType_e::Bool:
+			{
+				auto boolDecl = makeDecl<ast::expr::ExpressionConstantBoolDecl>(origin);
+				boolDecl->valueDecl = value.boolValue;
+				exprDecl = std::move(boolDecl);
+			}
+			break;
+		case vm::ValueType_e::Fp32:
+		case vm::ValueType_e::Fp64:
+			{
+				auto realDecl = makeDecl<ast::expr::ExpressionConstantRealDecl>(origin);
+				realDecl->valueDecl = value.realValue;
+				realDecl->valueType = toPrimitiveType(value.type);
+				exprDecl = std::move(realDecl);
+			}
+			break;
+		default:
+			if (!vm::isInteger(value.type))
+			{
+				return;
+			}
+			{
+				auto integerDecl = makeDecl<ast::expr::ExpressionConstantIntegerDecl>(origin);
+				integerDecl->valueDecl = value.integerValue;
+				integerDecl->valueType = toPrimitiveType(value.type);
+				exprDecl = std::move(integerDecl);
+			}
+			break;
+		}
+		mFoldedCount++;
+	}
+
+	scope::FindResult_t
+	ConstantFolding::findDecl(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		if (exprDecl->nodeType == AstNodeType_e::IdentifierExpr)
+		{
+			const Bool startFromRoot = exprDecl->to<ast::expr::ExpressionIdentifierDecl>()->startFromRoot;
+
+			// Variaveis locais e parametros escondem os nomes dos escopos externos.
+			if (!startFromRoot)
+			{
+				for (auto it = mLocalList.rbegin(); it != mLocalList.rend(); it++)
+				{
+					if ((*it)->identifier == exprDecl->identifier)
+					{
+						return scope::FindResult_t { nullptr, NodeList { *it }, true };
+					}
+				}
+			}
+			return mScopeManager->findNodeById(exprDecl->identifier, startFromRoot);
+		}
+
+		if (exprDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op != TokenType_e::ScopeResolution)
+			{
+				return scope::FindResult_t { nullptr, NodeList(), false };
+			}
+
+			scope::FindResult_t findResult = findDecl(binaryDecl->leftDecl.get());
+
+			if (findResult.foundResult && findResult.nodeList.size() == 1)
+			{
+				switch (findResult.nodeList[0]->nodeType)
+				{
+				case AstNodeType_e::NamespaceDecl:
+				case AstNodeType_e::ClassDecl:
+					return scope::Scope(mScopeManager, findResult.scope, findResult.nodeList[0]).findNodeById(binaryDecl->rightDecl->identifier);
+				default:
+					break;
+				}
+			}
+		}
+		return scope::FindResult_t { nullptr, NodeList(), false };
+	}
+
+	ast::expr::ExpressionDecl*
+	ConstantFolding::getConstantInit(ast::AstNode* const decl)
+	{
+		ast::TypeDecl* typeDecl = nullptr;
+		ExpressionDeclPtr* initExpr = nullptr;
+
+		switch (decl->nodeType)
+		{
+		case AstNodeType_e::StmtVariable:
+			{
+				auto variableDecl = decl->to<ast::stmt::StmtVariableDecl>();
+
+				if (!variableDecl->isConst || variableDecl->patternDecl)
+				{
+					return nullptr;
+				}
+				typeDecl = variableDecl->typeDecl.get();
+				initExpr = &variableDecl->initExpr;
+			}
+			break;
+		case AstNodeType_e::VariableDecl:
+			{
+				auto variableDecl = decl->to<ast::VariableDecl>();
+
+				if (!variableDecl->isConst)
+				{
+					return nullptr;
+				}
+				typeDecl = variableDecl->typeDecl.get();
+				initExpr = &variableDecl->initExpr;
+			}
+			break;
+		case AstNodeType_e::ClassVariableDecl:
+			{
+				auto classVariableDecl = decl->to<ast::ClassVariableDecl>();
+
+				if (!classVariableDecl->isConst || !classVariableDecl->isStatic)
+				{
+					return nullptr;
+				}
+				typeDecl = classVariableDecl->typeDecl.get();
+				initExpr = &classVariableDecl->initExpr;
+			}
+			break;
+		default:
+			return nullptr;
+		}
+
+		if (*initExpr == nullptr)
+		{
+			return nullptr;
+		}
+
+		// A constante ainda nao foi visitada: avalia apenas os literais, os nomes
+		// da expressao pertencem ao escopo da declaracao.
+		if (!isConstantExpr(initExpr->get()))
+		{
+			std::vector<ast::AstNode*> localList;
+			std::swap(localList, mLocalList);
+
+			const Bool literalOnly = mLiteralOnly;
+			mLiteralOnly = true;
+			foldExpr(*initExpr);
+			mLiteralOnly = literalOnly;
+
+			std::swap(localList, mLocalList);
+		}
+
+		if (!isConstantExpr(initExpr->get()))
+		{
+			return nullptr;
+		}
+
+		// O valor so e propagado quando tem exatamente o tipo declarado.
+		if (typeDecl != nullptr)
+		{
+			if (typeDecl->nodeType != AstNodeType_e::PrimitiveType
+				|| typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType != getConstantType(initExpr->get()))
+			{
+				return nullptr;
+			}
+		}
+		return initExpr->get();
+	}
+
+	void
+	ConstantFolding::declareLocal(ast::AstNode* const decl)
+	{
+		mLocalList.push_back(decl);
+	}
+
+	void
+	ConstantFolding::declarePattern(ast::pattern::PatternDecl* const patternDecl)
+	{
+		switch (patternDecl->nodeType)
+		{
+		case AstNodeType_e::LiteralPattern:
+			{
+				auto literalPatternDecl = patternDecl->to<ast::pattern::LiteralPatternDecl>();
+
+				if (literalPatternDecl->literalExpr)
+				{
+					foldExpr(literalPatternDecl->literalExpr);
+				}
+				else
+				{
+					declareLocal(literalPatternDecl);
+				}
+			}
+			break;
+		case AstNodeType_e::TuplePatternDecl:
+			for (auto& itemDecl : patternDecl->to<ast::pattern::TuplePatternDecl>()->patternItemDeclList)
+			{
+				declarePattern(itemDecl.get());
+			}
+			break;
+		case AstNodeType_e::EnumerablePatternDecl:
+			for (auto& itemDecl : patternDecl->to<ast::pattern::EnumerablePatternDecl>()->patternDeclItemList)
+			{
+				declarePattern(itemDecl.get());
+			}
+			break;
+		case AstNodeType_e::StructurePatternDecl:
+			for (auto& itemDecl : patternDecl->to<ast::pattern::StructurePatternDecl>()->structureItemDeclList)
+			{
+				itemDecl->referencedPattern ? declarePattern(itemDecl->referencedPattern.get()) : declareLocal(itemDecl.get());
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	void
+	ConstantFolding::reportWarning(ast::AstNode* const node, diagnostics::DiagnosticCode_e code)
+	{
+		const diagnostics::Diagnostic_s diagnostic = diagnostics::DiagnosticEngine::makeDiagnostic(code, mScopeManager->getCodeUnitName(), node, node->line, node->column, {});
+
+		mWarningList.push_back(ConstantWarning_s {
+			String(mScopeManager->getCodeUnitName().str()) + " warning: " + diagnostics::DiagnosticEngine::formatMessage(diagnostic),
+			node->line,
+			node->column
+		});
+
+		if (auto diagnosticEngine = mScopeManager->getDiagnosticEngine())
+		{
+			diagnosticEngine->report(diagnostic);
+		}
+	}
+} }
@@ -1,6 +1,7 @@
-#include "ast\fl_ast_decl.h"
-#include "utils\fl_ast_utils.h"
-#include "transformation\fl_transformation_resolve_include.h"
+#include "ast/fl_ast_decl.h"
+#include "utils/fl_ast_utils.h"
+#include "utils/fl_summary_utils.h"
+#include "transformation/fl_transformation_resolve_include.h"
 namespace fluffy { namespace transformations {
 	template <
 		typename TList,
@@ -72,12 +73,132 @@ namespace fluffy { namespace transformations {
 			auto includeRootScope = includeScopeManager.getRootScope();
 			validateScope(includeRootScope.getNode());
 
-			ast::for_each(this, &ResolveInclude::processIncludeItem, includeDecl->includedItemList, includeDecl, includeRootScope);
+			// O sumario de exportacao e gerado apos o parse, caso o code unit
+			// tenha sido inserido por outro caminho ele e gerado aqui.
+			auto includeCodeUnit = ast::safe_cast<ast::CodeUnit>(includeRootScope.getNode());
+			auto exportSummary = includeCodeUnit->getAttribute<attributes::ExportSummary>();
+
+			if (exportSummary == nullptr)
+			{
+				exportSummary = utils::SummaryUtils::generateExportSummary(includeCodeUnit);
+			}
+
+			for (auto& includeItemDecl : includeDecl->includedItemList)
+			{
+				// Tenta resolver o item pelo sumario, se nao for possivel faz a busca
+				// completa pelo escopo, que tambem e responsavel por reportar os erros.
+				if (!processIncludeItemFromSummary(includeItemDecl.get(), exportSummary))
+				{
+					processIncludeItem(includeItemDecl.get(), includeRootScope);
+				}
+			}
 		}
 	}
 
+	Bool
+	ResolveInclude::requireFunctionBody()
+	{
+		return false;
+	}
+
+	Bool
+	ResolveInclude::processIncludeItemFromSummary(ast::IncludeItemDecl* const includeItemDecl, attributes::ExportSummary* const exportSummary)
+	{
+		// Itens reexportados por includes do proprio code unit nao fazem parte do sumario.
+		if (includeItemDecl->scopePath == nullptr)
+		{
+			return false;
+		}
+
+		String scopePath;
+		ast::AstNode* scopeNode = nullptr;
+
+		auto nextId = includeItemDecl->scopePath.get();
+
+		while (nextId)
+		{
+			if (scopePath.size())
+			{
+				scopePath += "::";
+			}
+			scopePath += nextId->identifier.str();
+
+			// Apenas caminhos sem ambiguidade sao resolvidos pelo sumario.
+			auto& symbolList = exportSummary->findSymbol(scopePath);
+			if (symbolList.size() != 1)
+			{
+				return false;
+			}
+
+			scopeNode = symbolList[0].node;
+
+			switch (scopeNode->nodeType)
+			{
+			case AstNodeType_e::NamespaceDecl:
+			case AstNodeType_e::ClassDecl:
+			case AstNodeType_e::EnumDecl:
+				break;
+			default:
+				return false;
+			}
+
+			if (!checkNodeVisibility(scopeNode))
+			{
+				return false;
+			}
+			nextId = nextId->scopedChildPath.get();
+		}
+
+		if (!includeItemDecl->includeAll)
+		{
+			const TString& includedIdentifier = includeItemDecl->referencedAlias == TString(nullptr)
+				? includeItemDecl->identifier
+				: includeItemDecl->referencedAlias;
+
+			auto& symbolList = exportSummary->findSymbol(scopePath + "::" + includedIdentifier.str());
+			if (!symbolList.size())
+			{
+				return false;
+			}
+
+			for (auto& symbol : symbolList)
+			{
+				validateIncludedNode(symbol.node, includeItemDecl);
+
+				if (symbol.node->nodeType == AstNodeType_e::TraitForDecl)
+				{
+					mIncludedScope->insertTraitDefinitionNode(includeItemDecl->identifier, symbol.node);
+				}
+				else
+				{
+					mIncludedScope->insertIncludedNode(includeItemDecl->identifier, scopeNode, symbol.node);
+				}
+			}
+		}
+		else
+		{
+			for (auto& symbol : exportSummary->scopeSymbolList(scopePath))
+			{
+				if (checkNodeVisibility(symbol.node))
+				{
+					validateIncludedNode(symbol.node, includeItemDecl);
+
+					if (symbol.node->nodeType == AstNodeType_e::TraitForDecl)
+					{
+						mIncludedScope->insertTraitDefinitionNode(symbol.node->identifier, symbol.node);
+					}
+					else
+					{
+						mIncludedScope->insertWeakIncludedNode(symbol.node->identifier, scopeNode, symbol.node);
+					}
+				}
+			}
+		}
+		return true;
+	}
+
 	void
-	ResolveInclude::processIncludeItem(ast::IncludeItemDecl* const includeItemDecl, ast::IncludeDecl* const includeDecl, scope::Scope& includeRootScope)
+	ResolveInclude::processIncludeItem(ast::IncludeItemDecl* const includeItemDecl, scope::Scope& includeRootScope)
 	{
 		scope::Scope scope = includeRootScope;
 
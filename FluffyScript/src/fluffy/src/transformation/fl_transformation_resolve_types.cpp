@@ -1,9 +1,9 @@
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_decl.h"
-#include "utils\fl_ast_utils.h"
-#include "attributes\fl_reference.h"
-#include "attributes\fl_included_scope.h"
-#include "transformation\fl_transformation_resolve_types.h"
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_decl.h"
+#include "utils/fl_ast_utils.h"
+#include "attributes/fl_reference.h"
+#include "attributes/fl_included_scope.h"
+#include "transformation/fl_transformation_resolve_types.h"
 namespace fluffy { namespace transformations {
 	/**
 	 * ResolveTypes
@@ -44,28 +44,24 @@ namespace fluffy { namespace transformations {
 					else
 					{
 						auto scope = scope::Scope(mScopeManager, findResult.scope, findResult.nodeList[0]);
-						validateScope(scope.getNode());
+						if (!validateScope(scope.getNode()))
+						{
+							return;
+						}
 
 						findResult = scope.findNodeById(nextId->identifier);
 					}
 
 					if (!findResult.foundResult)
 					{
-						throw exceptions::custom_exception(
-							"%s error: Identifier '%s' not found in scope",
-							namedType->line, namedType->column,
-							mScopeManager->getCodeUnitName().str(),
-							namedType->identifier.str()
-						);
+						mScopeManager->reportError(diagnostics::DiagnosticCode_e::IdentifierNotFound, namedType, { namedType->identifier });
+						return;
 					}
 
 					if (findResult.nodeList.size() > 1)
 					{
-						throw exceptions::custom_exception(
-							"%s error: Ambiguous search result",
-							namedType->line, namedType->column,
-							mScopeManager->getCodeUnitName().str()
-						);
+						mScopeManager->reportError(diagnostics::DiagnosticCode_e::AmbiguousSearchResult, namedType, {});
+						return;
 					}
 
 					if (nextId->scopedChildPath)
@@ -79,7 +75,10 @@ namespace fluffy { namespace transformations {
 				}
 
 				auto scope = scope::Scope(mScopeManager, findResult.scope, findResult.nodeList[0]);
-				validateScope(scope.getNode());
+				if (!validateScope(scope.getNode()))
+				{
+					return;
+				}
 
 				findResult = scope.findNodeById(namedType->identifier);
 			}
@@ -90,17 +89,16 @@ namespace fluffy { namespace transformations {
 
 			if (!findResult.foundResult)
 			{
-				throw exceptions::custom_exception(
-					"%s error: Identifier '%s' not found in scope",
-					namedType->line, namedType->column,
-					mScopeManager->getCodeUnitName().str(),
-					namedType->identifier.str()
-				);
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::IdentifierNotFound, namedType, { namedType->identifier });
+				return;
 			}
 
 			// Se houver ambiguidade, remover os elementos fracos: aqueles elementos
 			// que vem de includes com coringa.
-			validateResult(findResult, namedType);
+			if (!validateResult(findResult, namedType))
+			{
+				return;
+			}
 
 			// Inclui o atributo de referencia no no de tipo.
 			if (findResult.scope->nodeType == AstNodeType_e::CodeUnit)
@@ -116,9 +114,32 @@ namespace fluffy { namespace transformations {
 				namedType->insertAttribute(new attributes::Reference(findResult.scope, findResult.nodeList[0]));
 			}
 		}
+
+		// Os filhos do tipo ja foram resolvidos, o tipo pode ser internado.
+		if (event == scope::NodeProcessorEvent_e::onEnd)
+		{
+			switch (node->nodeType)
+			{
+			case AstNodeType_e::PrimitiveType:
+			case AstNodeType_e::ArrayType:
+			case AstNodeType_e::FunctionType:
+			case AstNodeType_e::TupleType:
+			case AstNodeType_e::NamedType:
+				mTypeTable.intern(reinterpret_cast<ast::TypeDecl*>(node));
+				break;
+			default:
+				break;
+			}
+		}
 	}
 
-	void
+	types::TypeTable*
+	ResolveTypes::getTypeTable()
+	{
+		return &mTypeTable;
+	}
+
+	Bool
 	ResolveTypes::validateResult(fluffy::scope::FindResult_t& findResult, ast::AstNode* const namedType)
 	{
 		if (findResult.nodeList.size())
@@ -139,22 +160,15 @@ namespace fluffy { namespace transformations {
 
 		if (findResult.nodeList.size() > 1)
 		{
-			throw exceptions::custom_exception(
-				"%s error: Ambiguous search result '%s'",
-				namedType->line, namedType->column,
-				mScopeManager->getCodeUnitName().str(),
-				namedType->identifier.str()
-			);
+			mScopeManager->reportError(diagnostics::DiagnosticCode_e::AmbiguousType, namedType, { namedType->identifier });
+			return false;
 		}
 		else if (!findResult.nodeList.size())
 		{
-			throw exceptions::custom_exception(
-				"%s error: The '%s' could not be a valid type or could not be found in scope",
-				namedType->line, namedType->column,
-				mScopeManager->getCodeUnitName().str(),
-				namedType->identifier.str()
-			);
+			mScopeManager->reportError(diagnostics::DiagnosticCode_e::InvalidType, namedType, { namedType->identifier });
+			return false;
 		}
+		return true;
 	}
 
 	Bool
@@ -176,7 +190,7 @@ namespace fluffy { namespace transformations {
 		return false;
 	}
 
-	void
+	Bool
 	ResolveTypes::validateScope(ast::AstNode* const node)
 	{
 		switch (node->nodeType)
@@ -185,14 +199,10 @@ namespace fluffy { namespace transformations {
 		case AstNodeType_e::NamespaceDecl:
 		case AstNodeType_e::ClassDecl:
 		case AstNodeType_e::EnumDecl:
-			break;
+			return true;
 		default:
-			throw exceptions::custom_exception(
-				"%s error: '%s' is not a valid scope",
-				node->line, node->column,
-				mScopeManager->getCodeUnitName().str(),
-				node->identifier.str()
-			);
+			mScopeManager->reportError(diagnostics::DiagnosticCode_e::InvalidScope, node, { node->identifier });
+			return false;
 		}
 	}
 } }
\ No newline at end of file
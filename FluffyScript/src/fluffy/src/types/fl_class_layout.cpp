@@ -0,0 +1,374 @@
+#include <algorithm>
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_type.h"
+#include "utils/fl_ast_utils.h"
+#include "attributes/fl_reference.h"
+#include "types/fl_class_layout.h"
+#include "fl_exceptions.h"
+namespace fluffy { namespace types {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static Bool
+	sameSignature(const Signature_s& signatureA, const Signature_s& signatureB)
+	{
+		return *signatureA.identifier == *signatureB.identifier
+			&& signatureA.isStatic == signatureB.isStatic
+			&& signatureA.parameterList == signatureB.parameterList
+			&& signatureA.returnType == signatureB.returnType;
+	}
+
+	static ast::GenericDecl*
+	getGenericDecl(ast::AstNode* const decl)
+	{
+		switch (decl->nodeType)
+		{
+		case AstNodeType_e::ClassDecl:
+			return decl->to<ast::ClassDecl>()->genericDecl.get();
+		case AstNodeType_e::InterfaceDecl:
+			return decl->to<ast::InterfaceDecl>()->genericDecl.get();
+		default:
+			break;
+		}
+		return nullptr;
+	}
+
+	/**
+	 * SignatureIndex
+	 */
+
+	SignatureIndex::SignatureIndex()
+	{}
+
+	SignatureIndex::~SignatureIndex()
+	{}
+
+	void
+	SignatureIndex::insert(const Signature_s& signature, U32 value)
+	{
+		const U32 entryIndex = static_cast<U32>(mEntryList.size());
+
+		mEntryList.emplace_back(signature, value);
+
+		if (!signature.isOpen)
+		{
+			mSignatureMap.emplace(signature.hash, entryIndex);
+		}
+		mNameMap.emplace(signature.nameHash, entryIndex);
+	}
+
+	U32
+	SignatureIndex::find(const Signature_s& signature)
+	{
+		if (!signature.isOpen)
+		{
+			auto range = mSignatureMap.equal_range(signature.hash);
+
+			for (auto it = range.first; it != range.second; it++)
+			{
+				auto& entry = mEntryList[it->second];
+
+				if (sameSignature(entry.first, signature))
+				{
+					return entry.second;
+				}
+			}
+		}
+
+		// Assinaturas abertas sao comparadas pela arvore de tipos.
+		auto range = mNameMap.equal_range(signature.nameHash);
+
+		for (auto it = range.first; it != range.second; it++)
+		{
+			auto& entry = mEntryList[it->second];
+
+			if (!entry.first.isOpen && !signature.isOpen)
+			{
+				continue;
+			}
+
+			if (*entry.first.identifier == *signature.identifier && entry.first.isStatic == signature.isStatic &&
+				utils::AstUtils::equals(entry.first.functionDecl, signature.functionDecl))
+			{
+				return entry.second;
+			}
+		}
+		return invalidSlot;
+	}
+
+	/**
+	 * ClassLayout
+	 */
+
+	ClassLayout::ClassLayout(ast::ClassDecl* const classDecl)
+		: mClassDecl(classDecl)
+	{}
+
+	ClassLayout::~ClassLayout()
+	{}
+
+	const MethodSlot_s*
+	ClassLayout::findMethod(const Signature_s& signature)
+	{
+		const U32 slot = mSignatureIndex.find(signature);
+		return slot != invalidSlot ? &mVTable[slot] : nullptr;
+	}
+
+	const InterfaceTable_s*
+	ClassLayout::findInterfaceTable(ast::InterfaceDecl* const interfaceDecl)
+	{
+		auto it = mInterfaceTableMap.find(interfaceDecl);
+		return it != mInterfaceTableMap.end() ? &mInterfaceTableList[it->second] : nullptr;
+	}
+
+	const std::vector<MethodSlot_s>&
+	ClassLayout::getVTable()
+	{
+		return mVTable;
+	}
+
+	const std::vector<InterfaceTable_s>&
+	ClassLayout::getInterfaceTableList()
+	{
+		return mInterfaceTableList;
+	}
+
+	ast::ClassDecl*
+	ClassLayout::getClassDecl()
+	{
+		return mClassDecl;
+	}
+
+	U32
+	ClassLayout::insertSlot(MethodSlot_s& slot)
+	{
+		slot.index = static_cast<U32>(mVTable.size());
+
+		mSignatureIndex.insert(slot.signature, slot.index);
+		mVTable.push_back(std::move(slot));
+
+		return mVTable.back().index;
+	}
+
+	/**
+	 * LayoutBuilder
+	 */
+
+	LayoutBuilder::LayoutBuilder()
+	{}
+
+	LayoutBuilder::~LayoutBuilder()
+	{}
+
+	ClassLayout*
+	LayoutBuilder::getLayout(ast::ClassDecl* const classDecl)
+	{
+		auto it = mLayoutMap.find(classDecl);
+
+		if (it != mLayoutMap.end())
+		{
+			return it->second.get();
+		}
+
+		auto layout = new ClassLayout(classDecl);
+		mLayoutMap.emplace(classDecl, layout);
+
+		// Os itens do generic da propria classe ficam opacos.
+		build(layout, classDecl, TypeSubstitution());
+
+		return layout;
+	}
+
+	TypeTable*
+	LayoutBuilder::getTypeTable()
+	{
+		return &mTypeTable;
+	}
+
+	void
+	LayoutBuilder::build(ClassLayout* const layout, ast::ClassDecl* const classDecl, const TypeSubstitution& substitution)
+	{
+		// Os slots herdados vem primeiro, com os argumentos do 'extends' substituidos.
+		if (classDecl->baseClass)
+		{
+			auto reference = classDecl->baseClass->getAttribute<attributes::Reference>();
+
+			if (reference != nullptr && reference->get()->nodeType == AstNodeType_e::ClassDecl && reference->get() != classDecl)
+			{
+				build(layout, reference->to<ast::ClassDecl>(), makeSubstitution(classDecl->baseClass.get(), substitution));
+			}
+		}
+
+		// Cada funcao de interface ocupa um slot, abstrato ate ser implementado.
+		for (auto& implementDecl : classDecl->interfaceList)
+		{
+			auto reference = implementDecl->getAttribute<attributes::Reference>();
+
+			if (reference == nullptr || reference->get()->nodeType != AstNodeType_e::InterfaceDecl)
+			{
+				continue;
+			}
+
+			auto interfaceDecl = reference->to<ast::InterfaceDecl>();
+			auto interfaceSubstitution = makeSubstitution(implementDecl.get(), substitution);
+			InterfaceTable_s interfaceTable = { interfaceDecl, classDecl, {} };
+
+			for (auto& interfaceFunctionDecl : interfaceDecl->functionDeclList)
+			{
+				Signature_s signature = makeSignature(&mTypeTable, interfaceFunctionDecl.get(), interfaceSubstitution);
+				U32 slotIndex = layout->mSignatureIndex.find(signature);
+
+				if (slotIndex == invalidSlot)
+				{
+					MethodSlot_s slot = { 0, std::move(signature), interfaceFunctionDecl.get(), classDecl, true, interfaceDecl, classDecl };
+					slotIndex = layout->insertSlot(slot);
+				}
+				else if (layout->mVTable[slotIndex].interfaceDecl == nullptr)
+				{
+					layout->mVTable[slotIndex].interfaceDecl = interfaceDecl;
+					layout->mVTable[slotIndex].implementorDecl = classDecl;
+				}
+				interfaceTable.slotList.push_back(slotIndex);
+			}
+
+			layout->mInterfaceTableMap[interfaceDecl] = static_cast<U32>(layout->mInterfaceTableList.size());
+			layout->mInterfaceTableList.push_back(std::move(interfaceTable));
+		}
+
+		// Funcoes da classe sobrescrevem o slot de mesma assinatura ou criam um novo.
+		for (auto& functionDecl : classDecl->functionList)
+		{
+			if (functionDecl->isStatic)
+			{
+				continue;
+			}
+
+			Signature_s signature = makeSignature(&mTypeTable, functionDecl.get(), substitution);
+			const U32 slotIndex = layout->mSignatureIndex.find(signature);
+
+			if (slotIndex != invalidSlot)
+			{
+				MethodSlot_s& slot = layout->mVTable[slotIndex];
+
+				slot.functionDecl = functionDecl.get();
+				slot.ownerDecl = classDecl;
+				slot.isAbstract = functionDecl->isAbstract;
+			}
+			else
+			{
+				MethodSlot_s slot = { 0, std::move(signature), functionDecl.get(), classDecl, functionDecl->isAbstract, nullptr, nullptr };
+				layout->insertSlot(slot);
+			}
+		}
+	}
+
+	TypeSubstitution
+	LayoutBuilder::makeSubstitution(ast::TypeDecl* const typeDecl, const TypeSubstitution& substitution)
+	{
+		TypeSubstitution result;
+
+		if (typeDecl->nodeType != AstNodeType_e::NamedType)
+		{
+			return result;
+		}
+
+		auto namedType = typeDecl->to<ast::TypeDeclNamed>();
+		auto reference = namedType->getAttribute<attributes::Reference>();
+		auto genericDecl = reference ? getGenericDecl(reference->get()) : nullptr;
+
+		if (genericDecl == nullptr)
+		{
+			return result;
+		}
+
+		const size_t itemCount = std::min(genericDecl->genericDeclItemList.size(), namedType->genericDefinitionList.size());
+
+		for (size_t i = 0; i < itemCount; i++)
+		{
+			if (auto argumentType = mTypeTable.intern(namedType->genericDefinitionList[i].get(), substitution))
+			{
+				result.emplace(genericDecl->genericDeclItemList[i].get(), argumentType);
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	Signature_s
+	makeSignature(TypeTable* const typeTable, ast::AstNode* const functionDecl, const TypeSubstitution& substitution)
+	{
+		Signature_s signature = { functionDecl, &functionDecl->identifier, false, {}, nullptr, false, 0, 0 };
+		ast::FunctionParameterDeclPtrList* parameterList = nullptr;
+		ast::TypeDecl* returnType = nullptr;
+
+		switch (functionDecl->nodeType)
+		{
+		case AstNodeType_e::ClassFunctionDecl:
+			{
+				auto classFunctionDecl = functionDecl->to<ast::ClassFunctionDecl>();
+				signature.isStatic = classFunctionDecl->isStatic;
+				parameterList = &classFunctionDecl->parameterList;
+				returnType = classFunctionDecl->returnType.get();
+			}
+			break;
+		case AstNodeType_e::InterfaceFunctionDecl:
+			{
+				auto interfaceFunctionDecl = functionDecl->to<ast::InterfaceFunctionDecl>();
+				parameterList = &interfaceFunctionDecl->parameterList;
+				returnType = interfaceFunctionDecl->returnType.get();
+			}
+			break;
+		case AstNodeType_e::TraitFunctionDecl:
+			{
+				auto traitFunctionDecl = functionDecl->to<ast::TraitFunctionDecl>();
+				signature.isStatic = traitFunctionDecl->isStatic;
+				parameterList = &traitFunctionDecl->parameterList;
+				returnType = traitFunctionDecl->returnType.get();
+			}
+			break;
+		case AstNodeType_e::FunctionDecl:
+			{
+				auto freeFunctionDecl = functionDecl->to<ast::FunctionDecl>();
+				parameterList = &freeFunctionDecl->parameterList;
+				returnType = freeFunctionDecl->returnType.get();
+			}
+			break;
+		default:
+			throw exceptions::custom_exception("Invalid function declaration for signature");
+		}
+
+		for (auto& parameterDecl : *parameterList)
+		{
+			const Type_s* const parameterType = parameterDecl->typeDecl
+				? typeTable->intern(parameterDecl->typeDecl.get(), substitution)
+				: nullptr;
+
+			signature.isOpen |= parameterType == nullptr;
+			signature.parameterList.push_back(parameterType);
+		}
+
+		if (returnType != nullptr)
+		{
+			signature.returnType = typeTable->intern(returnType, substitution);
+			signature.isOpen |= signature.returnType == nullptr;
+		}
+
+		signature.nameHash = combineHash(signature.identifier->hash(), signature.isStatic);
+		signature.nameHash = combineHash(signature.nameHash, signature.parameterList.size());
+		signature.hash = signature.nameHash;
+
+		if (!signature.isOpen)
+		{
+			for (auto parameterType : signature.parameterList)
+			{
+				signature.hash = combineHash(signature.hash, reinterpret_cast<U64>(parameterType));
+			}
+			signature.hash = combineHash(signature.hash, reinterpret_cast<U64>(signature.returnType));
+		}
+		return signature;
+	}
+} }
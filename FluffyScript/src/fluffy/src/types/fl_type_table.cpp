@@ -0,0 +1,335 @@
+#include <string>
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_type.h"
+#include "attributes/fl_reference.h"
+#include "attributes/fl_interned_type.h"
+#include "types/fl_type_table.h"
+namespace fluffy { namespace types {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static const I8*
+	getPrimitiveName(PrimitiveTypeID_e primitiveType)
+	{
+		switch (primitiveType)
+		{
+		case PrimitiveTypeID_e::Void:		return "void";
+		case PrimitiveTypeID_e::Bool:		return "bool";
+		case PrimitiveTypeID_e::I8:			return "i8";
+		case PrimitiveTypeID_e::U8:			return "u8";
+		case PrimitiveTypeID_e::I16:		return "i16";
+		case PrimitiveTypeID_e::U16:		return "u16";
+		case PrimitiveTypeID_e::I32:		return "i32";
+		case PrimitiveTypeID_e::U32:		return "u32";
+		case PrimitiveTypeID_e::I64:		return "i64";
+		case PrimitiveTypeID_e::U64:		return "u64";
+		case PrimitiveTypeID_e::Fp32:		return "fp32";
+		case PrimitiveTypeID_e::Fp64:		return "fp64";
+		case PrimitiveTypeID_e::String:		return "string";
+		case PrimitiveTypeID_e::Object:		return "object";
+		default:
+			break;
+		}
+		return "unknown";
+	}
+
+	/**
+	 * TypeTable
+	 */
+
+	TypeTable::TypeTable()
+	{}
+
+	TypeTable::~TypeTable()
+	{}
+
+	const Type_s*
+	TypeTable::intern(ast::TypeDecl* const typeDecl)
+	{
+		return internType(typeDecl, nullptr);
+	}
+
+	const Type_s*
+	TypeTable::intern(ast::TypeDecl* const typeDecl, const TypeSubstitution& substitution)
+	{
+		return internType(typeDecl, &substitution);
+	}
+
+	U32
+	TypeTable::getTypeCount()
+	{
+		return static_cast<U32>(mTypeList.size());
+	}
+
+	const Type_s*
+	TypeTable::internType(ast::TypeDecl* const typeDecl, const TypeSubstitution* const substitution)
+	{
+		// Sem contexto o tipo canonico fica associado ao no.
+		if (substitution == nullptr)
+		{
+			if (auto internedType = typeDecl->getAttribute<attributes::InternedType>())
+			{
+				return internedType->get();
+			}
+		}
+
+		Type_s type = { TypeKind_e::Primitive, typeDecl->nullable, PrimitiveTypeID_e::Unknown, nullptr, nullptr, nullptr, {}, {}, 0, 0 };
+
+		switch (typeDecl->nodeType)
+		{
+		case AstNodeType_e::PrimitiveType:
+			type.primitiveType = typeDecl->to<ast::TypeDeclPrimitive>()->primitiveType;
+			break;
+		case AstNodeType_e::NamedType:
+			{
+				auto namedType = typeDecl->to<ast::TypeDeclNamed>();
+				auto reference = namedType->getAttribute<attributes::Reference>();
+
+				if (reference == nullptr)
+				{
+					return nullptr;
+				}
+
+				type.kind = TypeKind_e::Named;
+				type.decl = reference->get();
+
+				if (type.decl->nodeType == AstNodeType_e::GenericItemDecl)
+				{
+					if (substitution == nullptr)
+					{
+						return nullptr;
+					}
+
+					auto it = substitution->find(type.decl);
+
+					if (it != substitution->end())
+					{
+						// 'T?' com 'T' substituido recebe a versao anulavel do argumento.
+						if (!type.nullable || it->second->nullable)
+						{
+							return it->second;
+						}
+
+						Type_s nullableType = *it->second;
+						nullableType.nullable = true;
+						return insert(nullableType);
+					}
+				}
+
+				for (auto& genericType : namedType->genericDefinitionList)
+				{
+					const Type_s* const itemType = internType(genericType.get(), substitution);
+
+					if (itemType == nullptr)
+					{
+						return nullptr;
+					}
+					type.itemList.push_back(itemType);
+				}
+			}
+			break;
+		case AstNodeType_e::ArrayType:
+			{
+				auto arrayType = typeDecl->to<ast::TypeDeclArray>();
+
+				type.kind = TypeKind_e::Array;
+				type.elementType = internType(arrayType->valueType.get(), substitution);
+
+				if (type.elementType == nullptr)
+				{
+					return nullptr;
+				}
+
+				for (auto& arrayDecl : arrayType->arrayDeclList)
+				{
+					type.dimensionList.push_back(arrayDecl->nodeType == AstNodeType_e::SizedArray
+						? arrayDecl->to<ast::SizedArrayDecl>()->size
+						: unsizedDimension
+					);
+				}
+			}
+			break;
+		case AstNodeType_e::FunctionType:
+			{
+				auto functionType = typeDecl->to<ast::TypeDeclFunction>();
+
+				type.kind = TypeKind_e::Function;
+
+				if (functionType->objectOwnerDecl)
+				{
+					if ((type.ownerType = internType(functionType->objectOwnerDecl.get(), substitution)) == nullptr)
+					{
+						return nullptr;
+					}
+				}
+
+				if (functionType->returnType)
+				{
+					if ((type.elementType = internType(functionType->returnType.get(), substitution)) == nullptr)
+					{
+						return nullptr;
+					}
+				}
+
+				for (auto& parameterType : functionType->parameterTypeList)
+				{
+					const Type_s* const itemType = internType(parameterType.get(), substitution);
+
+					if (itemType == nullptr)
+					{
+						return nullptr;
+					}
+					type.itemList.push_back(itemType);
+				}
+			}
+			break;
+		case AstNodeType_e::TupleType:
+			{
+				auto tupleType = typeDecl->to<ast::TypeDeclTuple>();
+
+				type.kind = TypeKind_e::Tuple;
+
+				for (auto& tupleItem : tupleType->tupleItemList)
+				{
+					const Type_s* const itemType = internType(tupleItem.get(), substitution);
+
+					if (itemType == nullptr)
+					{
+						return nullptr;
+					}
+					type.itemList.push_back(itemType);
+				}
+			}
+			break;
+		default:
+			// 'self' depende da classe que implementa a trait.
+			return nullptr;
+		}
+
+		const Type_s* const result = insert(type);
+
+		if (substitution == nullptr)
+		{
+			typeDecl->insertAttribute(new attributes::InternedType(result));
+		}
+		return result;
+	}
+
+	String
+	TypeTable::toString(const Type_s* const type)
+	{
+		String result;
+
+		switch (type->kind)
+		{
+		case TypeKind_e::Primitive:
+			result = getPrimitiveName(type->primitiveType);
+			break;
+		case TypeKind_e::Named:
+			result = type->decl->identifier.str();
+
+			if (type->itemList.size())
+			{
+				result += "<";
+				for (size_t i = 0; i < type->itemList.size(); i++)
+				{
+					result += (i ? ", " : "") + toString(type->itemList[i]);
+				}
+				result += ">";
+			}
+			break;
+		case TypeKind_e::Array:
+			result = toString(type->elementType);
+
+			for (auto dimension : type->dimensionList)
+			{
+				result += dimension == unsizedDimension ? "[]" : "[" + std::to_string(dimension) + "]";
+			}
+			break;
+		case TypeKind_e::Function:
+			result = type->ownerType ? toString(type->ownerType) + "::fn(" : "fn(";
+
+			for (size_t i = 0; i < type->itemList.size(); i++)
+			{
+				result += (i ? ", " : "") + toString(type->itemList[i]);
+			}
+
+			if (type->elementType)
+			{
+				result += " -> " + toString(type->elementType);
+			}
+			result += ")";
+			break;
+		case TypeKind_e::Tuple:
+			result = "(";
+			for (size_t i = 0; i < type->itemList.size(); i++)
+			{
+				result += (i ? ", " : "") + toString(type->itemList[i]);
+			}
+			result += ")";
+			break;
+		}
+
+		if (type->nullable)
+		{
+			result += "?";
+		}
+		return result;
+	}
+
+	const Type_s*
+	TypeTable::insert(Type_s& type)
+	{
+		// Os filhos sao canonicos, o hash usa apenas os seus enderecos.
+		U64 hash = combineHash(static_cast<U64>(type.kind), type.nullable);
+
+		hash = combineHash(hash, static_cast<U64>(type.primitiveType));
+		hash = combineHash(hash, reinterpret_cast<U64>(type.decl));
+		hash = combineHash(hash, reinterpret_cast<U64>(type.elementType));
+		hash = combineHash(hash, reinterpret_cast<U64>(type.ownerType));
+
+		for (auto itemType : type.itemList)
+		{
+			hash = combineHash(hash, reinterpret_cast<U64>(itemType));
+		}
+
+		for (auto dimension : type.dimensionList)
+		{
+			hash = combineHash(hash, dimension);
+		}
+		type.hash = hash;
+
+		auto it = mTypeSet.find(&type);
+
+		if (it != mTypeSet.end())
+		{
+			return *it;
+		}
+
+		type.id = static_cast<U32>(mTypeList.size());
+		mTypeList.push_back(std::make_unique<Type_s>(std::move(type)));
+		mTypeSet.insert(mTypeList.back().get());
+
+		return mTypeList.back().get();
+	}
+
+	size_t
+	TypeTable::TypeHash::operator()(const Type_s* const type) const
+	{
+		return static_cast<size_t>(type->hash);
+	}
+
+	bool
+	TypeTable::TypeEqual::operator()(const Type_s* const typeA, const Type_s* const typeB) const
+	{
+		return typeA->kind == typeB->kind
+			&& typeA->nullable == typeB->nullable
+			&& typeA->primitiveType == typeB->primitiveType
+			&& typeA->decl == typeB->decl
+			&& typeA->elementType == typeB->elementType
+			&& typeA->ownerType == typeB->ownerType
+			&& typeA->itemList == typeB->itemList
+			&& typeA->dimensionList == typeB->dimensionList;
+	}
+} }
@@ -1,10 +1,11 @@
 #include <functional>
 #include <sstream>
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_decl.h"
-#include "ast\fl_ast_type.h"
-#include "utils\fl_ast_utils.h"
-#include "attributes\fl_reference.h"
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_type.h"
+#include "utils/fl_ast_utils.h"
+#include "attributes/fl_reference.h"
+#include "attributes/fl_interned_type.h"
 namespace fluffy { namespace utils {
 	/**
 	 * AstUtils
@@ -13,6 +14,17 @@ namespace fluffy { namespace utils {
 	Bool
 	AstUtils::equals(ast::AstNode* nodeA, ast::AstNode* nodeB)
 	{
+		// Tipos internados sao canonicos, basta comparar os enderecos. A
+		// comparacao recursiva abaixo considera os mesmos campos da tabela de
+		// tipos, o resultado nao depende de o tipo ter sido internado.
+		if (auto internedA = nodeA->getAttribute<attributes::InternedType>())
+		{
+			if (auto internedB = nodeB->getAttribute<attributes::InternedType>())
+			{
+				return internedA->get() == internedB->get();
+			}
+		}
+
 		if (nodeA->nodeType == nodeB->nodeType)
 		{
 			switch (nodeA->nodeType)
@@ -242,6 +254,10 @@ namespace fluffy { namespace utils {
 					ast::TypeDeclPrimitive* typeA = reinterpret_cast<ast::TypeDeclPrimitive*>(nodeA);
 					ast::TypeDeclPrimitive* typeB = reinterpret_cast<ast::TypeDeclPrimitive*>(nodeB);
 
+					if (typeA->nullable != typeB->nullable)
+					{
+						return false;
+					}
 					if (typeA->primitiveType != typeB->primitiveType)
 					{
 						return false;
@@ -286,6 +302,18 @@ namespace fluffy { namespace utils {
 						return false;
 					}
 
+					if (typeA->objectOwnerDecl || typeB->objectOwnerDecl)
+					{
+						if (!typeA->objectOwnerDecl || !typeB->objectOwnerDecl)
+						{
+							return false;
+						}
+						if (!equals(typeA->objectOwnerDecl.get(), typeB->objectOwnerDecl.get()))
+						{
+							return false;
+						}
+					}
+
 					if (!equals(typeA->returnType.get(), typeB->returnType.get()))
 					{
 						return false;
@@ -377,7 +405,10 @@ namespace fluffy { namespace utils {
 								referenceB->nodeType == AstNodeType_e::NamedType ? referenceB : typeB
 							);
 						}
-						return referenceA == referenceB;
+						if (referenceA != referenceB)
+						{
+							return false;
+						}
 					}
 					else
 					{
@@ -427,6 +458,10 @@ namespace fluffy { namespace utils {
 				}
 				return true;
 
+			case AstNodeType_e::ErrorDecl:
+				// Declaracoes com erro nao tem identificador, nunca sao duplicadas.
+				return false;
+
 			case AstNodeType_e::SizedArray:
 				{
 					ast::SizedArrayDecl* arrayDeclA = dynamic_cast<ast::SizedArrayDecl*>(nodeA);
@@ -634,6 +669,16 @@ namespace fluffy { namespace utils {
 	Bool
 	AstUtils::same(ast::AstNode* nodeA, ast::AstNode* nodeB)
 	{
+		// Tipos internados sao canonicos, basta comparar os enderecos, o
+		// resultado e o mesmo da comparacao recursiva.
+		if (auto internedA = nodeA->getAttribute<attributes::InternedType>())
+		{
+			if (auto internedB = nodeB->getAttribute<attributes::InternedType>())
+			{
+				return internedA->get() == internedB->get();
+			}
+		}
+
 		if (nodeA->nodeType == nodeB->nodeType)
 		{
 			switch (nodeA->nodeType)
@@ -869,6 +914,10 @@ namespace fluffy { namespace utils {
 					ast::TypeDeclPrimitive* typeA = reinterpret_cast<ast::TypeDeclPrimitive*>(nodeA);
 					ast::TypeDeclPrimitive* typeB = reinterpret_cast<ast::TypeDeclPrimitive*>(nodeB);
 
+					if (typeA->nullable != typeB->nullable)
+					{
+						return false;
+					}
 					if (typeA->primitiveType != typeB->primitiveType)
 					{
 						return false;
@@ -913,6 +962,18 @@ namespace fluffy { namespace utils {
 						return false;
 					}
 
+					if (typeA->objectOwnerDecl || typeB->objectOwnerDecl)
+					{
+						if (!typeA->objectOwnerDecl || !typeB->objectOwnerDecl)
+						{
+							return false;
+						}
+						if (!equals(typeA->objectOwnerDecl.get(), typeB->objectOwnerDecl.get()))
+						{
+							return false;
+						}
+					}
+
 					if (!equals(typeA->returnType.get(), typeB->returnType.get()))
 					{
 						return false;
@@ -0,0 +1,68 @@
+#include <sstream>
+#include "utils/fl_build_result_utils.h"
+#include "fl_compiler.h"
+
+namespace fluffy { namespace utils {
+	/**
+	 * BuildResultUtils
+	 */
+
+	String
+	BuildResultUtils::toJson(const std::vector<BuildResult_s>& resultList)
+	{
+		std::stringstream stream;
+
+		stream << "[";
+		for (size_t i = 0; i < resultList.size(); i++)
+		{
+			const BuildResult_s& result = resultList[i];
+
+			stream << (i ? "," : "")
+				<< "{\"file\":\"" << escapeJson(result.sourceFile) << "\""
+				<< ",\"entry\":" << (result.isEntry ? "true" : "false")
+				<< ",\"success\":" << (result.success ? "true" : "false")
+				<< ",\"cached\":" << (result.cached ? "true" : "false")
+				<< ",\"parseTime\":" << result.parseTime
+				<< ",\"processTime\":" << result.processTime
+				<< ",\"diagnostics\":[";
+
+			if (!result.success)
+			{
+				stream << "\"" << escapeJson(result.error) << "\"";
+			}
+			stream << "]}";
+		}
+		stream << "]";
+		return stream.str();
+	}
+
+	String
+	BuildResultUtils::escapeJson(const String& text)
+	{
+		static const I8* hexDigits = "0123456789abcdef";
+		std::stringstream stream;
+
+		for (auto c : text)
+		{
+			switch (c)
+			{
+			case '"':	stream << "\\\""; break;
+			case '\\':	stream << "\\\\"; break;
+			case '\n':	stream << "\\n"; break;
+			case '\r':	stream << "\\r"; break;
+			case '\t':	stream << "\\t"; break;
+			default:
+				if (static_cast<U8>(c) < 0x20)
+				{
+					stream << "\\u00" << hexDigits[c >> 4] << hexDigits[c & 0xF];
+				}
+				else
+				{
+					stream << c;
+				}
+				break;
+			}
+		}
+		return stream.str();
+	}
+} }
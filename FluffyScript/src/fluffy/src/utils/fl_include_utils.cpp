@@ -1,5 +1,5 @@
-#include "ast\fl_ast_decl.h"
-#include "utils\fl_include_utils.h"
+#include "ast/fl_ast_decl.h"
+#include "utils/fl_include_utils.h"
 
 namespace fluffy { namespace utils {
 	/**
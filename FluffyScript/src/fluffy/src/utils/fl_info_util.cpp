@@ -1,3 +1,3 @@
-#include "utils\fl_info_util.h"
+#include "utils/fl_info_util.h"
 namespace fluffy { namespace utils {
 } }
\ No newline at end of file
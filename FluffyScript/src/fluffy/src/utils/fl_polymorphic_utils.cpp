@@ -1,7 +1,7 @@
-#include "ast\fl_ast_decl.h"
-#include "attributes\fl_reference.h"
-#include "attributes\fl_implemented_trait_list.h"
-#include "utils\fl_polymorphic_utils.h"
+#include "ast/fl_ast_decl.h"
+#include "attributes/fl_reference.h"
+#include "attributes/fl_implemented_trait_list.h"
+#include "utils/fl_polymorphic_utils.h"
 
 namespace fluffy { namespace ast {
 	class AstNode;
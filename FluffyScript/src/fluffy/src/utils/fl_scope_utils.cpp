@@ -1,8 +1,8 @@
 #include <functional>
-#include "ast\fl_ast_decl.h"
-#include "scope\fl_scope_manager.h"
-#include "utils\fl_ast_utils.h"
-#include "utils\fl_scope_utils.h"
+#include "ast/fl_ast_decl.h"
+#include "scope/fl_scope_manager.h"
+#include "utils/fl_ast_utils.h"
+#include "utils/fl_scope_utils.h"
 namespace fluffy { namespace utils {
 	template <
 		typename TListDst,
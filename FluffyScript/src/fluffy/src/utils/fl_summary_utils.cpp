@@ -0,0 +1,114 @@
+#include "ast/fl_ast_decl.h"
+#include "attributes/fl_export_summary.h"
+#include "utils/fl_summary_utils.h"
+
+namespace fluffy { namespace utils {
+	template <
+		typename TList
+	> void
+	appendSummary(attributes::ExportSummary* const exportSummary, const String& scopePath, ast::AstNode* const scope, TList& list)
+	{
+		for (auto& it : list)
+		{
+			if (it->nodeType == AstNodeType_e::ErrorDecl)
+			{
+				continue;
+			}
+			exportSummary->insertSymbol(scopePath, scope, it.get());
+		}
+	}
+
+	/**
+	 * SummaryUtils
+	 */
+
+	attributes::ExportSummary* const
+	SummaryUtils::generateExportSummary(ast::CodeUnit* const codeUnit)
+	{
+		// Descarta um sumario anterior, o code unit pode ter sido reconstruido.
+		codeUnit->removeAttribute(AttributeType_e::ExportSummary);
+
+		auto exportSummary = codeUnit->getOrCreateAttribute<attributes::ExportSummary>();
+		summarizeScope(exportSummary, String(), codeUnit);
+		return exportSummary;
+	}
+
+	void
+	SummaryUtils::summarizeScope(attributes::ExportSummary* const exportSummary, const String& scopePath, ast::AstNode* const scope)
+	{
+		// O sumario contem apenas as declaracoes, corpos de funcoes nunca sao visitados.
+		// Somente escopos que podem ser alcancados por um include sao expandidos: namespaces
+		// e classes ou enums exportados.
+		switch (scope->nodeType)
+		{
+		case AstNodeType_e::CodeUnit:
+			{
+				auto codeUnit = scope->to<ast::CodeUnit>();
+				appendSummary(exportSummary, scopePath, scope, codeUnit->namespaceDeclList);
+
+				for (auto& namespaceDecl : codeUnit->namespaceDeclList)
+				{
+					summarizeScope(exportSummary, namespaceDecl->identifier.str(), namespaceDecl.get());
+				}
+			}
+			break;
+
+		case AstNodeType_e::NamespaceDecl:
+			{
+				auto namespaceDecl = scope->to<ast::NamespaceDecl>();
+				appendSummary(exportSummary, scopePath, scope, namespaceDecl->namespaceDeclList);
+				appendSummary(exportSummary, scopePath, scope, namespaceDecl->generalDeclList);
+
+				for (auto& childNamespaceDecl : namespaceDecl->namespaceDeclList)
+				{
+					summarizeScope(exportSummary, scopePath + "::" + childNamespaceDecl->identifier.str(), childNamespaceDecl.get());
+				}
+
+				for (auto& generalDecl : namespaceDecl->generalDeclList)
+				{
+					if (generalDecl->isExported)
+					{
+						summarizeScope(exportSummary, scopePath + "::" + generalDecl->identifier.str(), generalDecl.get());
+					}
+				}
+			}
+			break;
+
+		case AstNodeType_e::ClassDecl:
+			{
+				auto classDecl = scope->to<ast::ClassDecl>();
+
+				if (classDecl->genericDecl)
+				{
+					appendSummary(exportSummary, scopePath, scope, classDecl->genericDecl->genericDeclItemList);
+				}
+
+				appendSummary(exportSummary, scopePath, scope, classDecl->constructorList);
+				appendSummary(exportSummary, scopePath, scope, classDecl->functionList);
+				appendSummary(exportSummary, scopePath, scope, classDecl->variableList);
+
+				if (classDecl->destructorDecl)
+				{
+					exportSummary->insertSymbol(scopePath, scope, classDecl->destructorDecl.get());
+				}
+			}
+			break;
+
+		case AstNodeType_e::EnumDecl:
+			{
+				auto enumDecl = scope->to<ast::EnumDecl>();
+
+				if (enumDecl->genericDecl)
+				{
+					appendSummary(exportSummary, scopePath, scope, enumDecl->genericDecl->genericDeclItemList);
+				}
+
+				appendSummary(exportSummary, scopePath, scope, enumDecl->enumItemDeclList);
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+} }
\ No newline at end of file
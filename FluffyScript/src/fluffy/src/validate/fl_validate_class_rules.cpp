@@ -1,14 +1,10 @@
-#include <functional>
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_decl.h"
-#include "utils\fl_ast_utils.h"
-#include "utils\fl_polymorphic_utils.h"
-#include "attributes\fl_reference.h"
-#include "attributes\fl_scope.h"
-#include "attributes\fl_included_scope.h"
-#include "attributes\fl_implemented_trait_list.h"
-#include "validate\fl_validate_class_rules.h"
-#include "generics\fl_clone.h"
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_decl.h"
+#include "utils/fl_polymorphic_utils.h"
+#include "attributes/fl_reference.h"
+#include "attributes/fl_included_scope.h"
+#include "attributes/fl_implemented_trait_list.h"
+#include "validate/fl_validate_class_rules.h"
 namespace fluffy { namespace validations {
 	/**
 	 * ClassRules
@@ -16,7 +12,6 @@ namespace fluffy { namespace validations {
 
 	ClassRules::ClassRules()
 		: mScopeManager(nullptr)
-		, mNeedCleanGenerics(false)
 	{}
 
 	ClassRules::~ClassRules()
@@ -36,6 +31,12 @@ namespace fluffy { namespace validations {
 		}
 	}
 
+	Bool
+	ClassRules::requireFunctionBody()
+	{
+		return false;
+	}
+
 	void
 	ClassRules::validateClassDecl(ast::ClassDecl* const classDecl)
 	{
@@ -54,29 +55,26 @@ namespace fluffy { namespace validations {
 					{
 						if (baseClassRef->nodeType != AstNodeType_e::ClassDecl)
 						{
-							throw exceptions::custom_exception(
-								"%s error: The '%s' class must be extended by another class: '%s' is not a class",
-								parentClass->line, parentClass->column,
-								mScopeManager->getCodeUnitName().str(), parentClass->identifier.str(),
-								baseClassRef->identifier.str()
-							);
+							mScopeManager->reportError(diagnostics::DiagnosticCode_e::BaseClassNotClass, parentClass, {
+								parentClass->identifier,
+								baseClassRef->identifier
+							});
+							return;
 						}
 
 						if (baseClassRef == classDecl)
 						{
-							throw exceptions::custom_exception(
-								"%s error: The '%s' class has circular extends dependency",
-								classDecl->line, classDecl->column,
-								mScopeManager->getCodeUnitName().str(),
-								classDecl->identifier.str()
-							);
+							mScopeManager->reportError(diagnostics::DiagnosticCode_e::CircularExtends, classDecl, { classDecl->identifier });
+							return;
 						}
 
 						if (baseClassRef->baseClass != nullptr)
 						{
 							parentClass = baseClassRef;
 							auto baseClassRefAttrib = baseClassRef->baseClass->getAttribute<attributes::Reference>();
-							baseClassRef = baseClassRefAttrib->to<ast::ClassDecl>();
+
+							// A classe pai sem referencia ja foi reportada.
+							baseClassRef = baseClassRefAttrib != nullptr ? baseClassRefAttrib->to<ast::ClassDecl>() : nullptr;
 						}
 						else
 						{
@@ -86,21 +84,17 @@ namespace fluffy { namespace validations {
 				}
 				else
 				{
-					throw exceptions::custom_exception(
-						"%s error: The '%s' class must be extended by another class: '%s' is not a class",
-						classDecl->baseClass->line, classDecl->baseClass->column,
-						mScopeManager->getCodeUnitName().str(), classDecl->identifier.str(),
-						reference->get()->identifier.str()
-					);
+					mScopeManager->reportError(diagnostics::DiagnosticCode_e::BaseClassNotClass, classDecl->baseClass.get(), {
+						classDecl->identifier,
+						reference->get()->identifier
+					});
+					return;
 				}
 			}
 			else
 			{
-				throw exceptions::custom_exception(
-					"%s error: Failed '%s' to retrieve baseClass reference attribute",
-					mScopeManager->getCodeUnitName().str(),
-					classDecl->identifier.str()
-				);
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::MissingReference, { classDecl->identifier });
+				return;
 			}
 		}
 
@@ -111,22 +105,17 @@ namespace fluffy { namespace validations {
 			{
 				if (reference->get()->nodeType != AstNodeType_e::InterfaceDecl)
 				{
-					throw exceptions::custom_exception(
-						"%s error: The '%s' class must implement only interfaces: '%s' is not a interface",
-						implement->line, implement->column,
-						mScopeManager->getCodeUnitName().str(),
-						classDecl->identifier.str(),
-						reference->get()->identifier.str()
-					);
+					mScopeManager->reportError(diagnostics::DiagnosticCode_e::InterfaceExpected, implement.get(), {
+						classDecl->identifier,
+						reference->get()->identifier
+					});
+					return;
 				}
 			}
 			else
 			{
-				throw exceptions::custom_exception(
-					"%s error: Failed '%s' to retrieve baseClass reference attribute",
-					mScopeManager->getCodeUnitName().str(),
-					classDecl->identifier.str()
-				);
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::MissingReference, { classDecl->identifier });
+				return;
 			}
 		}
 
@@ -137,13 +126,10 @@ namespace fluffy { namespace validations {
 			{
 				if (classFunc->isAbstract)
 				{
-					throw exceptions::custom_exception(
-						"%s error: The class '%s' declare '%s' function as abstract, only abstract class can have abstract functions",
-						classFunc->line, classFunc->column,
-						mScopeManager->getCodeUnitName().str(),
-						classDecl->identifier.str(),
-						classFunc->identifier.str()
-					);
+					mScopeManager->reportError(diagnostics::DiagnosticCode_e::AbstractFunctionInConcreteClass, classFunc.get(), {
+						classDecl->identifier,
+						classFunc->identifier
+					});
 				}
 			}
 		}
@@ -155,180 +141,86 @@ namespace fluffy { namespace validations {
 	void
 	ClassRules::validateClassRequiredInterfaceFunctions(ast::ClassDecl* const classDecl)
 	{
-		// Valida se a classe implementa todas as funcoes das interfaces.
-		for (auto& classInterfaceDecl : classDecl->interfaceList)
+		// Valida o modificador de acesso de funcoes abstratas.
+		for (auto& functionDecl : classDecl->functionList)
 		{
-			auto interfaceRef = classInterfaceDecl->getAttribute<attributes::Reference>();
-			auto interfaceDecl = interfaceRef->to<ast::InterfaceDecl>();
-
-			for (auto& interfaceFunction : interfaceDecl->functionDeclList)
+			if (functionDecl->isAbstract && functionDecl->accessModifier != ClassMemberAccessModifier_e::Public)
 			{
-				for (auto& functionDecl : classDecl->functionList)
-				{
-					// Valida o modificador de acesso de funcoes abstratas.
-					if (functionDecl->isAbstract && functionDecl->accessModifier != ClassMemberAccessModifier_e::Public)
-					{
-						throw exceptions::custom_exception(
-							"%s error: The '%s' function, must be public",
-							functionDecl->line, functionDecl->column,
-							mScopeManager->getCodeUnitName().str(),
-							functionDecl->identifier.str()
-						);
-					}
-
-					if (utils::AstUtils::equals(interfaceFunction.get(), functionDecl.get()))
-					{
-						// Valida se a funcao e publica.
-						if (functionDecl->accessModifier != ClassMemberAccessModifier_e::Public)
-						{
-							throw exceptions::custom_exception(
-								"%s error: The '%s' function in '%s' class must be public to satisfy '%s' interface",
-								functionDecl->line, functionDecl->column,
-								mScopeManager->getCodeUnitName().str(),
-								interfaceFunction->identifier.str(),
-								classDecl->identifier.str(),
-								classInterfaceDecl->identifier.str()
-							);
-						}
-						break;
-					}
-				}
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::AbstractFunctionNotPublic, functionDecl.get(), { functionDecl->identifier });
 			}
 		}
 
-		NodeList functionsOfInterfaces;
-		std::function<void(ast::ClassDecl* const)> extractInterfaceFunctions;
+		// A vtable inclui os slots herdados, cada funcao de interface ja esta
+		// associada a implementacao de mesma assinatura.
+		auto layout = mLayoutBuilder.getLayout(classDecl);
 
-		extractInterfaceFunctions = [this, &functionsOfInterfaces, &extractInterfaceFunctions](ast::ClassDecl* const classDecl) {
-			// Percorre todas as herancas possivel.
-			if (classDecl->baseClass)
+		// Valida se as funcoes que satisfazem interfaces sao publicas.
+		for (auto& slot : layout->getVTable())
+		{
+			if (slot.interfaceDecl == nullptr || slot.isAbstract)
 			{
-				auto baseClassRefAttrib = classDecl->baseClass->getAttribute<attributes::Reference>();
-				auto baseClassRef = baseClassRefAttrib->to<ast::ClassDecl>();
-				extractInterfaceFunctions(baseClassRef);
+				continue;
 			}
 
-			// Extrai as funcoes das interfaces.
-			for (auto& classInterfaceDecl : classDecl->interfaceList)
+			// Slots herdados sem alteracao ja foram validados na classe pai.
+			if (slot.ownerDecl != classDecl && slot.implementorDecl != classDecl)
 			{
-				auto interfaceDeclRef = classInterfaceDecl->getAttribute<attributes::Reference>();
-				auto interfaceDecl = interfaceDeclRef->to<ast::InterfaceDecl>();
-
-				for (auto& interfaceFunc : interfaceDecl->functionDeclList)
-				{
-					functionsOfInterfaces.emplace_back(interfaceFunc.get());
-					interfaceFunc->insertAttribute(new attributes::Scope(interfaceDecl));
-				}
+				continue;
 			}
 
-			// Incluir na lista funcoes abstratas.
-			for (auto& functionDecl : classDecl->functionList)
-			{
-				if (functionDecl->isAbstract)
-				{
-					functionsOfInterfaces.emplace_back(functionDecl.get());
-					functionDecl->insertAttribute(new attributes::Scope(classDecl));
-				}
-			}
+			auto functionDecl = slot.functionDecl->to<ast::ClassFunctionDecl>();
 
-			// Remove funcoes ja implemetadas.
-			for (auto interfaceFunctionIt = functionsOfInterfaces.begin();
-				interfaceFunctionIt != functionsOfInterfaces.end();
-			)
+			if (functionDecl->accessModifier != ClassMemberAccessModifier_e::Public)
 			{
-				Bool needUpdate = true;
-				auto interfaceFunction = *interfaceFunctionIt;
-				for (auto& functionDecl : classDecl->functionList)
-				{
-					if (utils::AstUtils::equals(interfaceFunction, functionDecl.get()) && interfaceFunction != functionDecl.get())
-					{
-						auto scope = interfaceFunction->getAttribute<attributes::Scope>();
-
-						// Valida se a funcao e publica.
-						if (interfaceFunction->nodeType == AstNodeType_e::InterfaceFunctionDecl &&
-							functionDecl->accessModifier != ClassMemberAccessModifier_e::Public
-						)
-						{
-							throw exceptions::custom_exception(
-								"%s error: The '%s' function in '%s' class must be public to satisfy '%s' interface",
-								classDecl->line, classDecl->column,
-								mScopeManager->getCodeUnitName().str(),
-								interfaceFunction->identifier.str(),
-								classDecl->identifier.str(),
-								scope->get()->identifier.str()
-							);
-						}
-
-						interfaceFunctionIt = functionsOfInterfaces.erase(
-							interfaceFunctionIt
-						);
-						needUpdate = false;
-						break;
-					}
-				}
-
-				// Verifica se e necessario atualizar o iterator,
-				// se alguem elemento e deletado nao e necessario atualizar.
-				if (needUpdate)
-				{
-					interfaceFunctionIt++;
-				}
+				// Interfaces da propria classe apontam para a funcao.
+				ast::AstNode* const errorNode = slot.ownerDecl == classDecl && slot.implementorDecl == classDecl
+					? static_cast<ast::AstNode*>(functionDecl)
+					: static_cast<ast::AstNode*>(classDecl);
+
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::InterfaceFunctionNotPublic, errorNode, {
+					functionDecl->identifier,
+					classDecl->identifier,
+					slot.interfaceDecl->identifier
+				});
 			}
-		};
-
-		extractInterfaceFunctions(classDecl);
+		}
 
-		// Remove funcoes ja implemetadas.
-		for (auto& functionDecl : classDecl->functionList)
+		if (classDecl->isAbstract)
 		{
-			for (auto interfaceFunctionIt = functionsOfInterfaces.begin();
-				interfaceFunctionIt != functionsOfInterfaces.end();
-			)
-			{
-				if (utils::AstUtils::equals(*interfaceFunctionIt, functionDecl.get()))
-				{
-					interfaceFunctionIt = functionsOfInterfaces.erase(
-						interfaceFunctionIt
-					);
-				}
-				else
-				{
-					interfaceFunctionIt++;
-				}
-			}
+			return;
 		}
 
 		// TODO: Para deixar a mensagem de erro mais clara informar o escopo da funcao.
-		// Verifica se ha alguma funcao pendente.
-		if (functionsOfInterfaces.size() && !classDecl->isAbstract)
+		// Verifica se ha algum slot pendente.
+		for (auto& slot : layout->getVTable())
 		{
-			for (auto requiredFunction : functionsOfInterfaces)
+			if (!slot.isAbstract)
 			{
-				auto scope = requiredFunction->getAttribute<attributes::Scope>();
+				continue;
+			}
 
-				if (requiredFunction->nodeType == AstNodeType_e::ClassFunctionDecl)
-				{
-					throw exceptions::custom_exception(
-						"%s error: The '%s' class must implement '%s' abstract function from '%s' class",
-						classDecl->line, classDecl->column,
-						mScopeManager->getCodeUnitName().str(),
-						classDecl->identifier.str(),
-						requiredFunction->identifier.str(),
-						scope->get()->identifier.str()
-					);
-				}
-				else
-				{
-					throw exceptions::custom_exception(
-						"%s error: The '%s' class must implement '%s' function from '%s' interface",
-						classDecl->line, classDecl->column,
-						mScopeManager->getCodeUnitName().str(),
-						classDecl->identifier.str(),
-						requiredFunction->identifier.str(),
-						scope->get()->identifier.str()
-					);
-				}
+			if (slot.functionDecl->nodeType == AstNodeType_e::ClassFunctionDecl)
+			{
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::AbstractFunctionNotImplemented, classDecl, {
+					classDecl->identifier,
+					slot.functionDecl->identifier,
+					slot.ownerDecl->identifier
+				});
+			}
+			else
+			{
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::InterfaceFunctionNotImplemented, classDecl, {
+					classDecl->identifier,
+					slot.functionDecl->identifier,
+					slot.interfaceDecl->identifier
+				});
 			}
 		}
 	}
+
+	types::LayoutBuilder*
+	ClassRules::getLayoutBuilder()
+	{
+		return &mLayoutBuilder;
+	}
 } }
@@ -1,7 +1,7 @@
 #include <functional>
-#include "ast\fl_ast_decl.h"
-#include "utils\fl_ast_utils.h"
-#include "validate\fl_validate_duplicated_nodes.h"
+#include "ast/fl_ast_decl.h"
+#include "utils/fl_ast_utils.h"
+#include "validate/fl_validate_duplicated_nodes.h"
 namespace fluffy { namespace validations {
 	template <
 		typename TListDst,
@@ -213,8 +213,11 @@ namespace fluffy { namespace validations {
 				
 		NodeList list;
 		for_each_ptr(scope.toMap(), [scopeManager, node, &list](ast::AstNode* const nodeA) {
-			for_each(list, [scopeManager, node, nodeA](ast::AstNode* const nodeB) {
-				if (utils::AstUtils::equals(nodeA, nodeB)) {
+			// Cada no duplicado e reportado uma vez e nao entra na lista.
+			Bool isDuplicated = false;
+
+			for_each(list, [scopeManager, node, nodeA, &isDuplicated](ast::AstNode* const nodeB) {
+				if (!isDuplicated && utils::AstUtils::equals(nodeA, nodeB)) {
 					ast::AstNode* duplicatedNode = nullptr;
 					if (nodeA->line > nodeB->line)
 					{
@@ -229,16 +232,15 @@ namespace fluffy { namespace validations {
 						duplicatedNode = nodeB;
 					}
 
-					throw exceptions::custom_exception(
-						"%s error: Duplicated identifier '%s'",
-						duplicatedNode->line, duplicatedNode->column,
-						scopeManager->getCodeUnitName().str(),
-						duplicatedNode->identifier.str()
-					);
+					isDuplicated = true;
+					scopeManager->reportError(diagnostics::DiagnosticCode_e::DuplicatedIdentifier, duplicatedNode, { duplicatedNode->identifier });
 				}
 			});
 
-			list.emplace_back(nodeA);
+			if (!isDuplicated)
+			{
+				list.emplace_back(nodeA);
+			}
 		});
 	}
 } }
\ No newline at end of file
@@ -1,13 +1,13 @@
 #include <functional>
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_decl.h"
-#include "utils\fl_ast_utils.h"
-#include "utils\fl_polymorphic_utils.h"
-#include "attributes\fl_reference.h"
-#include "attributes\fl_scope.h"
-#include "attributes\fl_included_scope.h"
-#include "attributes\fl_implemented_trait_list.h"
-#include "validate\fl_validate_generic_rules.h"
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_decl.h"
+#include "utils/fl_ast_utils.h"
+#include "utils/fl_polymorphic_utils.h"
+#include "attributes/fl_reference.h"
+#include "attributes/fl_scope.h"
+#include "attributes/fl_included_scope.h"
+#include "attributes/fl_implemented_trait_list.h"
+#include "validate/fl_validate_generic_rules.h"
 namespace fluffy { namespace validations {
 	/**
 	 * GenericRules
@@ -33,6 +33,12 @@ namespace fluffy { namespace validations {
 			auto type = node->to<ast::TypeDeclNamed>();
 			auto reference = type->getAttribute<attributes::Reference>();
 
+			// O tipo nao resolvido ja foi reportado.
+			if (reference == nullptr)
+			{
+				return;
+			}
+
 			ast::GenericDecl* genericDecl = nullptr;
 			switch (reference->get()->nodeType)
 			{
@@ -70,13 +76,11 @@ namespace fluffy { namespace validations {
 			// Valida o numero de argumentos.
 			if (type->genericDefinitionList.size() != genericDecl->genericDeclItemList.size())
 			{
-				throw exceptions::custom_exception(
-					"%s error: Generic '%s' requires %d type arguments",
-					type->line, type->column,
-					mScopeManager->getCodeUnitName().str(),
-					reference->get()->identifier.str(),
-					genericDecl->genericDeclItemList.size()
-				);
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::GenericArgumentCount, type, {
+					reference->get()->identifier,
+					TString(std::to_string(genericDecl->genericDeclItemList.size()))
+				});
+				return;
 			}
 
 			auto typeGenericIt = type->genericDefinitionList.begin();
@@ -103,7 +107,7 @@ namespace fluffy { namespace validations {
 							auto referenceA = typeGeneric->getAttribute<attributes::Reference>();
 							auto referenceB = whereIt->getAttribute<attributes::Reference>();
 
-							if (utils::PolymorphicUtils::canBe(
+							if (referenceA != nullptr && referenceB != nullptr && utils::PolymorphicUtils::canBe(
 								referenceA->get(),
 								referenceB->get()))
 							{
@@ -115,11 +119,7 @@ namespace fluffy { namespace validations {
 
 					if (!acceptedType)
 					{
-						throw exceptions::custom_exception(
-							"%s error: Type generic item doesn't match where clause",
-							type->line, type->column,
-							mScopeManager->getCodeUnitName().str()
-						);
+						mScopeManager->reportError(diagnostics::DiagnosticCode_e::GenericWhereMismatch, type, {});
 					}
 				}
 				typeGenericIt++;
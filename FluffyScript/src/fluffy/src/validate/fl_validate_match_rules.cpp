@@ -0,0 +1,243 @@
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_pattern.h"
+#include "scope/fl_scope.h"
+#include "validate/fl_validate_match_rules.h"
+namespace fluffy { namespace validations {
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	static match::PatternInfo_s
+	makeInfo(match::PatternKind_e kind)
+	{
+		return match::PatternInfo_s { kind, vm::makeNull(), String(), nullptr, 0, 0 };
+	}
+
+	/**
+	 * MatchRules
+	 */
+
+	MatchRules::MatchRules()
+		: mScopeManager(nullptr)
+	{}
+
+	MatchRules::~MatchRules()
+	{}
+
+	void
+	MatchRules::onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node)
+	{
+		if (event != scope::NodeProcessorEvent_e::onBegin)
+		{
+			return;
+		}
+		mScopeManager = scopeManager;
+
+		std::vector<ast::pattern::PatternDecl*> patternList;
+
+		switch (node->nodeType)
+		{
+		case AstNodeType_e::StmtMatch:
+			for (auto& whenDecl : node->to<ast::stmt::StmtMatchDecl>()->whenDeclList)
+			{
+				patternList.push_back(whenDecl->patternDecl.get());
+			}
+			validateMatch(node, patternList, false);
+			break;
+		case AstNodeType_e::MatchExpr:
+			for (auto& whenDecl : node->to<ast::expr::ExpressionMatchDecl>()->whenDeclList)
+			{
+				patternList.push_back(whenDecl->patternDecl.get());
+			}
+			validateMatch(node, patternList, true);
+			break;
+		default:
+			break;
+		}
+	}
+
+	match::PatternInfo_s
+	MatchRules::resolve(ast::pattern::PatternDecl* const patternDecl)
+	{
+		if (patternDecl->nodeType == AstNodeType_e::EnumerablePatternDecl)
+		{
+			const match::PatternInfo_s info = resolveDecl(mScopeManager->findNodeById(patternDecl->identifier, false));
+			return info.kind == match::PatternKind_e::Constructor
+				? info
+				: makeInfo(match::PatternKind_e::Dynamic);
+		}
+
+		auto literalPatternDecl = patternDecl->to<ast::pattern::LiteralPatternDecl>();
+		auto literalExpr = literalPatternDecl->literalExpr.get();
+
+		// Nomes que nao sao itens de enum ou variaveis globais capturam o valor.
+		if (literalExpr == nullptr)
+		{
+			if (literalPatternDecl->identifier == TString("_"))
+			{
+				return makeInfo(match::PatternKind_e::Wildcard);
+			}
+
+			return resolveDecl(mScopeManager->findNodeById(literalPatternDecl->identifier, false));
+		}
+
+		match::PatternInfo_s info = makeInfo(match::PatternKind_e::Constant);
+
+		if (literalExpr->nodeType == AstNodeType_e::ConstantStringExpr)
+		{
+			info.value.type = vm::ValueType_e::String;
+			info.name = "\"" + literalExpr->to<ast::expr::ExpressionConstantStringDecl>()->valueDecl + "\"";
+			return info;
+		}
+
+		if (match::getLiteralValue(literalExpr, info.value))
+		{
+			return info;
+		}
+
+		info = resolveDecl(findDecl(literalExpr));
+		return info.kind == match::PatternKind_e::Constructor
+			? info
+			: makeInfo(match::PatternKind_e::Dynamic);
+	}
+
+	String
+	MatchRules::getItemName(const void* const domain, U32 index)
+	{
+		auto enumDecl = reinterpret_cast<const ast::EnumDecl*>(domain);
+
+		return String(enumDecl->identifier.str()) + "::" + enumDecl->enumItemDeclList[index]->identifier.str();
+	}
+
+	const std::vector<MatchWarning_s>&
+	MatchRules::getWarningList()
+	{
+		return mWarningList;
+	}
+
+	void
+	MatchRules::validateMatch(ast::AstNode* const matchDecl, const std::vector<ast::pattern::PatternDecl*>& patternList, Bool isExpression)
+	{
+		match::MatchCompiler matchCompiler(this);
+		auto decisionTree = matchCompiler.compile(patternList);
+
+		for (auto armIndex : decisionTree->getRedundantArmList())
+		{
+			reportWarning(patternList[armIndex], diagnostics::DiagnosticCode_e::UnreachableMatchArm, {});
+		}
+
+		if (decisionTree->isExhaustive())
+		{
+			return;
+		}
+
+		// Statements sem correspondencia sao validos, apenas os itens de enums e
+		// booleanos esquecidos sao reportados.
+		String missing;
+		Bool hasNamedItem = false;
+
+		for (auto& item : decisionTree->getMissingList())
+		{
+			missing += missing.size() ? ", " + item : item;
+			hasNamedItem |= item != "_";
+		}
+
+		if (isExpression || hasNamedItem)
+		{
+			reportWarning(matchDecl, diagnostics::DiagnosticCode_e::NonExhaustiveMatch, { TString(missing) });
+		}
+	}
+
+	scope::FindResult_t
+	MatchRules::findDecl(ast::expr::ExpressionDecl* const exprDecl)
+	{
+		if (exprDecl->nodeType == AstNodeType_e::IdentifierExpr)
+		{
+			return mScopeManager->findNodeById(exprDecl->identifier, exprDecl->to<ast::expr::ExpressionIdentifierDecl>()->startFromRoot);
+		}
+
+		if (exprDecl->nodeType == AstNodeType_e::BinaryExpr)
+		{
+			auto binaryDecl = exprDecl->to<ast::expr::ExpressionBinaryDecl>();
+
+			if (binaryDecl->op == TokenType_e::ScopeResolution)
+			{
+				const scope::FindResult_t findResult = findDecl(binaryDecl->leftDecl.get());
+
+				if (findResult.foundResult && findResult.nodeList.size() == 1)
+				{
+					switch (findResult.nodeList[0]->nodeType)
+					{
+					case AstNodeType_e::NamespaceDecl:
+					case AstNodeType_e::ClassDecl:
+					case AstNodeType_e::EnumDecl:
+						return scope::Scope(mScopeManager, findResult.scope, findResult.nodeList[0]).findNodeById(binaryDecl->rightDecl->identifier);
+					default:
+						break;
+					}
+				}
+			}
+		}
+		return scope::FindResult_t { nullptr, NodeList(), false };
+	}
+
+	match::PatternInfo_s
+	MatchRules::resolveDecl(const scope::FindResult_t& findResult)
+	{
+		if (!findResult.foundResult || findResult.nodeList.size() != 1)
+		{
+			return makeInfo(match::PatternKind_e::Wildcard);
+		}
+
+		ast::AstNode* const decl = findResult.nodeList[0];
+
+		switch (decl->nodeType)
+		{
+		case AstNodeType_e::EnumItemDecl:
+			if (findResult.scope && findResult.scope->nodeType == AstNodeType_e::EnumDecl)
+			{
+				auto enumDecl = findResult.scope->to<ast::EnumDecl>();
+				match::PatternInfo_s info = makeInfo(match::PatternKind_e::Constructor);
+
+				info.domain = enumDecl;
+				info.domainSize = static_cast<U32>(enumDecl->enumItemDeclList.size());
+
+				for (U32 index = 0; index < info.domainSize; index++)
+				{
+					if (enumDecl->enumItemDeclList[index].get() == decl)
+					{
+						info.index = index;
+						break;
+					}
+				}
+				info.name = getItemName(enumDecl, info.index);
+				return info;
+			}
+			return makeInfo(match::PatternKind_e::Dynamic);
+		case AstNodeType_e::VariableDecl:
+		case AstNodeType_e::ClassVariableDecl:
+			return makeInfo(match::PatternKind_e::Dynamic);
+		default:
+			return makeInfo(match::PatternKind_e::Wildcard);
+		}
+	}
+
+	void
+	MatchRules::reportWarning(ast::AstNode* const node, diagnostics::DiagnosticCode_e code, std::initializer_list<TString> argList)
+	{
+		const diagnostics::Diagnostic_s diagnostic = diagnostics::DiagnosticEngine::makeDiagnostic(code, mScopeManager->getCodeUnitName(), node, node->line, node->column, argList);
+
+		mWarningList.push_back(MatchWarning_s {
+			String(mScopeManager->getCodeUnitName().str()) + " warning: " + diagnostics::DiagnosticEngine::formatMessage(diagnostic),
+			node->line,
+			node->column
+		});
+
+		if (auto diagnosticEngine = mScopeManager->getDiagnosticEngine())
+		{
+			diagnosticEngine->report(diagnostic);
+		}
+	}
+} }
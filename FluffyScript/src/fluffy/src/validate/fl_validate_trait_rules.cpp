@@ -1,13 +1,12 @@
 #include <functional>
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_decl.h"
-#include "utils\fl_ast_utils.h"
-#include "utils\fl_polymorphic_utils.h"
-#include "attributes\fl_reference.h"
-#include "attributes\fl_scope.h"
-#include "attributes\fl_included_scope.h"
-#include "attributes\fl_implemented_trait_list.h"
-#include "validate\fl_validate_trait_rules.h"
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_decl.h"
+#include "utils/fl_polymorphic_utils.h"
+#include "attributes/fl_reference.h"
+#include "attributes/fl_scope.h"
+#include "attributes/fl_included_scope.h"
+#include "attributes/fl_implemented_trait_list.h"
+#include "validate/fl_validate_trait_rules.h"
 namespace fluffy { namespace validations {
 	/**
 	 * TraitRules
@@ -34,6 +33,12 @@ namespace fluffy { namespace validations {
 		}
 	}
 
+	Bool
+	TraitRules::requireFunctionBody()
+	{
+		return false;
+	}
+
 	void
 	TraitRules::validateTraitFor(ast::TraitForDecl* const traitFor)
 	{
@@ -41,12 +46,22 @@ namespace fluffy { namespace validations {
 
 		// Como trait for e uma definicao de um trait, esta funcao valida se o trait esta devidamente
 		// declarado no escopo.
-		validateTraitForDeclaration(traitFor);
+		if (!validateTraitForDeclaration(traitFor))
+		{
+			return;
+		}
 
 		// Inclui a declaracao do trait no tipo especificado no for.
 		if (typeDef->nodeType == AstNodeType_e::NamedType)
 		{
 			auto referenceDefType = traitFor->typeDefinitionDecl->getAttribute<attributes::Reference>();
+
+			// O tipo nao resolvido ja foi reportado.
+			if (referenceDefType == nullptr)
+			{
+				return;
+			}
+
 			auto implementedTraitList = referenceDefType->get()->getOrCreateAttribute<attributes::ImplementedTraitList>();
 			auto referenceTrait = traitFor->getAttribute<attributes::Reference>();
 
@@ -71,7 +86,7 @@ namespace fluffy { namespace validations {
 		validateTraitForRequiredFunctions(traitFor);
 	}
 
-	void
+	Bool
 	TraitRules::validateTraitForDeclaration(ast::TraitForDecl* const traitFor)
 	{
 		if (auto reference = traitFor->getAttribute<attributes::Reference>())
@@ -104,33 +119,25 @@ namespace fluffy { namespace validations {
 
 			if (!findResult.foundResult)
 			{
-				throw exceptions::custom_exception(
-					"%s error: Trait '%s' not found in scope",
-					traitFor->line, traitFor->column,
-					mScopeManager->getCodeUnitName().str(),
-					traitFor->identifier.str()
-				);
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::TraitNotFound, traitFor, { traitFor->identifier });
+				return false;
 			}
 
 			// Verifica se ha ambiguidade no resultado.
 			if (findResult.nodeList.size() > 1)
 			{
-				throw exceptions::custom_exception(
-					"%s error: Failed to resolve trait, invalid search result",
-					traitFor->line, traitFor->column,
-					mScopeManager->getCodeUnitName().str()
-				);
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::TraitSearchFailed, traitFor, {});
+				return false;
 			}
 
 			// Verifica se ha ambiguidade no resultado.
 			if (findResult.nodeList[0]->nodeType != AstNodeType_e::TraitDecl)
 			{
-				throw exceptions::custom_exception(
-					"%s error: Failed to implement '%s' trait, '%s' trait doesn't exists",
-					traitFor->line, traitFor->column,
-					mScopeManager->getCodeUnitName().str(),
-					traitFor->identifier.str(), traitFor->identifier.str()
-				);
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::TraitNotDeclared, traitFor, {
+					traitFor->identifier,
+					traitFor->identifier
+				});
+				return false;
 			}
 
 			// Insere a referencia de trait no elemento.
@@ -163,6 +170,7 @@ namespace fluffy { namespace validations {
 				}
 			}
 		}
+		return true;
 	}
 
 	void
@@ -170,34 +178,25 @@ namespace fluffy { namespace validations {
 	{
 		auto reference = traitFor->getAttribute<attributes::Reference>();
 		auto trait = ast::safe_cast<ast::TraitDecl>(reference->get());
-		auto functionList = NodeList();
+		auto signatureIndex = types::SignatureIndex();
 
-		ast::for_each(trait->functionDeclList, [&functionList](ast::TraitFunctionDecl* const traitFunction) {
-			functionList.push_back(traitFunction);
-		});
+		// Indexa as funcoes implementadas pela assinatura.
+		for (auto& traitFunction : traitFor->functionDeclList)
+		{
+			signatureIndex.insert(types::makeSignature(&mTypeTable, traitFunction.get(), types::TypeSubstitution()), 0);
+		}
+
+		for (auto& traitFunction : trait->functionDeclList)
+		{
+			auto signature = types::makeSignature(&mTypeTable, traitFunction.get(), types::TypeSubstitution());
 
-		ast::for_each(traitFor->functionDeclList, [&functionList](ast::TraitFunctionDecl* const traitFunction) {
-			for (auto it = functionList.begin(); it != functionList.end();)
+			if (signatureIndex.find(signature) == types::invalidSlot)
 			{
-				if (utils::AstUtils::same(traitFunction, *it))
-				{
-					it = functionList.erase(it);
-				}
-				else
-				{
-					it++;
-				}
+				mScopeManager->reportError(diagnostics::DiagnosticCode_e::TraitFunctionNotImplemented, traitFunction.get(), {
+					traitFor->identifier,
+					traitFunction->identifier
+				});
 			}
-		});
-
-		if (functionList.size())
-		{
-			throw exceptions::custom_exception(
-				"%s error: Trait definition '%s' trait, must implement all functions: '%s' was not implemented",
-				functionList[0]->line, functionList[0]->column,
-				mScopeManager->getCodeUnitName().str(),
-				traitFor->identifier.str(), functionList[0]->identifier.str()
-			);
 		}
 	}
 } }
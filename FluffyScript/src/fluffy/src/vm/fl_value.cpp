@@ -0,0 +1,369 @@
+#include <cmath>
+#include <sstream>
+#include "vm/fl_value.h"
+namespace fluffy { namespace vm {
+	using codegen::OpCode_e;
+
+	/**
+	 * Funcoes auxiliares
+	 */
+
+	const I8*
+	getValueTypeName(ValueType_e type)
+	{
+		switch (type)
+		{
+		case ValueType_e::Null:		return "null";
+		case ValueType_e::Bool:		return "bool";
+		case ValueType_e::I8:		return "i8";
+		case ValueType_e::U8:		return "u8";
+		case ValueType_e::I16:		return "i16";
+		case ValueType_e::U16:		return "u16";
+		case ValueType_e::I32:		return "i32";
+		case ValueType_e::U32:		return "u32";
+		case ValueType_e::I64:		return "i64";
+		case ValueType_e::U64:		return "u64";
+		case ValueType_e::Fp32:		return "fp32";
+		case ValueType_e::Fp64:		return "fp64";
+		case ValueType_e::String:	return "string";
+		case ValueType_e::Object:	return "object";
+		case ValueType_e::Array:	return "array";
+		case ValueType_e::Function:	return "function";
+		default:					return "unknown";
+		}
+	}
+
+	Bool
+	isEqual(const Value_s& lhs, const Value_s& rhs)
+	{
+		if (isNumber(lhs.type) && isNumber(rhs.type))
+		{
+			if (isInteger(lhs.type) && isInteger(rhs.type))
+			{
+				return lhs.integerValue == rhs.integerValue;
+			}
+			return toReal(lhs) == toReal(rhs);
+		}
+
+		if (lhs.type != rhs.type)
+		{
+			return false;
+		}
+
+		switch (lhs.type)
+		{
+		case ValueType_e::Null:
+			return true;
+		case ValueType_e::Bool:
+			return lhs.boolValue == rhs.boolValue;
+		case ValueType_e::String:
+			return getString(lhs) == getString(rhs);
+		case ValueType_e::Function:
+			return lhs.functionIndex == rhs.functionIndex;
+		default:
+			return lhs.object == rhs.object;
+		}
+	}
+
+	OperationStatus_e
+	computeArithmetic(OpCode_e op, const Value_s& lhs, const Value_s& rhs, Value_s& result)
+	{
+		if (isInteger(lhs.type) && isInteger(rhs.type))
+		{
+			// O resultado tem o tipo do operando mais largo.
+			const ValueType_e type = lhs.type > rhs.type ? lhs.type : rhs.type;
+			const U64 a = static_cast<U64>(lhs.integerValue);
+			const U64 b = static_cast<U64>(rhs.integerValue);
+
+			switch (op)
+			{
+			case OpCode_e::Add:		result = makeInteger(type, static_cast<I64>(a + b)); return OperationStatus_e::Success;
+			case OpCode_e::Sub:		result = makeInteger(type, static_cast<I64>(a - b)); return OperationStatus_e::Success;
+			case OpCode_e::Mul:		result = makeInteger(type, static_cast<I64>(a * b)); return OperationStatus_e::Success;
+			case OpCode_e::BitAnd:	result = makeInteger(type, static_cast<I64>(a & b)); return OperationStatus_e::Success;
+			case OpCode_e::BitOr:	result = makeInteger(type, static_cast<I64>(a | b)); return OperationStatus_e::Success;
+			case OpCode_e::BitXor:	result = makeInteger(type, static_cast<I64>(a ^ b)); return OperationStatus_e::Success;
+			case OpCode_e::Shl:		result = makeInteger(type, static_cast<I64>(a << (b & 63))); return OperationStatus_e::Success;
+			case OpCode_e::Shr:
+				result = isUnsigned(type)
+					? makeInteger(type, static_cast<I64>(a >> (b & 63)))
+					: makeInteger(type, lhs.integerValue >> (b & 63));
+				return OperationStatus_e::Success;
+			case OpCode_e::Div:
+			case OpCode_e::Mod:
+				if (b == 0)
+				{
+					return OperationStatus_e::DivisionByZero;
+				}
+
+				if (type == ValueType_e::U64)
+				{
+					result = makeInteger(type, static_cast<I64>(op == OpCode_e::Div ? a / b : a % b));
+				}
+				else if (rhs.integerValue == -1)
+				{
+					// Evita o overflow de INT64_MIN / -1.
+					result = makeInteger(type, op == OpCode_e::Div ? static_cast<I64>(0 - a) : 0);
+				}
+				else
+				{
+					result = makeInteger(type, op == OpCode_e::Div ? lhs.integerValue / rhs.integerValue : lhs.integerValue % rhs.integerValue);
+				}
+				return OperationStatus_e::Success;
+			default:
+				break;
+			}
+		}
+		else if (isNumber(lhs.type) && isNumber(rhs.type))
+		{
+			// fp64 prevalece sobre fp32, que prevalece sobre os inteiros.
+			const ValueType_e type = lhs.type == ValueType_e::Fp64 || rhs.type == ValueType_e::Fp64
+				? ValueType_e::Fp64
+				: ValueType_e::Fp32;
+			const Fp64 a = toReal(lhs);
+			const Fp64 b = toReal(rhs);
+
+			switch (op)
+			{
+			case OpCode_e::Add:		result = makeReal(type, a + b); return OperationStatus_e::Success;
+			case OpCode_e::Sub:		result = makeReal(type, a - b); return OperationStatus_e::Success;
+			case OpCode_e::Mul:		result = makeReal(type, a * b); return OperationStatus_e::Success;
+			case OpCode_e::Div:		result = makeReal(type, a / b); return OperationStatus_e::Success;
+			case OpCode_e::Mod:		result = makeReal(type, std::fmod(a, b)); return OperationStatus_e::Success;
+			default:
+				break;
+			}
+		}
+		else if (lhs.type == ValueType_e::Bool && rhs.type == ValueType_e::Bool)
+		{
+			switch (op)
+			{
+			case OpCode_e::BitAnd:	result = makeBool(lhs.boolValue && rhs.boolValue); return OperationStatus_e::Success;
+			case OpCode_e::BitOr:	result = makeBool(lhs.boolValue || rhs.boolValue); return OperationStatus_e::Success;
+			case OpCode_e::BitXor:	result = makeBool(lhs.boolValue != rhs.boolValue); return OperationStatus_e::Success;
+			default:
+				break;
+			}
+		}
+		return OperationStatus_e::InvalidOperands;
+	}
+
+	OperationStatus_e
+	computeComparison(OpCode_e op, const Value_s& lhs, const Value_s& rhs, Value_s& result)
+	{
+		if (op == OpCode_e::Equal || op == OpCode_e::NotEqual)
+		{
+			result = makeBool(isEqual(lhs, rhs) == (op == OpCode_e::Equal));
+			return OperationStatus_e::Success;
+		}
+
+		I32 order = 0;
+
+		if (isInteger(lhs.type) && isInteger(rhs.type))
+		{
+			if (lhs.type == ValueType_e::U64 || rhs.type == ValueType_e::U64)
+			{
+				const U64 a = static_cast<U64>(lhs.integerValue);
+				const U64 b = static_cast<U64>(rhs.integerValue);
+				order = a < b ? -1 : (a > b ? 1 : 0);
+			}
+			else
+			{
+				order = lhs.integerValue < rhs.integerValue ? -1 : (lhs.integerValue > rhs.integerValue ? 1 : 0);
+			}
+		}
+		else if (isNumber(lhs.type) && isNumber(rhs.type))
+		{
+			const Fp64 a = toReal(lhs);
+			const Fp64 b = toReal(rhs);
+
+			// Comparacoes com NaN sao sempre falsas.
+			if (a != a || b != b)
+			{
+				result = makeBool(false);
+				return OperationStatus_e::Success;
+			}
+			order = a < b ? -1 : (a > b ? 1 : 0);
+		}
+		else if (lhs.type == ValueType_e::String && rhs.type == ValueType_e::String)
+		{
+			order = getString(lhs).compare(getString(rhs));
+		}
+		else
+		{
+			return OperationStatus_e::InvalidOperands;
+		}
+
+		switch (op)
+		{
+		case OpCode_e::Less:			result = makeBool(order < 0); break;
+		case OpCode_e::LessEqual:		result = makeBool(order <= 0); break;
+		case OpCode_e::Greater:			result = makeBool(order > 0); break;
+		default:						result = makeBool(order >= 0); break;
+		}
+		return OperationStatus_e::Success;
+	}
+
+	Bool
+	computeCast(const Value_s& value, PrimitiveTypeID_e primitiveType, Value_s& result)
+	{
+		const ValueType_e type = toValueType(primitiveType);
+
+		if (isInteger(type))
+		{
+			if (isInteger(value.type))
+			{
+				result = makeInteger(type, value.integerValue);
+				return true;
+			}
+			if (isReal(value.type))
+			{
+				result = makeInteger(type, static_cast<I64>(value.realValue));
+				return true;
+			}
+			if (value.type == ValueType_e::Bool)
+			{
+				result = makeInteger(type, value.boolValue ? 1 : 0);
+				return true;
+			}
+			if (value.type == ValueType_e::String)
+			{
+				try
+				{
+					result = makeInteger(type, std::stoll(getString(value)));
+					return true;
+				}
+				catch (std::exception&)
+				{}
+			}
+		}
+		else if (isReal(type))
+		{
+			if (isNumber(value.type))
+			{
+				result = makeReal(type, toReal(value));
+				return true;
+			}
+			if (value.type == ValueType_e::String)
+			{
+				try
+				{
+					result = makeReal(type, std::stod(getString(value)));
+					return true;
+				}
+				catch (std::exception&)
+				{}
+			}
+		}
+		else if (type == ValueType_e::Bool)
+		{
+			result = makeBool(isTruthy(value));
+			return true;
+		}
+		else if (type == ValueType_e::Object)
+		{
+			result = value;
+			return true;
+		}
+		return false;
+	}
+
+	String
+	formatValue(const Value_s& value)
+	{
+		switch (value.type)
+		{
+		case ValueType_e::Null:
+			return "null";
+		case ValueType_e::Bool:
+			return value.boolValue ? "true" : "false";
+		case ValueType_e::U64:
+			return std::to_string(static_cast<U64>(value.integerValue));
+		case ValueType_e::Fp32:
+		case ValueType_e::Fp64:
+			{
+				std::stringstream ss;
+				ss << value.realValue;
+				return ss.str();
+			}
+		case ValueType_e::String:
+			return getString(value);
+		case ValueType_e::Object:
+		case ValueType_e::Array:
+		case ValueType_e::Function:
+			return getValueTypeName(value.type);
+		default:
+			return std::to_string(value.integerValue);
+		}
+	}
+
+	void
+	markValue(const Value_s& value)
+	{
+		if (!isHeapObject(value.type) || value.object->marked)
+		{
+			return;
+		}
+
+		// Usa uma pilha explicita para nao estourar a pilha nativa em estruturas profundas.
+		std::vector<HeapObject_s*> grayList;
+
+		value.object->marked = true;
+		grayList.push_back(value.object);
+
+		while (grayList.size())
+		{
+			HeapObject_s* const object = grayList.back();
+			grayList.pop_back();
+
+			const std::vector<Value_s>* valueList = nullptr;
+			if (object->type == ValueType_e::Object)
+			{
+				valueList = &static_cast<InstanceObject_s*>(object)->fieldList;
+			}
+			else if (object->type == ValueType_e::Array)
+			{
+				valueList = &static_cast<ArrayObject_s*>(object)->elementList;
+			}
+
+			if (valueList == nullptr)
+			{
+				continue;
+			}
+
+			for (auto& child : *valueList)
+			{
+				if (isHeapObject(child.type) && !child.object->marked)
+				{
+					child.object->marked = true;
+					grayList.push_back(child.object);
+				}
+			}
+		}
+	}
+
+	U32
+	sweepObjectList(HeapObject_s*& objectList)
+	{
+		U32 freedCount = 0;
+
+		// Libera os objetos nao marcados.
+		HeapObject_s** link = &objectList;
+		while (*link)
+		{
+			HeapObject_s* const object = *link;
+
+			if (object->marked)
+			{
+				object->marked = false;
+				link = &object->next;
+				continue;
+			}
+
+			*link = object->next;
+			delete object;
+			freedCount++;
+		}
+		return freedCount;
+	}
+} }
\ No newline at end of file
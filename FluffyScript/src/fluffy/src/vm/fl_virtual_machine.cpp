@@ -0,0 +1,1055 @@
+#include "vm/fl_virtual_machine.h"
+#include "fl_exceptions.h"
+
+// O despacho direct-threaded usa a extensao 'labels as values' (computed goto)
+// do gcc e do clang, nos demais compiladores o laco usa um switch.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(FL_VM_SWITCH_DISPATCH)
+#define FL_VM_THREADED_DISPATCH
+#endif
+
+namespace fluffy { namespace vm {
+	using codegen::OpCode_e;
+	using codegen::invalidIndex;
+
+	// Quantidade de registradores da pilha, compartilhada por todos os frames.
+	static constexpr const U32 maxStackSize = 1 << 18;
+
+	// Profundidade maxima de chamadas.
+	static constexpr const U32 maxCallDepth = 1 << 14;
+
+	// Quantidade de objetos alocados antes da primeira coleta.
+	static constexpr const U32 initialCollectionThreshold = 1 << 16;
+
+	/**
+	 * VirtualMachine
+	 */
+
+	VirtualMachine::VirtualMachine(codegen::BytecodeModule* const module)
+		: mModule(module)
+		, mObjectList(nullptr)
+		, mObjectCount(0)
+		, mNextCollection(initialCollectionThreshold)
+		, mInlineCacheMissCount(0)
+		, mPrepared(false)
+		, mInitialized(false)
+	{
+		// Converte as constantes do modulo uma unica vez, strings constantes nunca sao coletadas.
+		std::vector<Value_s> moduleConstantList;
+		moduleConstantList.reserve(module->getConstantCount());
+
+		for (U32 i = 0; i < module->getConstantCount(); i++)
+		{
+			const codegen::Constant_s& constant = module->getConstant(i);
+			const ValueType_e type = toValueType(constant.type);
+
+			if (type == ValueType_e::String)
+			{
+				auto stringObject = new StringObject_s(String(constant.stringValue));
+				stringObject->marked = true;
+
+				mPinnedObjectList.push_back(stringObject);
+				moduleConstantList.push_back(makeObject(stringObject));
+			}
+			else if (isReal(type))
+			{
+				moduleConstantList.push_back(makeReal(type, constant.realValue));
+			}
+			else
+			{
+				moduleConstantList.push_back(makeInteger(type, constant.integerValue));
+			}
+		}
+
+		mFunctionList.resize(module->getFunctionCount());
+		for (U32 i = 0; i < module->getFunctionCount(); i++)
+		{
+			auto& runtimeFunction = mFunctionList[i];
+			auto function = module->getFunction(i);
+
+			runtimeFunction.function = function;
+			runtimeFunction.cacheList.resize(function->code.size(), InlineCache_s { invalidIndex, invalidIndex });
+
+			// Os tratadores sao resolvidos na primeira execucao.
+			runtimeFunction.code.resize(function->code.size());
+			for (U32 pc = 0; pc < function->code.size(); pc++)
+			{
+				runtimeFunction.code[pc] = PreparedInstruction_s { nullptr, function->code[pc] };
+			}
+
+			for (auto constantIndex : function->constantList)
+			{
+				runtimeFunction.constantList.push_back(moduleConstantList[constantIndex]);
+			}
+		}
+
+		mClassList.resize(module->getClassCount());
+		for (U32 i = 0; i < module->getClassCount(); i++)
+		{
+			prepareClass(i);
+		}
+
+		mGlobalList.resize(module->getGlobalCount(), makeNull());
+		mStack.resize(maxStackSize, makeNull());
+		mFrameList.reserve(maxCallDepth);
+	}
+
+	VirtualMachine::~VirtualMachine()
+	{
+		while (mObjectList)
+		{
+			HeapObject_s* const next = mObjectList->next;
+			delete mObjectList;
+			mObjectList = next;
+		}
+
+		for (auto object : mPinnedObjectList)
+		{
+			delete object;
+		}
+	}
+
+	void
+	VirtualMachine::initialize()
+	{
+		if (mInitialized)
+		{
+			return;
+		}
+		mInitialized = true;
+
+		// Inicializa as variaveis globais de cada code unit.
+		for (auto functionIndex : mModule->getInitFunctionList())
+		{
+			call(functionIndex, {});
+		}
+	}
+
+	Value_s
+	VirtualMachine::call(const String& functionName, const std::vector<Value_s>& argumentList)
+	{
+		const U32 functionIndex = mModule->findFunction(functionName);
+
+		if (functionIndex == invalidIndex)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' not found",
+				functionName.c_str()
+			);
+		}
+		return call(functionIndex, argumentList);
+	}
+
+	Value_s
+	VirtualMachine::call(U32 functionIndex, const std::vector<Value_s>& argumentList)
+	{
+		RuntimeFunction_s* const runtimeFunction = &mFunctionList[functionIndex];
+		auto function = runtimeFunction->function;
+
+		if (argumentList.size() > function->parameterCount)
+		{
+			throw exceptions::custom_exception(
+				"Function '%s' receives %d arguments",
+				function->name.c_str(),
+				function->parameterCount
+			);
+		}
+
+		// A chamada nativa usa os registradores acima do frame atual.
+		Value_s* const top = mFrameList.empty()
+			? mStack.data()
+			: mFrameList.back().base + mFrameList.back().function->function->frameSize;
+
+		if (mFrameList.size() >= maxCallDepth || top + 1 + function->frameSize > mStack.data() + mStack.size())
+		{
+			throw exceptions::custom_exception(
+				"Stack overflow calling '%s'",
+				function->name.c_str()
+			);
+		}
+
+		top[0] = makeFunction(functionIndex);
+
+		Value_s* const base = top + 1;
+		for (U32 i = 0; i < function->frameSize; i++)
+		{
+			base[i] = i < argumentList.size() ? argumentList[i] : makeNull();
+		}
+
+		const U32 stopDepth = static_cast<U32>(mFrameList.size());
+		mFrameList.push_back(CallFrame_s { runtimeFunction, runtimeFunction->code.data(), base });
+
+		try
+		{
+			return execute(stopDepth);
+		}
+		catch (...)
+		{
+			mFrameList.resize(stopDepth);
+			throw;
+		}
+	}
+
+	Value_s
+	VirtualMachine::getGlobal(const String& globalName)
+	{
+		const U32 globalIndex = mModule->findGlobal(globalName);
+		return globalIndex != invalidIndex ? mGlobalList[globalIndex] : makeNull();
+	}
+
+	Value_s
+	VirtualMachine::makeString(String value)
+	{
+		return makeObject(allocate<StringObject_s>(std::move(value)));
+	}
+
+	String
+	VirtualMachine::toString(const Value_s& value)
+	{
+		switch (value.type)
+		{
+		case ValueType_e::Object:
+			return mClassList[static_cast<InstanceObject_s*>(value.object)->classIndex].classInfo->name;
+		case ValueType_e::Array:
+			{
+				auto& elementList = static_cast<ArrayObject_s*>(value.object)->elementList;
+
+				String result = "[";
+				for (U32 i = 0; i < elementList.size(); i++)
+				{
+					result += (i ? ", " : "") + toString(elementList[i]);
+				}
+				return result + "]";
+			}
+		case ValueType_e::Function:
+			return "<fn " + mFunctionList[value.functionIndex].function->name + ">";
+		default:
+			return formatValue(value);
+		}
+	}
+
+	void
+	VirtualMachine::collectGarbage()
+	{
+		// Marca os objetos alcancaveis pelas variaveis globais e pelos frames ativos.
+		for (auto& value : mGlobalList)
+		{
+			markValue(value);
+		}
+
+		if (mFrameList.size())
+		{
+			const Value_s* const top = mFrameList.back().base + mFrameList.back().function->function->frameSize;
+
+			for (const Value_s* value = mStack.data(); value < top; value++)
+			{
+				markValue(*value);
+			}
+		}
+
+		mObjectCount -= sweepObjectList(mObjectList);
+
+		mNextCollection = mObjectCount * 2 > initialCollectionThreshold
+			? mObjectCount * 2
+			: initialCollectionThreshold;
+	}
+
+	U32
+	VirtualMachine::getObjectCount()
+	{
+		return mObjectCount;
+	}
+
+	U64
+	VirtualMachine::getInlineCacheMissCount()
+	{
+		return mInlineCacheMissCount;
+	}
+
+	Value_s
+	VirtualMachine::execute(U32 stopDepth)
+	{
+#ifdef FL_VM_THREADED_DISPATCH
+		// Tabela na ordem de OpCode_e.
+		static const void* const dispatchTable[] = {
+			&&label_Nop,
+			&&label_LoadConst,
+			&&label_LoadInt,
+			&&label_LoadBool,
+			&&label_LoadNull,
+			&&label_Move,
+			&&label_GetGlobal,
+			&&label_SetGlobal,
+			&&label_LoadFunction,
+			&&label_GetField,
+			&&label_SetField,
+			&&label_GetIndex,
+			&&label_SetIndex,
+			&&label_GetMethod,
+			&&label_NewObject,
+			&&label_NewArray,
+			&&label_Add,
+			&&label_Sub,
+			&&label_Mul,
+			&&label_Div,
+			&&label_Mod,
+			&&label_Shl,
+			&&label_Shr,
+			&&label_BitAnd,
+			&&label_BitOr,
+			&&label_BitXor,
+			&&label_Equal,
+			&&label_NotEqual,
+			&&label_Less,
+			&&label_LessEqual,
+			&&label_Greater,
+			&&label_GreaterEqual,
+			&&label_Neg,
+			&&label_BitNot,
+			&&label_Not,
+			&&label_Cast,
+			&&label_AsType,
+			&&label_IsType,
+			&&label_Jump,
+			&&label_JumpIfFalse,
+			&&label_JumpIfTrue,
+			&&label_JumpIfNull,
+			&&label_Switch,
+			&&label_Call,
+			&&label_Return,
+			&&label_Panic
+		};
+		static_assert(sizeof(dispatchTable) / sizeof(dispatchTable[0]) == static_cast<U32>(OpCode_e::Count), "Missing opcode handler");
+
+#define VM_CASE(op)		label_##op:
+#define VM_NEXT()		instruction = ip->instruction; goto *(ip++)->handler
+#else
+		static const void* const* const dispatchTable = nullptr;
+
+#define VM_CASE(op)		case OpCode_e::op:
+#define VM_NEXT()		continue
+#endif
+
+#define VM_A()			codegen::getOperandA(instruction)
+#define VM_B()			codegen::getOperandB(instruction)
+#define VM_C()			codegen::getOperandC(instruction)
+#define VM_BX()			codegen::getOperandBx(instruction)
+#define VM_SBX()		codegen::getOperandSBx(instruction)
+#define VM_RA()			base[VM_A()]
+#define VM_RB()			base[VM_B()]
+#define VM_RC()			base[VM_C()]
+#define VM_SAVE()		frame->ip = ip
+#define VM_ERROR(msg)	VM_SAVE(); throwRuntimeError(*frame, msg)
+#define VM_LOAD_FRAME()	\
+		base = frame->base; ip = frame->ip; constants = frame->function->constantList.data()
+
+// Operacoes aritmeticas com caminho rapido para i32, o tipo das constantes inteiras.
+#define VM_ARITHMETIC(op, expr)																\
+		{																					\
+			const Value_s& lhs = VM_RB();													\
+			const Value_s& rhs = VM_RC();													\
+			if (lhs.type == ValueType_e::I32 && rhs.type == ValueType_e::I32)				\
+			{																				\
+				const I64 a = lhs.integerValue;												\
+				const I64 b = rhs.integerValue;												\
+				Value_s& target = VM_RA();													\
+				target.type = ValueType_e::I32;												\
+				target.integerValue = static_cast<I32>(expr);								\
+				VM_NEXT();																	\
+			}																				\
+			VM_SAVE();																		\
+			VM_RA() = executeArithmetic(OpCode_e::op, lhs, rhs);							\
+			VM_NEXT();																		\
+		}
+
+#define VM_COMPARISON(op, oper)																\
+		{																					\
+			const Value_s& lhs = VM_RB();													\
+			const Value_s& rhs = VM_RC();													\
+			if (lhs.type == ValueType_e::I32 && rhs.type == ValueType_e::I32)				\
+			{																				\
+				VM_RA() = makeBool(lhs.integerValue oper rhs.integerValue);					\
+				VM_NEXT();																	\
+			}																				\
+			VM_SAVE();																		\
+			VM_RA() = executeComparison(OpCode_e::op, lhs, rhs);							\
+			VM_NEXT();																		\
+		}
+
+		// Resolve os enderecos dos tratadores antes da primeira execucao.
+		if (!mPrepared)
+		{
+			for (auto& runtimeFunction : mFunctionList)
+			{
+				prepareFunction(runtimeFunction, dispatchTable);
+			}
+			mPrepared = true;
+		}
+
+		CallFrame_s* frame = &mFrameList.back();
+		Value_s* base;
+		const PreparedInstruction_s* ip;
+		const Value_s* constants;
+		codegen::Instruction instruction;
+
+		VM_LOAD_FRAME();
+
+#ifdef FL_VM_THREADED_DISPATCH
+		VM_NEXT();
+#else
+		for (;;)
+		{
+			instruction = (ip++)->instruction;
+
+			switch (codegen::getOpCode(instruction))
+			{
+#endif
+			VM_CASE(Nop)
+				VM_NEXT();
+
+			VM_CASE(LoadConst)
+				VM_RA() = constants[VM_BX()];
+				VM_NEXT();
+
+			VM_CASE(LoadInt)
+				{
+					Value_s& target = VM_RA();
+					target.type = ValueType_e::I32;
+					target.integerValue = VM_SBX();
+				}
+				VM_NEXT();
+
+			VM_CASE(LoadBool)
+				VM_RA() = makeBool(VM_B() != 0);
+				VM_NEXT();
+
+			VM_CASE(LoadNull)
+				VM_RA() = makeNull();
+				VM_NEXT();
+
+			VM_CASE(Move)
+				VM_RA() = VM_RB();
+				VM_NEXT();
+
+			VM_CASE(GetGlobal)
+				VM_RA() = mGlobalList[VM_BX()];
+				VM_NEXT();
+
+			VM_CASE(SetGlobal)
+				mGlobalList[VM_BX()] = VM_RA();
+				VM_NEXT();
+
+			VM_CASE(LoadFunction)
+				VM_RA() = makeFunction(VM_BX());
+				VM_NEXT();
+
+			VM_CASE(GetField)
+				{
+					const Value_s& object = VM_RB();
+
+					if (object.type != ValueType_e::Object)
+					{
+						VM_ERROR("Field access on " + String(getValueTypeName(object.type)));
+					}
+
+					auto instance = static_cast<InstanceObject_s*>(object.object);
+					InlineCache_s& cache = frame->function->cacheList[ip - 1 - frame->function->code.data()];
+
+					if (cache.classIndex != instance->classIndex)
+					{
+						VM_SAVE();
+						cache.index = findField(instance->classIndex, getString(constants[VM_C()]), *frame);
+						cache.classIndex = instance->classIndex;
+					}
+					VM_RA() = instance->fieldList[cache.index];
+				}
+				VM_NEXT();
+
+			VM_CASE(SetField)
+				{
+					const Value_s& object = VM_RA();
+
+					if (object.type != ValueType_e::Object)
+					{
+						VM_ERROR("Field access on " + String(getValueTypeName(object.type)));
+					}
+
+					auto instance = static_cast<InstanceObject_s*>(object.object);
+					InlineCache_s& cache = frame->function->cacheList[ip - 1 - frame->function->code.data()];
+
+					if (cache.classIndex != instance->classIndex)
+					{
+						VM_SAVE();
+						cache.index = findField(instance->classIndex, getString(constants[VM_B()]), *frame);
+						cache.classIndex = instance->classIndex;
+					}
+					instance->fieldList[cache.index] = VM_RC();
+				}
+				VM_NEXT();
+
+			VM_CASE(GetIndex)
+				{
+					const Value_s& object = VM_RB();
+					const Value_s& index = VM_RC();
+
+					if (!isInteger(index.type))
+					{
+						VM_ERROR("Index must be an integer");
+					}
+
+					if (object.type == ValueType_e::Array)
+					{
+						auto& elementList = static_cast<ArrayObject_s*>(object.object)->elementList;
+
+						if (static_cast<U64>(index.integerValue) >= elementList.size())
+						{
+							VM_ERROR("Index " + std::to_string(index.integerValue) + " out of bounds");
+						}
+						VM_RA() = elementList[index.integerValue];
+					}
+					else if (object.type == ValueType_e::String)
+					{
+						auto& value = static_cast<StringObject_s*>(object.object)->value;
+
+						if (static_cast<U64>(index.integerValue) >= value.size())
+						{
+							VM_ERROR("Index " + std::to_string(index.integerValue) + " out of bounds");
+						}
+						VM_RA() = makeInteger(ValueType_e::I8, value[index.integerValue]);
+					}
+					else
+					{
+						VM_ERROR("Index access on " + String(getValueTypeName(object.type)));
+					}
+				}
+				VM_NEXT();
+
+			VM_CASE(SetIndex)
+				{
+					const Value_s& object = VM_RA();
+					const Value_s& index = VM_RB();
+
+					if (object.type != ValueType_e::Array)
+					{
+						VM_ERROR("Index assignment on " + String(getValueTypeName(object.type)));
+					}
+
+					if (!isInteger(index.type))
+					{
+						VM_ERROR("Index must be an integer");
+					}
+
+					auto& elementList = static_cast<ArrayObject_s*>(object.object)->elementList;
+
+					if (static_cast<U64>(index.integerValue) >= elementList.size())
+					{
+						VM_ERROR("Index " + std::to_string(index.integerValue) + " out of bounds");
+					}
+					elementList[index.integerValue] = VM_RC();
+				}
+				VM_NEXT();
+
+			VM_CASE(GetMethod)
+				{
+					const Value_s object = VM_RB();
+
+					if (object.type != ValueType_e::Object)
+					{
+						VM_ERROR("Method call on " + String(getValueTypeName(object.type)));
+					}
+
+					auto instance = static_cast<InstanceObject_s*>(object.object);
+					InlineCache_s& cache = frame->function->cacheList[ip - 1 - frame->function->code.data()];
+
+					if (cache.classIndex != instance->classIndex)
+					{
+						VM_SAVE();
+						cache.index = findMethod(instance->classIndex, getString(constants[VM_C()]), *frame);
+						cache.classIndex = instance->classIndex;
+					}
+
+					base[VM_A() + 1] = object;
+					VM_RA() = makeFunction(cache.index);
+				}
+				VM_NEXT();
+
+			VM_CASE(NewObject)
+				{
+					const U32 classIndex = VM_BX();
+
+					VM_SAVE();
+					VM_RA() = makeObject(allocate<InstanceObject_s>(classIndex, static_cast<U32>(mClassList[classIndex].fieldList.size())));
+				}
+				VM_NEXT();
+
+			VM_CASE(NewArray)
+				{
+					VM_SAVE();
+					auto array = allocate<ArrayObject_s>();
+
+					const Value_s* const first = &VM_RB();
+					array->elementList.assign(first, first + VM_C());
+
+					VM_RA() = makeObject(array);
+				}
+				VM_NEXT();
+
+			VM_CASE(Add)
+				VM_ARITHMETIC(Add, a + b)
+
+			VM_CASE(Sub)
+				VM_ARITHMETIC(Sub, a - b)
+
+			VM_CASE(Mul)
+				VM_ARITHMETIC(Mul, a * b)
+
+			VM_CASE(Div)
+				{
+					// Divisao por zero e tratada no caminho lento.
+					const Value_s& lhs = VM_RB();
+					const Value_s& rhs = VM_RC();
+
+					if (lhs.type == ValueType_e::I32 && rhs.type == ValueType_e::I32 && rhs.integerValue != 0)
+					{
+						Value_s& target = VM_RA();
+						target.type = ValueType_e::I32;
+						target.integerValue = static_cast<I32>(lhs.integerValue / rhs.integerValue);
+						VM_NEXT();
+					}
+					VM_SAVE();
+					VM_RA() = executeArithmetic(OpCode_e::Div, lhs, rhs);
+				}
+				VM_NEXT();
+
+			VM_CASE(Mod)
+				{
+					const Value_s& lhs = VM_RB();
+					const Value_s& rhs = VM_RC();
+
+					if (lhs.type == ValueType_e::I32 && rhs.type == ValueType_e::I32 && rhs.integerValue != 0)
+					{
+						Value_s& target = VM_RA();
+						target.type = ValueType_e::I32;
+						target.integerValue = static_cast<I32>(lhs.integerValue % rhs.integerValue);
+						VM_NEXT();
+					}
+					VM_SAVE();
+					VM_RA() = executeArithmetic(OpCode_e::Mod, lhs, rhs);
+				}
+				VM_NEXT();
+
+			VM_CASE(Shl)
+				VM_SAVE();
+				VM_RA() = executeArithmetic(OpCode_e::Shl, VM_RB(), VM_RC());
+				VM_NEXT();
+
+			VM_CASE(Shr)
+				VM_SAVE();
+				VM_RA() = executeArithmetic(OpCode_e::Shr, VM_RB(), VM_RC());
+				VM_NEXT();
+
+			VM_CASE(BitAnd)
+				VM_ARITHMETIC(BitAnd, a & b)
+
+			VM_CASE(BitOr)
+				VM_ARITHMETIC(BitOr, a | b)
+
+			VM_CASE(BitXor)
+				VM_ARITHMETIC(BitXor, a ^ b)
+
+			VM_CASE(Equal)
+				VM_COMPARISON(Equal, ==)
+
+			VM_CASE(NotEqual)
+				VM_COMPARISON(NotEqual, !=)
+
+			VM_CASE(Less)
+				VM_COMPARISON(Less, <)
+
+			VM_CASE(LessEqual)
+				VM_COMPARISON(LessEqual, <=)
+
+			VM_CASE(Greater)
+				VM_COMPARISON(Greater, >)
+
+			VM_CASE(GreaterEqual)
+				VM_COMPARISON(GreaterEqual, >=)
+
+			VM_CASE(Neg)
+				{
+					const Value_s& value = VM_RB();
+
+					if (isInteger(value.type))
+					{
+						VM_RA() = makeInteger(value.type, static_cast<I64>(0 - static_cast<U64>(value.integerValue)));
+					}
+					else if (isReal(value.type))
+					{
+						VM_RA() = makeReal(value.type, -value.realValue);
+					}
+					else
+					{
+						VM_ERROR("Invalid operand for 'neg'");
+					}
+				}
+				VM_NEXT();
+
+			VM_CASE(BitNot)
+				{
+					const Value_s& value = VM_RB();
+
+					if (!isInteger(value.type))
+					{
+						VM_ERROR("Invalid operand for 'bitnot'");
+					}
+					VM_RA() = makeInteger(value.type, ~value.integerValue);
+				}
+				VM_NEXT();
+
+			VM_CASE(Not)
+				VM_RA() = makeBool(!isTruthy(VM_RB()));
+				VM_NEXT();
+
+			VM_CASE(Cast)
+				VM_SAVE();
+				VM_RA() = executeCast(VM_RB(), static_cast<PrimitiveTypeID_e>(VM_C()));
+				VM_NEXT();
+
+			VM_CASE(AsType)
+				{
+					const Value_s value = VM_RB();
+					VM_RA() = isInstanceOf(value, getString(constants[VM_C()])) ? value : makeNull();
+				}
+				VM_NEXT();
+
+			VM_CASE(IsType)
+				VM_RA() = makeBool(isInstanceOf(VM_RB(), getString(constants[VM_C()])));
+				VM_NEXT();
+
+			VM_CASE(Jump)
+				ip += VM_SBX();
+				VM_NEXT();
+
+			VM_CASE(JumpIfFalse)
+				{
+					const Value_s& value = VM_RA();
+
+					if (value.type == ValueType_e::Bool ? !value.boolValue : !isTruthy(value))
+					{
+						ip += VM_SBX();
+					}
+				}
+				VM_NEXT();
+
+			VM_CASE(JumpIfTrue)
+				{
+					const Value_s& value = VM_RA();
+
+					if (value.type == ValueType_e::Bool ? value.boolValue : isTruthy(value))
+					{
+						ip += VM_SBX();
+					}
+				}
+				VM_NEXT();
+
+			VM_CASE(JumpIfNull)
+				if (VM_RA().type == ValueType_e::Null)
+				{
+					ip += VM_SBX();
+				}
+				VM_NEXT();
+
+			VM_CASE(Switch)
+				{
+					const Value_s& value = VM_RA();
+
+					if (isInteger(value.type))
+					{
+						const codegen::SwitchTable_s& switchTable = frame->function->function->switchTableList[VM_BX()];
+						auto it = switchTable.offsetMap.find(value.integerValue);
+
+						ip += it != switchTable.offsetMap.end()
+							? it->second
+							: switchTable.defaultOffset;
+					}
+				}
+				VM_NEXT();
+
+			VM_CASE(Call)
+				{
+					const Value_s& callee = VM_RA();
+
+					if (callee.type != ValueType_e::Function)
+					{
+						VM_ERROR("Call on " + String(getValueTypeName(callee.type)));
+					}
+
+					RuntimeFunction_s* const target = &mFunctionList[callee.functionIndex];
+					auto function = target->function;
+
+					const U32 argumentCount = VM_B();
+					if (argumentCount > function->parameterCount)
+					{
+						VM_ERROR("Function '" + function->name + "' receives " + std::to_string(function->parameterCount) + " arguments");
+					}
+
+					// Os argumentos ja estao nos primeiros registradores do novo frame.
+					Value_s* const calleeBase = &VM_RA() + 1;
+					if (mFrameList.size() >= maxCallDepth || calleeBase + function->frameSize > mStack.data() + mStack.size())
+					{
+						VM_ERROR("Stack overflow calling '" + function->name + "'");
+					}
+
+					// Limpa os registradores restantes para que a coleta nao encontre valores antigos.
+					for (U32 i = argumentCount; i < function->frameSize; i++)
+					{
+						calleeBase[i].type = ValueType_e::Null;
+					}
+
+					VM_SAVE();
+					mFrameList.push_back(CallFrame_s { target, target->code.data(), calleeBase });
+
+					frame = &mFrameList.back();
+					VM_LOAD_FRAME();
+				}
+				VM_NEXT();
+
+			VM_CASE(Return)
+				{
+					const Value_s result = VM_B() ? VM_RA() : makeNull();
+
+					// O retorno ocupa o registrador da funcao chamada no frame anterior.
+					base[-1] = result;
+					mFrameList.pop_back();
+
+					if (mFrameList.size() == stopDepth)
+					{
+						return result;
+					}
+
+					frame = &mFrameList.back();
+					VM_LOAD_FRAME();
+				}
+				VM_NEXT();
+
+			VM_CASE(Panic)
+				VM_ERROR("panic: " + toString(VM_RA()));
+
+#ifndef FL_VM_THREADED_DISPATCH
+			default:
+				VM_ERROR("Invalid instruction");
+			}
+		}
+#endif
+
+#undef VM_CASE
+#undef VM_NEXT
+#undef VM_A
+#undef VM_B
+#undef VM_C
+#undef VM_BX
+#undef VM_SBX
+#undef VM_RA
+#undef VM_RB
+#undef VM_RC
+#undef VM_SAVE
+#undef VM_ERROR
+#undef VM_LOAD_FRAME
+#undef VM_ARITHMETIC
+#undef VM_COMPARISON
+	}
+
+	void
+	VirtualMachine::prepareFunction(RuntimeFunction_s& runtimeFunction, const void* const* dispatchTable)
+	{
+		if (dispatchTable == nullptr)
+		{
+			return;
+		}
+
+		for (auto& preparedInstruction : runtimeFunction.code)
+		{
+			preparedInstruction.handler = dispatchTable[static_cast<U32>(codegen::getOpCode(preparedInstruction.instruction))];
+		}
+	}
+
+	void
+	VirtualMachine::prepareClass(U32 classIndex)
+	{
+		auto& runtimeClass = mClassList[classIndex];
+
+		if (runtimeClass.classInfo != nullptr)
+		{
+			return;
+		}
+
+		auto classInfo = mModule->getClass(classIndex);
+
+		// Os campos e metodos da classe base sao herdados.
+		if (classInfo->baseClassIndex != invalidIndex)
+		{
+			prepareClass(classInfo->baseClassIndex);
+
+			auto& baseClass = mClassList[classInfo->baseClassIndex];
+			runtimeClass.fieldList = baseClass.fieldList;
+			runtimeClass.fieldMap = baseClass.fieldMap;
+			runtimeClass.methodMap = baseClass.methodMap;
+		}
+
+		for (auto& field : classInfo->fieldList)
+		{
+			runtimeClass.fieldMap[field] = static_cast<U32>(runtimeClass.fieldList.size());
+			runtimeClass.fieldList.push_back(field);
+		}
+
+		for (auto& method : classInfo->methodList)
+		{
+			runtimeClass.methodMap[method.name] = method.functionIndex;
+		}
+		runtimeClass.classInfo = classInfo;
+	}
+
+	Value_s
+	VirtualMachine::executeArithmetic(OpCode_e op, const Value_s& lhs, const Value_s& rhs)
+	{
+		// Concatenacao de strings.
+		if (op == OpCode_e::Add && (lhs.type == ValueType_e::String || rhs.type == ValueType_e::String))
+		{
+			return makeString(toString(lhs) + toString(rhs));
+		}
+
+		Value_s result;
+		switch (computeArithmetic(op, lhs, rhs, result))
+		{
+		case OperationStatus_e::Success:
+			return result;
+		case OperationStatus_e::DivisionByZero:
+			throwRuntimeError(mFrameList.back(), "Division by zero");
+		default:
+			throwRuntimeError(
+				mFrameList.back(),
+				String("Invalid operands for '") + codegen::getOpCodeName(op) + "': " + getValueTypeName(lhs.type) + " and " + getValueTypeName(rhs.type)
+			);
+		}
+	}
+
+	Value_s
+	VirtualMachine::executeComparison(OpCode_e op, const Value_s& lhs, const Value_s& rhs)
+	{
+		Value_s result;
+		if (computeComparison(op, lhs, rhs, result) != OperationStatus_e::Success)
+		{
+			throwRuntimeError(
+				mFrameList.back(),
+				String("Invalid operands for '") + codegen::getOpCodeName(op) + "': " + getValueTypeName(lhs.type) + " and " + getValueTypeName(rhs.type)
+			);
+		}
+		return result;
+	}
+
+	Value_s
+	VirtualMachine::executeCast(const Value_s& value, PrimitiveTypeID_e primitiveType)
+	{
+		if (primitiveType == PrimitiveTypeID_e::String)
+		{
+			return value.type == ValueType_e::String ? value : makeString(toString(value));
+		}
+
+		Value_s result;
+		if (!computeCast(value, primitiveType, result))
+		{
+			throwRuntimeError(
+				mFrameList.back(),
+				String("Invalid cast from ") + getValueTypeName(value.type) + " to " + getValueTypeName(toValueType(primitiveType))
+			);
+		}
+		return result;
+	}
+
+	Bool
+	VirtualMachine::isInstanceOf(const Value_s& value, const String& typeName)
+	{
+		if (value.type == ValueType_e::Object)
+		{
+			if (typeName == "object")
+			{
+				return true;
+			}
+
+			// Procura o nome na hierarquia da classe.
+			for (U32 classIndex = static_cast<InstanceObject_s*>(value.object)->classIndex; classIndex != invalidIndex; classIndex = mClassList[classIndex].classInfo->baseClassIndex)
+			{
+				if (mClassList[classIndex].classInfo->name == typeName)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+		return typeName == getValueTypeName(value.type);
+	}
+
+	U32
+	VirtualMachine::findField(U32 classIndex, const String& fieldName, const CallFrame_s& frame)
+	{
+		mInlineCacheMissCount++;
+
+		auto& fieldMap = mClassList[classIndex].fieldMap;
+		auto it = fieldMap.find(fieldName);
+
+		if (it == fieldMap.end())
+		{
+			throwRuntimeError(frame, "Field '" + fieldName + "' not found in '" + mClassList[classIndex].classInfo->name + "'");
+		}
+		return it->second;
+	}
+
+	U32
+	VirtualMachine::findMethod(U32 classIndex, const String& methodName, const CallFrame_s& frame)
+	{
+		mInlineCacheMissCount++;
+
+		auto& methodMap = mClassList[classIndex].methodMap;
+		auto it = methodMap.find(methodName);
+
+		if (it == methodMap.end())
+		{
+			throwRuntimeError(frame, "Method '" + methodName + "' not found in '" + mClassList[classIndex].classInfo->name + "'");
+		}
+		return it->second;
+	}
+
+	template <typename TObject, typename... TArgs>
+	TObject*
+	VirtualMachine::allocate(TArgs&&... args)
+	{
+		if (mObjectCount >= mNextCollection)
+		{
+			collectGarbage();
+		}
+
+		TObject* const object = new TObject(std::forward<TArgs>(args)...);
+		object->next = mObjectList;
+		mObjectList = object;
+		mObjectCount++;
+		return object;
+	}
+
+	void
+	VirtualMachine::throwRuntimeError(const CallFrame_s& frame, const String& message)
+	{
+		auto function = frame.function->function;
+		const size_t pc = frame.ip - frame.function->code.data();
+
+		// O ip aponta para a instrucao seguinte a que falhou.
+		const U32 line = pc > 0 && pc <= function->lineList.size()
+			? function->lineList[pc - 1]
+			: 0;
+
+		throw exceptions::custom_exception(
+			"Runtime error: %s in '%s' at line %d",
+			message.c_str(),
+			function->name.c_str(),
+			line
+		);
+	}
+} }
\ No newline at end of file
@@ -1,35 +1,158 @@
 #include <iostream>
-#include "ast\fl_ast_decl.h"
-#include "transformation\fl_transformation_resolve_include.h"
-#include "transformation\fl_transformation_resolve_types.h"
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include "ast/fl_ast_decl.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "validate/fl_validate_duplicated_nodes.h"
+#include "validate/fl_validate_class_rules.h"
+#include "validate/fl_validate_trait_rules.h"
+#include "validate/fl_validate_generic_rules.h"
+#include "server/fl_compiler_server.h"
+#include "utils/fl_build_result_utils.h"
 #include "fl_compiler.h"
 #include "fl_exceptions.h"
 
-int main()
+// fluffyc [-j N] [-b diretorio] [-o saida.json] [--skip-body] entrada...
+// fluffyc [-j N] [-b diretorio] [--skip-body] --server socket
+//
+// Compila todas as entradas em um unico lote, os arquivos incluidos por varias
+// entradas sao analisados uma vez. O resultado de cada arquivo, com os
+// diagnosticos e os tempos em microsegundos, e gravado em JSON na saida padrao
+// ou no arquivo indicado. Retorna 1 se algum arquivo tiver erro.
+//
+// Com '--server' o compilador fica em memoria atendendo as requisicoes do
+// socket local, ver server::CompilerServer.
+
+/**
+ * DriverOptions_s
+ */
+
+struct DriverOptions_s
+{
+	fluffy::U32							jobCount;
+	fluffy::String						basePath;
+	fluffy::String						outputFile;
+	fluffy::String						socketPath;
+	fluffy::Bool						skipFunctionBody;
+	std::vector<fluffy::String>			sourceFileList;
+};
+
+static void
+printUsage()
+{
+	std::cerr << "usage: fluffyc [-j N] [-b base-path] [-o output.json] [--skip-body] file..." << std::endl
+		<< "       fluffyc [-j N] [-b base-path] [--skip-body] --server socket-path" << std::endl;
+}
+
+static fluffy::Bool
+parseOptions(int argc, char* argv[], DriverOptions_s& options)
 {
+	options.jobCount = 1;
+	options.skipFunctionBody = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const fluffy::String argument = argv[i];
+		const fluffy::Bool hasValue = i + 1 < argc;
+
+		if (argument == "-j" && hasValue)
+		{
+			options.jobCount = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (argument == "-b" && hasValue)
+		{
+			options.basePath = argv[++i];
+		}
+		else if (argument == "-o" && hasValue)
+		{
+			options.outputFile = argv[++i];
+		}
+		else if (argument == "--server" && hasValue)
+		{
+			options.socketPath = argv[++i];
+		}
+		else if (argument == "--skip-body")
+		{
+			options.skipFunctionBody = true;
+		}
+		else if (!argument.empty() && argument[0] != '-')
+		{
+			options.sourceFileList.push_back(argument);
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return options.sourceFileList.empty() != options.socketPath.empty();
+}
+
+static void
+writeResult(std::ostream& stream, const DriverOptions_s& options, const std::vector<fluffy::BuildResult_s>& resultList, fluffy::U64 totalTime)
+{
+	stream << "{\"jobs\":" << options.jobCount
+		<< ",\"totalTime\":" << totalTime
+		<< ",\"files\":" << fluffy::utils::BuildResultUtils::toJson(resultList) << "}" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+	DriverOptions_s options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage();
+		return 2;
+	}
+
 	std::unique_ptr<fluffy::Compiler> compiler = std::unique_ptr<fluffy::Compiler>(new fluffy::Compiler());
 
-	compiler->initialize();
+	compiler->setNumberOfJobs(options.jobCount);
+	compiler->setSkipFunctionBody(options.skipFunctionBody);
+	compiler->initialize(options.basePath);
 	compiler->applyTransformation(new fluffy::transformations::ResolveInclude());
 	compiler->applyTransformation(new fluffy::transformations::ResolveTypes());
+	compiler->applyValidation(new fluffy::validations::DuplicatedNodes());
+	compiler->applyValidation(new fluffy::validations::TraitRules());
+	compiler->applyValidation(new fluffy::validations::GenericRules());
+	compiler->applyValidation(new fluffy::validations::ClassRules());
+
+	if (!options.socketPath.empty())
+	{
+		fluffy::server::CompilerServer server(std::move(compiler));
+		try
+		{
+			server.listen(options.socketPath);
+		}
+		catch (std::exception& e)
+		{
+			std::cerr << e.what() << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	auto resultList = compiler->buildBatch(options.sourceFileList);
+	const fluffy::U64 totalTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+	if (options.outputFile.empty())
+	{
+		writeResult(std::cout, options, resultList, totalTime);
+	}
+	else
+	{
+		std::ofstream fileStream(options.outputFile, std::ofstream::binary);
+		writeResult(fileStream, options, resultList, totalTime);
+	}
 
-	compiler->addBlockToBuild("source1",
-		"include { foo::FooOne } in \"source2\"; \n"
-		"namespace app { \n"
-			"let a: FooOne; \n"
-			"let b: subapp::FooOne; \n"
-			"namespace subapp { \n"
-				"class FooOne {} \n"
-			"} \n"
-		"} \n"
-	);
-
-	compiler->addBlockToBuild("source2",
-		"namespace foo { \n"
-			"export class FooOne {}"
-		"} \n"
-	);
-
-	compiler->build();
+	for (auto& result : resultList)
+	{
+		if (!result.success)
+		{
+			return 1;
+		}
+	}
 	return 0;
 }
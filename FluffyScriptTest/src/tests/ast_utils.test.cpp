@@ -1,9 +1,9 @@
 #include <memory>
 #include "gtest/gtest.h"
 
-#include "ast\fl_ast_decl.h"
-#include "parser\fl_parser.h"
-#include "utils\fl_ast_utils.h"
+#include "ast/fl_ast_decl.h"
+#include "parser/fl_parser.h"
+#include "utils/fl_ast_utils.h"
 #include "fl_buffer.h"
 #include "fl_exceptions.h"
 
@@ -17,7 +17,7 @@ namespace fluffy { namespace testing {
 	struct AstUtilsTest : public ::testing::Test
 	{
 		std::unique_ptr<Parser> parser;
-		parser::ParserContext_s ctx { false };
+		parser::ParserContext_s ctx;
 
 		// Sets up the test fixture.
 		virtual void SetUp()
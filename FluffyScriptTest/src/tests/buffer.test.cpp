@@ -98,6 +98,29 @@ namespace fluffy { namespace testing {
 	 * Testing
 	 */
 
+	TEST_F(LazyBufferTest, TestLoadLength)
+	{
+		String src = "test source";
+
+		// Apenas os bytes indicados sao carregados.
+		buffer->load(src.c_str(), 4);
+
+		String str;
+		while (true)
+		{
+			const I8 ch = buffer->readByte();
+
+			if (ch == '\0') {
+				break;
+			}
+			str.push_back(ch);
+
+			buffer->nextByte();
+		}
+
+		EXPECT_EQ("test", str);
+	}
+
 	TEST_F(LazyBufferTest, TestLoadAndReadDataFromFile)
 	{
 		String src = "u64 id\r\nstring identifier";
@@ -0,0 +1,164 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "types/fl_class_layout.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "validate/fl_validate_class_rules.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	using namespace types;
+
+	/**
+	 * DeclCollector
+	 */
+
+	// Coleta as classes e interfaces na ordem em que foram declaradas.
+	class DeclCollector : public scope::NodeProcessor
+	{
+	public:
+		virtual void
+		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override
+		{
+			if (event != scope::NodeProcessorEvent_e::onBegin)
+			{
+				return;
+			}
+
+			if (node->nodeType == AstNodeType_e::ClassDecl || node->nodeType == AstNodeType_e::InterfaceDecl)
+			{
+				declList.push_back(node);
+			}
+		}
+
+		std::vector<ast::AstNode*>
+		declList;
+	};
+
+	/**
+	 * ClassLayoutTest
+	 */
+
+	struct ClassLayoutTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		validations::ClassRules* classRules;
+		DeclCollector* declCollector;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+			compiler->applyTransformation(new transformations::ResolveInclude());
+			compiler->applyTransformation(new transformations::ResolveTypes());
+
+			classRules = new validations::ClassRules();
+			compiler->applyValidation(classRules);
+
+			declCollector = new DeclCollector();
+			compiler->applyValidation(declCollector);
+		}
+
+		void
+		build(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+		}
+
+		ClassLayout*
+		getLayout(U32 index) {
+			return classRules->getLayoutBuilder()->getLayout(declCollector->declList[index]->to<ast::ClassDecl>());
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(ClassLayoutTest, TestOverrideKeepsSlot)
+	{
+		build(
+			"namespace app { \n"
+				"class Base { \n"
+					"public fn first() {} \n"
+					"public fn second(a: i32) -> i32 { return a; } \n"
+				"} \n"
+				"class Derived extends Base { \n"
+					"public fn third() {} \n"
+					"public fn second(a: i32) -> i32 { return 0; } \n"
+					"public fn second(a: string) -> i32 { return 0; } \n"
+					"public static fn create() {} \n"
+				"} \n"
+			"} \n"
+		);
+
+		auto& vtable = getLayout(1)->getVTable();
+
+		// Os slots herdados vem primeiro, a sobrescrita ocupa o slot original.
+		ASSERT_EQ(vtable.size(), 4);
+		EXPECT_EQ(vtable[0].functionDecl->identifier, "first");
+		EXPECT_EQ(vtable[0].ownerDecl->identifier, "Base");
+		EXPECT_EQ(vtable[1].functionDecl->identifier, "second");
+		EXPECT_EQ(vtable[1].ownerDecl->identifier, "Derived");
+		EXPECT_EQ(vtable[2].functionDecl->identifier, "third");
+		EXPECT_EQ(vtable[3].functionDecl->identifier, "second");
+		EXPECT_EQ(vtable[3].index, 3);
+
+		// O layout da classe pai nao e alterado.
+		EXPECT_EQ(getLayout(0)->getVTable()[1].ownerDecl->identifier, "Base");
+	}
+
+	TEST_F(ClassLayoutTest, TestInterfaceTable)
+	{
+		build(
+			"namespace app { \n"
+				"interface Shape { \n"
+					"fn area() -> fp64; \n"
+					"fn name() -> string; \n"
+				"} \n"
+				"class Named { \n"
+					"public fn name() -> string { return \"\"; } \n"
+				"} \n"
+				"class Square extends Named implements Shape { \n"
+					"public fn area() -> fp64 { return 1.0; } \n"
+				"} \n"
+			"} \n"
+		);
+
+		auto interfaceDecl = declCollector->declList[0]->to<ast::InterfaceDecl>();
+		auto layout = getLayout(2);
+		auto interfaceTable = layout->findInterfaceTable(interfaceDecl);
+
+		// A implementacao herdada satisfaz a interface.
+		ASSERT_TRUE(interfaceTable != nullptr);
+		ASSERT_EQ(interfaceTable->slotList.size(), 2);
+		EXPECT_EQ(layout->getVTable()[interfaceTable->slotList[0]].ownerDecl->identifier, "Square");
+		EXPECT_EQ(layout->getVTable()[interfaceTable->slotList[1]].ownerDecl->identifier, "Named");
+		EXPECT_FALSE(layout->getVTable()[interfaceTable->slotList[0]].isAbstract);
+	}
+
+	TEST_F(ClassLayoutTest, TestGenericSubstitution)
+	{
+		build(
+			"namespace app { \n"
+				"interface Source<T> { fn next() -> T?; } \n"
+				"abstract class Reader<T> implements Source<T> { } \n"
+				"class IntReader extends Reader<i32> { \n"
+					"public fn next() -> i32? { return null; } \n"
+				"} \n"
+			"} \n"
+		);
+
+		auto layout = getLayout(2);
+
+		// 'T?' da interface e instanciado como 'i32?' no slot.
+		ASSERT_EQ(layout->getVTable().size(), 1);
+		EXPECT_FALSE(layout->getVTable()[0].isAbstract);
+		EXPECT_EQ(layout->getVTable()[0].ownerDecl->identifier, "IntReader");
+		EXPECT_EQ(classRules->getLayoutBuilder()->getTypeTable()->toString(layout->getVTable()[0].signature.returnType), "i32?");
+	}
+} }
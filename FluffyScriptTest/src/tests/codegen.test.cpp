@@ -0,0 +1,287 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "codegen/fl_code_generator.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "fl_exceptions.h"
+#include "fl_compiler.h"
+
+namespace fluffy { namespace testing {
+	using namespace codegen;
+
+	/**
+	 * CodeGeneratorTest
+	 */
+
+	struct CodeGeneratorTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		CodeGenerator* codeGenerator;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+
+			codeGenerator = new CodeGenerator();
+			compiler->applyCodeGeneration(codeGenerator);
+		}
+
+		BytecodeModule* const
+		build(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+			return codeGenerator->getModule();
+		}
+
+		static U32
+		countOpCode(BytecodeFunction_s* const function, OpCode_e op) {
+			U32 count = 0;
+			for (auto instruction : function->code) {
+				if (getOpCode(instruction) == op) {
+					count++;
+				}
+			}
+			return count;
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(CodeGeneratorTest, TestInstructionEncoding)
+	{
+		const Instruction abc = encodeABC(OpCode_e::Add, 1, 2, 255);
+		EXPECT_EQ(getOpCode(abc), OpCode_e::Add);
+		EXPECT_EQ(getOperandA(abc), 1);
+		EXPECT_EQ(getOperandB(abc), 2);
+		EXPECT_EQ(getOperandC(abc), 255);
+
+		const Instruction abx = encodeABx(OpCode_e::LoadConst, 3, maxOperandBx);
+		EXPECT_EQ(getOperandA(abx), 3);
+		EXPECT_EQ(getOperandBx(abx), maxOperandBx);
+
+		const Instruction asbx = encodeAsBx(OpCode_e::Jump, 0, -maxOperandSBx);
+		EXPECT_EQ(getOperandSBx(asbx), -maxOperandSBx);
+	}
+
+	TEST_F(CodeGeneratorTest, TestFunction)
+	{
+		auto module = build(
+			"namespace app {\n"
+				"fn fib(n: i32) -> i32 {\n"
+					"if (n < 2) { return n; }\n"
+					"return fib(n - 1) + fib(n - 2);\n"
+				"}\n"
+			"}\n"
+		);
+
+		const U32 functionIndex = module->findFunction("app::fib");
+		ASSERT_NE(functionIndex, invalidIndex);
+
+		auto function = module->getFunction(functionIndex);
+		EXPECT_EQ(function->parameterCount, 1);
+		EXPECT_FALSE(function->isMethod);
+		EXPECT_EQ(function->code.size(), function->lineList.size());
+
+		EXPECT_EQ(countOpCode(function, OpCode_e::Call), 2);
+		EXPECT_EQ(countOpCode(function, OpCode_e::Less), 1);
+		EXPECT_EQ(countOpCode(function, OpCode_e::JumpIfFalse), 1);
+		EXPECT_EQ(getOpCode(function->code.back()), OpCode_e::Return);
+
+		// O parametro e usado diretamente do seu registrador.
+		EXPECT_EQ(countOpCode(function, OpCode_e::Move), 0);
+	}
+
+	TEST_F(CodeGeneratorTest, TestDisassemble)
+	{
+		auto module = build(
+			"namespace app {\n"
+				"fn sum(a: i32, b: i32) -> i32 {\n"
+					"return a + b;\n"
+				"}\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(module->disassemble(module->findFunction("app::sum")),
+			"app::sum params: 2 frame: 3\n"
+			"0000 add 2 0 1\n"
+			"0001 return 2 1\n"
+			"0002 return 0 0\n"
+		);
+	}
+
+	TEST_F(CodeGeneratorTest, TestLoop)
+	{
+		auto module = build(
+			"namespace app {\n"
+				"fn count() -> i32 {\n"
+					"let total = 0;\n"
+					"for let i = 0; i < 10; i++ {\n"
+						"if (i == 5) { continue; }\n"
+						"if (i == 8) { break; }\n"
+						"total += i;\n"
+					"}\n"
+					"return total;\n"
+				"}\n"
+			"}\n"
+		);
+
+		auto function = module->getFunction(module->findFunction("app::count"));
+
+		// Todos os saltos apontam para dentro da funcao.
+		for (U32 pc = 0; pc < function->code.size(); pc++)
+		{
+			const OpCode_e op = getOpCode(function->code[pc]);
+
+			if (op == OpCode_e::Jump || op == OpCode_e::JumpIfFalse || op == OpCode_e::JumpIfTrue)
+			{
+				const I32 targetPc = static_cast<I32>(pc) + 1 + getOperandSBx(function->code[pc]);
+				EXPECT_GE(targetPc, 0);
+				EXPECT_LE(targetPc, static_cast<I32>(function->code.size()));
+			}
+		}
+		EXPECT_EQ(countOpCode(function, OpCode_e::Add), 2);
+	}
+
+	TEST_F(CodeGeneratorTest, TestConstantPool)
+	{
+		auto module = build(
+			"namespace app {\n"
+				"let greeting = \"hello\";\n"
+				"fn a() -> string { return \"hello\"; }\n"
+				"fn b() -> fp64 { return 1.5 + 1.5; }\n"
+				"fn c() -> i32 { return 100000; }\n"
+			"}\n"
+		);
+
+		// Constantes iguais sao compartilhadas pelo modulo e por funcao.
+		auto functionA = module->getFunction(module->findFunction("app::a"));
+		auto functionB = module->getFunction(module->findFunction("app::b"));
+		auto functionC = module->getFunction(module->findFunction("app::c"));
+
+		ASSERT_EQ(functionA->constantList.size(), 1);
+		ASSERT_EQ(functionB->constantList.size(), 1);
+		ASSERT_EQ(functionC->constantList.size(), 1);
+
+		EXPECT_EQ(module->getConstant(functionA->constantList[0]).stringValue, "hello");
+		EXPECT_EQ(module->getConstant(functionB->constantList[0]).realValue, 1.5);
+		EXPECT_EQ(module->getConstant(functionC->constantList[0]).integerValue, 100000);
+
+		EXPECT_EQ(module->getConstantCount(), 3);
+
+		// A variavel global e inicializada pela funcao de inicializacao do code unit.
+		ASSERT_EQ(module->getInitFunctionList().size(), 1);
+		auto initFunction = module->getFunction(module->getInitFunctionList()[0]);
+		EXPECT_EQ(countOpCode(initFunction, OpCode_e::SetGlobal), 1);
+		EXPECT_NE(module->findGlobal("app::greeting"), invalidIndex);
+	}
+
+	TEST_F(CodeGeneratorTest, TestClass)
+	{
+		auto module = build(
+			"namespace app {\n"
+				"class Base {\n"
+					"public let value: i32 = 1;\n"
+					"public fn get() -> i32 { return value; }\n"
+				"}\n"
+				"class Derived extends Base {\n"
+					"public let extra: i32;\n"
+					"public constructor(extra: i32) { this.extra = extra; }\n"
+					"public fn get() -> i32 { return super.get() + extra; }\n"
+				"}\n"
+				"fn main() -> i32 {\n"
+					"let d = new Derived(2);\n"
+					"return d.get();\n"
+				"}\n"
+			"}\n"
+		);
+
+		const U32 baseIndex = module->findClass("app::Base");
+		const U32 derivedIndex = module->findClass("app::Derived");
+		ASSERT_NE(baseIndex, invalidIndex);
+		ASSERT_NE(derivedIndex, invalidIndex);
+
+		auto derived = module->getClass(derivedIndex);
+		EXPECT_EQ(derived->baseClassIndex, baseIndex);
+		EXPECT_EQ(derived->fieldList.size(), 1);
+		EXPECT_EQ(derived->constructorList.size(), 1);
+		EXPECT_EQ(module->findMethod(derivedIndex, "get"), module->findFunction("app::Derived::get"));
+
+		auto method = module->getFunction(module->findFunction("app::Derived::get"));
+		EXPECT_TRUE(method->isMethod);
+		EXPECT_EQ(method->parameterCount, 1);
+
+		// A chamada ao super e resolvida estaticamente.
+		EXPECT_EQ(countOpCode(method, OpCode_e::LoadFunction), 1);
+		EXPECT_EQ(countOpCode(method, OpCode_e::GetField), 1);
+
+		auto main = module->getFunction(module->findFunction("app::main"));
+		EXPECT_EQ(countOpCode(main, OpCode_e::NewObject), 1);
+		EXPECT_EQ(countOpCode(main, OpCode_e::GetMethod), 1);
+		EXPECT_EQ(countOpCode(main, OpCode_e::Call), 3);
+	}
+
+	TEST_F(CodeGeneratorTest, TestEnum)
+	{
+		auto module = build(
+			"namespace app {\n"
+				"enum Color { Red, Green = 10, Blue }\n"
+				"fn blue() -> i32 { return Color::Blue as i32; }\n"
+			"}\n"
+		);
+
+		auto function = module->getFunction(module->findFunction("app::blue"));
+		ASSERT_EQ(getOpCode(function->code[0]), OpCode_e::LoadInt);
+		EXPECT_EQ(getOperandSBx(function->code[0]), 11);
+	}
+
+	TEST_F(CodeGeneratorTest, TestMatchSwitch)
+	{
+		auto module = build(
+			"namespace app {\n"
+				"fn small(value: i32) -> i32 {\n"
+					"return match value { when 1 -> 10, when 2 -> 20, when _ -> 0 };\n"
+				"}\n"
+				"fn large(value: i32) -> i32 {\n"
+					"return match value { when 1 -> 10, when 2 -> 20, when 3 -> 30, when 4 -> 40, when _ -> 0 };\n"
+				"}\n"
+			"}\n"
+		);
+
+		// Apenas matches com ao menos quatro inteiros usam a tabela de saltos.
+		auto small = module->getFunction(module->findFunction("app::small"));
+		EXPECT_EQ(countOpCode(small, OpCode_e::Switch), 0);
+
+		auto large = module->getFunction(module->findFunction("app::large"));
+		ASSERT_EQ(countOpCode(large, OpCode_e::Switch), 1);
+		ASSERT_EQ(large->switchTableList.size(), 1);
+		EXPECT_EQ(large->switchTableList[0].offsetMap.size(), 4);
+	}
+
+	TEST_F(CodeGeneratorTest, TestUnresolvedIdentifier)
+	{
+		EXPECT_THROW(
+			build(
+				"namespace app {\n"
+					"fn main() { let a = b; }\n"
+				"}\n"
+			),
+			exceptions::custom_exception
+		);
+	}
+
+	TEST_F(CodeGeneratorTest, TestBreakOutsideLoop)
+	{
+		EXPECT_THROW(
+			build(
+				"namespace app {\n"
+					"fn main() { break; }\n"
+				"}\n"
+			),
+			exceptions::custom_exception
+		);
+	}
+} }
\ No newline at end of file
@@ -2,16 +2,19 @@
 #include "test.h"
 #include "gtest/gtest.h"
 
-#include "ast\fl_ast.h"
-#include "ast\fl_ast_decl.h"
-#include "ast\fl_ast_stmt.h"
-#include "ast\fl_ast_expr.h"
-#include "transformation\fl_transformation_resolve_include.h"
-#include "transformation\fl_transformation_resolve_types.h"
-#include "validate\fl_validate_duplicated_nodes.h"
-#include "validate\fl_validate_class_rules.h"
-#include "validate\fl_validate_generic_rules.h"
-#include "validate\fl_validate_trait_rules.h"
+#include "ast/fl_ast.h"
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_expr.h"
+#include "attributes/fl_deferred_function_body.h"
+#include "attributes/fl_reference.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "scope/fl_scope_manager.h"
+#include "validate/fl_validate_duplicated_nodes.h"
+#include "validate/fl_validate_class_rules.h"
+#include "validate/fl_validate_generic_rules.h"
+#include "validate/fl_validate_trait_rules.h"
 #include "fl_exceptions.h"
 #include "fl_compiler.h"
 
@@ -48,4 +51,162 @@ namespace fluffy { namespace testing {
 		compiler->build("main.txt");
 	}
 
+	TEST_F(CompilerTest, TestBuildBatch)
+	{
+		String path = _BASE_PATH;
+		compiler->setNumberOfJobs(2);
+		// O separador '/' tambem e aceito no Windows.
+		compiler->initialize(path + "/files/compiler/batch/");
+		compiler->applyTransformation(new transformations::ResolveInclude());
+		compiler->applyTransformation(new transformations::ResolveTypes());
+
+		auto resultList = compiler->buildBatch({ "entry_one.txt", "entry_two.txt", "entry_error.txt", "entry_dependent.txt" });
+
+		// As entradas vem primeiro, o arquivo incluido por todas aparece uma vez.
+		ASSERT_EQ(resultList.size(), 5);
+		EXPECT_TRUE(resultList[0].isEntry);
+		EXPECT_TRUE(resultList[0].success);
+		EXPECT_TRUE(resultList[1].success);
+		EXPECT_FALSE(resultList[4].isEntry);
+		EXPECT_TRUE(resultList[4].success);
+		EXPECT_NE(resultList[4].sourceFile.find("common.txt"), String::npos);
+
+		// O erro fica no arquivo e em quem o inclui, sem interromper o lote.
+		EXPECT_FALSE(resultList[2].success);
+		EXPECT_NE(resultList[2].error.find("Missing"), String::npos);
+		EXPECT_FALSE(resultList[3].success);
+		EXPECT_NE(resultList[3].error.find("entry_error.txt"), String::npos);
+	}
+
+	TEST_F(CompilerTest, TestSkipFunctionBody)
+	{
+		class CheckResult : public scope::NodeProcessor
+		{
+		public:
+			CheckResult(Bool requireBody)
+				: requireBody(requireBody)
+			{}
+
+			virtual ~CheckResult()
+			{}
+
+			virtual void
+			onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override
+			{
+				if (event != scope::NodeProcessorEvent_e::onBegin)
+				{
+					return;
+				}
+
+				if (node->nodeType == AstNodeType_e::FunctionDecl)
+				{
+					auto functionDecl = node->to<ast::FunctionDecl>();
+					ASSERT_EQ(functionDecl->blockDecl->needParse, !requireBody);
+					passes++;
+				}
+
+				if (node->nodeType == AstNodeType_e::StmtVariable)
+				{
+					auto stmtVariable = node->to<ast::stmt::StmtVariableDecl>();
+					ASSERT_NE(stmtVariable->typeDecl->getAttribute<attributes::Reference>(), nullptr);
+					passes++;
+				}
+			}
+
+			virtual Bool
+			requireFunctionBody() override
+			{
+				return requireBody;
+			}
+
+			Bool requireBody;
+			U32 passes = 0;
+		};
+
+		auto declarationCheck = new CheckResult(false);
+		auto bodyCheck = new CheckResult(true);
+
+		compiler->setSkipFunctionBody(true);
+		compiler->initialize();
+		compiler->applyValidation(declarationCheck);
+		compiler->applyValidation(new validations::ClassRules());
+		compiler->applyTransformation(new transformations::ResolveTypes());
+		compiler->applyValidation(bodyCheck);
+
+		compiler->addBlockToBuild("source1",
+			"namespace app { \n"
+				"class Foo {}"
+				"fn main() { let a: Foo = null; } \n"
+			"} \n"
+		);
+
+		compiler->build();
+
+		EXPECT_EQ(declarationCheck->passes, 1);
+		EXPECT_EQ(bodyCheck->passes, 2);
+
+		// Todos os corpos foram processados, o parser ja foi liberado.
+		auto deferredFunctionBody = compiler->getExecutionTree()[0]->getAttribute<attributes::DeferredFunctionBody>();
+		ASSERT_NE(deferredFunctionBody, nullptr);
+		EXPECT_FALSE(deferredFunctionBody->hasPendingFunctionBody());
+	}
+
+	TEST_F(CompilerTest, TestParallelFunctionBody)
+	{
+		class CheckResult : public scope::NodeProcessor
+		{
+		public:
+			CheckResult()
+			{}
+
+			virtual ~CheckResult()
+			{}
+
+			virtual void
+			onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override
+			{
+				if (event != scope::NodeProcessorEvent_e::onBegin)
+				{
+					return;
+				}
+
+				if (node->nodeType == AstNodeType_e::FunctionDecl)
+				{
+					auto functionDecl = node->to<ast::FunctionDecl>();
+					const U32 index = static_cast<U32>(atoi(functionDecl->identifier.str() + 1));
+
+					ASSERT_EQ(functionDecl->blockDecl->needParse, false);
+					ASSERT_EQ(functionDecl->blockDecl->stmtList.size(), index % 7 + 2);
+					passes++;
+				}
+			}
+
+			U32 passes = 0;
+		};
+
+		auto check = new CheckResult();
+
+		compiler->setNumberOfJobs(4);
+		compiler->setParallelFunctionBody(true);
+		compiler->initialize();
+		compiler->applyValidation(check);
+
+		// Gera funcoes com quantidades diferentes de declaracoes.
+		String sourceCode = "namespace app { \n";
+		for (U32 i = 0; i < 64; i++)
+		{
+			sourceCode += "fn f" + std::to_string(i) + "() { ";
+			for (U32 j = 0; j < i % 7 + 1; j++)
+			{
+				sourceCode += "let a" + std::to_string(j) + " = " + std::to_string(j) + " * (2 + " + std::to_string(i) + "); ";
+			}
+			sourceCode += "if (true) { return 1; } } \n";
+		}
+		sourceCode += "} \n";
+
+		compiler->addBlockToBuild("source1", sourceCode);
+		compiler->build();
+
+		EXPECT_EQ(check->passes, 64);
+	}
 } }
\ No newline at end of file
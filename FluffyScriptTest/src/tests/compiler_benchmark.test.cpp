@@ -0,0 +1,305 @@
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include "test.h"
+#include "source_generator.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "lexer/fl_lexer.h"
+#include "parser/fl_parser.h"
+#include "profiler/fl_profiler.h"
+#include "interpreter/fl_slot_resolver.h"
+#include "ir/fl_ir_builder.h"
+#include "ir/fl_ir_constant_propagation.h"
+#include "ir/fl_ir_dead_code_elimination.h"
+#include "ir/fl_ir_common_subexpression_elimination.h"
+#include "ir/fl_ir_inliner.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "utils/fl_info_util.h"
+#include "fl_buffer.h"
+#include "fl_compiler.h"
+
+// Os benchmarks ficam desabilitados na execucao normal dos testes, para executa-los:
+// tests --gtest_also_run_disabled_tests --gtest_filter=CompilerBenchmark.*
+//
+// Os resultados sao gravados em 'compiler_benchmark.json' ou no arquivo indicado
+// pela variavel de ambiente 'FLUFFY_BENCHMARK_OUTPUT', para comparar com a base.
+namespace fluffy { namespace testing {
+	/**
+	 * BenchmarkResult_s
+	 */
+
+	struct BenchmarkResult_s
+	{
+		String								name;
+		String								unit;
+		U32									size;
+		U64									count;
+		Fp64								seconds;
+	};
+
+	/**
+	 * CompilerBenchmark
+	 */
+
+	struct CompilerBenchmark : public ::testing::Test
+	{
+		static std::vector<BenchmarkResult_s> resultList;
+
+		// Tamanhos usados por todos os geradores.
+		static constexpr const U32 sizeList[] = { 10, 100, 1000 };
+
+		// Apos o ultimo benchmark
+		static void TearDownTestSuite() {
+			if (resultList.empty())
+			{
+				return;
+			}
+
+			String filename = "compiler_benchmark.json";
+			size_t strSize = 0;
+			getenv_s(&strSize, nullptr, 0, "FLUFFY_BENCHMARK_OUTPUT");
+
+			if (strSize != 0)
+			{
+				filename.resize(strSize);
+				getenv_s(&strSize, const_cast<I8*>(filename.c_str()), strSize, "FLUFFY_BENCHMARK_OUTPUT");
+				filename.resize(strSize - 1);
+			}
+
+			std::ofstream fileStream(filename, std::ofstream::binary);
+			fileStream << "{\"benchmarks\":[";
+
+			for (size_t i = 0; i < resultList.size(); i++)
+			{
+				const BenchmarkResult_s& result = resultList[i];
+
+				fileStream << (i ? ",\n" : "\n")
+					<< "{\"name\":\"" << result.name << "\""
+					<< ",\"size\":" << result.size
+					<< ",\"count\":" << result.count
+					<< ",\"unit\":\"" << result.unit << "/s\""
+					<< ",\"rate\":" << std::fixed << std::setprecision(1) << result.count / result.seconds
+					<< ",\"ms\":" << std::setprecision(3) << result.seconds * 1000.0 << "}";
+			}
+			fileStream << "\n]}\n";
+			resultList.clear();
+		}
+
+		// Executa o corpo ate somar ao menos 200ms e 3 execucoes, reporta a melhor.
+		static void
+		measure(const String& name, const I8* unit, U32 size, const std::function<U64()>& body) {
+			Fp64 bestSeconds = 0.0;
+			Fp64 totalSeconds = 0.0;
+			U64 count = 0;
+
+			for (U32 iteration = 0; iteration < 3 || totalSeconds < 0.2; iteration++)
+			{
+				const auto start = std::chrono::steady_clock::now();
+				count = body();
+				const auto end = std::chrono::steady_clock::now();
+
+				const Fp64 seconds = std::chrono::duration<Fp64>(end - start).count();
+				bestSeconds = iteration == 0 || seconds < bestSeconds ? seconds : bestSeconds;
+				totalSeconds += seconds;
+			}
+
+			std::cout << "[ BENCH    ] " << std::left << std::setw(32) << name + "/" + std::to_string(size)
+				<< std::right << std::setw(14) << std::fixed << std::setprecision(0) << count / bestSeconds << " " << unit << "/sec"
+				<< " (" << std::setprecision(3) << bestSeconds * 1000.0 << " ms)" << std::endl;
+
+			resultList.push_back({ name, unit, size, count, bestSeconds });
+		}
+
+		static U64
+		lex(const String& sourceCode) {
+			lexer::Lexer lexer(new DirectBuffer());
+			lexer.loadSource("benchmark", sourceCode.c_str());
+
+			while (!lexer.isEof())
+			{
+				lexer.nextToken();
+			}
+			return lexer.getTokenCount();
+		}
+
+		static U64
+		parse(const String& sourceCode) {
+			const U64 nodeCount = utils::InfoUtil::getThreadNodeCount();
+
+			parser::ParserContext_s context;
+			auto parser = std::make_unique<parser::Parser>(new DirectBuffer());
+
+			parser->loadSource("benchmark", sourceCode.c_str());
+			auto codeUnit = parser->parseCodeUnit(context);
+
+			return utils::InfoUtil::getThreadNodeCount() - nodeCount;
+		}
+
+		// Compila os blocos resolvendo includes e tipos, retorna o numero de buscas.
+		static U64
+		build(const std::vector<SourceBlock_s>& blockList, Fp64* lookupSeconds = nullptr) {
+			profiler::Profiler buildProfiler;
+
+			auto compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+			compiler->setProfiler(&buildProfiler);
+			compiler->applyTransformation(new transformations::ResolveInclude());
+			compiler->applyTransformation(new transformations::ResolveTypes());
+
+			for (auto& block : blockList)
+			{
+				compiler->addBlockToBuild(block.name, block.sourceCode);
+			}
+			compiler->build();
+
+			U64 lookupCount = 0;
+			U64 lookupTime = 0;
+
+			for (auto& stats : buildProfiler.getStatsList())
+			{
+				if (stats.phase == profiler::findNodeByIdPhase)
+				{
+					lookupCount += stats.callCount;
+					lookupTime += stats.totalTime;
+				}
+			}
+
+			if (lookupSeconds != nullptr)
+			{
+				*lookupSeconds = lookupTime / 1000000.0;
+			}
+			return lookupCount;
+		}
+	};
+
+	std::vector<BenchmarkResult_s> CompilerBenchmark::resultList;
+	constexpr const U32 CompilerBenchmark::sizeList[];
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(CompilerBenchmark, DISABLED_Lexer)
+	{
+		for (auto size : sizeList)
+		{
+			const String wideClasses = SourceGenerator::wideClasses(size, 10);
+			const String expressionChain = SourceGenerator::expressionChain(size, 50);
+
+			measure("lexer/wide_classes", "tokens", size, [&]() { return lex(wideClasses); });
+			measure("lexer/expression_chain", "tokens", size, [&]() { return lex(expressionChain); });
+		}
+	}
+
+	TEST_F(CompilerBenchmark, DISABLED_Parser)
+	{
+		for (auto size : sizeList)
+		{
+			const String deepNamespaces = SourceGenerator::deepNamespaces(size);
+			const String wideClasses = SourceGenerator::wideClasses(size, 10);
+			const String expressionChain = SourceGenerator::expressionChain(size, 50);
+			const String heavyGenerics = SourceGenerator::heavyGenerics(size);
+
+			measure("parser/deep_namespaces", "nodes", size, [&]() { return parse(deepNamespaces); });
+			measure("parser/wide_classes", "nodes", size, [&]() { return parse(wideClasses); });
+			measure("parser/expression_chain", "nodes", size, [&]() { return parse(expressionChain); });
+			measure("parser/heavy_generics", "nodes", size, [&]() { return parse(heavyGenerics); });
+		}
+	}
+
+	TEST_F(CompilerBenchmark, DISABLED_ParserFiles)
+	{
+		// Arquivos dos testes funcionais do parser com code units completos, os
+		// demais contem apenas tipos, expressoes ou classes soltas.
+		for (U32 i : { 5, 6 })
+		{
+			const String filename = getProjectFilePath(("files\\parser\\source_" + std::to_string(i) + ".txt").c_str());
+
+			measure("parser/file_" + std::to_string(i), "nodes", i, [&]() {
+				const U64 nodeCount = utils::InfoUtil::getThreadNodeCount();
+
+				parser::ParserContext_s context;
+				auto parser = std::make_unique<parser::Parser>(new DirectBuffer());
+
+				parser->loadSourceFromFile(filename.c_str());
+				auto codeUnit = parser->parseCodeUnit(context);
+
+				return utils::InfoUtil::getThreadNodeCount() - nodeCount;
+			});
+		}
+	}
+
+	TEST_F(CompilerBenchmark, DISABLED_ScopeLookup)
+	{
+		for (auto size : sizeList)
+		{
+			const std::vector<SourceBlock_s> blockList = { { "benchmark", SourceGenerator::deepNamespaces(size) } };
+			Fp64 lookupSeconds = 0.0;
+			U64 lookupCount = 0;
+
+			// So o tempo das buscas entra na taxa.
+			for (U32 iteration = 0; iteration < 3; iteration++)
+			{
+				Fp64 seconds = 0.0;
+				lookupCount = build(blockList, &seconds);
+				lookupSeconds = iteration == 0 || seconds < lookupSeconds ? seconds : lookupSeconds;
+			}
+
+			std::cout << "[ BENCH    ] " << std::left << std::setw(32) << "lookup/deep_namespaces/" + std::to_string(size)
+				<< std::right << std::setw(14) << std::fixed << std::setprecision(0) << lookupCount / lookupSeconds << " lookups/sec"
+				<< " (" << std::setprecision(3) << lookupSeconds * 1000.0 << " ms)" << std::endl;
+
+			resultList.push_back({ "lookup/deep_namespaces", "lookups", size, lookupCount, lookupSeconds });
+		}
+	}
+
+	TEST_F(CompilerBenchmark, DISABLED_Build)
+	{
+		for (auto size : sizeList)
+		{
+			const std::vector<SourceBlock_s> wideClasses = { { "benchmark", SourceGenerator::wideClasses(size, 10) } };
+			const std::vector<SourceBlock_s> heavyGenerics = { { "benchmark", SourceGenerator::heavyGenerics(size) } };
+			const std::vector<SourceBlock_s> manyIncludes = SourceGenerator::manyIncludes(size / 10 + 1, 10);
+
+			// Uma compilacao por execucao, a taxa e o inverso da latencia.
+			measure("build/wide_classes", "builds", size, [&]() { build(wideClasses); return 1; });
+			measure("build/heavy_generics", "builds", size, [&]() { build(heavyGenerics); return 1; });
+			measure("build/many_includes", "builds", size, [&]() { build(manyIncludes); return 1; });
+		}
+	}
+
+	TEST_F(CompilerBenchmark, DISABLED_IrPasses)
+	{
+		for (auto size : sizeList)
+		{
+			auto compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+
+			auto slotResolver = new interpreter::SlotResolver();
+			compiler->applyTransformation(slotResolver);
+			compiler->addBlockToBuild("benchmark", SourceGenerator::expressionChain(size, 50));
+			compiler->build();
+
+			// Os passos alteram o modulo, cada execucao gera o IR novamente.
+			measure("ir/passes", "instructions", size, [&]() {
+				auto module = ir::IrBuilder(slotResolver->getProgram()).build();
+				const U64 instructionCount = module->getInstructionCount();
+
+				ir::PassManager passManager;
+				passManager.addPass(std::make_unique<ir::Inliner>());
+				passManager.addPass(std::make_unique<ir::ConstantPropagation>());
+				passManager.addPass(std::make_unique<ir::CommonSubexpressionElimination>());
+				passManager.addPass(std::make_unique<ir::DeadCodeElimination>());
+				passManager.run(module.get());
+
+				return instructionCount;
+			});
+		}
+	}
+} }
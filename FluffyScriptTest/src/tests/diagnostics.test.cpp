@@ -0,0 +1,175 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "diagnostics/fl_diagnostics.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "validate/fl_validate_duplicated_nodes.h"
+#include "validate/fl_validate_class_rules.h"
+#include "validate/fl_validate_match_rules.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	/**
+	 * DiagnosticsTest
+	 */
+
+	struct DiagnosticsTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		diagnostics::DiagnosticEngine engine;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->applyTransformation(new transformations::ResolveInclude());
+			compiler->applyTransformation(new transformations::ResolveTypes());
+			compiler->applyValidation(new validations::DuplicatedNodes());
+			compiler->applyValidation(new validations::ClassRules());
+			compiler->setDiagnosticEngine(&engine);
+		}
+
+		ast::NamespaceDecl*
+		getNamespace(U32 index) {
+			return compiler->getExecutionTree()[index]->namespaceDeclList[0].get();
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(DiagnosticsTest, TestCollectMultipleErrors)
+	{
+		compiler->addBlockToBuild("source1",
+			"namespace app { \n"
+				"class Foo { let a: Bar; let b: Zoo; } \n"
+				"class Foo {} \n"
+			"} \n"
+		);
+		compiler->build();
+
+		auto diagnosticList = engine.getDiagnosticList();
+		ASSERT_EQ(diagnosticList.size(), 3);
+		EXPECT_EQ(engine.getErrorCount(), 3);
+
+		EXPECT_EQ(diagnosticList[0].code, diagnostics::DiagnosticCode_e::IdentifierNotFound);
+		EXPECT_EQ(diagnosticList[1].code, diagnostics::DiagnosticCode_e::IdentifierNotFound);
+		EXPECT_EQ(diagnosticList[2].code, diagnostics::DiagnosticCode_e::DuplicatedIdentifier);
+
+		// O texto e o mesmo das excecoes lancadas sem o motor.
+		EXPECT_EQ(diagnostics::DiagnosticEngine::format(diagnosticList[0]), "source1 error: Identifier 'Bar' not found in scope at: line 2, column 20");
+		EXPECT_EQ(diagnostics::DiagnosticEngine::format(diagnosticList[1]), "source1 error: Identifier 'Zoo' not found in scope at: line 2, column 32");
+		EXPECT_EQ(diagnosticList[2].node->identifier, "Foo");
+	}
+
+	TEST_F(DiagnosticsTest, TestParserRecoverDeclaration)
+	{
+		compiler->addBlockToBuild("source1",
+			"namespace app { \n"
+				"class Foo { let a: i32 } \n"
+				"fn valid() {} \n"
+				"class 10 {} \n"
+				"class Bar {} \n"
+			"} \n"
+		);
+		compiler->build();
+
+		auto diagnosticList = engine.getDiagnosticList();
+		ASSERT_EQ(diagnosticList.size(), 2);
+		EXPECT_EQ(diagnosticList[0].code, diagnostics::DiagnosticCode_e::ExpectedToken);
+		EXPECT_EQ(diagnosticList[1].code, diagnostics::DiagnosticCode_e::ExpectedIdentifier);
+		EXPECT_EQ(diagnosticList[0].line, 2);
+		EXPECT_EQ(diagnosticList[1].line, 4);
+
+		// Os erros do parser sao registrados onde ocorrem, com os argumentos separados da mensagem.
+		EXPECT_EQ(diagnostics::DiagnosticEngine::format(diagnosticList[0]), "source1 error: Expected token ';', received '}' at: line 2, column 24");
+		EXPECT_EQ(diagnosticList[1].argList[0], "10");
+
+		// As declaracoes validas continuam na arvore, ao lado dos nos de erro.
+		auto namespaceDecl = getNamespace(0);
+		ASSERT_EQ(namespaceDecl->generalDeclList.size(), 4);
+		EXPECT_EQ(namespaceDecl->generalDeclList[0]->nodeType, AstNodeType_e::ErrorDecl);
+		EXPECT_EQ(namespaceDecl->generalDeclList[1]->identifier, "valid");
+		EXPECT_EQ(namespaceDecl->generalDeclList[2]->nodeType, AstNodeType_e::ErrorDecl);
+		EXPECT_EQ(namespaceDecl->generalDeclList[3]->identifier, "Bar");
+	}
+
+	TEST_F(DiagnosticsTest, TestParserRecoverFunctionBody)
+	{
+		compiler->setSkipFunctionBody(true);
+		compiler->addBlockToBuild("source1",
+			"namespace app { \n"
+				"fn foo() { let a = ; } \n"
+				"fn bar() { let b = 1; } \n"
+			"} \n"
+		);
+		compiler->build();
+
+		ASSERT_EQ(engine.getErrorCount(), 1);
+		EXPECT_EQ(engine.getDiagnosticList()[0].line, 2);
+		EXPECT_EQ(getNamespace(0)->generalDeclList.size(), 2);
+	}
+
+	TEST_F(DiagnosticsTest, TestErrorLimit)
+	{
+		engine.setErrorLimit(2);
+
+		compiler->addBlockToBuild("source1",
+			"namespace app { \n"
+				"class Foo { let a: A; let b: B; let c: C; let d: D; } \n"
+			"} \n"
+		);
+		compiler->build();
+
+		EXPECT_TRUE(engine.isErrorLimitReached());
+		EXPECT_EQ(engine.getDiagnosticList().size(), 2);
+		EXPECT_EQ(engine.getErrorCount(), 4);
+	}
+
+	TEST_F(DiagnosticsTest, TestWarning)
+	{
+		compiler->applyValidation(new validations::MatchRules());
+		compiler->addBlockToBuild("source1",
+			"namespace app { \n"
+				"enum Color { Red, Green, Blue } \n"
+				"fn name(color: i32) { \n"
+					"match color { when Color::Red -> {}, when Color::Blue -> {} } \n"
+				"} \n"
+			"} \n"
+		);
+		compiler->build();
+
+		// Avisos sao registrados mas nao contam como erros.
+		auto diagnosticList = engine.getDiagnosticList();
+		ASSERT_EQ(diagnosticList.size(), 1);
+		EXPECT_FALSE(engine.hasErrors());
+
+		EXPECT_EQ(diagnosticList[0].code, diagnostics::DiagnosticCode_e::NonExhaustiveMatch);
+		EXPECT_EQ(diagnosticList[0].severity, diagnostics::DiagnosticSeverity_e::Warning);
+		EXPECT_EQ(diagnostics::DiagnosticEngine::format(diagnosticList[0]), "source1 warning: Non-exhaustive match, missing: Color::Green at: line 4, column 1");
+	}
+
+	TEST_F(DiagnosticsTest, TestThrowWithoutEngine)
+	{
+		compiler->setDiagnosticEngine(nullptr);
+		compiler->addBlockToBuild("source1",
+			"namespace app { \n"
+				"class Foo { let a: Bar; let b: Zoo; } \n"
+			"} \n"
+		);
+
+		try
+		{
+			compiler->build();
+			FAIL() << "Unexpected result";
+		}
+		catch (exceptions::custom_exception& e)
+		{
+			ASSERT_STREQ(e.what(), "source1 error: Identifier 'Bar' not found in scope at: line 2, column 20");
+		}
+	}
+} }
@@ -0,0 +1,131 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_type.h"
+#include "attributes/fl_reference.h"
+#include "generics/fl_monomorphizer.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	using namespace generics;
+
+	/**
+	 * GenericsMonomorphizer
+	 */
+
+	struct GenericsMonomorphizer : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		Monomorphizer* monomorphizer;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+			compiler->applyTransformation(new transformations::ResolveInclude());
+			compiler->applyTransformation(new transformations::ResolveTypes());
+
+			monomorphizer = new Monomorphizer();
+			compiler->applyTransformation(monomorphizer);
+		}
+
+		InstanceCache* const
+		build(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+			return monomorphizer->getInstanceCache();
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(GenericsMonomorphizer, TestDeduplicateInstances)
+	{
+		auto instanceCache = build(
+			"namespace app { \n"
+				"class List<T> { \n"
+					"public let head: T; \n"
+					"public fn get(index: i32) -> T? { return null; } \n"
+				"} \n"
+				"let a: List<i32>; \n"
+				"let b: List<i32>; \n"
+				"let c: List<string>; \n"
+				"fn first(list: List<i32>) -> List<string> { return null; } \n"
+			"} \n"
+		);
+
+		// Cinco usos, apenas duas copias da classe.
+		ASSERT_EQ(instanceCache->getInstanceList().size(), 2);
+		EXPECT_EQ(instanceCache->getHitCount(), 3);
+
+		Instance_s* const instance = instanceCache->findInstance("List<i32>");
+		ASSERT_TRUE(instance != nullptr);
+		EXPECT_EQ(instance->useCount, 3);
+		EXPECT_EQ(instanceCache->findInstance("List<string>")->useCount, 2);
+
+		// Os itens do generic sao substituidos na copia.
+		auto classDecl = instance->specializedDecl->to<ast::ClassDecl>();
+		EXPECT_TRUE(classDecl->genericDecl == nullptr);
+		EXPECT_EQ(instanceCache->getTypeKey(classDecl->variableList[0]->typeDecl.get()), "i32");
+		EXPECT_EQ(instanceCache->getTypeKey(classDecl->functionList[0]->returnType.get()), "i32?");
+	}
+
+	TEST_F(GenericsMonomorphizer, TestNestedInstances)
+	{
+		auto instanceCache = build(
+			"namespace app { \n"
+				"class Box<T> { \n"
+					"public let value: T; \n"
+					"public let next: Box<T>; \n"
+				"} \n"
+				"class Pair<A, B> { \n"
+					"public let first: A; \n"
+					"public let second: B; \n"
+				"} \n"
+				"let a: Pair<Box<i32>, i32[]>; \n"
+				"let b: Pair<Box<i32>, i32[]>; \n"
+			"} \n"
+		);
+
+		// 'Box<T>' dentro da classe depende do argumento e nao e instanciado.
+		ASSERT_EQ(instanceCache->getInstanceList().size(), 2);
+		ASSERT_TRUE(instanceCache->findInstance("Box<i32>") != nullptr);
+		ASSERT_TRUE(instanceCache->findInstance("Pair<Box<i32>, i32[]>") != nullptr);
+
+		auto boxDecl = instanceCache->findInstance("Box<i32>")->specializedDecl->to<ast::ClassDecl>();
+		auto nextType = boxDecl->variableList[1]->typeDecl.get();
+
+		// A referencia resolvida e preservada na copia.
+		EXPECT_EQ(instanceCache->getTypeKey(nextType), "Box<i32>");
+		ASSERT_TRUE(nextType->getAttribute<attributes::Reference>() != nullptr);
+		EXPECT_EQ(nextType->getAttribute<attributes::Reference>()->get()->nodeType, AstNodeType_e::ClassDecl);
+	}
+
+	TEST_F(GenericsMonomorphizer, TestGenericFunctionCall)
+	{
+		auto instanceCache = build(
+			"namespace app { \n"
+				"fn max<T>(a: T, b: T) -> T { return a; } \n"
+				"fn main() { \n"
+					"let a = max<i32>(1, 2); \n"
+					"let b = max<i32>(3, 4); \n"
+					"let c = max<fp64>(1.0, 2.0); \n"
+				"} \n"
+			"} \n"
+		);
+
+		ASSERT_EQ(instanceCache->getInstanceList().size(), 2);
+		EXPECT_EQ(instanceCache->findInstance("max<i32>")->useCount, 2);
+
+		auto functionDecl = instanceCache->findInstance("max<fp64>")->specializedDecl->to<ast::FunctionDecl>();
+		EXPECT_EQ(instanceCache->getTypeKey(functionDecl->parameterList[1]->typeDecl.get()), "fp64");
+		EXPECT_EQ(instanceCache->getTypeKey(functionDecl->returnType.get()), "fp64");
+	}
+} }
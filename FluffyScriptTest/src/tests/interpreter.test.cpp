@@ -0,0 +1,284 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "interpreter/fl_slot_resolver.h"
+#include "interpreter/fl_ast_interpreter.h"
+#include "fl_exceptions.h"
+#include "fl_compiler.h"
+
+namespace fluffy { namespace testing {
+	using namespace vm;
+	using namespace interpreter;
+
+	/**
+	 * AstInterpreterTest
+	 */
+
+	struct AstInterpreterTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		std::unique_ptr<AstInterpreter> astInterpreter;
+		SlotResolver* slotResolver;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+
+			slotResolver = new SlotResolver();
+			compiler->applyTransformation(slotResolver);
+		}
+
+		AstInterpreter* const
+		load(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+
+			astInterpreter = std::make_unique<AstInterpreter>(slotResolver->getProgram());
+			astInterpreter->initialize();
+			return astInterpreter.get();
+		}
+
+		static Value_s
+		makeI32(I32 value) {
+			return makeInteger(ValueType_e::I32, value);
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(AstInterpreterTest, TestFib)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"fn fib(n: i32) -> i32 {\n"
+					"if (n < 2) { return n; }\n"
+					"return fib(n - 1) + fib(n - 2);\n"
+				"}\n"
+			"}\n"
+		);
+
+		const Value_s result = interpreter->call("app::fib", { makeI32(20) });
+
+		EXPECT_EQ(result.type, ValueType_e::I32);
+		EXPECT_EQ(result.integerValue, 6765);
+	}
+
+	TEST_F(AstInterpreterTest, TestLoop)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"fn sum(count: i32) -> i32 {\n"
+					"let total = 0;\n"
+					"for let i = 0; i < count; i++ {\n"
+						"if (i % 2 == 0) { continue; }\n"
+						"total += i;\n"
+					"}\n"
+					"let j = 0;\n"
+					"while (j < 10) { j = j + 1; total -= 1; }\n"
+					"return total;\n"
+				"}\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(interpreter->call("app::sum", { makeI32(100) }).integerValue, 2490);
+	}
+
+	TEST_F(AstInterpreterTest, TestIntegerWidth)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"fn wrap() -> i32 { return 2147483647 + 1; }\n"
+				"fn widen() -> i64 { return (2147483647 as i64) + 1; }\n"
+				"fn byte() -> u8 { return (255 as u8) + (1 as u8); }\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(interpreter->call("app::wrap", {}).integerValue, -2147483647LL - 1);
+
+		const Value_s widen = interpreter->call("app::widen", {});
+		EXPECT_EQ(widen.type, ValueType_e::I64);
+		EXPECT_EQ(widen.integerValue, 2147483648LL);
+
+		EXPECT_EQ(interpreter->call("app::byte", {}).integerValue, 0);
+	}
+
+	TEST_F(AstInterpreterTest, TestString)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"let prefix = \"value: \";\n"
+				"fn describe(n: i32) -> string { return prefix + n; }\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::describe", { makeI32(42) })), "value: 42");
+		EXPECT_EQ(interpreter->toString(interpreter->getGlobal("app::prefix")), "value: ");
+	}
+
+	TEST_F(AstInterpreterTest, TestObject)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"class Counter {\n"
+					"public let count: i32 = 10;\n"
+					"public fn next() -> i32 { count += 1; return count; }\n"
+				"}\n"
+				"class StepCounter extends Counter {\n"
+					"public let step: i32;\n"
+					"public constructor(step: i32) { this.step = step; }\n"
+					"public fn next() -> i32 { count += step; return super.next(); }\n"
+				"}\n"
+				"fn run() -> i32 {\n"
+					"let counters = [new Counter(), new StepCounter(5)];\n"
+					"let total = 0;\n"
+					"for let i = 0; i < 4; i++ {\n"
+						"total += counters[i % 2].next();\n"
+					"}\n"
+					"return total;\n"
+				"}\n"
+			"}\n"
+		);
+
+		// Counter: 11, 12; StepCounter: 16, 22.
+		EXPECT_EQ(interpreter->call("app::run", {}).integerValue, 61);
+
+		// O mesmo no de chamada observa as duas classes.
+		EXPECT_GE(interpreter->getInlineCacheMissCount(), 2);
+	}
+
+	TEST_F(AstInterpreterTest, TestMatch)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"let limit = 10;\n"
+				"fn name(value: i32) -> string {\n"
+					"match value {\n"
+						"when 0 -> { return \"zero\"; },\n"
+						"when limit -> { return \"limit\"; },\n"
+						"when other -> { return \"other \" + other; }\n"
+					"}\n"
+					"return \"none\";\n"
+				"}\n"
+			"}\n"
+		);
+
+		// Literais e variaveis globais sao comparados, os demais nomes capturam o valor.
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeI32(0) })), "zero");
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeI32(10) })), "limit");
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeI32(2) })), "other 2");
+	}
+
+	TEST_F(AstInterpreterTest, TestGarbageCollection)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"class Node {\n"
+					"public let next: Node;\n"
+				"}\n"
+				"fn build(count: i32) -> Node {\n"
+					"let head: Node = null;\n"
+					"for let i = 0; i < count; i++ {\n"
+						"let node = new Node();\n"
+						"node.next = head;\n"
+						"head = node;\n"
+					"}\n"
+					"return head;\n"
+				"}\n"
+				"let root: Node;\n"
+				"fn keep(count: i32) { root = build(count); }\n"
+				"fn churn(count: i32) {\n"
+					"for let i = 0; i < count; i++ { let node = new Node(); }\n"
+				"}\n"
+			"}\n"
+		);
+
+		interpreter->call("app::churn", { makeI32(200000) });
+		EXPECT_LT(interpreter->getObjectCount(), 200000);
+
+		// Objetos sem referencia sao liberados.
+		interpreter->call("app::build", { makeI32(1000) });
+		interpreter->collectGarbage();
+		EXPECT_EQ(interpreter->getObjectCount(), 0);
+
+		// Objetos alcancaveis por variaveis globais sobrevivem a coleta.
+		interpreter->call("app::keep", { makeI32(1000) });
+		interpreter->collectGarbage();
+		EXPECT_EQ(interpreter->getObjectCount(), 1000);
+	}
+
+	TEST_F(AstInterpreterTest, TestRuntimeError)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"fn divide(a: i32, b: i32) -> i32 {\n"
+					"return a / b;\n"
+				"}\n"
+				"fn fail() {\n"
+					"panic(\"failed\");\n"
+				"}\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(interpreter->call("app::divide", { makeI32(7), makeI32(2) }).integerValue, 3);
+		EXPECT_THROW(interpreter->call("app::divide", { makeI32(7), makeI32(0) }), exceptions::custom_exception);
+		EXPECT_THROW(interpreter->call("app::fail", {}), exceptions::custom_exception);
+
+		// O interpretador continua utilizavel apos o erro.
+		EXPECT_EQ(interpreter->call("app::divide", { makeI32(9), makeI32(3) }).integerValue, 3);
+	}
+
+	TEST_F(AstInterpreterTest, TestUnresolvedIdentifier)
+	{
+		// Nomes desconhecidos sao rejeitados na resolucao, antes da execucao.
+		EXPECT_THROW(load(
+			"namespace app {\n"
+				"fn run() -> i32 { return missing; }\n"
+			"}\n"
+		), exceptions::custom_exception);
+	}
+
+	TEST_F(AstInterpreterTest, TestMatchJumpTable)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"enum Color { Red, Green = 10, Blue }\n"
+				"let limit = 20;\n"
+				"fn name(value: i32) -> string {\n"
+					"return match value {\n"
+						"when Color::Red -> \"red\",\n"
+						"when Color::Green -> \"green\",\n"
+						"when Color::Blue -> \"blue\",\n"
+						"when 3 -> \"three\",\n"
+						"when limit -> \"limit\",\n"
+						"when other -> \"other \" + other\n"
+					"};\n"
+				"}\n"
+				"fn count(value: i32) -> i32 {\n"
+					"let total = 0;\n"
+					"match value {\n"
+						"when 1 -> { total = 1; },\n"
+						"when 2 -> { total = 2; },\n"
+						"when 3 -> { total = 3; },\n"
+						"when 4 -> { total = 4; }\n"
+					"}\n"
+					"return total;\n"
+				"}\n"
+			"}\n"
+		);
+
+		// Os inteiros usam a tabela de saltos, os demais valores testam os bracos.
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeI32(0) })), "red");
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeI32(11) })), "blue");
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeI32(3) })), "three");
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeI32(20) })), "limit");
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeI32(7) })), "other 7");
+		EXPECT_EQ(interpreter->toString(interpreter->call("app::name", { makeReal(ValueType_e::Fp64, 10.0) })), "green");
+		EXPECT_EQ(interpreter->call("app::count", { makeI32(4) }).integerValue, 4);
+		EXPECT_EQ(interpreter->call("app::count", { makeI32(5) }).integerValue, 0);
+		EXPECT_EQ(interpreter->call("app::count", { makeReal(ValueType_e::Fp64, 2.0) }).integerValue, 2);
+	}
+} }
@@ -0,0 +1,306 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "interpreter/fl_slot_resolver.h"
+#include "ir/fl_ir_builder.h"
+#include "ir/fl_ir_constant_propagation.h"
+#include "ir/fl_ir_dead_code_elimination.h"
+#include "ir/fl_ir_common_subexpression_elimination.h"
+#include "ir/fl_ir_inliner.h"
+#include "ir/fl_ir_escape_analysis.h"
+#include "fl_exceptions.h"
+#include "fl_compiler.h"
+
+namespace fluffy { namespace testing {
+	using namespace ir;
+	using namespace interpreter;
+
+	/**
+	 * IrTest
+	 */
+
+	struct IrTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		std::unique_ptr<Module> module;
+		SlotResolver* slotResolver;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+
+			slotResolver = new SlotResolver();
+			compiler->applyTransformation(slotResolver);
+		}
+
+		Module* const
+		load(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+
+			module = IrBuilder(slotResolver->getProgram()).build();
+
+			for (U32 i = 0; i < module->getFunctionCount(); i++)
+			{
+				module->getFunction(i)->verify();
+			}
+			return module.get();
+		}
+
+		void
+		optimize(Bool inlineCalls) {
+			PassManager passManager;
+			passManager.setVerify(true);
+
+			if (inlineCalls)
+			{
+				passManager.addPass(std::make_unique<Inliner>());
+			}
+			passManager.addPass(std::make_unique<ConstantPropagation>());
+			passManager.addPass(std::make_unique<CommonSubexpressionElimination>());
+			passManager.addPass(std::make_unique<DeadCodeElimination>());
+			passManager.run(module.get());
+		}
+
+		static U32
+		countOps(Function* const function, Opcode_e op) {
+			U32 count = 0;
+			for (auto& block : function->blockList)
+			{
+				for (auto& instruction : block->instructionList)
+				{
+					count += instruction->op == op ? 1 : 0;
+				}
+			}
+			return count;
+		}
+
+		static Instruction*
+		findOp(Function* const function, Opcode_e op) {
+			for (auto& block : function->blockList)
+			{
+				for (auto& instruction : block->instructionList)
+				{
+					if (instruction->op == op)
+					{
+						return instruction.get();
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		// Valor constante retornado por uma funcao com um unico bloco.
+		static Instruction*
+		getReturnedValue(Function* const function) {
+			EXPECT_EQ(function->blockList.size(), 1);
+
+			Instruction* const terminator = function->getEntry()->getTerminator();
+			EXPECT_EQ(terminator->op, Opcode_e::Return);
+			EXPECT_EQ(terminator->operandList.size(), 1);
+			return terminator->operandList[0];
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(IrTest, TestLoopPhi)
+	{
+		auto module = load(
+			"namespace app {\n"
+				"fn sum(count: i32) -> i32 {\n"
+					"let total = 0;\n"
+					"for let i = 0; i < count; i++ {\n"
+						"if (i % 2 == 0) { continue; }\n"
+						"total += i;\n"
+					"}\n"
+					"return total;\n"
+				"}\n"
+			"}\n"
+		);
+
+		Function* const function = module->findFunction("app::sum");
+		ASSERT_NE(function, nullptr);
+
+		// 'total' e 'i' mudam dentro do laco.
+		EXPECT_EQ(countOps(function, Opcode_e::Phi), 3);
+		EXPECT_EQ(countOps(function, Opcode_e::Return), 1);
+		EXPECT_EQ(function->returnType, Type_e::I32);
+
+		// Os tipos dos phis sao inferidos a partir dos valores iniciais.
+		for (auto& block : function->blockList)
+		{
+			for (auto& instruction : block->instructionList)
+			{
+				if (instruction->op == Opcode_e::Phi)
+				{
+					EXPECT_EQ(instruction->type, Type_e::I32);
+				}
+			}
+		}
+
+		optimize(false);
+		EXPECT_EQ(countOps(function, Opcode_e::Phi), 3);
+	}
+
+	TEST_F(IrTest, TestConstantFolding)
+	{
+		auto module = load(
+			"namespace app {\n"
+				"fn fold() -> i32 {\n"
+					"let a = 2;\n"
+					"let b = a * 3;\n"
+					"if (b > 5 && !false) { return b; }\n"
+					"return 0;\n"
+				"}\n"
+			"}\n"
+		);
+
+		optimize(false);
+
+		Instruction* const value = getReturnedValue(module->findFunction("app::fold"));
+		ASSERT_EQ(value->op, Opcode_e::Constant);
+		EXPECT_EQ(value->type, Type_e::I32);
+		EXPECT_EQ(value->value.integerValue, 6);
+	}
+
+	TEST_F(IrTest, TestDivisionByZeroIsKept)
+	{
+		auto module = load(
+			"namespace app {\n"
+				"fn fail() -> i32 { let unused = 1 / 0; return 2; }\n"
+			"}\n"
+		);
+
+		optimize(false);
+
+		Function* const function = module->findFunction("app::fail");
+		EXPECT_EQ(countOps(function, Opcode_e::Div), 1);
+		EXPECT_EQ(getReturnedValue(function)->value.integerValue, 2);
+	}
+
+	TEST_F(IrTest, TestCommonSubexpression)
+	{
+		auto module = load(
+			"namespace app {\n"
+				"fn square(a: i32, b: i32) -> i32 { return (a + b) * (b + a); }\n"
+			"}\n"
+		);
+
+		Function* const function = module->findFunction("app::square");
+		EXPECT_EQ(countOps(function, Opcode_e::Add), 2);
+
+		optimize(false);
+		EXPECT_EQ(countOps(function, Opcode_e::Add), 1);
+		EXPECT_EQ(countOps(function, Opcode_e::Mul), 1);
+	}
+
+	TEST_F(IrTest, TestInline)
+	{
+		auto module = load(
+			"namespace app {\n"
+				"fn sq(x: i32) -> i32 { return x * x; }\n"
+				"fn sign(x: i32) -> i32 { if (x < 0) { return -1; } return 1; }\n"
+				"fn compute() -> i32 { return sq(3) + sign(-4); }\n"
+			"}\n"
+		);
+
+		optimize(true);
+
+		Function* const function = module->findFunction("app::compute");
+		EXPECT_EQ(countOps(function, Opcode_e::Call), 0);
+
+		Instruction* const value = getReturnedValue(function);
+		ASSERT_EQ(value->op, Opcode_e::Constant);
+		EXPECT_EQ(value->value.integerValue, 8);
+	}
+
+	TEST_F(IrTest, TestRecursionIsNotInlined)
+	{
+		auto module = load(
+			"namespace app {\n"
+				"fn fib(n: i32) -> i32 {\n"
+					"if (n < 2) { return n; }\n"
+					"return fib(n - 1) + fib(n - 2);\n"
+				"}\n"
+			"}\n"
+		);
+
+		optimize(true);
+		EXPECT_EQ(countOps(module->findFunction("app::fib"), Opcode_e::Call), 2);
+	}
+
+	TEST_F(IrTest, TestClass)
+	{
+		auto module = load(
+			"namespace app {\n"
+				"class Counter {\n"
+					"public let count: i32 = 0;\n"
+					"public fn add(n: i32) -> i32 { count += n; return count; }\n"
+				"}\n"
+				"fn run() -> i32 {\n"
+					"let counter = new Counter();\n"
+					"counter.add(2);\n"
+					"return counter?.add(3);\n"
+				"}\n"
+			"}\n"
+		);
+
+		optimize(true);
+
+		Function* const function = module->findFunction("app::run");
+		EXPECT_EQ(countOps(function, Opcode_e::New), 1);
+		EXPECT_EQ(countOps(function, Opcode_e::CallMethod), 2);
+		EXPECT_FALSE(module->dump().empty());
+	}
+
+	TEST_F(IrTest, TestEscapeAnalysis)
+	{
+		auto module = load(
+			"namespace app {\n"
+				"class Point {\n"
+					"public let x: i32 = 0;\n"
+					"public fn get() -> i32 { return x; }\n"
+				"}\n"
+				"let last: Point;\n"
+				"fn keep(p: Point) { last = p; }\n"
+				"fn read(p: Point) -> i32 { return p.x; }\n"
+				"fn local() -> i32 { let p = new Point(); p.x = 2; return p.get(); }\n"
+				"fn returned() -> Point { return new Point(); }\n"
+				"fn stored() { last = new Point(); }\n"
+				"fn passed() -> i32 { return read(new Point()); }\n"
+				"fn leaked() { keep(new Point()); }\n"
+				"fn array() -> i32 { let list = [1, 2, 3]; return list[0]; }\n"
+			"}\n"
+		);
+
+		EscapeAnalysis escapeAnalysis(slotResolver->getProgram());
+		escapeAnalysis.run(module);
+
+		auto getState = [&](const I8* name, Opcode_e op) {
+			Function* const function = module->findFunction(name);
+			EXPECT_NE(function, nullptr);
+			return escapeAnalysis.getEscapeState(findOp(function, op));
+		};
+
+		// O metodo chamado no objeto nao o guarda.
+		EXPECT_EQ(getState("app::local", Opcode_e::New), EscapeState_e::ArgEscape);
+		EXPECT_EQ(getState("app::returned", Opcode_e::New), EscapeState_e::GlobalEscape);
+		EXPECT_EQ(getState("app::stored", Opcode_e::New), EscapeState_e::GlobalEscape);
+		EXPECT_EQ(getState("app::passed", Opcode_e::New), EscapeState_e::ArgEscape);
+		EXPECT_EQ(getState("app::leaked", Opcode_e::New), EscapeState_e::GlobalEscape);
+		EXPECT_EQ(getState("app::array", Opcode_e::NewArray), EscapeState_e::NoEscape);
+
+		const U32 keepIndex = module->findFunction("app::keep")->functionIndex;
+		const U32 readIndex = module->findFunction("app::read")->functionIndex;
+		EXPECT_EQ(escapeAnalysis.getParameterEscapeState(keepIndex, 0), EscapeState_e::GlobalEscape);
+		EXPECT_EQ(escapeAnalysis.getParameterEscapeState(readIndex, 0), EscapeState_e::NoEscape);
+
+		EXPECT_EQ(escapeAnalysis.getAllocationCount(), 6);
+		EXPECT_EQ(escapeAnalysis.getLocalAllocationCount(), 3);
+	}
+} }
@@ -7,9 +7,12 @@
 
 #include <memory>
 #include <set>
+#include <fstream>
+#include <filesystem>
 #include "test.h"
-#include "gtest\gtest.h"
-#include "lexer\fl_lexer.h"
+#include "gtest/gtest.h"
+#include "diagnostics/fl_diagnostics.h"
+#include "lexer/fl_lexer.h"
 #include "fl_buffer.h"
 #include "fl_exceptions.h"
 
@@ -44,9 +47,9 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "include");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Include);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -56,9 +59,9 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "namespace");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Namespace);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -68,9 +71,9 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "test");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -80,17 +83,17 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "void");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Void);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 		lex->nextToken();
 		{
 			EXPECT_EQ(lex->getToken().value, "test");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 6);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 6);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -103,18 +106,18 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "u32");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::U32);
-			EXPECT_EQ(lex->getToken().line, 2);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 2);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // love
 		{
 			EXPECT_EQ(lex->getToken().value, "love");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 2);
-			EXPECT_EQ(lex->getToken().column, 5);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 2);
+			EXPECT_EQ(lex->getTokenLocation().column, 5);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -125,36 +128,36 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "u64");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::U64);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 
 		lex->nextToken(); // id
 		{
 			EXPECT_EQ(lex->getToken().value, "id");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 5);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 5);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 
 		lex->nextToken(); // string
 		{
 			EXPECT_EQ(lex->getToken().value, "string");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::String);
-			EXPECT_EQ(lex->getToken().line, 2);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 2);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 
 		lex->nextToken(); // identifier
 		{
 			EXPECT_EQ(lex->getToken().value, "identifier");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 2);
-			EXPECT_EQ(lex->getToken().column, 8);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 2);
+			EXPECT_EQ(lex->getTokenLocation().column, 8);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 	}
 
@@ -179,9 +182,10 @@ namespace fluffy { namespace testing {
 			lex->loadSource("#");
 			throw std::exception();
 		}
-		catch (exceptions::unexpected_token_exception& e)
+		catch (exceptions::diagnostic_exception& e)
 		{
-			EXPECT_STREQ(e.what(), "anom_block error: Unexpected token '#' at: line 1, column 1");
+			EXPECT_EQ(e.getDiagnostic().code, diagnostics::DiagnosticCode_e::InvalidCharacter);
+			EXPECT_STREQ(e.what(), "anom_block error: Invalid character '#' at: line 1, column 1");
 		}
 	}
 
@@ -193,36 +197,36 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, ">");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::GreaterThan);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // >=
 		{
 			EXPECT_EQ(lex->getToken().value, ">=");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::GreaterThanOrEqual);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 3);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 3);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // ==
 		{
 			EXPECT_EQ(lex->getToken().value, "==");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Equal);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 6);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 6);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // +=
 		{
 			EXPECT_EQ(lex->getToken().value, "+=");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::PlusAssign);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 9);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 9);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -235,9 +239,9 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "void");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Void);
-			EXPECT_EQ(lex->getToken().line, 7);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 7);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 	}
 
@@ -250,9 +254,9 @@ namespace fluffy { namespace testing {
 
 			throw std::exception();
 		}
-		catch (exceptions::unexpected_end_of_file_exception& e)
+		catch (exceptions::diagnostic_exception& e)
 		{
-			EXPECT_STREQ(e.what(), "C:\\Users\\NPShinigami\\source\\repos\\FluffyScript\\FluffyScriptTest\\files\\lexer\\source_3.txt error: Unexpected end of file");
+			EXPECT_STREQ(e.what(), "C:\\Users\\NPShinigami\\source\\repos\\FluffyScript\\FluffyScriptTest\\files\\lexer\\source_3.txt error: Unexpected end of file at: line 7, column 1");
 		}
 	}
 
@@ -264,18 +268,18 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "0");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantHex);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // 0x10a
 		{
 			EXPECT_EQ(lex->getToken().value, "10a");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantHex);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 5);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 5);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -287,18 +291,18 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "0");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantBin);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // 0x10a
 		{
 			EXPECT_EQ(lex->getToken().value, "101");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantBin);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 5);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 5);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -310,27 +314,27 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "0.0");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantFp64);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // 0.5f
 		{
 			EXPECT_EQ(lex->getToken().value, "0.5");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantFp32);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 5);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 5);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // 0.95F
 		{
 			EXPECT_EQ(lex->getToken().value, "0.95");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantFp32);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 10);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 10);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -342,9 +346,27 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "0");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantInteger);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
+		}
+	}
+
+	TEST_F(LexerWithDirectBufferTest, TestIntegerConstant64Bits)
+	{
+		lex->loadSource("9223372036854775807 18446744073709551615 18446744073709551616");
+
+		EXPECT_EQ(lex->expectConstantInteger(), 9223372036854775807LL);
+		EXPECT_EQ(static_cast<U64>(lex->expectConstantInteger()), 18446744073709551615ULL);
+
+		try
+		{
+			lex->expectConstantInteger();
+			FAIL() << "Unexpected result";
+		}
+		catch (exceptions::diagnostic_exception& e)
+		{
+			EXPECT_STREQ(e.what(), "anom_block error: Integer constant '18446744073709551616' does not fit in 64 bits at: line 1, column 42");
 		}
 	}
 
@@ -356,27 +378,27 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "a");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantChar);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // 'b'
 		{
 			EXPECT_EQ(lex->getToken().value, "b");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantChar);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 5);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 5);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // '0'
 		{
 			EXPECT_EQ(lex->getToken().value, "0");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantChar);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 9);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 9);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -388,36 +410,36 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "test");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantString);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // bola
 		{
 			EXPECT_EQ(lex->getToken().value, "bola");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantString);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 8);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 8);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // \n\r
 		{
 			EXPECT_EQ(lex->getToken().value, "\\n\\r");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantString);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 15);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 15);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 
 		lex->nextToken(); // 'tonhudo'
 		{
 			EXPECT_EQ(lex->getToken().value, "'tonhudo'");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::ConstantString);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 22);
-			EXPECT_EQ(lex->getToken().filename, "anom_block");
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 22);
+			EXPECT_STREQ(lex->getFilename(), "anom_block");
 		}
 	}
 
@@ -439,6 +461,57 @@ namespace fluffy { namespace testing {
 		}
 		EXPECT_EQ(tokenCount, 134);
 	}
+
+	TEST_F(LexerWithDirectBufferTest, TestSourceLineIndex)
+	{
+		const I8* source = "u64\n\n\tlet a\t= 1;\n  b";
+
+		lexer::SourceLineIndex lineIndex;
+		lineIndex.build(source, static_cast<U32>(strlen(source)));
+
+		EXPECT_EQ(lineIndex.getLineCount(), 4);
+		EXPECT_EQ(lineIndex.getLineStart(3), 5);
+		EXPECT_EQ(lineIndex.getLine(0), 1);
+		EXPECT_EQ(lineIndex.getLine(3), 1);
+		EXPECT_EQ(lineIndex.getLine(4), 2);
+		EXPECT_EQ(lineIndex.getLine(6), 3);
+
+		// A indentacao e a tabulacao interna contam 4 colunas.
+		EXPECT_EQ(lineIndex.getLocation(6, 4).column, 5);
+		EXPECT_EQ(lineIndex.getLocation(10, 4).column, 9);
+		EXPECT_EQ(lineIndex.getLocation(12, 4).column, 14);
+		EXPECT_EQ(lineIndex.getLocation(19, 4).line, 4);
+		EXPECT_EQ(lineIndex.getLocation(19, 4).column, 3);
+	}
+
+	TEST_F(LexerWithDirectBufferTest, TestResetToPosition)
+	{
+		lex->loadSource("fn a() {\n\tlet b = 1;\n}");
+
+		while (lex->getToken().type != TokenType_e::Let)
+		{
+			lex->nextToken();
+		}
+
+		const Token_s letToken = lex->getToken();
+		EXPECT_EQ(lex->getTokenLocation().line, 2);
+		EXPECT_EQ(lex->getTokenLocation().column, 5);
+
+		while (lex->getToken().type != TokenType_e::Eof)
+		{
+			lex->nextToken();
+		}
+		EXPECT_EQ(lex->getTokenLocation().line, 3);
+
+		// Apenas o offset e necessario, a linha e a coluna vem do indice.
+		lex->resetToPosition(letToken.position);
+		EXPECT_EQ(lex->getToken().type, TokenType_e::Let);
+		EXPECT_EQ(lex->getTokenLocation().line, 2);
+		EXPECT_EQ(lex->getTokenLocation().column, 5);
+
+		EXPECT_EQ(lex->getLocation(0).line, 1);
+		EXPECT_EQ(lex->getLocation(letToken.position + 4).column, 9);
+	}
 } }
 
 namespace fluffy { namespace testing {
@@ -475,36 +548,36 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "u64");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::U64);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 
 		lex->nextToken(); // id
 		{
 			EXPECT_EQ(lex->getToken().value, "id");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 5);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 5);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 
 		lex->nextToken(); // string
 		{
 			EXPECT_EQ(lex->getToken().value, "string");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::String);
-			EXPECT_EQ(lex->getToken().line, 2);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 2);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 
 		lex->nextToken(); // identifier
 		{
 			EXPECT_EQ(lex->getToken().value, "identifier");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 2);
-			EXPECT_EQ(lex->getToken().column, 8);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 2);
+			EXPECT_EQ(lex->getTokenLocation().column, 8);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 	}
 
@@ -531,9 +604,9 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "void");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Void);
-			EXPECT_EQ(lex->getToken().line, 7);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, file.c_str());
+			EXPECT_EQ(lex->getTokenLocation().line, 7);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), file.c_str());
 		}
 	}
 
@@ -547,9 +620,9 @@ namespace fluffy { namespace testing {
 
 			throw std::exception();
 		}
-		catch (exceptions::unexpected_end_of_file_exception& e)
+		catch (exceptions::diagnostic_exception& e)
 		{
-			EXPECT_STREQ(e.what(), "C:\\Users\\NPShinigami\\source\\repos\\FluffyScript\\FluffyScriptTest\\files\\lexer\\source_3.txt error: Unexpected end of file");
+			EXPECT_STREQ(e.what(), "C:\\Users\\NPShinigami\\source\\repos\\FluffyScript\\FluffyScriptTest\\files\\lexer\\source_3.txt error: Unexpected end of file at: line 7, column 1");
 		}
 	}
 
@@ -572,6 +645,48 @@ namespace fluffy { namespace testing {
 		EXPECT_EQ(tokenCount, 134);
 	}
 
+	/**
+	 * Testing
+	 */
+
+	TEST_F(LexerWithLazyBufferTest, TestLocationBeyondBufferWindow)
+	{
+		// O arquivo e maior que a janela do buffer, o indice de linhas e
+		// construido sob demanda lendo o arquivo a partir do buffer.
+		const std::filesystem::path file = std::filesystem::temp_directory_path() / "fluffy_lexer_window.txt";
+		{
+			std::ofstream fileStream(file, std::ofstream::binary);
+			for (U32 index = 0; index < 200; index++)
+			{
+				fileStream << "\tlet value: i32 = 10;\n";
+			}
+		}
+		lex = std::make_unique<Lexer>(new LazyBuffer(64));
+		lex->loadSourceFromFile(file.string().c_str());
+
+		U32 tokenCount = 0;
+		while (lex->getToken().type != fluffy::TokenType_e::Eof)
+		{
+			// let value : i32 = 10 ;
+			EXPECT_EQ(lex->getTokenLocation().line, tokenCount / 7 + 1);
+			if (tokenCount % 7 == 0)
+			{
+				EXPECT_EQ(lex->getToken().value, "let");
+				EXPECT_EQ(lex->getTokenLocation().column, 5);
+			}
+			tokenCount++;
+			lex->nextToken();
+		}
+		EXPECT_EQ(tokenCount, 1400);
+
+		// Consulta fora de ordem, anterior a posicao atual.
+		EXPECT_EQ(lex->getLocation(0).line, 1);
+		EXPECT_EQ(lex->getLocation(21).line, 1);
+		EXPECT_EQ(lex->getLocation(22).line, 2);
+		EXPECT_EQ(lex->getLocation(23).column, 5);
+		std::filesystem::remove(file);
+	}
+
 	/**
 	 * Testing
 	 */
@@ -586,36 +701,36 @@ namespace fluffy { namespace testing {
 		{
 			EXPECT_EQ(lex->getToken().value, "u64");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::U64);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, filename);
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), filename);
 		}
 
 		lex->nextToken(); // id
 		{
 			EXPECT_EQ(lex->getToken().value, "id");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 1);
-			EXPECT_EQ(lex->getToken().column, 5);
-			EXPECT_EQ(lex->getToken().filename, filename);
+			EXPECT_EQ(lex->getTokenLocation().line, 1);
+			EXPECT_EQ(lex->getTokenLocation().column, 5);
+			EXPECT_STREQ(lex->getFilename(), filename);
 		}
 
 		lex->nextToken(); // string
 		{
 			EXPECT_EQ(lex->getToken().value, "string");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::String);
-			EXPECT_EQ(lex->getToken().line, 2);
-			EXPECT_EQ(lex->getToken().column, 1);
-			EXPECT_EQ(lex->getToken().filename, filename);
+			EXPECT_EQ(lex->getTokenLocation().line, 2);
+			EXPECT_EQ(lex->getTokenLocation().column, 1);
+			EXPECT_STREQ(lex->getFilename(), filename);
 		}
 
 		lex->nextToken(); // identifier
 		{
 			EXPECT_EQ(lex->getToken().value, "identifier");
 			EXPECT_EQ(lex->getToken().type, fluffy::TokenType_e::Identifier);
-			EXPECT_EQ(lex->getToken().line, 2);
-			EXPECT_EQ(lex->getToken().column, 8);
-			EXPECT_EQ(lex->getToken().filename, filename);
+			EXPECT_EQ(lex->getTokenLocation().line, 2);
+			EXPECT_EQ(lex->getTokenLocation().column, 8);
+			EXPECT_STREQ(lex->getFilename(), filename);
 		}
 	}
 } }
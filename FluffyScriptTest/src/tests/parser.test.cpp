@@ -2,9 +2,9 @@
 #include "gtest/gtest.h"
 #include "test.h"
 
-#include "parser\fl_parser.h"
-#include "scope\fl_scope_manager.h"
-#include "utils\fl_info_util.h"
+#include "parser/fl_parser.h"
+#include "scope/fl_scope_manager.h"
+#include "utils/fl_info_util.h"
 #include "fl_buffer.h"
 #include "fl_exceptions.h"
 
@@ -18,7 +18,7 @@ namespace fluffy { namespace testing {
 	struct ParserTest : public ::testing::Test
 	{
 		std::unique_ptr<Parser> parser;
-		fluffy::parser::ParserContext_s ctx{ false };
+		fluffy::parser::ParserContext_s ctx;
 
 		// Sets up the test fixture.
 		virtual void SetUp()
@@ -17,7 +17,7 @@ namespace fluffy { namespace testing {
 	struct ParserClassTest : public ::testing::Test
 	{
 		std::unique_ptr<Parser> parser;
-		fluffy::parser::ParserContext_s ctx{ false };
+		fluffy::parser::ParserContext_s ctx;
 
 		// Sets up the test fixture.
 		virtual void SetUp()
@@ -2,8 +2,9 @@
 #include "test.h"
 #include "gtest/gtest.h"
 
-#include "ast\fl_ast_type.h"
-#include "parser\fl_parser.h"
+#include "ast/fl_ast_type.h"
+#include "diagnostics/fl_diagnostics.h"
+#include "parser/fl_parser.h"
 #include "fl_buffer.h"
 #include "fl_exceptions.h"
 
@@ -18,7 +19,7 @@ namespace fluffy { namespace testing {
 	struct ParserClassFunctionTest : public ::testing::Test
 	{
 		std::unique_ptr<Parser> parser;
-		fluffy::parser::ParserContext_s ctx{ false };
+		fluffy::parser::ParserContext_s ctx;
 
 		// Sets up the test fixture.
 		virtual void SetUp()
@@ -379,9 +380,9 @@ namespace fluffy { namespace testing {
 			auto classObject = parser->parseClass(ctx, false);
 			throw std::exception();
 		}
-		catch (exceptions::custom_exception& e)
+		catch (exceptions::diagnostic_exception& e)
 		{
-			e.what();
+			EXPECT_EQ(e.getDiagnostic().code, diagnostics::DiagnosticCode_e::StaticFunctionOverride);
 		}
 	}
 
@@ -394,9 +395,9 @@ namespace fluffy { namespace testing {
 			auto classObject = parser->parseClass(ctx, false);
 			throw std::exception();
 		}
-		catch (exceptions::custom_exception& e)
+		catch (exceptions::diagnostic_exception& e)
 		{
-			e.what();
+			EXPECT_EQ(e.getDiagnostic().code, diagnostics::DiagnosticCode_e::StaticFunctionAbstract);
 		}
 	}
 
@@ -409,13 +410,9 @@ namespace fluffy { namespace testing {
 			auto classObject = parser->parseClass(ctx, false);
 			throw std::exception();
 		}
-		catch (exceptions::unexpected_token_exception& e)
+		catch (exceptions::diagnostic_exception& e)
 		{
-			e.what();
-		}
-		catch (exceptions::custom_exception& e)
-		{
-			e.what();
+			EXPECT_EQ(e.getDiagnostic().code, diagnostics::DiagnosticCode_e::ExpectedToken);
 		}
 	}
 
@@ -425,4 +422,36 @@ namespace fluffy { namespace testing {
 		parser->loadSourceFromFile(file.c_str());
 		parser->parseClass(ctx, false);
 	}
+
+	TEST_F(ParserClassFunctionTest, TestSkipFunctionBody)
+	{
+		parser->loadSource("class Foo { fn a() { let x = 0; if x > 0 { x += 1; } } fn b() -> i32 = 2; static fn c() {} }");
+
+		ctx.skipFunctionBody = true;
+
+		auto classObject = parser->parseClass(ctx, false);
+
+		EXPECT_EQ(classObject->functionList.size(), 3);
+
+		auto blockA = classObject->functionList[0]->blockDecl.get();
+		EXPECT_EQ(blockA->needParse, true);
+		EXPECT_EQ(blockA->stmtList.size(), 0);
+
+		EXPECT_EQ(classObject->functionList[1]->blockDecl, nullptr);
+		EXPECT_NE(classObject->functionList[1]->exprDecl, nullptr);
+
+		EXPECT_EQ(parser->hasSkippedBlock(), true);
+
+		parser->parseSkippedBlock(blockA);
+
+		EXPECT_EQ(blockA->needParse, false);
+		EXPECT_EQ(blockA->stmtList.size(), 2);
+		EXPECT_EQ(blockA->stmtList[0]->nodeType, AstNodeType_e::StmtVariable);
+		EXPECT_EQ(blockA->stmtList[1]->nodeType, AstNodeType_e::StmtIf);
+
+		parser->parseSkippedBlock(classObject->functionList[2]->blockDecl.get());
+
+		EXPECT_EQ(classObject->functionList[2]->blockDecl->stmtList.size(), 0);
+		EXPECT_EQ(parser->hasSkippedBlock(), false);
+	}
 } }
\ No newline at end of file
@@ -1,8 +1,8 @@
 #include <memory>
 #include "gtest/gtest.h"
 
-#include "ast\fl_ast_type.h"
-#include "parser\fl_parser.h"
+#include "ast/fl_ast_type.h"
+#include "parser/fl_parser.h"
 #include "fl_buffer.h"
 #include "fl_exceptions.h"
 
@@ -17,7 +17,7 @@ namespace fluffy { namespace testing {
 	struct ParserClassVariableTest : public ::testing::Test
 	{
 		std::unique_ptr<Parser> parser;
-		fluffy::parser::ParserContext_s ctx{ false };
+		fluffy::parser::ParserContext_s ctx;
 
 		// Sets up the test fixture.
 		virtual void SetUp()
@@ -3,9 +3,11 @@
 #include "test.h"
 #include "gtest/gtest.h"
 
-#include "ast\fl_ast_expr.h"
-#include "ast\fl_ast_type.h"
-#include "parser\fl_parser.h"
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_expr.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_type.h"
+#include "parser/fl_parser.h"
 #include "fl_buffer.h"
 #include "fl_exceptions.h"
 
@@ -63,7 +65,7 @@ namespace fluffy { namespace testing {
 	struct ParserExpressionTest : public ::testing::Test
 	{
 		std::unique_ptr<Parser> parser;
-		fluffy::parser::ParserContext_s ctx{ false };
+		fluffy::parser::ParserContext_s ctx;
 
 		// Sets up the test fixture.
 		virtual void SetUp()
@@ -260,4 +262,97 @@ namespace fluffy { namespace testing {
 		ASSERT_TRUE(expr != nullptr);
 		ASSERT_TRUE(parser->finished());
 	}
+
+	TEST_F(ParserExpressionTest, TestExpressionGenericTypeName)
+	{
+		parser->loadSource(
+			"namespace app {\n"
+				"fn main() {\n"
+					"let a = foo.count<Moo>(2);\n"
+					"let b = x < y > (3);\n"
+					"let c = foo.count<app::Moo, i32>();\n"
+				"}\n"
+				"class Moo {}\n"
+			"}\n"
+		);
+
+		auto codeUnit = parser->parseCodeUnit(ctx);
+		auto functionDecl = codeUnit->namespaceDeclList[0]->generalDeclList[0]->to<ast::FunctionDecl>();
+		auto& stmtList = functionDecl->blockDecl->stmtList;
+
+		ASSERT_EQ(stmtList.size(), 3);
+
+		// Moo e declarado depois da funcao, mas ja esta na tabela de tipos.
+		auto genericCall = stmtList[0]->to<ast::stmt::StmtVariableDecl>()->initExpr.get();
+		ASSERT_EQ(genericCall->nodeType, AstNodeType_e::GenericCallExpr);
+		EXPECT_EQ(genericCall->to<ExpressionGenericCallDecl>()->genericTypeList.size(), 1);
+
+		// y nao e um tipo: (x < y) > (3).
+		auto binExpr = stmtList[1]->to<ast::stmt::StmtVariableDecl>()->initExpr.get();
+		ASSERT_EQ(binExpr->nodeType, AstNodeType_e::BinaryExpr);
+		EXPECT_EQ(binExpr->to<ExpressionBinaryDecl>()->op, TokenType_e::GreaterThan);
+
+		auto scopedGenericCall = stmtList[2]->to<ast::stmt::StmtVariableDecl>()->initExpr.get();
+		ASSERT_EQ(scopedGenericCall->nodeType, AstNodeType_e::GenericCallExpr);
+		EXPECT_EQ(scopedGenericCall->to<ExpressionGenericCallDecl>()->genericTypeList.size(), 2);
+
+		ASSERT_TRUE(parser->finished());
+	}
+
+	TEST_F(ParserExpressionTest, TestExpressionAssociativity)
+	{
+		parser->loadSource("a = b += c - d - e * -f");
+
+		auto exprDecl = parser->parseExpression(ctx, OperatorPrecLevel_e::MinPrec);
+
+		// Atribuicoes associam a direita: a = [b += [...]]
+		ASSERT_EQ(exprDecl->nodeType, AstNodeType_e::BinaryExpr);
+		auto assignExpr = exprDecl->to<ExpressionBinaryDecl>();
+		EXPECT_EQ(assignExpr->op, TokenType_e::Assign);
+
+		ASSERT_EQ(assignExpr->rightDecl->nodeType, AstNodeType_e::BinaryExpr);
+		auto plusAssignExpr = assignExpr->rightDecl->to<ExpressionBinaryDecl>();
+		EXPECT_EQ(plusAssignExpr->op, TokenType_e::PlusAssign);
+
+		// Subtracoes associam a esquerda: [[c - d] - [e * -f]]
+		ASSERT_EQ(plusAssignExpr->rightDecl->nodeType, AstNodeType_e::BinaryExpr);
+		auto minusExpr = plusAssignExpr->rightDecl->to<ExpressionBinaryDecl>();
+		EXPECT_EQ(minusExpr->op, TokenType_e::Minus);
+
+		ASSERT_EQ(minusExpr->leftDecl->nodeType, AstNodeType_e::BinaryExpr);
+		EXPECT_EQ(minusExpr->leftDecl->to<ExpressionBinaryDecl>()->op, TokenType_e::Minus);
+
+		ASSERT_EQ(minusExpr->rightDecl->nodeType, AstNodeType_e::BinaryExpr);
+		auto mulExpr = minusExpr->rightDecl->to<ExpressionBinaryDecl>();
+		EXPECT_EQ(mulExpr->op, TokenType_e::Multiplication);
+		EXPECT_EQ(mulExpr->rightDecl->nodeType, AstNodeType_e::UnaryExpr);
+
+		ASSERT_TRUE(parser->finished());
+	}
+
+	TEST_F(ParserExpressionTest, TestExpressionDeepNesting)
+	{
+		const U32 depth = 2000;
+
+		String source;
+		for (U32 i = 0; i < depth; i++) {
+			source += "(1 + ";
+		}
+		source += "1";
+		for (U32 i = 0; i < depth; i++) {
+			source += ")";
+		}
+		parser->loadSource(source.c_str());
+
+		auto exprDecl = parser->parseExpression(ctx, OperatorPrecLevel_e::MinPrec);
+
+		U32 nestingCount = 0;
+		for (auto expr = exprDecl.get(); expr->nodeType == AstNodeType_e::BinaryExpr; nestingCount++)
+		{
+			expr = expr->to<ExpressionBinaryDecl>()->rightDecl.get();
+		}
+		EXPECT_EQ(nestingCount, depth);
+
+		ASSERT_TRUE(parser->finished());
+	}
 } }
\ No newline at end of file
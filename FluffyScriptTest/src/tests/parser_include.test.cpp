@@ -1,8 +1,8 @@
 #include <memory>
-#include "gtest\gtest.h"
+#include "gtest/gtest.h"
 
-#include "parser\fl_parser.h"
-#include "ast\fl_ast_decl.h"
+#include "parser/fl_parser.h"
+#include "ast/fl_ast_decl.h"
 #include "fl_buffer.h"
 
 namespace fluffy { namespace testing {
@@ -14,7 +14,7 @@ namespace fluffy { namespace testing {
 	struct ParserIncludeTest : public ::testing::Test
 	{
 		std::unique_ptr<fluffy::parser::Parser> parser;
-		fluffy::parser::ParserContext_s ctx{ false };
+		fluffy::parser::ParserContext_s ctx;
 
 		// Sets up the test fixture.
 		virtual void SetUp()
@@ -0,0 +1,136 @@
+#include <memory>
+#include "gtest/gtest.h"
+#include "test.h"
+
+#include "ast/fl_ast_decl.h"
+#include "diagnostics/fl_diagnostics.h"
+#include "parser/fl_parser.h"
+#include "fl_buffer.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	using parser::Parser;
+
+	/**
+	 * ParserRecoveryTest
+	 */
+
+	struct ParserRecoveryTest : public ::testing::Test
+	{
+		std::unique_ptr<Parser> parser;
+		diagnostics::DiagnosticEngine engine;
+		fluffy::parser::ParserContext_s ctx;
+
+		// Sets up the test fixture.
+		virtual void SetUp()
+		{
+			parser = std::make_unique<Parser>(
+				new DirectBuffer()
+			);
+			ctx.diagnosticEngine = &engine;
+		}
+
+		ast::BlockDecl*
+		getFunctionBlock(ast::CodeUnit* const codeUnit, U32 index) {
+			return codeUnit->namespaceDeclList[0]->generalDeclList[index]->to<ast::FunctionDecl>()->blockDecl.get();
+		}
+	};
+
+	/**
+	 * Tests
+	 */
+
+	TEST_F(ParserRecoveryTest, TestRecoverStatement)
+	{
+		parser->loadSource(
+			"namespace app { \n"
+				"fn main() { \n"
+					"let a = ; \n"
+					"let b = 1; \n"
+					"a + * 2; \n"
+					"if (b) { let c = ) ; } \n"
+					"return b; \n"
+				"} \n"
+			"} \n"
+		);
+
+		auto codeUnit = parser->parseCodeUnit(ctx);
+		auto blockDecl = getFunctionBlock(codeUnit.get(), 0);
+
+		ASSERT_EQ(engine.getErrorCount(), 3);
+		EXPECT_EQ(engine.getDiagnosticList()[0].line, 3);
+		EXPECT_EQ(engine.getDiagnosticList()[1].line, 5);
+		EXPECT_EQ(engine.getDiagnosticList()[2].line, 6);
+
+		// As instrucoes com erro ficam no lugar delas no bloco.
+		ASSERT_EQ(blockDecl->stmtList.size(), 5);
+		EXPECT_EQ(blockDecl->stmtList[0]->nodeType, AstNodeType_e::StmtError);
+		EXPECT_EQ(blockDecl->stmtList[1]->nodeType, AstNodeType_e::StmtVariable);
+		EXPECT_EQ(blockDecl->stmtList[2]->nodeType, AstNodeType_e::StmtError);
+		EXPECT_EQ(blockDecl->stmtList[3]->nodeType, AstNodeType_e::StmtIf);
+		EXPECT_EQ(blockDecl->stmtList[4]->nodeType, AstNodeType_e::StmtReturn);
+
+		auto ifDecl = blockDecl->stmtList[3]->to<ast::stmt::StmtIfDecl>();
+		ASSERT_EQ(ifDecl->ifBlockDecl->stmtList.size(), 1);
+		EXPECT_EQ(ifDecl->ifBlockDecl->stmtList[0]->nodeType, AstNodeType_e::StmtError);
+
+		auto stmtErrorDecl = blockDecl->stmtList[0]->to<ast::stmt::StmtErrorDecl>();
+		EXPECT_EQ(stmtErrorDecl->line, 3);
+		EXPECT_LT(stmtErrorDecl->beginPosition, stmtErrorDecl->endPosition);
+	}
+
+	TEST_F(ParserRecoveryTest, TestRecoverDeclaration)
+	{
+		parser->loadSource(
+			"namespace app { \n"
+				"class Foo { let a: i32 } \n"
+				"fn valid() { let a = 1; } \n"
+				"class 10 {} \n"
+				"class Bar {} \n"
+			"} \n"
+		);
+
+		auto codeUnit = parser->parseCodeUnit(ctx);
+		auto& generalDeclList = codeUnit->namespaceDeclList[0]->generalDeclList;
+
+		EXPECT_EQ(engine.getErrorCount(), 2);
+
+		ASSERT_EQ(generalDeclList.size(), 4);
+		EXPECT_EQ(generalDeclList[0]->nodeType, AstNodeType_e::ErrorDecl);
+		EXPECT_EQ(generalDeclList[1]->identifier, "valid");
+		EXPECT_EQ(generalDeclList[2]->nodeType, AstNodeType_e::ErrorDecl);
+		EXPECT_EQ(generalDeclList[3]->identifier, "Bar");
+
+		auto errorDecl = generalDeclList[2]->to<ast::ErrorDecl>();
+		EXPECT_EQ(errorDecl->line, 4);
+		EXPECT_EQ(errorDecl->column, 1);
+	}
+
+	TEST_F(ParserRecoveryTest, TestRecoverMissingBracket)
+	{
+		parser->loadSource(
+			"namespace app { \n"
+				"fn foo() { let a = 1; \n"
+		);
+
+		auto codeUnit = parser->parseCodeUnit(ctx);
+
+		// O fim do arquivo e reportado uma vez, pela declaracao.
+		EXPECT_EQ(engine.getErrorCount(), 1);
+		ASSERT_EQ(codeUnit->namespaceDeclList[0]->generalDeclList.size(), 1);
+		EXPECT_EQ(codeUnit->namespaceDeclList[0]->generalDeclList[0]->nodeType, AstNodeType_e::ErrorDecl);
+	}
+
+	TEST_F(ParserRecoveryTest, TestThrowWithoutEngine)
+	{
+		ctx.diagnosticEngine = nullptr;
+
+		parser->loadSource(
+			"namespace app { \n"
+				"fn main() { let a = ; } \n"
+			"} \n"
+		);
+
+		EXPECT_THROW(parser->parseCodeUnit(ctx), exceptions::diagnostic_exception);
+	}
+} }
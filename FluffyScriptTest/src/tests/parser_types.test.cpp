@@ -2,8 +2,9 @@
 #include "test.h"
 #include "gtest/gtest.h"
 
-#include "ast\fl_ast_type.h"
-#include "parser\fl_parser.h"
+#include "ast/fl_ast_type.h"
+#include "diagnostics/fl_diagnostics.h"
+#include "parser/fl_parser.h"
 #include "fl_buffer.h"
 #include "fl_exceptions.h"
 
@@ -17,7 +18,7 @@ namespace fluffy { namespace testing {
 	struct ParserTypesTest : public ::testing::Test
 	{
 		std::unique_ptr<Parser> parser;
-		fluffy::parser::ParserContext_s ctx{ false };
+		fluffy::parser::ParserContext_s ctx;
 
 		// Sets up the test fixture.
 		virtual void SetUp()
@@ -41,9 +42,9 @@ namespace fluffy { namespace testing {
 			auto typeVoidDecl = parser->parseType(ctx);			
 			throw std::exception();
 		}
-		catch (exceptions::custom_exception& e)
+		catch (exceptions::diagnostic_exception& e)
 		{
-			EXPECT_STREQ(e.what(), "'void' type can't be nullable at: line 1, column 1");
+			EXPECT_STREQ(e.what(), "anom_block error: 'void' type can't be nullable at: line 1, column 1");
 		}
 	}
 
@@ -0,0 +1,128 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "profiler/fl_profiler.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	using namespace profiler;
+
+	/**
+	 * ProfilerTest
+	 */
+
+	struct ProfilerTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		std::unique_ptr<Profiler> profiler;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			profiler = std::make_unique<Profiler>();
+
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+			compiler->setProfiler(profiler.get());
+			compiler->applyTransformation(new transformations::ResolveInclude());
+			compiler->applyTransformation(new transformations::ResolveTypes());
+		}
+
+		void
+		build() {
+			compiler->addBlockToBuild("source1",
+				"include { foo::Foo } in \"source2\"; \n"
+				"namespace app { \n"
+					"let a: Foo; \n"
+					"let b: Foo; \n"
+					"fn run(value: i32) -> i32 { let c: Foo; return value; } \n"
+				"} \n"
+			);
+			compiler->addBlockToBuild("source2",
+				"namespace foo { \n"
+					"export class Foo {} \n"
+				"} \n"
+			);
+			compiler->build();
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(ProfilerTest, TestPhaseStats)
+	{
+		build();
+
+		auto parserStats = profiler->findStats(parserPhase, "source1");
+		ASSERT_TRUE(parserStats != nullptr);
+		EXPECT_EQ(parserStats->callCount, 1);
+		EXPECT_GT(parserStats->nodeCount, 0);
+
+		auto lexerStats = profiler->findStats(lexerPhase, "source1");
+		ASSERT_TRUE(lexerStats != nullptr);
+		EXPECT_EQ(lexerStats->callCount, 1);
+		EXPECT_GT(lexerStats->nodeCount, lexerStats->callCount);
+
+		// Cada processador visita os nos de cada code unit uma vez.
+		auto resolveTypesStats = profiler->findStats("ResolveTypes", "source1");
+		auto resolveIncludeStats = profiler->findStats("ResolveInclude", "source1");
+		ASSERT_TRUE(resolveTypesStats != nullptr);
+		ASSERT_TRUE(resolveIncludeStats != nullptr);
+		EXPECT_EQ(resolveTypesStats->callCount, 1);
+		EXPECT_EQ(resolveTypesStats->nodeCount, resolveIncludeStats->nodeCount);
+		EXPECT_TRUE(profiler->findStats("ResolveTypes", "source2") != nullptr);
+
+		// As buscas entram nos totais mas nao geram eventos.
+		auto findStats = profiler->findStats(findNodeByIdPhase, "source1");
+		ASSERT_TRUE(findStats != nullptr);
+		EXPECT_GT(findStats->callCount, 0);
+
+		for (auto& event : profiler->getTraceEventList())
+		{
+			EXPECT_NE(event.phase, findNodeByIdPhase);
+		}
+
+		if (Profiler::hasAllocationHook())
+		{
+			EXPECT_GT(parserStats->allocatedBytes, 0);
+		}
+		else
+		{
+			EXPECT_EQ(parserStats->allocatedBytes, 0);
+		}
+	}
+
+	TEST_F(ProfilerTest, TestOutput)
+	{
+		build();
+
+		const String trace = profiler->toChromeTrace();
+		EXPECT_EQ(trace.find("{\"traceEvents\":["), 0);
+		EXPECT_NE(trace.find("\"name\":\"parser\""), String::npos);
+		EXPECT_NE(trace.find("\"name\":\"ResolveTypes\""), String::npos);
+		EXPECT_NE(trace.find("\"codeUnit\":\"source2\""), String::npos);
+
+		const String summary = profiler->toSummary();
+		EXPECT_NE(summary.find("ResolveInclude"), String::npos);
+		EXPECT_NE(summary.find(findNodeByIdPhase), String::npos);
+		EXPECT_NE(summary.find("total"), String::npos);
+
+		// Fora da compilacao o profiler nao fica ativo.
+		EXPECT_TRUE(Profiler::getActive() == nullptr);
+	}
+
+	TEST_F(ProfilerTest, TestInactive)
+	{
+		compiler->setProfiler(nullptr);
+		build();
+
+		EXPECT_TRUE(profiler->getStatsList().empty());
+		EXPECT_TRUE(profiler->getTraceEventList().empty());
+	}
+} }
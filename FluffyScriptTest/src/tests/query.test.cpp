@@ -0,0 +1,166 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "parser/fl_parser.h"
+#include "query/fl_query_engine.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "fl_buffer.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	/**
+	 * QueryEngineTest
+	 */
+
+	struct QueryEngineTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		std::unique_ptr<query::QueryEngine> engine;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+			compiler->applyTransformation(new transformations::ResolveInclude());
+			compiler->applyTransformation(new transformations::ResolveTypes());
+
+			compiler->addBlockToBuild("source1",
+				"include { lib::Foo } in \"source2\"; \n"
+				"namespace app { \n"
+					"fn main() { let b: Foo = null; } \n"
+					"fn other() {} \n"
+				"} \n"
+			);
+
+			compiler->addBlockToBuild("source2",
+				"namespace lib { \n"
+					"export class Base { fn base() {} } \n"
+					"export class Foo extends Base { \n"
+						"let value: i32; \n"
+						"fn run() { let a: Foo = null; } \n"
+					"} \n"
+				"} \n"
+			);
+
+			compiler->build();
+
+			engine = std::make_unique<query::QueryEngine>();
+			engine->applyBodyProcessor(new transformations::ResolveTypes());
+
+			for (auto codeUnit : compiler->getExecutionTree())
+			{
+				engine->insertCodeUnit(codeUnit);
+			}
+		}
+
+		ast::CodeUnit*
+		getCodeUnit(const I8* identifier) {
+			for (auto codeUnit : compiler->getExecutionTree())
+			{
+				if (codeUnit->identifier == identifier)
+				{
+					return codeUnit;
+				}
+			}
+			return nullptr;
+		}
+
+		ast::AstNode*
+		getDecl(const I8* codeUnitId, const I8* identifier) {
+			for (auto& generalDecl : getCodeUnit(codeUnitId)->namespaceDeclList[0]->generalDeclList)
+			{
+				if (generalDecl->identifier == identifier)
+				{
+					return generalDecl.get();
+				}
+			}
+			return nullptr;
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(QueryEngineTest, TestResolveTypeAt)
+	{
+		auto foo = getDecl("source2", "Foo");
+		ASSERT_NE(foo, nullptr);
+
+		// 'Foo' no corpo de main.
+		EXPECT_EQ(engine->resolveTypeAt(getCodeUnit("source1"), 3, 20), foo);
+		EXPECT_EQ(engine->resolveTypeAt(getCodeUnit("source1"), 3, 22), foo);
+
+		// 'Base' na heranca de Foo.
+		EXPECT_EQ(engine->resolveTypeAt(getCodeUnit("source2"), 3, 27), getDecl("source2", "Base"));
+
+		EXPECT_EQ(engine->resolveTypeAt(getCodeUnit("source1"), 3, 2), nullptr);
+		EXPECT_EQ(engine->findNodeAt(getCodeUnit("source1"), 4, 4)->identifier, "other");
+
+		// A segunda consulta e respondida pelo cache.
+		const U64 computeCount = engine->getComputeCount();
+		EXPECT_EQ(engine->resolveTypeAt(getCodeUnit("source1"), 3, 20), foo);
+		EXPECT_EQ(engine->getComputeCount(), computeCount);
+	}
+
+	TEST_F(QueryEngineTest, TestFindReferences)
+	{
+		auto referenceList = engine->findReferences(getDecl("source2", "Foo"));
+
+		// Os tipos de main e de run.
+		ASSERT_EQ(referenceList.size(), 2);
+		EXPECT_EQ(referenceList[0]->nodeType, AstNodeType_e::NamedType);
+		EXPECT_EQ(referenceList[1]->nodeType, AstNodeType_e::NamedType);
+	}
+
+	TEST_F(QueryEngineTest, TestListMembers)
+	{
+		auto foo = ast::safe_cast<ast::ClassDecl>(getDecl("source2", "Foo"));
+		auto memberList = engine->listMembers(foo);
+
+		// Membros proprios seguidos dos herdados de Base.
+		ASSERT_EQ(memberList.size(), 3);
+		EXPECT_EQ(memberList[0]->identifier, "value");
+		EXPECT_EQ(memberList[1]->identifier, "run");
+		EXPECT_EQ(memberList[2]->identifier, "base");
+	}
+
+	TEST_F(QueryEngineTest, TestUpdateFunctionBody)
+	{
+		auto foo = ast::safe_cast<ast::ClassDecl>(getDecl("source2", "Foo"));
+		auto other = ast::safe_cast<ast::FunctionDecl>(getDecl("source1", "other"));
+
+		EXPECT_EQ(engine->findReferences(foo).size(), 2);
+		engine->listMembers(foo);
+
+		const U64 computeCount = engine->getComputeCount();
+
+		// Substitui o corpo de 'other', as linhas continuam as mesmas do arquivo.
+		parser::Parser parser(new DirectBuffer());
+		parser::ParserContext_s ctx;
+
+		parser.loadSource("\n\n\n{ let c: Foo = null; let d: Foo = null; }");
+		other->blockDecl = parser.parseBlock(ctx);
+
+		engine->updateFunctionBody(other);
+
+		// Apenas as consultas que leram o corpo alterado sao recalculadas: o
+		// indice do corpo, as referencias nele e a uniao das referencias.
+		EXPECT_EQ(engine->findReferences(foo).size(), 4);
+		EXPECT_EQ(engine->getComputeCount(), computeCount + 3);
+
+		engine->listMembers(foo);
+		EXPECT_EQ(engine->getComputeCount(), computeCount + 3);
+
+		// Alterar as declaracoes invalida as consultas do code unit.
+		engine->invalidateDeclarations(getCodeUnit("source2"));
+		EXPECT_EQ(engine->listMembers(foo).size(), 3);
+		EXPECT_GT(engine->getComputeCount(), computeCount + 3);
+
+		EXPECT_THROW(engine->updateFunctionBody(foo), exceptions::custom_exception);
+	}
+} }
@@ -0,0 +1,293 @@
+#include <memory>
+#include <cmath>
+#include <map>
+#include "test.h"
+#include "source_generator.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "profiler/fl_profiler.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "validate/fl_validate_duplicated_nodes.h"
+#include "validate/fl_validate_class_rules.h"
+#include "validate/fl_validate_trait_rules.h"
+#include "validate/fl_validate_generic_rules.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	using namespace profiler;
+
+	// Expoentes maximos do crescimento de cada fase em relacao ao numero de
+	// tokens da entrada: 1 e linear, 2 e quadratico. Os contadores sao exatos
+	// e avaliados sempre, o tempo depende da maquina e da carga, por isso so
+	// e avaliado nos testes desabilitados e tem folga para o ruido.
+	static constexpr const Fp64 maxTimeExponent = 1.5;
+	static constexpr const Fp64 maxCountExponent = 1.15;
+
+	// Fases mais rapidas que isso no maior tamanho nao tem o tempo avaliado.
+	static constexpr const U64 minMeasuredTime = 2000;
+
+	/**
+	 * KnownGrowth_s
+	 */
+
+	// Fases que ja crescem mais rapido que o linear, o limite impede que piorem.
+	// Ao corrigir uma delas o limite deve voltar ao geral.
+	struct KnownGrowth_s
+	{
+		const I8*							phase;
+		Fp64								maxTimeExponent;
+	};
+
+	static const KnownGrowth_s knownGrowthList[] = {
+		// ScopeManager::findNodeById monta um Scope por nivel da pilha a cada
+		// busca e o Scope refaz o mapa de simbolos, o custo de cada busca e
+		// proporcional aos simbolos visiveis. Com os includes crescem tanto as
+		// buscas quanto os simbolos, o crescimento e quadratico.
+		{ findNodeByIdPhase,	3.0 },
+		{ "ResolveTypes",		3.0 },
+
+		// Cada include copia a arvore de referencias com todos os code units.
+		{ "ResolveInclude",		2.5 },
+
+		// validateDuplication compara todos os pares de filhos de cada escopo.
+		{ "DuplicatedNodes",	2.5 }
+	};
+
+	/**
+	 * PhaseSample_s
+	 */
+
+	struct PhaseSample_s
+	{
+		Fp64								time;
+		Fp64								callCount;
+		Fp64								nodeCount;
+	};
+
+	/**
+	 * ScalabilityTest
+	 */
+
+	struct ScalabilityTest : public ::testing::Test
+	{
+		// Compila o projeto e soma as fases de todos os code units, o tempo e o
+		// menor das execucoes.
+		static std::map<String, PhaseSample_s>
+		compile(const std::vector<SourceBlock_s>& blockList, U32 iterationCount, Fp64& tokenCount) {
+			std::map<String, PhaseSample_s> sampleMap;
+
+			for (U32 iteration = 0; iteration < iterationCount; iteration++)
+			{
+				Profiler profiler;
+
+				auto compiler = std::make_unique<fluffy::Compiler>();
+				compiler->initialize();
+				compiler->setProfiler(&profiler);
+				compiler->applyTransformation(new transformations::ResolveInclude());
+				compiler->applyTransformation(new transformations::ResolveTypes());
+				compiler->applyValidation(new validations::DuplicatedNodes());
+				compiler->applyValidation(new validations::TraitRules());
+				compiler->applyValidation(new validations::GenericRules());
+				compiler->applyValidation(new validations::ClassRules());
+
+				for (auto& block : blockList)
+				{
+					compiler->addBlockToBuild(block.name, block.sourceCode);
+				}
+				compiler->build();
+
+				std::map<String, PhaseSample_s> iterationMap;
+				for (auto& stats : profiler.getStatsList())
+				{
+					PhaseSample_s& sample = iterationMap[stats.phase];
+					sample.time += stats.totalTime;
+					sample.callCount += stats.callCount;
+					sample.nodeCount += stats.nodeCount;
+				}
+
+				for (auto& entry : iterationMap)
+				{
+					auto it = sampleMap.find(entry.first);
+					if (it == sampleMap.end())
+					{
+						sampleMap.emplace(entry.first, entry.second);
+					}
+					else if (entry.second.time < it->second.time)
+					{
+						it->second.time = entry.second.time;
+					}
+				}
+			}
+
+			tokenCount = sampleMap[lexerPhase].nodeCount;
+			return sampleMap;
+		}
+
+		static Fp64
+		getMaxTimeExponent(const String& phase) {
+			for (auto& knownGrowth : knownGrowthList)
+			{
+				if (phase == knownGrowth.phase)
+				{
+					return knownGrowth.maxTimeExponent;
+				}
+			}
+			return maxTimeExponent;
+		}
+
+		// Inclinacao da reta de minimos quadrados em escala log-log.
+		static Fp64
+		fitExponent(const std::vector<Fp64>& sizeList, const std::vector<Fp64>& valueList) {
+			Fp64 sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+			U32 count = 0;
+
+			for (size_t i = 0; i < sizeList.size(); i++)
+			{
+				if (valueList[i] <= 0.0)
+				{
+					continue;
+				}
+
+				const Fp64 x = std::log(sizeList[i]);
+				const Fp64 y = std::log(valueList[i]);
+
+				sumX += x;
+				sumY += y;
+				sumXX += x * x;
+				sumXY += x * y;
+				count++;
+			}
+
+			const Fp64 denominator = count * sumXX - sumX * sumX;
+			return count < 2 || denominator == 0.0 ? 0.0 : (count * sumXY - sumX * sumY) / denominator;
+		}
+
+		// Compila os projetos em ordem crescente e falha se alguma fase cresce
+		// mais rapido que os limites.
+		static void
+		checkGrowth(const I8* dimension, const std::vector<ProjectShape_s>& shapeList, Bool checkTime) {
+			std::vector<Fp64> sizeList;
+			std::vector<std::map<String, PhaseSample_s>> sampleList;
+
+			for (auto& shape : shapeList)
+			{
+				Fp64 tokenCount = 0.0;
+				sampleList.push_back(compile(SourceGenerator::project(shape), checkTime ? 3 : 1, tokenCount));
+				sizeList.push_back(tokenCount);
+			}
+
+			for (auto& entry : sampleList.back())
+			{
+				const String& phase = entry.first;
+
+				// O lexer e medido pelos tokens, usados como tamanho da entrada.
+				if (phase == lexerPhase)
+				{
+					continue;
+				}
+
+				std::vector<Fp64> timeList, callList, nodeList;
+				for (auto& sampleMap : sampleList)
+				{
+					const PhaseSample_s sample = sampleMap[phase];
+					timeList.push_back(sample.time);
+					callList.push_back(sample.callCount);
+					nodeList.push_back(sample.nodeCount);
+				}
+
+				if (checkTime)
+				{
+					if (entry.second.time >= minMeasuredTime)
+					{
+						EXPECT_LE(fitExponent(sizeList, timeList), getMaxTimeExponent(phase)) << dimension << ": " << phase << " time";
+					}
+					continue;
+				}
+				EXPECT_LE(fitExponent(sizeList, callList), maxCountExponent) << dimension << ": " << phase << " calls";
+				EXPECT_LE(fitExponent(sizeList, nodeList), maxCountExponent) << dimension << ": " << phase << " nodes";
+			}
+		}
+	};
+
+	/**
+	 * Dimensoes
+	 */
+
+	static const std::vector<ProjectShape_s> fileCountShapeList = {
+		{ 8, 8, 4, 2 },
+		{ 16, 8, 4, 2 },
+		{ 32, 8, 4, 2 },
+		{ 64, 8, 4, 2 }
+	};
+
+	static const std::vector<ProjectShape_s> classCountShapeList = {
+		{ 4, 8, 4, 2 },
+		{ 4, 16, 4, 2 },
+		{ 4, 32, 4, 2 },
+		{ 4, 64, 4, 2 }
+	};
+
+	static const std::vector<ProjectShape_s> memberCountShapeList = {
+		{ 4, 8, 8, 2 },
+		{ 4, 8, 16, 2 },
+		{ 4, 8, 32, 2 },
+		{ 4, 8, 64, 2 }
+	};
+
+	static const std::vector<ProjectShape_s> fanInShapeList = {
+		{ 17, 4, 0, 2 },
+		{ 17, 4, 0, 4 },
+		{ 17, 4, 0, 8 },
+		{ 17, 4, 0, 16 }
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(ScalabilityTest, TestFileCount)
+	{
+		checkGrowth("files", fileCountShapeList, false);
+	}
+
+	TEST_F(ScalabilityTest, TestClassesPerNamespace)
+	{
+		checkGrowth("classes", classCountShapeList, false);
+	}
+
+	TEST_F(ScalabilityTest, TestMembersPerClass)
+	{
+		checkGrowth("members", memberCountShapeList, false);
+	}
+
+	TEST_F(ScalabilityTest, TestIncludeFanIn)
+	{
+		checkGrowth("fan-in", fanInShapeList, false);
+	}
+
+	// O tempo fica desabilitado na execucao normal dos testes, para avalia-lo:
+	// tests --gtest_also_run_disabled_tests --gtest_filter=ScalabilityTest.*
+
+	TEST_F(ScalabilityTest, DISABLED_TestFileCountTime)
+	{
+		checkGrowth("files", fileCountShapeList, true);
+	}
+
+	TEST_F(ScalabilityTest, DISABLED_TestClassesPerNamespaceTime)
+	{
+		checkGrowth("classes", classCountShapeList, true);
+	}
+
+	TEST_F(ScalabilityTest, DISABLED_TestMembersPerClassTime)
+	{
+		checkGrowth("members", memberCountShapeList, true);
+	}
+
+	TEST_F(ScalabilityTest, DISABLED_TestIncludeFanInTime)
+	{
+		checkGrowth("fan-in", fanInShapeList, true);
+	}
+} }
@@ -3,12 +3,12 @@
 #include "gtest/gtest.h"
 
 #include "fl_buffer.h"
-#include "ast\fl_ast_decl.h"
-#include "parser\fl_parser.h"
-#include "scope\fl_scope_manager.h"
-#include "utils\fl_scope_utils.h"
-#include "attributes\fl_included_scope.h"
-#include "transformation\fl_transformation_resolve_include.h"
+#include "ast/fl_ast_decl.h"
+#include "parser/fl_parser.h"
+#include "scope/fl_scope_manager.h"
+#include "utils/fl_scope_utils.h"
+#include "attributes/fl_included_scope.h"
+#include "transformation/fl_transformation_resolve_include.h"
 #include "fl_compiler.h"
 #include "fl_exceptions.h"
 
@@ -22,7 +22,7 @@ namespace fluffy { namespace testing {
 	{
 		std::unique_ptr<fluffy::Compiler> compiler;
 		std::unique_ptr<parser::Parser> parser;
-		parser::ParserContext_s ctx = { false };
+		parser::ParserContext_s ctx;
 
 		// Antes de cada test
 		virtual void SetUp() override {
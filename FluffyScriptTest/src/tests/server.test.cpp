@@ -0,0 +1,209 @@
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "server/fl_compiler_server.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	/**
+	 * CompilerServerTest
+	 */
+
+	struct CompilerServerTest : public ::testing::Test
+	{
+		std::unique_ptr<server::CompilerServer> server;
+		std::filesystem::path directory;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			directory = std::filesystem::temp_directory_path() / "fluffy_server_test";
+			std::filesystem::remove_all(directory);
+			std::filesystem::create_directories(directory);
+
+			auto compiler = std::make_unique<fluffy::Compiler>();
+			compiler->setNumberOfJobs(1);
+			compiler->initialize(directory.string() + "/");
+			compiler->applyTransformation(new transformations::ResolveInclude());
+			compiler->applyTransformation(new transformations::ResolveTypes());
+
+			server = std::make_unique<server::CompilerServer>(std::move(compiler));
+
+			writeFile("lib.txt", "namespace lib { export class Foo {} }");
+			writeFile("main.txt", "include { lib::Foo } in \"lib\"; namespace app { let a: Foo; }");
+		}
+
+		// Apos cada test
+		virtual void TearDown() override {
+			std::filesystem::remove_all(directory);
+		}
+
+		void
+		writeFile(const I8* filename, const I8* sourceCode) {
+			std::ofstream fileStream(directory / filename, std::ofstream::binary);
+			fileStream << sourceCode;
+		}
+
+#ifndef _WIN32
+		// Conecta ao socket do servidor, aguardando ele ser criado.
+		int
+		connectClient(const String& socketPath) {
+			sockaddr_un address = {};
+			address.sun_family = AF_UNIX;
+			socketPath.copy(address.sun_path, socketPath.size());
+
+			for (U32 attempt = 0; attempt < 500; attempt++)
+			{
+				const int clientSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+				if (connect(clientSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+				{
+					return clientSocket;
+				}
+				close(clientSocket);
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			}
+			return -1;
+		}
+#endif
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(CompilerServerTest, TestWarmCache)
+	{
+		String response = server->handleRequest("check main.txt");
+		EXPECT_NE(response.find("\"success\":true"), String::npos);
+		EXPECT_EQ(response.find("\"cached\":true"), String::npos);
+
+		// Sem mudancas o resultado e reaproveitado.
+		response = server->handleRequest("check main.txt");
+		EXPECT_NE(response.find("\"success\":true"), String::npos);
+		EXPECT_EQ(response.find("\"cached\":false"), String::npos);
+
+		// Reescrever com o mesmo conteudo nao invalida pelo hash.
+		writeFile("lib.txt", "namespace lib { export class Foo {} }");
+		response = server->handleRequest("check main.txt");
+		EXPECT_EQ(response.find("\"cached\":false"), String::npos);
+
+		response = server->handleRequest("stats");
+		EXPECT_NE(response.find("\"requests\":4"), String::npos);
+		EXPECT_NE(response.find("\"builtFiles\":2"), String::npos);
+		EXPECT_NE(response.find("\"cachedFiles\":4"), String::npos);
+	}
+
+	TEST_F(CompilerServerTest, TestInvalidation)
+	{
+		server->handleRequest("check main.txt");
+
+		// O include mudou, os dois arquivos sao compilados novamente.
+		writeFile("lib.txt", "namespace lib { export class Bar {} }");
+		String response = server->handleRequest("check main.txt");
+		EXPECT_NE(response.find("\"success\":false"), String::npos);
+		EXPECT_EQ(response.find("\"cached\":true"), String::npos);
+		EXPECT_NE(response.find("Foo"), String::npos);
+
+		writeFile("main.txt", "include { lib::Bar } in \"lib\"; namespace app { let a: Bar; }");
+		response = server->handleRequest("check main.txt");
+		EXPECT_NE(response.find("\"success\":true"), String::npos);
+
+		// Apenas o arquivo alterado e compilado, o include continua em cache.
+		const size_t libPosition = response.find("lib.txt");
+		ASSERT_NE(libPosition, String::npos);
+		EXPECT_EQ(response.find("\"cached\":true", libPosition), response.find("\"cached\"", libPosition));
+	}
+
+	TEST_F(CompilerServerTest, TestInvalidationAcrossRequests)
+	{
+		server->handleRequest("check main.txt");
+
+		// O include e compilado novamente em uma requisicao que nao alcanca o
+		// arquivo principal, o code unit em cache dele deixa de ser valido.
+		writeFile("lib.txt", "namespace lib { export class Bar {} }");
+		String response = server->handleRequest("check lib.txt");
+		EXPECT_NE(response.find("\"success\":true"), String::npos);
+		EXPECT_EQ(response.find("\"cached\":true"), String::npos);
+
+		response = server->handleRequest("check main.txt");
+		EXPECT_NE(response.find("\"success\":false"), String::npos);
+		EXPECT_NE(response.find("Foo"), String::npos);
+
+		// O arquivo principal e compilado, o include continua em cache.
+		const size_t mainPosition = response.find("main.txt");
+		ASSERT_NE(mainPosition, String::npos);
+		EXPECT_EQ(response.find("\"cached\":false", mainPosition), response.find("\"cached\"", mainPosition));
+
+		const size_t libPosition = response.find("lib.txt");
+		ASSERT_NE(libPosition, String::npos);
+		EXPECT_EQ(response.find("\"cached\":true", libPosition), response.find("\"cached\"", libPosition));
+	}
+
+	TEST_F(CompilerServerTest, TestRequests)
+	{
+		EXPECT_NE(server->handleRequest("check").find("\"error\""), String::npos);
+		EXPECT_NE(server->handleRequest("compile main.txt").find("Unknown request"), String::npos);
+		EXPECT_TRUE(server->isRunning());
+
+		EXPECT_NE(server->handleRequest("shutdown").find("\"success\":true"), String::npos);
+		EXPECT_FALSE(server->isRunning());
+	}
+
+#ifndef _WIN32
+	TEST_F(CompilerServerTest, TestClientDisconnectBeforeRead)
+	{
+		const String socketPath = (directory / "server.sock").string();
+		std::thread serverThread([&]() {
+			server->listen(socketPath);
+		});
+
+		// O cliente envia as requisicoes e fecha a conexao sem ler as respostas,
+		// o servidor descarta a conexao e continua atendendo. A leitura e
+		// encerrada antes do envio para que a primeira resposta ja falhe com
+		// EPIPE, independente da ordem entre o cliente e o servidor.
+		int clientSocket = connectClient(socketPath);
+		ASSERT_GE(clientSocket, 0);
+		::shutdown(clientSocket, SHUT_RD);
+
+		String requests;
+		for (U32 index = 0; index < 200; index++)
+		{
+			requests += "check main.txt\n";
+		}
+		EXPECT_EQ(write(clientSocket, requests.c_str(), requests.size()), static_cast<ssize_t>(requests.size()));
+		close(clientSocket);
+
+		clientSocket = connectClient(socketPath);
+		ASSERT_GE(clientSocket, 0);
+
+		const String shutdownRequest = "shutdown\n";
+		EXPECT_EQ(write(clientSocket, shutdownRequest.c_str(), shutdownRequest.size()), static_cast<ssize_t>(shutdownRequest.size()));
+
+		String response;
+		I8 buffer[256];
+		ssize_t readCount;
+		while (response.find('\n') == String::npos && (readCount = read(clientSocket, buffer, sizeof(buffer))) > 0)
+		{
+			response.append(buffer, readCount);
+		}
+		close(clientSocket);
+		serverThread.join();
+
+		EXPECT_NE(response.find("\"success\":true"), String::npos);
+		EXPECT_FALSE(server->isRunning());
+	}
+#endif
+} }
@@ -0,0 +1,186 @@
+#include <sstream>
+#include "source_generator.h"
+
+namespace fluffy { namespace testing {
+	/**
+	 * SourceGenerator
+	 */
+
+	String
+	SourceGenerator::deepNamespaces(U32 depth)
+	{
+		std::stringstream stream;
+
+		for (U32 i = 0; i < depth; i++)
+		{
+			stream << "namespace level" << i << " {\n"
+				<< "class Node" << i << " { public let value: i32 = " << i << "; }\n"
+				<< "let item" << i << ": Node" << i << ";\n";
+		}
+
+		// O nivel mais interno referencia os tipos de todos os niveis.
+		for (U32 i = 0; i < depth; i++)
+		{
+			stream << "let ref" << i << ": Node" << i << ";\n";
+		}
+
+		for (U32 i = 0; i < depth; i++)
+		{
+			stream << "}\n";
+		}
+		return stream.str();
+	}
+
+	String
+	SourceGenerator::wideClasses(U32 classCount, U32 memberCount)
+	{
+		std::stringstream stream;
+
+		stream << "namespace wide {\n";
+		for (U32 i = 0; i < classCount; i++)
+		{
+			stream << "class Class" << i << " {\n";
+			for (U32 j = 0; j < memberCount; j++)
+			{
+				stream << "public let field" << j << ": i32 = " << j << ";\n"
+					<< "public fn method" << j << "(value: i32) -> i32 { return field" << j << " + value; }\n";
+			}
+			stream << "}\n";
+		}
+
+		for (U32 i = 0; i < classCount; i++)
+		{
+			stream << "let instance" << i << ": Class" << i << ";\n";
+		}
+		stream << "}\n";
+		return stream.str();
+	}
+
+	String
+	SourceGenerator::expressionChain(U32 functionCount, U32 chainLength)
+	{
+		std::stringstream stream;
+		static const I8* operatorList[] = { " + ", " * ", " - ", " & " };
+
+		stream << "namespace chain {\n";
+		for (U32 i = 0; i < functionCount; i++)
+		{
+			stream << "fn chain" << i << "(a: i32, b: i32) -> i32 {\n"
+				<< "let c = a";
+
+			for (U32 j = 0; j < chainLength; j++)
+			{
+				stream << operatorList[j % 4] << ((j & 1) ? "b" : "(a + 1)");
+			}
+			stream << ";\nreturn c;\n}\n";
+		}
+		stream << "}\n";
+		return stream.str();
+	}
+
+	String
+	SourceGenerator::heavyGenerics(U32 instanceCount)
+	{
+		std::stringstream stream;
+		static const I8* argumentList[] = { "i32", "bool", "string", "fp64" };
+
+		stream << "namespace generic {\n"
+			<< "class Box<T> { public let value: T; }\n"
+			<< "class Pair<K, V> { public let key: K; public let value: V; }\n";
+
+		for (U32 i = 0; i < instanceCount; i++)
+		{
+			const I8* const keyType = argumentList[i % 4];
+			const I8* const valueType = argumentList[(i / 4) % 4];
+
+			stream << "let box" << i << ": Box<" << keyType << ">;\n"
+				<< "let pair" << i << ": Pair<" << keyType << ", Box<" << valueType << ">>;\n";
+		}
+		stream << "}\n";
+		return stream.str();
+	}
+
+	std::vector<SourceBlock_s>
+	SourceGenerator::manyIncludes(U32 fileCount, U32 classesPerFile)
+	{
+		std::vector<SourceBlock_s> blockList;
+		std::stringstream mainStream;
+
+		for (U32 i = 0; i < fileCount; i++)
+		{
+			std::stringstream stream;
+
+			stream << "namespace lib" << i << " {\n";
+			for (U32 j = 0; j < classesPerFile; j++)
+			{
+				stream << "export class Type" << i << "_" << j << " { public let value: i32 = " << j << "; }\n";
+			}
+			stream << "}\n";
+
+			blockList.push_back({ "lib" + std::to_string(i), stream.str() });
+			mainStream << "include { lib" << i << "::* } in \"lib" << i << "\";\n";
+		}
+
+		mainStream << "namespace app {\n";
+		for (U32 i = 0; i < fileCount; i++)
+		{
+			for (U32 j = 0; j < classesPerFile; j++)
+			{
+				mainStream << "let value" << i << "_" << j << ": Type" << i << "_" << j << ";\n";
+			}
+		}
+		mainStream << "}\n";
+
+		blockList.push_back({ "main", mainStream.str() });
+		return blockList;
+	}
+
+	std::vector<SourceBlock_s>
+	SourceGenerator::project(const ProjectShape_s& shape)
+	{
+		std::vector<SourceBlock_s> blockList;
+
+		for (U32 i = 0; i < shape.fileCount; i++)
+		{
+			std::stringstream stream;
+			const U32 firstInclude = i > shape.includeFanIn ? i - shape.includeFanIn : 0;
+
+			for (U32 j = firstInclude; j < i; j++)
+			{
+				stream << "include { mod" << j << "::* } in \"file" << j << "\";\n";
+			}
+
+			stream << "namespace mod" << i << " {\n"
+				<< "export interface Shape" << i << " {\n";
+			for (U32 m = 0; m < shape.membersPerClass; m++)
+			{
+				stream << "fn method" << m << "(value: i32) -> i32;\n";
+			}
+			stream << "}\n";
+
+			for (U32 k = 0; k < shape.classesPerNamespace; k++)
+			{
+				stream << "export class Class" << i << "_" << k << " implements Shape" << i << " {\n";
+				for (U32 m = 0; m < shape.membersPerClass; m++)
+				{
+					stream << "public let field" << m << ": i32 = " << m << ";\n"
+						<< "public fn method" << m << "(value: i32) -> i32 { return field" << m << " + value; }\n";
+				}
+				stream << "}\n";
+			}
+
+			// Cada arquivo usa todas as classes que inclui.
+			for (U32 j = firstInclude; j < i; j++)
+			{
+				for (U32 k = 0; k < shape.classesPerNamespace; k++)
+				{
+					stream << "let use" << j << "_" << k << ": Class" << j << "_" << k << ";\n";
+				}
+			}
+			stream << "}\n";
+
+			blockList.push_back({ "file" + std::to_string(i), stream.str() });
+		}
+		return blockList;
+	}
+} }
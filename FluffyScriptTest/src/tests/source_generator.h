@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include "fl_defs.h"
+namespace fluffy { namespace testing {
+	/**
+	 * SourceBlock_s
+	 */
+
+	struct SourceBlock_s
+	{
+		String								name;
+		String								sourceCode;
+	};
+
+	/**
+	 * ProjectShape_s
+	 */
+
+	// Dimensoes de um projeto sintetico, cada uma pode ser escalada
+	// separadamente.
+	struct ProjectShape_s
+	{
+		U32									fileCount;
+		U32									classesPerNamespace;
+		U32									membersPerClass;
+
+		// Quantos arquivos anteriores cada arquivo inclui.
+		U32									includeFanIn;
+	};
+
+	/**
+	 * SourceGenerator
+	 */
+
+	// Gera codigos sinteticos validos para os benchmarks, o tamanho cresce
+	// linearmente com os parametros.
+	class SourceGenerator
+	{
+	public:
+		// Namespaces aninhados com uma classe e uma variavel em cada nivel.
+		static String
+		deepNamespaces(U32 depth);
+
+		// Classes com campos e metodos que usam os campos.
+		static String
+		wideClasses(U32 classCount, U32 memberCount);
+
+		// Funcoes com uma expressao aritmetica longa cada.
+		static String
+		expressionChain(U32 functionCount, U32 chainLength);
+
+		// Classes genericas instanciadas com varias combinacoes de argumentos.
+		static String
+		heavyGenerics(U32 instanceCount);
+
+		// Um bloco principal que inclui 'fileCount' blocos, na ordem de adicao
+		// ao compilador: os incluidos primeiro.
+		static std::vector<SourceBlock_s>
+		manyIncludes(U32 fileCount, U32 classesPerFile);
+
+		// Projeto com um namespace por arquivo. Cada namespace declara uma
+		// interface com 'membersPerClass' funcoes, classes que a implementam e
+		// variaveis com as classes dos arquivos incluidos. Os blocos estao na
+		// ordem de adicao ao compilador.
+		static std::vector<SourceBlock_s>
+		project(const ProjectShape_s& shape);
+	};
+} }
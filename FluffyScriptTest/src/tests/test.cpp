@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include "test.h"
 
@@ -8,6 +9,10 @@ namespace fluffy { namespace testing {
 		String url;
 		url.resize(1024);
 		sprintf_s(const_cast<I8*>(url.c_str()), 1024, "%s\\%s", _BASE_PATH, file);
+#ifndef _WIN32
+		// Os testes usam o separador do Windows nos caminhos dos arquivos.
+		std::replace(url.begin(), url.end(), '\\', '/');
+#endif
 		return url;
 	}
 } }
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_stmt.h"
+#include "ast/fl_ast_expr.h"
+#include "diagnostics/fl_diagnostics.h"
+#include "interpreter/fl_slot_resolver.h"
+#include "interpreter/fl_ast_interpreter.h"
+#include "transformation/fl_transformation_constant_folding.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	using namespace vm;
+	using namespace interpreter;
+
+	/**
+	 * TransformationConstantFolding
+	 */
+
+	struct TransformationConstantFolding : public ::testing::Test
+	{
+		class CheckResult : public scope::NodeProcessor
+		{
+		public:
+			CheckResult()
+			{}
+
+			virtual ~CheckResult()
+			{}
+
+			virtual void
+			onProcess(scope::ScopeManager* const scopeManager, scope::NodeProcessorEvent_e event, ast::AstNode* const node)
+			{
+				if (node->nodeType == AstNodeType_e::StmtReturn && event == scope::NodeProcessorEvent_e::onBegin)
+				{
+					returnTypeList.push_back(node->to<ast::stmt::StmtReturnDecl>()->exprDecl->nodeType);
+				}
+			}
+
+			std::vector<AstNodeType_e> returnTypeList;
+		};
+
+		std::unique_ptr<fluffy::Compiler> compiler;
+		std::unique_ptr<AstInterpreter> astInterpreter;
+		transformations::ConstantFolding* constantFolding;
+		SlotResolver* slotResolver;
+		CheckResult* checkResult;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+
+			constantFolding = new transformations::ConstantFolding();
+			compiler->applyTransformation(constantFolding);
+
+			slotResolver = new SlotResolver();
+			compiler->applyTransformation(slotResolver);
+
+			checkResult = new CheckResult();
+			compiler->applyValidation(checkResult);
+		}
+
+		AstInterpreter* const
+		load(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+
+			astInterpreter = std::make_unique<AstInterpreter>(slotResolver->getProgram());
+			astInterpreter->initialize();
+			return astInterpreter.get();
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(TransformationConstantFolding, TestFoldArithmetic)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"fn value() -> i32 {\n"
+					"return (2 + 3) * 4 - 10 / 2 % 3 + (1 << 4);\n"
+				"}\n"
+				"fn compare() -> bool {\n"
+					"return !(3 > 4) && 2.5 * 2.0 == 5.0;\n"
+				"}\n"
+			"}\n"
+		);
+
+		ASSERT_EQ(checkResult->returnTypeList.size(), 2);
+		EXPECT_EQ(checkResult->returnTypeList[0], AstNodeType_e::ConstantIntegerExpr);
+		EXPECT_EQ(checkResult->returnTypeList[1], AstNodeType_e::ConstantBoolExpr);
+
+		EXPECT_EQ(interpreter->call("app::value", {}).integerValue, 34);
+		EXPECT_TRUE(interpreter->call("app::compare", {}).boolValue);
+	}
+
+	TEST_F(TransformationConstantFolding, TestPropagateConstants)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"const LIMIT: i32 = SIZE * 2;\n"
+				"const SIZE: i32 = 8;\n"
+				"class Foo {\n"
+					"public static const MAX: i32 = 100;\n"
+				"}\n"
+				"fn value() -> i32 {\n"
+					"const half = Foo::MAX / 2;\n"
+					"return half + LIMIT;\n"
+				"}\n"
+				"fn shadow(SIZE: i32) -> i32 {\n"
+					"return SIZE + 1;\n"
+				"}\n"
+				"fn message() -> string {\n"
+					"return \"size: \" + SIZE;\n"
+				"}\n"
+			"}\n"
+		);
+
+		ASSERT_EQ(checkResult->returnTypeList.size(), 3);
+		EXPECT_EQ(checkResult->returnTypeList[0], AstNodeType_e::ConstantIntegerExpr);
+		EXPECT_EQ(checkResult->returnTypeList[1], AstNodeType_e::BinaryExpr);
+		EXPECT_EQ(checkResult->returnTypeList[2], AstNodeType_e::ConstantStringExpr);
+
+		EXPECT_EQ(interpreter->call("app::value", {}).integerValue, 66);
+		EXPECT_EQ(interpreter->call("app::shadow", { makeInteger(ValueType_e::I32, 1) }).integerValue, 2);
+		EXPECT_EQ(formatValue(interpreter->call("app::message", {})), "size: 8");
+	}
+
+	TEST_F(TransformationConstantFolding, TestShortCircuit)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"fn value(a: i32) -> i32 {\n"
+					"return false && a > 0 ? a : 7;\n"
+				"}\n"
+			"}\n"
+		);
+
+		ASSERT_EQ(checkResult->returnTypeList.size(), 1);
+		EXPECT_EQ(checkResult->returnTypeList[0], AstNodeType_e::ConstantIntegerExpr);
+		EXPECT_EQ(interpreter->call("app::value", { makeInteger(ValueType_e::I32, 1) }).integerValue, 7);
+	}
+
+	TEST_F(TransformationConstantFolding, TestOverflowWarning)
+	{
+		auto interpreter = load(
+			"namespace app {\n"
+				"fn value() -> i32 {\n"
+					"return 2147483647 + 1;\n"
+				"}\n"
+			"}\n"
+		);
+
+		ASSERT_EQ(constantFolding->getWarningList().size(), 1);
+		EXPECT_EQ(constantFolding->getWarningList()[0].line, 3);
+		EXPECT_EQ(interpreter->call("app::value", {}).integerValue, -2147483647 - 1);
+	}
+
+	TEST_F(TransformationConstantFolding, TestDivisionByZero)
+	{
+		EXPECT_THROW(load(
+			"namespace app {\n"
+				"fn value() -> i32 {\n"
+					"return 10 / (5 - 5);\n"
+				"}\n"
+			"}\n"
+		), exceptions::custom_exception);
+	}
+
+	TEST_F(TransformationConstantFolding, TestDivisionByZeroDiagnostic)
+	{
+		diagnostics::DiagnosticEngine engine;
+		compiler->setDiagnosticEngine(&engine);
+		compiler->addBlockToBuild("source1",
+			"namespace app {\n"
+				"fn value() -> i32 {\n"
+					"return 10 / (5 - 5);\n"
+				"}\n"
+			"}\n"
+		);
+		compiler->build();
+
+		// O erro e registrado e a divisao permanece sem avaliacao.
+		auto diagnosticList = engine.getDiagnosticList();
+		ASSERT_EQ(diagnosticList.size(), 1);
+		EXPECT_EQ(diagnosticList[0].code, diagnostics::DiagnosticCode_e::DivisionByZero);
+		EXPECT_EQ(diagnosticList[0].severity, diagnostics::DiagnosticSeverity_e::Error);
+		EXPECT_EQ(diagnosticList[0].line, 3);
+		ASSERT_NE(diagnosticList[0].node, nullptr);
+		EXPECT_EQ(diagnosticList[0].node->nodeType, AstNodeType_e::BinaryExpr);
+	}
+
+	TEST_F(TransformationConstantFolding, TestTernaryWithoutConstantValue)
+	{
+		load(
+			"namespace app {\n"
+				"fn value() -> i32 {\n"
+					"return \"a\" ? 1 : 2;\n"
+				"}\n"
+			"}\n"
+		);
+
+		// A condicao do tipo string nao tem valor constante, o ternario e mantido.
+		ASSERT_EQ(checkResult->returnTypeList.size(), 1);
+		EXPECT_EQ(checkResult->returnTypeList[0], AstNodeType_e::TernaryExpr);
+	}
+} }
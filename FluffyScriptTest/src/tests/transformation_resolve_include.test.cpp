@@ -2,10 +2,11 @@
 #include "test.h"
 #include "gtest/gtest.h"
 
-#include "ast\fl_ast_decl.h"
-#include "attributes\fl_included_scope.h"
-#include "transformation\fl_transformation_resolve_include.h"
-#include "scope\fl_scope_manager.h"
+#include "ast/fl_ast_decl.h"
+#include "attributes/fl_included_scope.h"
+#include "attributes/fl_export_summary.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "scope/fl_scope_manager.h"
 #include "fl_compiler.h"
 #include "fl_exceptions.h"
 
@@ -287,4 +288,93 @@ namespace fluffy { namespace testing {
 
 		EXPECT_EQ(checkResult->passes, 2);
 	}
+
+	TEST_F(TransformationResolveInclude, TestIncludeFromSummary)
+	{
+		class CheckResult : public scope::NodeProcessor
+		{
+		public:
+			CheckResult()
+			{}
+
+			virtual ~CheckResult()
+			{}
+
+			virtual void
+			onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node)
+			{
+				if (node->nodeType == AstNodeType_e::CodeUnit && event == scope::NodeProcessorEvent_e::onBegin)
+				{
+					if (node->identifier == "source1") {
+						auto includeList = node->getAttribute<attributes::IncludedScope>()->includeList();
+						ASSERT_EQ(includeList.size(), 2);
+
+						for (auto& includeItem : includeList)
+						{
+							if (includeItem.node->identifier == "FooOne") {
+								ASSERT_EQ(includeItem.node->nodeType, AstNodeType_e::ClassDecl);
+								ASSERT_EQ(includeItem.scope->identifier, "bar");
+							} else {
+								ASSERT_EQ(includeItem.node->identifier, "f");
+								ASSERT_EQ(includeItem.node->nodeType, AstNodeType_e::ClassFunctionDecl);
+								ASSERT_EQ(includeItem.scope->identifier, "FooOne");
+							}
+						}
+						passes++;
+					}
+
+					if (node->identifier == "source2") {
+						auto exportSummary = node->getAttribute<attributes::ExportSummary>();
+						ASSERT_NE(exportSummary, nullptr);
+
+						// Namespaces e declaracoes, exportadas ou nao.
+						ASSERT_EQ(exportSummary->findSymbol("foo").size(), 1);
+						ASSERT_EQ(exportSummary->findSymbol("foo::bar").size(), 1);
+						ASSERT_EQ(exportSummary->findSymbol("foo::bar::FooOne").size(), 1);
+						ASSERT_EQ(exportSummary->findSymbol("foo::bar::FooTwo").size(), 1);
+						ASSERT_EQ(exportSummary->findSymbol("foo::bar::g").size(), 1);
+
+						// Membros de classes exportadas.
+						ASSERT_EQ(exportSummary->scopeSymbolList("foo::bar::FooOne").size(), 2);
+						ASSERT_EQ(exportSummary->findSymbol("foo::bar::FooOne::f")[0].node->nodeType, AstNodeType_e::ClassFunctionDecl);
+
+						// Classes nao exportadas e corpos de funcoes nao sao expandidos.
+						ASSERT_EQ(exportSummary->scopeSymbolList("foo::bar::FooTwo").size(), 0);
+						ASSERT_EQ(exportSummary->findSymbol("foo::bar::FooOne::f::a").size(), 0);
+						ASSERT_EQ(exportSummary->getSymbolCount(), 7);
+						passes++;
+					}
+				}
+			}
+
+			U32 passes = false;
+		};
+
+		compiler->initialize();
+		compiler->applyTransformation(new transformations::ResolveInclude());
+
+		auto checkResult = new CheckResult();
+		compiler->applyValidation(checkResult);
+
+		compiler->addBlockToBuild("source1",
+			"include { foo::bar::FooOne, foo::bar::FooOne::f } in \"source2\"; \n"
+			"namespace app { \n"
+				"class Foo {}"
+			"} \n"
+		);
+
+		compiler->addBlockToBuild("source2",
+			"namespace foo { \n"
+				"namespace bar { \n"
+					"export class FooOne { static fn f() { let a = 0; } let v: i32; }"
+					"class FooTwo { static let p = 0; }"
+					"export fn g() {}"
+				"} \n"
+			"} \n"
+		);
+
+		compiler->build();
+
+		EXPECT_EQ(checkResult->passes, 2);
+	}
 } }
\ No newline at end of file
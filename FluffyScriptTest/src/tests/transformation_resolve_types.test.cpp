@@ -2,10 +2,10 @@
 #include "test.h"
 #include "gtest/gtest.h"
 
-#include "ast\fl_ast_decl.h"
-#include "attributes\fl_reference.h"
-#include "transformation\fl_transformation_resolve_include.h"
-#include "transformation\fl_transformation_resolve_types.h"
+#include "ast/fl_ast_decl.h"
+#include "attributes/fl_reference.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
 #include "fl_compiler.h"
 #include "fl_exceptions.h"
 
@@ -0,0 +1,214 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "ast/fl_ast_decl.h"
+#include "ast/fl_ast_type.h"
+#include "attributes/fl_interned_type.h"
+#include "types/fl_type_table.h"
+#include "utils/fl_ast_utils.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	using namespace types;
+
+	/**
+	 * TypeCollector
+	 */
+
+	// Coleta os tipos das variaveis na ordem em que foram declaradas.
+	class TypeCollector : public scope::NodeProcessor
+	{
+	public:
+		virtual void
+		onProcess(scope::ScopeManager* const scopeManager, const scope::NodeProcessorEvent_e event, ast::AstNode* const node) override
+		{
+			if (event != scope::NodeProcessorEvent_e::onBegin)
+			{
+				return;
+			}
+
+			if (node->nodeType == AstNodeType_e::VariableDecl)
+			{
+				typeList.push_back(node->to<ast::VariableDecl>()->typeDecl.get());
+			}
+			else if (node->nodeType == AstNodeType_e::ClassVariableDecl)
+			{
+				typeList.push_back(node->to<ast::ClassVariableDecl>()->typeDecl.get());
+			}
+		}
+
+		std::vector<ast::TypeDecl*>
+		typeList;
+	};
+
+	/**
+	 * TypeTableTest
+	 */
+
+	struct TypeTableTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		transformations::ResolveTypes* resolveTypes;
+		TypeCollector* typeCollector;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+			compiler->applyTransformation(new transformations::ResolveInclude());
+
+			resolveTypes = new transformations::ResolveTypes();
+			compiler->applyTransformation(resolveTypes);
+
+			typeCollector = new TypeCollector();
+			compiler->applyValidation(typeCollector);
+		}
+
+		TypeTable* const
+		build(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+			return resolveTypes->getTypeTable();
+		}
+
+		ast::TypeDecl*
+		getVariableType(U32 index) {
+			return typeCollector->typeList[index];
+		}
+
+		const Type_s*
+		getInternedType(ast::TypeDecl* const typeDecl) {
+			auto internedType = typeDecl->getAttribute<attributes::InternedType>();
+			return internedType ? internedType->get() : nullptr;
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(TypeTableTest, TestSharedCanonicalType)
+	{
+		auto typeTable = build(
+			"namespace app { \n"
+				"class List<T> { \n"
+					"public let head: T; \n"
+				"} \n"
+				"let a: List<i32>[]; \n"
+				"let b: List<i32>[]; \n"
+				"let c: (i32, fn(string -> bool)); \n"
+				"let d: (i32, fn(string -> bool)); \n"
+			"} \n"
+		);
+
+		auto typeA = getInternedType(getVariableType(1));
+		auto typeC = getInternedType(getVariableType(3));
+
+		ASSERT_TRUE(typeA != nullptr);
+		ASSERT_TRUE(typeC != nullptr);
+		EXPECT_EQ(typeA, getInternedType(getVariableType(2)));
+		EXPECT_EQ(typeC, getInternedType(getVariableType(4)));
+
+		EXPECT_EQ(typeTable->toString(typeA), "List<i32>[]");
+		EXPECT_EQ(typeTable->toString(typeC), "(i32, fn(string -> bool))");
+
+		// i32, List<i32>, List<i32>[], string, bool, fn(string -> bool) e a tupla.
+		EXPECT_EQ(typeTable->getTypeCount(), 7);
+		EXPECT_TRUE(utils::AstUtils::equals(getVariableType(1), getVariableType(2)));
+	}
+
+	TEST_F(TypeTableTest, TestDistinctTypes)
+	{
+		build(
+			"namespace app { \n"
+				"class List<T> { \n"
+					"public let head: T; \n"
+				"} \n"
+				"let a: i32; \n"
+				"let b: i32?; \n"
+				"let c: List<i32>; \n"
+				"let d: List<string>; \n"
+				"let e: i32[4]; \n"
+				"let f: i32[]; \n"
+			"} \n"
+		);
+
+		EXPECT_NE(getInternedType(getVariableType(1)), getInternedType(getVariableType(2)));
+		EXPECT_NE(getInternedType(getVariableType(3)), getInternedType(getVariableType(4)));
+		EXPECT_NE(getInternedType(getVariableType(5)), getInternedType(getVariableType(6)));
+
+		EXPECT_FALSE(utils::AstUtils::equals(getVariableType(3), getVariableType(4)));
+	}
+
+	TEST_F(TypeTableTest, TestEqualsWithoutInterning)
+	{
+		build(
+			"namespace app { \n"
+				"class List<T> { \n"
+					"public let head: T; \n"
+				"} \n"
+				"let a: i32; \n"
+				"let b: i32?; \n"
+				"let c: List<i32>; \n"
+				"let d: List<string>; \n"
+				"let e: List<i32>; \n"
+				"let f: fn(i32 -> bool); \n"
+				"let g: fn<string>(i32 -> bool); \n"
+				"let h: i32; \n"
+			"} \n"
+		);
+
+		const U32 typeCount = static_cast<U32>(typeCollector->typeList.size());
+		std::vector<Bool> internedResultList;
+
+		for (U32 i = 1; i < typeCount; i++)
+		{
+			for (U32 j = 1; j < typeCount; j++)
+			{
+				internedResultList.push_back(utils::AstUtils::equals(getVariableType(i), getVariableType(j)));
+			}
+		}
+
+		// Sem os tipos internados a comparacao recursiva deve dar o mesmo resultado.
+		for (U32 i = 1; i < typeCount; i++)
+		{
+			getVariableType(i)->removeAttribute(AttributeType_e::InternedType);
+		}
+
+		U32 index = 0;
+		for (U32 i = 1; i < typeCount; i++)
+		{
+			for (U32 j = 1; j < typeCount; j++)
+			{
+				EXPECT_EQ(utils::AstUtils::equals(getVariableType(i), getVariableType(j)), internedResultList[index++])
+					<< "variables " << i << " and " << j;
+			}
+		}
+
+		EXPECT_FALSE(utils::AstUtils::equals(getVariableType(1), getVariableType(2)));
+		EXPECT_FALSE(utils::AstUtils::equals(getVariableType(3), getVariableType(4)));
+		EXPECT_TRUE(utils::AstUtils::equals(getVariableType(3), getVariableType(5)));
+		EXPECT_FALSE(utils::AstUtils::equals(getVariableType(6), getVariableType(7)));
+		EXPECT_TRUE(utils::AstUtils::equals(getVariableType(1), getVariableType(8)));
+	}
+
+	TEST_F(TypeTableTest, TestOpenTypesNotInterned)
+	{
+		build(
+			"namespace app { \n"
+				"class Box<T> { \n"
+					"public let value: T; \n"
+					"public let next: Box<T>; \n"
+				"} \n"
+			"} \n"
+		);
+
+		// Tipos que dependem dos itens do generic mudam conforme a instancia.
+		EXPECT_TRUE(getInternedType(getVariableType(0)) == nullptr);
+		EXPECT_TRUE(getInternedType(getVariableType(1)) == nullptr);
+	}
+} }
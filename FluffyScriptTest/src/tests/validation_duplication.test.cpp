@@ -3,10 +3,10 @@
 #include "gtest/gtest.h"
 
 #include "fl_buffer.h"
-#include "parser\fl_parser.h"
-#include "transformation\fl_transformation_resolve_include.h"
-#include "transformation\fl_transformation_resolve_types.h"
-#include "validate\fl_validate_duplicated_nodes.h"
+#include "parser/fl_parser.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "validate/fl_validate_duplicated_nodes.h"
 #include "fl_compiler.h"
 #include "fl_exceptions.h"
 
@@ -3,14 +3,14 @@
 #include "gtest/gtest.h"
 
 #include "fl_buffer.h"
-#include "parser\fl_parser.h"
-#include "transformation\fl_transformation_resolve_include.h"
-#include "transformation\fl_transformation_resolve_types.h"
-#include "validate\fl_validate_duplicated_nodes.h"
-#include "validate\fl_validate_class_rules.h"
-#include "validate\fl_validate_trait_rules.h"
-#include "validate\fl_validate_generic_rules.h"
-#include "attributes\fl_reference.h"
+#include "parser/fl_parser.h"
+#include "transformation/fl_transformation_resolve_include.h"
+#include "transformation/fl_transformation_resolve_types.h"
+#include "validate/fl_validate_duplicated_nodes.h"
+#include "validate/fl_validate_class_rules.h"
+#include "validate/fl_validate_trait_rules.h"
+#include "validate/fl_validate_generic_rules.h"
+#include "attributes/fl_reference.h"
 #include "fl_compiler.h"
 #include "fl_exceptions.h"
 
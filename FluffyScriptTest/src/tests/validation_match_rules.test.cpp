@@ -0,0 +1,114 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "match/fl_match_compiler.h"
+#include "validate/fl_validate_match_rules.h"
+#include "fl_compiler.h"
+#include "fl_exceptions.h"
+
+namespace fluffy { namespace testing {
+	/**
+	 * ValidationMatchRulesTest
+	 */
+
+	struct ValidationMatchRulesTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		validations::MatchRules* matchRules;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+
+			matchRules = new validations::MatchRules();
+			compiler->applyValidation(matchRules);
+		}
+
+		const std::vector<validations::MatchWarning_s>&
+		build(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+			return matchRules->getWarningList();
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(ValidationMatchRulesTest, TestExhaustiveEnum)
+	{
+		auto& warningList = build(
+			"namespace app {\n"
+				"enum Color { Red, Green, Blue }\n"
+				"fn name(color: i32) -> string {\n"
+					"return match color {\n"
+						"when Color::Red -> \"red\",\n"
+						"when Color::Green -> \"green\",\n"
+						"when Color::Blue -> \"blue\"\n"
+					"};\n"
+				"}\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(warningList.size(), 0);
+	}
+
+	TEST_F(ValidationMatchRulesTest, TestMissingEnumItem)
+	{
+		auto& warningList = build(
+			"namespace app {\n"
+				"enum Color { Red, Green, Blue }\n"
+				"fn name(color: i32) {\n"
+					"match color {\n"
+						"when Color::Red -> {},\n"
+						"when Color::Blue -> {}\n"
+					"}\n"
+				"}\n"
+			"}\n"
+		);
+
+		ASSERT_EQ(warningList.size(), 1);
+		EXPECT_EQ(warningList[0].message, "source1 warning: Non-exhaustive match, missing: Color::Green");
+		EXPECT_EQ(warningList[0].line, 4);
+	}
+
+	TEST_F(ValidationMatchRulesTest, TestUnreachableArm)
+	{
+		auto& warningList = build(
+			"namespace app {\n"
+				"fn name(value: i32) -> string {\n"
+					"return match value {\n"
+						"when 1 -> \"one\",\n"
+						"when other -> \"other\",\n"
+						"when 2 -> \"two\"\n"
+					"};\n"
+				"}\n"
+			"}\n"
+		);
+
+		ASSERT_EQ(warningList.size(), 1);
+		EXPECT_EQ(warningList[0].message, "source1 warning: Unreachable match arm, previous patterns cover all its values");
+		EXPECT_EQ(warningList[0].line, 6);
+	}
+
+	TEST_F(ValidationMatchRulesTest, TestNonExhaustiveExpression)
+	{
+		auto& warningList = build(
+			"namespace app {\n"
+				"fn name(value: i32) -> string {\n"
+					"return match value {\n"
+						"when 1 -> \"one\",\n"
+						"when 2 -> \"two\"\n"
+					"};\n"
+				"}\n"
+			"}\n"
+		);
+
+		// Literais possuem dominio infinito, o match de um statement seria aceito.
+		ASSERT_EQ(warningList.size(), 1);
+		EXPECT_EQ(warningList[0].message, "source1 warning: Non-exhaustive match, missing: _");
+	}
+} }
@@ -0,0 +1,251 @@
+#include <memory>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "codegen/fl_code_generator.h"
+#include "vm/fl_virtual_machine.h"
+#include "fl_exceptions.h"
+#include "fl_compiler.h"
+
+namespace fluffy { namespace testing {
+	using namespace vm;
+
+	/**
+	 * VirtualMachineTest
+	 */
+
+	struct VirtualMachineTest : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		std::unique_ptr<VirtualMachine> virtualMachine;
+		codegen::CodeGenerator* codeGenerator;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+
+			codeGenerator = new codegen::CodeGenerator();
+			compiler->applyCodeGeneration(codeGenerator);
+		}
+
+		VirtualMachine* const
+		load(String sourceCode) {
+			compiler->addBlockToBuild("source1", sourceCode);
+			compiler->build();
+
+			virtualMachine = std::make_unique<VirtualMachine>(codeGenerator->getModule());
+			virtualMachine->initialize();
+			return virtualMachine.get();
+		}
+
+		static Value_s
+		makeI32(I32 value) {
+			return makeInteger(ValueType_e::I32, value);
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(VirtualMachineTest, TestFib)
+	{
+		auto vm = load(
+			"namespace app {\n"
+				"fn fib(n: i32) -> i32 {\n"
+					"if (n < 2) { return n; }\n"
+					"return fib(n - 1) + fib(n - 2);\n"
+				"}\n"
+			"}\n"
+		);
+
+		const Value_s result = vm->call("app::fib", { makeI32(20) });
+
+		EXPECT_EQ(result.type, ValueType_e::I32);
+		EXPECT_EQ(result.integerValue, 6765);
+	}
+
+	TEST_F(VirtualMachineTest, TestLoop)
+	{
+		auto vm = load(
+			"namespace app {\n"
+				"fn sum(count: i32) -> i32 {\n"
+					"let total = 0;\n"
+					"for let i = 0; i < count; i++ {\n"
+						"if (i % 2 == 0) { continue; }\n"
+						"total += i;\n"
+					"}\n"
+					"let j = 0;\n"
+					"while (j < 10) { j = j + 1; total -= 1; }\n"
+					"return total;\n"
+				"}\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(vm->call("app::sum", { makeI32(100) }).integerValue, 2490);
+	}
+
+	TEST_F(VirtualMachineTest, TestIntegerWidth)
+	{
+		auto vm = load(
+			"namespace app {\n"
+				"fn wrap() -> i32 { return 2147483647 + 1; }\n"
+				"fn widen() -> i64 { return (2147483647 as i64) + 1; }\n"
+				"fn byte() -> u8 { return (255 as u8) + (1 as u8); }\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(vm->call("app::wrap", {}).integerValue, -2147483647LL - 1);
+
+		const Value_s widen = vm->call("app::widen", {});
+		EXPECT_EQ(widen.type, ValueType_e::I64);
+		EXPECT_EQ(widen.integerValue, 2147483648LL);
+
+		EXPECT_EQ(vm->call("app::byte", {}).integerValue, 0);
+	}
+
+	TEST_F(VirtualMachineTest, TestString)
+	{
+		auto vm = load(
+			"namespace app {\n"
+				"let prefix = \"value: \";\n"
+				"fn describe(n: i32) -> string { return prefix + n; }\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(vm->toString(vm->call("app::describe", { makeI32(42) })), "value: 42");
+		EXPECT_EQ(vm->toString(vm->getGlobal("app::prefix")), "value: ");
+	}
+
+	TEST_F(VirtualMachineTest, TestObject)
+	{
+		auto vm = load(
+			"namespace app {\n"
+				"class Counter {\n"
+					"public let count: i32 = 10;\n"
+					"public fn next() -> i32 { count += 1; return count; }\n"
+				"}\n"
+				"class StepCounter extends Counter {\n"
+					"public let step: i32;\n"
+					"public constructor(step: i32) { this.step = step; }\n"
+					"public fn next() -> i32 { count += step; return super.next(); }\n"
+				"}\n"
+				"fn run() -> i32 {\n"
+					"let counters = [new Counter(), new StepCounter(5)];\n"
+					"let total = 0;\n"
+					"for let i = 0; i < 4; i++ {\n"
+						"total += counters[i % 2].next();\n"
+					"}\n"
+					"return total;\n"
+				"}\n"
+			"}\n"
+		);
+
+		// Counter: 11, 12; StepCounter: 16, 22.
+		EXPECT_EQ(vm->call("app::run", {}).integerValue, 61);
+
+		// A mesma instrucao GetMethod observa as duas classes.
+		EXPECT_GE(vm->getInlineCacheMissCount(), 2);
+	}
+
+	TEST_F(VirtualMachineTest, TestGarbageCollection)
+	{
+		auto vm = load(
+			"namespace app {\n"
+				"class Node {\n"
+					"public let next: Node;\n"
+				"}\n"
+				"fn build(count: i32) -> Node {\n"
+					"let head: Node = null;\n"
+					"for let i = 0; i < count; i++ {\n"
+						"let node = new Node();\n"
+						"node.next = head;\n"
+						"head = node;\n"
+					"}\n"
+					"return head;\n"
+				"}\n"
+				"let root: Node;\n"
+				"fn keep(count: i32) { root = build(count); }\n"
+				"fn churn(count: i32) {\n"
+					"for let i = 0; i < count; i++ { let node = new Node(); }\n"
+				"}\n"
+			"}\n"
+		);
+
+		vm->call("app::churn", { makeI32(200000) });
+		EXPECT_LT(vm->getObjectCount(), 200000);
+
+		// Objetos sem referencia sao liberados.
+		vm->call("app::build", { makeI32(1000) });
+		vm->collectGarbage();
+		EXPECT_EQ(vm->getObjectCount(), 0);
+
+		// Objetos alcancaveis por variaveis globais sobrevivem a coleta.
+		vm->call("app::keep", { makeI32(1000) });
+		vm->collectGarbage();
+		EXPECT_EQ(vm->getObjectCount(), 1000);
+	}
+
+	TEST_F(VirtualMachineTest, TestRuntimeError)
+	{
+		auto vm = load(
+			"namespace app {\n"
+				"fn divide(a: i32, b: i32) -> i32 {\n"
+					"return a / b;\n"
+				"}\n"
+				"fn fail() {\n"
+					"panic(\"failed\");\n"
+				"}\n"
+			"}\n"
+		);
+
+		EXPECT_EQ(vm->call("app::divide", { makeI32(7), makeI32(2) }).integerValue, 3);
+		EXPECT_THROW(vm->call("app::divide", { makeI32(7), makeI32(0) }), exceptions::custom_exception);
+		EXPECT_THROW(vm->call("app::fail", {}), exceptions::custom_exception);
+
+		// A maquina continua utilizavel apos o erro.
+		EXPECT_EQ(vm->call("app::divide", { makeI32(9), makeI32(3) }).integerValue, 3);
+	}
+
+	TEST_F(VirtualMachineTest, TestMatchJumpTable)
+	{
+		auto vm = load(
+			"namespace app {\n"
+				"enum Color { Red, Green = 10, Blue }\n"
+				"let limit = 20;\n"
+				"fn name(value: i32) -> string {\n"
+					"return match value {\n"
+						"when Color::Red -> \"red\",\n"
+						"when Color::Green -> \"green\",\n"
+						"when Color::Blue -> \"blue\",\n"
+						"when 3 -> \"three\",\n"
+						"when limit -> \"limit\",\n"
+						"when other -> \"other \" + other\n"
+					"};\n"
+				"}\n"
+				"fn count(value: i32) -> i32 {\n"
+					"let total = 0;\n"
+					"match value {\n"
+						"when 1 -> { total = 1; },\n"
+						"when 2 -> { total = 2; },\n"
+						"when 3 -> { total = 3; },\n"
+						"when 4 -> { total = 4; }\n"
+					"}\n"
+					"return total;\n"
+				"}\n"
+			"}\n"
+		);
+
+		// Os inteiros usam a tabela de saltos, os demais valores testam os bracos.
+		EXPECT_EQ(vm->toString(vm->call("app::name", { makeI32(0) })), "red");
+		EXPECT_EQ(vm->toString(vm->call("app::name", { makeI32(11) })), "blue");
+		EXPECT_EQ(vm->toString(vm->call("app::name", { makeI32(3) })), "three");
+		EXPECT_EQ(vm->toString(vm->call("app::name", { makeI32(20) })), "limit");
+		EXPECT_EQ(vm->toString(vm->call("app::name", { makeI32(7) })), "other 7");
+		EXPECT_EQ(vm->toString(vm->call("app::name", { makeReal(ValueType_e::Fp64, 10.0) })), "green");
+		EXPECT_EQ(vm->call("app::count", { makeI32(4) }).integerValue, 4);
+		EXPECT_EQ(vm->call("app::count", { makeI32(5) }).integerValue, 0);
+		EXPECT_EQ(vm->call("app::count", { makeReal(ValueType_e::Fp64, 2.0) }).integerValue, 2);
+	}
+} }
\ No newline at end of file
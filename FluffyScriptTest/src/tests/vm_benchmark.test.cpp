@@ -0,0 +1,122 @@
+#include <memory>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include "test.h"
+#include "gtest/gtest.h"
+
+#include "codegen/fl_code_generator.h"
+#include "vm/fl_virtual_machine.h"
+#include "fl_compiler.h"
+
+// Os benchmarks ficam desabilitados na execucao normal dos testes, para executa-los:
+// tests --gtest_also_run_disabled_tests --gtest_filter=VirtualMachineBenchmark.*
+namespace fluffy { namespace testing {
+	using namespace vm;
+
+	/**
+	 * VirtualMachineBenchmark
+	 */
+
+	struct VirtualMachineBenchmark : public ::testing::Test
+	{
+		std::unique_ptr<fluffy::Compiler> compiler;
+		std::unique_ptr<VirtualMachine> virtualMachine;
+		codegen::CodeGenerator* codeGenerator;
+
+		// Antes de cada test
+		virtual void SetUp() override {
+			compiler = std::make_unique<fluffy::Compiler>();
+			compiler->initialize();
+
+			codeGenerator = new codegen::CodeGenerator();
+			compiler->applyCodeGeneration(codeGenerator);
+
+			compiler->addBlockToBuild("benchmark",
+				"namespace bench {\n"
+					"fn fib(n: i32) -> i32 {\n"
+						"if (n < 2) { return n; }\n"
+						"return fib(n - 1) + fib(n - 2);\n"
+					"}\n"
+					"fn loop(count: i32) -> i32 {\n"
+						"let total = 0;\n"
+						"for let i = 0; i < count; i++ {\n"
+							"total = total + (i & 7) * 3;\n"
+						"}\n"
+						"return total;\n"
+					"}\n"
+					"fn strings(count: i32) -> i32 {\n"
+						"let equalCount = 0;\n"
+						"for let i = 0; i < count; i++ {\n"
+							"let text = \"item-\" + (i % 100);\n"
+							"if (text == \"item-42\") { equalCount++; }\n"
+						"}\n"
+						"return equalCount;\n"
+					"}\n"
+					"class Point {\n"
+						"public let x: i32;\n"
+						"public let y: i32;\n"
+						"public constructor(x: i32, y: i32) { this.x = x; this.y = y; }\n"
+						"public fn sum() -> i32 { return x + y; }\n"
+					"}\n"
+					"fn allocation(count: i32) -> i32 {\n"
+						"let total = 0;\n"
+						"for let i = 0; i < count; i++ {\n"
+							"let point = new Point(i, 1);\n"
+							"total += point.sum() & 1;\n"
+						"}\n"
+						"return total;\n"
+					"}\n"
+				"}\n"
+			);
+			compiler->build();
+
+			virtualMachine = std::make_unique<VirtualMachine>(codeGenerator->getModule());
+			virtualMachine->initialize();
+		}
+
+		// Executa a funcao e reporta a quantidade de operacoes por segundo.
+		Value_s
+		run(const I8* name, const I8* functionName, I32 argument, U64 operationCount) {
+			const auto start = std::chrono::steady_clock::now();
+			const Value_s result = virtualMachine->call(functionName, { makeInteger(ValueType_e::I32, argument) });
+			const auto end = std::chrono::steady_clock::now();
+
+			const Fp64 seconds = std::chrono::duration<Fp64>(end - start).count();
+
+			std::cout << "[ BENCH    ] " << std::left << std::setw(12) << name
+				<< std::right << std::setw(14) << std::fixed << std::setprecision(0) << operationCount / seconds << " ops/sec"
+				<< " (" << std::setprecision(1) << seconds * 1000.0 << " ms)" << std::endl;
+			return result;
+		}
+	};
+
+	/**
+	 * Testing
+	 */
+
+	TEST_F(VirtualMachineBenchmark, DISABLED_Fib)
+	{
+		// Cada chamada de fib(n) conta como uma operacao: 2 * fib(n + 1) - 1 chamadas.
+		const Value_s result = run("fib", "bench::fib", 30, 2 * 1346269 - 1);
+		EXPECT_EQ(result.integerValue, 832040);
+	}
+
+	TEST_F(VirtualMachineBenchmark, DISABLED_Loop)
+	{
+		const Value_s result = run("loop", "bench::loop", 10000000, 10000000);
+		EXPECT_EQ(result.integerValue, 105000000);
+	}
+
+	TEST_F(VirtualMachineBenchmark, DISABLED_Strings)
+	{
+		const Value_s result = run("strings", "bench::strings", 1000000, 1000000);
+		EXPECT_EQ(result.integerValue, 10000);
+	}
+
+	TEST_F(VirtualMachineBenchmark, DISABLED_Allocation)
+	{
+		const Value_s result = run("allocation", "bench::allocation", 1000000, 1000000);
+		EXPECT_EQ(result.integerValue, 500000);
+	}
+} }
\ No newline at end of file